@@ -20,6 +20,7 @@
 #include "http/middleware/allow_origin.hpp"
 #include "ledger/chain/consensus/bad_miner.hpp"
 #include "ledger/chain/consensus/dummy_miner.hpp"
+#include "ledger/chaincode/compiled_contract_cache.hpp"
 #include "ledger/chaincode/contract_http_interface.hpp"
 #include "ledger/execution_manager.hpp"
 #include "ledger/storage_unit/lane_remote_control.hpp"
@@ -153,6 +154,7 @@ Constellation::Constellation(CertificatePtr &&certificate, Config config)
   , trust_{}
   , p2p_{muddle_,        lane_control_,        trust_,
          cfg_.max_peers, cfg_.transient_peers, cfg_.peers_update_cycle_ms}
+  , tx_layout_cache_{cfg_.log2_num_lanes}
   , lane_services_()
   , storage_(std::make_shared<StorageUnitClient>(internal_muddle_.AsEndpoint(), shard_cfgs_,
                                                  cfg_.log2_num_lanes))
@@ -172,9 +174,10 @@ Constellation::Constellation(CertificatePtr &&certificate, Config config)
                        cfg_.num_lanes(),
                        cfg_.num_slices,
                        cfg_.block_difficulty}
-  , main_chain_service_{std::make_shared<MainChainRpcService>(p2p_.AsEndpoint(), chain_, trust_,
-                                                              cfg_.network_mode)}
-  , tx_processor_{*storage_, block_packer_, tx_status_cache_, cfg_.processor_threads}
+  , main_chain_service_{std::make_shared<MainChainRpcService>(
+        p2p_.AsEndpoint(), chain_, tx_layout_cache_, trust_, cfg_.network_mode)}
+  , tx_processor_{*storage_, block_packer_, tx_layout_cache_, tx_status_cache_,
+                  cfg_.processor_threads}
   , http_{http_network_manager_}
   , http_modules_{
         std::make_shared<p2p::P2PHttpInterface>(
@@ -196,6 +199,9 @@ Constellation::Constellation(CertificatePtr &&certificate, Config config)
   // attach the services to the reactor
   reactor_.Attach(main_chain_service_->GetWeakRunnable());
 
+  // persist the compiled smart contracts so that they do not need to be recompiled on restart
+  ledger::CompiledContractCache::Instance().AttachDiskStore("contracts.db", "contracts.index.db");
+
   // configure all the lane services
   lane_services_.Setup(network_manager_, shard_cfgs_, !config.disable_signing);
 
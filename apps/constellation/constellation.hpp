@@ -29,6 +29,7 @@
 #include "ledger/storage_unit/lane_remote_control.hpp"
 #include "ledger/storage_unit/storage_unit_bundled_service.hpp"
 #include "ledger/storage_unit/storage_unit_client.hpp"
+#include "ledger/transaction_layout_cache.hpp"
 #include "ledger/transaction_processor.hpp"
 #include "ledger/transaction_status_cache.hpp"
 #include "miner/basic_miner.hpp"
@@ -126,6 +127,7 @@ private:
   using TrustSystem            = p2p::P2PTrustBayRank<Muddle::Address>;
   using ShardConfigs           = ledger::ShardConfigs;
   using TxStatusCache          = ledger::TransactionStatusCache;
+  using TxLayoutCache          = ledger::TransactionLayoutCache;
 
   /// @name Configuration
   /// @{
@@ -152,6 +154,7 @@ private:
   /// @name Transaction and State Database shards
   /// @{
   TxStatusCache        tx_status_cache_;  ///< Cache of transaction status
+  TxLayoutCache        tx_layout_cache_;  ///< Cache of recent transaction layouts
   LaneServices         lane_services_;    ///< The lane services
   StorageUnitClientPtr storage_;          ///< The storage client to the lane services
   LaneRemoteControl    lane_control_;     ///< The lane control client for the lane services
@@ -0,0 +1,96 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/containers/queue.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using fetch::core::LockFreeQueue;
+using fetch::core::MultiThreadedIndex;
+using fetch::core::Queue;
+
+constexpr std::size_t QUEUE_SIZE = 1u << 16u;
+constexpr std::size_t BATCH_SIZE = 16;
+
+using Element      = uint64_t;
+using MutexQueue   = Queue<Element, QUEUE_SIZE, MultiThreadedIndex<QUEUE_SIZE>,
+                         MultiThreadedIndex<QUEUE_SIZE>>;
+using LockFreeRing = LockFreeQueue<Element, QUEUE_SIZE>;
+
+template <typename QueueType>
+QueueType &GetQueue()
+{
+  static QueueType queue;
+  return queue;
+}
+
+/**
+ * Each thread pushes an element and then pops an element from the shared queue, so that the
+ * occupancy of the queue never exceeds the number of threads
+ */
+template <typename QueueType>
+void QueuePushPop(benchmark::State &state)
+{
+  auto &queue = GetQueue<QueueType>();
+
+  Element value{0};
+  for (auto _ : state)
+  {
+    queue.Push(value);
+    queue.Pop(value, std::chrono::seconds{1});
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * Each thread pushes a batch of elements and then pops a batch of elements from the shared queue
+ */
+void LockFreeQueueBulkPushPop(benchmark::State &state)
+{
+  auto &queue = GetQueue<LockFreeRing>();
+
+  std::vector<Element> input(BATCH_SIZE, 0);
+  std::vector<Element> output;
+  output.reserve(BATCH_SIZE);
+
+  for (auto _ : state)
+  {
+    queue.PushMany(input.begin(), input.end());
+
+    output.clear();
+    while (output.size() < BATCH_SIZE)
+    {
+      queue.PopMany(output, BATCH_SIZE - output.size(), std::chrono::seconds{1});
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(BATCH_SIZE));
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(QueuePushPop, MutexQueue)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(QueuePushPop, LockFreeRing)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(LockFreeQueueBulkPushPop)->ThreadRange(1, 64)->UseRealTime();
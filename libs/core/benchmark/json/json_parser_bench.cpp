@@ -0,0 +1,153 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/json/document.hpp"
+#include "core/json/on_demand.hpp"
+#include "core/json/structural_index.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+
+namespace {
+
+using fetch::byte_array::ConstByteArray;
+using fetch::json::JSONDocument;
+using fetch::json::OnDemandDocument;
+using fetch::json::OnDemandValue;
+using fetch::json::StructuralIndex;
+
+using Kernel = StructuralIndex::Kernel;
+
+/**
+ * Generate a document with the shape of a bulk transaction submission: an array of objects with a
+ * version and a large base64 payload, along with some metadata
+ */
+ConstByteArray GenerateDocument(std::size_t count)
+{
+  static char const ALPHABET[] =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+  std::mt19937 rng{42};
+
+  std::string text = "[";
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    std::string data(260, '=');
+    for (std::size_t j = 0; j < 256; ++j)
+    {
+      data[j] = ALPHABET[rng() % 64u];
+    }
+
+    text += (i == 0) ? "\n  " : ",\n  ";
+    text += R"({"ver": "1.2", "data": ")" + data + R"(", "metadata": {"nonce": )" +
+            std::to_string(rng()) + R"(, "valid": true}})";
+  }
+  text += "\n]";
+
+  return ConstByteArray{text};
+}
+
+void ReportThroughput(benchmark::State &state, ConstByteArray const &document)
+{
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(document.size()));
+}
+
+void Json_Document(benchmark::State &state)
+{
+  ConstByteArray const document = GenerateDocument(static_cast<std::size_t>(state.range(0)));
+
+  for (auto _ : state)
+  {
+    JSONDocument doc{document};
+    benchmark::DoNotOptimize(doc.root().size());
+  }
+
+  ReportThroughput(state, document);
+}
+
+void Json_StructuralIndex(benchmark::State &state, Kernel kernel)
+{
+  if (!StructuralIndex::IsSupported(kernel))
+  {
+    state.SkipWithError("Kernel not supported by this CPU");
+    return;
+  }
+
+  ConstByteArray const document = GenerateDocument(static_cast<std::size_t>(state.range(0)));
+
+  StructuralIndex index;
+  for (auto _ : state)
+  {
+    index.Build(document, kernel);
+    benchmark::DoNotOptimize(index.size());
+  }
+
+  ReportThroughput(state, document);
+}
+
+void Json_OnDemand(benchmark::State &state)
+{
+  ConstByteArray const document = GenerateDocument(static_cast<std::size_t>(state.range(0)));
+
+  ConstByteArray const version_key{"ver"};
+  ConstByteArray const data_key{"data"};
+
+  OnDemandDocument doc;
+  for (auto _ : state)
+  {
+    doc.Parse(document);
+
+    // pull out the fields used to decode a transaction
+    std::size_t total{0};
+    doc.root().ForEach([&](OnDemandValue const &element) {
+      OnDemandValue value;
+      if (element.Find(version_key, value))
+      {
+        total += value.AsString().size();
+      }
+      if (element.Find(data_key, value))
+      {
+        total += value.AsString().size();
+      }
+    });
+
+    benchmark::DoNotOptimize(total);
+  }
+
+  ReportThroughput(state, document);
+}
+
+}  // namespace
+
+BENCHMARK(Json_Document)->Arg(10000)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(Json_StructuralIndex, scalar, Kernel::SCALAR)
+    ->Arg(10000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(Json_StructuralIndex, sse2, Kernel::SSE2)
+    ->Arg(10000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(Json_StructuralIndex, avx2, Kernel::AVX2)
+    ->Arg(10000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(Json_OnDemand)->Arg(10000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,110 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/logger.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <mutex>
+#include <sstream>
+
+namespace {
+
+using Level = fetch::log::DefaultLogger::Level;
+
+constexpr char const *LOGGING_NAME = "LoggerBench";
+constexpr char const *NULL_DEVICE  = "/dev/null";
+
+/**
+ * Route the output of the logger to the null device so that only the cost of the log call (and
+ * not the terminal) is measured
+ */
+bool ConfigureLogger()
+{
+  return fetch::logger.SetOutputFile(NULL_DEVICE);
+}
+
+bool const logger_configured = ConfigureLogger();
+
+/**
+ * Baseline: every thread formats and writes its entry while holding a single global lock (the
+ * previous behaviour of the logger)
+ */
+void LogSerialised(benchmark::State &state)
+{
+  static std::mutex  lock;
+  static std::FILE * output = std::fopen(NULL_DEVICE, "w");
+  std::ostringstream buffer;
+
+  uint64_t counter{0};
+  for (auto _ : state)
+  {
+    std::lock_guard<std::mutex> guard(lock);
+
+    buffer.str(std::string{});
+    buffer << "[ " << LOGGING_NAME << " ] Processed item: " << counter++ << " of " << 1000 << '\n';
+
+    auto const entry = buffer.str();
+    std::fwrite(entry.data(), 1, entry.size(), output);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * Log an entry through the asynchronous logger
+ */
+void LogEnabled(benchmark::State &state)
+{
+  fetch::logger.SetLevel(Level::DEBUG);
+
+  uint64_t counter{0};
+  for (auto _ : state)
+  {
+    FETCH_LOG_INFO(LOGGING_NAME, "Processed item: ", counter++, " of ", 1000);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+
+  auto const dropped        = static_cast<double>(fetch::logger.dropped_count());
+  state.counters["dropped"] = benchmark::Counter(dropped, benchmark::Counter::kAvgThreads);
+}
+
+/**
+ * Log an entry whose level has been disabled at runtime
+ */
+void LogDisabled(benchmark::State &state)
+{
+  fetch::logger.SetLevel(Level::WARNING);
+
+  uint64_t counter{0};
+  for (auto _ : state)
+  {
+    FETCH_LOG_INFO(LOGGING_NAME, "Processed item: ", counter++, " of ", 1000);
+  }
+
+  benchmark::DoNotOptimize(counter);
+  state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace
+
+BENCHMARK(LogSerialised)->Threads(1)->Threads(32)->UseRealTime();
+BENCHMARK(LogEnabled)->Threads(1)->Threads(32)->UseRealTime();
+BENCHMARK(LogDisabled)->Threads(1)->Threads(32)->UseRealTime();
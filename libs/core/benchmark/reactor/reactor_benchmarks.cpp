@@ -0,0 +1,195 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/reactor.hpp"
+#include "core/state_machine.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using fetch::core::Reactor;
+using fetch::core::StateMachine;
+
+enum class State
+{
+  IDLE,
+  ACTIVE,
+};
+
+using Machine    = StateMachine<State>;
+using MachinePtr = std::shared_ptr<Machine>;
+
+/**
+ * A state machine which is woken by its predecessor in a chain, and in turn wakes its successor
+ */
+class Stage
+{
+public:
+  explicit Stage(std::atomic<std::size_t> &completed)
+    : machine_{std::make_shared<Machine>("Stage", State::IDLE)}
+    , completed_{completed}
+  {
+    machine_->RegisterHandler(State::IDLE, this, &Stage::OnIdle);
+    machine_->RegisterHandler(State::ACTIVE, this, &Stage::OnActive);
+  }
+
+  State OnIdle()
+  {
+    if (triggered_.exchange(false))
+    {
+      return State::ACTIVE;
+    }
+
+    // only a wake up will cause the machine to be executed again
+    machine_->Delay(std::chrono::hours{1});
+
+    return State::IDLE;
+  }
+
+  State OnActive()
+  {
+    if (next_)
+    {
+      next_->Trigger();
+    }
+    else
+    {
+      ++completed_;
+    }
+
+    return State::IDLE;
+  }
+
+  void Trigger()
+  {
+    triggered_ = true;
+    machine_->Wake();
+  }
+
+  MachinePtr machine_;
+  Stage *    next_{nullptr};
+
+private:
+  std::atomic<bool>         triggered_{false};
+  std::atomic<std::size_t> &completed_;
+};
+
+/**
+ * A state machine which generates background load by doing a small amount of work every
+ * millisecond
+ */
+class Background
+{
+public:
+  Background()
+    : machine_{std::make_shared<Machine>("Background", State::ACTIVE)}
+  {
+    machine_->RegisterHandler(State::ACTIVE, this, &Background::OnActive);
+  }
+
+  State OnActive()
+  {
+    for (std::size_t i = 0; i < 1000; ++i)
+    {
+      benchmark::DoNotOptimize(counter_ += i);
+    }
+
+    machine_->Delay(std::chrono::milliseconds{1});
+
+    return State::ACTIVE;
+  }
+
+  MachinePtr machine_;
+
+private:
+  std::size_t counter_{0};
+};
+
+/**
+ * Measure the time taken for a wake up to propagate through a chain of state machines, while a
+ * number of other state machines generate background load on the reactor
+ *
+ * Arguments: number of background state machines, number of reactor workers
+ */
+void Reactor_StateTransitionLatency(benchmark::State &state)
+{
+  static constexpr std::size_t CHAIN_LENGTH = 4;
+
+  auto const num_background = static_cast<std::size_t>(state.range(0));
+  auto const num_workers    = static_cast<std::size_t>(state.range(1));
+
+  Reactor reactor{"Bench", num_workers};
+
+  std::atomic<std::size_t> completed{0};
+
+  std::vector<std::unique_ptr<Stage>> stages;
+  for (std::size_t i = 0; i < CHAIN_LENGTH; ++i)
+  {
+    stages.emplace_back(std::make_unique<Stage>(completed));
+    reactor.Attach(stages.back()->machine_);
+
+    if (i > 0)
+    {
+      stages[i - 1]->next_ = stages[i].get();
+    }
+  }
+
+  std::vector<std::unique_ptr<Background>> background;
+  for (std::size_t i = 0; i < num_background; ++i)
+  {
+    background.emplace_back(std::make_unique<Background>());
+    reactor.Attach(background.back()->machine_);
+  }
+
+  reactor.Start();
+
+  std::size_t expected{0};
+  for (auto _ : state)
+  {
+    stages.front()->Trigger();
+    ++expected;
+
+    while (completed < expected)
+    {
+      std::this_thread::yield();
+    }
+  }
+
+  reactor.Stop();
+
+  state.counters["transitions"] = benchmark::Counter(
+      static_cast<double>(state.iterations() * CHAIN_LENGTH), benchmark::Counter::kIsRate);
+}
+
+}  // namespace
+
+BENCHMARK(Reactor_StateTransitionLatency)
+    ->Args({0, 1})
+    ->Args({0, 4})
+    ->Args({16, 1})
+    ->Args({16, 4})
+    ->Args({128, 4})
+    ->UseRealTime();
@@ -0,0 +1,109 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/containers/lock_free_queue.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace fetch {
+namespace log {
+
+/**
+ * Background writer for formatted log records
+ *
+ * Records are submitted (fully formatted) through a bounded lock free queue and written out in
+ * batches by a dedicated thread, so that the threads generating the log records never contend on
+ * the output stream. Submitting a record never blocks: if the queue is full the record is dropped
+ * and counted, and the writer reports the number of dropped records in the output.
+ */
+class AsyncLogWriter
+{
+public:
+  static constexpr std::size_t QUEUE_SIZE     = 1u << 14u;
+  static constexpr std::size_t MAX_BATCH_SIZE = 256;
+
+  // Construction / Destruction
+  explicit AsyncLogWriter(std::FILE *stream = stdout);
+  AsyncLogWriter(AsyncLogWriter const &) = delete;
+  AsyncLogWriter(AsyncLogWriter &&)      = delete;
+  ~AsyncLogWriter();
+
+  /// @name Output Configuration
+  /// @{
+  bool SetOutputFile(std::string const &filename);
+  void SetOutputStream(std::FILE *stream);
+  /// @}
+
+  /// @name Record Submission
+  /// @{
+  bool Write(std::string record);
+  void Flush();
+  /// @}
+
+  /// @name Statistics
+  /// @{
+  uint64_t written_count() const;
+  uint64_t dropped_count() const;
+  /// @}
+
+  // Operators
+  AsyncLogWriter &operator=(AsyncLogWriter const &) = delete;
+  AsyncLogWriter &operator=(AsyncLogWriter &&) = delete;
+
+private:
+  using Queue    = core::LockFreeQueue<std::string, QUEUE_SIZE>;
+  using QueuePtr = std::unique_ptr<Queue>;
+  using Counter  = std::atomic<uint64_t>;
+  using Flag     = std::atomic<bool>;
+
+  void ThreadEntryPoint();
+  void WriteToStream(std::string const &output);
+  void CloseOwnedStream();
+
+  QueuePtr    queue_;                ///< The queue of formatted records
+  std::mutex  stream_lock_;          ///< Protects the output stream
+  std::FILE * stream_{nullptr};      ///< The current output stream
+  bool        owns_stream_{false};   ///< Flag to signal the stream should be closed by the writer
+  Counter     submitted_count_{0};   ///< The number of records added to the queue
+  Counter     written_count_{0};     ///< The number of records written to the output stream
+  Counter     dropped_count_{0};     ///< The number of records dropped because the queue was full
+  uint64_t    reported_dropped_{0};  ///< The number of dropped records already reported
+  Flag        running_{true};        ///< Flag to signal the writer thread to stop
+  std::thread thread_;               ///< The background writer thread
+};
+
+inline uint64_t AsyncLogWriter::written_count() const
+{
+  return written_count_;
+}
+
+inline uint64_t AsyncLogWriter::dropped_count() const
+{
+  return dropped_count_;
+}
+
+}  // namespace log
+}  // namespace fetch
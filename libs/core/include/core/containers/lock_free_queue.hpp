@@ -0,0 +1,664 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "meta/log2.hpp"
+#include "meta/type_traits.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace fetch {
+namespace core {
+
+/**
+ * Bounded, lock free, multi-producer multi-consumer queue
+ *
+ * The implementation is a ring of cells, each carrying a sequence number which determines whether
+ * the cell is free to be written (sequence == position) or ready to be read
+ * (sequence == position + 1). Producers and consumers claim positions with a single CAS on their
+ * respective (cache line padded) indices, so neither side ever takes a lock while the queue is
+ * neither full nor empty.
+ *
+ * The blocking interface is layered on top: a thread that can not make progress spins briefly
+ * and then parks on a condition variable. The opposing side only touches the mutex when it knows
+ * that there are parked threads.
+ *
+ * @tparam T The type of element to be stored in the queue
+ * @tparam SIZE The max size of the queue (must be a power of 2)
+ */
+template <typename T, std::size_t SIZE>
+class LockFreeQueue
+{
+public:
+  static constexpr std::size_t QUEUE_LENGTH = SIZE;
+
+  using Element = T;
+
+  static_assert(std::is_move_assignable<T>::value, "T must be move assignable");
+  static_assert(std::is_default_constructible<T>::value, "T must be default constructable");
+
+  // Construction / Destruction
+  LockFreeQueue();
+  LockFreeQueue(LockFreeQueue const &) = delete;
+  LockFreeQueue(LockFreeQueue &&)      = delete;
+  ~LockFreeQueue()                     = default;
+
+  /// @name Queue Interaction
+  /// @{
+  T Pop();
+  template <typename R, typename P>
+  bool Pop(T &value, std::chrono::duration<R, P> const &duration);
+  template <typename U>
+  meta::EnableIfSame<T, meta::Decay<U>> Push(U &&element);
+  template <typename U>
+  meta::EnableIfSame<T, meta::Decay<U>> Push(U &&element, std::size_t &count);
+  template <typename U, typename R, typename P>
+  meta::EnableIfSame<T, meta::Decay<U>, bool> Push(U &&element, std::size_t &count,
+                                                   std::chrono::duration<R, P> const &duration);
+  /// @}
+
+  /// @name Non-blocking Interaction
+  /// @{
+  bool TryPop(T &value);
+  template <typename U>
+  meta::EnableIfSame<T, meta::Decay<U>, bool> TryPush(U &&element);
+  /// @}
+
+  /// @name Bulk Interaction
+  /// @{
+  template <typename Iterator>
+  void PushMany(Iterator begin, Iterator end);
+  template <typename Container, typename R, typename P>
+  std::size_t PopMany(Container &values, std::size_t max_count,
+                      std::chrono::duration<R, P> const &duration);
+  /// @}
+
+  std::size_t size() const;
+  bool        empty() const;
+
+  // Operators
+  LockFreeQueue &operator=(LockFreeQueue const &) = delete;
+  LockFreeQueue &operator=(LockFreeQueue &&) = delete;
+
+private:
+  static constexpr std::size_t MASK            = SIZE - 1;
+  static constexpr std::size_t CACHE_LINE_SIZE = 64;
+  static constexpr std::size_t SPIN_COUNT      = 64;
+
+  using Index     = std::atomic<std::size_t>;
+  using Clock     = std::chrono::steady_clock;
+  using Timepoint = Clock::time_point;
+
+  struct Cell
+  {
+    Index sequence{0};
+    T     data{};
+  };
+
+  using Cells   = std::array<Cell, SIZE>;
+  using Padding = std::array<char, CACHE_LINE_SIZE - sizeof(Index)>;
+
+  /**
+   * The set of threads parked on one side of the queue
+   */
+  struct Waiters
+  {
+    std::mutex              lock;
+    std::condition_variable condition;
+    Index                   count{0};
+
+    void Notify(bool all);
+  };
+
+  template <typename Attempt, typename Ready>
+  bool WaitFor(Waiters &waiters, Attempt &&attempt, Ready &&ready, Timepoint const *deadline);
+
+  bool        IsReadable() const;
+  bool        IsWritable() const;
+  std::size_t ClaimForWrite(std::size_t max_count, std::size_t &position);
+  std::size_t ClaimForRead(std::size_t max_count, std::size_t &position);
+
+  Padding pad0_{};
+  Index   write_index_{0};  ///< The next position to be claimed by producers
+  Padding pad1_{};
+  Index   read_index_{0};  ///< The next position to be claimed by consumers
+  Padding pad2_{};
+  Cells   cells_;      ///< The ring of cells
+  Waiters consumers_;  ///< Consumers waiting for an element to become available
+  Waiters producers_;  ///< Producers waiting for a free cell
+
+  // static asserts
+  static_assert(meta::IsLog2(SIZE), "Queue size must be a valid power of 2");
+};
+
+/**
+ * Construct the queue, marking all the cells as writable
+ */
+template <typename T, std::size_t N>
+LockFreeQueue<T, N>::LockFreeQueue()
+{
+  for (std::size_t i = 0; i < N; ++i)
+  {
+    cells_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+}
+
+/**
+ * Pop an element from the queue
+ *
+ * If no element is available then the function will block until an element is available.
+ *
+ * @tparam T The type of element to be stored in the queue
+ * @tparam N The max size of the queue
+ * @return The element retrieved from the queue
+ */
+template <typename T, std::size_t N>
+T LockFreeQueue<T, N>::Pop()
+{
+  T value;
+  WaitFor(consumers_, [this, &value]() { return TryPop(value); },
+          [this]() { return IsReadable(); }, nullptr);
+  return value;
+}
+
+/**
+ * Pop an element from the queue with a specified maximum wait duration
+ *
+ * @tparam T The type of element to be stored in the queue
+ * @tparam N The max size of the queue
+ * @tparam R The tick representation for the duration
+ * @tparam P The tick period for the duration
+ * @param value The reference to the value to be populated
+ * @param duration The maximum amount of time to wait for an element
+ * @return true if an element was extracted, otherwise false
+ */
+template <typename T, std::size_t N>
+template <typename R, typename P>
+bool LockFreeQueue<T, N>::Pop(T &value, std::chrono::duration<R, P> const &duration)
+{
+  Timepoint const deadline = Clock::now() + duration;
+  return WaitFor(consumers_, [this, &value]() { return TryPop(value); },
+                 [this]() { return IsReadable(); }, &deadline);
+}
+
+/**
+ * Push an element onto the queue
+ *
+ * If the queue is full this function will block until an element can be added
+ *
+ * @tparam T The type of element to be stored in the queue
+ * @tparam N The max size of the queue
+ * @tparam U Universal reference type of the element
+ * @param element The universal reference to the element
+ */
+template <typename T, std::size_t N>
+template <typename U>
+meta::EnableIfSame<T, meta::Decay<U>> LockFreeQueue<T, N>::Push(U &&element)
+{
+  WaitFor(producers_, [this, &element]() { return TryPush(std::forward<U>(element)); },
+          [this]() { return IsWritable(); }, nullptr);
+}
+
+/**
+ * Push an element onto the queue
+ *
+ * If the queue is full this function will block until an element can be added
+ *
+ * @tparam T The type of element to be stored in the queue
+ * @tparam N The max size of the queue
+ * @tparam U Universal reference type of the element
+ * @param element The universal reference to the element
+ * @param count Number of enqueued elements still waiting in the queue to be processed.
+ */
+template <typename T, std::size_t N>
+template <typename U>
+meta::EnableIfSame<T, meta::Decay<U>> LockFreeQueue<T, N>::Push(U &&element, std::size_t &count)
+{
+  Push(std::forward<U>(element));
+  count = size();
+}
+
+/**
+ * Push an element onto the queue
+ *
+ * If the queue is full this function will block until an element can be added or the specified
+ * duration has elapsed
+ *
+ * @tparam T The type of element to be stored in the queue
+ * @tparam N The max size of the queue
+ * @tparam U Universal reference type of the element
+ * @tparam R The tick representation for the duration
+ * @tparam P The tick period for the duration
+ * @param element The universal reference to the element
+ * @param count Number of enqueued elements still waiting in the queue to be processed.
+ * @param duration The maximum amount of time to wait for being able to insert the element
+ * @return true if an element was inserted in given timeout, otherwise false
+ */
+template <typename T, std::size_t N>
+template <typename U, typename R, typename P>
+meta::EnableIfSame<T, meta::Decay<U>, bool> LockFreeQueue<T, N>::Push(
+    U &&element, std::size_t &count, std::chrono::duration<R, P> const &duration)
+{
+  Timepoint const deadline = Clock::now() + duration;
+
+  if (!WaitFor(producers_, [this, &element]() { return TryPush(std::forward<U>(element)); },
+               [this]() { return IsWritable(); }, &deadline))
+  {
+    return false;
+  }
+
+  count = size();
+  return true;
+}
+
+/**
+ * Attempt to pop an element from the queue without blocking
+ *
+ * @tparam T The type of element to be stored in the queue
+ * @tparam N The max size of the queue
+ * @param value The reference to the value to be populated
+ * @return true if an element was extracted, otherwise false
+ */
+template <typename T, std::size_t N>
+bool LockFreeQueue<T, N>::TryPop(T &value)
+{
+  std::size_t position{0};
+  if (ClaimForRead(1, position) == 0)
+  {
+    return false;
+  }
+
+  Cell &cell = cells_[position & MASK];
+  value      = std::move(cell.data);
+  cell.sequence.store(position + N, std::memory_order_release);
+
+  producers_.Notify(false);
+
+  return true;
+}
+
+/**
+ * Attempt to push an element onto the queue without blocking
+ *
+ * The element is only moved from when the push is successful.
+ *
+ * @tparam T The type of element to be stored in the queue
+ * @tparam N The max size of the queue
+ * @tparam U Universal reference type of the element
+ * @param element The universal reference to the element
+ * @return true if the element was added, otherwise false
+ */
+template <typename T, std::size_t N>
+template <typename U>
+meta::EnableIfSame<T, meta::Decay<U>, bool> LockFreeQueue<T, N>::TryPush(U &&element)
+{
+  std::size_t position{0};
+  if (ClaimForWrite(1, position) == 0)
+  {
+    return false;
+  }
+
+  Cell &cell = cells_[position & MASK];
+  cell.data  = std::forward<U>(element);
+  cell.sequence.store(position + 1, std::memory_order_release);
+
+  consumers_.Notify(false);
+
+  return true;
+}
+
+/**
+ * Push a range of elements onto the queue
+ *
+ * Contiguous runs of free cells are claimed with a single update of the write index. If the queue
+ * is full this function will block until all the elements have been added.
+ *
+ * @tparam T The type of element to be stored in the queue
+ * @tparam N The max size of the queue
+ * @tparam Iterator The input iterator type (use a move iterator to move the elements)
+ * @param begin The start of the range of elements
+ * @param end The end of the range of elements
+ */
+template <typename T, std::size_t N>
+template <typename Iterator>
+void LockFreeQueue<T, N>::PushMany(Iterator begin, Iterator end)
+{
+  while (begin != end)
+  {
+    auto const remaining = static_cast<std::size_t>(std::distance(begin, end));
+
+    std::size_t position{0};
+    std::size_t claimed{0};
+    WaitFor(producers_,
+            [this, remaining, &position, &claimed]() {
+              claimed = ClaimForWrite(remaining, position);
+              return claimed > 0;
+            },
+            [this]() { return IsWritable(); }, nullptr);
+
+    for (std::size_t i = 0; i < claimed; ++i, ++begin)
+    {
+      Cell &cell = cells_[(position + i) & MASK];
+      cell.data  = *begin;
+      cell.sequence.store(position + i + 1, std::memory_order_release);
+    }
+
+    consumers_.Notify(true);
+  }
+}
+
+/**
+ * Pop a number of elements from the queue
+ *
+ * Blocks maximally for the specified duration until at least one element is available and then
+ * extracts up to the specified number of elements which are appended to the container.
+ *
+ * @tparam T The type of element to be stored in the queue
+ * @tparam N The max size of the queue
+ * @tparam Container The container type (must support push_back)
+ * @tparam R The tick representation for the duration
+ * @tparam P The tick period for the duration
+ * @param values The container to which the elements are appended
+ * @param max_count The maximum number of elements to be extracted
+ * @param duration The maximum amount of time to wait for an element
+ * @return The number of elements extracted
+ */
+template <typename T, std::size_t N>
+template <typename Container, typename R, typename P>
+std::size_t LockFreeQueue<T, N>::PopMany(Container &values, std::size_t max_count,
+                                         std::chrono::duration<R, P> const &duration)
+{
+  if (max_count == 0)
+  {
+    return 0;
+  }
+
+  Timepoint const deadline = Clock::now() + duration;
+
+  std::size_t position{0};
+  std::size_t claimed{0};
+  bool const  success = WaitFor(consumers_,
+                               [this, max_count, &position, &claimed]() {
+                                 claimed = ClaimForRead(max_count, position);
+                                 return claimed > 0;
+                               },
+                               [this]() { return IsReadable(); }, &deadline);
+
+  if (!success)
+  {
+    return 0;
+  }
+
+  for (std::size_t i = 0; i < claimed; ++i)
+  {
+    Cell &cell = cells_[(position + i) & MASK];
+    values.push_back(std::move(cell.data));
+    cell.sequence.store(position + i + N, std::memory_order_release);
+  }
+
+  producers_.Notify(true);
+
+  return claimed;
+}
+
+/**
+ * Get the (approximate) number of elements in the queue
+ *
+ * @return The number of elements
+ */
+template <typename T, std::size_t N>
+std::size_t LockFreeQueue<T, N>::size() const
+{
+  std::size_t const read  = read_index_.load(std::memory_order_relaxed);
+  std::size_t const write = write_index_.load(std::memory_order_relaxed);
+
+  return (write > read) ? (write - read) : 0;
+}
+
+/**
+ * Determine if the queue is (approximately) empty
+ *
+ * @return true if the queue is empty, otherwise false
+ */
+template <typename T, std::size_t N>
+bool LockFreeQueue<T, N>::empty() const
+{
+  return size() == 0;
+}
+
+/**
+ * Internal: Wake one or all of the threads parked on this side of the queue
+ *
+ * @param all Flag to signal that all the threads should be woken
+ */
+template <typename T, std::size_t N>
+void LockFreeQueue<T, N>::Waiters::Notify(bool all)
+{
+  // pairs with the fence in WaitFor to ensure that either the waiter observes the update to the
+  // ring or this thread observes the waiter
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  if (count.load(std::memory_order_relaxed) > 0)
+  {
+    std::lock_guard<std::mutex> guard(lock);
+
+    if (all)
+    {
+      condition.notify_all();
+    }
+    else
+    {
+      condition.notify_one();
+    }
+  }
+}
+
+/**
+ * Internal: Repeatedly run an attempt until it succeeds or the deadline expires
+ *
+ * The attempt is never run while holding the waiters lock, since a successful attempt will notify
+ * the opposing side of the queue. Instead the side-effect free readiness check is evaluated under
+ * the lock before parking so that no notification can be lost.
+ *
+ * @tparam Attempt The type of the attempt function
+ * @tparam Ready The type of the readiness check function
+ * @param waiters The set of waiters to be joined when the attempt can not make progress
+ * @param attempt The attempt function (returning true on success)
+ * @param ready The check to determine if an attempt might succeed
+ * @param deadline The (optional) deadline for the operation
+ * @return true if the attempt was successful, otherwise false
+ */
+template <typename T, std::size_t N>
+template <typename Attempt, typename Ready>
+bool LockFreeQueue<T, N>::WaitFor(Waiters &waiters, Attempt &&attempt, Ready &&ready,
+                                  Timepoint const *deadline)
+{
+  // optimistic phase
+  for (std::size_t i = 0; i < SPIN_COUNT; ++i)
+  {
+    if (attempt())
+    {
+      return true;
+    }
+
+    if ((deadline != nullptr) && (Clock::now() >= *deadline))
+    {
+      break;
+    }
+
+    std::this_thread::yield();
+  }
+
+  // pessimistic phase
+  waiters.count.fetch_add(1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  bool success{false};
+  for (;;)
+  {
+    if (attempt())
+    {
+      success = true;
+      break;
+    }
+
+    std::unique_lock<std::mutex> guard(waiters.lock);
+    if (ready())
+    {
+      continue;
+    }
+
+    if (deadline == nullptr)
+    {
+      waiters.condition.wait(guard);
+    }
+    else if (std::cv_status::timeout == waiters.condition.wait_until(guard, *deadline))
+    {
+      guard.unlock();
+      success = attempt();
+      break;
+    }
+  }
+
+  waiters.count.fetch_sub(1, std::memory_order_relaxed);
+
+  return success;
+}
+
+/**
+ * Internal: Determine if the next cell to be read has been populated
+ *
+ * @return true if the cell is populated, otherwise false
+ */
+template <typename T, std::size_t N>
+bool LockFreeQueue<T, N>::IsReadable() const
+{
+  std::size_t const pos = read_index_.load(std::memory_order_relaxed);
+  return cells_[pos & MASK].sequence.load(std::memory_order_acquire) == (pos + 1);
+}
+
+/**
+ * Internal: Determine if the next cell to be written is free
+ *
+ * @return true if the cell is free, otherwise false
+ */
+template <typename T, std::size_t N>
+bool LockFreeQueue<T, N>::IsWritable() const
+{
+  std::size_t const pos = write_index_.load(std::memory_order_relaxed);
+  return cells_[pos & MASK].sequence.load(std::memory_order_acquire) == pos;
+}
+
+/**
+ * Internal: Claim a contiguous run of free cells for writing
+ *
+ * @param max_count The maximum number of cells to claim
+ * @param position The first claimed position (output)
+ * @return The number of cells claimed
+ */
+template <typename T, std::size_t N>
+std::size_t LockFreeQueue<T, N>::ClaimForWrite(std::size_t max_count, std::size_t &position)
+{
+  std::size_t pos = write_index_.load(std::memory_order_relaxed);
+
+  for (;;)
+  {
+    // determine the number of consecutive free cells
+    std::size_t count{0};
+    while ((count < max_count) &&
+           (cells_[(pos + count) & MASK].sequence.load(std::memory_order_acquire) == pos + count))
+    {
+      ++count;
+    }
+
+    if (count == 0)
+    {
+      std::size_t const sequence = cells_[pos & MASK].sequence.load(std::memory_order_acquire);
+
+      // the cell has not been consumed yet, i.e. the queue is full
+      if (static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos) < 0)
+      {
+        return 0;
+      }
+
+      // another producer has claimed the position
+      pos = write_index_.load(std::memory_order_relaxed);
+    }
+    else if (write_index_.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed))
+    {
+      position = pos;
+      return count;
+    }
+  }
+}
+
+/**
+ * Internal: Claim a contiguous run of populated cells for reading
+ *
+ * @param max_count The maximum number of cells to claim
+ * @param position The first claimed position (output)
+ * @return The number of cells claimed
+ */
+template <typename T, std::size_t N>
+std::size_t LockFreeQueue<T, N>::ClaimForRead(std::size_t max_count, std::size_t &position)
+{
+  std::size_t pos = read_index_.load(std::memory_order_relaxed);
+
+  for (;;)
+  {
+    // determine the number of consecutive populated cells
+    std::size_t count{0};
+    while ((count < max_count) && (cells_[(pos + count) & MASK].sequence.load(
+                                       std::memory_order_acquire) == pos + count + 1))
+    {
+      ++count;
+    }
+
+    if (count == 0)
+    {
+      std::size_t const sequence = cells_[pos & MASK].sequence.load(std::memory_order_acquire);
+
+      // the cell has not been populated yet, i.e. the queue is empty
+      if (static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1) < 0)
+      {
+        return 0;
+      }
+
+      // another consumer has claimed the position
+      pos = read_index_.load(std::memory_order_relaxed);
+    }
+    else if (read_index_.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed))
+    {
+      position = pos;
+      return count;
+    }
+  }
+}
+
+}  // namespace core
+}  // namespace fetch
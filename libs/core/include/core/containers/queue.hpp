@@ -17,6 +17,7 @@
 //
 //------------------------------------------------------------------------------
 
+#include "core/containers/lock_free_queue.hpp"
 #include "core/mutex.hpp"
 #include "core/sync/tickets.hpp"
 #include "meta/log2.hpp"
@@ -317,14 +318,16 @@ meta::EnableIfSame<T, meta::Decay<U>, bool> Queue<T, N, P, C>::Push(
 template <typename T, std::size_t N>
 using SPSCQueue = Queue<T, N, SingleThreadedIndex<N>, SingleThreadedIndex<N>>;
 
+// The multi-threaded variants are backed by the lock free ring rather than the mutex protected
+// indices
 template <typename T, std::size_t N>
-using SPMCQueue = Queue<T, N, SingleThreadedIndex<N>, MultiThreadedIndex<N>>;
+using SPMCQueue = LockFreeQueue<T, N>;
 
 template <typename T, std::size_t N>
-using MPSCQueue = Queue<T, N, MultiThreadedIndex<N>, SingleThreadedIndex<N>>;
+using MPSCQueue = LockFreeQueue<T, N>;
 
 template <typename T, std::size_t N>
-using MPMCQueue = Queue<T, N, MultiThreadedIndex<N>, MultiThreadedIndex<N>>;
+using MPMCQueue = LockFreeQueue<T, N>;
 
 }  // namespace core
 }  // namespace fetch
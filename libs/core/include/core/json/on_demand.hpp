@@ -0,0 +1,183 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/json/structural_index.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace fetch {
+namespace json {
+
+/**
+ * A value of an on-demand JSON document
+ *
+ * Values are lightweight references into the structural index of the document, which must
+ * outlive them. Nothing is decoded until it is asked for and skipping a value is a single lookup
+ * in the index, so the parts of the document which are not used cost nothing more than the
+ * indexing. Syntax errors are only detected in the parts of the document that are visited.
+ *
+ * Strings are returned as views of the document between the quotes, i.e. escape sequences are not
+ * decoded (the same as JSONDocument).
+ */
+class OnDemandValue
+{
+public:
+  using ConstByteArray = byte_array::ConstByteArray;
+
+  enum class Type
+  {
+    OBJECT,
+    ARRAY,
+    STRING,
+    NUMBER,
+    BOOLEAN,
+    NULL_VALUE,
+  };
+
+  // Construction / Destruction
+  OnDemandValue() = default;
+  OnDemandValue(StructuralIndex const &index, std::size_t entry);
+  OnDemandValue(OnDemandValue const &) = default;
+  ~OnDemandValue()                     = default;
+
+  /// @name Types
+  /// @{
+  Type type() const;
+  bool IsObject() const;
+  bool IsArray() const;
+  bool IsString() const;
+  bool IsNumber() const;
+  bool IsBoolean() const;
+  bool IsNull() const;
+  /// @}
+
+  /// @name Primitives
+  /// @{
+  ConstByteArray AsString() const;
+  int64_t        AsInteger() const;
+  double         AsFloat() const;
+  bool           AsBool() const;
+  /// @}
+
+  /// @name Objects and Arrays
+  /// @{
+  bool        Find(ConstByteArray const &key, OnDemandValue &value) const;
+  std::size_t size() const;
+
+  template <typename Function>
+  void ForEach(Function &&function) const;
+
+  template <typename Function>
+  void ForEachMember(Function &&function) const;
+  /// @}
+
+  // Operators
+  OnDemandValue &operator=(OnDemandValue const &) = default;
+
+private:
+  char           character() const;
+  ConstByteArray Scalar() const;
+  void           Expect(Type type) const;
+  std::size_t    FirstChild() const;
+  std::size_t    NextChild(std::size_t value) const;
+  std::size_t    MemberValue(std::size_t key) const;
+  ConstByteArray MemberKey(std::size_t key) const;
+  bool           KeyEquals(std::size_t key, ConstByteArray const &value) const;
+
+  StructuralIndex const *index_{nullptr};
+  std::size_t            entry_{0};
+};
+
+/**
+ * A JSON document which is decoded on demand, as its values are accessed
+ */
+class OnDemandDocument
+{
+public:
+  using ConstByteArray = byte_array::ConstByteArray;
+  using Kernel         = StructuralIndex::Kernel;
+
+  // Construction / Destruction
+  OnDemandDocument() = default;
+  explicit OnDemandDocument(ConstByteArray const &document);
+  OnDemandDocument(OnDemandDocument const &) = delete;
+  OnDemandDocument(OnDemandDocument &&)      = delete;
+  ~OnDemandDocument()                        = default;
+
+  void Parse(ConstByteArray const &document, Kernel kernel = Kernel::AUTO);
+
+  /// @name Accessors
+  /// @{
+  OnDemandValue          root() const;
+  StructuralIndex const &index() const;
+  /// @}
+
+  // Operators
+  OnDemandDocument &operator=(OnDemandDocument const &) = delete;
+  OnDemandDocument &operator=(OnDemandDocument &&) = delete;
+
+private:
+  StructuralIndex index_{};
+};
+
+/**
+ * Visit each of the elements of an array
+ *
+ * @tparam Function The type of the visitor
+ * @param function The visitor, called with each OnDemandValue element
+ * @throws JSONParseException if the value is not a (well formed) array
+ */
+template <typename Function>
+void OnDemandValue::ForEach(Function &&function) const
+{
+  Expect(Type::ARRAY);
+
+  std::size_t const end = index_->match(entry_);
+  for (std::size_t element = FirstChild(); element != end; element = NextChild(element))
+  {
+    function(OnDemandValue{*index_, element});
+  }
+}
+
+/**
+ * Visit each of the members of an object
+ *
+ * @tparam Function The type of the visitor
+ * @param function The visitor, called with the ConstByteArray key and OnDemandValue of each member
+ * @throws JSONParseException if the value is not a (well formed) object
+ */
+template <typename Function>
+void OnDemandValue::ForEachMember(Function &&function) const
+{
+  Expect(Type::OBJECT);
+
+  std::size_t const end = index_->match(entry_);
+  for (std::size_t key = FirstChild(); key != end;)
+  {
+    std::size_t const value = MemberValue(key);
+    function(MemberKey(key), OnDemandValue{*index_, value});
+
+    key = NextChild(value);
+  }
+}
+
+}  // namespace json
+}  // namespace fetch
@@ -0,0 +1,147 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace fetch {
+namespace json {
+
+/**
+ * The index of the structural characters of a JSON document
+ *
+ * The index is built in two passes. The first finds the positions of the operators, the quotes
+ * around the strings and the starts of the numbers and literals with SIMD bitmasks (see
+ * StructuralIndexer). The second walks the positions, checking the brackets are balanced and the
+ * strings terminated, and records for every bracket and opening quote the entry that closes it,
+ * so that values can be skipped over without being looked at.
+ */
+class StructuralIndex
+{
+public:
+  using ConstByteArray = byte_array::ConstByteArray;
+
+  /**
+   * The kernel which is used to find the structural characters
+   */
+  enum class Kernel
+  {
+    AUTO,    ///< The fastest kernel supported by the CPU
+    SCALAR,  ///< The portable kernel
+    SSE2,    ///< 16 bytes at a time
+    AVX2,    ///< 32 bytes at a time
+  };
+
+  // Construction / Destruction
+  StructuralIndex()                        = default;
+  StructuralIndex(StructuralIndex const &) = delete;
+  StructuralIndex(StructuralIndex &&)      = default;
+  ~StructuralIndex()                       = default;
+
+  void Build(ConstByteArray const &document, Kernel kernel = Kernel::AUTO);
+
+  /// @name Accessors
+  /// @{
+  ConstByteArray const &document() const;
+  std::size_t           size() const;
+  std::size_t           position(std::size_t entry) const;
+  std::size_t           match(std::size_t entry) const;
+  char                  character(std::size_t entry) const;
+  /// @}
+
+  static bool IsSupported(Kernel kernel);
+
+  // Operators
+  StructuralIndex &operator=(StructuralIndex const &) = delete;
+  StructuralIndex &operator=(StructuralIndex &&) = default;
+
+private:
+  using Buffer = std::unique_ptr<uint32_t[]>;
+  using Stack  = std::vector<uint32_t>;
+
+  void Reserve(std::size_t capacity);
+  void Match();
+
+  ConstByteArray document_{};
+  Buffer         positions_{};   ///< The positions of the structural characters
+  Buffer         matches_{};     ///< The entries which close the brackets and strings
+  std::size_t    capacity_{0};   ///< The capacity of the buffers
+  std::size_t    size_{0};       ///< The number of entries in the index
+  Stack          open_stack_{};  ///< The unclosed brackets, reused between documents
+};
+
+/**
+ * Get the indexed document
+ *
+ * @return The document
+ */
+inline StructuralIndex::ConstByteArray const &StructuralIndex::document() const
+{
+  return document_;
+}
+
+/**
+ * Get the number of structural characters in the document
+ *
+ * @return The number of entries
+ */
+inline std::size_t StructuralIndex::size() const
+{
+  return size_;
+}
+
+/**
+ * Get the position of an entry in the document
+ *
+ * @param entry The index entry
+ * @return The offset of the structural character
+ */
+inline std::size_t StructuralIndex::position(std::size_t entry) const
+{
+  return positions_[entry];
+}
+
+/**
+ * Get the entry which closes a bracket or string. Every other entry is matched with itself.
+ *
+ * @param entry The index entry
+ * @return The matching index entry
+ */
+inline std::size_t StructuralIndex::match(std::size_t entry) const
+{
+  return matches_[entry];
+}
+
+/**
+ * Get the structural character of an entry
+ *
+ * @param entry The index entry
+ * @return The character
+ */
+inline char StructuralIndex::character(std::size_t entry) const
+{
+  return document_.char_pointer()[positions_[entry]];
+}
+
+}  // namespace json
+}  // namespace fetch
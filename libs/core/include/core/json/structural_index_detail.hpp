@@ -0,0 +1,224 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace fetch {
+namespace json {
+namespace detail {
+
+/**
+ * The character classes of a 64 byte block of a document, one bit per byte
+ */
+struct CharacterMasks
+{
+  uint64_t quotes{0};       ///< The '"' characters
+  uint64_t backslashes{0};  ///< The '\' characters
+  uint64_t operators{0};    ///< The '{', '}', '[', ']', ':' and ',' characters
+  uint64_t whitespace{0};   ///< The ' ', '\t', '\n' and '\r' characters
+};
+
+/**
+ * Stage 1 of the on-demand JSON parser
+ *
+ * Finds the positions of the structural characters of a document, 64 bytes at a time. The
+ * structural characters are the operators outside of strings, the (unescaped) quotes which open
+ * and close the strings, and the first characters of the numbers and literals. The character
+ * classification of each block is provided by the Ops type:
+ *
+ *   Classify(block)     Compute the CharacterMasks of 64 bytes
+ *
+ * Everything else is done with 64 bit integer operations on the masks: the escaped characters are
+ * found from the lengths of the runs of backslashes and the bytes inside of strings are found with
+ * a prefix XOR of the quotes.
+ *
+ * In order that the kernels for the different instruction sets can be compiled with different
+ * target options the Ops types are expected to have internal linkage, so that every instantiation
+ * of this template is private to the translation unit that defines its Ops.
+ *
+ * @tparam Ops The character classification operations
+ */
+template <typename Ops>
+struct StructuralIndexer
+{
+  static constexpr std::size_t BLOCK_SIZE = 64;
+
+  /**
+   * Index a document
+   *
+   * @param data The document to be indexed
+   * @param size The size of the document in bytes
+   * @param positions The output buffer for the positions, at least size entries
+   * @return The number of structural characters found
+   */
+  static std::size_t Index(uint8_t const *data, std::size_t size, uint32_t *positions)
+  {
+    State     state{};
+    uint32_t *output = positions;
+
+    std::size_t offset = 0;
+    for (; (offset + BLOCK_SIZE) <= size; offset += BLOCK_SIZE)
+    {
+      output = Flatten(output, static_cast<uint32_t>(offset), Process(data + offset, state));
+    }
+
+    // the tail of the document is padded with whitespace, which is never structural
+    if (offset < size)
+    {
+      uint8_t block[BLOCK_SIZE];
+      std::memset(block, ' ', BLOCK_SIZE);
+      std::memcpy(block, data + offset, size - offset);
+
+      output = Flatten(output, static_cast<uint32_t>(offset), Process(block, state));
+    }
+
+    return static_cast<std::size_t>(output - positions);
+  }
+
+private:
+  static constexpr uint64_t EVEN_BITS = 0x5555555555555555ull;
+  static constexpr uint64_t ODD_BITS  = ~EVEN_BITS;
+
+  /**
+   * The state carried from one block to the next
+   */
+  struct State
+  {
+    uint64_t odd_backslashes{0};  ///< 1 if the block ended with an odd run of backslashes
+    uint64_t in_string{0};        ///< All ones if the block ended inside of a string
+    uint64_t separator{1};        ///< 1 if the block ended with a separator (or quote)
+  };
+
+  /**
+   * Find the characters which are escaped, i.e. those which follow an odd length run of
+   * backslashes
+   *
+   * @param backslashes The backslashes of the block
+   * @param state The state to be updated
+   * @return The mask of the escaped characters
+   */
+  static uint64_t FindEscaped(uint64_t backslashes, State &state)
+  {
+    // the runs of backslashes that start on even and odd bits
+    uint64_t const starts      = backslashes & ~(backslashes << 1u);
+    uint64_t const even_starts = starts & (EVEN_BITS ^ state.odd_backslashes);
+    uint64_t const odd_starts  = starts & ~(EVEN_BITS ^ state.odd_backslashes);
+
+    // adding the starts to the runs carries a bit to the character following each run
+    uint64_t const even_carries = backslashes + even_starts;
+    uint64_t       odd_carries  = backslashes + odd_starts;
+    bool const     overflow     = odd_carries < backslashes;
+
+    odd_carries |= state.odd_backslashes;
+    state.odd_backslashes = overflow ? 1u : 0u;
+
+    // a run is odd in length when it starts and ends on bits of differing parity
+    uint64_t const even_carry_ends = even_carries & ~backslashes;
+    uint64_t const odd_carry_ends  = odd_carries & ~backslashes;
+
+    return (even_carry_ends & ODD_BITS) | (odd_carry_ends & EVEN_BITS);
+  }
+
+  /**
+   * Compute the XOR of all the preceding bits of the mask (inclusive)
+   *
+   * @param mask The input mask
+   * @return The prefix XOR of the mask
+   */
+  static uint64_t PrefixXor(uint64_t mask)
+  {
+    mask ^= mask << 1u;
+    mask ^= mask << 2u;
+    mask ^= mask << 4u;
+    mask ^= mask << 8u;
+    mask ^= mask << 16u;
+    mask ^= mask << 32u;
+
+    return mask;
+  }
+
+  /**
+   * Compute the structural characters of a block
+   *
+   * @param block The 64 bytes of the block
+   * @param state The state carried between the blocks
+   * @return The mask of the structural characters
+   */
+  static uint64_t Process(uint8_t const *block, State &state)
+  {
+    CharacterMasks const masks = Ops::Classify(block);
+
+    // the quotes which open and close the strings
+    uint64_t const quotes = masks.quotes & ~FindEscaped(masks.backslashes, state);
+
+    // the bytes inside of strings, including the opening quotes (but not the closing ones)
+    uint64_t const in_string = PrefixXor(quotes) ^ state.in_string;
+    state.in_string          = static_cast<uint64_t>(static_cast<int64_t>(in_string) >> 63u);
+
+    // the numbers and literals start with the first character following a separator
+    uint64_t const separators = masks.operators | masks.whitespace | quotes;
+    uint64_t const scalars    = ~separators & ~in_string;
+    uint64_t const starts     = scalars & ((separators << 1u) | state.separator);
+    state.separator           = separators >> 63u;
+
+    return (masks.operators & ~in_string) | quotes | starts;
+  }
+
+  /**
+   * Append the positions of the bits of the mask to the output buffer
+   *
+   * @param output The output buffer
+   * @param offset The offset of the block in the document
+   * @param mask The mask of the structural characters
+   * @return The updated position of the output buffer
+   */
+  static uint32_t *Flatten(uint32_t *output, uint32_t offset, uint64_t mask)
+  {
+    while (mask != 0)
+    {
+      *output++ = offset + static_cast<uint32_t>(__builtin_ctzll(mask));
+      mask &= mask - 1u;
+    }
+
+    return output;
+  }
+};
+
+template <typename Ops>
+constexpr std::size_t StructuralIndexer<Ops>::BLOCK_SIZE;
+
+template <typename Ops>
+constexpr uint64_t StructuralIndexer<Ops>::EVEN_BITS;
+
+template <typename Ops>
+constexpr uint64_t StructuralIndexer<Ops>::ODD_BITS;
+
+/// @name Indexing Kernels
+/// @{
+std::size_t StructuralIndexScalar(uint8_t const *data, std::size_t size, uint32_t *positions);
+std::size_t StructuralIndexSSE2(uint8_t const *data, std::size_t size, uint32_t *positions);
+std::size_t StructuralIndexAVX2(uint8_t const *data, std::size_t size, uint32_t *positions);
+bool        StructuralIndexHasAVX2Kernel();
+/// @}
+
+}  // namespace detail
+}  // namespace json
+}  // namespace fetch
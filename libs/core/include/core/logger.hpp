@@ -18,6 +18,7 @@
 //------------------------------------------------------------------------------
 
 #include "core/abstract_mutex.hpp"
+#include "core/async_log_writer.hpp"
 #include "core/commandline/vt100.hpp"
 #include <atomic>
 #include <chrono>
@@ -26,6 +27,8 @@
 #include <iomanip>
 #include <iostream>
 #include <mutex>
+#include <sstream>
+#include <string>
 #include <thread>
 #include <unordered_map>
 #include <unordered_set>
@@ -172,6 +175,13 @@ private:
   std::chrono::high_resolution_clock::time_point created_;
 };
 
+/**
+ * The default log formatter
+ *
+ * Each thread formats its entries into its own buffer, completed entries are then handed over to
+ * an asynchronous writer which batches the output to stdout (or a file). The formatting of a log
+ * entry therefore never contends with the other logging threads.
+ */
 class DefaultLogger
 {
 public:
@@ -225,19 +235,23 @@ public:
       break;
     }
 
-    int const       thread_number = ReadableThread::GetThreadID(std::this_thread::get_id());
+    int const       thread_number = ThreadNumber();
     Timepoint const now           = Clock::now();
     Duration const  duration      = now.time_since_epoch();
 
     auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(duration).count() % 1000;
 
     // format and generate the time
-    std::time_t now_c = std::chrono::system_clock::to_time_t(now);
-    std::cout << "[ " << GetColor(color, bg_color) << std::put_time(std::localtime(&now_c), "%F %T")
-              << "." << std::setw(3) << millis << DefaultAttributes();
+    std::tm           local_time{};
+    std::time_t const now_c = std::chrono::system_clock::to_time_t(now);
+    localtime_r(&now_c, &local_time);
+
+    auto &buffer = Buffer();
+    buffer << "[ " << GetColor(color, bg_color) << std::put_time(&local_time, "%F %T") << "."
+           << std::setw(3) << millis << DefaultAttributes();
 
     // thread information
-    std::cout << ", #" << std::setw(2) << thread_number << ' ' << level_name;
+    buffer << ", #" << std::setw(2) << thread_number << ' ' << level_name;
 
     // determine which of the two logging formats we should use
     bool use_name = name != nullptr;
@@ -249,14 +263,14 @@ public:
 
     if (use_name)
     {
-      std::cout << ": " << std::setw(35) << name << " ] ";
+      buffer << ": " << std::setw(35) << name << " ] ";
     }
     else
     {
-      std::cout << ": " << std::setw(15) << ctx->instance() << std::setw(20) << ctx->context(18)
-                << " ] ";
+      buffer << ": " << std::setw(15) << ctx->instance() << std::setw(20) << ctx->context(18)
+             << " ] ";
     }
-    std::cout << GetColor(color, bg_color);
+    buffer << GetColor(color, bg_color);
 
 #endif
   }
@@ -265,14 +279,14 @@ public:
   void Append(T const &v)
   {
 #ifndef FETCH_DISABLE_COUT_LOGGING
-    std::cout << v;
+    Buffer() << v;
 #endif
   }
 
   virtual void Append(std::string const &s)
   {
 #ifndef FETCH_DISABLE_COUT_LOGGING
-    std::cout << s;
+    Buffer() << s;
 #endif
   }
 
@@ -280,11 +294,46 @@ public:
   {
 #ifndef FETCH_DISABLE_COUT_LOGGING
     using namespace fetch::commandline::VT100;
-    std::cout << DefaultAttributes() << std::endl;
+
+    auto &buffer = Buffer();
+    buffer << DefaultAttributes() << '\n';
+
+    // hand the completed entry over to the writer and reset the thread's buffer
+    writer_.Write(buffer.str());
+    buffer.str(std::string{});
+    buffer.clear();
 #endif
   }
 
+  /**
+   * Submit a block of preformatted output (e.g. a stack trace) to the writer
+   *
+   * @param text The text to be written
+   */
+  void Write(std::string text)
+  {
+    writer_.Write(std::move(text));
+  }
+
+  AsyncLogWriter &writer()
+  {
+    return writer_;
+  }
+
 private:
+  static std::ostringstream &Buffer()
+  {
+    thread_local std::ostringstream buffer;
+    return buffer;
+  }
+
+  static int ThreadNumber()
+  {
+    thread_local int const thread_number = ReadableThread::GetThreadID(std::this_thread::get_id());
+    return thread_number;
+  }
+
+  AsyncLogWriter writer_;
 };
 
 namespace details {
@@ -293,6 +342,7 @@ class LogWrapper
 {
 public:
   using shared_context_type = std::shared_ptr<ContextDetails>;
+  using Level               = DefaultLogger::Level;
 
   LogWrapper()
   {
@@ -301,160 +351,134 @@ public:
 
   ~LogWrapper()
   {
+    DisableLogger();
+
     std::lock_guard<std::mutex> lock(mutex_);
-    if (log_)
-    {
-      log_.reset();
-    }
+    log_.reset();
   }
 
+  /**
+   * Stop the logging of all entries. The logger itself is kept alive, since other threads may be
+   * logging concurrently, but once this returns no further entries will be written.
+   */
   void DisableLogger()
   {
-    if (log_)
-    {
-      log_.reset();
-    }
+    enabled_ = false;
+    WaitForActiveCalls();
+
+    log_->writer().Flush();
+  }
+
+  /**
+   * Set the (runtime) log level, entries with a lower priority than this are discarded at the call
+   * site. Highlighted entries are always enabled.
+   *
+   * @param level The new log level
+   */
+  void SetLevel(Level level)
+  {
+    level_ = static_cast<int>(level);
+  }
+
+  bool IsEnabled(Level level) const
+  {
+    return enabled_.load(std::memory_order_relaxed) &&
+           ((Level::HIGHLIGHT == level) ||
+            (static_cast<int>(level) <= level_.load(std::memory_order_relaxed)));
+  }
+
+  bool SetOutputFile(std::string const &filename)
+  {
+    return log_->writer().SetOutputFile(filename);
+  }
+
+  void Flush()
+  {
+    log_->writer().Flush();
+  }
+
+  uint64_t dropped_count() const
+  {
+    return log_->writer().dropped_count();
   }
 
   template <typename... Args>
   void Info(Args &&... args)
   {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (this->log_ != nullptr)
-    {
-      this->log_->StartEntry(DefaultLogger::Level::INFO, nullptr, TopContextImpl());
-      Unroll<Args...>::Append(this, std::forward<Args>(args)...);
-      this->log_->CloseEntry(DefaultLogger::Level::INFO);
-    }
+    Log(Level::INFO, nullptr, std::forward<Args>(args)...);
   }
 
   template <typename... Args>
   void InfoWithName(char const *name, Args &&... args)
   {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (this->log_ != nullptr)
-    {
-      this->log_->StartEntry(DefaultLogger::Level::INFO, name, TopContextImpl());
-      Unroll<Args...>::Append(this, std::forward<Args>(args)...);
-      this->log_->CloseEntry(DefaultLogger::Level::INFO);
-    }
+    Log(Level::INFO, name, std::forward<Args>(args)...);
   }
 
   template <typename... Args>
   void Warn(Args &&... args)
   {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (this->log_ != nullptr)
-    {
-      this->log_->StartEntry(DefaultLogger::Level::WARNING, nullptr, TopContextImpl());
-      Unroll<Args...>::Append(this, std::forward<Args>(args)...);
-      this->log_->CloseEntry(DefaultLogger::Level::WARNING);
-    }
+    Log(Level::WARNING, nullptr, std::forward<Args>(args)...);
   }
 
   template <typename... Args>
   void WarnWithName(char const *name, Args &&... args)
   {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (this->log_ != nullptr)
-    {
-      this->log_->StartEntry(DefaultLogger::Level::WARNING, name, TopContextImpl());
-      Unroll<Args...>::Append(this, std::forward<Args>(args)...);
-      this->log_->CloseEntry(DefaultLogger::Level::WARNING);
-    }
+    Log(Level::WARNING, name, std::forward<Args>(args)...);
   }
 
   template <typename... Args>
   void Highlight(Args &&... args)
   {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (this->log_ != nullptr)
-    {
-      this->log_->StartEntry(DefaultLogger::Level::HIGHLIGHT, nullptr, TopContextImpl());
-      Unroll<Args...>::Append(this, std::forward<Args>(args)...);
-      this->log_->CloseEntry(DefaultLogger::Level::HIGHLIGHT);
-    }
+    Log(Level::HIGHLIGHT, nullptr, std::forward<Args>(args)...);
   }
 
   template <typename... Args>
   void HighlightWithName(char const *name, Args &&... args)
   {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (this->log_ != nullptr)
-    {
-      this->log_->StartEntry(DefaultLogger::Level::HIGHLIGHT, name, TopContextImpl());
-      Unroll<Args...>::Append(this, std::forward<Args>(args)...);
-      this->log_->CloseEntry(DefaultLogger::Level::HIGHLIGHT);
-    }
+    Log(Level::HIGHLIGHT, name, std::forward<Args>(args)...);
   }
 
   template <typename... Args>
   void Error(Args &&... args)
   {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (this->log_ != nullptr)
-    {
-      this->log_->StartEntry(DefaultLogger::Level::ERROR, nullptr, TopContextImpl());
-      Unroll<Args...>::Append(this, std::forward<Args>(args)...);
-      this->log_->CloseEntry(DefaultLogger::Level::ERROR);
-
-      StackTrace();
-    }
-
-    //    exit(-1);
+    Log(Level::ERROR, nullptr, std::forward<Args>(args)...);
   }
 
   template <typename... Args>
   void ErrorWithName(char const *name, Args &&... args)
   {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (this->log_ != nullptr)
-    {
-      this->log_->StartEntry(DefaultLogger::Level::ERROR, name, TopContextImpl());
-      Unroll<Args...>::Append(this, std::forward<Args>(args)...);
-      this->log_->CloseEntry(DefaultLogger::Level::ERROR);
-
-      StackTrace();
-    }
-
-    //    exit(-1);
+    Log(Level::ERROR, name, std::forward<Args>(args)...);
   }
 
   template <typename... Args>
   void Debug(Args &&... args)
   {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (this->log_ != nullptr)
-    {
-      this->log_->StartEntry(DefaultLogger::Level::DEBUG, nullptr, TopContextImpl());
-      Unroll<Args...>::Append(this, std::forward<Args>(args)...);
-      this->log_->CloseEntry(DefaultLogger::Level::DEBUG);
-    }
+    Log(Level::DEBUG, nullptr, std::forward<Args>(args)...);
   }
 
   template <typename... Args>
   void DebugWithName(char const *name, Args const &... args)
   {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (this->log_ != nullptr)
-    {
-      this->log_->StartEntry(DefaultLogger::Level::DEBUG, name, TopContextImpl());
-      Unroll<Args...>::Append(this, std::forward<Args>(args)...);
-      this->log_->CloseEntry(DefaultLogger::Level::DEBUG);
-    }
+    Log(Level::DEBUG, name, args...);
   }
 
   void Debug(std::vector<std::string> const &items)
   {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (this->log_ != nullptr)
+    if (!IsEnabled(Level::DEBUG))
     {
-      this->log_->StartEntry(DefaultLogger::Level::DEBUG, nullptr, TopContextImpl());
+      return;
+    }
+
+    ActiveCall const call{*this};
+    if (call.enabled())
+    {
+      DefaultLogger *log = log_.get();
+      log->StartEntry(Level::DEBUG, nullptr, TopContext());
       for (auto &item : items)
       {
-        this->log_->Append(item);
+        log->Append(item);
       }
-      this->log_->CloseEntry(DefaultLogger::Level::DEBUG);
+      log->CloseEntry(Level::DEBUG);
     }
   }
 
@@ -462,22 +486,31 @@ public:
   {
     std::thread::id             id = std::this_thread::get_id();
     std::lock_guard<std::mutex> lock(mutex_);
-    if (this->log_ != nullptr)
+    if (enabled_)
     {
-      context_[id] = std::move(ctx);
+      CurrentContext() = ctx;
+      context_[id]     = std::move(ctx);
     }
   }
 
   shared_context_type TopContext()
   {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return TopContextImpl();
+    // fast path: the current thread already has a context
+    auto &current = CurrentContext();
+    if (!current)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      current                              = std::make_shared<ContextDetails>();
+      context_[std::this_thread::get_id()] = current;
+    }
+
+    return current;
   }
 
   void RegisterLock(fetch::mutex::AbstractMutex *ptr)
   {
     std::lock_guard<std::mutex> lock(mutex_);
-    if (this->log_ != nullptr)
+    if (enabled_)
     {
       active_locks_.insert(ptr);
     }
@@ -487,7 +520,7 @@ public:
                       const std::string &filename, int line)
   {
     std::lock_guard<std::mutex> lock(mutex_);
-    if (this->log_ != nullptr)
+    if (enabled_)
     {
       std::stringstream ss;
       ss << filename << line;
@@ -529,36 +562,48 @@ public:
       return;
     }
 
-    std::cout << trace_name << " for #" << ReadableThread::GetThreadID(ctx->thread_id())
-              << std::endl;
-    PrintTrace(ctx, max);
+    std::ostringstream trace;
+    trace << trace_name << " for #" << ReadableThread::GetThreadID(ctx->thread_id()) << '\n';
+    PrintTrace(trace, ctx, max);
 
     if (show_locks)
     {
+      std::lock_guard<std::mutex> lock(mutex_);
+
       std::vector<std::thread::id> locked_threads;
 
-      std::cout << std::endl;
-      std::cout << "Active locks: " << std::endl;
+      trace << '\n';
+      trace << "Active locks: " << '\n';
       for (auto &l : active_locks_)
       {
-        std::cout << "  - " << l->AsString() << std::endl;
+        trace << "  - " << l->AsString() << '\n';
         locked_threads.push_back(l->thread_id());
       }
-      std::cout << std::endl;
+      trace << '\n';
       for (auto &id : locked_threads)
       {
-        std::cout << "Additionally trace for #" << ReadableThread::GetThreadID(id) << std::endl;
+        trace << "Additionally trace for #" << ReadableThread::GetThreadID(id) << '\n';
         ctx = context_[id];
-        PrintTrace(ctx);
-        std::cout << std::endl;
+        PrintTrace(trace, ctx);
+        trace << '\n';
       }
     }
+
+    // submit the trace as a single block so that it is not interleaved with other entries
+    ActiveCall const call{*this};
+    if (call.enabled())
+    {
+      log_->Write(trace.str());
+    }
+    else
+    {
+      std::cout << trace.str() << std::flush;
+    }
   }
 
   void StackTrace(uint32_t max = uint32_t(-1), bool show_locks = true)
   {
-    shared_context_type ctx = TopContextImpl();
-    StackTrace(ctx, max, show_locks);
+    StackTrace(TopContext(), max, show_locks);
   }
 
   void UpdateContextTime(shared_context_type const &ctx, double spent_time)
@@ -667,60 +712,117 @@ private:
 
   mutable std::mutex timing_mutex_;
 
-  shared_context_type TopContextImpl()
+  /**
+   * The context of the calling thread (there is only one LogWrapper instance per process)
+   *
+   * @return The reference to the thread's context
+   */
+  static shared_context_type &CurrentContext()
+  {
+    thread_local shared_context_type context;
+    return context;
+  }
+
+  /**
+   * Registers a call which uses the logger for its duration, so that the logger is not disabled or
+   * destroyed while it is in use. The enabled flag is checked again once the call is registered,
+   * so either the call sees that the logger has been disabled or the disabling waits for the call.
+   */
+  class ActiveCall
   {
-    std::thread::id id = std::this_thread::get_id();
+  public:
+    explicit ActiveCall(LogWrapper &wrapper)
+      : wrapper_{wrapper}
+    {
+      ++wrapper_.active_calls_;
+    }
 
-    shared_context_type ret;
+    ActiveCall(ActiveCall const &) = delete;
 
-    auto it = context_.find(id);
-    if (it != context_.end())
+    ~ActiveCall()
     {
-      ret = it->second;
+      --wrapper_.active_calls_;
     }
-    else
+
+    bool enabled() const
     {
-      ret = std::make_shared<ContextDetails>();
-      context_.emplace(id, ret);
+      return wrapper_.enabled_;
     }
 
-    return ret;
+    ActiveCall &operator=(ActiveCall const &) = delete;
+
+  private:
+    LogWrapper &wrapper_;
+  };
+
+  void WaitForActiveCalls() const
+  {
+    while (active_calls_ != 0)
+    {
+      std::this_thread::yield();
+    }
+  }
+
+  template <typename... Args>
+  void Log(Level level, char const *name, Args &&... args)
+  {
+    if (!IsEnabled(level))
+    {
+      return;
+    }
+
+    ActiveCall const call{*this};
+    if (call.enabled())
+    {
+      DefaultLogger *log = log_.get();
+      log->StartEntry(level, name, TopContext());
+      Unroll<Args...>::Append(log, std::forward<Args>(args)...);
+      log->CloseEntry(level);
+
+      if (Level::ERROR == level)
+      {
+        StackTrace();
+
+        // errors are flushed immediately so that they are not lost if the process terminates
+        log->writer().Flush();
+      }
+    }
   }
 
   template <typename T, typename... Args>
   struct Unroll
   {
-    static void Append(LogWrapper *cls, T const &v, Args... args)
+    static void Append(DefaultLogger *log, T const &v, Args... args)
     {
-      cls->log_->Append(v);
-      Unroll<Args...>::Append(cls, args...);
+      log->Append(v);
+      Unroll<Args...>::Append(log, args...);
     }
   };
 
   template <typename T>
   struct Unroll<T>
   {
-    static void Append(LogWrapper *cls, T const &v)
+    static void Append(DefaultLogger *log, T const &v)
     {
-      cls->log_->Append(v);
+      log->Append(v);
     }
   };
 
-  void PrintTrace(shared_context_type ctx, uint32_t max = uint32_t(-1))
+  static void PrintTrace(std::ostream &stream, shared_context_type ctx, uint32_t max = uint32_t(-1))
   {
     using namespace fetch::commandline::VT100;
     std::size_t i = 0;
     while (ctx)
     {
-      std::cout << std::setw(3) << i << ": In thread #"
-                << ReadableThread::GetThreadID(ctx->thread_id()) << ": ";
-      std::cout << GetColor(5, 9) << ctx->context() << DefaultAttributes() << " " << ctx->filename()
-                << ", ";
-      std::cout << GetColor(3, 9) << ctx->line() << DefaultAttributes() << std::endl;
+      stream << std::setw(3) << i << ": In thread #"
+             << ReadableThread::GetThreadID(ctx->thread_id()) << ": ";
+      stream << GetColor(5, 9) << ctx->context() << DefaultAttributes() << " " << ctx->filename()
+             << ", ";
+      stream << GetColor(3, 9) << ctx->line() << DefaultAttributes() << '\n';
 
       if (ctx->derived_from())
       {
-        std::cout << "*";
+        stream << "*";
         ctx = ctx->derived_from();
       }
       else
@@ -736,6 +838,9 @@ private:
   }
 
   std::unique_ptr<DefaultLogger>                           log_;
+  std::atomic<int>                                         level_{static_cast<int>(Level::DEBUG)};
+  std::atomic<bool>                                        enabled_{true};
+  std::atomic<std::size_t>                                 active_calls_{0};
   mutable std::mutex                                       mutex_;
   std::unordered_map<std::thread::id, shared_context_type> context_;
 };
@@ -816,11 +921,17 @@ extern log::details::LogWrapper logger;
 #endif
 
 // Logging macros
+//
+// In addition to the compile time logging level, the runtime level is checked before any of the
+// arguments are evaluated so that disabled log statements cost no more than a relaxed load.
 
 // Debug
 #if FETCH_COMPILE_LOGGING_LEVEL >= 4
 #define FETCH_LOG_DEBUG_ENABLED
-#define FETCH_LOG_DEBUG(name, ...) fetch::logger.DebugWithName(name, __VA_ARGS__)
+#define FETCH_LOG_DEBUG(name, ...)                                  \
+  (fetch::logger.IsEnabled(fetch::log::DefaultLogger::Level::DEBUG) \
+       ? fetch::logger.DebugWithName(name, __VA_ARGS__)             \
+       : (void)name)
 #else
 #define FETCH_LOG_DEBUG(name, ...) (void)name
 #endif
@@ -828,7 +939,10 @@ extern log::details::LogWrapper logger;
 // Info
 #if FETCH_COMPILE_LOGGING_LEVEL >= 3
 #define FETCH_LOG_INFO_ENABLED
-#define FETCH_LOG_INFO(name, ...) fetch::logger.InfoWithName(name, __VA_ARGS__)
+#define FETCH_LOG_INFO(name, ...)                                  \
+  (fetch::logger.IsEnabled(fetch::log::DefaultLogger::Level::INFO) \
+       ? fetch::logger.InfoWithName(name, __VA_ARGS__)             \
+       : (void)name)
 #else
 #define FETCH_LOG_INFO(name, ...) (void)name
 #endif
@@ -836,7 +950,10 @@ extern log::details::LogWrapper logger;
 // Warn
 #if FETCH_COMPILE_LOGGING_LEVEL >= 2
 #define FETCH_LOG_WARN_ENABLED
-#define FETCH_LOG_WARN(name, ...) fetch::logger.WarnWithName(name, __VA_ARGS__)
+#define FETCH_LOG_WARN(name, ...)                                     \
+  (fetch::logger.IsEnabled(fetch::log::DefaultLogger::Level::WARNING) \
+       ? fetch::logger.WarnWithName(name, __VA_ARGS__)                \
+       : (void)name)
 #else
 #define FETCH_LOG_WARN(name, ...) (void)name
 #endif
@@ -844,7 +961,10 @@ extern log::details::LogWrapper logger;
 // Error
 #if FETCH_COMPILE_LOGGING_LEVEL >= 1
 #define FETCH_LOG_ERROR_ENABLED
-#define FETCH_LOG_ERROR(name, ...) fetch::logger.ErrorWithName(name, __VA_ARGS__)
+#define FETCH_LOG_ERROR(name, ...)                                  \
+  (fetch::logger.IsEnabled(fetch::log::DefaultLogger::Level::ERROR) \
+       ? fetch::logger.ErrorWithName(name, __VA_ARGS__)             \
+       : (void)name)
 #else
 #define FETCH_LOG_ERROR(name, ...) (void)name
 #endif
@@ -0,0 +1,230 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace fetch {
+namespace core {
+
+/**
+ * A monotonic (bump pointer) memory arena for short lived objects.
+ *
+ * Memory is handed out from a list of large blocks and is never returned to the system while the
+ * arena is alive. Deallocation only updates the book keeping, the memory of all the allocations is
+ * recycled at once (in constant time) when the arena is reset. This trades memory usage for far
+ * fewer calls to the system allocator and better locality, which suits the objects created during
+ * the execution of a block.
+ *
+ * Allocation and reset are not thread safe, it is expected that each thread of execution owns its
+ * own arena. Memory can however be released from any thread, which allows objects allocated from
+ * the arena to be handed to other threads.
+ */
+class Arena
+{
+public:
+  static constexpr std::size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+  // Construction / Destruction
+  explicit Arena(std::size_t block_size = DEFAULT_BLOCK_SIZE);
+  Arena(Arena const &) = delete;
+  Arena(Arena &&)      = delete;
+  ~Arena()             = default;
+
+  /// @name Allocation
+  /// @{
+  void *Allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+  void  Deallocate(void *ptr) noexcept;
+  bool  Reset();
+  /// @}
+
+  /// @name Statistics
+  /// @{
+  std::size_t num_allocations() const;
+  std::size_t num_live_allocations() const;
+  std::size_t num_blocks() const;
+  std::size_t capacity() const;
+  /// @}
+
+  /// @name Thread Arena
+  /// @{
+  static Arena *Current();
+  static void * AllocateTagged(std::size_t size);
+  static void   DeallocateTagged(void *ptr) noexcept;
+  /// @}
+
+  // Operators
+  Arena &operator=(Arena const &) = delete;
+  Arena &operator=(Arena &&) = delete;
+
+private:
+  struct Block
+  {
+    std::unique_ptr<uint8_t[]> data;
+    std::size_t                size;
+  };
+
+  using BlockList = std::vector<Block>;
+
+  uint8_t *AllocateFromNextBlock(std::size_t size, std::size_t alignment);
+
+  std::size_t const block_size_;
+
+  BlockList                blocks_{};            ///< The blocks of memory owned by the arena
+  std::size_t              current_block_{0};    ///< The index of the block being allocated from
+  std::size_t              offset_{0};           ///< The offset of the next allocation in the block
+  std::size_t              num_allocations_{0};  ///< The number of allocations since the last reset
+  std::atomic<std::size_t> num_live_{0};         ///< The number of allocations still live
+
+  static thread_local Arena *current_;
+
+  friend class ArenaScope;
+};
+
+/**
+ * Makes the specified arena the arena of the current thread for the lifetime of the scope. While
+ * the scope is active Arena::AllocateTagged allocates from the arena rather than the heap.
+ */
+class ArenaScope
+{
+public:
+  // Construction / Destruction
+  explicit ArenaScope(Arena &arena);
+  ArenaScope(ArenaScope const &) = delete;
+  ArenaScope(ArenaScope &&)      = delete;
+  ~ArenaScope();
+
+  // Operators
+  ArenaScope &operator=(ArenaScope const &) = delete;
+  ArenaScope &operator=(ArenaScope &&) = delete;
+
+private:
+  Arena *previous_;
+};
+
+/**
+ * Standard library compatible allocator which allocates from an arena. When no arena is specified
+ * the allocator falls back to the heap, which allows containers using it to be default constructed.
+ *
+ * @tparam T The type of the objects being allocated
+ */
+template <typename T>
+class ArenaAllocator
+{
+public:
+  using value_type = T;
+
+  // Construction / Destruction
+  ArenaAllocator() = default;
+  explicit ArenaAllocator(Arena *arena) noexcept;
+  template <typename U>
+  ArenaAllocator(ArenaAllocator<U> const &other) noexcept;
+  ~ArenaAllocator() = default;
+
+  /// @name Allocator Interface
+  /// @{
+  T *  allocate(std::size_t n);
+  void deallocate(T *ptr, std::size_t n) noexcept;
+  /// @}
+
+  Arena *arena() const noexcept;
+
+private:
+  Arena *arena_{nullptr};
+};
+
+inline std::size_t Arena::num_allocations() const
+{
+  return num_allocations_;
+}
+
+inline std::size_t Arena::num_live_allocations() const
+{
+  return num_live_;
+}
+
+inline std::size_t Arena::num_blocks() const
+{
+  return blocks_.size();
+}
+
+inline Arena *Arena::Current()
+{
+  return current_;
+}
+
+template <typename T>
+ArenaAllocator<T>::ArenaAllocator(Arena *arena) noexcept
+  : arena_{arena}
+{}
+
+template <typename T>
+template <typename U>
+ArenaAllocator<T>::ArenaAllocator(ArenaAllocator<U> const &other) noexcept
+  : arena_{other.arena()}
+{}
+
+template <typename T>
+T *ArenaAllocator<T>::allocate(std::size_t n)
+{
+  if (arena_)
+  {
+    return static_cast<T *>(arena_->Allocate(n * sizeof(T), alignof(T)));
+  }
+
+  return static_cast<T *>(::operator new(n * sizeof(T)));
+}
+
+template <typename T>
+void ArenaAllocator<T>::deallocate(T *ptr, std::size_t) noexcept
+{
+  if (arena_)
+  {
+    arena_->Deallocate(ptr);
+  }
+  else
+  {
+    ::operator delete(ptr);
+  }
+}
+
+template <typename T>
+Arena *ArenaAllocator<T>::arena() const noexcept
+{
+  return arena_;
+}
+
+template <typename T, typename U>
+bool operator==(ArenaAllocator<T> const &lhs, ArenaAllocator<U> const &rhs) noexcept
+{
+  return lhs.arena() == rhs.arena();
+}
+
+template <typename T, typename U>
+bool operator!=(ArenaAllocator<T> const &lhs, ArenaAllocator<U> const &rhs) noexcept
+{
+  return lhs.arena() != rhs.arena();
+}
+
+}  // namespace core
+}  // namespace fetch
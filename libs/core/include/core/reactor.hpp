@@ -19,25 +19,44 @@
 
 #include "core/mutex.hpp"
 #include "core/runnable.hpp"
+#include "core/timer_wheel.hpp"
 
 #include <atomic>
-#include <map>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <memory>
+#include <string>
 #include <thread>
+#include <unordered_map>
+#include <vector>
 
 namespace fetch {
 namespace core {
 
+/**
+ * Executes a set of runnables (typically state machines) on a pool of worker threads
+ *
+ * Runnables are not polled. Instead a runnable that is not ready to execute is parked until either
+ * the time it reports from GetNextExecutionTime() (tracked with a hierarchical timer wheel) or
+ * until it calls Notify(). Only runnables which can not report a time fall back to being polled.
+ *
+ * Each runnable is only ever executed on one worker thread at a time.
+ */
 class Reactor
 {
 public:
   static constexpr char const *LOGGING_NAME = "Reactor";
 
+  static constexpr std::size_t DEFAULT_NUM_WORKERS = 4;
+
   // Construction / Destruction
-  explicit Reactor(std::string name);
+  explicit Reactor(std::string name, std::size_t num_workers = DEFAULT_NUM_WORKERS);
   Reactor(Reactor const &) = delete;
   Reactor(Reactor &&)      = delete;
-  ~Reactor()               = default;
+  ~Reactor();
 
   bool Attach(WeakRunnable runnable);
   bool Detach(Runnable const &runnable);
@@ -45,29 +64,83 @@ public:
   void Start();
   void Stop();
 
+  std::size_t num_workers() const;
+
   // Operators
   Reactor &operator=(Reactor const &) = delete;
   Reactor &operator=(Reactor &&) = delete;
 
 private:
-  using Mutex       = mutex::Mutex;
-  using RunnableMap = std::map<Runnable const *, WeakRunnable>;
-  using Flag        = std::atomic<bool>;
-  using ThreadPtr   = std::unique_ptr<std::thread>;
+  using Clock        = Runnable::Clock;
+  using Timepoint    = Runnable::Timepoint;
+  using TickDuration = std::chrono::milliseconds;
+
+  enum class Status
+  {
+    WAITING,  ///< Parked until a timer expires or the runnable is notified
+    QUEUED,   ///< Waiting in the queue to be evaluated by a worker
+    RUNNING,  ///< Being evaluated / executed by a worker
+  };
+
+  struct Entry
+  {
+    Runnable const *key{nullptr};  ///< The key of the entry in the map
+    WeakRunnable    runnable;
+    Status          status{Status::QUEUED};
+    uint64_t        generation{0};    ///< Incremented to invalidate any pending timers
+    bool            notified{false};  ///< Notification received while running
+    bool            detached{false};
+  };
 
-  void StartWorker();
-  void StopWorker();
-  void Monitor();
+  using EntryPtr     = std::shared_ptr<Entry>;
+  using EntryMap     = std::unordered_map<Runnable const *, EntryPtr>;
+  using WorkQueue    = std::deque<EntryPtr>;
+  using TimerItem    = std::pair<EntryPtr, uint64_t>;
+  using Timers       = TimerWheel<TimerItem>;
+  using Tick         = Timers::Tick;
+  using Mutex        = std::mutex;
+  using Lock         = std::unique_lock<Mutex>;
+  using Condition    = std::condition_variable;
+  using Flag         = std::atomic<bool>;
+  using ThreadPtr    = std::unique_ptr<std::thread>;
+  using ThreadList   = std::vector<ThreadPtr>;
+  using RunnableList = std::vector<std::shared_ptr<Runnable>>;
+
+  void StartWorkers();
+  void StopWorkers();
+  void Monitor(std::size_t index);
+  void Process(Lock &lock, EntryPtr const &entry);
+  void Wake(EntryPtr const &entry);
+  void Enqueue(EntryPtr const &entry);
+  void Park(EntryPtr const &entry, Timepoint const &next);
+  void AdvanceTimers();
+  void ClearNotifiers();
+  Tick CurrentTick() const;
+  Tick ToTick(Timepoint const &timepoint) const;
 
   std::string const name_;
+  std::size_t const num_workers_;
+  Timepoint const   epoch_{Clock::now()};  ///< The reference point for the timer ticks
   Flag              running_{false};
 
-  Mutex       work_map_mutex_{__LINE__, __FILE__};
-  RunnableMap work_map_{};
+  Mutex       lock_;                  ///< Protects all of the scheduling state below
+  Condition   work_available_;        ///< Signalled when work has been queued
+  Condition   timer_changed_;         ///< Signalled to wake the worker which is keeping time
+  EntryMap    entries_{};             ///< The attached runnables
+  WorkQueue   queue_{};               ///< The runnables that need to be evaluated
+  Timers      timers_{};              ///< The parked runnables
+  std::size_t idle_workers_{0};       ///< The number of workers waiting for work
+  bool        keeper_active_{false};  ///< Flag to signal a worker is waiting for the next timer
+  Tick        keeper_deadline_{0};    ///< The tick the time keeping worker will wake at
 
-  Mutex     worker_mutex_{__LINE__, __FILE__};
-  ThreadPtr worker_{};
+  Mutex      worker_mutex_;
+  ThreadList workers_{};
 };
 
+inline std::size_t Reactor::num_workers() const
+{
+  return num_workers_;
+}
+
 }  // namespace core
 }  // namespace fetch
@@ -17,20 +17,35 @@
 //
 //------------------------------------------------------------------------------
 
+#include "core/macros.hpp"
+
+#include <chrono>
+#include <functional>
 #include <memory>
+#include <mutex>
 
 namespace fetch {
 namespace core {
 
 /**
- * Interface class to represent
+ * Interface class to represent a piece of work which is executed repeatedly by a reactor
+ *
+ * The reactor re-evaluates a runnable which is not ready to execute either at the time reported by
+ * GetNextExecutionTime() or when the runnable signals (via Notify()) that it has new work to do.
+ * Runnables that can not predict when they will next be ready are polled periodically.
  */
 class Runnable
 {
 public:
+  using Clock     = std::chrono::steady_clock;
+  using Timepoint = Clock::time_point;
+  using Notifier  = std::function<void()>;
+
   // Construction / Destruction
-  Runnable()          = default;
-  virtual ~Runnable() = default;
+  Runnable()                 = default;
+  Runnable(Runnable const &) = delete;
+  Runnable(Runnable &&)      = delete;
+  virtual ~Runnable()        = default;
 
   /// @name Runnable Interface
   /// @{
@@ -39,6 +54,24 @@ public:
     return true;
   }
   virtual void Execute() = 0;
+
+  /**
+   * Determine the time at which the runnable will next be ready to execute
+   *
+   * @param next The output time to be populated
+   * @return true if the time is known, false if the runnable needs to be polled
+   */
+  virtual bool GetNextExecutionTime(Timepoint &next) const
+  {
+    FETCH_UNUSED(next);
+    return false;
+  }
+  /// @}
+
+  /// @name Reactor Notifications
+  /// @{
+  void SetNotifier(Notifier notifier);
+  void Notify();
   /// @}
 
   // Helper operators
@@ -46,8 +79,43 @@ public:
   {
     Execute();
   }
+
+  // Operators
+  Runnable &operator=(Runnable const &) = delete;
+  Runnable &operator=(Runnable &&) = delete;
+
+private:
+  using Mutex = std::mutex;
+
+  Mutex    notifier_lock_;
+  Notifier notifier_;
 };
 
+/**
+ * Set (or clear) the callback which signals the owning reactor. Called by the reactor when the
+ * runnable is attached or detached.
+ *
+ * @param notifier The callback to be set
+ */
+inline void Runnable::SetNotifier(Notifier notifier)
+{
+  std::lock_guard<Mutex> lock{notifier_lock_};
+  notifier_ = std::move(notifier);
+}
+
+/**
+ * Signal to the reactor that the runnable should be re-evaluated as soon as possible, for example
+ * because an external event has occurred that it has been waiting for
+ */
+inline void Runnable::Notify()
+{
+  std::lock_guard<Mutex> lock{notifier_lock_};
+  if (notifier_)
+  {
+    notifier_();
+  }
+}
+
 using WeakRunnable = std::weak_ptr<Runnable>;
 
 }  // namespace core
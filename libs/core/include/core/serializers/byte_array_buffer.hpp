@@ -58,6 +58,23 @@ public:
     : data_{s.Copy()}
   {}
 
+  /**
+   * @brief Constructing from IMMUTABLE ConstByteArray.
+   *
+   * NO copy is made here, the buffer shares the memory of @ref s. This means
+   * that byte arrays deserialised from the buffer are views into the memory
+   * of @ref s rather than copies of it (i.e. zero-copy deserialisation of
+   * received data). Since the content of @ref s can not be modified by its
+   * holder, this constructor is intended for reading, writing into the buffer
+   * would be visible to all other holders of @ref s.
+   *
+   * @param s Input immutable instance of ConstByteArray to share content with
+   */
+  ByteArrayBufferEx(byte_array::ConstByteArray const &s)
+  {
+    data_.FromByteArray(s, 0, s.size());
+  }
+
   ByteArrayBufferEx(ByteArrayBufferEx const &from)
     : data_{from.data_.Copy()}
     , pos_{from.pos_}
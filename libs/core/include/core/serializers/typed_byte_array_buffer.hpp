@@ -92,10 +92,8 @@ inline void TypedByteArrayBuffer::ReadBytes(uint8_t *arr, std::size_t const &siz
                                     std::to_string(bytes_left()) + " not  " + std::to_string(size));
   }
 
-  for (std::size_t i = 0; i < size; ++i)
-  {
-    arr[i] = data_[pos_++];
-  }
+  data_.ReadBytes(arr, size, pos_);
+  pos_ += size;
 }
 
 template <>
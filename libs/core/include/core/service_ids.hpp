@@ -40,7 +40,8 @@ static constexpr uint16_t CHANNEL_ROUTING = 1;
 // P2P Service Channels
 
 // Main Chain Service Channels
-static constexpr uint16_t CHANNEL_BLOCKS = 2;
+static constexpr uint16_t CHANNEL_BLOCKS         = 2;
+static constexpr uint16_t CHANNEL_COMPACT_BLOCKS = 3;
 
 // RPC Protocol identifiers
 static constexpr uint64_t RPC_MAIN_CHAIN = 128;
@@ -84,6 +84,7 @@ public:
   /// @{
   bool IsReadyToExecute() const override;
   void Execute() override;
+  bool GetNextExecutionTime(Timepoint &next) const override;
   /// @}
 
   State state() const
@@ -93,17 +94,17 @@ public:
 
   template <typename R, typename P>
   void Delay(std::chrono::duration<R, P> const &delay);
+  void Wake();
 
   // Operators
   StateMachine &operator=(StateMachine const &) = delete;
   StateMachine &operator=(StateMachine &&) = delete;
 
 private:
-  using Clock       = std::chrono::steady_clock;
-  using Timepoint   = Clock::time_point;
-  using Duration    = Clock::duration;
-  using CallbackMap = std::unordered_map<State, Callback>;
-  using Mutex       = std::mutex;
+  using Duration        = Clock::duration;
+  using CallbackMap     = std::unordered_map<State, Callback>;
+  using Mutex           = std::mutex;
+  using AtomicTimepoint = std::atomic<Timepoint>;
 
   void Reset();
 
@@ -113,7 +114,7 @@ private:
   CallbackMap         callbacks_{};
   std::atomic<State>  current_state_;
   std::atomic<State>  previous_state_{current_state_.load()};
-  Timepoint           next_execution_{};
+  AtomicTimepoint     next_execution_{Timepoint{}};
   StateChangeCallback state_change_callback_{};
 };
 
@@ -282,14 +283,35 @@ bool StateMachine<S>::IsReadyToExecute() const
 {
   bool ready{true};
 
-  if (next_execution_.time_since_epoch().count())
+  Timepoint const next_execution = next_execution_;
+  if (next_execution.time_since_epoch().count())
   {
-    ready = (Clock::now() >= next_execution_);
+    ready = (Clock::now() >= next_execution);
   }
 
   return ready;
 }
 
+/**
+ * Determine when the state machine will next be ready to execute
+ *
+ * @tparam S The state enum type
+ * @param next The output time to be populated
+ * @return true if the state machine is delayed (and next has been populated), otherwise false
+ */
+template <typename S>
+bool StateMachine<S>::GetNextExecutionTime(Timepoint &next) const
+{
+  Timepoint const next_execution = next_execution_;
+  if (next_execution.time_since_epoch().count() == 0)
+  {
+    return false;
+  }
+
+  next = next_execution;
+  return true;
+}
+
 /**
  * Execute the state machine (called from the reactor)
  *
@@ -337,7 +359,21 @@ template <typename S>
 template <typename R, typename P>
 void StateMachine<S>::Delay(std::chrono::duration<R, P> const &delay)
 {
-  next_execution_ = Clock::now() + delay;
+  next_execution_ = Clock::now() + std::chrono::duration_cast<Duration>(delay);
+}
+
+/**
+ * Cancel any pending delay and signal the reactor to execute the state machine as soon as possible.
+ * Unlike Delay() this can be called from any thread, for example when an event occurs that the
+ * current state is waiting for.
+ *
+ * @tparam S The state enum type
+ */
+template <typename S>
+void StateMachine<S>::Wake()
+{
+  next_execution_ = Timepoint{};
+  Notify();
 }
 
 }  // namespace core
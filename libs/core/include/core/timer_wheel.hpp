@@ -0,0 +1,367 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace fetch {
+namespace core {
+
+/**
+ * Hierarchical timer wheel
+ *
+ * Items are scheduled to expire at an absolute tick. Each level of the wheel has 64 slots, with a
+ * slot on level N covering 64^N ticks. Items are placed on the lowest level whose current span
+ * contains their deadline, and are cascaded down to the lower levels as the wheel advances. Both
+ * scheduling and expiry are therefore O(1) per item, irrespective of the number of items.
+ *
+ * The wheel does not support the cancellation of items. Users should instead ignore stale items
+ * as they expire (for example by comparing a generation counter).
+ *
+ * @tparam T The type of the items being scheduled
+ */
+template <typename T>
+class TimerWheel
+{
+public:
+  using Tick     = uint64_t;
+  using ItemList = std::vector<T>;
+
+  static constexpr std::size_t SLOT_BITS  = 6;
+  static constexpr std::size_t NUM_SLOTS  = 1u << SLOT_BITS;
+  static constexpr std::size_t NUM_LEVELS = 4;
+
+  // Construction / Destruction
+  explicit TimerWheel(Tick current = 0);
+  TimerWheel(TimerWheel const &) = default;
+  TimerWheel(TimerWheel &&)      = default;
+  ~TimerWheel()                  = default;
+
+  /// @name Scheduling
+  /// @{
+  void        Schedule(Tick deadline, T item);
+  std::size_t Advance(Tick now, ItemList &expired);
+  bool        GetNextExpiry(Tick &tick) const;
+  /// @}
+
+  /// @name Accessors
+  /// @{
+  Tick        current_tick() const;
+  std::size_t size() const;
+  bool        empty() const;
+  /// @}
+
+  // Operators
+  TimerWheel &operator=(TimerWheel const &) = default;
+  TimerWheel &operator=(TimerWheel &&) = default;
+
+private:
+  static constexpr Tick SLOT_MASK = NUM_SLOTS - 1;
+
+  struct Timer
+  {
+    Tick deadline;
+    T    item;
+  };
+
+  using TimerList = std::vector<Timer>;
+  using Level     = std::array<TimerList, NUM_SLOTS>;
+  using Levels    = std::array<Level, NUM_LEVELS>;
+
+  void Insert(Timer &&timer);
+  void Cascade();
+  void Expire(TimerList &timers, ItemList &expired);
+
+  static Tick LevelShift(std::size_t level);
+
+  Tick        current_;     ///< The current tick of the wheel
+  std::size_t count_{0};    ///< The number of scheduled items
+  TimerList   due_{};       ///< Items whose deadline had already passed when scheduled
+  Levels      levels_{};    ///< The levels of the wheel
+  TimerList   overflow_{};  ///< Items beyond the range of the top level
+};
+
+/**
+ * Construct an empty timer wheel
+ *
+ * @tparam T The type of the items being scheduled
+ * @param current The initial tick of the wheel
+ */
+template <typename T>
+TimerWheel<T>::TimerWheel(Tick current)
+  : current_{current}
+{}
+
+/**
+ * Schedule an item to expire at the specified tick. Items with a deadline that is not after the
+ * current tick are expired on the next call to Advance.
+ *
+ * @tparam T The type of the items being scheduled
+ * @param deadline The tick at which the item expires
+ * @param item The item to be scheduled
+ */
+template <typename T>
+void TimerWheel<T>::Schedule(Tick deadline, T item)
+{
+  Insert(Timer{deadline, std::move(item)});
+  ++count_;
+}
+
+/**
+ * Advance the wheel to the specified tick, collecting all the items that have expired
+ *
+ * @tparam T The type of the items being scheduled
+ * @param now The tick to advance to
+ * @param expired The list to which the expired items are appended
+ * @return The number of expired items
+ */
+template <typename T>
+std::size_t TimerWheel<T>::Advance(Tick now, ItemList &expired)
+{
+  std::size_t const initial_size = expired.size();
+
+  Expire(due_, expired);
+
+  while (current_ < now)
+  {
+    if (count_ == 0)
+    {
+      // nothing is scheduled, so no need to visit the intervening slots
+      current_ = now;
+      break;
+    }
+
+    ++current_;
+
+    if ((current_ & SLOT_MASK) == 0)
+    {
+      Cascade();
+    }
+
+    Expire(levels_[0][current_ & SLOT_MASK], expired);
+    Expire(due_, expired);
+  }
+
+  return expired.size() - initial_size;
+}
+
+/**
+ * Determine the earliest tick at which the wheel needs to be advanced. This is exact for items that
+ * are on the lowest level, and a lower bound for those on the higher levels.
+ *
+ * @tparam T The type of the items being scheduled
+ * @param tick The output tick to be populated
+ * @return true if there are items scheduled (and tick has been populated), otherwise false
+ */
+template <typename T>
+bool TimerWheel<T>::GetNextExpiry(Tick &tick) const
+{
+  if (count_ == 0)
+  {
+    return false;
+  }
+
+  if (!due_.empty())
+  {
+    tick = current_;
+    return true;
+  }
+
+  for (std::size_t level = 0; level < NUM_LEVELS; ++level)
+  {
+    Tick const shift = LevelShift(level);
+    Tick const index = (current_ >> shift) & SLOT_MASK;
+
+    // the slots ahead of the current position on this level
+    for (Tick slot = index + 1; slot < NUM_SLOTS; ++slot)
+    {
+      if (!levels_[level][slot].empty())
+      {
+        Tick const base = (current_ >> (shift + SLOT_BITS)) << (shift + SLOT_BITS);
+        tick            = base + (slot << shift);
+        return true;
+      }
+    }
+  }
+
+  // only items in the overflow remain, these are considered at the next wrap of the top level
+  Tick const top_shift = LevelShift(NUM_LEVELS);
+  tick                 = ((current_ >> top_shift) + 1) << top_shift;
+
+  return true;
+}
+
+/**
+ * Get the current tick of the wheel
+ *
+ * @tparam T The type of the items being scheduled
+ * @return The current tick
+ */
+template <typename T>
+typename TimerWheel<T>::Tick TimerWheel<T>::current_tick() const
+{
+  return current_;
+}
+
+/**
+ * Get the number of scheduled items
+ *
+ * @tparam T The type of the items being scheduled
+ * @return The number of items
+ */
+template <typename T>
+std::size_t TimerWheel<T>::size() const
+{
+  return count_;
+}
+
+/**
+ * Determine if there are no scheduled items
+ *
+ * @tparam T The type of the items being scheduled
+ * @return true if empty, otherwise false
+ */
+template <typename T>
+bool TimerWheel<T>::empty() const
+{
+  return count_ == 0;
+}
+
+/**
+ * Internal: Place a timer on the appropriate level of the wheel
+ *
+ * @tparam T The type of the items being scheduled
+ * @param timer The timer to be inserted
+ */
+template <typename T>
+void TimerWheel<T>::Insert(Timer &&timer)
+{
+  if (timer.deadline <= current_)
+  {
+    due_.emplace_back(std::move(timer));
+    return;
+  }
+
+  // find the lowest level whose current span contains the deadline
+  for (std::size_t level = 0; level < NUM_LEVELS; ++level)
+  {
+    Tick const span_shift = LevelShift(level + 1);
+
+    if ((timer.deadline >> span_shift) == (current_ >> span_shift))
+    {
+      Tick const slot = (timer.deadline >> LevelShift(level)) & SLOT_MASK;
+      levels_[level][slot].emplace_back(std::move(timer));
+      return;
+    }
+  }
+
+  overflow_.emplace_back(std::move(timer));
+}
+
+/**
+ * Internal: Redistribute the timers of the higher level slots that have been reached by the current
+ * tick onto the lower levels
+ *
+ * @tparam T The type of the items being scheduled
+ */
+template <typename T>
+void TimerWheel<T>::Cascade()
+{
+  // determine the highest level whose slot boundary has been reached
+  std::size_t level = 1;
+  while ((level < NUM_LEVELS) && (((current_ >> LevelShift(level)) & SLOT_MASK) == 0))
+  {
+    ++level;
+  }
+
+  TimerList timers;
+
+  // the top level has wrapped, reconsider the overflow
+  if (level == NUM_LEVELS)
+  {
+    timers.swap(overflow_);
+    for (auto &timer : timers)
+    {
+      Insert(std::move(timer));
+    }
+    timers.clear();
+
+    level = NUM_LEVELS - 1;
+  }
+
+  // cascade from the highest level down, so that timers can fall through multiple levels
+  for (; level > 0; --level)
+  {
+    Tick const slot = (current_ >> LevelShift(level)) & SLOT_MASK;
+
+    timers.swap(levels_[level][slot]);
+    for (auto &timer : timers)
+    {
+      Insert(std::move(timer));
+    }
+    timers.clear();
+  }
+}
+
+/**
+ * Internal: Move the items from a list of timers to the expired list
+ *
+ * @tparam T The type of the items being scheduled
+ * @param timers The timers which have expired
+ * @param expired The list to which the expired items are appended
+ */
+template <typename T>
+void TimerWheel<T>::Expire(TimerList &timers, ItemList &expired)
+{
+  for (auto &timer : timers)
+  {
+    expired.emplace_back(std::move(timer.item));
+  }
+
+  count_ -= timers.size();
+  timers.clear();
+}
+
+/**
+ * Internal: The number of bits the tick must be shifted by to give the slot index on a level
+ *
+ * @tparam T The type of the items being scheduled
+ * @param level The level of the wheel
+ * @return The shift in bits
+ */
+template <typename T>
+typename TimerWheel<T>::Tick TimerWheel<T>::LevelShift(std::size_t level)
+{
+  return static_cast<Tick>(level * SLOT_BITS);
+}
+
+template <typename T>
+constexpr std::size_t TimerWheel<T>::SLOT_BITS;
+template <typename T>
+constexpr std::size_t TimerWheel<T>::NUM_SLOTS;
+template <typename T>
+constexpr std::size_t TimerWheel<T>::NUM_LEVELS;
+template <typename T>
+constexpr typename TimerWheel<T>::Tick TimerWheel<T>::SLOT_MASK;
+
+}  // namespace core
+}  // namespace fetch
@@ -0,0 +1,207 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/async_log_writer.hpp"
+
+#include <chrono>
+#include <utility>
+#include <vector>
+
+namespace fetch {
+namespace log {
+
+/**
+ * Construct the writer and start the background thread
+ *
+ * @param stream The initial output stream
+ */
+AsyncLogWriter::AsyncLogWriter(std::FILE *stream)
+  : queue_{std::make_unique<Queue>()}
+  , stream_{stream}
+{
+  thread_ = std::thread([this]() { ThreadEntryPoint(); });
+}
+
+/**
+ * Stop the writer, making sure that all the submitted records have been written
+ */
+AsyncLogWriter::~AsyncLogWriter()
+{
+  running_ = false;
+
+  // wake the writer thread with an (ignored) empty record
+  queue_->TryPush(std::string{});
+
+  if (thread_.joinable())
+  {
+    thread_.join();
+  }
+
+  std::lock_guard<std::mutex> lock(stream_lock_);
+  CloseOwnedStream();
+}
+
+/**
+ * Redirect the output of the writer to the specified file (the records are appended)
+ *
+ * @param filename The path to the output file
+ * @return true if the file was successfully opened, otherwise false
+ */
+bool AsyncLogWriter::SetOutputFile(std::string const &filename)
+{
+  std::FILE *stream = std::fopen(filename.c_str(), "a");
+  if (stream == nullptr)
+  {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(stream_lock_);
+  CloseOwnedStream();
+
+  stream_      = stream;
+  owns_stream_ = true;
+
+  return true;
+}
+
+/**
+ * Redirect the output of the writer to the specified stream (not owned by the writer)
+ *
+ * @param stream The output stream
+ */
+void AsyncLogWriter::SetOutputStream(std::FILE *stream)
+{
+  std::lock_guard<std::mutex> lock(stream_lock_);
+  CloseOwnedStream();
+
+  stream_ = stream;
+}
+
+/**
+ * Submit a formatted record to be written. This function never blocks.
+ *
+ * @param record The formatted record
+ * @return true if the record was queued, false if it had to be dropped
+ */
+bool AsyncLogWriter::Write(std::string record)
+{
+  if (record.empty())
+  {
+    return true;
+  }
+
+  if (!queue_->TryPush(std::move(record)))
+  {
+    ++dropped_count_;
+    return false;
+  }
+
+  ++submitted_count_;
+  return true;
+}
+
+/**
+ * Wait until all the records submitted before this call have been written to the output
+ */
+void AsyncLogWriter::Flush()
+{
+  uint64_t const target = submitted_count_;
+
+  while (running_ && (written_count_ < target))
+  {
+    std::this_thread::sleep_for(std::chrono::microseconds{100});
+  }
+}
+
+/**
+ * Internal: The main loop of the background writer thread
+ */
+void AsyncLogWriter::ThreadEntryPoint()
+{
+  std::vector<std::string> records;
+  std::string              output;
+
+  records.reserve(MAX_BATCH_SIZE);
+
+  while (running_ || !queue_->empty())
+  {
+    records.clear();
+    output.clear();
+
+    queue_->PopMany(records, MAX_BATCH_SIZE, std::chrono::milliseconds{100});
+
+    // report any records which have been dropped since the last batch
+    uint64_t const dropped = dropped_count_;
+    if (dropped != reported_dropped_)
+    {
+      output += "[ AsyncLogWriter: " + std::to_string(dropped - reported_dropped_) +
+                " log record(s) dropped, queue full ]\n";
+      reported_dropped_ = dropped;
+    }
+
+    uint64_t num_written{0};
+    for (auto const &record : records)
+    {
+      if (!record.empty())
+      {
+        output += record;
+        ++num_written;
+      }
+    }
+
+    if (!output.empty())
+    {
+      WriteToStream(output);
+    }
+
+    written_count_ += num_written;
+  }
+}
+
+/**
+ * Internal: Write (and flush) a batch of output to the current stream
+ *
+ * @param output The batch of formatted records
+ */
+void AsyncLogWriter::WriteToStream(std::string const &output)
+{
+  std::lock_guard<std::mutex> lock(stream_lock_);
+
+  if (stream_ != nullptr)
+  {
+    std::fwrite(output.data(), 1, output.size(), stream_);
+    std::fflush(stream_);
+  }
+}
+
+/**
+ * Internal: Close the current stream if it is owned by the writer (stream lock must be held)
+ */
+void AsyncLogWriter::CloseOwnedStream()
+{
+  if (owns_stream_ && (stream_ != nullptr))
+  {
+    std::fclose(stream_);
+  }
+
+  stream_      = nullptr;
+  owns_stream_ = false;
+}
+
+}  // namespace log
+}  // namespace fetch
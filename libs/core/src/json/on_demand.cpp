@@ -0,0 +1,500 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/json/exceptions.hpp"
+#include "core/json/on_demand.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+
+namespace fetch {
+namespace json {
+namespace {
+
+using ConstByteArray = byte_array::ConstByteArray;
+
+JSONParseException ParseError(std::string const &message, std::size_t position)
+{
+  return JSONParseException(message + " at position " + std::to_string(position));
+}
+
+bool IsWhitespace(char c)
+{
+  return (c == ' ') || (c == '\t') || (c == '\n') || (c == '\r');
+}
+
+}  // namespace
+
+/**
+ * Construct a value from an entry of the structural index
+ *
+ * @param index The structural index of the document
+ * @param entry The entry at which the value starts
+ */
+OnDemandValue::OnDemandValue(StructuralIndex const &index, std::size_t entry)
+  : index_{&index}
+  , entry_{entry}
+{}
+
+/**
+ * Determine the type of the value from its first character
+ *
+ * @return The type of the value
+ * @throws JSONParseException if the value is not valid JSON
+ */
+OnDemandValue::Type OnDemandValue::type() const
+{
+  char const c = character();
+
+  switch (c)
+  {
+  case '{':
+    return Type::OBJECT;
+  case '[':
+    return Type::ARRAY;
+  case '"':
+    return Type::STRING;
+  case 't':
+  case 'f':
+    return Type::BOOLEAN;
+  case 'n':
+    return Type::NULL_VALUE;
+  default:
+    if ((c == '-') || ((c >= '0') && (c <= '9')))
+    {
+      return Type::NUMBER;
+    }
+
+    throw ParseError(std::string("Unexpected character '") + c + "'",
+                     index_->position(entry_));
+  }
+}
+
+bool OnDemandValue::IsObject() const
+{
+  return type() == Type::OBJECT;
+}
+
+bool OnDemandValue::IsArray() const
+{
+  return type() == Type::ARRAY;
+}
+
+bool OnDemandValue::IsString() const
+{
+  return type() == Type::STRING;
+}
+
+bool OnDemandValue::IsNumber() const
+{
+  return type() == Type::NUMBER;
+}
+
+bool OnDemandValue::IsBoolean() const
+{
+  return type() == Type::BOOLEAN;
+}
+
+bool OnDemandValue::IsNull() const
+{
+  return type() == Type::NULL_VALUE;
+}
+
+/**
+ * Get the contents of a string value, without the quotes. Escape sequences are not decoded.
+ *
+ * @return The raw contents of the string
+ * @throws JSONParseException if the value is not a string
+ */
+OnDemandValue::ConstByteArray OnDemandValue::AsString() const
+{
+  Expect(Type::STRING);
+
+  std::size_t const begin = index_->position(entry_) + 1u;
+  std::size_t const end   = index_->position(index_->match(entry_));
+
+  return index_->document().SubArray(begin, end - begin);
+}
+
+/**
+ * Get the value of an integer
+ *
+ * @return The integer value
+ * @throws JSONParseException if the value is not an integer or is out of range
+ */
+int64_t OnDemandValue::AsInteger() const
+{
+  Expect(Type::NUMBER);
+
+  ConstByteArray const text     = Scalar();
+  char const *         ptr      = text.char_pointer();
+  char const *         end      = ptr + text.size();
+  bool const           negative = (*ptr == '-');
+
+  if (negative)
+  {
+    ++ptr;
+  }
+
+  if (ptr == end)
+  {
+    throw ParseError("Invalid integer", index_->position(entry_));
+  }
+
+  // accumulated as the magnitude so that the most negative value can be represented
+  uint64_t const limit = static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) +
+                         static_cast<uint64_t>(negative ? 1u : 0u);
+
+  uint64_t magnitude{0};
+  for (; ptr != end; ++ptr)
+  {
+    if ((*ptr < '0') || (*ptr > '9'))
+    {
+      throw ParseError("Invalid integer", index_->position(entry_));
+    }
+
+    auto const digit = static_cast<uint64_t>(*ptr - '0');
+    if (magnitude > ((limit - digit) / 10u))
+    {
+      throw ParseError("Integer out of range", index_->position(entry_));
+    }
+
+    magnitude = (magnitude * 10u) + digit;
+  }
+
+  if (negative)
+  {
+    return (magnitude == limit) ? std::numeric_limits<int64_t>::min()
+                                : -static_cast<int64_t>(magnitude);
+  }
+
+  return static_cast<int64_t>(magnitude);
+}
+
+/**
+ * Get the value of a number as floating point
+ *
+ * @return The floating point value
+ * @throws JSONParseException if the value is not a number
+ */
+double OnDemandValue::AsFloat() const
+{
+  Expect(Type::NUMBER);
+
+  // the document is not guaranteed to be null terminated
+  std::string const text{static_cast<std::string>(Scalar())};
+
+  char *       end{nullptr};
+  double const value = std::strtod(text.c_str(), &end);
+
+  if (end != (text.c_str() + text.size()))
+  {
+    throw ParseError("Invalid number", index_->position(entry_));
+  }
+
+  return value;
+}
+
+/**
+ * Get the value of a boolean
+ *
+ * @return The boolean value
+ * @throws JSONParseException if the value is not a boolean
+ */
+bool OnDemandValue::AsBool() const
+{
+  Expect(Type::BOOLEAN);
+
+  ConstByteArray const text = Scalar();
+  if (text == "true")
+  {
+    return true;
+  }
+
+  if (text == "false")
+  {
+    return false;
+  }
+
+  throw ParseError("Invalid literal", index_->position(entry_));
+}
+
+/**
+ * Find a member of an object. Where a key is repeated the first member is found.
+ *
+ * @param key The key of the member
+ * @param value The output value of the member
+ * @return true if the member was found, otherwise false
+ * @throws JSONParseException if the value is not a (well formed) object
+ */
+bool OnDemandValue::Find(ConstByteArray const &key, OnDemandValue &value) const
+{
+  Expect(Type::OBJECT);
+
+  std::size_t const end = index_->match(entry_);
+  for (std::size_t member = FirstChild(); member != end;)
+  {
+    std::size_t const member_value = MemberValue(member);
+
+    if (KeyEquals(member, key))
+    {
+      value = OnDemandValue{*index_, member_value};
+      return true;
+    }
+
+    member = NextChild(member_value);
+  }
+
+  return false;
+}
+
+/**
+ * Count the number of elements of an array or members of an object
+ *
+ * @return The number of elements or members
+ * @throws JSONParseException if the value is not a (well formed) array or object
+ */
+std::size_t OnDemandValue::size() const
+{
+  std::size_t count{0};
+
+  if (IsObject())
+  {
+    ForEachMember([&count](ConstByteArray const &, OnDemandValue const &) { ++count; });
+  }
+  else
+  {
+    ForEach([&count](OnDemandValue const &) { ++count; });
+  }
+
+  return count;
+}
+
+/**
+ * Get the structural character at the start of the value
+ *
+ * @return The character
+ */
+char OnDemandValue::character() const
+{
+  if (index_ == nullptr)
+  {
+    throw JSONParseException("Access to an empty JSON value");
+  }
+
+  return index_->character(entry_);
+}
+
+/**
+ * Get the text of a number or literal, which extends up to the next structural character
+ *
+ * @return The text of the value
+ */
+OnDemandValue::ConstByteArray OnDemandValue::Scalar() const
+{
+  ConstByteArray const &document = index_->document();
+
+  bool const        last  = (entry_ + 1u) == index_->size();
+  std::size_t const begin = index_->position(entry_);
+  std::size_t       end   = last ? document.size() : index_->position(entry_ + 1u);
+
+  while ((end > begin) && IsWhitespace(document.char_pointer()[end - 1u]))
+  {
+    --end;
+  }
+
+  return document.SubArray(begin, end - begin);
+}
+
+/**
+ * Check the type of the value
+ *
+ * @param type The expected type
+ * @throws JSONParseException if the value is of a different type
+ */
+void OnDemandValue::Expect(Type type) const
+{
+  if (this->type() != type)
+  {
+    throw ParseError("Unexpected type of value", index_->position(entry_));
+  }
+}
+
+/**
+ * Get the first element of an array (or key of an object)
+ *
+ * @return The index entry of the first child, or the closing bracket if there are none
+ */
+std::size_t OnDemandValue::FirstChild() const
+{
+  return entry_ + 1u;
+}
+
+/**
+ * Get the element of an array (or key of an object) which follows a value
+ *
+ * @param value The index entry of the preceding value
+ * @return The index entry of the next child, or the closing bracket if there are none
+ * @throws JSONParseException if the children are not separated by commas
+ */
+std::size_t OnDemandValue::NextChild(std::size_t value) const
+{
+  std::size_t const end  = index_->match(entry_);
+  std::size_t const next = index_->match(value) + 1u;
+
+  if (next == end)
+  {
+    return end;
+  }
+
+  if (index_->character(next) != ',')
+  {
+    throw ParseError("Expected ','", index_->position(next));
+  }
+
+  if ((next + 1u) == end)
+  {
+    throw ParseError("Trailing ','", index_->position(next));
+  }
+
+  return next + 1u;
+}
+
+/**
+ * Get the value of an object member
+ *
+ * @param key The index entry of the (opening quote of the) key
+ * @return The index entry of the value
+ * @throws JSONParseException if the member is not of the form "key": value
+ */
+std::size_t OnDemandValue::MemberValue(std::size_t key) const
+{
+  std::size_t const end   = index_->match(entry_);
+  std::size_t const colon = key + 2u;
+
+  if (index_->character(key) != '"')
+  {
+    throw ParseError("Expected object key", index_->position(key));
+  }
+
+  if ((colon >= end) || (index_->character(colon) != ':'))
+  {
+    throw ParseError("Expected ':'", index_->position(key + 1u));
+  }
+
+  if ((colon + 1u) == end)
+  {
+    throw ParseError("Missing object value", index_->position(colon));
+  }
+
+  return colon + 1u;
+}
+
+/**
+ * Get the contents of the key of an object member
+ *
+ * @param key The index entry of the (opening quote of the) key
+ * @return The raw contents of the key
+ */
+OnDemandValue::ConstByteArray OnDemandValue::MemberKey(std::size_t key) const
+{
+  std::size_t const begin = index_->position(key) + 1u;
+  std::size_t const end   = index_->position(key + 1u);
+
+  return index_->document().SubArray(begin, end - begin);
+}
+
+/**
+ * Compare the key of an object member, without creating a view of it
+ *
+ * @param key The index entry of the (opening quote of the) key
+ * @param value The key to be compared against
+ * @return true if the keys are the same, otherwise false
+ */
+bool OnDemandValue::KeyEquals(std::size_t key, ConstByteArray const &value) const
+{
+  std::size_t const begin = index_->position(key) + 1u;
+  std::size_t const size  = index_->position(key + 1u) - begin;
+
+  return (size == value.size()) &&
+         (std::memcmp(index_->document().pointer() + begin, value.pointer(), size) == 0);
+}
+
+/**
+ * Parse a JSON document
+ *
+ * @param document The document to be parsed
+ */
+OnDemandDocument::OnDemandDocument(ConstByteArray const &document)
+{
+  Parse(document);
+}
+
+/**
+ * Parse a JSON document. Only the structure of the document is checked, the values are decoded as
+ * they are accessed.
+ *
+ * @param document The document to be parsed
+ * @param kernel The kernel used to build the structural index
+ * @throws JSONParseException if the document is empty or not well formed
+ */
+void OnDemandDocument::Parse(ConstByteArray const &document, Kernel kernel)
+{
+  index_.Build(document, kernel);
+
+  if (index_.size() == 0)
+  {
+    throw JSONParseException("Empty JSON document");
+  }
+
+  std::size_t const root_end = index_.match(0) + 1u;
+  if (root_end != index_.size())
+  {
+    throw ParseError("Unexpected content after the root value", index_.position(root_end));
+  }
+}
+
+/**
+ * Get the root value of the document
+ *
+ * @return The root value
+ */
+OnDemandValue OnDemandDocument::root() const
+{
+  if (index_.size() == 0)
+  {
+    throw JSONParseException("No JSON document has been parsed");
+  }
+
+  return {index_, 0};
+}
+
+/**
+ * Get the structural index of the document
+ *
+ * @return The structural index
+ */
+StructuralIndex const &OnDemandDocument::index() const
+{
+  return index_;
+}
+
+}  // namespace json
+}  // namespace fetch
@@ -0,0 +1,307 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/json/exceptions.hpp"
+#include "core/json/structural_index.hpp"
+#include "core/json/structural_index_detail.hpp"
+#include "vectorise/platform.hpp"
+
+#include <limits>
+#include <string>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace fetch {
+namespace json {
+namespace detail {
+namespace {
+
+/**
+ * Byte at a time character classification
+ */
+struct ScalarOps
+{
+  static CharacterMasks Classify(uint8_t const *block)
+  {
+    CharacterMasks masks{};
+
+    for (std::size_t i = 0; i < 64; ++i)
+    {
+      uint64_t const bit = 1ull << i;
+
+      switch (block[i])
+      {
+      case '"':
+        masks.quotes |= bit;
+        break;
+      case '\\':
+        masks.backslashes |= bit;
+        break;
+      case '{':
+      case '}':
+      case '[':
+      case ']':
+      case ':':
+      case ',':
+        masks.operators |= bit;
+        break;
+      case ' ':
+      case '\t':
+      case '\n':
+      case '\r':
+        masks.whitespace |= bit;
+        break;
+      default:
+        break;
+      }
+    }
+
+    return masks;
+  }
+};
+
+#ifdef __SSE2__
+
+/**
+ * 16 bytes at a time character classification
+ */
+struct SSE2Ops
+{
+  using Vector = __m128i;
+
+  static uint64_t Equal(Vector const *chunks, char c)
+  {
+    Vector const value = _mm_set1_epi8(c);
+
+    uint64_t mask{0};
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+      auto const bits = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunks[i], value)));
+      mask |= static_cast<uint64_t>(bits) << (16u * i);
+    }
+
+    return mask;
+  }
+
+  static CharacterMasks Classify(uint8_t const *block)
+  {
+    Vector chunks[4];
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+      chunks[i] = _mm_loadu_si128(reinterpret_cast<Vector const *>(block + (16u * i)));
+    }
+
+    CharacterMasks masks{};
+    masks.quotes      = Equal(chunks, '"');
+    masks.backslashes = Equal(chunks, '\\');
+    masks.operators   = Equal(chunks, '{') | Equal(chunks, '}') | Equal(chunks, '[') |
+                      Equal(chunks, ']') | Equal(chunks, ':') | Equal(chunks, ',');
+    masks.whitespace =
+        Equal(chunks, ' ') | Equal(chunks, '\t') | Equal(chunks, '\n') | Equal(chunks, '\r');
+
+    return masks;
+  }
+};
+
+#endif
+
+}  // namespace
+
+/**
+ * Index a document a byte at a time
+ *
+ * @param data The document to be indexed
+ * @param size The size of the document in bytes
+ * @param positions The output buffer for the positions
+ * @return The number of structural characters found
+ */
+std::size_t StructuralIndexScalar(uint8_t const *data, std::size_t size, uint32_t *positions)
+{
+  return StructuralIndexer<ScalarOps>::Index(data, size, positions);
+}
+
+/**
+ * Index a document 16 bytes at a time
+ *
+ * @param data The document to be indexed
+ * @param size The size of the document in bytes
+ * @param positions The output buffer for the positions
+ * @return The number of structural characters found
+ */
+std::size_t StructuralIndexSSE2(uint8_t const *data, std::size_t size, uint32_t *positions)
+{
+#ifdef __SSE2__
+  return StructuralIndexer<SSE2Ops>::Index(data, size, positions);
+#else
+  return StructuralIndexScalar(data, size, positions);
+#endif
+}
+
+}  // namespace detail
+
+/**
+ * Build the index of a document
+ *
+ * @param document The document to be indexed
+ * @param kernel The kernel to be used, falling back to slower kernels when it is not supported
+ * @throws JSONParseException if the brackets are not balanced or a string is not terminated
+ */
+void StructuralIndex::Build(ConstByteArray const &document, Kernel kernel)
+{
+  if (document.size() >= std::numeric_limits<uint32_t>::max())
+  {
+    throw JSONParseException("JSON document is too large to be indexed");
+  }
+
+  document_ = document;
+  size_     = 0;
+
+  // every byte of the document is at most one structural character
+  Reserve(document.size());
+
+  if (kernel == Kernel::AUTO)
+  {
+    kernel = Kernel::AVX2;
+  }
+
+  if ((kernel == Kernel::AVX2) && !IsSupported(Kernel::AVX2))
+  {
+    kernel = Kernel::SSE2;
+  }
+
+  switch (kernel)
+  {
+  case Kernel::AVX2:
+    size_ = detail::StructuralIndexAVX2(document.pointer(), document.size(), positions_.get());
+    break;
+  case Kernel::SSE2:
+    size_ = detail::StructuralIndexSSE2(document.pointer(), document.size(), positions_.get());
+    break;
+  default:
+    size_ = detail::StructuralIndexScalar(document.pointer(), document.size(), positions_.get());
+    break;
+  }
+
+  Match();
+}
+
+/**
+ * Determine if a kernel can be used on this CPU
+ *
+ * @param kernel The kernel to be checked
+ * @return true if the kernel is supported, otherwise false
+ */
+bool StructuralIndex::IsSupported(Kernel kernel)
+{
+  switch (kernel)
+  {
+  case Kernel::AVX2:
+    return platform::cpu_supports_avx2() && detail::StructuralIndexHasAVX2Kernel();
+  case Kernel::SSE2:
+    return platform::has_sse2();
+  default:
+    return true;
+  }
+}
+
+/**
+ * Ensure that the buffers can hold the specified number of entries. The contents of the buffers
+ * are not preserved.
+ *
+ * @param capacity The required number of entries
+ */
+void StructuralIndex::Reserve(std::size_t capacity)
+{
+  if (capacity > capacity_)
+  {
+    positions_.reset(new uint32_t[capacity]);
+    matches_.reset(new uint32_t[capacity]);
+    capacity_ = capacity;
+  }
+}
+
+/**
+ * Pair up the brackets and the quotes of the index
+ *
+ * @throws JSONParseException if the brackets are not balanced or a string is not terminated
+ */
+void StructuralIndex::Match()
+{
+  ConstByteArray const &document = document_;
+  char const *          text     = document.char_pointer();
+
+  open_stack_.clear();
+
+  for (std::size_t entry = 0; entry < size_; ++entry)
+  {
+    auto const current = static_cast<uint32_t>(entry);
+    char const c       = text[positions_[entry]];
+
+    switch (c)
+    {
+    case '{':
+    case '[':
+      open_stack_.push_back(current);
+      break;
+
+    case '}':
+    case ']':
+    {
+      char const expected = (c == '}') ? '{' : '[';
+      if (open_stack_.empty() || (text[positions_[open_stack_.back()]] != expected))
+      {
+        throw JSONParseException(std::string("Unexpected '") + c + "' at position " +
+                                 std::to_string(positions_[entry]));
+      }
+
+      matches_[open_stack_.back()] = current;
+      matches_[entry]              = current;
+      open_stack_.pop_back();
+      break;
+    }
+
+    case '"':
+      // nothing inside of a string is structural, so the closing quote is always the next entry
+      if ((entry + 1) >= size_)
+      {
+        throw JSONParseException("Unterminated string at position " +
+                                 std::to_string(positions_[entry]));
+      }
+
+      matches_[entry]     = current + 1u;
+      matches_[entry + 1] = current + 1u;
+      ++entry;
+      break;
+
+    default:
+      matches_[entry] = current;
+      break;
+    }
+  }
+
+  if (!open_stack_.empty())
+  {
+    throw JSONParseException("Unterminated object or array at position " +
+                             std::to_string(positions_[open_stack_.back()]));
+  }
+}
+
+}  // namespace json
+}  // namespace fetch
@@ -0,0 +1,109 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+// This file is compiled with AVX2 enabled (see the library CMakeLists.txt) and is only called once
+// the CPU has been detected to support it. It must therefore not include any headers which might
+// emit (non-internal) inline functions which could be shared with the rest of the library.
+#include "core/json/structural_index_detail.hpp"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace fetch {
+namespace json {
+namespace detail {
+namespace {
+
+#ifdef __AVX2__
+
+/**
+ * 32 bytes at a time character classification
+ */
+struct AVX2Ops
+{
+  using Vector = __m256i;
+
+  static uint64_t Equal(Vector const *chunks, char c)
+  {
+    Vector const value = _mm256_set1_epi8(c);
+
+    auto const low =
+        static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunks[0], value)));
+    auto const high =
+        static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunks[1], value)));
+
+    return static_cast<uint64_t>(low) | (static_cast<uint64_t>(high) << 32u);
+  }
+
+  static CharacterMasks Classify(uint8_t const *block)
+  {
+    Vector chunks[2];
+    chunks[0] = _mm256_loadu_si256(reinterpret_cast<Vector const *>(block));
+    chunks[1] = _mm256_loadu_si256(reinterpret_cast<Vector const *>(block + 32));
+
+    CharacterMasks masks{};
+    masks.quotes      = Equal(chunks, '"');
+    masks.backslashes = Equal(chunks, '\\');
+    masks.operators   = Equal(chunks, '{') | Equal(chunks, '}') | Equal(chunks, '[') |
+                      Equal(chunks, ']') | Equal(chunks, ':') | Equal(chunks, ',');
+    masks.whitespace =
+        Equal(chunks, ' ') | Equal(chunks, '\t') | Equal(chunks, '\n') | Equal(chunks, '\r');
+
+    return masks;
+  }
+};
+
+#endif
+
+}  // namespace
+
+/**
+ * Index a document 32 bytes at a time
+ *
+ * @param data The document to be indexed
+ * @param size The size of the document in bytes
+ * @param positions The output buffer for the positions
+ * @return The number of structural characters found
+ */
+std::size_t StructuralIndexAVX2(uint8_t const *data, std::size_t size, uint32_t *positions)
+{
+#ifdef __AVX2__
+  return StructuralIndexer<AVX2Ops>::Index(data, size, positions);
+#else
+  return StructuralIndexSSE2(data, size, positions);
+#endif
+}
+
+/**
+ * Determine if the library has been built with the AVX2 kernel
+ *
+ * @return true if the kernel is available, otherwise false
+ */
+bool StructuralIndexHasAVX2Kernel()
+{
+#ifdef __AVX2__
+  return true;
+#else
+  return false;
+#endif
+}
+
+}  // namespace detail
+}  // namespace json
+}  // namespace fetch
@@ -0,0 +1,258 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/memory/arena.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace fetch {
+namespace core {
+namespace {
+
+/**
+ * The header placed in front of the tagged allocations, it records the arena (if any) which the
+ * allocation was made from. The header is padded to the maximum fundamental alignment so that the
+ * memory following it is suitably aligned for any type.
+ */
+struct alignas(alignof(std::max_align_t)) TagHeader
+{
+  Arena *arena;
+};
+
+/**
+ * Compute the padding required to align a pointer
+ *
+ * @param ptr The pointer to be aligned
+ * @param alignment The required alignment (a power of two)
+ * @return The number of bytes of padding
+ */
+std::size_t Padding(uint8_t const *ptr, std::size_t alignment)
+{
+  auto const address = reinterpret_cast<std::uintptr_t>(ptr);
+  return static_cast<std::size_t>((alignment - (address & (alignment - 1u))) & (alignment - 1u));
+}
+
+}  // namespace
+
+thread_local Arena *Arena::current_{nullptr};
+
+/**
+ * Construct the arena, no memory is allocated until the first allocation is made
+ *
+ * @param block_size The size of the blocks of memory requested from the system
+ */
+Arena::Arena(std::size_t block_size)
+  : block_size_{block_size}
+{}
+
+/**
+ * Allocate memory from the arena
+ *
+ * @param size The number of bytes being requested
+ * @param alignment The required alignment of the memory (a power of two)
+ * @return The pointer to the allocated memory
+ */
+void *Arena::Allocate(std::size_t size, std::size_t alignment)
+{
+  assert((alignment != 0) && ((alignment & (alignment - 1u)) == 0));
+
+  uint8_t *ptr = nullptr;
+
+  if (current_block_ < blocks_.size())
+  {
+    auto &block = blocks_[current_block_];
+
+    uint8_t *const    next    = block.data.get() + offset_;
+    std::size_t const padding = Padding(next, alignment);
+
+    if ((offset_ + padding + size) <= block.size)
+    {
+      ptr = next + padding;
+      offset_ += padding + size;
+    }
+  }
+
+  if (ptr == nullptr)
+  {
+    ptr = AllocateFromNextBlock(size, alignment);
+  }
+
+  ++num_allocations_;
+  ++num_live_;
+
+  return ptr;
+}
+
+/**
+ * Release memory previously allocated from the arena. The memory is only recycled once the arena
+ * has been reset
+ *
+ * @param ptr The pointer to the allocated memory
+ */
+void Arena::Deallocate(void *ptr) noexcept
+{
+  if (ptr != nullptr)
+  {
+    assert(num_live_ > 0);
+    num_live_.fetch_sub(1, std::memory_order_release);
+  }
+}
+
+/**
+ * Recycle all of the memory of the arena. The blocks of memory are retained so that subsequent
+ * allocations do not need to go back to the system. The arena can only be reset once all of the
+ * allocations made from it have been released.
+ *
+ * @return true if the arena was reset, otherwise false
+ */
+bool Arena::Reset()
+{
+  if (num_live_.load(std::memory_order_acquire) != 0)
+  {
+    return false;
+  }
+
+  current_block_   = 0;
+  offset_          = 0;
+  num_allocations_ = 0;
+
+  return true;
+}
+
+/**
+ * Get the total amount of memory owned by the arena
+ *
+ * @return The number of bytes
+ */
+std::size_t Arena::capacity() const
+{
+  std::size_t total{0};
+  for (auto const &block : blocks_)
+  {
+    total += block.size;
+  }
+
+  return total;
+}
+
+/**
+ * Allocate memory from the arena of the current thread, or from the heap if the current thread
+ * does not have an arena. The memory must be released with DeallocateTagged, which is safe to call
+ * regardless of the arena (if any) which is current at that point.
+ *
+ * @param size The number of bytes being requested
+ * @return The pointer to the allocated memory
+ */
+void *Arena::AllocateTagged(std::size_t size)
+{
+  std::size_t const total = sizeof(TagHeader) + size;
+
+  Arena *const arena = current_;
+
+  void *raw = (arena != nullptr) ? arena->Allocate(total, alignof(TagHeader))
+                                 : ::operator new(total);
+
+  auto *header  = static_cast<TagHeader *>(raw);
+  header->arena = arena;
+
+  return header + 1;
+}
+
+/**
+ * Release memory allocated with AllocateTagged
+ *
+ * @param ptr The pointer to the allocated memory
+ */
+void Arena::DeallocateTagged(void *ptr) noexcept
+{
+  if (ptr == nullptr)
+  {
+    return;
+  }
+
+  auto *header = static_cast<TagHeader *>(ptr) - 1;
+
+  if (header->arena != nullptr)
+  {
+    header->arena->Deallocate(header);
+  }
+  else
+  {
+    ::operator delete(header);
+  }
+}
+
+/**
+ * Internal: Move on to the next block of memory which is large enough for the allocation, creating
+ * a new block if required
+ *
+ * @param size The number of bytes being requested
+ * @param alignment The required alignment of the memory
+ * @return The pointer to the allocated memory
+ */
+uint8_t *Arena::AllocateFromNextBlock(std::size_t size, std::size_t alignment)
+{
+  std::size_t const required = size + alignment;
+
+  // the blocks retained from before the last reset are reused when they are large enough
+  std::size_t next = blocks_.empty() ? 0 : current_block_ + 1;
+  if ((next < blocks_.size()) && (blocks_[next].size < required))
+  {
+    // oversized allocations are given a block of their own, which is inserted in place
+    std::size_t const block_size = std::max(block_size_, required);
+    blocks_.insert(blocks_.begin() + static_cast<std::ptrdiff_t>(next),
+                   Block{std::unique_ptr<uint8_t[]>(new uint8_t[block_size]), block_size});
+  }
+  else if (next == blocks_.size())
+  {
+    std::size_t const block_size = std::max(block_size_, required);
+    blocks_.push_back(Block{std::unique_ptr<uint8_t[]>(new uint8_t[block_size]), block_size});
+  }
+
+  current_block_ = next;
+
+  uint8_t *const    base    = blocks_[current_block_].data.get();
+  std::size_t const padding = Padding(base, alignment);
+
+  offset_ = padding + size;
+
+  return base + padding;
+}
+
+/**
+ * Make the specified arena the arena of the current thread
+ *
+ * @param arena The arena to be used
+ */
+ArenaScope::ArenaScope(Arena &arena)
+  : previous_{Arena::current_}
+{
+  Arena::current_ = &arena;
+}
+
+/**
+ * Restore the previous arena of the current thread
+ */
+ArenaScope::~ArenaScope()
+{
+  Arena::current_ = previous_;
+}
+
+}  // namespace core
+}  // namespace fetch
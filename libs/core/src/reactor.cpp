@@ -21,44 +21,124 @@
 #include "core/runnable.hpp"
 #include "core/threading.hpp"
 
+#include <algorithm>
 #include <chrono>
-#include <deque>
+#include <exception>
+#include <stdexcept>
 
+// the interval at which runnables which can not predict their next execution time are evaluated
 static const std::chrono::milliseconds POLL_INTERVAL{15};
 
-using WorkQueue = std::deque<fetch::core::WeakRunnable>;
-
 namespace fetch {
 namespace core {
 
-Reactor::Reactor(std::string name)
+/**
+ * Construct the reactor
+ *
+ * @param name The name of the reactor (used to name the worker threads)
+ * @param num_workers The number of worker threads
+ */
+Reactor::Reactor(std::string name, std::size_t num_workers)
   : name_{std::move(name)}
+  , num_workers_{std::max<std::size_t>(num_workers, 1)}
 {}
 
-bool Reactor::Attach(WeakRunnable runnable)
+Reactor::~Reactor()
 {
-  bool success{false};
+  Stop();
+  ClearNotifiers();
+}
 
+/**
+ * Attach a runnable to the reactor. The runnable will be evaluated as soon as the reactor is
+ * running.
+ *
+ * @param runnable The runnable to be attached
+ * @return true if successful, false if the runnable has expired or is already attached
+ */
+bool Reactor::Attach(WeakRunnable runnable)
+{
   // convert to concrete runnable
   auto concrete_runnable = runnable.lock();
-  if (concrete_runnable)
+  if (!concrete_runnable)
+  {
+    return false;
+  }
+
+  auto entry      = std::make_shared<Entry>();
+  entry->key      = concrete_runnable.get();
+  entry->runnable = runnable;
+
   {
-    FETCH_LOCK(work_map_mutex_);
+    Lock lock{lock_};
 
     // attempt to insert the element into the map
-    auto const result = work_map_.insert(std::make_pair(concrete_runnable.get(), runnable));
+    auto result = entries_.emplace(concrete_runnable.get(), entry);
+    if (!result.second)
+    {
+      auto &existing = result.first->second;
 
-    // signal success if the insertion was successful
-    success = result.second;
+      // replace the entry only if it belongs to an expired runnable at the same address
+      if (!existing->runnable.expired())
+      {
+        return false;
+      }
+
+      existing->detached = true;
+      existing           = entry;
+    }
+
+    Enqueue(entry);
   }
 
-  return success;
+  // the entry is captured weakly so that notifications after detaching are ignored. The
+  // notifier must be set outside of the reactor lock, since it is called with the runnable's
+  // notifier lock held.
+  std::weak_ptr<Entry> weak_entry{entry};
+  concrete_runnable->SetNotifier([this, weak_entry]() {
+    auto entry = weak_entry.lock();
+    if (entry)
+    {
+      Wake(entry);
+    }
+  });
+
+  return true;
 }
 
+/**
+ * Detach a runnable from the reactor. If the runnable is currently being executed it will
+ * complete that execution.
+ *
+ * @param runnable The runnable to be detached
+ * @return true if successful, otherwise false
+ */
 bool Reactor::Detach(Runnable const &runnable)
 {
-  FETCH_LOCK(work_map_mutex_);
-  return (work_map_.erase(&runnable) > 0);
+  std::shared_ptr<Runnable> concrete_runnable{};
+
+  {
+    Lock lock{lock_};
+
+    auto it = entries_.find(&runnable);
+    if (it == entries_.end())
+    {
+      return false;
+    }
+
+    concrete_runnable = it->second->runnable.lock();
+
+    // any queued work or timers for the entry are discarded lazily
+    it->second->detached = true;
+    entries_.erase(it);
+  }
+
+  if (concrete_runnable)
+  {
+    concrete_runnable->SetNotifier({});
+  }
+
+  return true;
 }
 
 void Reactor::Start()
@@ -66,21 +146,21 @@ void Reactor::Start()
   FETCH_LOCK(worker_mutex_);
 
   // restart the work if called multiple times
-  StopWorker();
-  StartWorker();
+  StopWorkers();
+  StartWorkers();
 }
 
 void Reactor::Stop()
 {
   FETCH_LOCK(worker_mutex_);
 
-  // stop the worker
-  StopWorker();
+  // stop the workers
+  StopWorkers();
 }
 
-void Reactor::StartWorker()
+void Reactor::StartWorkers()
 {
-  if (worker_)
+  if (!workers_.empty())
   {
     FETCH_LOG_ERROR(LOGGING_NAME, "Worker already started, logic start up error");
     throw std::runtime_error("Worker already started");
@@ -89,79 +169,338 @@ void Reactor::StartWorker()
   // signal the reactor is running
   running_ = true;
 
-  // create the worker routine
-  worker_ = std::make_unique<std::thread>(&Reactor::Monitor, this);
+  // create the worker routines
+  for (std::size_t i = 0; i < num_workers_; ++i)
+  {
+    workers_.emplace_back(std::make_unique<std::thread>(&Reactor::Monitor, this, i));
+  }
 }
 
-void Reactor::StopWorker()
+void Reactor::StopWorkers()
 {
-  running_ = false;
+  {
+    Lock lock{lock_};
+    running_ = false;
+  }
 
-  if (worker_)
+  work_available_.notify_all();
+  timer_changed_.notify_all();
+
+  for (auto &worker : workers_)
   {
-    worker_->join();
-    worker_.reset();
+    worker->join();
   }
+
+  workers_.clear();
 }
 
-void Reactor::Monitor()
+/**
+ * The main loop of each of the worker threads
+ *
+ * @param index The index of the worker
+ */
+void Reactor::Monitor(std::size_t index)
 {
   // set the thread name
-  SetThreadName(name_);
+  if (num_workers_ > 1)
+  {
+    SetThreadName(name_, index);
+  }
+  else
+  {
+    SetThreadName(name_);
+  }
 
-  WorkQueue work_queue;
+  Lock lock{lock_};
 
   while (running_)
   {
-    // Step 1. If we have run out of work to execute then gather all the runnables that are ready
-    if (work_queue.empty())
+    // Step 1. Collect any of the parked runnables whose timers have expired
+    AdvanceTimers();
+
+    // Step 2. Evaluate the next runnable in the queue
+    if (!queue_.empty())
     {
-      FETCH_LOCK(work_map_mutex_);
+      auto entry = std::move(queue_.front());
+      queue_.pop_front();
 
-      // loop through and evaluate the map
-      auto it = work_map_.begin();
-      while (it != work_map_.end())
+      // if this worker was keeping time then ensure that another idle worker takes over
+      if (!keeper_active_ && !timers_.empty() && (idle_workers_ > 0))
       {
-        // attempt to lock the runnable
-        auto concrete_runnable = it->second.lock();
-
-        if (concrete_runnable)
-        {
-          // evaluate if the runnable is ready to execute, if it is then add it to the work queue
-          if (concrete_runnable->IsReadyToExecute())
-          {
-            work_queue.emplace_back(it->second);
-          }
-
-          // advance to the next element in the map
-          ++it;
-        }
-        else
-        {
-          // the lifetime of the runnable has expired, remove and advance to next element in the map
-          it = work_map_.erase(it);
-        }
+        work_available_.notify_one();
       }
+
+      Process(lock, entry);
+      continue;
     }
 
-    // If the work queue is still empty then there is no work to do. Sleep the worker and try again
-    if (work_queue.empty())
+    // Step 3. No work to do, wait for the next timer to expire (if no other worker is already
+    // doing so) or for new work to be queued
+    Tick deadline{0};
+    if (!keeper_active_ && timers_.GetNextExpiry(deadline))
     {
-      std::this_thread::sleep_for(POLL_INTERVAL);
-      continue;
+      keeper_active_   = true;
+      keeper_deadline_ = deadline;
+
+      timer_changed_.wait_until(lock, epoch_ + TickDuration{deadline});
+
+      keeper_active_ = false;
     }
+    else
+    {
+      ++idle_workers_;
+      work_available_.wait(lock);
+      --idle_workers_;
+    }
+  }
+}
 
-    // extract the element from the front of the queue
-    auto runnable = work_queue.front().lock();
-    work_queue.pop_front();
+/**
+ * Evaluate a runnable, executing it if it is ready and then either re-queueing it or parking it
+ * until it is next expected to be ready
+ *
+ * @param lock The (held) reactor lock, which is released while the runnable is evaluated
+ * @param entry The entry for the runnable
+ */
+void Reactor::Process(Lock &lock, EntryPtr const &entry)
+{
+  if (entry->detached)
+  {
+    return;
+  }
+
+  auto runnable = entry->runnable.lock();
+  if (!runnable)
+  {
+    // the lifetime of the runnable has expired, remove it
+    entry->detached = true;
 
-    // execute the item if it can be executed
-    if (runnable)
+    auto it = entries_.find(entry->key);
+    if ((it != entries_.end()) && (it->second == entry))
+    {
+      entries_.erase(it);
+    }
+
+    return;
+  }
+
+  entry->status   = Status::RUNNING;
+  entry->notified = false;
+
+  lock.unlock();
+
+  bool      ready{false};
+  bool      next_known{false};
+  Timepoint next{};
+
+  try
+  {
+    if (runnable->IsReadyToExecute())
     {
       runnable->Execute();
     }
+
+    ready = runnable->IsReadyToExecute();
+    if (!ready)
+    {
+      next_known = runnable->GetNextExecutionTime(next);
+    }
+  }
+  catch (std::exception const &ex)
+  {
+    FETCH_LOG_ERROR(LOGGING_NAME, "Caught exception in Reactor::Process - ", ex.what());
+  }
+
+  if (!ready && !next_known)
+  {
+    next = Clock::now() + POLL_INTERVAL;
+  }
+
+  // release the runnable outside of the lock, in case this was the last reference to it
+  runnable.reset();
+
+  lock.lock();
+
+  if (entry->detached)
+  {
+    return;
+  }
+
+  if (ready || entry->notified)
+  {
+    Enqueue(entry);
+  }
+  else
+  {
+    Park(entry, next);
+  }
+}
+
+/**
+ * Signal that a runnable should be re-evaluated as soon as possible
+ *
+ * @param entry The entry for the runnable
+ */
+void Reactor::Wake(EntryPtr const &entry)
+{
+  Lock lock{lock_};
+
+  if (entry->detached)
+  {
+    return;
+  }
+
+  switch (entry->status)
+  {
+  case Status::WAITING:
+    Enqueue(entry);
+    break;
+  case Status::RUNNING:
+    entry->notified = true;
+    break;
+  case Status::QUEUED:
+    break;
+  }
+}
+
+/**
+ * Internal: Add a runnable to the back of the work queue. Must be called with the lock held.
+ *
+ * @param entry The entry for the runnable
+ */
+void Reactor::Enqueue(EntryPtr const &entry)
+{
+  // invalidate any pending timer
+  ++entry->generation;
+  entry->status = Status::QUEUED;
+
+  queue_.push_back(entry);
+
+  if (idle_workers_ > 0)
+  {
+    work_available_.notify_one();
+  }
+  else if (keeper_active_)
+  {
+    timer_changed_.notify_one();
+  }
+}
+
+/**
+ * Internal: Park a runnable until the specified time. Must be called with the lock held.
+ *
+ * @param entry The entry for the runnable
+ * @param next The time at which the runnable should be re-evaluated
+ */
+void Reactor::Park(EntryPtr const &entry, Timepoint const &next)
+{
+  ++entry->generation;
+  entry->status = Status::WAITING;
+
+  Tick const deadline = ToTick(next);
+  timers_.Schedule(deadline, TimerItem{entry, entry->generation});
+
+  if (keeper_active_)
+  {
+    // wake the time keeping worker if it is waiting for a later timer
+    if (deadline < keeper_deadline_)
+    {
+      timer_changed_.notify_one();
+    }
+  }
+  else if (idle_workers_ > 0)
+  {
+    // recruit an idle worker to keep time
+    work_available_.notify_one();
   }
 }
 
+/**
+ * Internal: Queue all of the parked runnables whose timers have expired. Must be called with the
+ * lock held.
+ */
+void Reactor::AdvanceTimers()
+{
+  Timers::ItemList expired;
+  timers_.Advance(CurrentTick(), expired);
+
+  for (auto const &item : expired)
+  {
+    auto const &entry = item.first;
+
+    // ignore timers that have been superseded
+    bool const current = (entry->status == Status::WAITING) && (entry->generation == item.second);
+    if (current && !entry->detached)
+    {
+      Enqueue(entry);
+    }
+  }
+}
+
+/**
+ * Internal: Remove the notifiers from all of the attached runnables
+ */
+void Reactor::ClearNotifiers()
+{
+  RunnableList runnables;
+
+  {
+    Lock lock{lock_};
+
+    for (auto const &element : entries_)
+    {
+      auto runnable = element.second->runnable.lock();
+      if (runnable)
+      {
+        runnables.emplace_back(std::move(runnable));
+      }
+
+      element.second->detached = true;
+    }
+
+    entries_.clear();
+  }
+
+  for (auto const &runnable : runnables)
+  {
+    runnable->SetNotifier({});
+  }
+}
+
+/**
+ * Internal: Get the current tick of the timers, i.e. the number of whole ticks that have elapsed
+ *
+ * @return The current tick
+ */
+Reactor::Tick Reactor::CurrentTick() const
+{
+  auto const elapsed = std::chrono::duration_cast<TickDuration>(Clock::now() - epoch_);
+  return static_cast<Tick>(elapsed.count());
+}
+
+/**
+ * Internal: Convert a point in time to the first timer tick that is not before it, so that timers
+ * never expire early
+ *
+ * @param timepoint The point in time
+ * @return The corresponding tick
+ */
+Reactor::Tick Reactor::ToTick(Timepoint const &timepoint) const
+{
+  if (timepoint <= epoch_)
+  {
+    return 0;
+  }
+
+  auto const elapsed = timepoint - epoch_;
+  auto       ticks   = std::chrono::duration_cast<TickDuration>(elapsed);
+  if (ticks < elapsed)
+  {
+    ++ticks;
+  }
+
+  return static_cast<Tick>(ticks.count());
+}
+
 }  // namespace core
-}  // namespace fetch
\ No newline at end of file
+}  // namespace fetch
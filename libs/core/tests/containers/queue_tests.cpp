@@ -221,4 +221,79 @@ TEST_F(QueueTests, ProducerConsumer_1p_50c_1000x__MPMCQueue)
   ProducerConsumerTest<1, 50, 1000>(queue);
 }
 
+TEST(LockFreeQueueTests, CheckPopTimeout)
+{
+  fetch::core::MPMCQueue<int, 16> queue;
+
+  int value{0};
+  EXPECT_FALSE(queue.Pop(value, std::chrono::milliseconds{10}));
+
+  queue.Push(42);
+  EXPECT_TRUE(queue.Pop(value, std::chrono::milliseconds{10}));
+  EXPECT_EQ(value, 42);
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(LockFreeQueueTests, CheckPushTimeoutWhenFull)
+{
+  fetch::core::MPMCQueue<int, 4> queue;
+
+  std::size_t count{0};
+  for (int i = 0; i < 4; ++i)
+  {
+    EXPECT_TRUE(queue.Push(i, count, std::chrono::milliseconds{10}));
+    EXPECT_EQ(count, static_cast<std::size_t>(i + 1));
+  }
+
+  EXPECT_FALSE(queue.Push(4, count, std::chrono::milliseconds{10}));
+  EXPECT_FALSE(queue.TryPush(4));
+  EXPECT_EQ(queue.size(), 4u);
+}
+
+TEST(LockFreeQueueTests, CheckBulkOperations)
+{
+  fetch::core::MPMCQueue<int, 8> queue;
+
+  std::vector<int> const input{0, 1, 2, 3, 4, 5};
+  queue.PushMany(input.begin(), input.end());
+  EXPECT_EQ(queue.size(), input.size());
+
+  std::vector<int> output;
+  EXPECT_EQ(queue.PopMany(output, 4, std::chrono::milliseconds{10}), 4u);
+  EXPECT_EQ(queue.PopMany(output, 4, std::chrono::milliseconds{10}), 2u);
+  EXPECT_EQ(queue.PopMany(output, 4, std::chrono::milliseconds{10}), 0u);
+  EXPECT_EQ(output, input);
+}
+
+TEST(LockFreeQueueTests, CheckBulkOperationsWrapAround)
+{
+  static constexpr std::size_t NUM_ELEMENTS = 10000;
+
+  fetch::core::MPMCQueue<std::size_t, 16> queue;
+
+  // push more elements than the capacity of the queue so that the producer has to block
+  std::thread producer([&queue]() {
+    std::vector<std::size_t> input(NUM_ELEMENTS);
+    for (std::size_t i = 0; i < NUM_ELEMENTS; ++i)
+    {
+      input[i] = i;
+    }
+
+    queue.PushMany(input.begin(), input.end());
+  });
+
+  std::vector<std::size_t> output;
+  while (output.size() < NUM_ELEMENTS)
+  {
+    ASSERT_GT(queue.PopMany(output, 7, std::chrono::seconds{4}), 0u);
+  }
+
+  producer.join();
+
+  for (std::size_t i = 0; i < NUM_ELEMENTS; ++i)
+  {
+    ASSERT_EQ(output[i], i);
+  }
+}
+
 }  // namespace
@@ -0,0 +1,171 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/json/exceptions.hpp"
+#include "core/json/on_demand.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace {
+
+using fetch::byte_array::ConstByteArray;
+using fetch::json::JSONParseException;
+using fetch::json::OnDemandDocument;
+using fetch::json::OnDemandValue;
+
+using Type = OnDemandValue::Type;
+
+TEST(OnDemandTests, values_are_found_and_decoded)
+{
+  OnDemandDocument doc{R"({
+    "empty": {},
+    "array": [1, -2, 3.5, true, false, null, "text"],
+    "nested": {"value": {"deeper": [[], {}]}, "escaped\"key": "a\"b"}
+  })"};
+
+  OnDemandValue const root = doc.root();
+  ASSERT_TRUE(root.IsObject());
+  EXPECT_EQ(3u, root.size());
+
+  OnDemandValue value;
+  ASSERT_TRUE(root.Find("empty", value));
+  EXPECT_TRUE(value.IsObject());
+  EXPECT_EQ(0u, value.size());
+
+  ASSERT_TRUE(root.Find("array", value));
+  ASSERT_TRUE(value.IsArray());
+  EXPECT_EQ(7u, value.size());
+
+  std::vector<Type> types;
+  value.ForEach([&types](OnDemandValue const &element) { types.push_back(element.type()); });
+
+  std::vector<Type> const expected{Type::NUMBER,  Type::NUMBER,     Type::NUMBER, Type::BOOLEAN,
+                                   Type::BOOLEAN, Type::NULL_VALUE, Type::STRING};
+  EXPECT_EQ(expected, types);
+
+  std::vector<OnDemandValue> elements;
+  value.ForEach([&elements](OnDemandValue const &element) { elements.push_back(element); });
+
+  EXPECT_EQ(1, elements[0].AsInteger());
+  EXPECT_EQ(-2, elements[1].AsInteger());
+  EXPECT_DOUBLE_EQ(3.5, elements[2].AsFloat());
+  EXPECT_TRUE(elements[3].AsBool());
+  EXPECT_FALSE(elements[4].AsBool());
+  EXPECT_TRUE(elements[5].IsNull());
+  EXPECT_EQ(ConstByteArray{"text"}, elements[6].AsString());
+
+  // escape sequences are not decoded
+  ASSERT_TRUE(root.Find("nested", value));
+  OnDemandValue escaped;
+  ASSERT_TRUE(value.Find(R"(escaped\"key)", escaped));
+  EXPECT_EQ(ConstByteArray{R"(a\"b)"}, escaped.AsString());
+
+  EXPECT_FALSE(root.Find("missing", value));
+}
+
+TEST(OnDemandTests, members_are_visited_in_order)
+{
+  OnDemandDocument doc{R"({"a": {"skipped": [1, 2, {"b": 3}]}, "b": "two", "c": [3]})"};
+
+  std::vector<ConstByteArray> keys;
+  doc.root().ForEachMember(
+      [&keys](ConstByteArray const &key, OnDemandValue const &) { keys.push_back(key); });
+
+  std::vector<ConstByteArray> const expected{"a", "b", "c"};
+  EXPECT_EQ(expected, keys);
+
+  OnDemandValue value;
+  ASSERT_TRUE(doc.root().Find("b", value));
+  EXPECT_EQ(ConstByteArray{"two"}, value.AsString());
+}
+
+TEST(OnDemandTests, integers_are_range_checked)
+{
+  OnDemandDocument doc{"[9223372036854775807, -9223372036854775808, 9223372036854775808, 1.5]"};
+
+  std::vector<OnDemandValue> elements;
+  doc.root().ForEach([&elements](OnDemandValue const &element) { elements.push_back(element); });
+  ASSERT_EQ(4u, elements.size());
+
+  EXPECT_EQ(std::numeric_limits<int64_t>::max(), elements[0].AsInteger());
+  EXPECT_EQ(std::numeric_limits<int64_t>::min(), elements[1].AsInteger());
+  EXPECT_THROW(elements[2].AsInteger(), JSONParseException);
+  EXPECT_THROW(elements[3].AsInteger(), JSONParseException);
+  EXPECT_DOUBLE_EQ(1.5, elements[3].AsFloat());
+}
+
+TEST(OnDemandTests, scalar_documents_are_supported)
+{
+  OnDemandDocument doc;
+
+  doc.Parse(" 42 ");
+  EXPECT_EQ(42, doc.root().AsInteger());
+
+  doc.Parse(R"("value")");
+  EXPECT_EQ(ConstByteArray{"value"}, doc.root().AsString());
+}
+
+TEST(OnDemandTests, type_mismatches_are_rejected)
+{
+  OnDemandDocument doc{R"({"a": "1", "b": tru})"};
+
+  OnDemandValue value;
+  ASSERT_TRUE(doc.root().Find("a", value));
+  EXPECT_THROW(value.AsInteger(), JSONParseException);
+  EXPECT_THROW(value.Find("a", value), JSONParseException);
+
+  ASSERT_TRUE(doc.root().Find("b", value));
+  EXPECT_THROW(value.AsBool(), JSONParseException);
+
+  EXPECT_THROW(OnDemandValue{}.type(), JSONParseException);
+}
+
+TEST(OnDemandTests, malformed_documents_are_rejected)
+{
+  OnDemandDocument doc;
+
+  EXPECT_THROW(doc.Parse(""), JSONParseException);
+  EXPECT_THROW(doc.Parse("{} {}"), JSONParseException);
+  EXPECT_THROW(doc.Parse("[1, 2"), JSONParseException);
+
+  auto const visit = [](OnDemandValue const &value) {
+    if (value.IsArray())
+    {
+      value.ForEach([](OnDemandValue const &element) { element.type(); });
+    }
+    else
+    {
+      value.ForEachMember([](ConstByteArray const &, OnDemandValue const &) {});
+    }
+  };
+
+  // syntax errors are found as the values are visited
+  for (char const *text : {"[1 2]", "[1, 2,]", "[,]", R"({"a" 1})", R"({"a": 1,})", R"({"a":})",
+                           "{1: 2}", "[1, :]"})
+  {
+    doc.Parse(text);
+    EXPECT_THROW(visit(doc.root()), JSONParseException) << text;
+  }
+}
+
+}  // namespace
@@ -0,0 +1,270 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/json/exceptions.hpp"
+#include "core/json/structural_index.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using fetch::byte_array::ConstByteArray;
+using fetch::json::JSONParseException;
+using fetch::json::StructuralIndex;
+
+using Kernel    = StructuralIndex::Kernel;
+using Positions = std::vector<std::size_t>;
+
+Positions GetPositions(StructuralIndex const &index)
+{
+  Positions positions;
+  for (std::size_t i = 0; i < index.size(); ++i)
+  {
+    positions.push_back(index.position(i));
+  }
+
+  return positions;
+}
+
+/**
+ * Find the structural characters a byte at a time
+ */
+Positions ReferencePositions(std::string const &text)
+{
+  Positions positions;
+  bool      in_string{false};
+  bool      escaped{false};
+  bool      separator{true};
+
+  for (std::size_t i = 0; i < text.size(); ++i)
+  {
+    char const c = text[i];
+
+    if (in_string)
+    {
+      if (escaped)
+      {
+        escaped = false;
+      }
+      else if (c == '\\')
+      {
+        escaped = true;
+      }
+      else if (c == '"')
+      {
+        positions.push_back(i);
+        in_string = false;
+        separator = true;
+      }
+
+      continue;
+    }
+
+    switch (c)
+    {
+    case '"':
+      positions.push_back(i);
+      in_string = true;
+      break;
+    case '{':
+    case '}':
+    case '[':
+    case ']':
+    case ':':
+    case ',':
+      positions.push_back(i);
+      separator = true;
+      break;
+    case ' ':
+    case '\t':
+    case '\n':
+    case '\r':
+      separator = true;
+      break;
+    default:
+      if (separator)
+      {
+        positions.push_back(i);
+      }
+      separator = false;
+      break;
+    }
+  }
+
+  return positions;
+}
+
+/**
+ * Generate a document with strings full of escape sequences and operators, so that all the
+ * combinations of strings and runs of backslashes straddle the block boundaries
+ */
+std::string GenerateDocument(std::size_t num_elements)
+{
+  std::mt19937                    rng{42};
+  std::uniform_int_distribution<> length{0, 40};
+  std::uniform_int_distribution<> kind{0, 9};
+
+  static char const STRING_CHARS[] = "ab{}[]:, \t";
+
+  std::string text = "[";
+  for (std::size_t i = 0; i < num_elements; ++i)
+  {
+    if (i != 0)
+    {
+      text += (kind(rng) < 5) ? "," : " ,\n";
+    }
+
+    switch (kind(rng) % 4)
+    {
+    case 0:
+      text += std::to_string(rng() % 100000);
+      break;
+    case 1:
+      text += (kind(rng) < 5) ? "true" : "null";
+      break;
+    case 2:
+      text += "{\"key\":" + std::to_string(i) + "}";
+      break;
+    default:
+    {
+      text += '"';
+      for (int j = 0, end = length(rng); j < end; ++j)
+      {
+        int const c = kind(rng);
+        if (c == 0)
+        {
+          // an escaped quote, preceded by any number of escaped backslashes
+          text += std::string(2u * static_cast<std::size_t>(length(rng) % 4), '\\') + "\\\"";
+        }
+        else if (c == 1)
+        {
+          text += "\\\\";
+        }
+        else
+        {
+          text += STRING_CHARS[rng() % (sizeof(STRING_CHARS) - 1u)];
+        }
+      }
+      text += '"';
+      break;
+    }
+    }
+  }
+  text += "]";
+
+  return text;
+}
+
+TEST(StructuralIndexTests, finds_the_structural_characters)
+{
+  std::string const text = R"({"a": [1, -2.5e3 ,true],"b\"c": "x:{y}", "d\\": null})";
+
+  StructuralIndex index;
+  index.Build(text);
+
+  std::string characters;
+  for (std::size_t i = 0; i < index.size(); ++i)
+  {
+    characters.push_back(index.character(i));
+  }
+
+  EXPECT_EQ(R"({"":[1,-,t],"":"","":n})", characters);
+  EXPECT_EQ(ReferencePositions(text), GetPositions(index));
+}
+
+TEST(StructuralIndexTests, brackets_and_strings_are_matched)
+{
+  StructuralIndex index;
+  index.Build(R"([{"a": [[]]}, "b", 3])");
+
+  std::vector<std::size_t> matches;
+  for (std::size_t i = 0; i < index.size(); ++i)
+  {
+    matches.push_back(index.match(i));
+  }
+
+  // the brackets and opening quotes are matched with their closing entries, all else with itself
+  std::vector<std::size_t> const expected{15, 9, 3, 3, 4, 8, 7, 7, 8, 9, 10, 12, 12, 13, 14, 15};
+  EXPECT_EQ(expected, matches);
+}
+
+TEST(StructuralIndexTests, all_the_kernels_find_the_same_characters)
+{
+  std::string const text      = GenerateDocument(5000);
+  Positions const   reference = ReferencePositions(text);
+  ASSERT_GT(reference.size(), 10000u);
+
+  for (auto kernel : {Kernel::SCALAR, Kernel::SSE2, Kernel::AVX2, Kernel::AUTO})
+  {
+    if (!StructuralIndex::IsSupported(kernel))
+    {
+      continue;
+    }
+
+    // every alignment of the document with respect to the blocks
+    for (std::size_t offset = 0; offset < 64; offset += 7)
+    {
+      std::string const padded = std::string(offset, ' ') + text;
+
+      StructuralIndex index;
+      index.Build(padded, kernel);
+
+      Positions positions = GetPositions(index);
+      for (auto &position : positions)
+      {
+        position -= offset;
+      }
+
+      EXPECT_EQ(reference, positions);
+    }
+  }
+}
+
+TEST(StructuralIndexTests, the_index_can_be_reused)
+{
+  StructuralIndex index;
+  index.Build(GenerateDocument(100));
+  index.Build(R"({"a":1})");
+
+  EXPECT_EQ(6u, index.size());
+  EXPECT_EQ(ConstByteArray{R"({"a":1})"}, index.document());
+}
+
+TEST(StructuralIndexTests, malformed_structure_is_rejected)
+{
+  StructuralIndex index;
+
+  EXPECT_THROW(index.Build(R"({"a": [1, 2})"), JSONParseException);
+  EXPECT_THROW(index.Build(R"([1, 2]])"), JSONParseException);
+  EXPECT_THROW(index.Build(R"({"a": [1, 2)"), JSONParseException);
+  EXPECT_THROW(index.Build(R"({"a": "b})"), JSONParseException);
+  EXPECT_THROW(index.Build(R"(["a\"])"), JSONParseException);
+
+  EXPECT_NO_THROW(index.Build(R"(["a\\"])"));
+  EXPECT_NO_THROW(index.Build(""));
+  EXPECT_EQ(0u, index.size());
+}
+
+}  // namespace
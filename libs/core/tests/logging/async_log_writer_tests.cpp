@@ -0,0 +1,189 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/async_log_writer.hpp"
+#include "core/logger.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+
+using fetch::log::AsyncLogWriter;
+
+constexpr char const *OUTPUT_FILE = "async_log_writer_tests.log";
+
+std::vector<std::string> ReadLines(char const *filename)
+{
+  std::vector<std::string> lines;
+
+  std::ifstream stream{filename};
+  std::string   line;
+  while (std::getline(stream, line))
+  {
+    lines.push_back(line);
+  }
+
+  return lines;
+}
+
+TEST(AsyncLogWriterTests, CheckConcurrentRecordsAreWritten)
+{
+  static constexpr std::size_t NUM_THREADS = 8;
+  static constexpr std::size_t NUM_RECORDS = 500;
+
+  std::remove(OUTPUT_FILE);
+
+  {
+    AsyncLogWriter writer;
+    ASSERT_TRUE(writer.SetOutputFile(OUTPUT_FILE));
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < NUM_THREADS; ++i)
+    {
+      threads.emplace_back([&writer, i]() {
+        for (std::size_t j = 0; j < NUM_RECORDS; ++j)
+        {
+          writer.Write(std::to_string(i) + ":" + std::to_string(j) + "\n");
+        }
+      });
+    }
+
+    for (auto &thread : threads)
+    {
+      thread.join();
+    }
+
+    writer.Flush();
+    EXPECT_EQ(writer.dropped_count(), 0u);
+    EXPECT_EQ(writer.written_count(), NUM_THREADS * NUM_RECORDS);
+  }
+
+  // every record must have been written exactly once and must not have been interleaved
+  auto const lines = ReadLines(OUTPUT_FILE);
+  ASSERT_EQ(lines.size(), NUM_THREADS * NUM_RECORDS);
+
+  std::unordered_set<std::string> unique_lines(lines.begin(), lines.end());
+  EXPECT_EQ(unique_lines.size(), lines.size());
+
+  std::remove(OUTPUT_FILE);
+}
+
+TEST(AsyncLogWriterTests, CheckPendingRecordsAreWrittenOnDestruction)
+{
+  std::remove(OUTPUT_FILE);
+
+  {
+    AsyncLogWriter writer;
+    ASSERT_TRUE(writer.SetOutputFile(OUTPUT_FILE));
+
+    for (std::size_t i = 0; i < 100; ++i)
+    {
+      writer.Write("record\n");
+    }
+  }
+
+  EXPECT_EQ(ReadLines(OUTPUT_FILE).size(), 100u);
+
+  std::remove(OUTPUT_FILE);
+}
+
+TEST(AsyncLogWriterTests, CheckRuntimeLogLevel)
+{
+  using Level = fetch::log::DefaultLogger::Level;
+
+  fetch::logger.SetLevel(Level::WARNING);
+  EXPECT_TRUE(fetch::logger.IsEnabled(Level::ERROR));
+  EXPECT_TRUE(fetch::logger.IsEnabled(Level::WARNING));
+  EXPECT_FALSE(fetch::logger.IsEnabled(Level::INFO));
+  EXPECT_FALSE(fetch::logger.IsEnabled(Level::DEBUG));
+  EXPECT_TRUE(fetch::logger.IsEnabled(Level::HIGHLIGHT));
+
+  fetch::logger.SetLevel(Level::DEBUG);
+  EXPECT_TRUE(fetch::logger.IsEnabled(Level::INFO));
+  EXPECT_TRUE(fetch::logger.IsEnabled(Level::DEBUG));
+}
+
+TEST(AsyncLogWriterTests, CheckLoggerCanBeDisabledWhileLogging)
+{
+  using fetch::log::details::LogWrapper;
+
+  static constexpr std::size_t NUM_THREADS = 8;
+
+  std::remove(OUTPUT_FILE);
+
+  {
+    LogWrapper wrapper;
+    ASSERT_TRUE(wrapper.SetOutputFile(OUTPUT_FILE));
+
+    std::atomic<bool>        running{true};
+    std::atomic<std::size_t> num_calls{0};
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < NUM_THREADS; ++i)
+    {
+      threads.emplace_back([&wrapper, &running, &num_calls, i]() {
+        while (running)
+        {
+          wrapper.InfoWithName("Test", "thread ", i);
+          wrapper.Highlight("highlighted");
+          ++num_calls;
+        }
+      });
+    }
+
+    // disable the logger while all of the threads are logging
+    while (num_calls < 1000)
+    {
+      std::this_thread::yield();
+    }
+
+    wrapper.DisableLogger();
+    EXPECT_FALSE(wrapper.IsEnabled(LogWrapper::Level::HIGHLIGHT));
+
+    // nothing further is written once the logger has been disabled
+    std::size_t const num_lines = ReadLines(OUTPUT_FILE).size();
+    EXPECT_GT(num_lines, 0u);
+
+    std::size_t const calls_at_disable = num_calls;
+    while (num_calls < (calls_at_disable + 1000))
+    {
+      std::this_thread::yield();
+    }
+
+    running = false;
+    for (auto &thread : threads)
+    {
+      thread.join();
+    }
+
+    wrapper.Flush();
+    EXPECT_EQ(ReadLines(OUTPUT_FILE).size(), num_lines);
+  }
+
+  std::remove(OUTPUT_FILE);
+}
+
+}  // namespace
@@ -0,0 +1,186 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/memory/arena.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+using fetch::core::Arena;
+using fetch::core::ArenaAllocator;
+using fetch::core::ArenaScope;
+
+bool IsAligned(void const *ptr, std::size_t alignment)
+{
+  return (reinterpret_cast<std::uintptr_t>(ptr) & (alignment - 1u)) == 0;
+}
+
+TEST(ArenaTests, allocations_are_aligned_and_do_not_overlap)
+{
+  Arena arena{256};
+
+  std::vector<uint8_t *> allocations;
+  for (std::size_t alignment : {1u, 2u, 8u, 16u, 64u, 1u, 16u})
+  {
+    auto *ptr = static_cast<uint8_t *>(arena.Allocate(24, alignment));
+    EXPECT_TRUE(IsAligned(ptr, alignment));
+
+    for (auto *other : allocations)
+    {
+      EXPECT_TRUE((ptr + 24 <= other) || (other + 24 <= ptr));
+    }
+
+    allocations.push_back(ptr);
+  }
+
+  EXPECT_EQ(allocations.size(), arena.num_allocations());
+  EXPECT_EQ(allocations.size(), arena.num_live_allocations());
+}
+
+TEST(ArenaTests, reset_recycles_the_memory)
+{
+  Arena arena{1024};
+
+  auto const allocate_all = [&arena]() {
+    std::vector<void *> allocations;
+    for (std::size_t i = 0; i < 100; ++i)
+    {
+      allocations.push_back(arena.Allocate(100));
+    }
+
+    for (auto *ptr : allocations)
+    {
+      arena.Deallocate(ptr);
+    }
+
+    return allocations;
+  };
+
+  auto const first = allocate_all();
+  std::size_t const num_blocks = arena.num_blocks();
+  EXPECT_GT(num_blocks, 1u);
+
+  ASSERT_TRUE(arena.Reset());
+  EXPECT_EQ(0u, arena.num_allocations());
+
+  // the same memory is handed out again without any further blocks being allocated
+  auto const second = allocate_all();
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(num_blocks, arena.num_blocks());
+}
+
+TEST(ArenaTests, reset_is_refused_while_allocations_are_live)
+{
+  Arena arena;
+
+  void *ptr = arena.Allocate(32);
+  EXPECT_FALSE(arena.Reset());
+  EXPECT_EQ(1u, arena.num_allocations());
+
+  arena.Deallocate(ptr);
+  EXPECT_TRUE(arena.Reset());
+}
+
+TEST(ArenaTests, oversized_allocations_are_given_their_own_block)
+{
+  Arena arena{128};
+
+  void *small = arena.Allocate(64);
+  auto *large = static_cast<uint8_t *>(arena.Allocate(1000));
+  EXPECT_NE(small, large);
+  EXPECT_GE(arena.capacity(), 1128u);
+
+  // the whole allocation must be usable
+  for (std::size_t i = 0; i < 1000; ++i)
+  {
+    large[i] = static_cast<uint8_t>(i);
+  }
+
+  arena.Deallocate(small);
+  arena.Deallocate(large);
+  ASSERT_TRUE(arena.Reset());
+
+  // after a reset the retained small block is too small for the large allocation
+  void *small_again = arena.Allocate(64);
+  void *large_again = arena.Allocate(1000);
+  EXPECT_EQ(small, small_again);
+  EXPECT_NE(small_again, large_again);
+}
+
+TEST(ArenaTests, allocator_can_be_used_with_containers)
+{
+  using Allocator = ArenaAllocator<std::pair<int const, std::string>>;
+  using Map       = std::unordered_map<int, std::string, std::hash<int>, std::equal_to<int>,
+                                 Allocator>;
+
+  Arena arena;
+  {
+    Map map{0, std::hash<int>{}, std::equal_to<int>{}, Allocator{&arena}};
+    for (int i = 0; i < 100; ++i)
+    {
+      map.emplace(i, std::to_string(i));
+    }
+
+    EXPECT_EQ("42", map.at(42));
+    EXPECT_GT(arena.num_live_allocations(), 100u);
+  }
+
+  EXPECT_EQ(0u, arena.num_live_allocations());
+  EXPECT_TRUE(arena.Reset());
+
+  // default constructed allocators use the heap
+  std::vector<int, ArenaAllocator<int>> vec(10, 1);
+  EXPECT_EQ(nullptr, vec.get_allocator().arena());
+  EXPECT_EQ(0u, arena.num_allocations());
+}
+
+TEST(ArenaTests, tagged_allocations_follow_the_thread_arena)
+{
+  Arena arena;
+
+  void *heap = Arena::AllocateTagged(48);
+  EXPECT_EQ(0u, arena.num_allocations());
+
+  void *pooled = nullptr;
+  {
+    ArenaScope scope{arena};
+    EXPECT_EQ(&arena, Arena::Current());
+
+    pooled = Arena::AllocateTagged(48);
+    EXPECT_TRUE(IsAligned(pooled, alignof(std::max_align_t)));
+    EXPECT_EQ(1u, arena.num_live_allocations());
+
+    // memory from the heap can be released while the scope is active
+    Arena::DeallocateTagged(heap);
+    EXPECT_EQ(1u, arena.num_live_allocations());
+  }
+
+  EXPECT_EQ(nullptr, Arena::Current());
+
+  // memory from the arena can be released after the scope has finished
+  Arena::DeallocateTagged(pooled);
+  EXPECT_EQ(0u, arena.num_live_allocations());
+}
+
+}  // namespace
@@ -0,0 +1,250 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/reactor.hpp"
+#include "core/runnable.hpp"
+#include "core/state_machine.hpp"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace std::chrono_literals;
+
+using fetch::core::Reactor;
+using fetch::core::Runnable;
+using fetch::core::StateMachine;
+
+enum class State
+{
+  RUNNING,
+};
+
+using StateMachinePtr = std::shared_ptr<StateMachine<State>>;
+
+/**
+ * Runnable which records if it is ever executed concurrently
+ */
+class ExclusiveRunnable : public Runnable
+{
+public:
+  void Trigger()
+  {
+    pending_ = true;
+    Notify();
+  }
+
+  void Execute() override
+  {
+    pending_ = false;
+
+    if (executing_.exchange(true))
+    {
+      overlapped_ = true;
+    }
+
+    std::this_thread::sleep_for(100us);
+    ++count_;
+
+    executing_ = false;
+
+    // keep the runnable busy
+    Trigger();
+  }
+
+  bool IsReadyToExecute() const override
+  {
+    return pending_;
+  }
+
+  std::atomic<bool>        pending_{true};
+  std::atomic<bool>        executing_{false};
+  std::atomic<bool>        overlapped_{false};
+  std::atomic<std::size_t> count_{0};
+};
+
+template <typename Predicate>
+bool WaitFor(Predicate &&predicate, std::chrono::milliseconds timeout = 5000ms)
+{
+  auto const deadline = std::chrono::steady_clock::now() + timeout;
+  while (!predicate())
+  {
+    if (std::chrono::steady_clock::now() >= deadline)
+    {
+      return false;
+    }
+
+    std::this_thread::sleep_for(1ms);
+  }
+
+  return true;
+}
+
+class ReactorTests : public ::testing::Test
+{
+protected:
+  /**
+   * Create a state machine which delays for the specified period after each execution
+   */
+  template <typename R, typename P>
+  StateMachinePtr CreateStateMachine(std::chrono::duration<R, P> const &delay)
+  {
+    auto machine = std::make_shared<StateMachine<State>>("Test", State::RUNNING);
+
+    auto *raw = machine.get();
+    handlers_.emplace_back(std::make_unique<Handler>(raw, delay));
+    machine->RegisterHandler(State::RUNNING, handlers_.back().get(), &Handler::OnRunning);
+
+    return machine;
+  }
+
+  struct Handler
+  {
+    template <typename R, typename P>
+    Handler(StateMachine<State> *machine, std::chrono::duration<R, P> const &delay)
+      : machine_{machine}
+      , delay_{std::chrono::duration_cast<std::chrono::milliseconds>(delay)}
+    {}
+
+    State OnRunning()
+    {
+      ++count_;
+      machine_->Delay(delay_);
+      return State::RUNNING;
+    }
+
+    StateMachine<State> *           machine_;
+    std::chrono::milliseconds const delay_;
+    std::atomic<std::size_t>        count_{0};
+  };
+
+  std::vector<std::unique_ptr<Handler>> handlers_;
+};
+
+TEST_F(ReactorTests, DelayedStateMachinesAreNotPolled)
+{
+  Reactor reactor{"Test"};
+
+  auto machine = CreateStateMachine(20ms);
+  ASSERT_TRUE(reactor.Attach(machine));
+  EXPECT_FALSE(reactor.Attach(machine));
+
+  reactor.Start();
+  std::this_thread::sleep_for(200ms);
+  reactor.Stop();
+
+  // roughly every 20ms, without any early (spurious) executions
+  std::size_t const count = handlers_.back()->count_;
+  EXPECT_GE(count, 2u);
+  EXPECT_LE(count, 11u);
+}
+
+TEST_F(ReactorTests, WakeCancelsTheDelay)
+{
+  Reactor reactor{"Test"};
+
+  auto  machine = CreateStateMachine(1h);
+  auto &handler = *handlers_.back();
+  reactor.Attach(machine);
+  reactor.Start();
+
+  ASSERT_TRUE(WaitFor([&handler]() { return handler.count_ == 1; }));
+
+  for (std::size_t i = 2; i <= 5; ++i)
+  {
+    machine->Wake();
+    ASSERT_TRUE(WaitFor([&handler, i]() { return handler.count_ == i; }));
+  }
+
+  reactor.Stop();
+}
+
+TEST_F(ReactorTests, RunnablesAreOnlyExecutedOnOneThreadAtATime)
+{
+  static constexpr std::size_t NUM_RUNNABLES = 8;
+
+  Reactor reactor{"Test", 4};
+
+  std::vector<std::shared_ptr<ExclusiveRunnable>> runnables;
+  for (std::size_t i = 0; i < NUM_RUNNABLES; ++i)
+  {
+    runnables.emplace_back(std::make_shared<ExclusiveRunnable>());
+    reactor.Attach(runnables.back());
+  }
+
+  reactor.Start();
+
+  // while running, notify all the runnables from a different thread too
+  for (std::size_t i = 0; i < 200; ++i)
+  {
+    for (auto const &runnable : runnables)
+    {
+      runnable->Trigger();
+    }
+
+    std::this_thread::sleep_for(100us);
+  }
+
+  reactor.Stop();
+
+  for (auto const &runnable : runnables)
+  {
+    EXPECT_FALSE(runnable->overlapped_);
+    EXPECT_GT(runnable->count_, 0u);
+  }
+}
+
+TEST_F(ReactorTests, DetachedAndExpiredRunnablesAreNotExecuted)
+{
+  Reactor reactor{"Test", 2};
+
+  auto  detached         = CreateStateMachine(1ms);
+  auto &detached_handler = *handlers_.back();
+  auto  expired          = CreateStateMachine(1ms);
+
+  reactor.Attach(detached);
+  reactor.Attach(expired);
+  reactor.Start();
+
+  ASSERT_TRUE(WaitFor([&detached_handler]() { return detached_handler.count_ > 2; }));
+
+  EXPECT_TRUE(reactor.Detach(*detached));
+  EXPECT_FALSE(reactor.Detach(*detached));
+  expired.reset();
+
+  // allow any in flight execution to complete
+  std::this_thread::sleep_for(20ms);
+  std::size_t const count = detached_handler.count_;
+  std::this_thread::sleep_for(50ms);
+  EXPECT_EQ(count, detached_handler.count_);
+
+  // notifications after detaching are ignored
+  detached->Wake();
+  std::this_thread::sleep_for(20ms);
+  EXPECT_EQ(count, detached_handler.count_);
+
+  reactor.Stop();
+}
+
+}  // namespace
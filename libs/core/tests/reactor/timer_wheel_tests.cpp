@@ -0,0 +1,135 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/random/lcg.hpp"
+#include "core/timer_wheel.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using fetch::core::TimerWheel;
+
+using Wheel = TimerWheel<uint64_t>;
+using Tick  = Wheel::Tick;
+using RNG   = fetch::random::LinearCongruentialGenerator;
+
+TEST(TimerWheelTests, PastDeadlinesExpireOnNextAdvance)
+{
+  Wheel wheel{100};
+
+  wheel.Schedule(50, 1);
+  wheel.Schedule(100, 2);
+  EXPECT_EQ(wheel.size(), 2u);
+
+  Tick next{0};
+  ASSERT_TRUE(wheel.GetNextExpiry(next));
+  EXPECT_EQ(next, 100u);
+
+  Wheel::ItemList expired;
+  EXPECT_EQ(wheel.Advance(100, expired), 2u);
+  EXPECT_EQ(expired, (Wheel::ItemList{1, 2}));
+  EXPECT_TRUE(wheel.empty());
+  EXPECT_FALSE(wheel.GetNextExpiry(next));
+}
+
+TEST(TimerWheelTests, ItemsExpireOnTimeOnAllLevels)
+{
+  static constexpr std::size_t NUM_ITEMS = 2000;
+
+  RNG   rng;
+  Wheel wheel{};
+
+  // spread the deadlines over all the levels of the wheel (including the overflow)
+  std::vector<Tick> deadlines(NUM_ITEMS);
+  for (std::size_t i = 0; i < NUM_ITEMS; ++i)
+  {
+    Tick const range = Tick{1} << (rng() % 26u);
+    deadlines[i]     = 1 + (rng() % range);
+
+    wheel.Schedule(deadlines[i], i);
+  }
+
+  std::vector<bool> expired_flags(NUM_ITEMS, false);
+
+  Tick            now{0};
+  Wheel::ItemList expired;
+  while (!wheel.empty())
+  {
+    Tick const previous = now;
+
+    // the wheel never needs to be advanced until the next expiry
+    Tick next{0};
+    ASSERT_TRUE(wheel.GetNextExpiry(next));
+    ASSERT_GT(next, now);
+
+    now = next + (rng() % 100u);
+
+    expired.clear();
+    wheel.Advance(now, expired);
+
+    for (auto const index : expired)
+    {
+      ASSERT_FALSE(expired_flags[index]);
+      expired_flags[index] = true;
+
+      // items must not expire early or be delayed beyond the advance in which they are due
+      EXPECT_LE(deadlines[index], now);
+      EXPECT_GT(deadlines[index], previous);
+    }
+  }
+
+  for (std::size_t i = 0; i < NUM_ITEMS; ++i)
+  {
+    EXPECT_TRUE(expired_flags[i]) << "item: " << i;
+  }
+}
+
+TEST(TimerWheelTests, NextExpiryIsALowerBound)
+{
+  RNG rng;
+
+  for (std::size_t round = 0; round < 200; ++round)
+  {
+    Tick const start = rng() % 100000u;
+    Wheel      wheel{start};
+
+    Tick earliest{0};
+    for (std::size_t i = 0; i < 5; ++i)
+    {
+      Tick const deadline = start + 1 + (rng() % 500000u);
+      earliest            = (i == 0) ? deadline : std::min(earliest, deadline);
+
+      wheel.Schedule(deadline, i);
+    }
+
+    Tick next{0};
+    ASSERT_TRUE(wheel.GetNextExpiry(next));
+    EXPECT_LE(next, earliest);
+
+    // nothing expires before the earliest deadline
+    Wheel::ItemList expired;
+    EXPECT_EQ(wheel.Advance(earliest - 1, expired), 0u);
+    EXPECT_GE(wheel.Advance(earliest, expired), 1u);
+  }
+}
+
+}  // namespace
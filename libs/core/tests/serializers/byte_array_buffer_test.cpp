@@ -285,6 +285,29 @@ TEST_F(ByteArrayBufferTest, test_stream_absolute_resize_with_preexisting_offset)
   EXPECT_EQ(small_size, stream.tell());
 }
 
+TEST_F(ByteArrayBufferTest, test_deserialisation_from_const_byte_array_does_not_copy)
+{
+  byte_array::ConstByteArray const payload{"payload"};
+
+  //* Setup
+  ByteArrayBuffer source;
+  source << uint64_t{42} << payload;
+
+  // emulate data which has been received as a part of a larger message
+  byte_array::ConstByteArray const received = source.data().SubArray(sizeof(uint64_t));
+
+  //* Production code under test
+  ByteArrayBuffer            stream{received};
+  byte_array::ConstByteArray extracted;
+  stream >> extracted;
+
+  //* Expectations
+  byte_array::ConstByteArray const &view = extracted;
+  EXPECT_EQ(payload, view);
+  EXPECT_EQ(received.pointer() + sizeof(uint64_t), view.pointer());
+  EXPECT_EQ(0, stream.bytes_left());
+}
+
 }  // namespace
 
 }  // namespace serializers
@@ -0,0 +1,164 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/random/lcg.hpp"
+#include "crypto/merkle_tree.hpp"
+#include "crypto/sha256.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+using fetch::byte_array::ByteArray;
+using fetch::byte_array::ConstByteArray;
+using fetch::crypto::MerkleTree;
+using fetch::random::LinearCongruentialGenerator;
+
+namespace {
+
+// note: the unqualified name would collide with the OpenSSL function of the same name
+using Hasher   = fetch::crypto::SHA256;
+using RNG      = LinearCongruentialGenerator;
+using ItemList = std::vector<Hasher::BatchItem>;
+using Buffer   = std::vector<uint8_t>;
+
+/// The size of a trie node message (the hashes of both children)
+constexpr std::size_t MESSAGE_SIZE = 64;
+
+RNG rng;
+
+ConstByteArray GenerateRandomDigest()
+{
+  ByteArray buffer;
+  buffer.Resize(Hasher::size_in_bytes());
+
+  auto *words = reinterpret_cast<RNG::random_type *>(buffer.pointer());
+  for (std::size_t i = 0; i < Hasher::size_in_bytes() / sizeof(RNG::random_type); ++i)
+  {
+    words[i] = rng();
+  }
+
+  return ConstByteArray{buffer};
+}
+
+/**
+ * Build a batch of random trie node sized messages
+ */
+ItemList GenerateBatch(std::size_t count, Buffer &messages, Buffer &digests)
+{
+  messages.resize(count * MESSAGE_SIZE);
+  digests.resize(count * Hasher::size_in_bytes());
+
+  for (auto &byte : messages)
+  {
+    byte = static_cast<uint8_t>(rng());
+  }
+
+  ItemList items(count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    items[i].data   = messages.data() + (i * MESSAGE_SIZE);
+    items[i].size   = MESSAGE_SIZE;
+    items[i].digest = digests.data() + (i * Hasher::size_in_bytes());
+  }
+
+  return items;
+}
+
+void HashSequential(benchmark::State &state)
+{
+  Buffer     messages;
+  Buffer     digests;
+  auto const items = GenerateBatch(static_cast<std::size_t>(state.range(0)), messages, digests);
+
+  Hasher hasher;
+  for (auto _ : state)
+  {
+    for (auto const &item : items)
+    {
+      hasher.Reset();
+      hasher.Update(item.data, item.size);
+      hasher.Final(item.digest, Hasher::size_in_bytes());
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void HashBatch(benchmark::State &state)
+{
+  Buffer     messages;
+  Buffer     digests;
+  auto const items = GenerateBatch(static_cast<std::size_t>(state.range(0)), messages, digests);
+
+  for (auto _ : state)
+  {
+    Hasher::HashBatch(items.data(), items.size());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.counters["lanes"] = static_cast<double>(Hasher::batch_lanes());
+}
+
+/**
+ * Hash a batch with a specific kernel (irrespective of the kernel selected by HashBatch)
+ */
+template <void (*Kernel)(Hasher::BatchItem const *, std::size_t)>
+void HashBatchKernel(benchmark::State &state)
+{
+  Buffer     messages;
+  Buffer     digests;
+  auto const items = GenerateBatch(static_cast<std::size_t>(state.range(0)), messages, digests);
+
+  for (auto _ : state)
+  {
+    Kernel(items.data(), items.size());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void MerkleRoot(benchmark::State &state)
+{
+  MerkleTree tree{static_cast<std::size_t>(state.range(0))};
+  for (auto &leaf : tree)
+  {
+    leaf = GenerateRandomDigest();
+  }
+
+  for (auto _ : state)
+  {
+    tree.CalculateRoot();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}  // namespace
+
+BENCHMARK(HashSequential)->RangeMultiplier(8)->Range(8, 4096);
+BENCHMARK(HashBatch)->RangeMultiplier(8)->Range(8, 4096);
+BENCHMARK_TEMPLATE(HashBatchKernel, fetch::crypto::detail::SHA256HashBatchSSE2)
+    ->RangeMultiplier(8)
+    ->Range(8, 4096);
+BENCHMARK_TEMPLATE(HashBatchKernel, fetch::crypto::detail::SHA256HashBatchAVX2)
+    ->RangeMultiplier(8)
+    ->Range(8, 4096);
+BENCHMARK(MerkleRoot)->RangeMultiplier(8)->Range(8, 4096);
@@ -0,0 +1,134 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace fetch {
+namespace crypto {
+
+/**
+ * Merkle tree with a fixed number of leaves which caches all of its interior nodes
+ *
+ * The root is identical to that of a MerkleTree with the same leaves, however when leaves are
+ * updated only the nodes on the paths from the changed leaves to the root are recalculated (the
+ * first time the root is requested).
+ *
+ * In addition, the leaves of the tree can be recorded against an (increasing) index, for example a
+ * block number, so that the tree can cheaply be reverted to a previous state. Inclusion proofs can
+ * be generated for any one of the leaves.
+ */
+class IncrementalMerkleTree
+{
+public:
+  using Digest     = byte_array::ConstByteArray;
+  using DigestList = std::vector<Digest>;
+  using Proof      = std::vector<Digest>;
+
+  static constexpr std::size_t DEFAULT_MAX_SNAPSHOTS = 256;
+
+  // Construction / Destruction
+  explicit IncrementalMerkleTree(std::size_t count,
+                                 std::size_t max_snapshots = DEFAULT_MAX_SNAPSHOTS);
+  IncrementalMerkleTree(IncrementalMerkleTree const &) = default;
+  IncrementalMerkleTree(IncrementalMerkleTree &&)      = default;
+  ~IncrementalMerkleTree()                             = default;
+
+  /// @name Leaf Access
+  /// @{
+  std::size_t       size() const;
+  DigestList const &leaf_nodes() const;
+  Digest const &    leaf(std::size_t index) const;
+  bool              Update(std::size_t index, Digest const &digest);
+  std::size_t       Update(DigestList const &leaves);
+  /// @}
+
+  Digest const &root() const;
+
+  /// @name Snapshots
+  /// @{
+  void        Snapshot(uint64_t index);
+  bool        HasSnapshot(uint64_t index) const;
+  bool        RevertToSnapshot(uint64_t index);
+  void        ClearSnapshots();
+  std::size_t num_snapshots() const;
+  /// @}
+
+  /// @name Inclusion Proofs
+  /// @{
+  Proof       GenerateProof(std::size_t index) const;
+  static bool VerifyProof(Digest const &leaf, std::size_t index, std::size_t count,
+                          Proof const &proof, Digest const &root);
+  /// @}
+
+  // Operators
+  IncrementalMerkleTree &operator=(IncrementalMerkleTree const &) = default;
+  IncrementalMerkleTree &operator=(IncrementalMerkleTree &&) = default;
+
+private:
+  using IndexList   = std::vector<std::size_t>;
+  using SnapshotMap = std::map<uint64_t, DigestList>;
+
+  Digest const &Node(std::size_t node) const;
+  void          UpdateDirtyNodes() const;
+
+  std::size_t        max_snapshots_;  ///< The maximum number of snapshots to retain
+  std::size_t        width_{0};       ///< The number of leaves once padded to a power of 2
+  DigestList         leaf_nodes_;     ///< The leaves of the tree
+  mutable DigestList nodes_;          ///< The interior nodes of the tree (1 is the root)
+  mutable IndexList  dirty_;          ///< The nodes whose parents must be recalculated
+  mutable Digest     root_;           ///< The cached root of the tree
+  SnapshotMap        snapshots_;      ///< The recorded leaves of the tree
+};
+
+inline std::size_t IncrementalMerkleTree::size() const
+{
+  return leaf_nodes_.size();
+}
+
+inline IncrementalMerkleTree::DigestList const &IncrementalMerkleTree::leaf_nodes() const
+{
+  return leaf_nodes_;
+}
+
+inline IncrementalMerkleTree::Digest const &IncrementalMerkleTree::leaf(std::size_t index) const
+{
+  return leaf_nodes_.at(index);
+}
+
+inline std::size_t IncrementalMerkleTree::num_snapshots() const
+{
+  return snapshots_.size();
+}
+
+/**
+ * Serialise the tree in the same format as the MerkleTree (i.e. the leaves followed by the root)
+ */
+template <typename T>
+void Serialize(T &serializer, IncrementalMerkleTree const &tree)
+{
+  serializer << tree.leaf_nodes() << tree.root();
+}
+
+}  // namespace crypto
+}  // namespace fetch
@@ -0,0 +1,127 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "crypto/identity.hpp"
+#include "crypto/openssl_ecdsa_public_key.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace fetch {
+namespace crypto {
+
+/**
+ * Bounded, thread safe cache of parsed public keys
+ *
+ * Parsing a public key from its binary representation is a significant part of the cost of a
+ * signature verification. Since the majority of the transactions on the network are signed by a
+ * comparatively small set of identities, the parsed keys are kept in a set of LRU ordered shards
+ * (each protected by its own lock) to avoid this cost on subsequent verifications.
+ *
+ * A cache constructed with a capacity of zero will never store any entries, i.e. every lookup
+ * parses the key from scratch.
+ */
+class PublicKeyCache
+{
+public:
+  using ConstByteArray = byte_array::ConstByteArray;
+  using PublicKey      = openssl::ECDSAPublicKey<>;
+  using PublicKeyPtr   = std::shared_ptr<PublicKey const>;
+
+  static constexpr std::size_t DEFAULT_CAPACITY = 4096;
+
+  // Construction / Destruction
+  explicit PublicKeyCache(std::size_t capacity = DEFAULT_CAPACITY);
+  PublicKeyCache(PublicKeyCache const &) = delete;
+  PublicKeyCache(PublicKeyCache &&)      = delete;
+  ~PublicKeyCache()                      = default;
+
+  /// @name Key Access
+  /// @{
+  PublicKeyPtr Lookup(Identity const &identity);
+  bool         Verify(Identity const &identity, ConstByteArray const &data,
+                      ConstByteArray const &signature);
+  void         Clear();
+  /// @}
+
+  /// @name Statistics
+  /// @{
+  std::size_t capacity() const;
+  std::size_t size() const;
+  std::size_t hit_count() const;
+  std::size_t miss_count() const;
+  /// @}
+
+  // Operators
+  PublicKeyCache &operator=(PublicKeyCache const &) = delete;
+  PublicKeyCache &operator=(PublicKeyCache &&) = delete;
+
+private:
+  static constexpr std::size_t NUM_SHARDS = 16;
+
+  struct Entry
+  {
+    Identity     identity;
+    PublicKeyPtr key;
+  };
+
+  using EntryList = std::list<Entry>;
+  using EntryMap  = std::unordered_map<Identity, EntryList::iterator>;
+  using Counter   = std::atomic<std::size_t>;
+
+  struct Shard
+  {
+    mutable std::mutex lock;
+    EntryList          entries;  ///< The cached entries, most recently used first
+    EntryMap           index;    ///< The index from identity to entry
+  };
+
+  using Shards = std::array<Shard, NUM_SHARDS>;
+
+  Shard &LookupShard(Identity const &identity);
+
+  std::size_t const shard_capacity_;
+  Shards            shards_;
+  Counter           hit_count_{0};
+  Counter           miss_count_{0};
+};
+
+inline std::size_t PublicKeyCache::capacity() const
+{
+  return shard_capacity_ * NUM_SHARDS;
+}
+
+inline std::size_t PublicKeyCache::hit_count() const
+{
+  return hit_count_;
+}
+
+inline std::size_t PublicKeyCache::miss_count() const
+{
+  return miss_count_;
+}
+
+}  // namespace crypto
+}  // namespace fetch
@@ -18,12 +18,23 @@
 //------------------------------------------------------------------------------
 
 #include "core/byte_array/byte_array.hpp"
+#include "crypto/sha256_batch_detail.hpp"
 #include "crypto/stream_hasher.hpp"
+
 #include <openssl/sha.h>
 
+#include <vector>
+
 namespace fetch {
 namespace crypto {
 
+/**
+ * SHA-256 stream hasher
+ *
+ * In addition to the streaming interface, a batch of independent messages can be hashed with
+ * HashBatch. Unless the CPU provides the (faster) hardware SHA extensions, the messages of the
+ * batch are hashed in parallel, one per lane of the vector registers (SSE2: 4 lanes, AVX2: 8).
+ */
 class SHA256 : public StreamHasher
 {
 public:
@@ -47,6 +58,17 @@ public:
   std::size_t GetSizeInBytes() const override;
   /// @}
 
+  /// @name Batch Hashing
+  /// @{
+  using BatchItem   = detail::SHA256BatchItem;
+  using DigestList  = std::vector<byte_array::ByteArray>;
+  using MessageList = std::vector<byte_array::ConstByteArray>;
+
+  static void        HashBatch(BatchItem const *items, std::size_t count);
+  static DigestList  HashBatch(MessageList const &messages);
+  static std::size_t batch_lanes();
+  /// @}
+
 private:
   SHA256_CTX context_;
 };
@@ -0,0 +1,316 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace fetch {
+namespace crypto {
+namespace detail {
+
+/**
+ * A single message of a batch to be hashed
+ */
+struct SHA256BatchItem
+{
+  uint8_t const *data{nullptr};    ///< The message to be hashed
+  std::size_t    size{0};          ///< The size of the message in bytes
+  uint8_t *      digest{nullptr};  ///< The output buffer for the (32 byte) digest
+};
+
+/**
+ * Multi-buffer SHA-256
+ *
+ * Hashes up to LANES independent messages at the same time, with each of the messages occupying
+ * one of the lanes of the vector registers. The vector operations are provided by the Ops type:
+ *
+ *   Vector              The vector type (LANES x 32 bit words)
+ *   LANES               The number of lanes of the vector type
+ *   Broadcast(w)        Set all the lanes to w
+ *   Load(words)         Load LANES words (one per lane)
+ *   Store(words, v)     Store the LANES words of v
+ *   Add, Xor, And, Or   Lane-wise operations
+ *   AndNot(a, b)        Lane-wise (~a & b)
+ *   ShiftRight<N>(v)    Lane-wise logical shift right
+ *   RotateRight<N>(v)   Lane-wise rotate right
+ *
+ * In order that the kernels for the different instruction sets can be compiled with different
+ * target options the Ops types are expected to have internal linkage, so that every instantiation
+ * of this template is private to the translation unit that defines its Ops.
+ *
+ * @tparam Ops The vector operations
+ */
+template <typename Ops>
+struct SHA256MultiBuffer
+{
+  using Vector = typename Ops::Vector;
+
+  static constexpr std::size_t LANES       = Ops::LANES;
+  static constexpr std::size_t BLOCK_SIZE  = 64;
+  static constexpr std::size_t LENGTH_SIZE = 8;
+  static constexpr std::size_t STATE_WORDS = 8;
+  static constexpr std::size_t BLOCK_WORDS = 16;
+  static constexpr std::size_t ROUNDS      = 64;
+
+  static constexpr uint32_t INITIAL_STATE[STATE_WORDS] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372,
+                                                          0xa54ff53a, 0x510e527f, 0x9b05688c,
+                                                          0x1f83d9ab, 0x5be0cd19};
+
+  static constexpr uint32_t ROUND_CONSTANTS[ROUNDS] = {
+      0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4,
+      0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe,
+      0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f,
+      0x4a7484aa, 0x5cb0a9dc, 0x76f988da, 0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+      0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc,
+      0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+      0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070, 0x19a4c116,
+      0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+      0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7,
+      0xc67178f2};
+
+  /**
+   * Determine the number of blocks of a message once it has been padded
+   *
+   * @param size The size of the message in bytes
+   * @return The number of 64 byte blocks
+   */
+  static std::size_t BlockCount(std::size_t size)
+  {
+    return (size + 1 + LENGTH_SIZE + BLOCK_SIZE - 1) / BLOCK_SIZE;
+  }
+
+  /**
+   * Extract the specified block of the padded form of a message
+   *
+   * @param item The message
+   * @param index The index of the block
+   * @param block The output block
+   */
+  static void LoadBlock(SHA256BatchItem const &item, std::size_t index, uint8_t *block)
+  {
+    std::size_t const offset = index * BLOCK_SIZE;
+
+    // copy the part of the message which is contained in this block (if any)
+    std::size_t copied{0};
+    if (offset < item.size)
+    {
+      copied = item.size - offset;
+      copied = (copied < BLOCK_SIZE) ? copied : BLOCK_SIZE;
+
+      std::memcpy(block, item.data + offset, copied);
+    }
+
+    if (copied == BLOCK_SIZE)
+    {
+      return;
+    }
+
+    std::memset(block + copied, 0, BLOCK_SIZE - copied);
+
+    // the terminating bit directly follows the message
+    if (offset + copied == item.size)
+    {
+      block[copied] = 0x80;
+    }
+
+    // the message length (in bits, big endian) ends the last block
+    if (index + 1 == BlockCount(item.size))
+    {
+      uint64_t const length = static_cast<uint64_t>(item.size) << 3u;
+      for (std::size_t i = 0; i < LENGTH_SIZE; ++i)
+      {
+        block[BLOCK_SIZE - 1 - i] = static_cast<uint8_t>(length >> (i * 8u));
+      }
+    }
+  }
+
+  static uint32_t ReadBigEndian(uint8_t const *bytes)
+  {
+    return (static_cast<uint32_t>(bytes[0]) << 24u) | (static_cast<uint32_t>(bytes[1]) << 16u) |
+           (static_cast<uint32_t>(bytes[2]) << 8u) | static_cast<uint32_t>(bytes[3]);
+  }
+
+  static void WriteBigEndian(uint32_t word, uint8_t *bytes)
+  {
+    bytes[0] = static_cast<uint8_t>(word >> 24u);
+    bytes[1] = static_cast<uint8_t>(word >> 16u);
+    bytes[2] = static_cast<uint8_t>(word >> 8u);
+    bytes[3] = static_cast<uint8_t>(word);
+  }
+
+  /**
+   * Hash the specified messages, one per lane
+   *
+   * The messages do not need to be of the same length, however a lane which runs out of blocks is
+   * idle until the longest message of the group has been hashed.
+   *
+   * @param items The messages to be hashed
+   * @param count The number of messages (at most LANES)
+   */
+  static void Hash(SHA256BatchItem const *items, std::size_t count)
+  {
+    std::size_t num_blocks[LANES] = {};
+    std::size_t max_blocks{0};
+    for (std::size_t lane = 0; lane < count; ++lane)
+    {
+      num_blocks[lane] = BlockCount(items[lane].size);
+      max_blocks       = (num_blocks[lane] > max_blocks) ? num_blocks[lane] : max_blocks;
+    }
+
+    Vector state[STATE_WORDS];
+    for (std::size_t i = 0; i < STATE_WORDS; ++i)
+    {
+      state[i] = Ops::Broadcast(INITIAL_STATE[i]);
+    }
+
+    uint8_t  blocks[LANES][BLOCK_SIZE];
+    uint32_t words[LANES];
+    Vector   schedule[ROUNDS];
+
+    for (std::size_t index = 0; index < max_blocks; ++index)
+    {
+      for (std::size_t lane = 0; lane < LANES; ++lane)
+      {
+        if (index < num_blocks[lane])
+        {
+          LoadBlock(items[lane], index, blocks[lane]);
+        }
+        else
+        {
+          std::memset(blocks[lane], 0, BLOCK_SIZE);
+        }
+      }
+
+      // transpose the blocks so that each message word holds one word of each lane
+      for (std::size_t t = 0; t < BLOCK_WORDS; ++t)
+      {
+        for (std::size_t lane = 0; lane < LANES; ++lane)
+        {
+          words[lane] = ReadBigEndian(blocks[lane] + (t * 4u));
+        }
+
+        schedule[t] = Ops::Load(words);
+      }
+
+      Compress(state, schedule);
+
+      // extract the digests of the messages which have been completed
+      for (std::size_t lane = 0; lane < count; ++lane)
+      {
+        if (index + 1 == num_blocks[lane])
+        {
+          for (std::size_t i = 0; i < STATE_WORDS; ++i)
+          {
+            Ops::Store(words, state[i]);
+            WriteBigEndian(words[lane], items[lane].digest + (i * 4u));
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * Apply the compression function to the state of all the lanes
+   *
+   * @param state The hash state of the lanes
+   * @param w The message schedule, the first 16 words of which have been populated
+   */
+  static void Compress(Vector *state, Vector *w)
+  {
+    for (std::size_t t = BLOCK_WORDS; t < ROUNDS; ++t)
+    {
+      Vector const w15 = w[t - 15];
+      Vector const w2  = w[t - 2];
+
+      Vector const s0 = Ops::Xor(
+          Ops::Xor(Ops::template RotateRight<7>(w15), Ops::template RotateRight<18>(w15)),
+          Ops::template ShiftRight<3>(w15));
+      Vector const s1 = Ops::Xor(
+          Ops::Xor(Ops::template RotateRight<17>(w2), Ops::template RotateRight<19>(w2)),
+          Ops::template ShiftRight<10>(w2));
+
+      w[t] = Ops::Add(Ops::Add(w[t - 16], s0), Ops::Add(w[t - 7], s1));
+    }
+
+    Vector a = state[0];
+    Vector b = state[1];
+    Vector c = state[2];
+    Vector d = state[3];
+    Vector e = state[4];
+    Vector f = state[5];
+    Vector g = state[6];
+    Vector h = state[7];
+
+    for (std::size_t t = 0; t < ROUNDS; ++t)
+    {
+      Vector const sigma1 =
+          Ops::Xor(Ops::Xor(Ops::template RotateRight<6>(e), Ops::template RotateRight<11>(e)),
+                   Ops::template RotateRight<25>(e));
+      Vector const choice = Ops::Xor(Ops::And(e, f), Ops::AndNot(e, g));
+      Vector const temp1  = Ops::Add(Ops::Add(Ops::Add(h, sigma1), Ops::Add(choice, w[t])),
+                                    Ops::Broadcast(ROUND_CONSTANTS[t]));
+
+      Vector const sigma0 =
+          Ops::Xor(Ops::Xor(Ops::template RotateRight<2>(a), Ops::template RotateRight<13>(a)),
+                   Ops::template RotateRight<22>(a));
+      Vector const majority = Ops::Or(Ops::And(a, b), Ops::And(c, Ops::Or(a, b)));
+      Vector const temp2    = Ops::Add(sigma0, majority);
+
+      h = g;
+      g = f;
+      f = e;
+      e = Ops::Add(d, temp1);
+      d = c;
+      c = b;
+      b = a;
+      a = Ops::Add(temp1, temp2);
+    }
+
+    state[0] = Ops::Add(state[0], a);
+    state[1] = Ops::Add(state[1], b);
+    state[2] = Ops::Add(state[2], c);
+    state[3] = Ops::Add(state[3], d);
+    state[4] = Ops::Add(state[4], e);
+    state[5] = Ops::Add(state[5], f);
+    state[6] = Ops::Add(state[6], g);
+    state[7] = Ops::Add(state[7], h);
+  }
+};
+
+template <typename Ops>
+constexpr std::size_t SHA256MultiBuffer<Ops>::LANES;
+
+template <typename Ops>
+constexpr uint32_t SHA256MultiBuffer<Ops>::INITIAL_STATE[];
+
+template <typename Ops>
+constexpr uint32_t SHA256MultiBuffer<Ops>::ROUND_CONSTANTS[];
+
+/// @name Batch Kernels
+/// @{
+void SHA256HashBatchScalar(SHA256BatchItem const *items, std::size_t count);
+void SHA256HashBatchSSE2(SHA256BatchItem const *items, std::size_t count);
+void SHA256HashBatchAVX2(SHA256BatchItem const *items, std::size_t count);
+bool SHA256HasAVX2Kernel();
+/// @}
+
+}  // namespace detail
+}  // namespace crypto
+}  // namespace fetch
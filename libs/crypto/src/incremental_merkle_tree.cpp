@@ -0,0 +1,346 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "crypto/incremental_merkle_tree.hpp"
+#include "crypto/hash.hpp"
+#include "crypto/sha256.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace fetch {
+namespace crypto {
+namespace {
+
+using Digest     = IncrementalMerkleTree::Digest;
+using DigestList = IncrementalMerkleTree::DigestList;
+
+/**
+ * Determine the number of leaves of the (padded) tree
+ *
+ * @param count The number of leaves
+ * @return The smallest power of 2 which is not less than the count
+ */
+std::size_t CalculateWidth(std::size_t count)
+{
+  std::size_t width{1};
+  while (width < count)
+  {
+    width <<= 1u;
+  }
+
+  return width;
+}
+
+Digest HashChildren(Digest const &left, Digest const &right)
+{
+  SHA256 hasher{};
+  hasher.Reset();
+  hasher.Update(left);
+  hasher.Update(right);
+  return hasher.Final();
+}
+
+}  // namespace
+
+/**
+ * Construct a tree where all the leaves are empty
+ *
+ * @param count The number of leaves of the tree
+ * @param max_snapshots The maximum number of snapshots to be retained
+ */
+IncrementalMerkleTree::IncrementalMerkleTree(std::size_t count, std::size_t max_snapshots)
+  : max_snapshots_{max_snapshots}
+  , width_{CalculateWidth(count)}
+  , leaf_nodes_(count)
+  , nodes_(width_)
+{
+  // all the interior nodes need to be calculated
+  for (std::size_t node = width_; node < (width_ << 1u); ++node)
+  {
+    dirty_.push_back(node);
+  }
+}
+
+/**
+ * Update one of the leaves of the tree
+ *
+ * @param index The index of the leaf
+ * @param digest The new value of the leaf
+ * @return true if the value of the leaf was changed, otherwise false
+ */
+bool IncrementalMerkleTree::Update(std::size_t index, Digest const &digest)
+{
+  auto &leaf = leaf_nodes_.at(index);
+
+  if (leaf == digest)
+  {
+    return false;
+  }
+
+  leaf = digest;
+  dirty_.push_back(width_ + index);
+
+  return true;
+}
+
+/**
+ * Update all the leaves of the tree
+ *
+ * @param leaves The new values of the leaves
+ * @return The number of leaves whose values have changed
+ */
+std::size_t IncrementalMerkleTree::Update(DigestList const &leaves)
+{
+  if (leaves.size() != leaf_nodes_.size())
+  {
+    throw std::runtime_error("Incorrect number of leaves for merkle tree update");
+  }
+
+  std::size_t num_changed{0};
+  for (std::size_t i = 0; i < leaves.size(); ++i)
+  {
+    if (Update(i, leaves[i]))
+    {
+      ++num_changed;
+    }
+  }
+
+  return num_changed;
+}
+
+/**
+ * Get the root of the tree, recalculating the paths of any updated leaves
+ *
+ * @return The merkle root
+ */
+IncrementalMerkleTree::Digest const &IncrementalMerkleTree::root() const
+{
+  if (!dirty_.empty())
+  {
+    UpdateDirtyNodes();
+  }
+
+  return root_;
+}
+
+/**
+ * Record the current leaves of the tree. Any snapshots with the same or a later index are
+ * discarded, as are the oldest snapshots should the maximum number of snapshots be exceeded.
+ *
+ * @param index The index (e.g. block number) to associate with the snapshot
+ */
+void IncrementalMerkleTree::Snapshot(uint64_t index)
+{
+  if (max_snapshots_ == 0)
+  {
+    return;
+  }
+
+  snapshots_.erase(snapshots_.lower_bound(index), snapshots_.end());
+  snapshots_.emplace(index, leaf_nodes_);
+
+  while (snapshots_.size() > max_snapshots_)
+  {
+    snapshots_.erase(snapshots_.begin());
+  }
+}
+
+/**
+ * Determine if a snapshot has been recorded for the specified index
+ *
+ * @param index The index of the snapshot
+ * @return true if present, otherwise false
+ */
+bool IncrementalMerkleTree::HasSnapshot(uint64_t index) const
+{
+  return snapshots_.find(index) != snapshots_.end();
+}
+
+/**
+ * Revert the leaves of the tree to a previously recorded snapshot. Only the paths of the leaves
+ * which differ from the snapshot are recalculated. The snapshots after the index are discarded.
+ *
+ * @param index The index of the snapshot
+ * @return true if successful, false if no snapshot is present for the index
+ */
+bool IncrementalMerkleTree::RevertToSnapshot(uint64_t index)
+{
+  auto const it = snapshots_.find(index);
+  if (it == snapshots_.end())
+  {
+    return false;
+  }
+
+  Update(it->second);
+
+  snapshots_.erase(std::next(it), snapshots_.end());
+
+  return true;
+}
+
+/**
+ * Discard all the recorded snapshots
+ */
+void IncrementalMerkleTree::ClearSnapshots()
+{
+  snapshots_.clear();
+}
+
+/**
+ * Generate a proof that a leaf is included in the tree
+ *
+ * The proof is the list of sibling nodes on the path from the leaf to the root
+ *
+ * @param index The index of the leaf
+ * @return The inclusion proof
+ */
+IncrementalMerkleTree::Proof IncrementalMerkleTree::GenerateProof(std::size_t index) const
+{
+  if (index >= leaf_nodes_.size())
+  {
+    throw std::out_of_range("Merkle tree leaf index out of range");
+  }
+
+  // ensure that all the interior nodes are up to date
+  root();
+
+  Proof proof;
+  for (std::size_t node = width_ + index; node > 1; node >>= 1u)
+  {
+    proof.push_back(Node(node ^ 1u));
+  }
+
+  return proof;
+}
+
+/**
+ * Verify the proof that a leaf is included in a tree
+ *
+ * @param leaf The value of the leaf
+ * @param index The index of the leaf
+ * @param count The number of leaves of the tree
+ * @param proof The inclusion proof for the leaf
+ * @param root The expected root of the tree
+ * @return true if the proof is valid, otherwise false
+ */
+bool IncrementalMerkleTree::VerifyProof(Digest const &leaf, std::size_t index, std::size_t count,
+                                        Proof const &proof, Digest const &root)
+{
+  if (index >= count)
+  {
+    return false;
+  }
+
+  std::size_t node = CalculateWidth(count) + index;
+
+  Digest current = leaf;
+  for (auto const &sibling : proof)
+  {
+    if (node <= 1)
+    {
+      return false;
+    }
+
+    current = (node & 1u) ? HashChildren(sibling, current) : HashChildren(current, sibling);
+    node >>= 1u;
+  }
+
+  return (node == 1) && (current == root);
+}
+
+/**
+ * Internal: Lookup a node of the (padded) tree
+ *
+ * @param node The index of the node, the leaves start at the width of the tree
+ * @return The value of the node
+ */
+IncrementalMerkleTree::Digest const &IncrementalMerkleTree::Node(std::size_t node) const
+{
+  static Digest const EMPTY{};
+
+  if (node < width_)
+  {
+    return nodes_[node];
+  }
+
+  std::size_t const index = node - width_;
+  return (index < leaf_nodes_.size()) ? leaf_nodes_[index] : EMPTY;
+}
+
+/**
+ * Internal: Recalculate the nodes on the paths from the dirty nodes to the root. The nodes are
+ * updated one level at a time, with the nodes of a level hashed as a single batch.
+ */
+void IncrementalMerkleTree::UpdateDirtyNodes() const
+{
+  // special cases to match the root of the MerkleTree
+  if (leaf_nodes_.empty())
+  {
+    root_ = Hash<SHA256>(Digest{});
+  }
+  else if (leaf_nodes_.size() == 1)
+  {
+    root_ = leaf_nodes_[0];
+  }
+  else
+  {
+    IndexList         parents;
+    SHA256::MessageList messages;
+
+    while (!dirty_.empty())
+    {
+      // determine the unique parents of the dirty nodes (all of which are on the same level)
+      parents.clear();
+      for (auto const node : dirty_)
+      {
+        parents.push_back(node >> 1u);
+      }
+
+      std::sort(parents.begin(), parents.end());
+      parents.erase(std::unique(parents.begin(), parents.end()), parents.end());
+
+      messages.resize(parents.size());
+      for (std::size_t i = 0; i < parents.size(); ++i)
+      {
+        std::size_t const left = parents[i] << 1u;
+        messages[i]            = Node(left) + Node(left + 1);
+      }
+
+      auto const digests = SHA256::HashBatch(messages);
+      for (std::size_t i = 0; i < parents.size(); ++i)
+      {
+        nodes_[parents[i]] = digests[i];
+      }
+
+      // continue up the tree until the root has been updated
+      dirty_.clear();
+      if (parents.front() > 1)
+      {
+        dirty_.swap(parents);
+      }
+    }
+
+    root_ = nodes_[1];
+  }
+
+  dirty_.clear();
+}
+
+}  // namespace crypto
+}  // namespace fetch
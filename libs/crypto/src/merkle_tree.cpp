@@ -60,17 +60,19 @@ void MerkleTree::CalculateRoot() const
     hashes.push_back(Digest{});
   }
 
-  // Now, repeatedly condense the vector by calculating the parents of each of the roots
+  // Now, repeatedly condense the vector by calculating the parents of each of the roots. Since the
+  // parents of a level are independent of each other they are hashed as a single batch
+  SHA256::MessageList messages;
   while (hashes.size() > 1)
   {
+    messages.resize(hashes.size() / 2);
     for (std::size_t i = 0, j = 0; i < hashes.size(); i += 2, ++j)
     {
-      Digest concantenated_hash = hashes[i] + hashes[i + 1];
-      concantenated_hash        = Hash<crypto::SHA256>(concantenated_hash);
-      hashes[j]                 = concantenated_hash;
+      messages[j] = hashes[i] + hashes[i + 1];
     }
 
-    hashes.resize(hashes.size() / 2);
+    auto const parents = SHA256::HashBatch(messages);
+    hashes.assign(parents.begin(), parents.end());
   }
 
   assert(hashes.size() == 1);
@@ -0,0 +1,156 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "crypto/public_key_cache.hpp"
+#include "crypto/ecdsa_signature.hpp"
+
+#include <functional>
+
+namespace fetch {
+namespace crypto {
+
+/**
+ * Construct a public key cache
+ *
+ * @param capacity The maximum number of keys to be cached (rounded up to a multiple of the shards)
+ */
+PublicKeyCache::PublicKeyCache(std::size_t capacity)
+  : shard_capacity_{(capacity + NUM_SHARDS - 1) / NUM_SHARDS}
+{}
+
+/**
+ * Lookup (or parse and insert) the public key for the specified identity
+ *
+ * @param identity The identity whose public key is requested
+ * @return The parsed public key, or an empty pointer if the identity is not valid
+ */
+PublicKeyCache::PublicKeyPtr PublicKeyCache::Lookup(Identity const &identity)
+{
+  if (!identity)
+  {
+    return {};
+  }
+
+  auto &shard = LookupShard(identity);
+
+  // fast path: the key has already been parsed
+  {
+    std::lock_guard<std::mutex> lock(shard.lock);
+
+    auto const it = shard.index.find(identity);
+    if (it != shard.index.end())
+    {
+      // move the entry to the front of the LRU list
+      shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+
+      ++hit_count_;
+      return it->second->key;
+    }
+  }
+
+  ++miss_count_;
+
+  // parse the key outside of the lock since this is the expensive part of the operation
+  auto key = std::make_shared<PublicKey const>(identity.identifier());
+
+  if (shard_capacity_ > 0)
+  {
+    std::lock_guard<std::mutex> lock(shard.lock);
+
+    // another thread might have populated the entry in the meantime
+    if (shard.index.find(identity) == shard.index.end())
+    {
+      shard.entries.push_front(Entry{identity, key});
+      shard.index.emplace(identity, shard.entries.begin());
+
+      // evict the least recently used entries
+      while (shard.entries.size() > shard_capacity_)
+      {
+        shard.index.erase(shard.entries.back().identity);
+        shard.entries.pop_back();
+      }
+    }
+  }
+
+  return key;
+}
+
+/**
+ * Verify a specified signature from a data buffer and identity using the cached public key
+ *
+ * @param identity The identity of the signer
+ * @param data The payload of the message
+ * @param signature The signature to verify
+ * @return true if the signature is valid for the payload, otherwise false
+ */
+bool PublicKeyCache::Verify(Identity const &identity, ConstByteArray const &data,
+                            ConstByteArray const &signature)
+{
+  auto const key = Lookup(identity);
+  if (!key)
+  {
+    return false;
+  }
+
+  openssl::ECDSASignature<> const sig{signature};
+  return sig.Verify(*key, data);
+}
+
+/**
+ * Remove all the entries from the cache
+ */
+void PublicKeyCache::Clear()
+{
+  for (auto &shard : shards_)
+  {
+    std::lock_guard<std::mutex> lock(shard.lock);
+    shard.index.clear();
+    shard.entries.clear();
+  }
+}
+
+/**
+ * Determine the current number of cached keys
+ *
+ * @return The number of cached keys
+ */
+std::size_t PublicKeyCache::size() const
+{
+  std::size_t total{0};
+  for (auto const &shard : shards_)
+  {
+    std::lock_guard<std::mutex> lock(shard.lock);
+    total += shard.entries.size();
+  }
+
+  return total;
+}
+
+/**
+ * Internal: Determine the shard responsible for the specified identity
+ *
+ * @param identity The identity to lookup
+ * @return The corresponding shard
+ */
+PublicKeyCache::Shard &PublicKeyCache::LookupShard(Identity const &identity)
+{
+  return shards_[std::hash<Identity>{}(identity) % NUM_SHARDS];
+}
+
+}  // namespace crypto
+}  // namespace fetch
@@ -0,0 +1,263 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "crypto/sha256.hpp"
+#include "crypto/sha256_batch_detail.hpp"
+#include "vectorise/platform.hpp"
+
+#include <openssl/sha.h>
+
+#include <algorithm>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace fetch {
+namespace crypto {
+namespace detail {
+namespace {
+
+#ifdef __SSE2__
+
+/**
+ * 4 lane vector operations for the multi-buffer hashing
+ */
+struct SSE2Ops
+{
+  using Vector = __m128i;
+
+  static constexpr std::size_t LANES = 4;
+
+  static Vector Broadcast(uint32_t word)
+  {
+    return _mm_set1_epi32(static_cast<int>(word));
+  }
+
+  static Vector Load(uint32_t const *words)
+  {
+    return _mm_loadu_si128(reinterpret_cast<Vector const *>(words));
+  }
+
+  static void Store(uint32_t *words, Vector value)
+  {
+    _mm_storeu_si128(reinterpret_cast<Vector *>(words), value);
+  }
+
+  static Vector Add(Vector a, Vector b)
+  {
+    return _mm_add_epi32(a, b);
+  }
+
+  static Vector Xor(Vector a, Vector b)
+  {
+    return _mm_xor_si128(a, b);
+  }
+
+  static Vector And(Vector a, Vector b)
+  {
+    return _mm_and_si128(a, b);
+  }
+
+  static Vector Or(Vector a, Vector b)
+  {
+    return _mm_or_si128(a, b);
+  }
+
+  static Vector AndNot(Vector a, Vector b)
+  {
+    return _mm_andnot_si128(a, b);
+  }
+
+  template <int N>
+  static Vector ShiftRight(Vector value)
+  {
+    return _mm_srli_epi32(value, N);
+  }
+
+  template <int N>
+  static Vector RotateRight(Vector value)
+  {
+    return _mm_or_si128(_mm_srli_epi32(value, N), _mm_slli_epi32(value, 32 - N));
+  }
+};
+
+#endif
+
+}  // namespace
+
+/**
+ * Hash each of the messages of the batch in turn
+ *
+ * @param items The messages to be hashed
+ * @param count The number of messages
+ */
+void SHA256HashBatchScalar(SHA256BatchItem const *items, std::size_t count)
+{
+  SHA256_CTX context;
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    SHA256_Init(&context);
+    SHA256_Update(&context, items[i].data, items[i].size);
+    SHA256_Final(items[i].digest, &context);
+  }
+}
+
+/**
+ * Hash the messages of the batch, 4 at a time
+ *
+ * @param items The messages to be hashed
+ * @param count The number of messages
+ */
+void SHA256HashBatchSSE2(SHA256BatchItem const *items, std::size_t count)
+{
+#ifdef __SSE2__
+  using Kernel = SHA256MultiBuffer<SSE2Ops>;
+
+  for (std::size_t start = 0; start < count; start += Kernel::LANES)
+  {
+    std::size_t const remaining = count - start;
+    Kernel::Hash(items + start, (remaining < Kernel::LANES) ? remaining : Kernel::LANES);
+  }
+#else
+  SHA256HashBatchScalar(items, count);
+#endif
+}
+
+}  // namespace detail
+
+namespace {
+
+using detail::SHA256BatchItem;
+using BatchItemList = std::vector<SHA256BatchItem>;
+
+/// The smallest batch for which the multi-buffer kernels are used
+constexpr std::size_t MIN_MULTI_BUFFER_BATCH = 2;
+
+std::size_t PaddedBlockCount(std::size_t size)
+{
+  return (size + 72u) / 64u;
+}
+
+/**
+ * Hash the batch with the fastest kernel supported by the CPU. The hardware SHA extensions (used by
+ * OpenSSL when present) outperform the multi-buffer kernels, which are otherwise preferred.
+ *
+ * @param items The messages to be hashed
+ * @param count The number of messages
+ */
+void Dispatch(SHA256BatchItem const *items, std::size_t count)
+{
+  if ((count < MIN_MULTI_BUFFER_BATCH) || platform::cpu_supports_sha())
+  {
+    detail::SHA256HashBatchScalar(items, count);
+  }
+  else if (platform::cpu_supports_avx2() && detail::SHA256HasAVX2Kernel())
+  {
+    detail::SHA256HashBatchAVX2(items, count);
+  }
+  else
+  {
+    detail::SHA256HashBatchSSE2(items, count);
+  }
+}
+
+}  // namespace
+
+/**
+ * Hash a batch of independent messages
+ *
+ * Messages of differing lengths are grouped by their number of (padded) blocks so that the lanes of
+ * the vector registers are not left idle while the longer messages of a group are hashed.
+ *
+ * @param items The messages (and output digest buffers) of the batch
+ * @param count The number of messages in the batch
+ */
+void SHA256::HashBatch(BatchItem const *items, std::size_t count)
+{
+  bool uniform{true};
+  for (std::size_t i = 1; uniform && (i < count); ++i)
+  {
+    uniform = PaddedBlockCount(items[i].size) == PaddedBlockCount(items[0].size);
+  }
+
+  if (uniform)
+  {
+    Dispatch(items, count);
+  }
+  else
+  {
+    BatchItemList sorted(items, items + count);
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [](SHA256BatchItem const &a, SHA256BatchItem const &b) {
+                       return PaddedBlockCount(a.size) < PaddedBlockCount(b.size);
+                     });
+
+    Dispatch(sorted.data(), sorted.size());
+  }
+}
+
+/**
+ * Hash a batch of independent messages
+ *
+ * @param messages The messages to be hashed
+ * @return The digests of the messages (in the same order)
+ */
+SHA256::DigestList SHA256::HashBatch(MessageList const &messages)
+{
+  DigestList    digests(messages.size());
+  BatchItemList items(messages.size());
+
+  for (std::size_t i = 0; i < messages.size(); ++i)
+  {
+    digests[i].Resize(size_in_bytes());
+
+    items[i].data   = messages[i].pointer();
+    items[i].size   = messages[i].size();
+    items[i].digest = digests[i].pointer();
+  }
+
+  HashBatch(items.data(), items.size());
+
+  return digests;
+}
+
+/**
+ * Determine the number of messages which are hashed in parallel by HashBatch on this CPU
+ *
+ * @return The number of lanes
+ */
+std::size_t SHA256::batch_lanes()
+{
+  if (platform::cpu_supports_sha())
+  {
+    return 1;
+  }
+
+  if (platform::cpu_supports_avx2() && detail::SHA256HasAVX2Kernel())
+  {
+    return 8;
+  }
+
+  return platform::has_sse2() ? 4 : 1;
+}
+
+}  // namespace crypto
+}  // namespace fetch
@@ -0,0 +1,138 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+// This file is compiled with AVX2 enabled (see the library CMakeLists.txt) and is only called once
+// the CPU has been detected to support it. It must therefore not include any headers which might
+// emit (non-internal) inline functions which could be shared with the rest of the library.
+#include "crypto/sha256_batch_detail.hpp"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace fetch {
+namespace crypto {
+namespace detail {
+namespace {
+
+#ifdef __AVX2__
+
+/**
+ * 8 lane vector operations for the multi-buffer hashing
+ */
+struct AVX2Ops
+{
+  using Vector = __m256i;
+
+  static constexpr std::size_t LANES = 8;
+
+  static Vector Broadcast(uint32_t word)
+  {
+    return _mm256_set1_epi32(static_cast<int>(word));
+  }
+
+  static Vector Load(uint32_t const *words)
+  {
+    return _mm256_loadu_si256(reinterpret_cast<Vector const *>(words));
+  }
+
+  static void Store(uint32_t *words, Vector value)
+  {
+    _mm256_storeu_si256(reinterpret_cast<Vector *>(words), value);
+  }
+
+  static Vector Add(Vector a, Vector b)
+  {
+    return _mm256_add_epi32(a, b);
+  }
+
+  static Vector Xor(Vector a, Vector b)
+  {
+    return _mm256_xor_si256(a, b);
+  }
+
+  static Vector And(Vector a, Vector b)
+  {
+    return _mm256_and_si256(a, b);
+  }
+
+  static Vector Or(Vector a, Vector b)
+  {
+    return _mm256_or_si256(a, b);
+  }
+
+  static Vector AndNot(Vector a, Vector b)
+  {
+    return _mm256_andnot_si256(a, b);
+  }
+
+  template <int N>
+  static Vector ShiftRight(Vector value)
+  {
+    return _mm256_srli_epi32(value, N);
+  }
+
+  template <int N>
+  static Vector RotateRight(Vector value)
+  {
+    return _mm256_or_si256(_mm256_srli_epi32(value, N), _mm256_slli_epi32(value, 32 - N));
+  }
+};
+
+#endif
+
+}  // namespace
+
+/**
+ * Hash the messages of the batch, 8 at a time
+ *
+ * @param items The messages to be hashed
+ * @param count The number of messages
+ */
+void SHA256HashBatchAVX2(SHA256BatchItem const *items, std::size_t count)
+{
+#ifdef __AVX2__
+  using Kernel = SHA256MultiBuffer<AVX2Ops>;
+
+  for (std::size_t start = 0; start < count; start += Kernel::LANES)
+  {
+    std::size_t const remaining = count - start;
+    Kernel::Hash(items + start, (remaining < Kernel::LANES) ? remaining : Kernel::LANES);
+  }
+#else
+  SHA256HashBatchSSE2(items, count);
+#endif
+}
+
+/**
+ * Determine if the library has been built with the AVX2 kernel
+ *
+ * @return true if the kernel is available, otherwise false
+ */
+bool SHA256HasAVX2Kernel()
+{
+#ifdef __AVX2__
+  return true;
+#else
+  return false;
+#endif
+}
+
+}  // namespace detail
+}  // namespace crypto
+}  // namespace fetch
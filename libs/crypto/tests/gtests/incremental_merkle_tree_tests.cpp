@@ -0,0 +1,212 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/random/lcg.hpp"
+#include "core/serializers/byte_array.hpp"
+#include "core/serializers/byte_array_buffer.hpp"
+#include "crypto/hash.hpp"
+#include "crypto/incremental_merkle_tree.hpp"
+#include "crypto/merkle_tree.hpp"
+#include "crypto/sha256.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+using namespace fetch;
+using namespace fetch::crypto;
+
+using fetch::byte_array::ConstByteArray;
+using fetch::byte_array::ByteArray;
+
+namespace {
+
+using RNG = fetch::random::LinearCongruentialGenerator;
+
+ConstByteArray GenerateLeaf(RNG &rng)
+{
+  return Hash<crypto::SHA256>(ByteArray{std::to_string(rng())});
+}
+
+/**
+ * Build the reference MerkleTree from the leaves of an incremental tree
+ */
+MerkleTree BuildReference(IncrementalMerkleTree const &tree)
+{
+  MerkleTree reference{tree.size()};
+  for (std::size_t i = 0; i < tree.size(); ++i)
+  {
+    reference[i] = tree.leaf(i);
+  }
+
+  reference.CalculateRoot();
+  return reference;
+}
+
+}  // namespace
+
+TEST(crypto_incremental_merkle_tree, empty_tree)
+{
+  IncrementalMerkleTree tree{0};
+
+  EXPECT_EQ(tree.root(), Hash<crypto::SHA256>(ByteArray{}));
+}
+
+TEST(crypto_incremental_merkle_tree, matches_merkle_tree_under_updates)
+{
+  RNG rng;
+
+  for (std::size_t count = 1; count <= 17; ++count)
+  {
+    IncrementalMerkleTree tree{count};
+    EXPECT_EQ(tree.root(), BuildReference(tree).root());
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      tree.Update(i, GenerateLeaf(rng));
+    }
+    EXPECT_EQ(tree.root(), BuildReference(tree).root());
+
+    // update a random selection of the leaves
+    for (std::size_t round = 0; round < 8; ++round)
+    {
+      for (std::size_t i = 0; i < 3; ++i)
+      {
+        tree.Update(rng() % count, GenerateLeaf(rng));
+      }
+
+      EXPECT_EQ(tree.root(), BuildReference(tree).root()) << "count: " << count;
+    }
+  }
+}
+
+TEST(crypto_incremental_merkle_tree, only_changed_leaves_reported)
+{
+  RNG                               rng;
+  IncrementalMerkleTree             tree{8};
+  IncrementalMerkleTree::DigestList leaves(8);
+
+  for (auto &leaf : leaves)
+  {
+    leaf = GenerateLeaf(rng);
+  }
+
+  EXPECT_EQ(tree.Update(leaves), 8);
+  EXPECT_EQ(tree.Update(leaves), 0);
+
+  leaves[3] = GenerateLeaf(rng);
+  EXPECT_EQ(tree.Update(leaves), 1);
+  EXPECT_FALSE(tree.Update(3, leaves[3]));
+}
+
+TEST(crypto_incremental_merkle_tree, serializes_like_merkle_tree)
+{
+  RNG                   rng;
+  IncrementalMerkleTree tree{4};
+
+  for (std::size_t i = 0; i < tree.size(); ++i)
+  {
+    tree.Update(i, GenerateLeaf(rng));
+  }
+
+  fetch::serializers::ByteArrayBuffer buffer;
+  buffer << tree;
+  buffer.seek(0);
+
+  MerkleTree deserialized{4};
+  buffer >> deserialized;
+
+  EXPECT_EQ(deserialized.leaf_nodes(), tree.leaf_nodes());
+  EXPECT_EQ(deserialized.root(), tree.root());
+}
+
+TEST(crypto_incremental_merkle_tree, snapshot_and_revert)
+{
+  RNG                   rng;
+  IncrementalMerkleTree tree{5, 3};
+
+  std::vector<ConstByteArray> roots;
+  for (uint64_t index = 0; index < 5; ++index)
+  {
+    tree.Update(index, GenerateLeaf(rng));
+    tree.Snapshot(index);
+
+    roots.push_back(tree.root());
+  }
+
+  // only the most recent snapshots are retained
+  EXPECT_EQ(tree.num_snapshots(), 3);
+  EXPECT_FALSE(tree.HasSnapshot(1));
+  EXPECT_FALSE(tree.RevertToSnapshot(1));
+
+  ASSERT_TRUE(tree.RevertToSnapshot(2));
+  EXPECT_EQ(tree.root(), roots[2]);
+  EXPECT_EQ(tree.root(), BuildReference(tree).root());
+
+  // the later snapshots are discarded on revert
+  EXPECT_FALSE(tree.HasSnapshot(3));
+  EXPECT_FALSE(tree.HasSnapshot(4));
+  EXPECT_TRUE(tree.HasSnapshot(2));
+
+  // re-snapshotting an index replaces the previous entry
+  tree.Update(4, GenerateLeaf(rng));
+  tree.Snapshot(3);
+  auto const new_root = tree.root();
+
+  ASSERT_TRUE(tree.RevertToSnapshot(2));
+  EXPECT_EQ(tree.root(), roots[2]);
+
+  ASSERT_FALSE(tree.RevertToSnapshot(3));
+  EXPECT_NE(tree.root(), new_root);
+}
+
+TEST(crypto_incremental_merkle_tree, inclusion_proofs)
+{
+  RNG rng;
+
+  for (std::size_t count = 1; count <= 9; ++count)
+  {
+    IncrementalMerkleTree tree{count};
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      tree.Update(i, GenerateLeaf(rng));
+    }
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      auto proof = tree.GenerateProof(i);
+      EXPECT_TRUE(IncrementalMerkleTree::VerifyProof(tree.leaf(i), i, count, proof, tree.root()));
+
+      // the proof must not be valid for any other leaf or position
+      EXPECT_FALSE(
+          IncrementalMerkleTree::VerifyProof(GenerateLeaf(rng), i, count, proof, tree.root()));
+
+      if (count > 1)
+      {
+        std::size_t const other = (i + 1) % count;
+        EXPECT_FALSE(
+            IncrementalMerkleTree::VerifyProof(tree.leaf(i), other, count, proof, tree.root()));
+
+        proof.front() = GenerateLeaf(rng);
+        EXPECT_FALSE(
+            IncrementalMerkleTree::VerifyProof(tree.leaf(i), i, count, proof, tree.root()));
+      }
+    }
+  }
+}
@@ -0,0 +1,148 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "crypto/ecdsa.hpp"
+#include "crypto/public_key_cache.hpp"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace fetch {
+namespace crypto {
+
+namespace {
+
+using ConstByteArray = byte_array::ConstByteArray;
+
+ConstByteArray const TEST_DATA{"hello world"};
+
+TEST(PublicKeyCacheTests, CheckVerificationWithCache)
+{
+  ECDSASigner signer;
+  signer.GenerateKeys();
+
+  auto const signature = signer.Sign(TEST_DATA);
+
+  PublicKeyCache cache;
+  EXPECT_TRUE(cache.Verify(signer.identity(), TEST_DATA, signature));
+  EXPECT_TRUE(cache.Verify(signer.identity(), TEST_DATA, signature));
+  EXPECT_FALSE(cache.Verify(signer.identity(), ConstByteArray{"goodbye world"}, signature));
+
+  EXPECT_EQ(cache.size(), 1u);
+  EXPECT_EQ(cache.miss_count(), 1u);
+  EXPECT_EQ(cache.hit_count(), 2u);
+}
+
+TEST(PublicKeyCacheTests, CheckInvalidIdentity)
+{
+  ECDSASigner signer;
+  signer.GenerateKeys();
+
+  auto const signature = signer.Sign(TEST_DATA);
+
+  PublicKeyCache cache;
+  EXPECT_FALSE(cache.Verify(Identity{}, TEST_DATA, signature));
+  EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST(PublicKeyCacheTests, CheckEviction)
+{
+  PublicKeyCache cache{16};
+
+  std::vector<std::unique_ptr<ECDSASigner>> signers;
+  for (std::size_t i = 0; i < 128; ++i)
+  {
+    signers.emplace_back(std::make_unique<ECDSASigner>());
+    signers.back()->GenerateKeys();
+
+    auto const key = cache.Lookup(signers.back()->identity());
+    ASSERT_TRUE(key);
+    EXPECT_EQ(key->keyAsBin(), signers.back()->public_key());
+  }
+
+  EXPECT_LE(cache.size(), cache.capacity());
+  EXPECT_EQ(cache.miss_count(), 128u);
+
+  cache.Clear();
+  EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST(PublicKeyCacheTests, CheckDisabledCache)
+{
+  ECDSASigner signer;
+  signer.GenerateKeys();
+
+  auto const signature = signer.Sign(TEST_DATA);
+
+  PublicKeyCache cache{0};
+  EXPECT_TRUE(cache.Verify(signer.identity(), TEST_DATA, signature));
+  EXPECT_TRUE(cache.Verify(signer.identity(), TEST_DATA, signature));
+
+  EXPECT_EQ(cache.size(), 0u);
+  EXPECT_EQ(cache.miss_count(), 2u);
+}
+
+TEST(PublicKeyCacheTests, CheckConcurrentVerification)
+{
+  static constexpr std::size_t NUM_THREADS = 4;
+  static constexpr std::size_t NUM_SIGNERS = 8;
+
+  std::vector<std::unique_ptr<ECDSASigner>> signers;
+  std::vector<ConstByteArray>               signatures;
+  for (std::size_t i = 0; i < NUM_SIGNERS; ++i)
+  {
+    signers.emplace_back(std::make_unique<ECDSASigner>());
+    signers.back()->GenerateKeys();
+    signatures.emplace_back(signers.back()->Sign(TEST_DATA));
+  }
+
+  PublicKeyCache   cache;
+  std::atomic<int> failures{0};
+
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < NUM_THREADS; ++i)
+  {
+    threads.emplace_back([&]() {
+      for (std::size_t j = 0; j < 50; ++j)
+      {
+        auto const index = j % NUM_SIGNERS;
+        if (!cache.Verify(signers[index]->identity(), TEST_DATA, signatures[index]))
+        {
+          ++failures;
+        }
+      }
+    });
+  }
+
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  EXPECT_EQ(failures, 0);
+  EXPECT_EQ(cache.size(), NUM_SIGNERS);
+}
+
+}  // namespace
+
+}  // namespace crypto
+}  // namespace fetch
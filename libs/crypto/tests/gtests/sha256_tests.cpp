@@ -19,6 +19,9 @@
 #include "core/byte_array/encoders.hpp"
 #include "crypto/hash.hpp"
 #include "crypto/sha256.hpp"
+#include "vectorise/platform.hpp"
+
+#include <vector>
 
 using namespace fetch;
 using namespace fetch::crypto;
@@ -34,4 +37,86 @@ TEST(crypto_SHA_gtest, The_SHA256_implmentation_differs_from_other_libraries)
   EXPECT_EQ(hash(input), "64ec88ca00b268e5ba1a35678a1b5316d212f4f366b2477232534a8aeca37f3c");
   input = "some RandSom byte_array!! With !@#$%^&*() Symbols!";
   EXPECT_EQ(hash(input), "3d4e08bae43f19e146065b7de2027f9a611035ae138a4ac1978f03cf43b61029");
-}
\ No newline at end of file
+}
+namespace {
+
+using BatchKernel = void (*)(crypto::SHA256::BatchItem const *, std::size_t);
+
+std::vector<byte_array::ConstByteArray> GenerateMessages(std::size_t count)
+{
+  std::vector<byte_array::ConstByteArray> messages;
+  messages.reserve(count);
+
+  // cover all the lengths around the padding boundaries (55, 56, 63, 64, ...)
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    byte_array_type message;
+    message.Resize(i % 150);
+
+    for (std::size_t j = 0; j < message.size(); ++j)
+    {
+      message[j] = static_cast<uint8_t>((i * 31) + j);
+    }
+
+    messages.emplace_back(message);
+  }
+
+  return messages;
+}
+
+void CheckKernel(BatchKernel kernel)
+{
+  auto const messages = GenerateMessages(301);
+
+  std::vector<crypto::SHA256::BatchItem> items(messages.size());
+  std::vector<uint8_t>                   digests(messages.size() * crypto::SHA256::size_in_bytes());
+
+  for (std::size_t i = 0; i < messages.size(); ++i)
+  {
+    items[i].data   = messages[i].pointer();
+    items[i].size   = messages[i].size();
+    items[i].digest = digests.data() + (i * crypto::SHA256::size_in_bytes());
+  }
+
+  kernel(items.data(), items.size());
+
+  for (std::size_t i = 0; i < messages.size(); ++i)
+  {
+    byte_array_type const digest{items[i].digest, crypto::SHA256::size_in_bytes()};
+    EXPECT_EQ(digest, Hash<crypto::SHA256>(messages[i])) << "message size: " << messages[i].size();
+  }
+}
+
+}  // namespace
+
+TEST(crypto_SHA_gtest, CheckScalarBatchKernel)
+{
+  CheckKernel(&crypto::detail::SHA256HashBatchScalar);
+}
+
+TEST(crypto_SHA_gtest, CheckSSE2BatchKernel)
+{
+  CheckKernel(&crypto::detail::SHA256HashBatchSSE2);
+}
+
+TEST(crypto_SHA_gtest, CheckAVX2BatchKernel)
+{
+  if (!(platform::cpu_supports_avx2() && crypto::detail::SHA256HasAVX2Kernel()))
+  {
+    return;
+  }
+
+  CheckKernel(&crypto::detail::SHA256HashBatchAVX2);
+}
+
+TEST(crypto_SHA_gtest, CheckHashBatchPreservesOrder)
+{
+  auto const messages = GenerateMessages(77);
+  auto const digests  = crypto::SHA256::HashBatch(messages);
+
+  ASSERT_EQ(digests.size(), messages.size());
+  for (std::size_t i = 0; i < messages.size(); ++i)
+  {
+    EXPECT_EQ(digests[i], Hash<crypto::SHA256>(messages[i]));
+  }
+}
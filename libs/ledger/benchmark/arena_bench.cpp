@@ -0,0 +1,235 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/memory/arena.hpp"
+#include "ledger/storage_unit/cached_storage_adapter.hpp"
+#include "storage/resource_mapper.hpp"
+#include "vm/string.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+
+// the number of calls made to the global allocator, used to measure the allocations per iteration
+std::atomic<std::size_t> num_heap_allocations{0};
+
+}  // namespace
+
+void *operator new(std::size_t size)
+{
+  ++num_heap_allocations;
+
+  void *ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr)
+  {
+    throw std::bad_alloc{};
+  }
+
+  return ptr;
+}
+
+void operator delete(void *ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+
+namespace {
+
+using fetch::byte_array::ConstByteArray;
+using fetch::core::Arena;
+using fetch::core::ArenaScope;
+using fetch::ledger::CachedStorageAdapter;
+using fetch::ledger::StorageInterface;
+using fetch::storage::ResourceAddress;
+using fetch::vm::Ptr;
+using fetch::vm::String;
+
+using ArenaPtr   = std::shared_ptr<Arena>;
+using KeyList    = std::vector<ResourceAddress>;
+using ObjectList = std::vector<Ptr<String>>;
+
+/**
+ * Storage engine which does not store anything, so that only the cost of the cache is measured
+ */
+class NullStorage : public StorageInterface
+{
+public:
+  Document Get(ResourceAddress const &) override
+  {
+    return {};
+  }
+
+  Document GetOrCreate(ResourceAddress const &) override
+  {
+    return {};
+  }
+
+  void Set(ResourceAddress const &, StateValue const &) override
+  {}
+
+  bool Lock(ShardIndex) override
+  {
+    return true;
+  }
+
+  bool Unlock(ShardIndex) override
+  {
+    return true;
+  }
+};
+
+KeyList GenerateKeys(std::size_t count)
+{
+  KeyList keys;
+  keys.reserve(count);
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    keys.emplace_back(ConstByteArray{"fetch.token.state." + std::to_string(i)});
+  }
+
+  return keys;
+}
+
+/**
+ * Emulate the state accesses of a transaction: every key is read and then updated
+ */
+void ExecuteTransaction(StorageInterface &storage, ArenaPtr const &arena, KeyList const &keys,
+                        ConstByteArray const &value)
+{
+  CachedStorageAdapter cache{storage, true, arena};
+
+  for (auto const &key : keys)
+  {
+    benchmark::DoNotOptimize(cache.Get(key));
+    cache.Set(key, value);
+  }
+
+  benchmark::DoNotOptimize(cache.write_set().size());
+}
+
+void ReportAllocations(benchmark::State &state, std::size_t initial)
+{
+  state.counters["heap_allocs"] = benchmark::Counter(
+      static_cast<double>(num_heap_allocations - initial), benchmark::Counter::kAvgIterations);
+}
+
+void CachedStorageAdapter_Heap(benchmark::State &state)
+{
+  NullStorage          storage;
+  KeyList const        keys = GenerateKeys(static_cast<std::size_t>(state.range(0)));
+  ConstByteArray const value{"value"};
+
+  std::size_t const initial = num_heap_allocations;
+  for (auto _ : state)
+  {
+    ExecuteTransaction(storage, ArenaPtr{}, keys, value);
+  }
+
+  ReportAllocations(state, initial);
+}
+
+void CachedStorageAdapter_Arena(benchmark::State &state)
+{
+  NullStorage          storage;
+  KeyList const        keys = GenerateKeys(static_cast<std::size_t>(state.range(0)));
+  ConstByteArray const value{"value"};
+  auto                 arena = std::make_shared<Arena>();
+
+  std::size_t const initial = num_heap_allocations;
+  for (auto _ : state)
+  {
+    ExecuteTransaction(storage, arena, keys, value);
+
+    // recycled as the execution of the block finishes
+    arena->Reset();
+  }
+
+  ReportAllocations(state, initial);
+}
+
+void CreateObjects(ObjectList &objects, std::size_t count)
+{
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    objects.emplace_back(new String(nullptr, "object"));
+  }
+
+  benchmark::DoNotOptimize(objects.data());
+  objects.clear();
+}
+
+void VmObjects_Heap(benchmark::State &state)
+{
+  auto const count = static_cast<std::size_t>(state.range(0));
+
+  ObjectList objects;
+  objects.reserve(count);
+
+  std::size_t const initial = num_heap_allocations;
+  for (auto _ : state)
+  {
+    CreateObjects(objects, count);
+  }
+
+  ReportAllocations(state, initial);
+}
+
+void VmObjects_Arena(benchmark::State &state)
+{
+  auto const count = static_cast<std::size_t>(state.range(0));
+
+  ObjectList objects;
+  objects.reserve(count);
+
+  Arena arena;
+
+  std::size_t const initial = num_heap_allocations;
+  for (auto _ : state)
+  {
+    {
+      ArenaScope scope{arena};
+      CreateObjects(objects, count);
+    }
+
+    arena.Reset();
+  }
+
+  ReportAllocations(state, initial);
+}
+
+}  // namespace
+
+BENCHMARK(CachedStorageAdapter_Heap)->Arg(16)->Arg(256);
+BENCHMARK(CachedStorageAdapter_Arena)->Arg(16)->Arg(256);
+BENCHMARK(VmObjects_Heap)->Arg(64)->Arg(1024);
+BENCHMARK(VmObjects_Arena)->Arg(64)->Arg(1024);
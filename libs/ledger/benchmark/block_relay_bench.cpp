@@ -0,0 +1,338 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/bitvector.hpp"
+#include "core/serializers/byte_array_buffer.hpp"
+#include "core/service_ids.hpp"
+#include "crypto/ecdsa.hpp"
+#include "crypto/hash.hpp"
+#include "crypto/sha256.hpp"
+#include "ledger/chain/address.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/chain/compact_block.hpp"
+#include "ledger/chain/main_chain.hpp"
+#include "ledger/chain/transaction_layout.hpp"
+#include "ledger/protocols/main_chain_rpc_service.hpp"
+#include "ledger/transaction_layout_cache.hpp"
+#include "network/management/network_manager.hpp"
+#include "network/muddle/muddle.hpp"
+#include "network/p2pservice/p2ptrust_bayrank.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::crypto::ECDSASigner;
+using fetch::crypto::Hash;
+using fetch::crypto::SHA256;
+using fetch::ledger::Address;
+using fetch::ledger::Block;
+using fetch::ledger::CompactBlock;
+using fetch::ledger::MainChain;
+using fetch::ledger::MainChainRpcService;
+using fetch::ledger::TransactionLayout;
+using fetch::ledger::TransactionLayoutCache;
+using fetch::muddle::Muddle;
+using fetch::muddle::NetworkId;
+using fetch::network::NetworkManager;
+using fetch::serializers::ByteArrayBuffer;
+
+using Clock       = std::chrono::steady_clock;
+using Layouts     = std::vector<TransactionLayout>;
+using TrustSystem = fetch::p2p::P2PTrustBayRank<Muddle::Address>;
+
+constexpr uint32_t    LOG2_NUM_LANES = 2;
+constexpr std::size_t NUM_SLICES     = 16;
+constexpr std::size_t NUM_NODES      = 3;
+
+/**
+ * A node on the in-process network, which only runs the block relay
+ */
+struct Node
+{
+  Node(uint16_t port, Muddle::UriList const &peers)
+    : muddle{NetworkId{"Test"}, std::make_unique<ECDSASigner>(), manager}
+    , service{std::make_shared<MainChainRpcService>(muddle.AsEndpoint(), chain, cache, trust,
+                                                    MainChainRpcService::Mode::STANDALONE)}
+  {
+    manager.Start();
+    muddle.Start({port}, peers);
+  }
+
+  ~Node()
+  {
+    service.reset();
+    muddle.Stop();
+    manager.Stop();
+  }
+
+  NetworkManager                       manager{"NetMgr", 1};
+  Muddle                               muddle;
+  MainChain                            chain{MainChain::Mode::IN_MEMORY_DB};
+  TransactionLayoutCache               cache{LOG2_NUM_LANES};
+  TrustSystem                          trust{};
+  std::shared_ptr<MainChainRpcService> service;
+};
+
+using NodePtr = std::unique_ptr<Node>;
+using Nodes   = std::vector<NodePtr>;
+
+/**
+ * Build a line of nodes, so that blocks are relayed through the nodes in the middle
+ */
+Nodes CreateNetwork()
+{
+  static uint16_t next_port = 8100;
+
+  Nodes nodes;
+  for (std::size_t i = 0; i < NUM_NODES; ++i)
+  {
+    Muddle::UriList peers;
+    if (i > 0)
+    {
+      peers.emplace_back("tcp://127.0.0.1:" + std::to_string(next_port - 1));
+    }
+
+    nodes.emplace_back(std::make_unique<Node>(next_port++, peers));
+  }
+
+  // wait for the connections to be established
+  std::this_thread::sleep_for(std::chrono::seconds{2});
+
+  return nodes;
+}
+
+TransactionLayout NextLayout()
+{
+  static uint64_t counter{0};
+
+  BitVector mask{1u << LOG2_NUM_LANES};
+  mask.set(counter % mask.size(), 1);
+
+  return TransactionLayout{Hash<SHA256>("tx" + std::to_string(counter++)), mask, 100u, 0u, 1000u};
+}
+
+/**
+ * Fill the caches with unrelated layouts, as on a node which has been running for some time
+ */
+void FillCaches(std::vector<TransactionLayoutCache *> const &caches)
+{
+  for (std::size_t i = 0; i < TransactionLayoutCache::DEFAULT_CAPACITY; ++i)
+  {
+    auto const layout = NextLayout();
+
+    for (auto *cache : caches)
+    {
+      cache->Add(layout);
+    }
+  }
+}
+
+Block NextBlock(Block const &previous, std::size_t num_txs)
+{
+  Block block;
+  block.body.previous_hash  = previous.body.hash;
+  block.body.block_number   = previous.body.block_number + 1;
+  block.body.miner          = Address{Hash<SHA256>("miner")};
+  block.body.log2_num_lanes = LOG2_NUM_LANES;
+  block.body.slices.resize(NUM_SLICES);
+
+  for (std::size_t i = 0; i < num_txs; ++i)
+  {
+    block.body.slices[i % NUM_SLICES].push_back(NextLayout());
+  }
+
+  // the easiest possible proof
+  block.proof.SetTarget(std::size_t{0});
+  do
+  {
+    ++block.nonce;
+    block.UpdateDigest();
+  } while (!block.proof());
+
+  return block;
+}
+
+Layouts Flatten(Block const &block)
+{
+  Layouts layouts;
+  for (auto const &slice : block.body.slices)
+  {
+    layouts.insert(layouts.end(), slice.begin(), slice.end());
+  }
+
+  return layouts;
+}
+
+bool WaitForBlock(Nodes const &nodes, Block const &block)
+{
+  auto const deadline = Clock::now() + std::chrono::seconds{10};
+
+  for (;;)
+  {
+    bool received{true};
+    for (auto const &node : nodes)
+    {
+      received = received && static_cast<bool>(node->chain.GetBlock(block.body.hash));
+    }
+
+    if (received)
+    {
+      return true;
+    }
+
+    if (Clock::now() > deadline)
+    {
+      return false;
+    }
+
+    std::this_thread::sleep_for(std::chrono::microseconds{100});
+  }
+}
+
+/**
+ * Time the propagation of a block across all the nodes of the network, either as a full block or
+ * in its compact form. For compact blocks a percentage of the transactions are unknown to the
+ * receiving nodes, and must be fetched from the sender. The caches of the receiving nodes are
+ * full, as they would be on a live network.
+ */
+void Relay(benchmark::State &state, bool compact)
+{
+  auto const num_txs         = static_cast<std::size_t>(state.range(0));
+  auto const missing_percent = static_cast<std::size_t>(state.range(1));
+
+  auto const nodes    = CreateNetwork();
+  auto       previous = *nodes.front()->chain.GetHeaviestBlock();
+
+  std::vector<TransactionLayoutCache *> caches;
+  for (std::size_t j = 1; j < nodes.size(); ++j)
+  {
+    caches.push_back(&nodes[j]->cache);
+  }
+  FillCaches(caches);
+
+  std::size_t num_bytes{0};
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+
+    Block const block = NextBlock(previous, num_txs);
+    nodes.front()->chain.AddBlock(block);
+
+    // the receiving nodes have already seen most of the transactions
+    auto const layouts = Flatten(block);
+    for (std::size_t i = 0; i < layouts.size(); ++i)
+    {
+      if ((i % 100) >= missing_percent)
+      {
+        for (std::size_t j = 1; j < nodes.size(); ++j)
+        {
+          nodes[j]->cache.Add(layouts[i]);
+        }
+      }
+    }
+
+    ByteArrayBuffer buffer;
+    if (compact)
+    {
+      buffer << CompactBlock{block, 0};
+    }
+    else
+    {
+      buffer << block;
+    }
+    num_bytes = buffer.data().size();
+
+    state.ResumeTiming();
+
+    if (compact)
+    {
+      nodes.front()->service->BroadcastBlock(block);
+    }
+    else
+    {
+      nodes.front()->muddle.AsEndpoint().Broadcast(fetch::SERVICE_MAIN_CHAIN,
+                                                   fetch::CHANNEL_BLOCKS, buffer.data());
+    }
+
+    if (!WaitForBlock(nodes, block))
+    {
+      state.SkipWithError("block was not relayed to all the nodes");
+      break;
+    }
+
+    previous = block;
+  }
+
+  state.counters["bytes"] = static_cast<double>(num_bytes);
+}
+
+void BlockRelay_Full(benchmark::State &state)
+{
+  Relay(state, false);
+}
+
+void BlockRelay_Compact(benchmark::State &state)
+{
+  Relay(state, true);
+}
+
+/**
+ * Time the reconstruction of a compact block from a full cache
+ */
+void CompactBlock_Reconstruct(benchmark::State &state)
+{
+  auto const num_txs = static_cast<std::size_t>(state.range(0));
+
+  TransactionLayoutCache cache{LOG2_NUM_LANES};
+  FillCaches({&cache});
+
+  Block const block = NextBlock(Block{}, num_txs);
+  for (auto const &layout : Flatten(block))
+  {
+    cache.Add(layout);
+  }
+
+  CompactBlock const    compact{block, 0};
+  Block                 output;
+  CompactBlock::Indices missing;
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(compact.Reconstruct(cache, output, missing));
+  }
+}
+
+}  // namespace
+
+BENCHMARK(BlockRelay_Full)->Args({1000, 0})->Args({10000, 0})->UseRealTime();
+BENCHMARK(BlockRelay_Compact)
+    ->Args({1000, 0})
+    ->Args({1000, 5})
+    ->Args({10000, 0})
+    ->Args({10000, 5})
+    ->UseRealTime();
+BENCHMARK(CompactBlock_Reconstruct)->Arg(1000)->Arg(10000);
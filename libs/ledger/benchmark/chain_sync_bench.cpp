@@ -0,0 +1,262 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/bitvector.hpp"
+#include "core/reactor.hpp"
+#include "crypto/ecdsa.hpp"
+#include "crypto/hash.hpp"
+#include "crypto/sha256.hpp"
+#include "ledger/chain/address.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/chain/main_chain.hpp"
+#include "ledger/protocols/main_chain_rpc_service.hpp"
+#include "ledger/transaction_layout_cache.hpp"
+#include "network/management/network_manager.hpp"
+#include "network/muddle/muddle.hpp"
+#include "network/p2pservice/p2ptrust_bayrank.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::core::Reactor;
+using fetch::crypto::ECDSASigner;
+using fetch::crypto::Hash;
+using fetch::crypto::SHA256;
+using fetch::ledger::Address;
+using fetch::ledger::Block;
+using fetch::ledger::MainChain;
+using fetch::ledger::MainChainRpcService;
+using fetch::ledger::TransactionLayoutCache;
+using fetch::muddle::Muddle;
+using fetch::muddle::NetworkId;
+using fetch::network::NetworkManager;
+
+using Clock       = std::chrono::steady_clock;
+using Blocks      = std::vector<Block>;
+using Mode        = MainChainRpcService::Mode;
+using SyncMode    = MainChainRpcService::SyncMode;
+using TrustSystem = fetch::p2p::P2PTrustBayRank<Muddle::Address>;
+
+constexpr uint32_t    LOG2_NUM_LANES = 2;
+constexpr std::size_t NUM_SOURCES    = 3;
+constexpr std::size_t TXS_PER_BLOCK  = 10;
+
+/**
+ * A node on the in-process network, which only runs the main chain service
+ */
+struct Node
+{
+  Node(uint16_t port, Muddle::UriList const &peers, Mode mode, SyncMode sync_mode)
+    : muddle{NetworkId{"Test"}, std::make_unique<ECDSASigner>(), manager}
+    , service{std::make_shared<MainChainRpcService>(muddle.AsEndpoint(), chain, cache, trust, mode,
+                                                    sync_mode)}
+  {
+    manager.Start();
+    muddle.Start({port}, peers);
+  }
+
+  ~Node()
+  {
+    reactor.Stop();
+    service.reset();
+    muddle.Stop();
+    manager.Stop();
+  }
+
+  NetworkManager                       manager{"NetMgr", 1};
+  Muddle                               muddle;
+  MainChain                            chain{MainChain::Mode::IN_MEMORY_DB};
+  TransactionLayoutCache               cache{LOG2_NUM_LANES};
+  TrustSystem                          trust{};
+  std::shared_ptr<MainChainRpcService> service;
+  Reactor                              reactor{"Reactor"};
+};
+
+using NodePtr = std::unique_ptr<Node>;
+using Nodes   = std::vector<NodePtr>;
+
+uint16_t NextPort()
+{
+  static uint16_t next_port = 8200;
+  return next_port++;
+}
+
+Blocks GenerateChain(Block const &genesis, std::size_t length)
+{
+  uint64_t counter{0};
+
+  Blocks blocks;
+  blocks.reserve(length);
+
+  Block const *previous = &genesis;
+  for (std::size_t i = 0; i < length; ++i)
+  {
+    Block block;
+    block.body.previous_hash  = previous->body.hash;
+    block.body.block_number   = previous->body.block_number + 1;
+    block.body.miner          = Address{Hash<SHA256>("miner")};
+    block.body.log2_num_lanes = LOG2_NUM_LANES;
+    block.body.slices.resize(1);
+
+    for (std::size_t j = 0; j < TXS_PER_BLOCK; ++j)
+    {
+      BitVector mask{1u << LOG2_NUM_LANES};
+      mask.set(j % mask.size(), 1);
+
+      block.body.slices.front().emplace_back(Hash<SHA256>("tx" + std::to_string(counter++)), mask,
+                                             100u, 0u, 1000u);
+    }
+
+    // the easiest possible proof
+    block.proof.SetTarget(std::size_t{0});
+    do
+    {
+      ++block.nonce;
+      block.UpdateDigest();
+    } while (!block.proof());
+
+    blocks.emplace_back(std::move(block));
+    previous = &blocks.back();
+  }
+
+  return blocks;
+}
+
+template <typename Predicate>
+bool WaitFor(Predicate &&predicate, std::chrono::seconds timeout)
+{
+  auto const deadline = Clock::now() + timeout;
+
+  while (!predicate())
+  {
+    if (Clock::now() > deadline)
+    {
+      return false;
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+  }
+
+  return true;
+}
+
+/**
+ * Time a new node catching up with a chain which is served by a number of directly connected peers
+ */
+void CatchUp(benchmark::State &state, SyncMode sync_mode)
+{
+  auto const length = static_cast<std::size_t>(state.range(0));
+
+  // the nodes which serve the chain
+  Nodes           sources;
+  Muddle::UriList peers;
+  for (std::size_t i = 0; i < NUM_SOURCES; ++i)
+  {
+    uint16_t const port = NextPort();
+
+    sources.emplace_back(std::make_unique<Node>(port, Muddle::UriList{}, Mode::STANDALONE,
+                                                SyncMode::HEAVIEST_CHAIN));
+    peers.emplace_back("tcp://127.0.0.1:" + std::to_string(port));
+  }
+
+  auto const blocks = GenerateChain(*sources.front()->chain.GetHeaviestBlock(), length);
+  for (auto const &source : sources)
+  {
+    for (auto const &block : blocks)
+    {
+      source->chain.AddBlock(block);
+    }
+  }
+
+  auto const &tip = blocks.back().body.hash;
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+
+    auto node = std::make_unique<Node>(NextPort(), peers, Mode::PRIVATE_NETWORK, sync_mode);
+
+    // wait for the connections to be established
+    bool const connected = WaitFor(
+        [&node]() {
+          return node->muddle.AsEndpoint().GetDirectlyConnectedPeers().size() >= NUM_SOURCES;
+        },
+        std::chrono::seconds{10});
+    if (!connected)
+    {
+      state.SkipWithError("unable to connect to the peers");
+      break;
+    }
+
+    state.ResumeTiming();
+
+    node->reactor.Attach(node->service->GetWeakRunnable());
+    node->reactor.Start();
+
+    bool const synced =
+        WaitFor([&node, &tip]() { return node->chain.GetHeaviestBlockHash() == tip; },
+                std::chrono::seconds{300});
+
+    state.PauseTiming();
+    node.reset();
+    state.ResumeTiming();
+
+    if (!synced)
+    {
+      state.SkipWithError("node did not catch up with the chain");
+      break;
+    }
+  }
+
+  // reported as the number of blocks synchronised per second
+  state.counters["blocks"] = benchmark::Counter(static_cast<double>(length),
+                                                benchmark::Counter::kIsIterationInvariantRate);
+}
+
+void ChainSync_HeaviestChain(benchmark::State &state)
+{
+  CatchUp(state, SyncMode::HEAVIEST_CHAIN);
+}
+
+void ChainSync_HeadersFirst(benchmark::State &state)
+{
+  CatchUp(state, SyncMode::HEADERS_FIRST);
+}
+
+}  // namespace
+
+BENCHMARK(ChainSync_HeaviestChain)
+    ->Arg(2000)
+    ->Arg(20000)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(ChainSync_HeadersFirst)
+    ->Arg(2000)
+    ->Arg(20000)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
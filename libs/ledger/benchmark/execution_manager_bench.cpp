@@ -0,0 +1,163 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/bitvector.hpp"
+#include "core/byte_array/byte_array.hpp"
+#include "core/macros.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/chain/transaction_layout.hpp"
+#include "ledger/execution_manager.hpp"
+#include "ledger/executor_interface.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <thread>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::byte_array::ByteArray;
+using fetch::ledger::Block;
+using fetch::ledger::ExecutionManager;
+using fetch::ledger::ExecutorInterface;
+using fetch::ledger::TransactionLayout;
+
+using SchedulingMode = ExecutionManager::SchedulingMode;
+using Clock          = std::chrono::high_resolution_clock;
+
+static constexpr uint32_t    LOG2_NUM_LANES = 4;
+static constexpr std::size_t NUM_LANES      = 1u << LOG2_NUM_LANES;
+static constexpr std::size_t NUM_SLICES     = 64;
+static constexpr std::size_t NUM_EXECUTORS  = 8;
+
+/**
+ * Executor which simulates a fixed execution cost for each transaction
+ */
+class SpinningExecutor : public ExecutorInterface
+{
+public:
+  Result Execute(fetch::ledger::Digest const &, BlockIndex, SliceIndex, BitVector const &) override
+  {
+    auto const deadline = Clock::now() + std::chrono::microseconds{50};
+    while (Clock::now() < deadline)
+    {
+      // busy wait to emulate the execution of the contract
+    }
+
+    return {Status::SUCCESS, 0, 0, 0};
+  }
+
+  void SettleFees(fetch::ledger::Address const &, TokenAmount, uint32_t) override
+  {}
+};
+
+/**
+ * Generate a block in which each slice is made up of transactions of random widths. Wide
+ * transactions result in slices with fewer transactions than executors.
+ */
+Block::Body GenerateBlock()
+{
+  std::mt19937 rng{42};
+
+  Block::Body block;
+  block.slices.resize(NUM_SLICES);
+
+  uint64_t counter{0};
+  for (auto &slice : block.slices)
+  {
+    std::size_t lane = 0;
+    while (lane < NUM_LANES)
+    {
+      std::size_t const width = std::min<std::size_t>(1u + (rng() % 6u), NUM_LANES - lane);
+
+      BitVector mask{NUM_LANES};
+      for (std::size_t i = 0; i < width; ++i)
+      {
+        mask.set(lane + i, 1);
+      }
+
+      ByteArray digest;
+      digest.Resize(sizeof(counter));
+      std::memcpy(digest.pointer(), &counter, sizeof(counter));
+      ++counter;
+
+      slice.emplace_back(TransactionLayout{digest, mask, 1, 0, 100});
+      lane += width;
+    }
+  }
+
+  return block;
+}
+
+void ExecutionManager_BlockExecution(benchmark::State &state, SchedulingMode mode)
+{
+  auto manager = std::make_shared<ExecutionManager>(
+      NUM_EXECUTORS, LOG2_NUM_LANES, nullptr,
+      []() { return std::make_shared<SpinningExecutor>(); }, mode);
+
+  manager->Start();
+
+  auto const  block            = GenerateBlock();
+  std::size_t num_transactions = 0;
+  for (auto const &slice : block.slices)
+  {
+    num_transactions += slice.size();
+  }
+
+  for (auto _ : state)
+  {
+    std::size_t const target = manager->completed_executions() + num_transactions;
+
+    if (ExecutionManager::ScheduleStatus::SCHEDULED != manager->Execute(block))
+    {
+      state.SkipWithError("Unable to schedule the block");
+      break;
+    }
+
+    // wait for the execution of the block to complete
+    while ((manager->completed_executions() < target) ||
+           (ExecutionManager::State::IDLE != manager->GetState()))
+    {
+      std::this_thread::yield();
+    }
+  }
+
+  manager->Stop();
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(num_transactions));
+}
+
+void ExecutionManager_SliceOrder(benchmark::State &state)
+{
+  ExecutionManager_BlockExecution(state, SchedulingMode::SLICE_ORDER);
+}
+
+void ExecutionManager_ConflictGraph(benchmark::State &state)
+{
+  ExecutionManager_BlockExecution(state, SchedulingMode::CONFLICT_GRAPH);
+}
+
+}  // namespace
+
+BENCHMARK(ExecutionManager_SliceOrder)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(ExecutionManager_ConflictGraph)->Unit(benchmark::kMillisecond)->UseRealTime();
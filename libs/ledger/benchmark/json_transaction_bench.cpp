@@ -0,0 +1,155 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/json/document.hpp"
+#include "core/json/on_demand.hpp"
+#include "crypto/ecdsa.hpp"
+#include "ledger/chain/address.hpp"
+#include "ledger/chain/json_transaction.hpp"
+#include "ledger/chain/transaction.hpp"
+#include "ledger/chain/transaction_builder.hpp"
+#include "variant/variant.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace {
+
+using fetch::byte_array::ConstByteArray;
+using fetch::crypto::ECDSASigner;
+using fetch::json::JSONDocument;
+using fetch::json::OnDemandDocument;
+using fetch::json::OnDemandValue;
+using fetch::ledger::Address;
+using fetch::ledger::FromJsonTransaction;
+using fetch::ledger::ToJsonTransaction;
+using fetch::ledger::Transaction;
+using fetch::ledger::TransactionBuilder;
+using fetch::variant::Variant;
+
+/**
+ * Build the body of a bulk submission of signed transactions, as received by the HTTP interface
+ */
+ConstByteArray GenerateSubmission(std::size_t count)
+{
+  ECDSASigner   signer;
+  ECDSASigner   recipient;
+  Address const from{signer.identity()};
+  Address const to{recipient.identity()};
+
+  Variant batch = Variant::Array(count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    auto const tx = TransactionBuilder()
+                        .From(from)
+                        .Transfer(to, 1000 + i)
+                        .Signer(signer.identity())
+                        .Seal()
+                        .Sign(signer)
+                        .Build();
+
+    if (!ToJsonTransaction(*tx, batch[i]))
+    {
+      throw std::runtime_error("unable to convert transaction to JSON");
+    }
+  }
+
+  std::ostringstream text;
+  text << batch;
+
+  return ConstByteArray{text.str()};
+}
+
+/**
+ * The signed transactions are expensive to generate, so the submission is shared between runs
+ */
+ConstByteArray const &Submission(std::size_t count)
+{
+  static std::unordered_map<std::size_t, ConstByteArray> submissions{};
+
+  auto &submission = submissions[count];
+  if (submission.empty())
+  {
+    submission = GenerateSubmission(count);
+  }
+
+  return submission;
+}
+
+void ReportThroughput(benchmark::State &state, ConstByteArray const &submission, std::size_t count)
+{
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(submission.size()));
+  state.counters["tx"] =
+      benchmark::Counter(static_cast<double>(count), benchmark::Counter::kIsIterationInvariantRate);
+}
+
+void JsonTransaction_Variant(benchmark::State &state)
+{
+  auto const            count      = static_cast<std::size_t>(state.range(0));
+  ConstByteArray const &submission = Submission(count);
+
+  for (auto _ : state)
+  {
+    JSONDocument doc{submission};
+
+    for (std::size_t i = 0, end = doc.root().size(); i < end; ++i)
+    {
+      Transaction tx;
+      if (!FromJsonTransaction(doc[i], tx))
+      {
+        throw std::runtime_error("unable to decode transaction");
+      }
+    }
+  }
+
+  ReportThroughput(state, submission, count);
+}
+
+void JsonTransaction_OnDemand(benchmark::State &state)
+{
+  auto const            count      = static_cast<std::size_t>(state.range(0));
+  ConstByteArray const &submission = Submission(count);
+
+  OnDemandDocument doc;
+  for (auto _ : state)
+  {
+    doc.Parse(submission);
+
+    doc.root().ForEach([](OnDemandValue const &value) {
+      Transaction tx;
+      if (!FromJsonTransaction(value, tx))
+      {
+        throw std::runtime_error("unable to decode transaction");
+      }
+    });
+  }
+
+  ReportThroughput(state, submission, count);
+}
+
+}  // namespace
+
+BENCHMARK(JsonTransaction_Variant)->Arg(10000)->Unit(benchmark::kMillisecond);
+BENCHMARK(JsonTransaction_OnDemand)->Arg(10000)->Unit(benchmark::kMillisecond);
@@ -16,18 +16,31 @@
 //
 //------------------------------------------------------------------------------
 
+#include "core/bitvector.hpp"
+#include "crypto/hash.hpp"
+#include "crypto/sha256.hpp"
 #include "ledger/chain/main_chain.hpp"
 #include "ledger/testing/block_generator.hpp"
 
 #include <benchmark/benchmark.h>
 
+#include <atomic>
+#include <cstddef>
 #include <memory>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace {
 
+using fetch::BitVector;
+using fetch::ledger::Digest;
+using fetch::ledger::DigestSet;
 using fetch::ledger::MainChain;
 using fetch::ledger::testing::BlockGenerator;
 
+using Mode = MainChain::Mode;
+
 using MainChainPtr = std::unique_ptr<MainChain>;
 using BlockArray   = std::vector<BlockGenerator::BlockPtr>;
 
@@ -124,9 +137,172 @@ void MainChain_Persistent_AddBlocksOutOfOrder(benchmark::State &state)
   }
 }
 
+/**
+ * Add the blocks to a chain with a single writer, while the specified number of reader threads
+ * repeatedly query the chain
+ *
+ * @param state The benchmark state, where the first argument is the number of reader threads
+ * @param mode The storage mode of the chain
+ * @param cache_size The size of the block cache of the chain
+ */
+void ConcurrentReadWrite(benchmark::State &state, Mode mode, std::size_t cache_size)
+{
+  static constexpr uint64_t CHAIN_LIMIT = 100;
+
+  auto array = GenerateBlocks(state);
+
+  auto const        num_readers   = static_cast<std::size_t>(state.range(0));
+  std::size_t const num_preloaded = array.size() / 2;
+
+  std::size_t total_reads{0};
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    auto chain = std::make_unique<MainChain>(mode, cache_size);
+    for (std::size_t i = 1; i < num_preloaded; ++i)
+    {
+      chain->AddBlock(*array[i]);
+    }
+    state.ResumeTiming();
+
+    std::atomic<bool>        finished{false};
+    std::atomic<std::size_t> num_reads{0};
+
+    std::vector<std::thread> readers;
+    for (std::size_t reader = 0; reader < num_readers; ++reader)
+    {
+      readers.emplace_back([&chain, &array, &finished, &num_reads, num_preloaded, reader]() {
+        std::size_t index = 1 + reader;
+        std::size_t reads{0};
+
+        while (!finished)
+        {
+          auto const &block = array[index];
+          index             = 1 + ((index + 7) % (num_preloaded - 1));
+
+          MainChain::Blocks path;
+          chain->GetHeaviestChain(CHAIN_LIMIT);
+          chain->GetBlock(block->body.hash);
+          chain->GetPathToCommonAncestor(path, chain->GetHeaviestBlockHash(), block->body.hash,
+                                         CHAIN_LIMIT);
+
+          reads += 3;
+        }
+
+        num_reads += reads;
+      });
+    }
+
+    for (std::size_t i = num_preloaded; i < array.size(); ++i)
+    {
+      chain->AddBlock(*array[i]);
+    }
+
+    finished = true;
+    for (auto &reader : readers)
+    {
+      reader.join();
+    }
+
+    total_reads += num_reads;
+  }
+
+  state.counters["reads"] = static_cast<double>(total_reads);
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(array.size() - num_preloaded));
+}
+
+void MainChain_InMemory_ConcurrentReadWrite(benchmark::State &state)
+{
+  ConcurrentReadWrite(state, Mode::IN_MEMORY_DB, MainChain::DEFAULT_CACHE_SIZE);
+}
+
+void MainChain_Persistent_ConcurrentReadWrite(benchmark::State &state)
+{
+  ConcurrentReadWrite(state, Mode::CREATE_PERSISTENT_DB, MainChain::DEFAULT_CACHE_SIZE);
+}
+
+void MainChain_PersistentSmallCache_ConcurrentReadWrite(benchmark::State &state)
+{
+  // only a fraction of the block bodies fit in the cache, forcing reloads from the block store
+  static constexpr std::size_t SMALL_CACHE_SIZE = 64 * 1024;
+
+  ConcurrentReadWrite(state, Mode::CREATE_PERSISTENT_DB, SMALL_CACHE_SIZE);
+}
+
+Digest GenerateTxDigest(std::size_t index)
+{
+  return fetch::crypto::Hash<fetch::crypto::SHA256>("tx" + std::to_string(index));
+}
+
+/**
+ * Check a pool of transactions for duplicates against chains of increasing length. Every block of
+ * the chain contains a transaction and a small number of the transactions in the pool are also
+ * found in recent blocks, the typical case when a block is packed.
+ *
+ * @param state The benchmark state, where the first argument is the length of the chain
+ */
+void MainChain_DetectDuplicateTransactions(benchmark::State &state)
+{
+  static constexpr std::size_t POOL_SIZE      = 1000;
+  static constexpr std::size_t NUM_DUPLICATES = 10;
+
+  auto const chain_length = static_cast<std::size_t>(state.range(0));
+
+  BitVector mask{1};
+  mask.set(0, 1);
+
+  BlockGenerator gen{1, 1};
+  MainChain      chain{Mode::IN_MEMORY_DB};
+
+  auto block = gen.Generate();
+  for (std::size_t i = 0; i < chain_length; ++i)
+  {
+    block = gen.Generate(block);
+    block->body.slices[0].emplace_back(GenerateTxDigest(i), mask, 1, 0, chain_length + 1);
+    block->UpdateDigest();
+
+    chain.AddBlock(*block);
+  }
+
+  DigestSet pool{};
+  for (std::size_t i = 0; i < POOL_SIZE - NUM_DUPLICATES; ++i)
+  {
+    pool.insert(GenerateTxDigest(chain_length + i));
+  }
+
+  for (std::size_t i = 1; i <= NUM_DUPLICATES; ++i)
+  {
+    pool.insert(GenerateTxDigest(chain_length - i));
+  }
+
+  for (auto _ : state)
+  {
+    auto const duplicates = chain.DetectDuplicateTransactions(block->body.hash, pool);
+    if (duplicates.size() != NUM_DUPLICATES)
+    {
+      state.SkipWithError("unexpected number of duplicates");
+    }
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * POOL_SIZE));
+}
+
 }  // namespace
 
 BENCHMARK(MainChain_InMemory_AddBlocksSequentially);
 BENCHMARK(MainChain_Persistent_AddBlocksSequentially);
 BENCHMARK(MainChain_InMemory_AddBlocksOutOfOrder);
 BENCHMARK(MainChain_Persistent_AddBlocksOutOfOrder);
+BENCHMARK(MainChain_InMemory_ConcurrentReadWrite)->Arg(0)->Arg(1)->Arg(4)->UseRealTime();
+BENCHMARK(MainChain_Persistent_ConcurrentReadWrite)->Arg(0)->Arg(1)->Arg(4)->UseRealTime();
+BENCHMARK(MainChain_PersistentSmallCache_ConcurrentReadWrite)
+    ->Arg(0)
+    ->Arg(1)
+    ->Arg(4)
+    ->UseRealTime();
+BENCHMARK(MainChain_DetectDuplicateTransactions)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,155 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/bitvector.hpp"
+#include "core/byte_array/byte_array.hpp"
+#include "core/serializers/byte_array_buffer.hpp"
+#include "core/serializers/counter.hpp"
+#include "crypto/ecdsa.hpp"
+#include "ledger/chain/address.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/chain/transaction.hpp"
+#include "ledger/chain/transaction_builder.hpp"
+#include "ledger/chain/transaction_layout.hpp"
+#include "ledger/chain/transaction_layout_rpc_serializers.hpp"
+#include "ledger/chain/transaction_serializer.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::byte_array::ByteArray;
+using fetch::byte_array::ConstByteArray;
+using fetch::crypto::ECDSASigner;
+using fetch::ledger::Address;
+using fetch::ledger::Block;
+using fetch::ledger::Transaction;
+using fetch::ledger::TransactionBuilder;
+using fetch::ledger::TransactionLayout;
+using fetch::ledger::TransactionSerializer;
+using fetch::serializers::ByteArrayBuffer;
+using fetch::serializers::SizeCounter;
+
+constexpr uint32_t LOG2_NUM_LANES = 4;
+
+TransactionBuilder::TransactionPtr GenerateTransaction(ECDSASigner &signer, std::size_t data_size)
+{
+  ByteArray data;
+  data.Resize(data_size);
+  for (std::size_t i = 0; i < data_size; ++i)
+  {
+    data[i] = static_cast<uint8_t>(i);
+  }
+
+  BitVector shard_mask{1u << LOG2_NUM_LANES};
+  shard_mask.set(0, 1);
+
+  return TransactionBuilder()
+      .From(Address{signer.identity()})
+      .TargetChainCode("fetch.dummy", shard_mask)
+      .Action("run")
+      .Data(data)
+      .Signer(signer.identity())
+      .Seal()
+      .Sign(signer)
+      .Build();
+}
+
+void Transaction_Serialize(benchmark::State &state)
+{
+  ECDSASigner signer;
+  auto const  tx = GenerateTransaction(signer, static_cast<std::size_t>(state.range(0)));
+
+  for (auto _ : state)
+  {
+    TransactionSerializer serializer{};
+    serializer << *tx;
+
+    benchmark::DoNotOptimize(serializer.data().pointer());
+  }
+}
+
+void Transaction_Deserialize(benchmark::State &state)
+{
+  ECDSASigner signer;
+  auto const  tx = GenerateTransaction(signer, static_cast<std::size_t>(state.range(0)));
+
+  TransactionSerializer serializer{};
+  serializer << *tx;
+
+  ConstByteArray const received = serializer.data();
+
+  for (auto _ : state)
+  {
+    TransactionSerializer deserializer{received};
+
+    Transaction output;
+    deserializer >> output;
+
+    benchmark::DoNotOptimize(output.data().pointer());
+  }
+}
+
+void Block_RoundTrip(benchmark::State &state)
+{
+  static constexpr std::size_t NUM_SLICES = 16;
+
+  ECDSASigner signer;
+  auto const  tx = GenerateTransaction(signer, 64);
+
+  // populate the block with the layout of the same transaction
+  Block block;
+  block.body.miner          = Address{signer.identity()};
+  block.body.log2_num_lanes = LOG2_NUM_LANES;
+  block.body.slices.resize(NUM_SLICES);
+  for (auto &slice : block.body.slices)
+  {
+    slice.assign(static_cast<std::size_t>(state.range(0)) / NUM_SLICES,
+                 TransactionLayout{*tx, LOG2_NUM_LANES});
+  }
+
+  for (auto _ : state)
+  {
+    // serialise the block, as it is broadcast
+    SizeCounter<ByteArrayBuffer> counter;
+    counter << block;
+
+    ByteArrayBuffer serializer;
+    serializer.Reserve(counter.size());
+    serializer << block;
+
+    // deserialise the block, as it is received
+    ConstByteArray const received = serializer.data();
+    ByteArrayBuffer      deserializer{received};
+
+    Block output;
+    deserializer >> output;
+
+    benchmark::DoNotOptimize(output.body.slices.data());
+  }
+}
+
+}  // namespace
+
+BENCHMARK(Transaction_Serialize)->Arg(64)->Arg(1024)->Arg(16384);
+BENCHMARK(Transaction_Deserialize)->Arg(64)->Arg(1024)->Arg(16384);
+BENCHMARK(Block_RoundTrip)->Arg(256)->Arg(4096);
@@ -24,7 +24,9 @@
 
 #include <benchmark/benchmark.h>
 #include <condition_variable>
+#include <memory>
 #include <thread>
+#include <vector>
 
 using fetch::ledger::TransactionVerifier;
 using fetch::crypto::ECDSASigner;
@@ -103,6 +105,97 @@ void TransactionVerifierBench(benchmark::State &state)
   }
 }
 
+/**
+ * Generate a set of transactions signed (in round robin fashion) by a fixed set of signers. This
+ * mirrors the traffic pattern of a small number of hot wallets.
+ */
+TransactionList GenerateHotWalletTransactions(std::size_t count, std::size_t num_signers)
+{
+  std::vector<std::unique_ptr<ECDSASigner>> signers;
+  signers.reserve(num_signers);
+  for (std::size_t i = 0; i < num_signers; ++i)
+  {
+    signers.emplace_back(std::make_unique<ECDSASigner>());
+    signers.back()->GenerateKeys();
+  }
+
+  TransactionList list;
+  list.reserve(count);
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    auto &signer = *signers[i % num_signers];
+
+    list.emplace_back(TransactionBuilder()
+                          .From(Address{signer.identity()})
+                          .TargetChainCode("fetch.dummy", BitVector{})
+                          .Signer(signer.identity())
+                          .Seal()
+                          .Sign(signer)
+                          .Build());
+  }
+
+  return list;
+}
+
+void TransactionVerifierKeyCacheBench(benchmark::State &state)
+{
+  auto const num_threads    = static_cast<std::size_t>(state.range(0));
+  auto const key_cache_size = static_cast<std::size_t>(state.range(1));
+  auto const num_signers    = static_cast<std::size_t>(state.range(2));
+
+  std::size_t const num_txs = 10000;
+
+  // generate the transactions (which are never verified themselves)
+  auto const txs = GenerateHotWalletTransactions(num_txs, num_signers);
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+
+    DummySink sink{txs.size()};
+
+    auto verifier =
+        std::make_unique<TransactionVerifier>(sink, num_threads, "Verifier", key_cache_size);
+
+    // since the verification result is cached in the transaction, use fresh copies each time
+    TransactionList batch;
+    batch.reserve(txs.size());
+    for (auto const &tx : txs)
+    {
+      batch.emplace_back(std::make_shared<Transaction>(*tx));
+    }
+
+    verifier->AddTransactions(batch);
+
+    verifier->Start();
+    state.ResumeTiming();
+
+    sink.Wait();
+
+    state.PauseTiming();
+    verifier->Stop();
+    state.ResumeTiming();
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(num_txs));
+}
+
+void CreateKeyCacheRanges(benchmark::internal::Benchmark *b)
+{
+  int const max_threads = static_cast<int>(std::thread::hardware_concurrency());
+  int const cache_size  = static_cast<int>(TransactionVerifier::DEFAULT_KEY_CACHE_SIZE);
+
+  for (int i = 1; i <= max_threads; i *= 2)
+  {
+    for (int num_signers : {1, 100, 1000})
+    {
+      b->Args({i, 0, num_signers});
+      b->Args({i, cache_size, num_signers});
+    }
+  }
+}
+
 void CreateRanges(benchmark::internal::Benchmark *b)
 {
   int const max_threads = static_cast<int>(std::thread::hardware_concurrency());
@@ -121,3 +214,4 @@ void CreateRanges(benchmark::internal::Benchmark *b)
 }  // namespace
 
 BENCHMARK(TransactionVerifierBench)->Apply(CreateRanges);
+BENCHMARK(TransactionVerifierKeyCacheBench)->Apply(CreateKeyCacheRanges)->UseRealTime();
@@ -0,0 +1,114 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+#include "core/serializers/byte_array_buffer.hpp"
+#include "crypto/hash.hpp"
+#include "crypto/sha256.hpp"
+#include "ledger/storage_unit/transaction_sketch.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+using fetch::crypto::Hash;
+using fetch::crypto::SHA256;
+using fetch::ledger::TransactionSketch;
+using fetch::serializers::ByteArrayBuffer;
+
+using Digests = TransactionSketch::Digests;
+
+Digests GenerateDigests(std::size_t count, std::string const &seed)
+{
+  Digests digests;
+  digests.reserve(count);
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    digests.emplace_back(Hash<SHA256>(seed + std::to_string(i)));
+  }
+
+  return digests;
+}
+
+/**
+ * Reconcile a set of digests with a peer which holds a few more of them, reporting the size of the
+ * sketch which is exchanged against the size of the digests of the whole set
+ */
+void TransactionSketch_Reconcile(benchmark::State &state)
+{
+  auto const set_size   = static_cast<std::size_t>(state.range(0));
+  auto const difference = static_cast<std::size_t>(state.range(1));
+
+  Digests const common  = GenerateDigests(set_size, "common");
+  Digests const missing = GenerateDigests(difference, "missing");
+
+  std::size_t const num_cells = TransactionSketch::CellsFor(difference);
+
+  // the sketch received from the peer
+  TransactionSketch remote{num_cells};
+  for (auto const &digest : common)
+  {
+    remote.Add(digest);
+  }
+
+  for (auto const &digest : missing)
+  {
+    remote.Add(digest);
+  }
+
+  ByteArrayBuffer buffer;
+  buffer << remote;
+
+  for (auto _ : state)
+  {
+    TransactionSketch local{num_cells};
+    for (auto const &digest : common)
+    {
+      local.Add(digest);
+    }
+
+    TransactionSketch reconciled{remote};
+    reconciled.Subtract(local);
+
+    Digests only_remote;
+    Digests only_local;
+    if (!reconciled.Decode(only_remote, only_local))
+    {
+      throw std::runtime_error("unable to decode the sketch");
+    }
+
+    benchmark::DoNotOptimize(only_remote.data());
+  }
+
+  state.counters["sketch_bytes"] = static_cast<double>(buffer.data().size());
+  state.counters["digest_bytes"] =
+      static_cast<double>((set_size + difference) * TransactionSketch::DIGEST_SIZE);
+}
+
+}  // namespace
+
+BENCHMARK(TransactionSketch_Reconcile)
+    ->Args({10000, 10})
+    ->Args({10000, 100})
+    ->Args({100000, 100})
+    ->Args({100000, 1000})
+    ->Unit(benchmark::kMicrosecond);
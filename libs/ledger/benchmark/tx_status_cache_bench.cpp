@@ -0,0 +1,113 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "ledger/transaction_status_cache.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+using fetch::byte_array::ByteArray;
+using fetch::ledger::Digest;
+using fetch::ledger::TransactionStatus;
+using fetch::ledger::TransactionStatusCache;
+
+using Digests = TransactionStatusCache::Digests;
+
+constexpr std::size_t NUM_DIGESTS = 1u << 14u;
+
+Digests GenerateDigests(std::size_t count)
+{
+  Digests digests;
+  digests.reserve(count);
+
+  uint64_t seed = 0x5eed;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    ByteArray digest;
+    digest.Resize(32);
+
+    for (std::size_t j = 0; j < digest.size(); j += sizeof(seed))
+    {
+      seed = (seed * 6364136223846793005ull) + 1442695040888963407ull;
+      std::memcpy(digest.pointer() + j, &seed, sizeof(seed));
+    }
+
+    digests.emplace_back(std::move(digest));
+  }
+
+  return digests;
+}
+
+/**
+ * Status queries from the HTTP interface interleaved with the updates from the block coordinator
+ * and the transaction processor. One in every `state.range(0)` operations is an update.
+ */
+void TransactionStatusCache_Contention(benchmark::State &state)
+{
+  static Digests const            digests = GenerateDigests(NUM_DIGESTS);
+  static TransactionStatusCache   cache;
+  static std::atomic<std::size_t> next_offset{0};
+
+  // each thread starts from a different part of the digest set
+  auto const write_interval = static_cast<std::size_t>(state.range(0));
+  auto       index          = (next_offset++) * (NUM_DIGESTS / 8u);
+
+  for (auto _ : state)
+  {
+    auto const &digest = digests[index % NUM_DIGESTS];
+
+    if ((index % write_interval) == 0)
+    {
+      cache.Update(digest, TransactionStatus::PENDING);
+    }
+    else
+    {
+      benchmark::DoNotOptimize(cache.Query(digest));
+    }
+
+    ++index;
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+void TransactionStatusCache_BlockUpdate(benchmark::State &state)
+{
+  Digests const          digests = GenerateDigests(static_cast<std::size_t>(state.range(0)));
+  TransactionStatusCache cache;
+
+  for (auto _ : state)
+  {
+    cache.Update(digests, TransactionStatus::EXECUTED);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * state.range(0)));
+}
+
+}  // namespace
+
+BENCHMARK(TransactionStatusCache_Contention)->Arg(10)->Threads(1)->Threads(4)->Threads(8)->UseRealTime();
+BENCHMARK(TransactionStatusCache_BlockUpdate)->Arg(1000)->Arg(10000);
@@ -74,7 +74,10 @@ public:
 
   // Helper functions
   std::size_t GetTransactionCount() const;
+  Digest      GetTransactionRoot() const;
+  Block       CopyHeader() const;
   void        UpdateDigest();
+  void        UpdateDigest(Digest const &transaction_root);
 };
 
 /**
@@ -0,0 +1,176 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/mutex.hpp"
+#include "crypto/fnv.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/chain/digest.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Memory bounded, sharded cache of the blocks of the main chain
+ *
+ * Every block in the cache is either complete or has had its body (the transaction slices) evicted,
+ * leaving only the header. Headers are pinned in the cache until they are explicitly erased. Bodies
+ * become eligible for eviction once their blocks have been marked as persisted (i.e. they can be
+ * reloaded from the block store), after which they are evicted with the CLOCK (second chance)
+ * algorithm whenever the cache exceeds its byte budget.
+ *
+ * Each shard is protected by its own lock, so that lookups from different threads rarely contend.
+ * The blocks returned from the cache must not be modified once they have been persisted.
+ */
+class BlockCache
+{
+public:
+  using BlockPtr  = std::shared_ptr<Block>;
+  using BlockHash = Digest;
+
+  static constexpr std::size_t DEFAULT_MAX_BYTES = 64ull * 1024ull * 1024ull;
+  static constexpr std::size_t NUM_SHARDS        = 16;
+
+  // Construction / Destruction
+  explicit BlockCache(std::size_t max_bytes = DEFAULT_MAX_BYTES);
+  BlockCache(BlockCache const &) = delete;
+  BlockCache(BlockCache &&)      = delete;
+  ~BlockCache()                  = default;
+
+  /// @name Block Access
+  /// @{
+  bool Has(BlockHash const &hash) const;
+  bool HasBody(BlockHash const &hash) const;
+  bool IsPersisted(BlockHash const &hash) const;
+  bool Get(BlockHash const &hash, BlockPtr &block) const;
+  bool GetHeader(BlockHash const &hash, BlockPtr &block) const;
+  void Add(BlockPtr const &block);
+  void Set(BlockPtr const &block);
+  bool Restore(BlockPtr const &block);
+  bool Erase(BlockHash const &hash);
+  void MarkPersisted(BlockHash const &hash);
+  /// @}
+
+  /// @name Iteration
+  /// @{
+  template <typename Visitor>
+  void ForEach(Visitor &&visitor) const;
+  /// @}
+
+  /// @name Statistics
+  /// @{
+  std::size_t size() const;
+  std::size_t size_in_bytes() const;
+  std::size_t max_bytes() const;
+  /// @}
+
+  static BlockPtr    CreateHeader(Block const &block);
+  static std::size_t CalculateBodySize(Block const &block);
+
+  // Operators
+  BlockCache &operator=(BlockCache const &) = delete;
+  BlockCache &operator=(BlockCache &&) = delete;
+
+private:
+  using Mutex = mutex::Mutex;
+
+  struct Entry
+  {
+    BlockPtr     block;             ///< The complete block or only its header (if evicted)
+    std::size_t  body_size{0};      ///< The size of the body (or zero if evicted)
+    bool         persisted{false};  ///< Flag to signal the body can be evicted
+    mutable bool referenced{true};  ///< The CLOCK reference bit
+  };
+
+  using EntryMap   = std::unordered_map<BlockHash, Entry>;
+  using HashList   = std::vector<BlockHash>;
+  using AtomicSize = std::atomic<std::size_t>;
+
+  struct Shard
+  {
+    mutable Mutex lock{__LINE__, __FILE__};
+    EntryMap      entries;  ///< The blocks of the shard
+    HashList      clock;    ///< The hashes of the blocks whose bodies can be evicted
+    std::size_t   hand{0};  ///< The current position of the CLOCK hand
+  };
+
+  using Shards = std::array<Shard, NUM_SHARDS>;
+
+  Shard &      LookupShard(BlockHash const &hash);
+  Shard const &LookupShard(BlockHash const &hash) const;
+  void         Insert(BlockPtr const &block, bool replace);
+  void         Release(Entry &entry);
+  void         EvictIfRequired();
+  std::size_t  EvictFromShard(Shard &shard, std::size_t target);
+
+  static std::size_t HeaderSize();
+
+  std::size_t const max_bytes_;                     ///< The byte budget for the cache
+  AtomicSize        total_bytes_{0};                ///< The current (estimated) size of the cache
+  AtomicSize        num_blocks_{0};                 ///< The number of blocks in the cache
+  Mutex             evict_lock_{__LINE__, __FILE__};  ///< Serialises evictions
+  std::size_t       evict_shard_{0};                ///< The next shard to be evicted from
+  Shards            shards_;                        ///< The shards of the cache
+};
+
+/**
+ * Visit every block in the cache. The visitor is called with each shard locked and so must not
+ * call back into the cache.
+ *
+ * @tparam Visitor The type of the visitor
+ * @param visitor The visitor to be called with each (possibly header only) block and a flag to
+ * signal if the block has been persisted
+ */
+template <typename Visitor>
+void BlockCache::ForEach(Visitor &&visitor) const
+{
+  for (auto const &shard : shards_)
+  {
+    FETCH_LOCK(shard.lock);
+
+    for (auto const &element : shard.entries)
+    {
+      visitor(element.second.block, element.second.persisted);
+    }
+  }
+}
+
+inline std::size_t BlockCache::size() const
+{
+  return num_blocks_;
+}
+
+inline std::size_t BlockCache::size_in_bytes() const
+{
+  return total_bytes_;
+}
+
+inline std::size_t BlockCache::max_bytes() const
+{
+  return max_bytes_;
+}
+
+}  // namespace ledger
+}  // namespace fetch
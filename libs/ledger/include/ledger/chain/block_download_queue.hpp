@@ -0,0 +1,101 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/chain/block.hpp"
+#include "ledger/chain/block_header.hpp"
+#include "ledger/chain/digest.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Schedules the download of the bodies of a validated section of chain
+ *
+ * The headers are split into windows of consecutive blocks which can be requested from different
+ * peers in parallel. Blocks may arrive in any order, each one is checked against its header and
+ * then buffered until all of the blocks preceding it have arrived, so that the blocks are always
+ * released in chain order. Windows which fail, or are only partially served, are returned to the
+ * queue to be requested again.
+ */
+class BlockDownloadQueue
+{
+public:
+  using Headers     = std::vector<BlockHeader>;
+  using Blocks      = std::vector<Block>;
+  using BlockHashes = std::vector<Digest>;
+  using WindowId    = uint64_t;
+
+  static constexpr std::size_t DEFAULT_WINDOW_SIZE = 128;
+  static constexpr std::size_t DEFAULT_LOOKAHEAD   = 2048;
+
+  // Construction / Destruction
+  explicit BlockDownloadQueue(Headers headers, std::size_t window_size = DEFAULT_WINDOW_SIZE,
+                              std::size_t lookahead = DEFAULT_LOOKAHEAD);
+  BlockDownloadQueue(BlockDownloadQueue const &) = delete;
+  BlockDownloadQueue(BlockDownloadQueue &&)      = delete;
+  ~BlockDownloadQueue()                          = default;
+
+  /// @name Scheduling
+  /// @{
+  bool   Assign(WindowId &id, BlockHashes &hashes);
+  void   Complete(WindowId id, Blocks &blocks);
+  void   Fail(WindowId id);
+  Blocks PopReady();
+  /// @}
+
+  /// @name Status
+  /// @{
+  bool        IsComplete() const;
+  std::size_t GetRemainingCount() const;
+  std::size_t GetInFlightCount() const;
+  /// @}
+
+  // Operators
+  BlockDownloadQueue &operator=(BlockDownloadQueue const &) = delete;
+  BlockDownloadQueue &operator=(BlockDownloadQueue &&) = delete;
+
+private:
+  using Indices   = std::vector<std::size_t>;
+  using Windows   = std::deque<Indices>;
+  using InFlight  = std::unordered_map<WindowId, Indices>;
+  using IndexMap  = DigestMap<std::size_t>;
+  using Received  = std::vector<bool>;
+  using BlockSlot = std::vector<Block>;
+
+  void Requeue(Indices window);
+
+  std::size_t const lookahead_;          ///< The max distance of a window from the next block
+  Headers           headers_;            ///< The headers to be downloaded (oldest first)
+  IndexMap          index_;              ///< The index of each header by block hash
+  BlockSlot         blocks_;             ///< The blocks which have been received
+  Received          received_;           ///< Flags for the blocks which have been received
+  Windows           pending_;            ///< The windows waiting to be requested
+  InFlight          in_flight_;          ///< The windows which have been requested
+  WindowId          next_window_id_{1};  ///< The identifier of the next window to be requested
+  std::size_t       next_block_{0};      ///< The index of the next block to be released
+};
+
+}  // namespace ledger
+}  // namespace fetch
@@ -0,0 +1,84 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/chain/block.hpp"
+#include "ledger/chain/digest.hpp"
+#include "ledger/chain/transaction_layout_rpc_serializers.hpp"
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * The header of a block, which is used to validate the chain before the block bodies are fetched
+ *
+ * The contents of the slices are replaced by the merkle root of the transactions, which is
+ * sufficient to recompute the hash of the block and check its proof.
+ */
+class BlockHeader
+{
+public:
+  // Construction / Destruction
+  BlockHeader() = default;
+  explicit BlockHeader(Block const &block);
+  BlockHeader(BlockHeader const &) = default;
+  BlockHeader(BlockHeader &&)      = default;
+  ~BlockHeader()                   = default;
+
+  /// @name Header Contents
+  /// @{
+  Block  header;            ///< The block with its slices removed
+  Digest transaction_root;  ///< The merkle root of the transactions in the block
+  /// @}
+
+  // Helper functions
+  void UpdateDigest();
+
+  // Operators
+  BlockHeader &operator=(BlockHeader const &) = default;
+  BlockHeader &operator=(BlockHeader &&) = default;
+};
+
+/**
+ * Serializer for the block header
+ *
+ * @tparam T The serializer type
+ * @param serializer The reference to the serializer
+ * @param header The reference to the block header to be serialised
+ */
+template <typename T>
+inline void Serialize(T &serializer, BlockHeader const &header)
+{
+  serializer << header.header << header.transaction_root;
+}
+
+/**
+ * Deserializer for the block header
+ *
+ * @tparam T The serializer type
+ * @param serializer The reference to the serializer
+ * @param header The reference to the output block header to be populated
+ */
+template <typename T>
+inline void Deserialize(T &serializer, BlockHeader &header)
+{
+  serializer >> header.header >> header.transaction_root;
+}
+
+}  // namespace ledger
+}  // namespace fetch
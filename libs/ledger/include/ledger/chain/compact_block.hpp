@@ -0,0 +1,122 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/chain/block.hpp"
+#include "ledger/chain/digest.hpp"
+#include "ledger/chain/transaction_layout.hpp"
+#include "ledger/chain/transaction_layout_rpc_serializers.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fetch {
+namespace ledger {
+
+class TransactionLayoutCache;
+
+/**
+ * The compact form of a block which is relayed to the other nodes on the network
+ *
+ * The transaction layouts in each slice of the block are replaced by short transaction IDs, a
+ * keyed hash of the transaction digest. The key is derived from the block hash and a random salt
+ * chosen by the sender, so that transactions can not be crafted to collide with each other. The
+ * receiving node rebuilds the block from the layouts of the transactions that it has recently
+ * seen, and only fetches the layouts it is missing from the sender.
+ */
+class CompactBlock
+{
+public:
+  using ShortId  = uint64_t;
+  using ShortIds = std::vector<ShortId>;
+  using Slices   = std::vector<ShortIds>;
+  using Indices  = std::vector<uint64_t>;
+  using Layouts  = std::vector<TransactionLayout>;
+
+  /// The number of cached layouts scanned per transaction in the block
+  static constexpr std::size_t SCAN_FACTOR = 4u;
+  /// The minimum number of cached layouts scanned for any block
+  static constexpr std::size_t MIN_SCAN_LENGTH = 1u << 14u;
+
+  // Construction / Destruction
+  CompactBlock() = default;
+  CompactBlock(Block const &block, uint64_t salt);
+  CompactBlock(CompactBlock const &) = default;
+  CompactBlock(CompactBlock &&)      = default;
+  ~CompactBlock()                    = default;
+
+  /// @name Block Contents
+  /// @{
+  Block    header;   ///< The block with the contents of its slices removed
+  uint64_t salt{0};  ///< The salt used to derive the key for the short IDs
+  Slices   slices;   ///< The short IDs of the transactions in each slice
+  /// @}
+
+  /// @name Reconstruction
+  /// @{
+  bool Reconstruct(TransactionLayoutCache const &cache, Block &block, Indices &missing) const;
+  bool Complete(Block &block, Indices const &missing, Layouts const &layouts) const;
+  /// @}
+
+  // Helper functions
+  std::size_t GetTransactionCount() const;
+  ShortId     ComputeShortId(Digest const &digest) const;
+  void        UpdateKey();
+
+  // Operators
+  CompactBlock &operator=(CompactBlock const &) = default;
+  CompactBlock &operator=(CompactBlock &&) = default;
+
+private:
+  using Key = std::array<uint64_t, 2>;
+
+  Key key_{};  ///< The key for the short IDs, derived from the block hash and the salt
+};
+
+/**
+ * Serializer for the compact block
+ *
+ * @tparam T The serializer type
+ * @param serializer The reference to the serializer
+ * @param block The reference to the compact block to be serialised
+ */
+template <typename T>
+inline void Serialize(T &serializer, CompactBlock const &block)
+{
+  serializer << block.header << block.salt << block.slices;
+}
+
+/**
+ * Deserializer for the compact block
+ *
+ * @tparam T The serializer type
+ * @param serializer The reference to the serializer
+ * @param block The reference to the output compact block to be populated
+ */
+template <typename T>
+inline void Deserialize(T &serializer, CompactBlock &block)
+{
+  serializer >> block.header >> block.salt >> block.slices;
+
+  block.UpdateKey();
+}
+
+}  // namespace ledger
+}  // namespace fetch
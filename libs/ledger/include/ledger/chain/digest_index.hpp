@@ -0,0 +1,121 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/mutex.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/chain/digest.hpp"
+#include "storage/object_store.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Index of the blocks in which each transaction digest has been included
+ *
+ * The index is used to detect duplicate transactions without scanning the bodies of the blocks of
+ * the chain. Since the index records every block which has been added, including those on forks,
+ * each lookup returns all the locations of a digest and it is up to the caller to determine which
+ * of them are on the chain of interest.
+ *
+ * The locations are held in an object store when the chain is persistent (otherwise in memory) and
+ * are fronted by an in memory Bloom filter, so that the digests which have never been seen (the
+ * common case when packing a block) can be rejected without consulting the store.
+ */
+class DigestIndex
+{
+public:
+  struct Location
+  {
+    uint64_t block_number{0};  ///< The number of the block containing the transaction
+    Digest   block_hash{};     ///< The hash of the block containing the transaction
+  };
+
+  using Locations   = std::vector<Location>;
+  using LocationMap = DigestMap<Locations>;
+
+  static constexpr std::size_t DEFAULT_FILTER_BITS = 1u << 24u;
+  static constexpr std::size_t NUM_FILTER_HASHES   = 4;
+
+  // Construction / Destruction
+  explicit DigestIndex(std::size_t filter_bits = DEFAULT_FILTER_BITS);
+  DigestIndex(DigestIndex const &) = delete;
+  DigestIndex(DigestIndex &&)      = delete;
+  ~DigestIndex()                   = default;
+
+  /// @name Persistence
+  /// @{
+  void New(std::string const &doc_file, std::string const &index_file);
+  void Load(std::string const &doc_file, std::string const &index_file);
+  void Flush();
+  /// @}
+
+  /// @name Index Management
+  /// @{
+  void Add(Block const &block);
+  void AddToFilter(Block const &block);
+  /// @}
+
+  /// @name Queries
+  /// @{
+  LocationMap Lookup(DigestSet const &digests) const;
+  std::size_t size() const;
+  /// @}
+
+  // Operators
+  DigestIndex &operator=(DigestIndex const &) = delete;
+  DigestIndex &operator=(DigestIndex &&) = delete;
+
+private:
+  using Mutex    = mutex::Mutex;
+  using Store    = storage::ObjectStore<Locations>;
+  using StorePtr = std::unique_ptr<Store>;
+  using Filter   = std::vector<uint64_t>;
+
+  void SetFilter(Digest const &digest);
+  bool TestFilter(Digest const &digest) const;
+  bool LookupLocations(Digest const &digest, Locations &locations) const;
+  void SetLocations(Digest const &digest, Locations const &locations);
+
+  mutable Mutex lock_{__LINE__, __FILE__};
+  std::size_t   filter_bits_;  ///< The number of bits in the filter (a power of 2)
+  Filter        filter_;       ///< The Bloom filter of all the digests in the index
+  StorePtr      store_;        ///< The persistent locations (when the chain is persistent)
+  LocationMap   locations_;    ///< The in memory locations (when the chain is not persistent)
+};
+
+template <typename T>
+void Serialize(T &serializer, DigestIndex::Location const &location)
+{
+  serializer << location.block_number << location.block_hash;
+}
+
+template <typename T>
+void Deserialize(T &serializer, DigestIndex::Location &location)
+{
+  serializer >> location.block_number >> location.block_hash;
+}
+
+}  // namespace ledger
+}  // namespace fetch
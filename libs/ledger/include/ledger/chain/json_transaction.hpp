@@ -21,11 +21,15 @@ namespace fetch {
 namespace variant {
 class Variant;
 }
+namespace json {
+class OnDemandValue;
+}
 namespace ledger {
 
 class Transaction;
 
 bool FromJsonTransaction(variant::Variant const &src, Transaction &dst);
+bool FromJsonTransaction(json::OnDemandValue const &src, Transaction &dst);
 bool ToJsonTransaction(Transaction const &src, variant::Variant &dst,
                        bool include_metadata = false);
 
@@ -22,9 +22,11 @@
 #include "core/mutex.hpp"
 #include "crypto/fnv.hpp"
 #include "ledger/chain/block.hpp"
+#include "ledger/chain/block_cache.hpp"
 #include "ledger/chain/consensus/proof_of_work.hpp"
 #include "ledger/chain/constants.hpp"
 #include "ledger/chain/digest.hpp"
+#include "ledger/chain/digest_index.hpp"
 #include "ledger/chain/transaction_layout.hpp"
 #include "network/generics/milli_timer.hpp"
 #include "storage/object_store.hpp"
@@ -33,7 +35,9 @@
 #include <fstream>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
+#include <shared_mutex>
 #include <unordered_set>
 
 namespace fetch {
@@ -51,6 +55,14 @@ namespace ledger {
  *
  * Loose blocks are blocks where the previous hash/block isn't found.
  * Tips keep track of all non loose chains.
+ *
+ * Recent blocks are kept in a memory bounded block cache. Once blocks have been written to the
+ * block store their bodies can be evicted from the cache, while their headers remain in memory.
+ * The chain queries only require a shared (reader) lock, and therefore run concurrently with each
+ * other, while modifications to the chain require the exclusive (writer) lock.
+ *
+ * The transactions of every block added to the chain are recorded in a digest index, so that
+ * duplicate transactions can be detected without scanning the bodies of the blocks of the chain.
  */
 struct Tip
 {
@@ -82,8 +94,9 @@ public:
   using BlockHashSet         = std::unordered_set<BlockHash>;
   using TransactionLayoutSet = std::unordered_set<TransactionLayout>;
 
-  static constexpr char const *LOGGING_NAME = "MainChain";
-  static constexpr uint64_t    UPPER_BOUND  = 100000ull;
+  static constexpr char const *LOGGING_NAME       = "MainChain";
+  static constexpr uint64_t    UPPER_BOUND        = 100000ull;
+  static constexpr std::size_t DEFAULT_CACHE_SIZE = BlockCache::DEFAULT_MAX_BYTES;
 
   enum class Mode
   {
@@ -102,7 +115,7 @@ public:
   };
 
   // Construction / Destruction
-  explicit MainChain(Mode mode = Mode::IN_MEMORY_DB);
+  explicit MainChain(Mode mode = Mode::IN_MEMORY_DB, std::size_t cache_size = DEFAULT_CACHE_SIZE);
   MainChain(MainChain const &rhs) = delete;
   MainChain(MainChain &&rhs)      = delete;
   ~MainChain();
@@ -131,6 +144,11 @@ public:
   bool         ReindexTips();  // testing only
   /// @}
 
+  /// @name Block Cache
+  /// @{
+  BlockCache const &block_cache() const;
+  /// @}
+
   /// @name Missing / Loose Management
   /// @{
   BlockHashSet GetMissingTips() const;
@@ -149,16 +167,55 @@ public:
   MainChain &operator=(MainChain &&rhs) = delete;
 
 private:
-  using IntBlockPtr   = std::shared_ptr<Block>;
-  using BlockMap      = std::unordered_map<BlockHash, IntBlockPtr>;
-  using Proof         = Block::Proof;
-  using TipsMap       = std::unordered_map<BlockHash, Tip>;
-  using BlockHashList = std::list<BlockHash>;
-  using LooseBlockMap = std::unordered_map<BlockHash, BlockHashList>;
-  using BlockStore    = fetch::storage::ObjectStore<Block>;
-  using BlockStorePtr = std::unique_ptr<BlockStore>;
-  using RMutex        = std::recursive_mutex;
-  using RLock         = std::unique_lock<RMutex>;
+  using IntBlockPtr    = std::shared_ptr<Block>;
+  using Proof          = Block::Proof;
+  using TipsMap        = std::unordered_map<BlockHash, Tip>;
+  using BlockHashList  = std::list<BlockHash>;
+  using LooseBlockMap  = std::unordered_map<BlockHash, BlockHashList>;
+  using BlockStore     = fetch::storage::ObjectStore<Block>;
+  using BlockStorePtr  = std::unique_ptr<BlockStore>;
+  using HeightStore    = fetch::storage::ObjectStore<BlockHash>;
+  using HeightStorePtr = std::unique_ptr<HeightStore>;
+
+  /**
+   * Reader / writer lock which gives precedence to the writers. Readers must pass through the gate
+   * (which is held by writers for their duration) so that a steady stream of chain queries can not
+   * starve the addition of new blocks. The shared lock is not recursive.
+   */
+  class RWMutex
+  {
+  public:
+    void lock()
+    {
+      gate_.lock();
+      mutex_.lock();
+    }
+
+    void unlock()
+    {
+      mutex_.unlock();
+      gate_.unlock();
+    }
+
+    void lock_shared()
+    {
+      {
+        std::lock_guard<std::mutex> guard{gate_};
+      }
+      mutex_.lock_shared();
+    }
+
+    void unlock_shared()
+    {
+      mutex_.unlock_shared();
+    }
+
+  private:
+    std::mutex              gate_;
+    std::shared_timed_mutex mutex_;
+  };
+
+  using ReadLock = std::shared_lock<RWMutex>;
 
   struct HeaviestTip
   {
@@ -174,6 +231,9 @@ private:
   void WriteToFile();
   void TrimCache();
   void FlushBlock(IntBlockPtr const &block);
+  void PersistBlock(IntBlockPtr const &block);
+  bool IsOnPersistedChain(Block const &block) const;
+  bool IsOnPersistedChain(uint64_t block_number, BlockHash const &hash) const;
   /// @}
 
   /// @name Loose Blocks
@@ -188,8 +248,10 @@ private:
   bool        LookupBlock(BlockHash hash, IntBlockPtr &block, bool add_to_cache = false) const;
   bool        LookupBlockFromCache(BlockHash hash, IntBlockPtr &block) const;
   bool        LookupBlockFromStorage(BlockHash hash, IntBlockPtr &block, bool add_to_cache) const;
+  bool        LookupHeader(BlockHash hash, IntBlockPtr &block) const;
   bool        IsBlockInCache(BlockHash hash) const;
   void        AddBlockToCache(IntBlockPtr const &) const;
+  Blocks      WalkChain(BlockHash start, uint64_t limit) const;
   /// @}
 
   /// @name Tip Management
@@ -197,6 +259,7 @@ private:
   bool AddTip(IntBlockPtr const &block);
   bool UpdateTips(IntBlockPtr const &block);
   bool DetermineHeaviestTip();
+  bool RebuildTips();
   /// @}
 
   static IntBlockPtr CreateGenesisBlock();
@@ -204,15 +267,22 @@ private:
   BlockHash GetHeadHash();
   void      SetHeadHash(BlockHash const &hash);
 
-  BlockStorePtr block_store_;  /// < Long term storage and backup
-  std::fstream  head_store_;
+  BlockStorePtr  block_store_;   /// < Long term storage and backup
+  HeightStorePtr height_store_;  ///< The hashes of the persisted chain, by block number
+  std::fstream   head_store_;
 
-  mutable RMutex   lock_;          ///< Mutex protecting block_chain_, tips_ & heaviest_
-  mutable BlockMap block_chain_;   ///< All recent blocks are kept in memory
-  TipsMap          tips_;          ///< Keep track of the tips
-  HeaviestTip      heaviest_;      ///< Heaviest block/tip
-  LooseBlockMap    loose_blocks_;  ///< Waiting (loose) blocks
+  mutable RWMutex    lock_;          ///< Mutex protecting the chain structure & heaviest_
+  mutable BlockCache block_chain_;   ///< Recent blocks (and older block headers) kept in memory
+  TipsMap            tips_;          ///< Keep track of the tips
+  HeaviestTip        heaviest_;      ///< Heaviest block/tip
+  LooseBlockMap      loose_blocks_;  ///< Waiting (loose) blocks
+  DigestIndex        digest_index_;  ///< The blocks containing each transaction
 };
 
+inline BlockCache const &MainChain::block_cache() const
+{
+  return block_chain_;
+}
+
 }  // namespace ledger
 }  // namespace fetch
@@ -20,6 +20,7 @@
 #include "core/bitvector.hpp"
 #include "core/byte_array/const_byte_array.hpp"
 #include "crypto/identity.hpp"
+#include "crypto/public_key_cache.hpp"
 #include "ledger/chain/address.hpp"
 #include "ledger/chain/digest.hpp"
 
@@ -130,6 +131,7 @@ public:
   /// @name Validation / Verification
   /// @{
   bool Verify();
+  bool Verify(crypto::PublicKeyCache &key_cache);
   bool IsVerified() const;
   bool IsSignedByFromAddress() const;
   /// @}
@@ -164,6 +166,8 @@ private:
   bool   verified_{false};                ///< The cached result of the verification
   /// @}
 
+  bool Verify(crypto::PublicKeyCache *key_cache);
+
   // There are only two ways to generate a transaction, each from one of the two companion classes:
   friend class TransactionBuilder;
   friend class TransactionSerializer;
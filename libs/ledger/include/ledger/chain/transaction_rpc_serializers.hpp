@@ -18,9 +18,15 @@
 //------------------------------------------------------------------------------
 
 #include "core/byte_array/const_byte_array.hpp"
+#include "core/serializers/byte_array.hpp"
 #include "ledger/chain/transaction.hpp"
 #include "ledger/chain/transaction_serializer.hpp"
 
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
 namespace fetch {
 namespace ledger {
 
@@ -45,5 +51,54 @@ void Deserialize(T &s, Transaction &tx)
   serializer >> tx;
 }
 
+namespace detail {
+
+/**
+ * The serialized data of a transaction. Since it is read in the same way as a transaction (and
+ * neither type is registered with typed serializers) it can be extracted in place of one.
+ */
+struct TransactionData
+{
+  byte_array::ConstByteArray data;
+};
+
+template <typename T>
+void Deserialize(T &s, TransactionData &element)
+{
+  s >> element.data;
+}
+
+}  // namespace detail
+
+/**
+ * Deserialize a list of transactions. The wire format is identical to the generic list case,
+ * however the digests of the transactions are computed as a single batch.
+ */
+template <typename T>
+void Deserialize(T &s, std::vector<Transaction> &txs)
+{
+  uint64_t count{0};
+  s.ReadBytes(reinterpret_cast<uint8_t *>(&count), sizeof(uint64_t));
+
+  // extract the data for each of the transactions
+  std::vector<detail::TransactionData> elements(count);
+  for (auto &element : elements)
+  {
+    s >> element;
+  }
+
+  std::vector<byte_array::ConstByteArray> data;
+  data.reserve(elements.size());
+  for (auto &element : elements)
+  {
+    data.emplace_back(std::move(element.data));
+  }
+
+  if (!TransactionSerializer::DeserializeBatch(data, txs))
+  {
+    throw std::runtime_error("Unable to deserialize transaction from input stream");
+  }
+}
+
 }  // namespace ledger
 }  // namespace fetch
\ No newline at end of file
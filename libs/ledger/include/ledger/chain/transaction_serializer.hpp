@@ -19,6 +19,8 @@
 
 #include "core/byte_array/byte_array.hpp"
 
+#include <vector>
+
 namespace fetch {
 namespace ledger {
 
@@ -32,8 +34,10 @@ class Transaction;
 class TransactionSerializer
 {
 public:
-  using ConstByteArray = byte_array::ConstByteArray;
-  using ByteArray      = byte_array::ByteArray;
+  using ConstByteArray     = byte_array::ConstByteArray;
+  using ByteArray          = byte_array::ByteArray;
+  using ConstByteArrayList = std::vector<ConstByteArray>;
+  using TransactionList    = std::vector<Transaction>;
 
   static constexpr char const *LOGGING_NAME = "TxSerializer";
 
@@ -57,6 +61,8 @@ public:
   bool Serialize(Transaction const &tx);
   bool Deserialize(Transaction &tx) const;
 
+  static bool DeserializeBatch(ConstByteArrayList const &data, TransactionList &txs);
+
   // Operators (throw on error)
   TransactionSerializer &operator<<(Transaction const &tx);
   TransactionSerializer &operator>>(Transaction &tx);
@@ -67,6 +73,9 @@ public:
   TransactionSerializer &operator=(TransactionSerializer &&) = delete;
 
 private:
+  static bool DecodeTransaction(ConstByteArray const &data, Transaction &tx,
+                                ConstByteArray &payload);
+
   ConstByteArray serial_data_;
 };
 
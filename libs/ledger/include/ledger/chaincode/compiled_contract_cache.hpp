@@ -0,0 +1,162 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/mutex.hpp"
+#include "crypto/fnv.hpp"  // needed for std::hash<ConstByteArray>
+
+#include <atomic>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace fetch {
+
+namespace vm {
+struct Executable;
+class Module;
+}  // namespace vm
+
+namespace storage {
+template <typename T, std::size_t S>
+class ObjectStore;
+}  // namespace storage
+
+namespace ledger {
+
+/**
+ * Bounded, thread safe cache of compiled smart contract executables
+ *
+ * Compiling a smart contract requires the complete tokeniser / parser / analyser / generator
+ * pipeline to be run. Since a contract is immutable once it has been deployed, the compiled
+ * executable is keyed by the digest of the contract source and shared (read only) between all the
+ * contract instances across all executors and lanes in the process.
+ *
+ * An executable refers to types and module functions by their index in the tables of the module
+ * that it was compiled against. Therefore the key also includes a fingerprint of those tables, so
+ * that an executable is never reused with a module that has changed.
+ *
+ * The in memory entries are kept in LRU order. Optionally the cache can be backed by an on disk
+ * store of serialised executables which allows a restarted node to avoid recompiling contracts.
+ */
+class CompiledContractCache
+{
+public:
+  using ConstByteArray = byte_array::ConstByteArray;
+  using Executable     = vm::Executable;
+  using ExecutablePtr  = std::shared_ptr<Executable const>;
+  using Module         = vm::Module;
+
+  static constexpr std::size_t DEFAULT_CAPACITY = 512;
+
+  // Process wide instance
+  static CompiledContractCache &Instance();
+
+  // Module Fingerprint
+  static ConstByteArray GenerateModuleFingerprint(Module &module);
+
+  // Construction / Destruction
+  explicit CompiledContractCache(std::size_t capacity = DEFAULT_CAPACITY);
+  CompiledContractCache(CompiledContractCache const &) = delete;
+  CompiledContractCache(CompiledContractCache &&)      = delete;
+  ~CompiledContractCache();
+
+  /// @name Disk Store
+  /// @{
+  void AttachDiskStore(std::string const &doc_file, std::string const &index_file,
+                       bool create = true);
+  void DetachDiskStore();
+  bool has_disk_store() const;
+  /// @}
+
+  /// @name Executable Access
+  /// @{
+  ExecutablePtr Lookup(ConstByteArray const &digest, ConstByteArray const &module_fingerprint);
+  void          Insert(ConstByteArray const &digest, ConstByteArray const &module_fingerprint,
+                       ExecutablePtr executable);
+  void          Clear();
+  /// @}
+
+  /// @name Statistics
+  /// @{
+  std::size_t capacity() const;
+  std::size_t size() const;
+  std::size_t hit_count() const;
+  std::size_t disk_hit_count() const;
+  std::size_t miss_count() const;
+  /// @}
+
+  // Operators
+  CompiledContractCache &operator=(CompiledContractCache const &) = delete;
+  CompiledContractCache &operator=(CompiledContractCache &&) = delete;
+
+private:
+  using Mutex        = mutex::Mutex;
+  using DiskStore    = storage::ObjectStore<Executable, 2048>;
+  using DiskStorePtr = std::shared_ptr<DiskStore>;
+
+  struct Entry
+  {
+    ConstByteArray key;
+    ExecutablePtr  executable;
+  };
+
+  using EntryList = std::list<Entry>;
+  using EntryMap  = std::unordered_map<ConstByteArray, EntryList::iterator>;
+  using Counter   = std::atomic<std::size_t>;
+
+  void          InsertInMemory(ConstByteArray const &key, ExecutablePtr const &executable);
+  ExecutablePtr LoadFromDisk(DiskStore &store, ConstByteArray const &digest,
+                             ConstByteArray const &module_fingerprint);
+  DiskStorePtr  disk_store() const;
+
+  std::size_t const capacity_;
+  mutable Mutex     lock_{__LINE__, __FILE__};
+  EntryList         entries_;     ///< The cached entries, most recently used first
+  EntryMap          index_;       ///< The index from contract and module key to entry
+  DiskStorePtr      disk_store_;  ///< The (optional) persistent store of executables
+  Counter           hit_count_{0};
+  Counter           disk_hit_count_{0};
+  Counter           miss_count_{0};
+};
+
+inline std::size_t CompiledContractCache::capacity() const
+{
+  return capacity_;
+}
+
+inline std::size_t CompiledContractCache::hit_count() const
+{
+  return hit_count_;
+}
+
+inline std::size_t CompiledContractCache::disk_hit_count() const
+{
+  return disk_hit_count_;
+}
+
+inline std::size_t CompiledContractCache::miss_count() const
+{
+  return miss_count_;
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -44,7 +44,7 @@ class SmartContract : public Contract
 public:
   using ConstByteArray = byte_array::ConstByteArray;
   using Executable     = fetch::vm::Executable;
-  using ExecutablePtr  = std::shared_ptr<Executable>;
+  using ExecutablePtr  = std::shared_ptr<Executable const>;
 
   static constexpr char const *LOGGING_NAME = "SmartContract";
 
@@ -57,7 +57,7 @@ public:
     return digest_;
   }
 
-  ExecutablePtr executable()
+  ExecutablePtr executable() const
   {
     return executable_;
   }
@@ -73,7 +73,7 @@ private:
   BlockIndex     block_index_{};  ///< The index current contract's block
   std::string    source_;         ///< The source of the current contract
   ConstByteArray digest_;         ///< The digest of the current contract
-  ExecutablePtr  executable_;     ///< The internal script object of the parsed source
+  ExecutablePtr  executable_;     ///< The (shared) compiled executable of the source
   ModulePtr      module_;         ///< The internal module instance for the contract
   std::string    init_fn_name_;
 };
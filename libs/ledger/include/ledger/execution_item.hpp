@@ -32,10 +32,11 @@ namespace ledger {
 class ExecutionItem
 {
 public:
-  using LaneIndex  = uint32_t;
-  using BlockIndex = ExecutorInterface::BlockIndex;
-  using SliceIndex = ExecutorInterface::SliceIndex;
-  using Status     = ExecutorInterface::Status;
+  using LaneIndex       = uint32_t;
+  using BlockIndex      = ExecutorInterface::BlockIndex;
+  using SliceIndex      = ExecutorInterface::SliceIndex;
+  using Status          = ExecutorInterface::Status;
+  using StateChangesPtr = ExecutorInterface::StateChangesPtr;
 
   static constexpr char const *LOGGING_NAME = "ExecutionItem";
 
@@ -47,13 +48,15 @@ public:
 
   /// @name Accessors
   /// @{
-  Digest const &   digest() const;
-  BitVector const &shards() const;
-  Status           status() const;
-  uint64_t         fee() const;
+  Digest const &         digest() const;
+  BitVector const &      shards() const;
+  Status                 status() const;
+  uint64_t               fee() const;
+  StateChangesPtr const &changes() const;
   /// @}
 
   void Execute(ExecutorInterface &executor);
+  void ExecuteSpeculatively(ExecutorInterface &executor);
 
   // Operators
   ExecutionItem &operator=(ExecutionItem const &) = delete;
@@ -63,12 +66,13 @@ private:
   using AtomicStatus = std::atomic<Status>;
   using AtomicFee    = std::atomic<uint64_t>;
 
-  Digest       digest_;
-  BlockIndex   block_{0};
-  SliceIndex   slice_{0};
-  BitVector    shards_;
-  AtomicStatus status_{Status::NOT_RUN};
-  AtomicFee    fee_{0};
+  Digest          digest_;
+  BlockIndex      block_{0};
+  SliceIndex      slice_{0};
+  BitVector       shards_;
+  AtomicStatus    status_{Status::NOT_RUN};
+  AtomicFee       fee_{0};
+  StateChangesPtr changes_{};  ///< The buffered changes of the last speculative execution
 };
 
 inline ExecutionItem::ExecutionItem(Digest digest, BlockIndex block, SliceIndex slice,
@@ -99,6 +103,11 @@ inline uint64_t ExecutionItem::fee() const
   return fee_;
 }
 
+inline ExecutionItem::StateChangesPtr const &ExecutionItem::changes() const
+{
+  return changes_;
+}
+
 inline void ExecutionItem::Execute(ExecutorInterface &executor)
 {
   try
@@ -117,5 +126,28 @@ inline void ExecutionItem::Execute(ExecutorInterface &executor)
   }
 }
 
+inline void ExecutionItem::ExecuteSpeculatively(ExecutorInterface &executor)
+{
+  // any previous (speculative) execution is superseded
+  changes_.reset();
+
+  try
+  {
+    auto const result = executor.ExecuteSpeculatively(digest_, block_, slice_, shards_, changes_);
+
+    // update the internal results
+    status_ = result.status;
+    fee_    = result.fee;
+  }
+  catch (std::exception const &ex)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Exception thrown while executing transaction: ", ex.what());
+
+    changes_.reset();
+    status_ = Status::RESOURCE_FAILURE;
+    fee_    = 0;
+  }
+}
+
 }  // namespace ledger
 }  // namespace fetch
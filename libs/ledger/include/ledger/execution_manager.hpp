@@ -33,6 +33,7 @@
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <deque>
 #include <future>
 #include <memory>
 #include <thread>
@@ -54,9 +55,17 @@ public:
   using ExecutorPtr     = std::shared_ptr<ExecutorInterface>;
   using ExecutorFactory = std::function<ExecutorPtr()>;
 
+  enum class SchedulingMode
+  {
+    SLICE_ORDER,     ///< The block is executed strictly one slice at a time
+    CONFLICT_GRAPH,  ///< Transactions are executed as soon as all the lanes they use are free
+    OPTIMISTIC,      ///< Transactions are executed speculatively and validated in block order
+  };
+
   // Construction / Destruction
   ExecutionManager(std::size_t num_executors, uint32_t log2_num_lanes, StorageUnitPtr storage,
-                   ExecutorFactory const &factory);
+                   ExecutorFactory const &factory,
+                   SchedulingMode scheduling_mode = SchedulingMode::SLICE_ORDER);
 
   /// @name Execution Manager Interface
   /// @{
@@ -77,6 +86,16 @@ public:
     return completed_executions_;
   }
 
+  std::size_t num_reexecutions() const
+  {
+    return num_reexecutions_;
+  }
+
+  SchedulingMode scheduling_mode() const
+  {
+    return scheduling_mode_;
+  }
+
 private:
   struct Counters
   {
@@ -90,6 +109,21 @@ private:
   using ThreadPool        = fetch::network::ThreadPool;
   using Mutex             = std::mutex;
   using Counter           = std::atomic<std::size_t>;
+  using NodeIndex         = std::size_t;
+  using NodeIndexList     = std::vector<NodeIndex>;
+
+  /**
+   * A node in the conflict graph of a block. The edges of the graph point from each transaction to
+   * the later transactions (in slice order) which make use of at least one of the same lanes.
+   */
+  struct ExecutionNode
+  {
+    ExecutionItem *item{nullptr};
+    NodeIndexList  dependants{};  ///< The nodes that can only be executed after this one
+    Counter        pending{0};    ///< The number of the nodes this one is waiting on
+  };
+
+  using ExecutionGraph = std::deque<ExecutionNode>;
   using Flag              = std::atomic<bool>;
   using StateHash         = StorageUnitInterface::Hash;
   using ExecutorList      = std::vector<ExecutorPtr>;
@@ -102,7 +136,8 @@ private:
   using SyncCounters      = SynchronisedState<Counters>;
   using SyncedState       = SynchronisedState<State>;
 
-  uint32_t const log2_num_lanes_;
+  uint32_t const       log2_num_lanes_;
+  SchedulingMode const scheduling_mode_;
 
   Flag running_{false};
   Flag monitor_ready_{false};
@@ -111,8 +146,10 @@ private:
 
   StorageUnitPtr storage_;
 
-  Mutex         execution_plan_lock_;  ///< guards `execution_plan_`
-  ExecutionPlan execution_plan_;
+  Mutex          execution_plan_lock_;  ///< guards `execution_plan_` and `execution_graph_`
+  ExecutionPlan  execution_plan_;
+  ExecutionGraph execution_graph_;      ///< Only populated in conflict graph mode
+  Flag           execution_halted_{false};
 
   Digest  last_block_hash_ = GENESIS_DIGEST;
   Address last_block_miner_{};
@@ -126,6 +163,7 @@ private:
 
   Counter completed_executions_{0};
   Counter num_slices_{0};
+  Counter num_reexecutions_{0};
 
   SyncCounters counters_{};
 
@@ -135,7 +173,14 @@ private:
   void MonitorThreadEntrypoint();
 
   bool PlanExecution(Block::Body const &block);
+  void BuildExecutionGraph();
+  void ExecuteItem(ExecutionItem &item, bool speculative = false);
   void DispatchExecution(ExecutionItem &item);
+  void DispatchGraphExecution(NodeIndex index);
+  void DispatchSpeculativeExecution(ExecutionItem &item);
+  bool CommitSpeculativeExecutions();
+  bool ApplySpeculativeExecutions(ExecutorInterface *executor);
+  void ReleaseBlockResources();
 };
 
 }  // namespace ledger
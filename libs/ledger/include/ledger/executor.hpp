@@ -17,12 +17,14 @@
 //
 //------------------------------------------------------------------------------
 
+#include "core/memory/arena.hpp"
 #include "crypto/fnv.hpp"
 #include "ledger/chain/block.hpp"
 #include "ledger/chaincode/chain_code_cache.hpp"
 #include "ledger/executor_interface.hpp"
 #include "ledger/storage_unit/storage_unit_interface.hpp"
 
+#include <memory>
 #include <unordered_set>
 #include <vector>
 
@@ -52,22 +54,33 @@ public:
   Result Execute(Digest const &digest, BlockIndex block, SliceIndex slice,
                  BitVector const &shards) override;
   void   SettleFees(Address const &miner, TokenAmount amount, uint32_t log2_num_lanes) override;
+  Result ExecuteSpeculatively(Digest const &digest, BlockIndex block, SliceIndex slice,
+                              BitVector const &shards, StateChangesPtr &changes) override;
+  void   ReleaseBlockResources() override;
   /// @}
 
 private:
   using TokenContractPtr        = std::shared_ptr<TokenContract>;
   using TransactionPtr          = std::shared_ptr<Transaction>;
   using CachedStorageAdapterPtr = std::shared_ptr<CachedStorageAdapter>;
+  using ArenaPtr                = std::shared_ptr<core::Arena>;
+  using ArenaList               = std::vector<ArenaPtr>;
 
-  bool RetrieveTransaction(Digest const &digest);
-  bool ValidationChecks(Result &result);
-  bool ExecuteTransactionContract(Result &result);
-  bool ProcessTransfers(Result &result);
-  void DeductFees(Result &result);
-  bool Cleanup();
+  Result Run(Digest const &digest, BlockIndex block, SliceIndex slice, BitVector const &shards,
+             bool speculative);
+  bool   RetrieveTransaction(Digest const &digest);
+  bool   ValidationChecks(Result &result);
+  bool   ExecuteTransactionContract(Result &result);
+  bool   ProcessTransfers(Result &result);
+  void   DeductFees(Result &result);
+  bool   Cleanup();
 
   /// @name Resources
   /// @{
+  // The arenas are declared first so that they are destroyed last, since the chain code instances
+  // and the execution state can hold objects allocated from them
+  ArenaPtr         arena_;           ///< The arena for the state created while executing the block
+  ArenaList        retired_arenas_;  ///< The replaced arenas whose allocations are still live
   StorageUnitPtr   storage_;             ///< The collection of resources
   ChainCodeCache   chain_code_cache_{};  //< The factory to create new chain code instances
   TokenContractPtr token_contract_;
@@ -19,6 +19,9 @@
 
 #include "ledger/chain/digest.hpp"
 
+#include <memory>
+#include <stdexcept>
+
 namespace fetch {
 
 class BitVector;
@@ -26,14 +29,16 @@ class BitVector;
 namespace ledger {
 
 class Address;
+class CachedStorageAdapter;
 
 class ExecutorInterface
 {
 public:
-  using BlockIndex  = uint64_t;
-  using SliceIndex  = uint64_t;
-  using LaneIndex   = uint32_t;
-  using TokenAmount = uint64_t;
+  using BlockIndex      = uint64_t;
+  using SliceIndex      = uint64_t;
+  using LaneIndex       = uint32_t;
+  using TokenAmount     = uint64_t;
+  using StateChangesPtr = std::shared_ptr<CachedStorageAdapter>;
 
   enum class Status
   {
@@ -74,8 +79,46 @@ public:
                          BitVector const &shards)                                              = 0;
   virtual void   SettleFees(Address const &miner, TokenAmount amount, uint32_t log2_num_lanes) = 0;
   /// @}
+
+  /// @name Speculative Execution
+  /// @{
+  virtual Result ExecuteSpeculatively(Digest const &digest, BlockIndex block, SliceIndex slice,
+                                      BitVector const &shards, StateChangesPtr &changes);
+  /// @}
+
+  /// @name Resource Management
+  /// @{
+  virtual void ReleaseBlockResources();
+  /// @}
 };
 
+/**
+ * Executes a given transaction without applying the changes to the state database. Instead the
+ * changes (along with the set of keys which have been read) are returned to the caller, who is
+ * responsible for validating and flushing them. Executors do not support this by default.
+ *
+ * @param digest The transaction digest to be executed
+ * @param block The current block index
+ * @param slice The current slice index
+ * @param shards The bit vector outlining the shards in use by this transaction
+ * @param changes The output buffered changes of the execution
+ * @return The status code for the operation
+ */
+inline ExecutorInterface::Result ExecutorInterface::ExecuteSpeculatively(Digest const &, BlockIndex,
+                                                                         SliceIndex,
+                                                                         BitVector const &,
+                                                                         StateChangesPtr &)
+{
+  throw std::runtime_error("Speculative execution is not supported by this executor");
+}
+
+/**
+ * Signal to the executor that the execution of the current block has finished and that any state
+ * retained for it can be recycled. Executors do not retain any such state by default.
+ */
+inline void ExecutorInterface::ReleaseBlockResources()
+{}
+
 inline char const *ToString(ExecutorInterface::Status status)
 {
   char const *text = "Unknown";
@@ -19,30 +19,49 @@
 
 #include "core/serializers/stl_types.hpp"
 #include "core/service_ids.hpp"
+#include "ledger/chain/block_header.hpp"
 #include "ledger/chain/main_chain.hpp"
+#include "ledger/chain/transaction_layout_rpc_serializers.hpp"
 #include "network/service/protocol.hpp"
 
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
 namespace fetch {
 namespace ledger {
 
 class MainChainProtocol : public service::Protocol
 {
 public:
-  using Blocks = std::vector<Block>;
+  using Blocks      = std::vector<Block>;
+  using Headers     = std::vector<BlockHeader>;
+  using BlockHashes = std::vector<Digest>;
+  using Indices     = std::vector<uint64_t>;
+  using Layouts     = std::vector<TransactionLayout>;
 
   enum
   {
-    HEAVIEST_CHAIN   = 1,
-    CHAIN_PRECEDING  = 2,
-    COMMON_SUB_CHAIN = 3
+    HEAVIEST_CHAIN     = 1,
+    CHAIN_PRECEDING    = 2,
+    COMMON_SUB_CHAIN   = 3,
+    BLOCK_TRANSACTIONS = 4,
+    HEADERS_PRECEDING  = 5,
+    BLOCKS             = 6
   };
 
+  /// The maximum number of blocks which will be returned from a single BLOCKS request
+  static constexpr std::size_t MAX_BLOCKS_REQUEST_SIZE = 256;
+
   explicit MainChainProtocol(MainChain &chain)
     : chain_(chain)
   {
     Expose(HEAVIEST_CHAIN, this, &MainChainProtocol::GetHeaviestChain);
     Expose(CHAIN_PRECEDING, this, &MainChainProtocol::GetChainPreceding);
     Expose(COMMON_SUB_CHAIN, this, &MainChainProtocol::GetCommonSubChain);
+    Expose(BLOCK_TRANSACTIONS, this, &MainChainProtocol::GetBlockTransactions);
+    Expose(HEADERS_PRECEDING, this, &MainChainProtocol::GetHeadersPreceding);
+    Expose(BLOCKS, this, &MainChainProtocol::GetBlocks);
   }
 
 private:
@@ -73,6 +92,108 @@ private:
     return Copy(blocks);
   }
 
+  /**
+   * Lookup the layouts of the specified transactions in a block, used to complete compact blocks
+   *
+   * @param hash The hash of the block
+   * @param indices The indices (across all slices) of the transactions
+   * @return The layouts of the transactions, or an empty list if the block or any of the indices
+   * are unknown
+   */
+  Layouts GetBlockTransactions(Digest const &hash, Indices const &indices)
+  {
+    LOG_STACK_TRACE_POINT;
+
+    Layouts layouts{};
+
+    auto const block = chain_.GetBlock(hash);
+    if (block)
+    {
+      std::vector<TransactionLayout const *> entries;
+      entries.reserve(block->GetTransactionCount());
+
+      for (auto const &slice : block->body.slices)
+      {
+        for (auto const &layout : slice)
+        {
+          entries.push_back(&layout);
+        }
+      }
+
+      layouts.reserve(indices.size());
+      for (auto const index : indices)
+      {
+        if (index >= entries.size())
+        {
+          layouts.clear();
+          break;
+        }
+
+        layouts.push_back(*entries[index]);
+      }
+    }
+
+    return layouts;
+  }
+
+  /**
+   * Lookup the headers of the chain preceding (and including) the specified block
+   *
+   * @param at The hash of the first block, or empty for the heaviest block
+   * @param maxsize The maximum number of headers to be returned
+   * @return The headers (from heaviest to lightest), or an empty list if the block is unknown
+   */
+  Headers GetHeadersPreceding(Digest const &at, uint32_t maxsize)
+  {
+    LOG_STACK_TRACE_POINT;
+
+    Digest const start = at.empty() ? chain_.GetHeaviestBlockHash() : at;
+
+    Headers headers{};
+    if (chain_.GetBlock(start))
+    {
+      auto const blocks = chain_.GetChainPreceding(start, maxsize);
+
+      headers.reserve(blocks.size());
+      for (auto const &block : blocks)
+      {
+        headers.emplace_back(*block);
+      }
+    }
+
+    return headers;
+  }
+
+  /**
+   * Lookup the specified blocks, used to download block bodies once the headers are known
+   *
+   * @param hashes The hashes of the blocks
+   * @return The blocks which are known, in the order they were requested
+   */
+  Blocks GetBlocks(BlockHashes const &hashes)
+  {
+    LOG_STACK_TRACE_POINT;
+
+    Blocks blocks{};
+    blocks.reserve(hashes.size());
+
+    for (auto const &hash : hashes)
+    {
+      if (blocks.size() >= MAX_BLOCKS_REQUEST_SIZE)
+      {
+        break;
+      }
+
+      auto const block = chain_.GetBlock(hash);
+      if (block)
+      {
+        blocks.emplace_back(*block);
+      }
+    }
+
+    return blocks;
+  }
+
   static Blocks Copy(MainChain::Blocks const &blocks)
   {
     Blocks output{};
@@ -21,6 +21,10 @@
 #include "core/mutex.hpp"
 #include "core/random/lcg.hpp"
 #include "core/state_machine.hpp"
+#include "ledger/chain/block_download_queue.hpp"
+#include "ledger/chain/block_header.hpp"
+#include "ledger/chain/compact_block.hpp"
+#include "ledger/chain/digest.hpp"
 #include "ledger/chain/main_chain.hpp"
 #include "ledger/protocols/main_chain_rpc_protocol.hpp"
 #include "network/generics/backgrounded_work.hpp"
@@ -31,7 +35,9 @@
 #include "network/muddle/subscription.hpp"
 #include "network/p2pservice/p2ptrust_interface.hpp"
 
+#include <cstddef>
 #include <memory>
+#include <vector>
 
 namespace fetch {
 namespace ledger {
@@ -39,6 +45,7 @@ namespace ledger {
 class BlockCoordinator;
 class MainChain;
 class MainChainSyncWorker;
+class TransactionLayoutCache;
 
 class MainChainRpcService : public muddle::rpc::Server,
                             public std::enable_shared_from_this<MainChainRpcService>
@@ -46,6 +53,9 @@ class MainChainRpcService : public muddle::rpc::Server,
 public:
   enum class State
   {
+    REQUEST_HEADERS,
+    WAIT_FOR_HEADERS,
+    DOWNLOADING_BLOCKS,
     REQUEST_HEAVIEST_CHAIN,
     WAIT_FOR_HEAVIEST_CHAIN,
     SYNCHRONISING,
@@ -55,6 +65,7 @@ public:
 
   using MuddleEndpoint  = muddle::MuddleEndpoint;
   using MainChain       = ledger::MainChain;
+  using LayoutCache     = ledger::TransactionLayoutCache;
   using Subscription    = muddle::Subscription;
   using SubscriptionPtr = std::shared_ptr<Subscription>;
   using Address         = muddle::Packet::Address;
@@ -67,6 +78,18 @@ public:
 
   static constexpr char const *LOGGING_NAME = "MainChainRpc";
 
+  /// The time after which an incomplete compact block is abandoned
+  static constexpr uint64_t COMPACT_BLOCK_TIMEOUT_MS = 30000;
+
+  /// The time after which a request for a window of blocks is given to another peer
+  static constexpr uint64_t BLOCK_REQUEST_TIMEOUT_MS = 5000;
+
+  /// The time for which a peer is not sent requests after failing to serve a window of blocks
+  static constexpr uint64_t SLOW_PEER_BACKOFF_MS = 10000;
+
+  /// The maximum number of windows of blocks requested from a single peer at the same time
+  static constexpr std::size_t MAX_BLOCK_REQUESTS_PER_PEER = 2;
+
   enum class Mode
   {
     STANDALONE,       ///< Single instance network
@@ -74,8 +97,15 @@ public:
     PUBLIC_NETWORK,   ///< Network restricted to public miners
   };
 
+  enum class SyncMode
+  {
+    HEAVIEST_CHAIN,  ///< Request the heaviest chain from a single peer at a time
+    HEADERS_FIRST,   ///< Validate the headers, then download the blocks from all peers in parallel
+  };
+
   // Construction / Destruction
-  MainChainRpcService(MuddleEndpoint &endpoint, MainChain &chain, TrustSystem &trust, Mode mode);
+  MainChainRpcService(MuddleEndpoint &endpoint, MainChain &chain, LayoutCache &layout_cache,
+                      TrustSystem &trust, Mode mode, SyncMode sync_mode = SyncMode::HEADERS_FIRST);
   MainChainRpcService(MainChainRpcService const &) = delete;
   MainChainRpcService(MainChainRpcService &&)      = delete;
   ~MainChainRpcService() override                  = default;
@@ -108,12 +138,59 @@ public:
 
 private:
   using BlockList       = fetch::ledger::MainChainProtocol::Blocks;
+  using LayoutList      = fetch::ledger::MainChainProtocol::Layouts;
   using StateMachine    = core::StateMachine<State>;
   using StateMachinePtr = std::shared_ptr<StateMachine>;
+  using Mutex           = mutex::Mutex;
+  using RNG             = random::LinearCongruentialGenerator;
+
+  /**
+   * A compact block whose missing transactions are being requested from the sender, or for which
+   * the full block is being requested when it could not be completed
+   */
+  struct PendingBlock
+  {
+    CompactBlock          compact;      ///< The compact block as received
+    Block                 block;        ///< The partially reconstructed block
+    CompactBlock::Indices missing;      ///< The indices of the missing transactions
+    Address               from;         ///< The sender of the compact block
+    Address               transmitter;  ///< The peer which relayed the compact block
+    Promise               request;      ///< The request in flight to the sender
+    FutureTimepoint       deadline;     ///< The time after which the block is abandoned
+    bool                  full{false};  ///< Whether the full block has been requested
+  };
+
+  using PendingBlocks = DigestMap<PendingBlock>;
+
+  /**
+   * A request for a window of blocks made to one of the peers during header first synchronisation
+   */
+  struct BlockRequest
+  {
+    BlockDownloadQueue::WindowId window{0};  ///< The window of blocks which has been requested
+    Address                      peer;       ///< The peer serving the request
+    Promise                      request;    ///< The request in flight to the peer
+    FutureTimepoint              deadline;   ///< The time after which the request is abandoned
+  };
+
+  using HeaderList       = fetch::ledger::MainChainProtocol::Headers;
+  using BlockRequests    = std::vector<BlockRequest>;
+  using PeerTimeouts     = DigestMap<FutureTimepoint>;
+  using DownloadQueuePtr = std::unique_ptr<BlockDownloadQueue>;
 
   /// @name Subscription Handlers
   /// @{
   void OnNewBlock(Address const &from, Block &block, Address const &transmitter);
+  void OnNewCompactBlock(Address const &from, CompactBlock const &compact,
+                         Address const &transmitter);
+  /// @}
+
+  /// @name Compact Block Reconstruction
+  /// @{
+  void RequestMissingTransactions(BlockHash const &hash, PendingBlock &pending);
+  void RequestFullBlock(BlockHash const &hash, PendingBlock &pending);
+  void OnPendingBlockResponse(BlockHash const &hash, bool success);
+  void WatchPendingBlock(BlockHash const &hash, Promise const &request);
   /// @}
 
   /// @name Utilities
@@ -124,8 +201,21 @@ private:
   bool               IsBlockValid(Block &block) const;
   /// @}
 
+  /// @name Header First Synchronisation
+  /// @{
+  State HandleHeadersResponse(HeaderList header_list);
+  void  UpdateBlockRequests();
+  bool  AddDownloadedBlocks();
+  void  RequestBlocks();
+  void  ResetDownload();
+  void  WakeOnResponse(Promise const &request);
+  /// @}
+
   /// @name State Machine Handlers
   /// @{
+  State OnRequestHeaders();
+  State OnWaitForHeaders();
+  State OnDownloadingBlocks();
   State OnRequestHeaviestChain();
   State OnWaitForHeaviestChain();
   State OnSynchronising();
@@ -136,17 +226,27 @@ private:
   /// @name System Components
   /// @{
   Mode const      mode_;
+  SyncMode const  sync_mode_;
   MuddleEndpoint &endpoint_;
   MainChain &     chain_;
+  LayoutCache &   layout_cache_;
   TrustSystem &   trust_;
   /// @}
 
   /// @name RPC Server
   /// @{
   SubscriptionPtr   block_subscription_;
+  SubscriptionPtr   compact_block_subscription_;
   MainChainProtocol main_chain_protocol_;
   /// @}
 
+  /// @name Compact Block Data
+  /// @{
+  RNG           salt_generator_;  ///< The source of the salts for the compact blocks
+  mutable Mutex pending_lock_{__LINE__, __FILE__};
+  PendingBlocks pending_blocks_;  ///< The compact blocks which are waiting to be completed
+  /// @}
+
   /// @name State Machine Data
   /// @{
   RpcClient       rpc_client_;
@@ -155,6 +255,16 @@ private:
   BlockHash       current_missing_block_;
   Promise         current_request_;
   /// @}
+
+  /// @name Header First Synchronisation Data
+  /// @{
+  BlockHash        header_cursor_;    ///< The next block for which the headers are requested
+  FutureTimepoint  header_deadline_;  ///< The time after which the header request is abandoned
+  HeaderList       sync_headers_;     ///< The validated headers (from heaviest to lightest)
+  DownloadQueuePtr download_queue_;   ///< The schedule of the blocks to be downloaded
+  BlockRequests    block_requests_;   ///< The requests for windows of blocks which are in flight
+  PeerTimeouts     slow_peers_;       ///< The peers which are not sent requests until a timeout
+  /// @}
 };
 
 }  // namespace ledger
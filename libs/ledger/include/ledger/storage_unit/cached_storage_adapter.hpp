@@ -17,11 +17,15 @@
 //
 //------------------------------------------------------------------------------
 
+#include "core/memory/arena.hpp"
 #include "core/mutex.hpp"
 #include "ledger/storage_unit/storage_unit_interface.hpp"
 
 #include <atomic>
+#include <functional>
+#include <memory>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace fetch {
 namespace ledger {
@@ -29,18 +33,36 @@ namespace ledger {
 /**
  * Designed for temporary caching of values to reduce hits to the underlying storage engine.
  *
- * Initially intended in conjuction with the smart contract engine
+ * Initially intended in conjuction with the smart contract engine. The adapter also records the
+ * set of keys read from the underlying storage engine and the set of keys written, which allows
+ * speculative executions to be validated against each other.
+ *
+ * The book keeping of the adapter can optionally be allocated from an arena, which is shared with
+ * the adapter so that it remains valid for the lifetime of the adapter.
  */
 class CachedStorageAdapter : public StorageInterface
 {
 public:
+  using ArenaPtr = std::shared_ptr<core::Arena>;
+  using KeySet   = std::unordered_set<ResourceAddress, std::hash<ResourceAddress>,
+                                    std::equal_to<ResourceAddress>,
+                                    core::ArenaAllocator<ResourceAddress>>;
+
   // Construction / Destruction
-  explicit CachedStorageAdapter(StorageInterface &storage);
+  explicit CachedStorageAdapter(StorageInterface &storage, bool speculative = false,
+                                ArenaPtr arena = ArenaPtr{});
   ~CachedStorageAdapter();
 
   void Flush();
   void Clear();
 
+  /// @name Access Tracking
+  /// @{
+  bool          speculative() const;
+  KeySet const &read_set() const;
+  KeySet const &write_set() const;
+  /// @}
+
   /// @name State Interface
   /// @{
   Document Get(ResourceAddress const &key) override;
@@ -62,7 +84,9 @@ private:
     {}
   };
 
-  using Cache = std::unordered_map<ResourceAddress, CacheEntry>;
+  using CacheAllocator = core::ArenaAllocator<std::pair<ResourceAddress const, CacheEntry>>;
+  using Cache = std::unordered_map<ResourceAddress, CacheEntry, std::hash<ResourceAddress>,
+                                   std::equal_to<ResourceAddress>, CacheAllocator>;
   using Mutex = mutex::Mutex;
 
   /// @name Cache Helpers
@@ -72,15 +96,46 @@ private:
   bool       HasCacheEntry(ResourceAddress const &address) const;
   /// @}
 
-  StorageInterface &storage_;  ///< The reference to the underlying storage engine
+  ArenaPtr          arena_;        ///< The (optional) arena the book keeping is allocated from
+  StorageInterface &storage_;      ///< The reference to the underlying storage engine
+  bool const        speculative_;  ///< Lane locking is deferred to when the cache is flushed
 
   /// @name Cache Data
   /// @{
   mutable Mutex lock_{__LINE__, __FILE__};
-  Cache         cache_{};                ///< The local cache
+  Cache         cache_;                  ///< The local cache
   bool          flush_required_{false};  ///< Top level cache flush flag
+  KeySet        read_keys_;              ///< The keys read from the underlying storage engine
+  KeySet        write_keys_;             ///< The keys written to the cache
   /// @}
 };
 
+inline bool CachedStorageAdapter::speculative() const
+{
+  return speculative_;
+}
+
+/**
+ * Get the set of keys that have been read from the underlying storage engine. Should only be
+ * accessed once the execution using the cache has completed.
+ *
+ * @return The set of keys
+ */
+inline CachedStorageAdapter::KeySet const &CachedStorageAdapter::read_set() const
+{
+  return read_keys_;
+}
+
+/**
+ * Get the set of keys that have been written to the cache (and not cleared). Should only be
+ * accessed once the execution using the cache has completed.
+ *
+ * @return The set of keys
+ */
+inline CachedStorageAdapter::KeySet const &CachedStorageAdapter::write_set() const
+{
+  return write_keys_;
+}
+
 }  // namespace ledger
 }  // namespace fetch
@@ -21,6 +21,7 @@
 #include "core/logger.hpp"
 #include "core/serializers/typed_byte_array_buffer.hpp"
 #include "core/service_ids.hpp"
+#include "crypto/incremental_merkle_tree.hpp"
 #include "crypto/merkle_tree.hpp"
 #include "ledger/shard_config.hpp"
 #include "ledger/storage_unit/lane_connectivity_details.hpp"
@@ -50,6 +51,7 @@ class StorageUnitClient final : public StorageUnitInterface
 public:
   using MuddleEndpoint = muddle::MuddleEndpoint;
   using Address        = MuddleEndpoint::Address;
+  using MerkleProof    = crypto::IncrementalMerkleTree::Proof;
 
   static constexpr char const *LOGGING_NAME = "StorageUnitClient";
 
@@ -60,7 +62,8 @@ public:
   ~StorageUnitClient() override                = default;
 
   // Helpers
-  uint32_t num_lanes() const;
+  uint32_t    num_lanes() const;
+  MerkleProof GenerateLaneProof(ShardIndex lane) const;
 
   /// @name Storage Unit Interface
   /// @{
@@ -98,7 +101,7 @@ private:
       std::memset(this, -1, sizeof(*this));
     }
 
-    explicit MerkleTreeBlock(crypto::MerkleTree const &tree)
+    explicit MerkleTreeBlock(crypto::IncrementalMerkleTree const &tree)
     {
       serializers::TypedByteArrayBuffer buff;
       buff << tree;
@@ -141,6 +144,7 @@ private:
   using LaneIndex            = LaneIdentity::lane_type;
   using AddressList          = std::vector<MuddleEndpoint::Address>;
   using MerkleTree           = crypto::MerkleTree;
+  using StateMerkleTree      = crypto::IncrementalMerkleTree;
   using PermanentMerkleStack = storage::RandomAccessStack<MerkleTreeBlock>;
   using Mutex                = fetch::mutex::Mutex;
 
@@ -161,7 +165,8 @@ private:
   /// @name State Hash Support
   /// @{
   mutable Mutex        merkle_mutex_{__LINE__, __FILE__};
-  MerkleTree           current_merkle_;
+  StateMerkleTree      working_merkle_;  ///< The lane roots reported by the last CurrentHash()
+  StateMerkleTree      current_merkle_;  ///< The lane roots of the last commit (or revert)
   PermanentMerkleStack permanent_state_merkle_stack_{};
   /// @}
 };
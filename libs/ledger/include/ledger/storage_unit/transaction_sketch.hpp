@@ -0,0 +1,148 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Compact sketch of a set of transaction digests (an Invertible Bloom Lookup Table)
+ *
+ * Every digest is added to one cell in each of the NUM_HASHES partitions of the sketch. Each cell
+ * records the number of digests which have been added to it, the XOR of those digests and the XOR
+ * of their checksums. Subtracting the sketch of one set from the sketch of another cancels out all
+ * the digests which the two sets have in common, and the remaining digests (the symmetric
+ * difference) can then be recovered by repeatedly peeling off the cells which hold a single digest.
+ *
+ * The size of a sketch is proportional to the size of the difference which it is able to decode,
+ * not to the size of the set, which makes it suitable for reconciling the transactions held by two
+ * peers which are mostly in sync.
+ */
+class TransactionSketch
+{
+public:
+  using Digest  = byte_array::ConstByteArray;
+  using Digests = std::vector<Digest>;
+  using KeySum  = std::array<uint64_t, 4>;
+
+  struct Cell
+  {
+    int64_t  count{0};     ///< The number of digests (added minus subtracted) in the cell
+    KeySum   key_sum{};    ///< The XOR of the digests in the cell
+    uint64_t hash_sum{0};  ///< The XOR of the checksums of the digests in the cell
+  };
+
+  using Cells = std::vector<Cell>;
+
+  static constexpr std::size_t DIGEST_SIZE = sizeof(KeySum);
+  static constexpr std::size_t NUM_HASHES  = 4;
+
+  // Construction / Destruction
+  TransactionSketch() = default;
+  explicit TransactionSketch(std::size_t num_cells);
+  explicit TransactionSketch(Cells cells);
+  TransactionSketch(TransactionSketch const &) = default;
+  TransactionSketch(TransactionSketch &&)      = default;
+  ~TransactionSketch()                         = default;
+
+  static std::size_t CellsFor(std::size_t difference);
+
+  /// @name Sketch Operations
+  /// @{
+  void Add(Digest const &digest);
+  bool Subtract(TransactionSketch const &other);
+  bool Decode(Digests &only_in_this, Digests &only_in_other) const;
+  /// @}
+
+  /// @name Accessors
+  /// @{
+  std::size_t  num_cells() const;
+  int64_t      count() const;
+  Cells const &cells() const;
+  /// @}
+
+  // Operators
+  TransactionSketch &operator=(TransactionSketch const &) = default;
+  TransactionSketch &operator=(TransactionSketch &&) = default;
+
+private:
+  using Indices = std::array<std::size_t, NUM_HASHES>;
+
+  Indices CalculateIndices(KeySum const &key) const;
+  void    Update(KeySum const &key, int64_t count, Cells &cells) const;
+
+  Cells cells_;
+};
+
+/**
+ * Get the number of cells in the sketch
+ *
+ * @return The number of cells
+ */
+inline std::size_t TransactionSketch::num_cells() const
+{
+  return cells_.size();
+}
+
+/**
+ * Get the cells of the sketch
+ *
+ * @return The cells
+ */
+inline TransactionSketch::Cells const &TransactionSketch::cells() const
+{
+  return cells_;
+}
+
+template <typename T>
+void Serialize(T &serializer, TransactionSketch::Cell const &cell)
+{
+  serializer << cell.count << cell.key_sum << cell.hash_sum;
+}
+
+template <typename T>
+void Deserialize(T &serializer, TransactionSketch::Cell &cell)
+{
+  serializer >> cell.count >> cell.key_sum >> cell.hash_sum;
+}
+
+template <typename T>
+void Serialize(T &serializer, TransactionSketch const &sketch)
+{
+  serializer << sketch.cells();
+}
+
+template <typename T>
+void Deserialize(T &serializer, TransactionSketch &sketch)
+{
+  TransactionSketch::Cells cells;
+  serializer >> cells;
+
+  sketch = TransactionSketch{std::move(cells)};
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -21,6 +21,7 @@
 #include "ledger/chain/transaction.hpp"
 #include "ledger/storage_unit/lane_connectivity_details.hpp"
 #include "ledger/storage_unit/transaction_sinks.hpp"
+#include "ledger/storage_unit/transaction_sketch.hpp"
 #include "ledger/transaction_verifier.hpp"
 #include "metrics/metrics.hpp"
 #include "network/details/thread_pool.hpp"
@@ -49,7 +50,8 @@ public:
     OBJECT_COUNT          = 1,
     PULL_OBJECTS          = 2,
     PULL_SUBTREE          = 3,
-    PULL_SPECIFIC_OBJECTS = 4
+    PULL_SPECIFIC_OBJECTS = 4,
+    PULL_SKETCH           = 5
   };
 
   using ObjectStore = storage::TransientObjectStore<Transaction>;
@@ -72,6 +74,9 @@ public:
 private:
   static constexpr uint64_t PULL_LIMIT_ = 10000;  // Limit the amount a single rpc call will provide
 
+  // Limit the size of a sketch which can be requested by a peer
+  static constexpr uint64_t MAX_SKETCH_CELLS_ = 1u << 16u;
+
   struct CachedObject
   {
     using Clock      = std::chrono::system_clock;
@@ -97,6 +102,9 @@ private:
   TxArray PullSubtree(byte_array::ConstByteArray const &rid, uint64_t mask);
   TxArray PullSpecificObjects(std::vector<storage::ResourceID> const &rids);
 
+  TransactionSketch PullSketch(byte_array::ConstByteArray const &rid, uint64_t bit_count,
+                               uint64_t num_cells);
+
   ObjectStore *store_;  ///< The pointer to the object store
 
   mutex::Mutex cache_mutex_{__LINE__, __FILE__};  ///< The mutex protecting cache_
@@ -22,6 +22,7 @@
 #include "core/state_machine.hpp"
 #include "ledger/storage_unit/lane_controller.hpp"
 #include "ledger/storage_unit/transaction_sinks.hpp"
+#include "ledger/storage_unit/transaction_sketch.hpp"
 #include "ledger/transaction_verifier.hpp"
 #include "network/generics/promise_of.hpp"
 #include "network/generics/requesting_queue.hpp"
@@ -32,6 +33,7 @@
 #include "transaction_store_sync_protocol.hpp"
 
 #include <algorithm>
+#include <queue>
 #include <unordered_map>
 
 namespace fetch {
@@ -43,6 +45,8 @@ enum class State
   INITIAL = 0,
   QUERY_OBJECT_COUNTS,
   RESOLVING_OBJECT_COUNTS,
+  QUERY_SKETCH,
+  RESOLVING_SKETCH,
   QUERY_SUBTREE,
   RESOLVING_SUBTREE,
   QUERY_OBJECTS,
@@ -68,6 +72,8 @@ public:
   using RequestingTxList      = network::RequestingQueueOf<Address, TxArray>;
   using RequestingSubTreeList = network::RequestingQueueOf<uint64_t, TxArray>;
   using PromiseOfTxList       = network::PromiseOf<TxArray>;
+  using RequestingSketchList  = network::RequestingQueueOf<uint64_t, TransactionSketch>;
+  using PromiseOfSketch       = network::PromiseOf<TransactionSketch>;
   using ResourceID            = storage::ResourceID;
   using Mutex                 = mutex::Mutex;
   using EventNewTransaction   = std::function<void(Transaction const &)>;
@@ -82,10 +88,17 @@ public:
   static constexpr std::size_t MAX_OBJECT_COUNT_RESOLUTION_PER_CYCLE = 128;
   static constexpr std::size_t MAX_SUBTREE_RESOLUTION_PER_CYCLE      = 128;
   static constexpr std::size_t MAX_OBJECT_RESOLUTION_PER_CYCLE       = 128;
+  static constexpr std::size_t MAX_SKETCH_RESOLUTION_PER_CYCLE       = 128;
   // Limit the amount to be retrieved at once from the TxFinderProtocol
   static constexpr uint64_t TX_FINDER_PROTO_LIMIT = 1000;
   // Limit the amount a single rpc call will provide
   static constexpr uint64_t PULL_LIMIT = 10000;
+  // The difference which a sketch is sized for, even when the peers hold the same number of txs
+  static constexpr uint64_t MIN_SKETCH_DIFFERENCE = 32;
+  // The difference above which a subtree is split into several sketches
+  static constexpr uint64_t MAX_SKETCH_DIFFERENCE = 1000;
+  // Subtrees are not split beyond the first byte of the digests
+  static constexpr uint64_t MAX_SUBTREE_BITS = 8;
 
   struct Config
   {
@@ -129,17 +142,42 @@ public:
 protected:
   void OnTransaction(TransactionPtr const &tx) override;
 
-  // Reverse bits in byte
-  uint8_t Reverse(uint8_t c)
+private:
+  /**
+   * A subtree of the transactions, all of whose digests start with the same (least significant)
+   * bits of the first byte
+   */
+  struct Subtree
   {
-    // https://graphics.stanford.edu/~seander/bithacks.html#ReverseByteWith64Bits
-    return static_cast<uint8_t>(((c * 0x80200802ULL) & 0x0884422110ULL) * 0x0101010101ULL >> 32);
-  }
+    uint8_t  prefix{0};     ///< The leading bits of the digests in the subtree
+    uint64_t bit_count{0};  ///< The number of leading bits
+    uint64_t num_cells{0};  ///< The size of the sketch used to reconcile the subtree
+
+    uint64_t key() const
+    {
+      return (bit_count << 8u) | prefix;
+    }
+  };
+
+  struct Reconciliation
+  {
+    Subtree subtree;  ///< The subtree being reconciled
+    Address peer;     ///< The peer with which the subtree is being reconciled
+  };
+
+  using SubtreeQueue      = std::queue<Subtree>;
+  using ReconciliationMap = std::unordered_map<uint64_t, Reconciliation>;
+
+  static byte_array::ConstByteArray SubtreePrefix(Subtree const &subtree);
+
+  void QueueSubtrees(uint64_t bit_count, uint64_t num_cells, SubtreeQueue &queue);
+  void ReconcileSubtree(Reconciliation const &reconciliation, TransactionSketch remote_sketch);
 
-private:
   State OnInitial();
   State OnQueryObjectCounts();
   State OnResolvingObjectCounts();
+  State OnQuerySketch();
+  State OnResolvingSketch();
   State OnQuerySubtree();
   State OnResolvingSubtree();
   State OnQueryObjects();
@@ -161,12 +199,18 @@ private:
   RequestingObjectCount pending_object_count_;
   uint64_t              max_object_count_;
 
+  RequestingSketchList  pending_sketches_;
+  RequestingSubTreeList pending_differences_;
   RequestingSubTreeList pending_subtree_;
   RequestingTxList      pending_objects_;
 
-  std::queue<uint8_t>                                          roots_to_sync_;
-  uint64_t                                                     root_size_ = 0;
-  std::unordered_map<PromiseOfTxList::PromiseCounter, uint8_t> promise_id_to_roots_;
+  SubtreeQueue      subtrees_to_reconcile_;  ///< The subtrees waiting for a sketch to be requested
+  ReconciliationMap sketch_requests_;        ///< The reconciliations waiting for a sketch
+  ReconciliationMap difference_requests_;    ///< The reconciliations waiting for the missing txs
+  uint64_t          next_difference_id_{0};
+
+  SubtreeQueue                                                 roots_to_sync_;
+  std::unordered_map<PromiseOfTxList::PromiseCounter, Subtree> promise_id_to_roots_;
 
   Mutex mutex_{__LINE__, __FILE__};
 
@@ -0,0 +1,137 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/chain/digest.hpp"
+#include "ledger/chain/transaction_layout.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <shared_mutex>
+#include <vector>
+
+namespace fetch {
+namespace ledger {
+
+class Transaction;
+
+/**
+ * Cache of the layouts of the transactions which have recently been seen by the node
+ *
+ * The cache is the pool from which compact blocks are reconstructed. It is split into two
+ * generations, when the current generation is full the previous one is discarded, so that the
+ * oldest layouts are evicted without any per entry book keeping.
+ *
+ * The layouts are stored in the order in which they were added, in segments which are never
+ * modified once they have been written. This allows the cache to be scanned (newest first)
+ * without holding the lock, the lock is only taken to snapshot the segments.
+ */
+class TransactionLayoutCache
+{
+public:
+  using Visitor = std::function<void(TransactionLayout const &)>;
+
+  static constexpr std::size_t DEFAULT_CAPACITY = 1u << 18u;
+  static constexpr std::size_t SEGMENT_SIZE     = 1u << 12u;
+
+  // Construction / Destruction
+  explicit TransactionLayoutCache(uint32_t log2_num_lanes,
+                                  std::size_t capacity = DEFAULT_CAPACITY);
+  TransactionLayoutCache(TransactionLayoutCache const &) = delete;
+  TransactionLayoutCache(TransactionLayoutCache &&)      = delete;
+  ~TransactionLayoutCache()                              = default;
+
+  /// @name Cache Interface
+  /// @{
+  void        Add(Transaction const &tx);
+  void        Add(TransactionLayout const &layout);
+  void        Visit(Visitor const &visitor) const;
+  std::size_t size() const;
+
+  template <typename RecentVisitor>
+  void VisitRecent(std::size_t limit, RecentVisitor &&visitor) const;
+  /// @}
+
+  // Operators
+  TransactionLayoutCache &operator=(TransactionLayoutCache const &) = delete;
+  TransactionLayoutCache &operator=(TransactionLayoutCache &&) = delete;
+
+private:
+  using Mutex      = std::shared_timed_mutex;
+  using ReadLock   = std::shared_lock<Mutex>;
+  using WriteLock  = std::unique_lock<Mutex>;
+  using Segment    = std::vector<TransactionLayout>;
+  using SegmentPtr = std::shared_ptr<Segment>;
+
+  /// A written range of a segment, which remains valid while the segment is referenced
+  struct Range
+  {
+    SegmentPtr               segment;
+    TransactionLayout const *begin{nullptr};
+    std::size_t              size{0};
+  };
+
+  using Snapshot = std::vector<Range>;
+
+  struct Generation
+  {
+    DigestSet               digests;
+    std::vector<SegmentPtr> segments;
+  };
+
+  Snapshot TakeSnapshot() const;
+
+  uint32_t const    log2_num_lanes_;
+  std::size_t const generation_size_;  ///< The number of layouts in each generation
+  std::size_t const segment_size_;     ///< The number of layouts in each segment
+
+  mutable Mutex lock_;
+  Generation    current_;   ///< The generation to which new layouts are added
+  Generation    previous_;  ///< The generation which will be evicted next
+};
+
+/**
+ * Visit the most recently added layouts in the cache, newest first
+ *
+ * The cache is not locked while the layouts are being visited, layouts which are added during the
+ * visit are not seen.
+ *
+ * @param limit The maximum number of layouts to visit
+ * @param visitor The function to be called with each layout, returning false to stop the visit
+ */
+template <typename RecentVisitor>
+void TransactionLayoutCache::VisitRecent(std::size_t limit, RecentVisitor &&visitor) const
+{
+  auto const snapshot = TakeSnapshot();
+
+  for (auto it = snapshot.rbegin(); (it != snapshot.rend()) && (limit > 0); ++it)
+  {
+    for (std::size_t i = it->size; (i > 0) && (limit > 0); --i, --limit)
+    {
+      if (!visitor(it->begin[i - 1]))
+      {
+        return;
+      }
+    }
+  }
+}
+
+}  // namespace ledger
+}  // namespace fetch
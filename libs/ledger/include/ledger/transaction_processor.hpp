@@ -30,6 +30,7 @@ namespace ledger {
 class Transaction;
 class StorageUnitInterface;
 class BlockPackerInterface;
+class TransactionLayoutCache;
 class TransactionStatusCache;
 
 class TransactionProcessor : public TransactionSink
@@ -39,6 +40,7 @@ public:
 
   // Construction / Destruction
   TransactionProcessor(StorageUnitInterface &storage, BlockPackerInterface &packer,
+                       TransactionLayoutCache &layout_cache,
                        TransactionStatusCache &tx_status_cache, std::size_t num_threads);
   TransactionProcessor(TransactionProcessor const &) = delete;
   TransactionProcessor(TransactionProcessor &&)      = delete;
@@ -69,6 +71,7 @@ private:
 
   StorageUnitInterface &  storage_;
   BlockPackerInterface &  packer_;
+  TransactionLayoutCache &layout_cache_;
   TransactionStatusCache &status_cache_;
   TransactionVerifier     verifier_;
   ThreadPtr               poll_new_tx_thread_;
@@ -17,12 +17,17 @@
 //
 //------------------------------------------------------------------------------
 
-#include "core/mutex.hpp"
 #include "core/threading/synchronised_state.hpp"
 #include "ledger/chain/digest.hpp"
 
+#include <array>
 #include <chrono>
-#include <unordered_map>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
 
 namespace fetch {
 namespace ledger {
@@ -37,41 +42,86 @@ enum class TransactionStatus
 
 char const *ToString(TransactionStatus status);
 
+/**
+ * Cache of the recent status of transactions
+ *
+ * The cache is split into shards, each with its own reader / writer lock, so that status queries
+ * do not block each other and only contend with updates to the same shard. Entries are expired by
+ * a background thread. Every shard records the digests updated in each time bucket, so expiry only
+ * visits the entries of the buckets which have aged out, and the update path does no pruning.
+ */
 class TransactionStatusCache
 {
 public:
   using Clock     = std::chrono::steady_clock;
   using Timepoint = Clock::time_point;
+  using Digests   = std::vector<Digest>;
+
+  static constexpr std::size_t NUM_SHARDS = 16;
 
   // Construction / Destruction
-  TransactionStatusCache()                               = default;
+  TransactionStatusCache();
   TransactionStatusCache(TransactionStatusCache const &) = delete;
   TransactionStatusCache(TransactionStatusCache &&)      = delete;
-  ~TransactionStatusCache()                              = default;
+  ~TransactionStatusCache();
 
   TransactionStatus Query(Digest digest) const;
   void Update(Digest digest, TransactionStatus status, Timepoint const &now = Clock::now());
+  void Update(Digests const &digests, TransactionStatus status,
+              Timepoint const &now = Clock::now());
+  void Prune(Timepoint const &now = Clock::now());
+
+  std::size_t size() const;
 
   // Operators
   TransactionStatusCache &operator=(TransactionStatusCache const &) = delete;
   TransactionStatusCache &operator=(TransactionStatusCache &&) = delete;
 
 private:
-  using Mutex = mutex::Mutex;
+  using Mutex      = std::shared_timed_mutex;
+  using ReadLock   = std::shared_lock<Mutex>;
+  using StopSignal = SynchronisedState<bool>;
+  using ThreadPtr  = std::unique_ptr<std::thread>;
 
   struct Element
   {
     TransactionStatus status{TransactionStatus::UNKNOWN};
     Timepoint         timestamp{Clock::now()};
+    uint64_t          bucket{0};  ///< The index of the most recent bucket recording the entry
   };
 
   using Cache = DigestMap<Element>;
 
-  void PruneCache(Timepoint const &now);
+  struct Bucket
+  {
+    uint64_t  index;    ///< The index of the bucket in its shard
+    Timepoint start;    ///< The time of the first update in the bucket
+    Timepoint latest;   ///< The time of the most recent update in the bucket
+    Digests   digests;  ///< The digests updated during the bucket
+  };
+
+  using Buckets = std::deque<Bucket>;
+
+  struct Shard
+  {
+    mutable Mutex lock;
+    Cache         cache;           ///< The status of the transactions in the shard
+    Buckets       buckets;         ///< The updates of the shard, oldest first
+    uint64_t      num_buckets{0};  ///< The number of buckets created for the shard
+  };
+
+  using Shards = std::array<Shard, NUM_SHARDS>;
+
+  Shard &      LookupShard(Digest const &digest);
+  Shard const &LookupShard(Digest const &digest) const;
+  void         Insert(Shard &shard, Digest const &digest, TransactionStatus status,
+                      Timepoint const &now);
+  void         PruneShard(Shard &shard, Timepoint const &now);
+  void         ThreadEntryPoint();
 
-  mutable Mutex mtx_{__LINE__, __FILE__};
-  Cache         cache_{};
-  Timepoint     last_clean_{Clock::now()};
+  Shards     shards_{};
+  StopSignal stop_{false};
+  ThreadPtr  thread_{};
 };
 
 }  // namespace ledger
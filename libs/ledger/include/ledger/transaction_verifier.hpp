@@ -18,10 +18,12 @@
 //------------------------------------------------------------------------------
 
 #include "core/containers/queue.hpp"
+#include "crypto/public_key_cache.hpp"
 
 #include <cstddef>
 #include <memory>
 #include <thread>
+#include <vector>
 
 namespace fetch {
 namespace ledger {
@@ -34,14 +36,20 @@ class TransactionVerifier
 public:
   static constexpr char const *LOGGING_NAME = "TxVerifier";
 
-  using TransactionPtr = std::shared_ptr<Transaction>;
+  using TransactionPtr  = std::shared_ptr<Transaction>;
+  using TransactionList = std::vector<TransactionPtr>;
+
+  static constexpr std::size_t DEFAULT_KEY_CACHE_SIZE = crypto::PublicKeyCache::DEFAULT_CAPACITY;
+  static constexpr std::size_t MAX_BATCH_SIZE         = 64;
 
   // Construction / Destruction
   explicit TransactionVerifier(TransactionSink &sink, std::size_t verifying_threads,
-                               std::string name)
+                               std::string name,
+                               std::size_t key_cache_size = DEFAULT_KEY_CACHE_SIZE)
     : verifying_threads_(verifying_threads)
     , name_(std::move(name))
     , sink_(sink)
+    , key_cache_(key_cache_size)
   {}
   TransactionVerifier(TransactionVerifier const &) = delete;
   TransactionVerifier(TransactionVerifier &&)      = delete;
@@ -55,8 +63,15 @@ public:
 
   /// @name Transaction Processing
   /// @{
-  void AddTransaction(TransactionPtr const &tx);
-  void AddTransaction(TransactionPtr &&tx);
+  void        AddTransaction(TransactionPtr const &tx);
+  void        AddTransaction(TransactionPtr &&tx);
+  void        AddTransactions(TransactionList const &txs);
+  std::size_t VerifyBatch(TransactionList &batch);
+  /// @}
+
+  /// @name Public Key Cache
+  /// @{
+  crypto::PublicKeyCache const &key_cache() const;
   /// @}
 
   // Operators
@@ -72,6 +87,7 @@ private:
   using ThreadPtr       = std::unique_ptr<std::thread>;
   using Threads         = std::vector<ThreadPtr>;
   using Sink            = TransactionSink;
+  using KeyCache        = crypto::PublicKeyCache;
 
   void Verifier();
   void Dispatcher();
@@ -79,6 +95,7 @@ private:
   std::size_t const verifying_threads_;
   std::string const name_;
   Sink &            sink_;
+  KeyCache          key_cache_;
   Flag              active_{true};
   Threads           threads_;
   VerifiedQueue     verified_queue_;
@@ -95,5 +112,15 @@ inline void TransactionVerifier::AddTransaction(TransactionPtr &&tx)
   unverified_queue_.Push(std::move(tx));
 }
 
+inline void TransactionVerifier::AddTransactions(TransactionList const &txs)
+{
+  unverified_queue_.PushMany(txs.begin(), txs.end());
+}
+
+inline crypto::PublicKeyCache const &TransactionVerifier::key_cache() const
+{
+  return key_cache_;
+}
+
 }  // namespace ledger
 }  // namespace fetch
@@ -42,9 +42,11 @@ std::size_t Block::GetTransactionCount() const
 }
 
 /**
- * Populate the block hash field based on the contents of the current block
+ * Compute the merkle root of the transactions in the block
+ *
+ * @return The transaction root
  */
-void Block::UpdateDigest()
+Digest Block::GetTransactionRoot() const
 {
   crypto::MerkleTree tx_merkle_tree{GetTransactionCount()};
 
@@ -61,10 +63,52 @@ void Block::UpdateDigest()
   // Calculate the root
   tx_merkle_tree.CalculateRoot();
 
+  return tx_merkle_tree.root();
+}
+
+/**
+ * Create a copy of the header of the block, i.e. the block without its transaction slices
+ *
+ * @return The header only copy of the block
+ */
+Block Block::CopyHeader() const
+{
+  Block header;
+  header.body.hash           = body.hash;
+  header.body.previous_hash  = body.previous_hash;
+  header.body.merkle_hash    = body.merkle_hash;
+  header.body.block_number   = body.block_number;
+  header.body.miner          = body.miner;
+  header.body.log2_num_lanes = body.log2_num_lanes;
+  header.nonce               = nonce;
+  header.proof               = proof;
+  header.weight              = weight;
+  header.total_weight        = total_weight;
+  header.is_loose            = is_loose;
+
+  return header;
+}
+
+/**
+ * Populate the block hash field based on the contents of the current block
+ */
+void Block::UpdateDigest()
+{
+  UpdateDigest(GetTransactionRoot());
+}
+
+/**
+ * Populate the block hash field based on the header fields of the block and the specified merkle
+ * root of its transactions. This allows the hash of a block to be checked without its slices.
+ *
+ * @param transaction_root The merkle root of the transactions in the block
+ */
+void Block::UpdateDigest(Digest const &transaction_root)
+{
   // Generate hash stream
   serializers::ByteArrayBuffer buf;
   buf << body.previous_hash << body.merkle_hash << body.block_number << body.miner
-      << body.log2_num_lanes << tx_merkle_tree.root() << nonce;
+      << body.log2_num_lanes << transaction_root << nonce;
 
   // Generate the hash
   crypto::SHA256 hash;
@@ -0,0 +1,446 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/chain/block_cache.hpp"
+
+#include <functional>
+#include <mutex>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Construct the block cache
+ *
+ * @param max_bytes The (approximate) maximum number of bytes the cache should occupy
+ */
+BlockCache::BlockCache(std::size_t max_bytes)
+  : max_bytes_{max_bytes}
+{}
+
+/**
+ * Determine if a block (or its header) is present in the cache
+ *
+ * @param hash The hash of the block
+ * @return true if present, otherwise false
+ */
+bool BlockCache::Has(BlockHash const &hash) const
+{
+  auto const &shard = LookupShard(hash);
+  FETCH_LOCK(shard.lock);
+
+  return shard.entries.find(hash) != shard.entries.end();
+}
+
+/**
+ * Determine if a complete block is present in the cache
+ *
+ * @param hash The hash of the block
+ * @return true if the block is present and its body has not been evicted, otherwise false
+ */
+bool BlockCache::HasBody(BlockHash const &hash) const
+{
+  auto const &shard = LookupShard(hash);
+  FETCH_LOCK(shard.lock);
+
+  auto const it = shard.entries.find(hash);
+  return (it != shard.entries.end()) && (it->second.body_size > 0);
+}
+
+/**
+ * Determine if a block in the cache has been written to the block store
+ *
+ * @param hash The hash of the block
+ * @return true if the block is present and has been persisted, otherwise false
+ */
+bool BlockCache::IsPersisted(BlockHash const &hash) const
+{
+  auto const &shard = LookupShard(hash);
+  FETCH_LOCK(shard.lock);
+
+  auto const it = shard.entries.find(hash);
+  return (it != shard.entries.end()) && it->second.persisted;
+}
+
+/**
+ * Lookup a complete block from the cache
+ *
+ * @param hash The hash of the block
+ * @param block The output block to be populated
+ * @return true if the complete block was found, false if it is not present or has been evicted
+ */
+bool BlockCache::Get(BlockHash const &hash, BlockPtr &block) const
+{
+  auto const &shard = LookupShard(hash);
+  FETCH_LOCK(shard.lock);
+
+  auto const it = shard.entries.find(hash);
+  if ((it == shard.entries.end()) || (it->second.body_size == 0))
+  {
+    return false;
+  }
+
+  it->second.referenced = true;
+  block                 = it->second.block;
+
+  return true;
+}
+
+/**
+ * Lookup a block from the cache, irrespective of whether its body has been evicted. The output
+ * block must only be used to examine the header fields.
+ *
+ * @param hash The hash of the block
+ * @param block The output block to be populated
+ * @return true if the block was found, otherwise false
+ */
+bool BlockCache::GetHeader(BlockHash const &hash, BlockPtr &block) const
+{
+  auto const &shard = LookupShard(hash);
+  FETCH_LOCK(shard.lock);
+
+  auto const it = shard.entries.find(hash);
+  if (it == shard.entries.end())
+  {
+    return false;
+  }
+
+  block = it->second.block;
+
+  return true;
+}
+
+/**
+ * Add a block to the cache if it is not already present
+ *
+ * @param block The block to be added
+ */
+void BlockCache::Add(BlockPtr const &block)
+{
+  Insert(block, false);
+}
+
+/**
+ * Add a block to the cache, replacing any existing entry for it
+ *
+ * @param block The block to be set
+ */
+void BlockCache::Set(BlockPtr const &block)
+{
+  Insert(block, true);
+}
+
+/**
+ * Restore the body of a block whose body has previously been evicted (for example, after it has
+ * been reloaded from the block store)
+ *
+ * @param block The complete block
+ * @return true if the block was restored, otherwise false
+ */
+bool BlockCache::Restore(BlockPtr const &block)
+{
+  {
+    auto &shard = LookupShard(block->body.hash);
+    FETCH_LOCK(shard.lock);
+
+    auto it = shard.entries.find(block->body.hash);
+    if ((it == shard.entries.end()) || (it->second.body_size > 0))
+    {
+      return false;
+    }
+
+    auto &entry = it->second;
+
+    entry.block      = block;
+    entry.body_size  = CalculateBodySize(*block);
+    entry.referenced = true;
+
+    total_bytes_ += entry.body_size;
+
+    // the block was persisted previously and so can be evicted once again
+    shard.clock.push_back(block->body.hash);
+  }
+
+  EvictIfRequired();
+
+  return true;
+}
+
+/**
+ * Remove a block (and its header) from the cache
+ *
+ * @param hash The hash of the block to be removed
+ * @return true if the block was removed, otherwise false
+ */
+bool BlockCache::Erase(BlockHash const &hash)
+{
+  auto &shard = LookupShard(hash);
+  FETCH_LOCK(shard.lock);
+
+  auto it = shard.entries.find(hash);
+  if (it == shard.entries.end())
+  {
+    return false;
+  }
+
+  // the clock entry (if any) is discarded lazily when the hand reaches it
+  Release(it->second);
+  shard.entries.erase(it);
+
+  return true;
+}
+
+/**
+ * Signal that the block has been written to the block store and that its body can therefore be
+ * evicted from the cache when required
+ *
+ * @param hash The hash of the block
+ */
+void BlockCache::MarkPersisted(BlockHash const &hash)
+{
+  {
+    auto &shard = LookupShard(hash);
+    FETCH_LOCK(shard.lock);
+
+    auto it = shard.entries.find(hash);
+    if ((it == shard.entries.end()) || it->second.persisted)
+    {
+      return;
+    }
+
+    it->second.persisted = true;
+
+    if (it->second.body_size > 0)
+    {
+      shard.clock.push_back(hash);
+    }
+  }
+
+  EvictIfRequired();
+}
+
+/**
+ * Create a copy of the header of a block, i.e. the block without its transaction slices
+ *
+ * @param block The input block
+ * @return The header only version of the block
+ */
+BlockCache::BlockPtr BlockCache::CreateHeader(Block const &block)
+{
+  return std::make_shared<Block>(block.CopyHeader());
+}
+
+/**
+ * Estimate the number of bytes occupied by the body of the block
+ *
+ * @param block The input block
+ * @return The estimated size of the body in bytes (always non-zero)
+ */
+std::size_t BlockCache::CalculateBodySize(Block const &block)
+{
+  std::size_t size{sizeof(Block::Slices)};
+
+  for (auto const &slice : block.body.slices)
+  {
+    size += sizeof(Block::Slice);
+
+    for (auto const &layout : slice)
+    {
+      size += sizeof(TransactionLayout) + layout.digest().size();
+      size += (layout.mask().size() + 7u) / 8u;
+    }
+  }
+
+  return size;
+}
+
+/**
+ * Internal: Lookup the shard that is responsible for the specified block
+ *
+ * @param hash The hash of the block
+ * @return The reference to the shard
+ */
+BlockCache::Shard &BlockCache::LookupShard(BlockHash const &hash)
+{
+  return shards_[std::hash<BlockHash>{}(hash) % NUM_SHARDS];
+}
+
+BlockCache::Shard const &BlockCache::LookupShard(BlockHash const &hash) const
+{
+  return shards_[std::hash<BlockHash>{}(hash) % NUM_SHARDS];
+}
+
+/**
+ * Internal: Add a block to the cache
+ *
+ * @param block The block to be added
+ * @param replace Flag to signal that any existing entry should be replaced
+ */
+void BlockCache::Insert(BlockPtr const &block, bool replace)
+{
+  {
+    auto &shard = LookupShard(block->body.hash);
+    FETCH_LOCK(shard.lock);
+
+    auto it = shard.entries.find(block->body.hash);
+    if (it != shard.entries.end())
+    {
+      if (!replace)
+      {
+        return;
+      }
+
+      Release(it->second);
+      shard.entries.erase(it);
+    }
+
+    Entry entry{};
+    entry.block     = block;
+    entry.body_size = CalculateBodySize(*block);
+
+    total_bytes_ += HeaderSize() + entry.body_size;
+    ++num_blocks_;
+
+    shard.entries.emplace(block->body.hash, std::move(entry));
+  }
+
+  EvictIfRequired();
+}
+
+/**
+ * Internal: Remove the accounting for an entry which is about to be erased
+ *
+ * @param entry The entry being erased
+ */
+void BlockCache::Release(Entry &entry)
+{
+  total_bytes_ -= HeaderSize() + entry.body_size;
+  --num_blocks_;
+}
+
+/**
+ * Internal: Evict the bodies of blocks until the cache is within its byte budget. If another thread
+ * is already evicting then this thread does not wait for it.
+ */
+void BlockCache::EvictIfRequired()
+{
+  if (total_bytes_ <= max_bytes_)
+  {
+    return;
+  }
+
+  std::unique_lock<Mutex> lock{evict_lock_, std::try_to_lock};
+  if (!lock.owns_lock())
+  {
+    return;
+  }
+
+  // visit the shards in turn, stopping when either the budget has been met or a complete pass has
+  // been made over all the shards without being able to evict anything
+  std::size_t idle_shards{0};
+  while (idle_shards < NUM_SHARDS)
+  {
+    std::size_t const total_bytes = total_bytes_;
+    if (total_bytes <= max_bytes_)
+    {
+      break;
+    }
+
+    auto &shard  = shards_[evict_shard_];
+    evict_shard_ = (evict_shard_ + 1) % NUM_SHARDS;
+
+    if (EvictFromShard(shard, total_bytes - max_bytes_) > 0)
+    {
+      idle_shards = 0;
+    }
+    else
+    {
+      ++idle_shards;
+    }
+  }
+}
+
+/**
+ * Internal: Run the CLOCK algorithm over one of the shards
+ *
+ * @param shard The shard to evict from
+ * @param target The number of bytes that need to be evicted
+ * @return The number of bytes that have been evicted
+ */
+std::size_t BlockCache::EvictFromShard(Shard &shard, std::size_t target)
+{
+  std::size_t evicted{0};
+
+  FETCH_LOCK(shard.lock);
+
+  // each entry is visited at most twice, once to clear its reference bit and once to evict it
+  std::size_t steps = shard.clock.size() * 2;
+  while ((evicted < target) && !shard.clock.empty() && (steps > 0))
+  {
+    --steps;
+
+    if (shard.hand >= shard.clock.size())
+    {
+      shard.hand = 0;
+    }
+
+    auto const it = shard.entries.find(shard.clock[shard.hand]);
+
+    // remove stale clock entries i.e. blocks that have been erased or are already evicted
+    if ((it == shard.entries.end()) || (it->second.body_size == 0) || !it->second.persisted)
+    {
+      shard.clock[shard.hand] = std::move(shard.clock.back());
+      shard.clock.pop_back();
+      continue;
+    }
+
+    auto &entry = it->second;
+
+    if (entry.referenced)
+    {
+      // second chance
+      entry.referenced = false;
+      ++shard.hand;
+      continue;
+    }
+
+    // evict the body, pinning only the header of the block
+    entry.block = CreateHeader(*entry.block);
+    evicted += entry.body_size;
+    total_bytes_ -= entry.body_size;
+    entry.body_size = 0;
+
+    shard.clock[shard.hand] = std::move(shard.clock.back());
+    shard.clock.pop_back();
+  }
+
+  return evicted;
+}
+
+/**
+ * Internal: The estimated number of bytes occupied by a block header in the cache
+ *
+ * @return The size in bytes
+ */
+std::size_t BlockCache::HeaderSize()
+{
+  return sizeof(Block) + sizeof(Entry) + sizeof(BlockHash);
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -859,13 +859,19 @@ void BlockCoordinator::UpdateNextBlockTime()
 
 void BlockCoordinator::UpdateTxStatus(Block const &block)
 {
+  TransactionStatusCache::Digests digests;
+  digests.reserve(block.GetTransactionCount());
+
   for (auto const &slice : block.body.slices)
   {
     for (auto const &tx : slice)
     {
-      status_cache_.Update(tx.digest(), TransactionStatus::EXECUTED);
+      digests.push_back(tx.digest());
     }
   }
+
+  // update all the transactions of the block in a single pass
+  status_cache_.Update(digests, TransactionStatus::EXECUTED);
 }
 
 char const *BlockCoordinator::ToString(State state)
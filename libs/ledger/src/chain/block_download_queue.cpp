@@ -0,0 +1,225 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/chain/block_download_queue.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace fetch {
+namespace ledger {
+
+constexpr std::size_t BlockDownloadQueue::DEFAULT_WINDOW_SIZE;
+constexpr std::size_t BlockDownloadQueue::DEFAULT_LOOKAHEAD;
+
+/**
+ * Construct the download queue for the specified section of chain
+ *
+ * @param headers The validated headers of the blocks to be downloaded (oldest first)
+ * @param window_size The maximum number of blocks in each request
+ * @param lookahead The maximum number of blocks which can be requested ahead of the next block
+ */
+BlockDownloadQueue::BlockDownloadQueue(Headers headers, std::size_t window_size,
+                                       std::size_t lookahead)
+  : lookahead_{std::max(lookahead, window_size)}
+  , headers_{std::move(headers)}
+  , blocks_(headers_.size())
+  , received_(headers_.size(), false)
+{
+  window_size = std::max<std::size_t>(window_size, 1);
+
+  index_.reserve(headers_.size());
+  for (std::size_t i = 0; i < headers_.size(); ++i)
+  {
+    index_.emplace(headers_[i].header.body.hash, i);
+  }
+
+  for (std::size_t start = 0; start < headers_.size(); start += window_size)
+  {
+    pending_.emplace_back();
+
+    auto &window = pending_.back();
+    for (std::size_t i = start, end = std::min(start + window_size, headers_.size()); i < end; ++i)
+    {
+      window.push_back(i);
+    }
+  }
+}
+
+/**
+ * Take the next window of blocks to be requested
+ *
+ * @param id The output identifier of the window
+ * @param hashes The output hashes of the blocks in the window
+ * @return true if a window was assigned, false if there are no windows which can be requested
+ */
+bool BlockDownloadQueue::Assign(WindowId &id, BlockHashes &hashes)
+{
+  // limit the number of blocks which are buffered waiting for an earlier block
+  if (pending_.empty() || (pending_.front().front() >= next_block_ + lookahead_))
+  {
+    return false;
+  }
+
+  id = next_window_id_++;
+
+  auto &window = in_flight_[id];
+  window       = std::move(pending_.front());
+  pending_.pop_front();
+
+  hashes.clear();
+  hashes.reserve(window.size());
+  for (auto const index : window)
+  {
+    hashes.push_back(headers_[index].header.body.hash);
+  }
+
+  return true;
+}
+
+/**
+ * Handle the blocks received for a window
+ *
+ * Blocks which do not match the header of a block in the window are discarded, any blocks of the
+ * window which have not been received are requested again.
+ *
+ * @param id The identifier of the window
+ * @param blocks The blocks which have been received
+ */
+void BlockDownloadQueue::Complete(WindowId id, Blocks &blocks)
+{
+  auto it = in_flight_.find(id);
+  if (it == in_flight_.end())
+  {
+    return;
+  }
+
+  Indices window = std::move(it->second);
+  in_flight_.erase(it);
+
+  for (auto &block : blocks)
+  {
+    // the hash can only be trusted once it has been recalculated
+    block.UpdateDigest();
+
+    auto const index = index_.find(block.body.hash);
+    if ((index == index_.end()) || received_[index->second] ||
+        (std::find(window.begin(), window.end(), index->second) == window.end()))
+    {
+      continue;
+    }
+
+    blocks_[index->second]   = std::move(block);
+    received_[index->second] = true;
+  }
+
+  // request the remainder of the window again
+  window.erase(std::remove_if(window.begin(), window.end(),
+                              [this](std::size_t index) { return received_[index]; }),
+               window.end());
+
+  if (!window.empty())
+  {
+    Requeue(std::move(window));
+  }
+}
+
+/**
+ * Return a window which could not be downloaded to the queue
+ *
+ * @param id The identifier of the window
+ */
+void BlockDownloadQueue::Fail(WindowId id)
+{
+  auto it = in_flight_.find(id);
+  if (it == in_flight_.end())
+  {
+    return;
+  }
+
+  Requeue(std::move(it->second));
+  in_flight_.erase(it);
+}
+
+/**
+ * Return a window to the queue, the windows are kept in chain order so that the oldest blocks are
+ * always requested first
+ *
+ * @param window The indices of the blocks in the window
+ */
+void BlockDownloadQueue::Requeue(Indices window)
+{
+  auto const position =
+      std::upper_bound(pending_.begin(), pending_.end(), window,
+                       [](Indices const &a, Indices const &b) { return a.front() < b.front(); });
+
+  pending_.emplace(position, std::move(window));
+}
+
+/**
+ * Take the blocks which are ready to be added to the chain
+ *
+ * @return The received blocks following the last released block, in chain order
+ */
+BlockDownloadQueue::Blocks BlockDownloadQueue::PopReady()
+{
+  Blocks ready{};
+
+  while ((next_block_ < headers_.size()) && received_[next_block_])
+  {
+    ready.emplace_back(std::move(blocks_[next_block_]));
+    blocks_[next_block_] = Block{};
+
+    ++next_block_;
+  }
+
+  return ready;
+}
+
+/**
+ * Determine if all of the blocks have been released
+ *
+ * @return true if the download is complete, otherwise false
+ */
+bool BlockDownloadQueue::IsComplete() const
+{
+  return next_block_ == headers_.size();
+}
+
+/**
+ * Get the number of blocks which have not yet been released
+ *
+ * @return The number of blocks
+ */
+std::size_t BlockDownloadQueue::GetRemainingCount() const
+{
+  return headers_.size() - next_block_;
+}
+
+/**
+ * Get the number of windows which have been requested and not yet completed
+ *
+ * @return The number of windows
+ */
+std::size_t BlockDownloadQueue::GetInFlightCount() const
+{
+  return in_flight_.size();
+}
+
+}  // namespace ledger
+}  // namespace fetch
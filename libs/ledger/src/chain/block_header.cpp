@@ -0,0 +1,43 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/chain/block_header.hpp"
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Construct the header of the specified block
+ *
+ * @param block The block
+ */
+BlockHeader::BlockHeader(Block const &block)
+  : header{block.CopyHeader()}
+  , transaction_root{block.GetTransactionRoot()}
+{}
+
+/**
+ * Recalculate the hash of the block from the contents of the header
+ */
+void BlockHeader::UpdateDigest()
+{
+  header.UpdateDigest(transaction_root);
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -0,0 +1,359 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/chain/compact_block.hpp"
+#include "crypto/sha256.hpp"
+#include "ledger/transaction_layout_cache.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace fetch {
+namespace ledger {
+namespace {
+
+enum class Status : uint8_t
+{
+  MISSING,
+  FOUND,
+  AMBIGUOUS,
+};
+
+/**
+ * Mix the bits of the input value (the finaliser of splitmix64)
+ *
+ * @param value The input value
+ * @return The mixed value
+ */
+uint64_t Mix(uint64_t value)
+{
+  value = (value ^ (value >> 30u)) * 0xbf58476d1ce4e5b9ull;
+  value = (value ^ (value >> 27u)) * 0x94d049bb133111ebull;
+  return value ^ (value >> 31u);
+}
+
+/**
+ * Open addressing table from the short IDs of a block to their positions in the block
+ *
+ * The short IDs are keyed hashes, so their low bits are used directly as the slot index.
+ */
+class PositionTable
+{
+public:
+  using ShortId = CompactBlock::ShortId;
+
+  static constexpr std::size_t NOT_FOUND = std::numeric_limits<std::size_t>::max();
+
+  explicit PositionTable(std::size_t count)
+  {
+    std::size_t capacity{16};
+    while (capacity < (count * 2u))
+    {
+      capacity <<= 1u;
+    }
+
+    slots_.resize(capacity);
+    mask_ = capacity - 1u;
+  }
+
+  /**
+   * Insert the position of a short ID, unless the short ID is already present
+   *
+   * @param id The short ID
+   * @param position The position of the short ID in the block
+   * @return The existing position of the short ID, or NOT_FOUND if it has been inserted
+   */
+  std::size_t Insert(ShortId id, std::size_t position)
+  {
+    for (std::size_t index = id & mask_;; index = (index + 1u) & mask_)
+    {
+      auto &slot = slots_[index];
+
+      if (NOT_FOUND == slot.position)
+      {
+        slot.id       = id;
+        slot.position = position;
+        return NOT_FOUND;
+      }
+
+      if (slot.id == id)
+      {
+        return slot.position;
+      }
+    }
+  }
+
+  /**
+   * Lookup the position of a short ID
+   *
+   * @param id The short ID
+   * @return The position of the short ID, or NOT_FOUND if it is not present
+   */
+  std::size_t Find(ShortId id) const
+  {
+    for (std::size_t index = id & mask_;; index = (index + 1u) & mask_)
+    {
+      auto const &slot = slots_[index];
+
+      if ((NOT_FOUND == slot.position) || (slot.id == id))
+      {
+        return slot.position;
+      }
+    }
+  }
+
+private:
+  struct Slot
+  {
+    ShortId     id{0};
+    std::size_t position{NOT_FOUND};
+  };
+
+  std::vector<Slot> slots_;
+  std::size_t       mask_{0};
+};
+
+constexpr std::size_t PositionTable::NOT_FOUND;
+
+}  // namespace
+
+constexpr std::size_t CompactBlock::SCAN_FACTOR;
+constexpr std::size_t CompactBlock::MIN_SCAN_LENGTH;
+
+/**
+ * Construct the compact form of the specified block
+ *
+ * @param block The block to be compacted
+ * @param salt The salt for the short IDs of the transactions
+ */
+CompactBlock::CompactBlock(Block const &block, uint64_t salt)
+  : header{block.CopyHeader()}
+  , salt{salt}
+{
+  UpdateKey();
+
+  slices.reserve(block.body.slices.size());
+  for (auto const &slice : block.body.slices)
+  {
+    slices.emplace_back();
+    slices.back().reserve(slice.size());
+
+    for (auto const &layout : slice)
+    {
+      slices.back().push_back(ComputeShortId(layout.digest()));
+    }
+  }
+}
+
+/**
+ * Rebuild the block from the layouts of the transactions which are present in the cache
+ *
+ * A transaction is only taken from the cache when its short ID identifies it uniquely, all the
+ * other transactions are reported as missing. Only the most recent layouts in the cache are
+ * scanned (in proportion to the size of the block) and the scan stops as soon as every
+ * transaction has been found, a wrong match is caught when the block digest is checked.
+ *
+ * @param cache The cache of recently seen transaction layouts
+ * @param block The output block
+ * @param missing The output indices (across all slices) of the transactions which are missing
+ * @return true if the block could be completely rebuilt, otherwise false
+ */
+bool CompactBlock::Reconstruct(TransactionLayoutCache const &cache, Block &block,
+                               Indices &missing) const
+{
+  block = header;
+  block.body.slices.resize(slices.size());
+
+  std::size_t const num_transactions = GetTransactionCount();
+
+  std::vector<TransactionLayout *> entries;
+  std::vector<Status>              status(num_transactions, Status::MISSING);
+  PositionTable                    positions{num_transactions};
+  std::size_t                      num_unresolved{num_transactions};
+  entries.reserve(num_transactions);
+
+  for (std::size_t i = 0; i < slices.size(); ++i)
+  {
+    auto &slice = block.body.slices[i];
+    slice.resize(slices[i].size());
+
+    for (std::size_t j = 0; j < slice.size(); ++j)
+    {
+      std::size_t const index = entries.size();
+      entries.push_back(&slice[j]);
+
+      // short IDs which collide inside the block can never be resolved from the cache
+      std::size_t const existing = positions.Insert(slices[i][j], index);
+      if (PositionTable::NOT_FOUND != existing)
+      {
+        num_unresolved -= (Status::MISSING == status[existing]) ? 2u : 1u;
+
+        status[existing] = Status::AMBIGUOUS;
+        status[index]    = Status::AMBIGUOUS;
+      }
+    }
+  }
+
+  std::size_t const scan_length = std::max(num_transactions * SCAN_FACTOR, MIN_SCAN_LENGTH);
+
+  cache.VisitRecent(scan_length, [&](TransactionLayout const &layout) {
+    if (num_unresolved == 0)
+    {
+      return false;
+    }
+
+    std::size_t const position = positions.Find(ComputeShortId(layout.digest()));
+    if (PositionTable::NOT_FOUND == position)
+    {
+      return true;
+    }
+
+    auto &entry_status = status[position];
+    if (Status::MISSING == entry_status)
+    {
+      *entries[position] = layout;
+      entry_status       = Status::FOUND;
+      --num_unresolved;
+    }
+    else if ((Status::FOUND == entry_status) && (entries[position]->digest() != layout.digest()))
+    {
+      entry_status = Status::AMBIGUOUS;
+    }
+
+    return true;
+  });
+
+  missing.clear();
+  for (std::size_t index = 0; index < num_transactions; ++index)
+  {
+    if (Status::FOUND != status[index])
+    {
+      *entries[index] = TransactionLayout{};
+      missing.push_back(index);
+    }
+  }
+
+  return missing.empty();
+}
+
+/**
+ * Fill in the missing transactions of a partially reconstructed block
+ *
+ * @param block The block to be completed
+ * @param missing The indices (across all slices) of the missing transactions
+ * @param layouts The layouts of the missing transactions, in the same order as the indices
+ * @return true if all the layouts match the short IDs of the block, otherwise false
+ */
+bool CompactBlock::Complete(Block &block, Indices const &missing, Layouts const &layouts) const
+{
+  if ((missing.size() != layouts.size()) || (block.body.slices.size() != slices.size()))
+  {
+    return false;
+  }
+
+  // the index of the first transaction in each slice
+  Indices offsets;
+  offsets.reserve(slices.size() + 1);
+  offsets.push_back(0);
+  for (auto const &slice : slices)
+  {
+    offsets.push_back(offsets.back() + slice.size());
+  }
+
+  for (std::size_t i = 0; i < missing.size(); ++i)
+  {
+    if (missing[i] >= offsets.back())
+    {
+      return false;
+    }
+
+    // lookup the slice which contains the transaction
+    auto const it = std::upper_bound(offsets.begin(), offsets.end(), missing[i]) - 1;
+
+    std::size_t const slice  = static_cast<std::size_t>(it - offsets.begin());
+    std::size_t const offset = static_cast<std::size_t>(missing[i] - *it);
+
+    if ((block.body.slices[slice].size() != slices[slice].size()) ||
+        (ComputeShortId(layouts[i].digest()) != slices[slice][offset]))
+    {
+      return false;
+    }
+
+    block.body.slices[slice][offset] = layouts[i];
+  }
+
+  return true;
+}
+
+/**
+ * Get the number of transactions present in the block
+ *
+ * @return The transaction count
+ */
+std::size_t CompactBlock::GetTransactionCount() const
+{
+  std::size_t count{0};
+
+  for (auto const &slice : slices)
+  {
+    count += slice.size();
+  }
+
+  return count;
+}
+
+/**
+ * Compute the short ID of a transaction
+ *
+ * @param digest The digest of the transaction
+ * @return The short ID
+ */
+CompactBlock::ShortId CompactBlock::ComputeShortId(Digest const &digest) const
+{
+  uint64_t hash = key_[0];
+
+  for (std::size_t offset = 0; offset < digest.size(); offset += sizeof(uint64_t))
+  {
+    uint64_t word{0};
+    std::memcpy(&word, digest.pointer() + offset,
+                std::min(sizeof(uint64_t), digest.size() - offset));
+
+    hash = Mix(hash ^ word);
+  }
+
+  return Mix(hash ^ key_[1]);
+}
+
+/**
+ * Derive the key for the short IDs from the block hash and the salt
+ */
+void CompactBlock::UpdateKey()
+{
+  crypto::SHA256 hasher;
+  hasher.Reset();
+  hasher.Update(header.body.hash);
+  hasher.Update(reinterpret_cast<uint8_t const *>(&salt), sizeof(salt));
+
+  auto const digest = hasher.Final();
+  std::memcpy(key_.data(), digest.pointer(), sizeof(key_));
+}
+
+}  // namespace ledger
+}  // namespace fetch
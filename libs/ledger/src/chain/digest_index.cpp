@@ -0,0 +1,314 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/chain/digest_index.hpp"
+#include "core/assert.hpp"
+#include "crypto/fnv.hpp"
+#include "crypto/hash.hpp"
+#include "crypto/sha256.hpp"
+#include "ledger/chain/transaction_layout_rpc_serializers.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+namespace fetch {
+namespace ledger {
+namespace {
+
+constexpr std::size_t BITS_PER_WORD = 64;
+
+/**
+ * Round the requested size of the filter up to a power of 2 (and at least one word)
+ *
+ * @param filter_bits The requested number of bits
+ * @return The number of bits of the filter
+ */
+std::size_t CalculateFilterSize(std::size_t filter_bits)
+{
+  std::size_t size{BITS_PER_WORD};
+  while (size < filter_bits)
+  {
+    size <<= 1u;
+  }
+
+  return size;
+}
+
+/**
+ * Derive the pair of hashes from which the bit positions of a digest in the filter are generated
+ * (double hashing). Transaction digests are cryptographic hashes, so their bytes can be used
+ * directly, only short digests need to be hashed.
+ *
+ * @param digest The digest to be hashed
+ * @param h1 The output first hash
+ * @param h2 The output second hash
+ */
+void CalculateFilterHashes(Digest const &digest, uint64_t &h1, uint64_t &h2)
+{
+  if (digest.size() >= (2 * sizeof(uint64_t)))
+  {
+    std::memcpy(&h1, digest.pointer(), sizeof(uint64_t));
+    std::memcpy(&h2, digest.pointer() + sizeof(uint64_t), sizeof(uint64_t));
+  }
+  else
+  {
+    h1 = std::hash<Digest>{}(digest);
+    h2 = (h1 >> 32u) | (h1 << 32u);
+  }
+
+  // the step must be odd so that it visits different bits of the (power of 2 sized) filter
+  h2 |= 1u;
+}
+
+/**
+ * Map a digest onto the 32 byte identifiers used by the object store
+ *
+ * @param digest The digest to be mapped
+ * @return The resource identifier for the digest
+ */
+storage::ResourceID ToResourceID(Digest const &digest)
+{
+  if (digest.size() == storage::ResourceID::RESOURCE_ID_SIZE_IN_BYTES)
+  {
+    return storage::ResourceID{digest};
+  }
+
+  return storage::ResourceID{crypto::Hash<crypto::SHA256>(digest)};
+}
+
+}  // namespace
+
+constexpr std::size_t DigestIndex::DEFAULT_FILTER_BITS;
+constexpr std::size_t DigestIndex::NUM_FILTER_HASHES;
+
+/**
+ * Construct an (in memory) digest index
+ *
+ * @param filter_bits The number of bits of the Bloom filter, rounded up to a power of 2
+ */
+DigestIndex::DigestIndex(std::size_t filter_bits)
+  : filter_bits_{CalculateFilterSize(filter_bits)}
+  , filter_(filter_bits_ / BITS_PER_WORD, 0)
+{}
+
+/**
+ * Create a new (empty) persistent index, replacing any existing one
+ *
+ * @param doc_file The path to the document file of the store
+ * @param index_file The path to the index file of the store
+ */
+void DigestIndex::New(std::string const &doc_file, std::string const &index_file)
+{
+  FETCH_LOCK(lock_);
+
+  store_ = std::make_unique<Store>();
+  store_->New(doc_file, index_file);
+
+  locations_.clear();
+  std::fill(filter_.begin(), filter_.end(), 0);
+}
+
+/**
+ * Load a persistent index. The filter is not persisted and must be repopulated, with AddToFilter,
+ * for every block which has already been indexed.
+ *
+ * @param doc_file The path to the document file of the store
+ * @param index_file The path to the index file of the store
+ */
+void DigestIndex::Load(std::string const &doc_file, std::string const &index_file)
+{
+  FETCH_LOCK(lock_);
+
+  store_ = std::make_unique<Store>();
+  store_->Load(doc_file, index_file, true);
+
+  locations_.clear();
+  std::fill(filter_.begin(), filter_.end(), 0);
+}
+
+/**
+ * Flush the persistent index to disk
+ */
+void DigestIndex::Flush()
+{
+  FETCH_LOCK(lock_);
+
+  if (store_)
+  {
+    store_->Flush(false);
+  }
+}
+
+/**
+ * Record the location of all the transactions of a block. Adding a block more than once has no
+ * further effect.
+ *
+ * @param block The block to be indexed
+ */
+void DigestIndex::Add(Block const &block)
+{
+  FETCH_LOCK(lock_);
+
+  for (auto const &slice : block.body.slices)
+  {
+    for (auto const &tx : slice)
+    {
+      auto const &digest = tx.digest();
+
+      Locations locations{};
+      if (TestFilter(digest))
+      {
+        LookupLocations(digest, locations);
+      }
+
+      bool const present =
+          std::any_of(locations.begin(), locations.end(), [&block](Location const &location) {
+            return location.block_hash == block.body.hash;
+          });
+
+      if (!present)
+      {
+        locations.emplace_back(Location{block.body.block_number, block.body.hash});
+
+        SetLocations(digest, locations);
+        SetFilter(digest);
+      }
+    }
+  }
+}
+
+/**
+ * Add the transactions of a block, which has already been indexed, to the filter. Used to rebuild
+ * the filter when loading a persistent index.
+ *
+ * @param block The block whose transactions are to be added
+ */
+void DigestIndex::AddToFilter(Block const &block)
+{
+  FETCH_LOCK(lock_);
+
+  for (auto const &slice : block.body.slices)
+  {
+    for (auto const &tx : slice)
+    {
+      SetFilter(tx.digest());
+    }
+  }
+}
+
+/**
+ * Lookup the locations of a set of transaction digests
+ *
+ * @param digests The set of digests to be looked up
+ * @return The map of the digests which were found to all of their locations
+ */
+DigestIndex::LocationMap DigestIndex::Lookup(DigestSet const &digests) const
+{
+  LocationMap found{};
+
+  FETCH_LOCK(lock_);
+
+  for (auto const &digest : digests)
+  {
+    Locations locations{};
+    if (TestFilter(digest) && LookupLocations(digest, locations))
+    {
+      found.emplace(digest, std::move(locations));
+    }
+  }
+
+  return found;
+}
+
+/**
+ * Get the number of digests in the index
+ *
+ * @return The number of digests
+ */
+std::size_t DigestIndex::size() const
+{
+  FETCH_LOCK(lock_);
+
+  return store_ ? store_->size() : locations_.size();
+}
+
+void DigestIndex::SetFilter(Digest const &digest)
+{
+  uint64_t h1{0};
+  uint64_t h2{0};
+  CalculateFilterHashes(digest, h1, h2);
+
+  uint64_t const mask = filter_bits_ - 1u;
+  for (std::size_t i = 0; i < NUM_FILTER_HASHES; ++i)
+  {
+    uint64_t const bit = (h1 + (i * h2)) & mask;
+    filter_[bit / BITS_PER_WORD] |= (1ull << (bit % BITS_PER_WORD));
+  }
+}
+
+bool DigestIndex::TestFilter(Digest const &digest) const
+{
+  uint64_t h1{0};
+  uint64_t h2{0};
+  CalculateFilterHashes(digest, h1, h2);
+
+  uint64_t const mask = filter_bits_ - 1u;
+  for (std::size_t i = 0; i < NUM_FILTER_HASHES; ++i)
+  {
+    uint64_t const bit = (h1 + (i * h2)) & mask;
+    if ((filter_[bit / BITS_PER_WORD] & (1ull << (bit % BITS_PER_WORD))) == 0)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool DigestIndex::LookupLocations(Digest const &digest, Locations &locations) const
+{
+  if (store_)
+  {
+    return store_->Get(ToResourceID(digest), locations);
+  }
+
+  auto const it = locations_.find(digest);
+  if (it == locations_.end())
+  {
+    return false;
+  }
+
+  locations = it->second;
+  return true;
+}
+
+void DigestIndex::SetLocations(Digest const &digest, Locations const &locations)
+{
+  if (store_)
+  {
+    store_->Set(ToResourceID(digest), locations);
+  }
+  else
+  {
+    locations_[digest] = locations;
+  }
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -18,6 +18,7 @@
 
 #include "ledger/chain/json_transaction.hpp"
 #include "core/byte_array/decoders.hpp"
+#include "core/json/on_demand.hpp"
 #include "ledger/chain/transaction.hpp"
 #include "ledger/chain/transaction_serializer.hpp"
 #include "variant/variant.hpp"
@@ -30,9 +31,44 @@ using variant::Variant;
 using variant::Extract;
 using byte_array::ConstByteArray;
 using byte_array::FromBase64;
+using json::OnDemandValue;
 
 static constexpr char const *LOGGING_NAME        = "JsonTx";
 static const ConstByteArray  JSON_FORMAT_VERSION = "1.2";
+static const ConstByteArray  VERSION_KEY         = "ver";
+static const ConstByteArray  DATA_KEY            = "data";
+
+namespace {
+
+/**
+ * Decode the fields of a JSON transaction
+ *
+ * @param version The contents of the version field
+ * @param data The contents of the (base64 encoded) data field
+ * @param dst The transaction to be populated
+ * @return true if successful, otherwise false
+ */
+bool DecodeTransaction(ConstByteArray const &version, ConstByteArray const &data, Transaction &dst)
+{
+  // ensure that the version matches expectation
+  if (JSON_FORMAT_VERSION != version)
+  {
+    FETCH_LOG_INFO(LOGGING_NAME, "Unexpected version: ", version);
+    return false;
+  }
+
+  // create the serializer and try and deserialize the transaction
+  TransactionSerializer serializer{FromBase64(data)};
+  if (!serializer.Deserialize(dst))
+  {
+    FETCH_LOG_INFO(LOGGING_NAME, "No data field present in payload");
+    return false;
+  }
+
+  return true;
+}
+
+}  // namespace
 
 /**
  * Convert an input JSON object into a transaction
@@ -44,39 +80,55 @@ bool FromJsonTransaction(Variant const &src, Transaction &dst)
 {
   // determine if this payload is of the correct version
   ConstByteArray version{};
-  if (!Extract(src, "ver", version))
+  if (!Extract(src, VERSION_KEY, version))
   {
     FETCH_LOG_INFO(LOGGING_NAME, "No version field present in payload");
     return false;
   }
 
-  // ensure that the version matches expectation
-  if (JSON_FORMAT_VERSION != version)
+  // extract the data field
+  ConstByteArray data{};
+  if (!Extract(src, DATA_KEY, data))
   {
-    FETCH_LOG_INFO(LOGGING_NAME, "Unexpected version: ", version);
+    FETCH_LOG_INFO(LOGGING_NAME, "No data field present in payload");
     return false;
   }
 
-  // extract the data field
-  ConstByteArray data{};
-  if (!Extract(src, "data", data))
+  return DecodeTransaction(version, data, dst);
+}
+
+/**
+ * Convert an input JSON object into a transaction, reading the fields directly from the document
+ * without building a variant
+ *
+ * @param src The on-demand JSON value to decode into a transaction
+ * @param dst The transaction to be populated
+ */
+bool FromJsonTransaction(OnDemandValue const &src, Transaction &dst)
+{
+  if (!src.IsObject())
   {
-    FETCH_LOG_INFO(LOGGING_NAME, "No data field present in payload");
+    FETCH_LOG_INFO(LOGGING_NAME, "Payload is not an object");
     return false;
   }
 
-  // convert the data field to binary
-  data = FromBase64(data);
+  // determine if this payload is of the correct version
+  OnDemandValue version{};
+  if (!src.Find(VERSION_KEY, version) || !version.IsString())
+  {
+    FETCH_LOG_INFO(LOGGING_NAME, "No version field present in payload");
+    return false;
+  }
 
-  // create the serializer and try and deserialize the transaction
-  TransactionSerializer serializer{data};
-  if (!serializer.Deserialize(dst))
+  // extract the data field
+  OnDemandValue data{};
+  if (!src.Find(DATA_KEY, data) || !data.IsString())
   {
     FETCH_LOG_INFO(LOGGING_NAME, "No data field present in payload");
     return false;
   }
 
-  return true;
+  return DecodeTransaction(version.AsString(), data.AsString(), dst);
 }
 
 /**
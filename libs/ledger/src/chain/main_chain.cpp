@@ -23,6 +23,8 @@
 #include "network/generics/milli_timer.hpp"
 
 #include <algorithm>
+#include <limits>
+#include <string>
 #include <utility>
 
 using fetch::byte_array::ToBase64;
@@ -30,6 +32,20 @@ using fetch::generics::MilliTimer;
 
 namespace fetch {
 namespace ledger {
+namespace {
+
+/**
+ * Generate the key of the persisted chain height store for a given block number
+ *
+ * @param block_number The number of the block
+ * @return The resource address of the block hash at that height
+ */
+storage::ResourceAddress CreateHeightKey(uint64_t block_number)
+{
+  return storage::ResourceAddress{std::to_string(block_number)};
+}
+
+}  // namespace
 
 /**
  * Converts a block status into a human readable string
@@ -64,13 +80,16 @@ char const *ToString(BlockStatus status)
  * Constructs the main chain
  *
  * @param mode Flag to signal which storage mode has been requested
+ * @param cache_size The (approximate) maximum number of bytes for the in memory block cache
  */
-MainChain::MainChain(Mode mode)
+MainChain::MainChain(Mode mode, std::size_t cache_size)
+  : block_chain_{cache_size}
 {
   if (Mode::IN_MEMORY_DB != mode)
   {
     // create the block store
-    block_store_ = std::make_unique<BlockStore>();
+    block_store_  = std::make_unique<BlockStore>();
+    height_store_ = std::make_unique<HeightStore>();
 
     RecoverFromFile(mode);
   }
@@ -90,6 +109,8 @@ MainChain::~MainChain()
   if (block_store_)
   {
     block_store_->Flush(false);
+    height_store_->Flush(false);
+    digest_index_.Flush();
   }
 }
 
@@ -112,6 +133,8 @@ BlockStatus MainChain::AddBlock(Block const &blk)
     block->weight += slice.size();
   }
 
+  FETCH_LOCK(lock_);
+
   // pass the block to the
   auto const status = InsertBlock(block);
   FETCH_LOG_DEBUG(LOGGING_NAME, "New Block: 0x", block->body.hash.ToHex(), " -> ", ToString(status),
@@ -127,8 +150,12 @@ BlockStatus MainChain::AddBlock(Block const &blk)
  */
 MainChain::BlockPtr MainChain::GetHeaviestBlock() const
 {
-  FETCH_LOCK(lock_);
-  return GetBlock(heaviest_.hash);
+  ReadLock lock{lock_};
+
+  IntBlockPtr block{};
+  LookupBlock(heaviest_.hash, block);
+
+  return block;
 }
 
 /**
@@ -146,37 +173,41 @@ bool MainChain::RemoveBlock(BlockHash hash)
   FETCH_LOCK(lock_);
 
   // Check that the input block hash is actually in the cache
-  auto invalid_block_it = block_chain_.find(hash);
-  if (block_chain_.end() != invalid_block_it)
+  if (block_chain_.Has(hash))
   {
     BlockHashSet invalidated_blocks{};
 
     // add the original element into the invalidated block set
     invalidated_blocks.insert(hash);
-    block_chain_.erase(hash);
+    block_chain_.Erase(hash);
 
     // Step 1. Evaluate all the blocks which have been now been made invalid from this change
     for (;;)
     {
-      // find the next element to remove
-      auto it = std::find_if(block_chain_.begin(), block_chain_.end(),
-                             [&invalidated_blocks, hash](BlockMap::value_type const &e) {
-                               return (invalidated_blocks.find(e.second->body.previous_hash) !=
-                                       invalidated_blocks.end());
-                             });
+      // find all the blocks which build upon the invalidated blocks
+      BlockHashs removed_blocks{};
+      block_chain_.ForEach([&invalidated_blocks, &removed_blocks](IntBlockPtr const &block, bool) {
+        if (invalidated_blocks.find(block->body.previous_hash) != invalidated_blocks.end())
+        {
+          removed_blocks.push_back(block->body.hash);
+        }
+      });
 
       // once we have done a complete sweep where we haven't found anything, the fallout has been
       // calculated and collected
-      if (it == block_chain_.end())
+      if (removed_blocks.empty())
       {
         break;
       }
 
-      // update our removed blocks and hashes
-      invalidated_blocks.insert(it->first);
+      for (auto const &removed_hash : removed_blocks)
+      {
+        // update our removed blocks and hashes
+        invalidated_blocks.insert(removed_hash);
 
-      // remove the element from the map
-      block_chain_.erase(it);
+        // remove the element from the cache
+        block_chain_.Erase(removed_hash);
+      }
     }
 
     // Step 2. Loop through all the loose blocks and remove any references to invalidated blocks
@@ -216,7 +247,7 @@ bool MainChain::RemoveBlock(BlockHash hash)
 
     // Step 3. Since we might have removed a whole series of blocks the tips datastructure has been
     // invalidated. We need to evaluate the changes here
-    success = ReindexTips();
+    success = RebuildTips();
   }
 
   return success;
@@ -236,9 +267,9 @@ MainChain::Blocks MainChain::GetHeaviestChain(uint64_t limit) const
   limit = std::min(limit, uint64_t{MainChain::UPPER_BOUND});
   MilliTimer myTimer("MainChain::HeaviestChain");
 
-  FETCH_LOCK(lock_);
+  ReadLock lock{lock_};
 
-  return GetChainPreceding(GetHeaviestBlockHash(), limit);
+  return WalkChain(heaviest_.hash, limit);
 }
 
 /**
@@ -254,13 +285,27 @@ MainChain::Blocks MainChain::GetChainPreceding(BlockHash start, uint64_t limit)
   limit = std::min(limit, uint64_t{MainChain::UPPER_BOUND});
   MilliTimer myTimer("MainChain::ChainPreceding");
 
-  FETCH_LOCK(lock_);
+  ReadLock lock{lock_};
+
+  return WalkChain(std::move(start), limit);
+}
 
+/**
+ * Internal: Walk the block history collecting blocks until either genesis or the block limit is
+ * reached
+ *
+ * @param start The hash of the first block
+ * @param limit The maximum number of blocks to be returned
+ * @return The array of blocks
+ * @throws std::runtime_error if a block lookup occurs
+ */
+MainChain::Blocks MainChain::WalkChain(BlockHash start, uint64_t limit) const
+{
   Blocks result;
 
   // lookup the heaviest block hash
-  BlockPtr  block;
-  BlockHash current_hash = std::move(start);
+  IntBlockPtr block;
+  BlockHash   current_hash = std::move(start);
 
   while (result.size() < limit)
   {
@@ -271,8 +316,7 @@ MainChain::Blocks MainChain::GetChainPreceding(BlockHash start, uint64_t limit)
     }
 
     // lookup the block
-    block = GetBlock(current_hash);
-    if (!block)
+    if (!LookupBlock(current_hash, block))
     {
       FETCH_LOG_ERROR(LOGGING_NAME, "Block lookup failure for block: ", ToBase64(current_hash));
       throw std::runtime_error("Failed to lookup block");
@@ -306,15 +350,15 @@ bool MainChain::GetPathToCommonAncestor(Blocks &blocks, BlockHash tip, BlockHash
   limit = std::min(limit, uint64_t{MainChain::UPPER_BOUND});
   MilliTimer myTimer("MainChain::GetPathToCommonAncestor", 500);
 
-  FETCH_LOCK(lock_);
+  ReadLock lock{lock_};
 
   bool success{true};
 
   // clear the output structure
   blocks.clear();
 
-  BlockPtr left{};
-  BlockPtr right{};
+  IntBlockPtr left{};
+  IntBlockPtr right{};
 
   BlockHash left_hash  = std::move(tip);
   BlockHash right_hash = std::move(node);
@@ -328,8 +372,7 @@ bool MainChain::GetPathToCommonAncestor(Blocks &blocks, BlockHash tip, BlockHash
     // load up the left side
     if (!left || left->body.hash != left_hash)
     {
-      left = GetBlock(left_hash);
-      if (!left)
+      if (!LookupBlock(left_hash, left))
       {
         FETCH_LOG_WARN(LOGGING_NAME, "Unable to lookup block (left): ", ToBase64(left_hash));
         success = false;
@@ -366,8 +409,7 @@ bool MainChain::GetPathToCommonAncestor(Blocks &blocks, BlockHash tip, BlockHash
     // load up the right side
     if (!right || right->body.hash != right_hash)
     {
-      right = GetBlock(right_hash);
-      if (!right)
+      if (!LookupBlock(right_hash, right))
       {
         FETCH_LOG_WARN(LOGGING_NAME, "Unable to lookup block (right): ", ToBase64(right_hash));
         success = false;
@@ -414,12 +456,12 @@ bool MainChain::GetPathToCommonAncestor(Blocks &blocks, BlockHash tip, BlockHash
  */
 MainChain::BlockPtr MainChain::GetBlock(BlockHash hash) const
 {
-  FETCH_LOCK(lock_);
+  ReadLock lock{lock_};
 
   BlockPtr output_block{};
 
   // attempt to lookup the block
-  auto internal_block = std::make_shared<Block>();
+  IntBlockPtr internal_block{};
   if (LookupBlock(std::move(hash), internal_block))
   {
     // convert the pointer type to per const
@@ -436,7 +478,7 @@ MainChain::BlockPtr MainChain::GetBlock(BlockHash hash) const
  */
 MainChain::BlockHashSet MainChain::GetMissingTips() const
 {
-  FETCH_LOCK(lock_);
+  ReadLock lock{lock_};
 
   BlockHashSet tips{};
   for (auto const &element : loose_blocks_)
@@ -462,7 +504,7 @@ MainChain::BlockHashSet MainChain::GetMissingTips() const
 MainChain::BlockHashs MainChain::GetMissingBlockHashes(uint64_t limit) const
 {
   limit = std::min(limit, uint64_t{MainChain::UPPER_BOUND});
-  FETCH_LOCK(lock_);
+  ReadLock lock{lock_};
 
   BlockHashs results;
 
@@ -485,7 +527,7 @@ MainChain::BlockHashs MainChain::GetMissingBlockHashes(uint64_t limit) const
  */
 bool MainChain::HasMissingBlocks() const
 {
-  FETCH_LOCK(lock_);
+  ReadLock lock{lock_};
   return !loose_blocks_.empty();
 }
 
@@ -496,7 +538,7 @@ bool MainChain::HasMissingBlocks() const
  */
 MainChain::BlockHashSet MainChain::GetTips() const
 {
-  FETCH_LOCK(lock_);
+  ReadLock lock{lock_};
 
   BlockHashSet hash_set;
   for (auto const &element : tips_)
@@ -524,6 +566,8 @@ void MainChain::RecoverFromFile(Mode mode)
   if (Mode::CREATE_PERSISTENT_DB == mode)
   {
     block_store_->New("chain.db", "chain.index.db");
+    height_store_->New("chain.heights.db", "chain.heights.index.db");
+    digest_index_.New("chain.digests.db", "chain.digests.index.db");
     head_store_.open("chain.head.db",
                      std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
     return;
@@ -531,6 +575,8 @@ void MainChain::RecoverFromFile(Mode mode)
   else if (Mode::LOAD_PERSISTENT_DB == mode)
   {
     block_store_->Load("chain.db", "chain.index.db");
+    height_store_->Load("chain.heights.db", "chain.heights.index.db");
+    digest_index_.Load("chain.digests.db", "chain.digests.index.db");
     head_store_.open("chain.head.db", std::ios::binary | std::ios::in | std::ios::out);
   }
   else
@@ -545,6 +591,19 @@ void MainChain::RecoverFromFile(Mode mode)
   // retrieve the starting hash
   BlockHash head_block_hash = GetHeadHash();
 
+  // the indices are not flushed atomically with the block store, so the blocks of the chain are
+  // added to them as it is walked (which has no effect on the blocks that were already indexed).
+  // The filter of the digest index must be rebuilt first since it fronts the lookups of the index.
+  auto const restore_indices = [this](Block const &stored) {
+    digest_index_.AddToFilter(stored);
+    digest_index_.Add(stored);
+
+    if (!IsOnPersistedChain(stored))
+    {
+      height_store_->Set(CreateHeightKey(stored.body.block_number), stored.body.hash);
+    }
+  };
+
   bool recovery_complete{false};
   if (!head_block_hash.empty() && block_store_->Get(storage::ResourceID{head_block_hash}, *block))
   {
@@ -552,12 +611,15 @@ void MainChain::RecoverFromFile(Mode mode)
 
     // Save the head
     head = block;
+    restore_indices(*head);
 
     // Copy head block so as to walk down the chain
     IntBlockPtr next = std::make_shared<Block>(*block);
 
     while (block_store_->Get(storage::ResourceID(next->body.previous_hash), *next))
     {
+      restore_indices(*next);
+
       if (next->body.block_number != block_index - 1)
       {
         FETCH_LOG_WARN(LOGGING_NAME,
@@ -580,8 +642,9 @@ void MainChain::RecoverFromFile(Mode mode)
       FETCH_LOG_INFO(LOGGING_NAME,
                      "Recovering main chain with heaviest block: ", head->body.block_number);
 
-      // Add heaviest to cache
-      block_chain_[head->body.hash] = head;
+      // Add heaviest to cache (since it has been loaded from the store its body can be evicted)
+      block_chain_.Set(head);
+      block_chain_.MarkPersisted(head->body.hash);
 
       // Update this as our heaviest
       bool const result      = heaviest_.Update(*head);
@@ -593,13 +656,14 @@ void MainChain::RecoverFromFile(Mode mode)
       }
 
       // Sanity check
-      uint64_t heaviest_block_num = GetHeaviestBlock()->body.block_number;
-      FETCH_LOG_INFO(LOGGING_NAME, "Heaviest block: ", heaviest_block_num);
+      IntBlockPtr heaviest_block{};
+      LookupHeader(heaviest_.hash, heaviest_block);
+      FETCH_LOG_INFO(LOGGING_NAME, "Heaviest block: ", heaviest_block->body.block_number);
 
       DetermineHeaviestTip();
-      heaviest_block_num = GetHeaviestBlock()->body.block_number;
-      FETCH_LOG_INFO(LOGGING_NAME, "Heaviest block now: ", heaviest_block_num);
-      FETCH_LOG_INFO(LOGGING_NAME, "Heaviest block weight: ", GetHeaviestBlock()->total_weight);
+      LookupHeader(heaviest_.hash, heaviest_block);
+      FETCH_LOG_INFO(LOGGING_NAME, "Heaviest block now: ", heaviest_block->body.block_number);
+      FETCH_LOG_INFO(LOGGING_NAME, "Heaviest block weight: ", heaviest_block->total_weight);
 
       // signal that the recovery was successful
       recovery_complete = true;
@@ -615,6 +679,8 @@ void MainChain::RecoverFromFile(Mode mode)
   if (!recovery_complete)
   {
     block_store_->New("chain.db", "chain.index.db");
+    height_store_->New("chain.heights.db", "chain.heights.index.db");
+    digest_index_.New("chain.digests.db", "chain.digests.index.db");
 
     // reopen the file and clear the contents
     head_store_.close();
@@ -629,10 +695,17 @@ void MainChain::RecoverFromFile(Mode mode)
 void MainChain::WriteToFile()
 {
   // lookup the heaviest block
-  IntBlockPtr block = block_chain_.at(heaviest_.hash);
+  IntBlockPtr block{};
+  if (!LookupBlockFromCache(heaviest_.hash, block))
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Unable to lookup the heaviest block when writing to file");
+    return;
+  }
+
+  uint64_t const heaviest_block_num = block->body.block_number;
 
   // skip if the block store is not persistent
-  if (block_store_ && (block->body.block_number >= FINALITY_PERIOD))
+  if (block_store_ && (heaviest_block_num >= FINALITY_PERIOD))
   {
     MilliTimer myTimer("MainChain::WriteToFile", 500);
 
@@ -653,7 +726,7 @@ void MainChain::WriteToFile()
     {
       FETCH_LOG_WARN(LOGGING_NAME,
                      "Failed to walk back the chain when writing to file! Block head: ",
-                     block_chain_.at(heaviest_.hash)->body.block_number);
+                     heaviest_block_num);
       return;
     }
 
@@ -663,7 +736,7 @@ void MainChain::WriteToFile()
     {
       FETCH_LOG_DEBUG(LOGGING_NAME, "Writing genesis. ");
 
-      block_store_->Set(storage::ResourceID(block->body.hash), *block);
+      PersistBlock(block);
       SetHeadHash(block->body.hash);
     }
     else
@@ -675,13 +748,14 @@ void MainChain::WriteToFile()
       IntBlockPtr block_head        = block;
 
       block_store_->Get(storage::ResourceID(GetHeadHash()), *current_file_head);
+      uint64_t const file_head_number = current_file_head->body.block_number;
 
       // Now keep adding the block and its prev to the file until we are certain the file contains
       // an unbroken chain. Assuming that the current_file_head is unbroken we can write until we
       // touch it or it's root.
       for (;;)
       {
-        block_store_->Set(storage::ResourceID(block->body.hash), *block);
+        PersistBlock(block);
 
         // Keep the current_file_head one block behind
         while (current_file_head->body.block_number != block->body.block_number - 1)
@@ -700,15 +774,25 @@ void MainChain::WriteToFile()
         LookupBlock(block->body.previous_hash, block);
       }
 
+      // the blocks of a replaced branch which extend beyond the new head are no longer part of
+      // the persisted chain
+      for (uint64_t number = block_head->body.block_number + 1; number <= file_head_number;
+           ++number)
+      {
+        height_store_->Erase(CreateHeightKey(number));
+      }
+
       // Success - we kept a copy of the new head to write
       SetHeadHash(block_head->body.hash);
     }
 
-    // Clear the block from ram
+    // Clear the block from the tips
     FlushBlock(block);
 
     // Force flush of the file object!
     block_store_->Flush(false);
+    height_store_->Flush(false);
+    digest_index_.Flush();
 
     // as final step do some sanity checks
     TrimCache();
@@ -718,59 +802,71 @@ void MainChain::WriteToFile()
 /**
  * Trim the in memory cache
  *
+ * Blocks which have not been written to the block store (i.e. stale forks and loose blocks) are
+ * removed once they fall outside of the finality period. Blocks which have been written to the
+ * block store are retained for much longer, since the cache evicts their bodies as required and
+ * only their headers remain in memory.
+ *
  * Only should be called if the block store is being used
  */
 void MainChain::TrimCache()
 {
-  static const uint64_t CACHE_TRIM_THRESHOLD = 2 * FINALITY_PERIOD;
+  static const uint64_t CACHE_TRIM_THRESHOLD  = 2 * FINALITY_PERIOD;
+  static const uint64_t HEADER_TRIM_THRESHOLD = 1000 * FINALITY_PERIOD;
   assert(static_cast<bool>(block_store_));
 
   MilliTimer myTimer("MainChain::TrimCache");
 
-  FETCH_LOCK(lock_);
+  IntBlockPtr heaviest_block{};
+  if (!LookupHeader(heaviest_.hash, heaviest_block))
+  {
+    return;
+  }
 
-  uint64_t const heaviest_block_num = GetHeaviestBlock()->body.block_number;
+  uint64_t const heaviest_block_num = heaviest_block->body.block_number;
 
   if (CACHE_TRIM_THRESHOLD < heaviest_block_num)
   {
-    uint64_t const trim_threshold = heaviest_block_num - CACHE_TRIM_THRESHOLD;
+    uint64_t const trim_threshold   = heaviest_block_num - CACHE_TRIM_THRESHOLD;
+    bool const     trim_headers     = HEADER_TRIM_THRESHOLD < heaviest_block_num;
+    uint64_t const header_threshold = trim_headers ? heaviest_block_num - HEADER_TRIM_THRESHOLD : 0;
+
+    // Loop through the block cache looking for blocks which are outside of our finality period.
+    // This is needed to ensure that the block cache does not grow forever
+    std::vector<IntBlockPtr> trimmed_blocks{};
+    block_chain_.ForEach([&](IntBlockPtr const &block, bool persisted) {
+      if (persisted ? (trim_headers && (header_threshold >= block->body.block_number))
+                    : (trim_threshold >= block->body.block_number))
+      {
+        trimmed_blocks.push_back(block);
+      }
+    });
 
-    // Loop through the block chain store looking for blocks which are outside of our finality
-    // period. This is needed to ensure that the block chain map does not grow forever
-    auto chain_it = block_chain_.begin();
-    while (chain_it != block_chain_.end())
+    for (auto const &trimmed_block : trimmed_blocks)
     {
-      auto const &block = chain_it->second->body;
+      auto const &block = trimmed_block->body;
 
-      if (trim_threshold >= block.block_number)
-      {
-        FETCH_LOG_INFO(LOGGING_NAME, "Removing loose block: 0x", block.hash.ToHex());
+      FETCH_LOG_INFO(LOGGING_NAME, "Removing loose block: 0x", block.hash.ToHex());
 
-        // remove the entry from the tips map
-        tips_.erase(block.hash);
+      // remove the entry from the tips map
+      tips_.erase(block.hash);
 
-        // remove any reference in the loose map
-        auto loose_it = loose_blocks_.find(block.previous_hash);
-        if (loose_it != loose_blocks_.end())
+      // remove any reference in the loose map
+      auto loose_it = loose_blocks_.find(block.previous_hash);
+      if (loose_it != loose_blocks_.end())
+      {
+        // remove the hash from the list
+        loose_it->second.remove(block.hash);
+
+        // if, as a result, the list is empty then also remove the entry from the loose blocks
+        if (loose_it->second.empty())
         {
-          // remove the hash from the list
-          loose_it->second.remove(block.hash);
-
-          // if, as a result, the list is empty then also remove the entry from the loose blocks
-          if (loose_it->second.empty())
-          {
-            loose_blocks_.erase(loose_it);
-          }
+          loose_blocks_.erase(loose_it);
         }
-
-        // remove the entry from the main block chain
-        chain_it = block_chain_.erase(chain_it);
-      }
-      else
-      {
-        // normal case advance to the next one
-        ++chain_it;
       }
+
+      // remove the entry from the block cache
+      block_chain_.Erase(block.hash);
     }
   }
 
@@ -792,25 +888,62 @@ void MainChain::TrimCache()
 }
 
 /**
- * Internal: Remove the block from the cache and remove any tips
+ * Internal: Remove any tips for a block which has been written to the block store. The block itself
+ * is retained in the cache, which will evict its body when required.
  *
  * @param block The block to be flushed
  */
 void MainChain::FlushBlock(IntBlockPtr const &block)
 {
-  // remove the block from the block map
-  block_chain_.erase(block->body.hash);
-
   // remove the block hash from the tips
   tips_.erase(block->body.hash);
 }
 
+/**
+ * Internal: Write a block to the block store, allowing its body to be evicted from the cache
+ *
+ * @param block The block to be written
+ */
+void MainChain::PersistBlock(IntBlockPtr const &block)
+{
+  block_store_->Set(storage::ResourceID(block->body.hash), *block);
+  block_chain_.MarkPersisted(block->body.hash);
+
+  // the block replaces any block of a previously persisted branch at the same height
+  height_store_->Set(CreateHeightKey(block->body.block_number), block->body.hash);
+}
+
+/**
+ * Internal: Determine if a block is part of the persisted chain. The block store also contains the
+ * blocks of the branches which were replaced after they had been written, so this is only the case
+ * when it is the block recorded at its height.
+ *
+ * @param block The block to be checked
+ * @return true if the block is on the persisted chain, otherwise false
+ */
+bool MainChain::IsOnPersistedChain(Block const &block) const
+{
+  return IsOnPersistedChain(block.body.block_number, block.body.hash);
+}
+
+/**
+ * Internal: Determine if a block is part of the persisted chain
+ *
+ * @param block_number The number of the block to be checked
+ * @param hash The hash of the block to be checked
+ * @return true if the block is on the persisted chain, otherwise false
+ */
+bool MainChain::IsOnPersistedChain(uint64_t block_number, BlockHash const &hash) const
+{
+  BlockHash persisted_hash{};
+  return height_store_ && height_store_->Get(CreateHeightKey(block_number), persisted_hash) &&
+         (persisted_hash == hash);
+}
+
 // We have added a non-loose block. It is then safe to lock the loose blocks map and
 // walk through it adding the blocks, so long as we do breadth first search (!!)
 void MainChain::CompleteLooseBlocks(IntBlockPtr const &block)
 {
-  FETCH_LOCK(lock_);
-
   // Determine if this block is actually a loose block, if it isn't exit immediately
   auto it = loose_blocks_.find(block->body.hash);
   if (it == loose_blocks_.end())
@@ -835,8 +968,13 @@ void MainChain::CompleteLooseBlocks(IntBlockPtr const &block)
     // get pushed with the next layer of blocks
     for (auto const &hash : blocks_to_add)
     {
-      // This should be guaranteed safe
-      IntBlockPtr add_block = block_chain_.at(hash);  // TODO(EJF): What happens when this fails
+      // Loose blocks are never written to the block store and so are always complete in the cache
+      IntBlockPtr add_block{};
+      if (!LookupBlockFromCache(hash, add_block))
+      {
+        FETCH_LOG_WARN(LOGGING_NAME, "Unable to lookup loose block: 0x", hash.ToHex());
+        continue;
+      }
 
       // This won't re-call this function due to the flag
       InsertBlock(add_block, false);
@@ -864,14 +1002,12 @@ void MainChain::CompleteLooseBlocks(IntBlockPtr const &block)
  */
 void MainChain::RecordLooseBlock(IntBlockPtr const &block)
 {
-  FETCH_LOCK(lock_);
-
   // Get vector of waiting blocks and push ours on
   auto &waiting_blocks = loose_blocks_[block->body.previous_hash];
   waiting_blocks.push_back(block->body.hash);
 
-  block->is_loose                = true;
-  block_chain_[block->body.hash] = block;
+  block->is_loose = true;
+  block_chain_.Set(block);
 }
 
 /**
@@ -908,8 +1044,6 @@ BlockStatus MainChain::InsertBlock(IntBlockPtr const &block, bool evaluate_loose
 
   MilliTimer myTimer("MainChain::InsertBlock", 500);
 
-  FETCH_LOCK(lock_);
-
   if (block->body.hash.empty())
   {
     FETCH_LOG_WARN(LOGGING_NAME, "Block discard due to lack of digest");
@@ -936,8 +1070,8 @@ BlockStatus MainChain::InsertBlock(IntBlockPtr const &block, bool evaluate_loose
       return BlockStatus::DUPLICATE;
     }
 
-    // Determine if the block is present in the cache
-    if (LookupBlock(block->body.previous_hash, prev_block))
+    // Determine if the block is present in the cache (only the header of the block is required)
+    if (LookupHeader(block->body.previous_hash, prev_block))
     {
       // TODO(EJF): Add check to validate the block number (it is relied on heavily now)
       if (block->body.block_number != (prev_block->body.block_number + 1))
@@ -969,7 +1103,7 @@ BlockStatus MainChain::InsertBlock(IntBlockPtr const &block, bool evaluate_loose
   {
     // This branch is a small optimisation since loose / missing blocks are not flushed to disk
 
-    if (!LookupBlockFromCache(block->body.previous_hash, prev_block))
+    if (!block_chain_.GetHeader(block->body.previous_hash, prev_block))
     {
       // This is currently only called from inside CompleteLooseBlocks and it is invariant on the
       // return value. For completeness this block is however loose because the parent can not be
@@ -1002,6 +1136,7 @@ BlockStatus MainChain::InsertBlock(IntBlockPtr const &block, bool evaluate_loose
   // Add block
   FETCH_LOG_DEBUG(LOGGING_NAME, "Adding block to chain: 0x", block->body.hash.ToHex());
   AddBlockToCache(block);
+  digest_index_.Add(*block);
 
   // If the heaviest branch has been updated we should determine if any blocks should be flushed
   // to disk
@@ -1037,7 +1172,7 @@ bool MainChain::LookupBlock(BlockHash hash, IntBlockPtr &block, bool add_to_cach
 }
 
 /**
- * Attempt to locate a block stored in the im memory cache
+ * Attempt to locate a complete block stored in the in memory cache
  *
  * @param hash The hash of the block to search for
  * @param block The output block to be populated
@@ -1045,19 +1180,7 @@ bool MainChain::LookupBlock(BlockHash hash, IntBlockPtr &block, bool add_to_cach
  */
 bool MainChain::LookupBlockFromCache(BlockHash hash, IntBlockPtr &block) const
 {
-  bool success{false};
-
-  FETCH_LOCK(lock_);
-
-  // perform the lookup
-  auto const it = block_chain_.find(hash);
-  if ((block_chain_.end() != it))
-  {
-    block   = it->second;
-    success = true;
-  }
-
-  return success;
+  return block_chain_.Get(hash, block);
 }
 
 /**
@@ -1084,8 +1207,9 @@ bool MainChain::LookupBlockFromStorage(BlockHash hash, IntBlockPtr &block, bool
       // hash not serialised, needs to be recomputed
       output_block->UpdateDigest();
 
-      // add the newly loaded block to the cache (if required)
-      if (add_to_cache)
+      // restore the body of the block if it has been evicted from the cache, otherwise add the
+      // newly loaded block to the cache (if required)
+      if (!block_chain_.Restore(output_block) && add_to_cache)
       {
         AddBlockToCache(output_block);
       }
@@ -1099,14 +1223,29 @@ bool MainChain::LookupBlockFromStorage(BlockHash hash, IntBlockPtr &block, bool
 }
 
 /**
- * No Locking: Determine is a specified block is in the cache
+ * Attempt to lookup the header of a block. The returned block might not contain its transactions.
+ *
+ * The search is performed initially on the in memory cache (where the headers of the blocks are
+ * pinned) and then if this fails the persistent disk storage is searched
+ *
+ * @param hash The hash of the block to search for
+ * @param block The output block to be populated
+ * @return true if successful, otherwise false
+ */
+bool MainChain::LookupHeader(BlockHash hash, IntBlockPtr &block) const
+{
+  return block_chain_.GetHeader(hash, block) || LookupBlockFromStorage(hash, block, false);
+}
+
+/**
+ * Determine is a specified block is in the cache
  *
  * @param hash The hash to query
  * @return true if the block is present, otherwise false
  */
 bool MainChain::IsBlockInCache(BlockHash hash) const
 {
-  return block_chain_.find(hash) != block_chain_.end();
+  return block_chain_.Has(hash);
 }
 
 /**
@@ -1118,11 +1257,8 @@ void MainChain::AddBlockToCache(IntBlockPtr const &block) const
 {
   block->is_loose = false;
 
-  if (!IsBlockInCache(block->body.hash))
-  {
-    // add the item to the block chain storage
-    block_chain_.emplace(block->body.hash, block);
-  }
+  // add the item to the block cache (if not already present)
+  block_chain_.Add(block);
 }
 
 /**
@@ -1132,8 +1268,6 @@ void MainChain::AddBlockToCache(IntBlockPtr const &block) const
  */
 bool MainChain::AddTip(IntBlockPtr const &block)
 {
-  FETCH_LOCK(lock_);
-
   // record the tip weight
   tips_[block->body.hash] = Tip{block->total_weight};
 
@@ -1149,8 +1283,6 @@ bool MainChain::DetermineHeaviestTip()
 {
   bool success{false};
 
-  FETCH_LOCK(lock_);
-
   if (!tips_.empty())
   {
     // find the heaviest item in our tip selection
@@ -1182,17 +1314,25 @@ bool MainChain::DetermineHeaviestTip()
  */
 bool MainChain::ReindexTips()
 {
-  // TODO(private issue 666): Improve performance of block removal
   FETCH_LOCK(lock_);
+  return RebuildTips();
+}
+
+/**
+ * Internal: Rebuild the tips from the blocks in the cache
+ *
+ * @return true if successful, otherwise false
+ */
+bool MainChain::RebuildTips()
+{
+  // TODO(private issue 666): Improve performance of block removal
 
   // Step 1. Generate a new set of blocks (so that we can order them)
   std::vector<IntBlockPtr> block_list{};
   block_list.reserve(block_chain_.size());
 
-  for (auto const &block : block_chain_)
-  {
-    block_list.push_back(block.second);
-  }
+  block_chain_.ForEach(
+      [&block_list](IntBlockPtr const &block, bool) { block_list.push_back(block); });
 
   // Step 2. Order the blocks so that we have a good order for them to be evaluated
   std::sort(block_list.begin(), block_list.end(), [](IntBlockPtr const &a, IntBlockPtr const &b) {
@@ -1225,7 +1365,7 @@ bool MainChain::ReindexTips()
   IntBlockPtr block;
   for (auto const &tip : tips)
   {
-    if (!LookupBlockFromCache(tip, block))
+    if (!block_chain_.GetHeader(tip, block))
     {
       return false;
     }
@@ -1264,7 +1404,7 @@ MainChain::IntBlockPtr MainChain::CreateGenesisBlock()
  */
 MainChain::BlockHash MainChain::GetHeaviestBlockHash() const
 {
-  FETCH_LOCK(lock_);
+  ReadLock lock{lock_};
   return heaviest_.hash;
 }
 
@@ -1324,6 +1464,11 @@ void MainChain::SetHeadHash(BlockHash const &hash)
 /**
  * Strip transactions in container that already exist in the blockchain
  *
+ * The locations of the transactions are found from the digest index, so only the headers of the
+ * chain between the starting block and the oldest location need to be examined. The walk stops
+ * early once it reaches a block on the persisted chain, since the older locations can then be
+ * checked against the blocks recorded at their heights.
+ *
  * @param: starting_hash Block to start looking downwards from
  * @tparam: transaction The set of transaction to be filtered
  *
@@ -1336,43 +1481,88 @@ DigestSet MainChain::DetectDuplicateTransactions(BlockHash        starting_hash,
 
   FETCH_LOG_DEBUG(LOGGING_NAME, "Starting TX uniqueness verify");
 
+  // the shared lock is only held for each lookup, so that the walk does not block other threads
   IntBlockPtr block;
-  if (!LookupBlock(std::move(starting_hash), block, false) || block->is_loose)
+  {
+    ReadLock lock{lock_};
+    if (!LookupHeader(std::move(starting_hash), block) || block->is_loose)
+    {
+      block.reset();
+    }
+  }
+
+  if (!block)
   {
     FETCH_LOG_WARN(LOGGING_NAME, "TX uniqueness verify on bad block hash");
     return {};
   }
 
-  // Need a set for quickly checking whether transactions are in our container
-  DigestSet duplicates{};
-  bool      searching{true};
-  while (searching)
+  // find all the blocks (on any branch) which contain the transactions
+  auto const locations = digest_index_.Lookup(transactions);
+
+  // determine the oldest block which could be an ancestor of the starting block
+  uint64_t lowest_block_number = std::numeric_limits<uint64_t>::max();
+  for (auto const &entry : locations)
   {
-    // Traversing the chain fully is costly: break out early if we know the transactions are all
-    // duplicated (or empty)
-    if (transactions.size() == duplicates.size())
+    for (auto const &location : entry.second)
     {
-      break;
+      if (location.block_number <= block->body.block_number)
+      {
+        lowest_block_number = std::min(lowest_block_number, location.block_number);
+      }
     }
+  }
+
+  // walk the headers of the chain down to the oldest location
+  DigestSet ancestors{};
+  bool      reached_store{false};
+  uint64_t  store_block_number{0};
+  while (block->body.block_number >= lowest_block_number)
+  {
+    ancestors.insert(block->body.hash);
 
-    for (auto const &slice : block->body.slices)
+    ReadLock lock{lock_};
+
+    // blocks which are not in the cache have been loaded from the block store, although only the
+    // blocks on the persisted chain can be used to resolve the older locations
+    if (block_store_ &&
+        (block_chain_.IsPersisted(block->body.hash) || !block_chain_.Has(block->body.hash)) &&
+        IsOnPersistedChain(*block))
     {
-      for (auto const &tx : slice)
-      {
-        if (transactions.find(tx.digest()) != transactions.end())
-        {
-          duplicates.insert(tx.digest());
-        }
-      }
+      reached_store      = true;
+      store_block_number = block->body.block_number;
+      break;
     }
 
     // exit the loop once we can no longer find the block
-    if (!LookupBlock(block->body.previous_hash, block, false))
+    if (!LookupHeader(block->body.previous_hash, block))
     {
       break;
     }
   }
 
+  DigestSet duplicates{};
+  {
+    ReadLock lock{lock_};
+
+    for (auto const &entry : locations)
+    {
+      for (auto const &location : entry.second)
+      {
+        bool const is_ancestor =
+            (ancestors.find(location.block_hash) != ancestors.end()) ||
+            (reached_store && (location.block_number <= store_block_number) &&
+             IsOnPersistedChain(location.block_number, location.block_hash));
+
+        if (is_ancestor)
+        {
+          duplicates.insert(entry.first);
+          break;
+        }
+      }
+    }
+  }
+
   return duplicates;
 }
 
@@ -46,6 +46,29 @@ uint64_t Transaction::GetTotalTransferAmount() const
  * @return
  */
 bool Transaction::Verify()
+{
+  return Verify(nullptr);
+}
+
+/**
+ * Verify the contents of the transaction, looking up the signatories' public keys in the specified
+ * cache
+ *
+ * @param key_cache The cache of parsed public keys
+ * @return true if the transaction is verified, otherwise false
+ */
+bool Transaction::Verify(crypto::PublicKeyCache &key_cache)
+{
+  return Verify(&key_cache);
+}
+
+/**
+ * Internal: Verify the contents of the transaction
+ *
+ * @param key_cache The (optional) cache of parsed public keys
+ * @return true if the transaction is verified, otherwise false
+ */
+bool Transaction::Verify(crypto::PublicKeyCache *key_cache)
 {
   if (!verification_completed_)
   {
@@ -63,7 +86,12 @@ bool Transaction::Verify()
       for (auto const &signatory : signatories_)
       {
         // verify the signature
-        if (!crypto::Verifier::Verify(signatory.identity, payload, signatory.signature))
+        bool const signature_valid =
+            (key_cache != nullptr)
+                ? key_cache->Verify(signatory.identity, payload, signatory.signature)
+                : crypto::Verifier::Verify(signatory.identity, payload, signatory.signature);
+
+        if (!signature_valid)
         {
           // exit as soon as the first non valid signature is detected
           all_verified = false;
@@ -19,6 +19,7 @@
 #include "ledger/chain/transaction_serializer.hpp"
 #include "core/byte_array/byte_array.hpp"
 #include "core/serializers/byte_array_buffer.hpp"
+#include "core/serializers/counter.hpp"
 #include "crypto/sha256.hpp"
 #include "ledger/chain/transaction.hpp"
 #include "meta/type_traits.hpp"
@@ -33,6 +34,7 @@ using byte_array::ConstByteArray;
 using crypto::Identity;
 using serializers::ByteArrayBuffer;
 
+using SizeCounter  = serializers::SizeCounter<ByteArrayBuffer>;
 using TokenAmount  = Transaction::TokenAmount;
 using ContractMode = Transaction::ContractMode;
 
@@ -67,11 +69,6 @@ uint8_t Map(ContractMode mode)
   return value;
 }
 
-ConstByteArray Encode(Address const &address)
-{
-  return address.address();
-}
-
 template <typename T>
 meta::IfIsUnsignedInteger<T, T> ToUnsigned(T value)
 {
@@ -97,17 +94,31 @@ meta::IfIsSignedInteger<T, T> Negate(T value)
   return static_cast<T>(-value);
 }
 
-template <typename T>
-meta::IfIsInteger<T, ConstByteArray> Encode(T value)
+template <typename W>
+void WriteByte(W &writer, uint8_t value)
+{
+  writer.WriteBytes(&value, 1u);
+}
+
+template <typename W>
+void Encode(W &writer, Address const &address)
+{
+  auto const &raw_address = address.address();
+  writer.WriteBytes(raw_address.pointer(), raw_address.size());
+}
+
+template <typename W, typename T>
+meta::IfIsInteger<T> Encode(W &writer, T value)
 {
   using U = typename std::make_unsigned<T>::type;
 
   bool const is_signed = meta::IsSignedInteger<T> && (value < 0);
 
-  ByteArray encoded;
+  uint8_t     encoded[sizeof(U) + 1u];
+  std::size_t encoded_length{1};
+
   if (!is_signed && (value <= T{0x7f}))
   {
-    encoded.Resize(1);
     encoded[0] = static_cast<uint8_t>(value & 0x7f);
   }
   else
@@ -116,7 +127,6 @@ meta::IfIsInteger<T, ConstByteArray> Encode(T value)
 
     if (is_signed && (abs_value <= 0x1F))
     {
-      encoded.Resize(1);
       encoded[0] = 0xE0 | static_cast<uint8_t>(abs_value);
     }
     else
@@ -139,9 +149,7 @@ meta::IfIsInteger<T, ConstByteArray> Encode(T value)
 
       // calculate the actual number of bytes that will be required
       std::size_t const bytes_required = 1u << log2_bytes_required;
-
-      // resize the buffer and encode the value
-      encoded.Resize(bytes_required + 1u);
+      encoded_length                   = bytes_required + 1u;
 
       // write out the header
       encoded[0] = static_cast<uint8_t>((is_signed) ? 0xD0u : 0xC0u) |
@@ -166,40 +174,37 @@ meta::IfIsInteger<T, ConstByteArray> Encode(T value)
     }
   }
 
-  return {encoded};
+  writer.WriteBytes(encoded, encoded_length);
 }
 
-ConstByteArray Encode(ConstByteArray const &value)
+template <typename W>
+void Encode(W &writer, ConstByteArray const &value)
 {
-  auto const length = Encode(value.size());
-  return length + value;
+  Encode(writer, value.size());
+  writer.WriteBytes(value.pointer(), value.size());
 }
 
-ConstByteArray Encode(BitVector const &bits)
+template <typename W>
+void Encode(W &writer, BitVector const &bits)
 {
   auto const *      raw_data   = reinterpret_cast<uint8_t const *>(bits.data().pointer());
   std::size_t const raw_length = bits.data().size() * sizeof(BitVector::Block);
   std::size_t const size_bytes = bits.size() >> 3u;
   std::size_t const offset     = (raw_length - size_bytes) + 1;
 
-  // create and populate the array
-  ByteArray array;
-  array.Resize(size_bytes);
-
   for (std::size_t i = 0, j = raw_length - offset; i < size_bytes; ++i, --j)
   {
-    array[i] = raw_data[j];
+    writer.WriteBytes(&raw_data[j], 1u);
   }
-
-  return {array};
 }
 
-ConstByteArray Encode(Identity const &identity)
+template <typename W>
+void Encode(W &writer, Identity const &identity)
 {
-  ByteArray buffer;
-  buffer.Append(uint8_t{0x04}, identity.identifier());
+  auto const &identifier = identity.identifier();
 
-  return {buffer};
+  WriteByte(writer, 0x04);
+  writer.WriteBytes(identifier.pointer(), identifier.size());
 }
 
 void Decode(ByteArrayBuffer &buffer, Address &address)
@@ -346,27 +351,21 @@ void Decode(ByteArrayBuffer &buffer, Identity &identity)
   identity = Identity{std::move(public_key)};
 }
 
-}  // namespace
-
-TransactionSerializer::TransactionSerializer(ConstByteArray data)
-  : serial_data_{std::move(data)}
-{}
-
-ByteArray TransactionSerializer::SerializePayload(Transaction const &tx)
+/**
+ * Write the payload section of the transaction, i.e. everything apart from the signatures
+ *
+ * @tparam W The type of the writer (a buffer or a size counter)
+ * @param writer The writer to be populated
+ * @param tx The transaction to be written
+ */
+template <typename W>
+void WritePayload(W &writer, Transaction const &tx)
 {
   std::size_t const num_transfers  = tx.transfers().size();
   std::size_t const num_signatures = tx.signatories().size();
 
   auto const contract_mode = tx.contract_mode();
 
-  // make an estimate for the serial size of the transaction and reserve this amount of buffer
-  // space
-  std::size_t const estimated_transaction_size = (num_transfers * 64u) + (num_signatures * 128u) +
-                                                 tx.data().size() + tx.action().size() + 256u;
-
-  ByteArray buffer;
-  buffer.Reserve(estimated_transaction_size);
-
   // determine how to signal the number of signatures
   assert(num_signatures >= 1);
   std::size_t const num_extra_signatures = (num_signatures >= 0x40u) ? (num_signatures - 0x40u) : 0;
@@ -380,7 +379,8 @@ ByteArray TransactionSerializer::SerializePayload(Transaction const &tx)
   header0 |= static_cast<uint8_t>((num_transfers ? 1u : 0) << 2u);
   header0 |= static_cast<uint8_t>(((num_transfers > 1u) ? 1u : 0) << 1u);
   header0 |= static_cast<uint8_t>(has_valid_from ? 1u : 0);
-  buffer.Append(MAGIC, header0);
+  WriteByte(writer, MAGIC);
+  WriteByte(writer, header0);
 
   uint8_t header1{0};
 
@@ -388,29 +388,31 @@ ByteArray TransactionSerializer::SerializePayload(Transaction const &tx)
 
   header1 |= contract_mode_field;
   header1 |= static_cast<uint8_t>(signalled_signatures) & 0x3Fu;
-  buffer.Append(header1);
+  WriteByte(writer, header1);
 
-  buffer.Append(Encode(tx.from()));
+  Encode(writer, tx.from());
 
   if (num_transfers > 1u)
   {
-    buffer.Append(Encode(num_transfers - 2u));
+    Encode(writer, num_transfers - 2u);
   }
 
   for (auto const &transfer : tx.transfers())
   {
-    buffer.Append(Encode(transfer.to), Encode(transfer.amount));
+    Encode(writer, transfer.to);
+    Encode(writer, transfer.amount);
   }
 
   if (has_valid_from)
   {
-    buffer.Append(Encode(tx.valid_from()));
+    Encode(writer, tx.valid_from());
   }
 
-  buffer.Append(Encode(tx.valid_until()));
+  Encode(writer, tx.valid_until());
 
   // TODO(private issue 885): Increase efficiency by signaling with the charge_unit_flag
-  buffer.Append(Encode(tx.charge()), Encode(tx.charge_limit()));
+  Encode(writer, tx.charge());
+  Encode(writer, tx.charge_limit());
 
   // handle the signalling of the contract mode
   if (ContractMode::NOT_PRESENT != contract_mode)
@@ -422,7 +424,7 @@ ByteArray TransactionSerializer::SerializePayload(Transaction const &tx)
     {
       // in this case we are either explicitly signalling a wildcard or implicitly because the shard
       // mask length is 1.
-      buffer.Append(uint8_t{0x80});
+      WriteByte(writer, 0x80);
     }
     else
     {
@@ -441,7 +443,7 @@ ByteArray TransactionSerializer::SerializePayload(Transaction const &tx)
           contract_header |= static_cast<uint8_t>(0x10u);
         }
 
-        buffer.Append(contract_header);
+        WriteByte(writer, contract_header);
       }
       else
       {
@@ -454,58 +456,191 @@ ByteArray TransactionSerializer::SerializePayload(Transaction const &tx)
             static_cast<uint8_t>(0x40u) | static_cast<uint8_t>((log2_shard_mask_size - 3) & 0x3Fu);
 
         // write the header and the corresponding bytes
-        buffer.Append(contract_header, Encode(shard_mask));
+        WriteByte(writer, contract_header);
+        Encode(writer, shard_mask);
       }
     }
 
     switch (tx.contract_mode())
     {
     case ContractMode::PRESENT:
-      buffer.Append(Encode(tx.contract_digest()), Encode(tx.contract_address()));
+      Encode(writer, tx.contract_digest());
+      Encode(writer, tx.contract_address());
       break;
     case ContractMode::CHAIN_CODE:
-      buffer.Append(Encode(tx.chain_code()));
+      Encode(writer, tx.chain_code());
       break;
     default:
       break;
     }
 
-    // add the action and data to the buffer
-    buffer.Append(Encode(tx.action()), Encode(tx.data()));
+    // add the action and data
+    Encode(writer, tx.action());
+    Encode(writer, tx.data());
   }
 
   if (num_extra_signatures > 0)
   {
-    buffer.Append(Encode(num_extra_signatures));
+    Encode(writer, num_extra_signatures);
   }
 
   for (auto const &signatory : tx.signatories())
   {
-    buffer.Append(Encode(signatory.identity));
+    Encode(writer, signatory.identity);
   }
+}
 
-  return buffer;
+/**
+ * Write the signatures of the transaction, these follow the payload
+ *
+ * @tparam W The type of the writer (a buffer or a size counter)
+ * @param writer The writer to be populated
+ * @param tx The transaction to be written
+ */
+template <typename W>
+void WriteSignatures(W &writer, Transaction const &tx)
+{
+  for (auto const &signatory : tx.signatories())
+  {
+    Encode(writer, signatory.signature);
+  }
 }
 
-bool TransactionSerializer::Serialize(Transaction const &tx)
+/**
+ * Serialize the transaction in two passes. The first pass computes the exact size of the output
+ * so that the buffer is allocated once and never grows while it is being written.
+ *
+ * @param tx The transaction to be serialized
+ * @param include_signatures Flag to signal if the signatures should follow the payload
+ * @return The serialized transaction
+ */
+ByteArray Write(Transaction const &tx, bool include_signatures)
 {
-  // serialize the actual buffer
-  auto buffer = SerializePayload(tx);
+  SizeCounter counter;
+  WritePayload(counter, tx);
+  if (include_signatures)
+  {
+    WriteSignatures(counter, tx);
+  }
 
-  for (auto const &signatory : tx.signatories())
+  ByteArrayBuffer buffer;
+  buffer.Resize(counter.tell(), ResizeParadigm::ABSOLUTE, false);
+
+  WritePayload(buffer, tx);
+  if (include_signatures)
   {
-    buffer.Append(Encode(signatory.signature));
+    WriteSignatures(buffer, tx);
   }
 
-  // update the serial data
-  serial_data_ = std::move(buffer);
+  assert(buffer.tell() == buffer.size());
+
+  return buffer.data();
+}
+
+}  // namespace
+
+TransactionSerializer::TransactionSerializer(ConstByteArray data)
+  : serial_data_{std::move(data)}
+{}
+
+ByteArray TransactionSerializer::SerializePayload(Transaction const &tx)
+{
+  return Write(tx, false);
+}
+
+bool TransactionSerializer::Serialize(Transaction const &tx)
+{
+  serial_data_ = Write(tx, true);
 
   return true;
 }
 
 bool TransactionSerializer::Deserialize(Transaction &tx) const
 {
-  serializers::ByteArrayBuffer buffer{serial_data_};
+  ConstByteArray payload{};
+  if (!DecodeTransaction(serial_data_, tx, payload))
+  {
+    return false;
+  }
+
+  crypto::SHA256 hash_function{};
+  hash_function.Update(payload);
+
+  for (auto const &signatory : tx.signatories_)
+  {
+    hash_function.Update(signatory.signature);
+  }
+
+  // compute the hash function
+  tx.digest_ = hash_function.Final();
+
+  return true;
+}
+
+/**
+ * Deserialize a batch of transactions. Equivalent to deserializing each of the transactions in
+ * turn, however the digests of the transactions are computed as a single batch.
+ *
+ * @param data The serialized transactions
+ * @param txs The output transactions
+ * @return true if all the transactions were successfully deserialized, otherwise false
+ */
+bool TransactionSerializer::DeserializeBatch(ConstByteArrayList const &data, TransactionList &txs)
+{
+  txs.clear();
+  txs.resize(data.size());
+
+  crypto::SHA256::MessageList messages(data.size());
+  for (std::size_t i = 0; i < data.size(); ++i)
+  {
+    auto &tx = txs[i];
+
+    ConstByteArray payload{};
+    if (!DecodeTransaction(data[i], tx, payload))
+    {
+      return false;
+    }
+
+    // the digest covers the payload followed by each of the signatures
+    std::size_t message_size = payload.size();
+    for (auto const &signatory : tx.signatories_)
+    {
+      message_size += signatory.signature.size();
+    }
+
+    ByteArray message{};
+    message.Reserve(message_size);
+    message.Append(payload);
+
+    for (auto const &signatory : tx.signatories_)
+    {
+      message.Append(signatory.signature);
+    }
+
+    messages[i] = message;
+  }
+
+  auto const digests = crypto::SHA256::HashBatch(messages);
+  for (std::size_t i = 0; i < txs.size(); ++i)
+  {
+    txs[i].digest_ = digests[i];
+  }
+
+  return true;
+}
+
+/**
+ * Internal: Decode the contents of a serialized transaction (excluding its digest)
+ *
+ * @param data The serialized transaction
+ * @param tx The output transaction
+ * @param payload The output payload section of the serialized transaction
+ * @return true if successful, otherwise false
+ */
+bool TransactionSerializer::DecodeTransaction(ConstByteArray const &data, Transaction &tx,
+                                              ConstByteArray &payload)
+{
+  serializers::ByteArrayBuffer buffer{data};
 
   std::size_t const payload_start = buffer.tell();
 
@@ -691,20 +826,13 @@ bool TransactionSerializer::Deserialize(Transaction &tx) const
   std::size_t const payload_end  = buffer.tell();
   std::size_t const payload_size = payload_end - payload_start;
 
-  crypto::SHA256 hash_function{};
-  hash_function.Update(buffer.data().SubArray(payload_start, payload_size));
+  payload = buffer.data().SubArray(payload_start, payload_size);
 
   for (std::size_t i = 0; i < num_signatures; ++i)
   {
     Decode(buffer, tx.signatories_[i].signature);
-
-    // update signatories
-    hash_function.Update(tx.signatories_[i].signature);
   }
 
-  // compute the hash function
-  tx.digest_ = hash_function.Final();
-
   return true;
 }
 
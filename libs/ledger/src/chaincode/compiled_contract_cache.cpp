@@ -0,0 +1,360 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/chaincode/compiled_contract_cache.hpp"
+#include "core/logger.hpp"
+#include "crypto/sha256.hpp"
+#include "storage/object_store.hpp"
+#include "storage/resource_mapper.hpp"
+#include "vm/compiler.hpp"
+#include "vm/executable_serializers.hpp"
+#include "vm/generator.hpp"
+#include "vm/module.hpp"
+#include "vm/opcodes.hpp"
+
+#include <exception>
+#include <string>
+#include <utility>
+
+namespace fetch {
+namespace ledger {
+namespace {
+
+constexpr char const *LOGGING_NAME = "CompiledContractCache";
+
+using byte_array::ConstByteArray;
+
+/**
+ * Generate the in memory key for a given contract digest and module fingerprint
+ *
+ * @param digest The digest of the contract source
+ * @param module_fingerprint The fingerprint of the module the contract is compiled against
+ * @return The in memory key for the compiled executable
+ */
+ConstByteArray CreateMemoryKey(ConstByteArray const &digest,
+                               ConstByteArray const &module_fingerprint)
+{
+  return digest + module_fingerprint;
+}
+
+/**
+ * Generate the disk store key for a given contract digest and module fingerprint.
+ *
+ * The key includes the VM bytecode format version and the fingerprint of the module, so
+ * executables stored by an incompatible VM or against a different module are simply never found
+ * and are recompiled.
+ *
+ * @param digest The digest of the contract source
+ * @param module_fingerprint The fingerprint of the module the contract is compiled against
+ * @return The resource address for the compiled executable
+ */
+storage::ResourceAddress CreateDiskStoreKey(ConstByteArray const &digest,
+                                            ConstByteArray const &module_fingerprint)
+{
+  return storage::ResourceAddress{"fetch.compiled_contract.v" +
+                                  std::to_string(vm::BYTECODE_FORMAT_VERSION) + "." +
+                                  static_cast<std::string>(digest.ToHex()) + "." +
+                                  static_cast<std::string>(module_fingerprint.ToHex())};
+}
+
+}  // namespace
+
+/**
+ * Get the process wide instance of the cache
+ *
+ * @return The cache instance
+ */
+CompiledContractCache &CompiledContractCache::Instance()
+{
+  static CompiledContractCache instance;
+  return instance;
+}
+
+/**
+ * Generate the fingerprint of the type and function tables of a module
+ *
+ * As a side effect the tables of the module are populated, which is also required before a VM can
+ * run an executable (looked up from the cache) against the module.
+ *
+ * @param module The module to be fingerprinted
+ * @return The digest of the type and function tables of the module
+ */
+ConstByteArray CompiledContractCache::GenerateModuleFingerprint(Module &module)
+{
+  // the tables are only populated when a compiler is set up against the module
+  vm::Compiler compiler{&module};
+
+  crypto::SHA256 hash;
+
+  for (auto const &type_info : module.type_info_array())
+  {
+    hash.Update(type_info.type_kind);
+    hash.Update(type_info.name.size());
+    hash.Update(type_info.name);
+    hash.Update(type_info.parameter_type_ids.size());
+    hash.Update(type_info.parameter_type_ids);
+  }
+
+  for (auto const &function_info : module.function_info_array())
+  {
+    hash.Update(function_info.function_kind);
+    hash.Update(function_info.unique_id.size());
+    hash.Update(function_info.unique_id);
+  }
+
+  return hash.Final();
+}
+
+/**
+ * Construct a compiled contract cache
+ *
+ * @param capacity The maximum number of executables to be kept in memory
+ */
+CompiledContractCache::CompiledContractCache(std::size_t capacity)
+  : capacity_{capacity}
+{}
+
+CompiledContractCache::~CompiledContractCache()
+{
+  DetachDiskStore();
+}
+
+/**
+ * Back the cache with a persistent store of serialised executables
+ *
+ * @param doc_file The path to the document file of the store
+ * @param index_file The path to the index file of the store
+ * @param create Flag to signal that the files should be created if they do not already exist
+ */
+void CompiledContractCache::AttachDiskStore(std::string const &doc_file,
+                                            std::string const &index_file, bool create)
+{
+  auto store = std::make_shared<DiskStore>();
+  store->Load(doc_file, index_file, create);
+
+  FETCH_LOCK(lock_);
+  disk_store_ = std::move(store);
+}
+
+/**
+ * Flush and remove the persistent store (if present)
+ */
+void CompiledContractCache::DetachDiskStore()
+{
+  DiskStorePtr store{};
+
+  {
+    FETCH_LOCK(lock_);
+    std::swap(store, disk_store_);
+  }
+
+  if (store)
+  {
+    store->Flush(false);
+  }
+}
+
+/**
+ * Determine if the cache is backed by a persistent store
+ *
+ * @return true if a disk store is present, otherwise false
+ */
+bool CompiledContractCache::has_disk_store() const
+{
+  return static_cast<bool>(disk_store());
+}
+
+/**
+ * Lookup the compiled executable for the specified contract
+ *
+ * @param digest The digest of the contract source
+ * @param module_fingerprint The fingerprint of the module the contract is compiled against
+ * @return The compiled executable if present, otherwise an empty pointer
+ */
+CompiledContractCache::ExecutablePtr CompiledContractCache::Lookup(
+    ConstByteArray const &digest, ConstByteArray const &module_fingerprint)
+{
+  auto const key = CreateMemoryKey(digest, module_fingerprint);
+
+  // fast path: the executable is in memory
+  {
+    FETCH_LOCK(lock_);
+
+    auto const it = index_.find(key);
+    if (it != index_.end())
+    {
+      // move the entry to the front of the LRU list
+      entries_.splice(entries_.begin(), entries_, it->second);
+
+      ++hit_count_;
+      return it->second->executable;
+    }
+  }
+
+  // slow path: attempt to restore the executable from the disk store
+  auto store = disk_store();
+  if (store)
+  {
+    auto executable = LoadFromDisk(*store, digest, module_fingerprint);
+    if (executable)
+    {
+      InsertInMemory(key, executable);
+
+      ++disk_hit_count_;
+      return executable;
+    }
+  }
+
+  ++miss_count_;
+  return {};
+}
+
+/**
+ * Add a newly compiled executable to the cache (and disk store if present)
+ *
+ * @param digest The digest of the contract source
+ * @param module_fingerprint The fingerprint of the module the contract is compiled against
+ * @param executable The compiled executable for the contract
+ */
+void CompiledContractCache::Insert(ConstByteArray const &digest,
+                                   ConstByteArray const &module_fingerprint,
+                                   ExecutablePtr         executable)
+{
+  if (!executable)
+  {
+    return;
+  }
+
+  InsertInMemory(CreateMemoryKey(digest, module_fingerprint), executable);
+
+  auto store = disk_store();
+  if (store)
+  {
+    try
+    {
+      auto const key = CreateDiskStoreKey(digest, module_fingerprint);
+
+      if (!store->Has(key))
+      {
+        store->Set(key, *executable);
+        store->Flush(false);
+      }
+    }
+    catch (std::exception const &ex)
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Unable to persist compiled contract 0x", digest.ToHex(), ": ",
+                     ex.what());
+    }
+  }
+}
+
+/**
+ * Remove all the in memory entries from the cache
+ */
+void CompiledContractCache::Clear()
+{
+  FETCH_LOCK(lock_);
+  index_.clear();
+  entries_.clear();
+}
+
+/**
+ * Determine the current number of executables held in memory
+ *
+ * @return The number of cached executables
+ */
+std::size_t CompiledContractCache::size() const
+{
+  FETCH_LOCK(lock_);
+  return entries_.size();
+}
+
+/**
+ * Internal: Add an executable to the in memory LRU cache
+ *
+ * @param key The in memory key of the executable
+ * @param executable The compiled executable
+ */
+void CompiledContractCache::InsertInMemory(ConstByteArray const &key,
+                                           ExecutablePtr const &executable)
+{
+  if (capacity_ == 0)
+  {
+    return;
+  }
+
+  FETCH_LOCK(lock_);
+
+  // another thread might have populated the entry in the meantime
+  if (index_.find(key) == index_.end())
+  {
+    entries_.push_front(Entry{key, executable});
+    index_.emplace(key, entries_.begin());
+
+    // evict the least recently used entries
+    while (entries_.size() > capacity_)
+    {
+      index_.erase(entries_.back().key);
+      entries_.pop_back();
+    }
+  }
+}
+
+/**
+ * Internal: Restore a serialised executable from the disk store
+ *
+ * @param store The disk store to query
+ * @param digest The digest of the contract source
+ * @param module_fingerprint The fingerprint of the module the contract is compiled against
+ * @return The restored executable if successful, otherwise an empty pointer
+ */
+CompiledContractCache::ExecutablePtr CompiledContractCache::LoadFromDisk(
+    DiskStore &store, ConstByteArray const &digest, ConstByteArray const &module_fingerprint)
+{
+  ExecutablePtr executable{};
+
+  try
+  {
+    auto restored = std::make_shared<Executable>();
+    if (store.Get(CreateDiskStoreKey(digest, module_fingerprint), *restored))
+    {
+      executable = std::move(restored);
+    }
+  }
+  catch (std::exception const &ex)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Unable to restore compiled contract 0x", digest.ToHex(), ": ",
+                   ex.what());
+  }
+
+  return executable;
+}
+
+/**
+ * Internal: Get a reference to the disk store (if present)
+ *
+ * @return The disk store pointer, which might be empty
+ */
+CompiledContractCache::DiskStorePtr CompiledContractCache::disk_store() const
+{
+  FETCH_LOCK(lock_);
+  return disk_store_;
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -19,6 +19,7 @@
 #include "ledger/chaincode/contract_http_interface.hpp"
 #include "core/byte_array/decoders.hpp"
 #include "core/json/document.hpp"
+#include "core/json/on_demand.hpp"
 #include "core/logger.hpp"
 #include "core/serializers/stl_types.hpp"
 #include "core/string/replace.hpp"
@@ -33,6 +34,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace fetch {
 namespace ledger {
@@ -44,6 +46,9 @@ using fetch::byte_array::ConstByteArray;
 using fetch::byte_array::ToBase64;
 using fetch::ledger::FromJsonTransaction;
 
+using TransactionPtr  = std::shared_ptr<Transaction>;
+using TransactionList = std::vector<TransactionPtr>;
+
 ConstByteArray const API_PATH_CONTRACT_PREFIX("/api/contract/");
 ConstByteArray const CONTRACT_NAME_SEPARATOR(".");
 ConstByteArray const PATH_SEPARATOR("/");
@@ -310,45 +315,44 @@ ContractHttpInterface::SubmitTxStatus ContractHttpInterface::SubmitJsonTx(
   std::size_t submitted{0};
   std::size_t expected_count{0};
 
-  // parse the JSON request
-  json::JSONDocument doc{request.body()};
+  // index the JSON request, the transactions are decoded directly from the document
+  json::OnDemandDocument doc{request.body()};
 
   FETCH_LOG_DEBUG(LOGGING_NAME, "NEW TRANSACTION RECEIVED");
   FETCH_LOG_DEBUG(LOGGING_NAME, request.body());
 
   FETCH_UNUSED(expected_contract);
 
-  if (doc.root().IsArray())
-  {
-    expected_count = doc.root().size();
-    for (std::size_t i = 0, end = doc.root().size(); i < end; ++i)
-    {
-      auto const &tx_obj = doc[i];
-
-      // create the transaction
-      auto tx = std::make_shared<Transaction>();
-      if (FromJsonTransaction(tx_obj, *tx))
-      {
-        txs.emplace_back(tx->digest());
+  // the elements of the document are only validated as they are visited, so all the transactions
+  // are decoded before any of them is submitted. A malformed request is rejected as a whole.
+  TransactionList decoded{};
 
-        processor_.AddTransaction(std::move(tx));
-        ++submitted;
-      }
+  auto const decode = [&decoded](json::OnDemandValue const &tx_obj) {
+    auto tx = std::make_shared<Transaction>();
+    if (FromJsonTransaction(tx_obj, *tx))
+    {
+      decoded.emplace_back(std::move(tx));
     }
+  };
+
+  json::OnDemandValue const root = doc.root();
+  if (root.IsArray())
+  {
+    expected_count = root.size();
+    root.ForEach(decode);
   }
   else
   {
     expected_count = 1;
+    decode(root);
+  }
 
-    auto tx = std::make_shared<Transaction>();
-    if (FromJsonTransaction(doc.root(), *tx))
-    {
-      txs.emplace_back(tx->digest());
-
-      processor_.AddTransaction(std::move(tx));
+  for (auto &tx : decoded)
+  {
+    txs.emplace_back(tx->digest());
 
-      ++submitted;
-    }
+    processor_.AddTransaction(std::move(tx));
+    ++submitted;
   }
 
   FETCH_LOG_DEBUG(LOGGING_NAME, "Submitted ", submitted, " transactions from ",
@@ -23,6 +23,7 @@
 #include "crypto/hash.hpp"
 #include "crypto/sha256.hpp"
 #include "ledger/chain/transaction.hpp"
+#include "ledger/chaincode/compiled_contract_cache.hpp"
 #include "ledger/chaincode/smart_contract_exception.hpp"
 #include "ledger/chaincode/vm_definition.hpp"
 #include "ledger/state_adapter.hpp"
@@ -97,7 +98,6 @@ void ValidateAddressesInParams(Transaction const &tx, vm::ParameterPack const &p
 SmartContract::SmartContract(std::string const &source)
   : source_{source}
   , digest_{GenerateDigest(source)}
-  , executable_{std::make_shared<Executable>()}
   , module_{vm_modules::VMFactory::GetModule()}
 {
   if (source_.empty())
@@ -111,13 +111,28 @@ SmartContract::SmartContract(std::string const &source)
   module_->CreateFreeFunctionFromLambda<uint64_t>("getBlockNumber",
                                                   [this](vm::VM *) { return block_index_; });
 
-  // create and compile the executable
-  auto errors = vm_modules::VMFactory::Compile(module_, source_, *executable_);
+  // since all contract modules are populated identically the compiled executable for a given
+  // source can be shared between all the instances of the contract. Fingerprinting the module also
+  // populates its tables, which the VM requires when the executable is served from the cache
+  auto &     cache              = CompiledContractCache::Instance();
+  auto const module_fingerprint = CompiledContractCache::GenerateModuleFingerprint(*module_);
+  executable_                   = cache.Lookup(digest_, module_fingerprint);
 
-  // if there are any compilation errors
-  if (!errors.empty())
+  if (!executable_)
   {
-    throw SmartContractException(SmartContractException::Category::COMPILATION, std::move(errors));
+    // create and compile the executable
+    auto executable = std::make_shared<Executable>();
+    auto errors     = vm_modules::VMFactory::Compile(module_, source_, *executable);
+
+    // if there are any compilation errors
+    if (!errors.empty())
+    {
+      throw SmartContractException(SmartContractException::Category::COMPILATION,
+                                   std::move(errors));
+    }
+
+    executable_ = std::move(executable);
+    cache.Insert(digest_, module_fingerprint, executable_);
   }
 
   // since we now have a fully compiled executable we can evaluate the functions and assign the
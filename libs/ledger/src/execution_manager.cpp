@@ -22,6 +22,7 @@
 #include "core/mutex.hpp"
 #include "core/threading.hpp"
 #include "ledger/executor.hpp"
+#include "ledger/storage_unit/cached_storage_adapter.hpp"
 #include "storage/resource_mapper.hpp"
 
 #include "ledger/state_adapter.hpp"
@@ -29,7 +30,9 @@
 #include "core/byte_array/decoders.hpp"
 #include "core/byte_array/encoders.hpp"
 
+#include <algorithm>
 #include <chrono>
+#include <limits>
 #include <memory>
 #include <thread>
 #include <vector>
@@ -40,15 +43,44 @@ static constexpr std::size_t STARTUP_ITERATION_TIME_MS = 100;
 
 namespace fetch {
 namespace ledger {
+namespace {
+
+/**
+ * Determine if the execution of the block must be halted given the status of a transaction
+ *
+ * @param status The execution status of the transaction
+ * @return true if the remaining transactions should not be executed, otherwise false
+ */
+bool IsExecutionHalted(ExecutionItem::Status status)
+{
+  switch (status)
+  {
+  case ExecutionItem::Status::SUCCESS:
+  case ExecutionItem::Status::CHAIN_CODE_LOOKUP_FAILURE:
+  case ExecutionItem::Status::CHAIN_CODE_EXEC_FAILURE:
+  case ExecutionItem::Status::CONTRACT_NAME_PARSE_FAILURE:
+    return false;
+  default:
+    return true;
+  }
+}
+
+}  // namespace
 
 /**
  * Constructs a execution manager instance
  *
  * @param num_executors The specified number of executors (and threads)
+ * @param log2_num_lanes The log2 of the number of lanes
+ * @param storage The storage unit
+ * @param factory The factory used to create the executors
+ * @param scheduling_mode The mode used to schedule the transactions of a block
  */
 ExecutionManager::ExecutionManager(std::size_t num_executors, uint32_t log2_num_lanes,
-                                   StorageUnitPtr storage, ExecutorFactory const &factory)
+                                   StorageUnitPtr storage, ExecutorFactory const &factory,
+                                   SchedulingMode scheduling_mode)
   : log2_num_lanes_{log2_num_lanes}
+  , scheduling_mode_{scheduling_mode}
   , storage_(std::move(storage))
   , idle_executors_()
   , thread_pool_(network::MakeThreadPool(num_executors, "Executor"))
@@ -152,9 +184,77 @@ bool ExecutionManager::PlanExecution(Block::Body const &block)
     ++slice_index;
   }
 
+  if (SchedulingMode::CONFLICT_GRAPH == scheduling_mode_)
+  {
+    BuildExecutionGraph();
+  }
+
   return true;
 }
 
+/**
+ * Build the conflict graph of the current execution plan
+ *
+ * Every transaction depends on the last transaction (in slice order) which precedes it on each of
+ * the lanes it makes use of. Executing the graph therefore yields the same state as executing the
+ * block slice by slice. Should be called with the execution plan lock held.
+ */
+void ExecutionManager::BuildExecutionGraph()
+{
+  static constexpr NodeIndex INVALID_NODE = std::numeric_limits<NodeIndex>::max();
+
+  std::size_t const num_lanes = 1u << log2_num_lanes_;
+
+  // the last node (in slice order) to have made use of each of the lanes
+  std::vector<NodeIndex> last_user(num_lanes, INVALID_NODE);
+  NodeIndexList          dependencies;
+
+  execution_graph_.clear();
+
+  for (auto const &slice_plan : execution_plan_)
+  {
+    for (auto const &item : slice_plan)
+    {
+      NodeIndex const index = execution_graph_.size();
+
+      execution_graph_.emplace_back();
+      auto &node = execution_graph_.back();
+      node.item  = item.get();
+
+      // a transaction with a malformed (or empty) mask is conservatively assumed to make use of
+      // all the lanes
+      auto const &shards   = item->shards();
+      bool const  all_lanes = (shards.size() != num_lanes) || (shards.PopCount() == 0);
+
+      dependencies.clear();
+      for (std::size_t lane = 0; lane < num_lanes; ++lane)
+      {
+        if (all_lanes || shards.bit(lane))
+        {
+          if (last_user[lane] != INVALID_NODE)
+          {
+            dependencies.push_back(last_user[lane]);
+          }
+
+          last_user[lane] = index;
+        }
+      }
+
+      // multiple lanes can be shared with the same previous transaction
+      std::sort(dependencies.begin(), dependencies.end());
+      dependencies.erase(std::unique(dependencies.begin(), dependencies.end()),
+                         dependencies.end());
+
+      for (auto const dependency : dependencies)
+      {
+        execution_graph_[dependency].dependants.push_back(index);
+      }
+
+      node.pending = dependencies.size();
+    }
+  }
+}
+
 /**
  * Dispatches an execution item to the next available executor
  *
@@ -163,6 +263,211 @@ bool ExecutionManager::PlanExecution(Block::Body const &block)
  * @param item The execution item to dispatch
  */
 void ExecutionManager::DispatchExecution(ExecutionItem &item)
+{
+  ExecuteItem(item);
+
+  counters_.Apply([](Counters &counters) { counters.remaining--; });
+}
+
+/**
+ * Dispatches a node of the conflict graph to the next available executor and then schedules any
+ * of its dependants which are no longer waiting on other nodes
+ *
+ * This function should be called from a context of a thread pool
+ *
+ * @param index The index of the node to dispatch
+ */
+void ExecutionManager::DispatchGraphExecution(NodeIndex index)
+{
+  auto &node = execution_graph_[index];
+
+  // once a transaction has stalled or failed fatally the remaining transactions are not executed
+  // (as in the slice by slice case) however the graph is still drained to complete the block
+  if (!execution_halted_)
+  {
+    ExecuteItem(*node.item);
+
+    if (IsExecutionHalted(node.item->status()))
+    {
+      execution_halted_ = true;
+    }
+  }
+
+  for (auto const dependant : node.dependants)
+  {
+    if (--execution_graph_[dependant].pending == 0)
+    {
+      auto self = shared_from_this();
+      thread_pool_->Post([self, dependant]() { self->DispatchGraphExecution(dependant); });
+    }
+  }
+
+  // signal the completion last since the graph can not be modified until then
+  counters_.Apply([](Counters &counters) { counters.remaining--; });
+}
+
+/**
+ * Speculatively executes an item on the next available executor. The changes of the execution are
+ * only applied once all the items of the block have been validated.
+ *
+ * This function should be called from a context of a thread pool
+ *
+ * @param item The execution item to dispatch
+ */
+void ExecutionManager::DispatchSpeculativeExecution(ExecutionItem &item)
+{
+  ExecuteItem(item, true);
+
+  counters_.Apply([](Counters &counters) { counters.remaining--; });
+}
+
+/**
+ * Validate and apply the changes of the speculative executions of the block
+ *
+ * The items are processed in block order. An item is valid if none of the keys that it read have
+ * been written by a preceding item, in which case its changes are applied directly. Otherwise the
+ * item is executed again (serially) against the now current state. The resulting state is
+ * therefore identical to executing the block serially. Should be called from the monitor thread
+ * once all the speculative executions have completed.
+ *
+ * @return true if the block was validated, false if a conflicting item could not be re-executed
+ */
+bool ExecutionManager::CommitSpeculativeExecutions()
+{
+  // all the executors are idle at this point, one of them is taken for the re-executions
+  ExecutorPtr executor;
+  {
+    FETCH_LOCK(idle_executors_lock_);
+    if (!idle_executors_.empty())
+    {
+      executor = std::move(idle_executors_.back());
+      idle_executors_.pop_back();
+    }
+  }
+
+  bool const success = ApplySpeculativeExecutions(executor.get());
+
+  if (executor)
+  {
+    FETCH_LOCK(idle_executors_lock_);
+    idle_executors_.push_back(std::move(executor));
+  }
+
+  return success;
+}
+
+/**
+ * Internal: Validate and apply the changes of the speculative executions in block order
+ *
+ * @param executor The executor used to re-execute the conflicting items (if any)
+ * @return true if successful, false if a conflicting item could not be re-executed
+ */
+bool ExecutionManager::ApplySpeculativeExecutions(ExecutorInterface *executor)
+{
+  using KeySet = CachedStorageAdapter::KeySet;
+
+  KeySet written;
+  for (auto const &slice_plan : execution_plan_)
+  {
+    for (auto const &item : slice_plan)
+    {
+      // determine if the speculative execution is still valid
+      bool conflicting = false;
+      if (item->changes())
+      {
+        auto const &reads = item->changes()->read_set();
+
+        conflicting =
+            std::any_of(reads.begin(), reads.end(), [&written](KeySet::value_type const &key) {
+              return written.find(key) != written.end();
+            });
+      }
+
+      if (conflicting)
+      {
+        // the stale changes must never be applied, otherwise the resulting state would depend on
+        // the availability of the executors
+        if (executor == nullptr)
+        {
+          FETCH_LOG_ERROR(LOGGING_NAME, "No executor available to re-execute conflicting tx: 0x",
+                          item->digest().ToHex());
+          return false;
+        }
+
+        FETCH_LOG_DEBUG(LOGGING_NAME, "Re-executing conflicting tx: 0x", item->digest().ToHex());
+
+        item->ExecuteSpeculatively(*executor);
+        ++num_reexecutions_;
+      }
+
+      auto const &changes = item->changes();
+      if (changes)
+      {
+        auto const &shards    = item->shards();
+        auto const  num_lanes = static_cast<uint32_t>(shards.size());
+
+        // lock the lanes of the transaction while the changes are applied
+        for (uint32_t lane = 0; lane < num_lanes; ++lane)
+        {
+          if (shards.bit(lane))
+          {
+            storage_->Lock(lane);
+          }
+        }
+
+        changes->Flush();
+
+        for (uint32_t lane = 0; lane < num_lanes; ++lane)
+        {
+          if (shards.bit(lane))
+          {
+            storage_->Unlock(lane);
+          }
+        }
+
+        written.insert(changes->write_set().begin(), changes->write_set().end());
+      }
+
+      // as with the other modes, no further transactions are applied after a stall or fatal error
+      if (IsExecutionHalted(item->status()))
+      {
+        execution_halted_ = true;
+        return true;
+      }
+    }
+  }
+
+  return true;
+}
+
+/**
+ * Release the state retained for the execution of the current block, allowing the executors to
+ * recycle their per block memory. Should be called from the monitor thread once the execution of
+ * the block has finished.
+ */
+void ExecutionManager::ReleaseBlockResources()
+{
+  // the buffered changes of the speculative executions must be released first
+  {
+    FETCH_LOCK(execution_plan_lock_);
+    execution_plan_.clear();
+    execution_graph_.clear();
+  }
+
+  FETCH_LOCK(idle_executors_lock_);
+  for (auto &executor : idle_executors_)
+  {
+    executor->ReleaseBlockResources();
+  }
+}
+
+/**
+ * Executes an item on the next available executor
+ *
+ * @param item The execution item to be executed
+ * @param speculative Flag to signal that the item should be executed speculatively
+ */
+void ExecutionManager::ExecuteItem(ExecutionItem &item, bool speculative)
 {
   ExecutorPtr executor;
 
@@ -186,19 +491,23 @@ void ExecutionManager::DispatchExecution(ExecutionItem &item)
     counters_.Apply([](Counters &counters) { counters.active++; });
 
     // execute the item
-    item.Execute(*executor);
+    if (speculative)
+    {
+      item.ExecuteSpeculatively(*executor);
+    }
+    else
+    {
+      item.Execute(*executor);
+    }
 
-    // determine what the status is
-    if (ExecutorInterface::Status::SUCCESS != item.status())
+    // determine what the status is (the outcome of speculative executions might still change)
+    if (!speculative && (ExecutorInterface::Status::SUCCESS != item.status()))
     {
       FETCH_LOG_WARN(LOGGING_NAME, "Error executing tx: 0x", item.digest().ToHex(),
                      " status: ", ledger::ToString(item.status()));
     }
 
-    counters_.Apply([](Counters &counters) {
-      counters.active--;
-      counters.remaining--;
-    });
+    counters_.Apply([](Counters &counters) { counters.active--; });
 
     ++completed_executions_;
 
@@ -321,6 +630,7 @@ void ExecutionManager::MonitorThreadEntrypoint()
     case MonitorState::FAILED:
       FETCH_LOG_WARN(LOGGING_NAME, "Execution Engine experience fatal error");
 
+      ReleaseBlockResources();
       state_.Set(State::EXECUTION_FAILED);
       monitor_state = MonitorState::IDLE;
       break;
@@ -328,6 +638,7 @@ void ExecutionManager::MonitorThreadEntrypoint()
     case MonitorState::STALLED:
       FETCH_LOG_DEBUG(LOGGING_NAME, "Now Stalled");
 
+      ReleaseBlockResources();
       state_.Set(State::TRANSACTIONS_UNAVAILABLE);
       monitor_state = MonitorState::IDLE;
       break;
@@ -375,6 +686,57 @@ void ExecutionManager::MonitorThreadEntrypoint()
       {
         monitor_state = MonitorState::SETTLE_FEES;
       }
+      else if (SchedulingMode::OPTIMISTIC == scheduling_mode_)
+      {
+        // the whole block is speculatively executed at once
+        std::size_t num_items{0};
+        for (auto const &slice_plan : execution_plan_)
+        {
+          num_items += slice_plan.size();
+        }
+
+        execution_halted_ = false;
+        counters_.Set(Counters{0, num_items});
+
+        auto self = shared_from_this();
+        for (auto const &slice_plan : execution_plan_)
+        {
+          for (auto const &item : slice_plan)
+          {
+            ExecutionItem *raw_item = item.get();
+            thread_pool_->Post(
+                [self, raw_item]() { self->DispatchSpeculativeExecution(*raw_item); });
+          }
+        }
+
+        monitor_state = MonitorState::RUNNING;
+      }
+      else if (SchedulingMode::CONFLICT_GRAPH == scheduling_mode_)
+      {
+        // the whole block is scheduled at once, initially only the transactions which do not
+        // depend on any other transaction can be dispatched
+        execution_halted_ = false;
+        counters_.Set(Counters{0, execution_graph_.size()});
+
+        // the roots must be determined before any dispatch, since the nodes being executed
+        // concurrently decrement the pending counts of their dependants
+        NodeIndexList roots;
+        for (NodeIndex index = 0, end = execution_graph_.size(); index < end; ++index)
+        {
+          if (execution_graph_[index].pending == 0)
+          {
+            roots.push_back(index);
+          }
+        }
+
+        auto self = shared_from_this();
+        for (auto const index : roots)
+        {
+          thread_pool_->Post([self, index]() { self->DispatchGraphExecution(index); });
+        }
+
+        monitor_state = MonitorState::RUNNING;
+      }
       else
       {
         auto const &slice_plan = execution_plan_[current_slice];
@@ -410,37 +772,58 @@ void ExecutionManager::MonitorThreadEntrypoint()
       }
       else
       {
+        // validate and apply the results of the speculative executions
+        if ((SchedulingMode::OPTIMISTIC == scheduling_mode_) && !CommitSpeculativeExecutions())
+        {
+          monitor_state = MonitorState::FAILED;
+          break;
+        }
+
         // evaluate the status of the executions
         std::size_t num_complete{0};
         std::size_t num_stalls{0};
         std::size_t num_errors{0};
         std::size_t num_fatal_errors{0};
 
+        // in the conflict graph and optimistic modes all the slices of the block have been executed
+        bool const        whole_block = (SchedulingMode::SLICE_ORDER != scheduling_mode_);
+        std::size_t const last_slice  = whole_block ? num_slices_.load() : current_slice + 1;
+
         // look through all execution items and determine if it was successful
-        for (auto const &item : execution_plan_[current_slice])
+        for (std::size_t slice = current_slice; slice < last_slice; ++slice)
         {
-          assert(item);
-
-          switch (item->status())
+          for (auto const &item : execution_plan_[slice])
           {
-          case ExecutionItem::Status::SUCCESS:
-            ++num_complete;
-            break;
-          case ExecutionItem::Status::TX_LOOKUP_FAILURE:
-            ++num_stalls;
-            break;
-          case ExecutionItem::Status::CHAIN_CODE_LOOKUP_FAILURE:
-          case ExecutionItem::Status::CHAIN_CODE_EXEC_FAILURE:
-          case ExecutionItem::Status::CONTRACT_NAME_PARSE_FAILURE:
-            ++num_errors;
-            break;
-          default:
-            ++num_fatal_errors;
-            break;
+            assert(item);
+
+            switch (item->status())
+            {
+            case ExecutionItem::Status::SUCCESS:
+              ++num_complete;
+              break;
+            case ExecutionItem::Status::TX_LOOKUP_FAILURE:
+              ++num_stalls;
+              break;
+            case ExecutionItem::Status::CHAIN_CODE_LOOKUP_FAILURE:
+            case ExecutionItem::Status::CHAIN_CODE_EXEC_FAILURE:
+            case ExecutionItem::Status::CONTRACT_NAME_PARSE_FAILURE:
+              ++num_errors;
+              break;
+            case ExecutionItem::Status::NOT_RUN:
+              // transactions skipped after the execution of the block was halted
+              if (!execution_halted_)
+              {
+                ++num_fatal_errors;
+              }
+              break;
+            default:
+              ++num_fatal_errors;
+              break;
+            }
+
+            // update aggregate fees
+            aggregate_block_fees += item->fee();
           }
-
-          // update aggregate fees
-          aggregate_block_fees += item->fee();
         }
 
         // only provide debug if required
@@ -461,7 +844,7 @@ void ExecutionManager::MonitorThreadEntrypoint()
         }
 
         // increment the slice counter
-        ++current_slice;
+        current_slice = last_slice;
 
         // decide the next monitor state based on the status of the slice execution
         if (num_fatal_errors)
@@ -506,6 +889,7 @@ void ExecutionManager::MonitorThreadEntrypoint()
 
     case MonitorState::BOOKMARKING_STATE:
       // finished processing the block
+      ReleaseBlockResources();
       monitor_state = MonitorState::IDLE;
       break;
     }
@@ -93,7 +93,8 @@ bool IsCreateWealth(Transaction const &tx)
  * @param storage The storage unit to be used
  */
 Executor::Executor(StorageUnitPtr storage)
-  : storage_{std::move(storage)}
+  : arena_{std::make_shared<core::Arena>()}
+  , storage_{std::move(storage)}
   , token_contract_{std::make_shared<TokenContract>()}
 {}
 
@@ -108,16 +109,74 @@ Executor::Executor(StorageUnitPtr storage)
  */
 Executor::Result Executor::Execute(Digest const &digest, BlockIndex block, SliceIndex slice,
                                    BitVector const &shards)
+{
+  auto const result = Run(digest, block, slice, shards, false);
+
+  // flush the storage so that all changes are now persistent
+  if (storage_cache_)
+  {
+    storage_cache_->Flush();
+  }
+
+  // clean up any used resources
+  Cleanup();
+
+  return result;
+}
+
+/**
+ * Executes a given transaction across a series of lanes, without applying the changes to the
+ * state database
+ *
+ * @param digest The transaction digest to be executed
+ * @param block The current block index
+ * @param slice The current slice index
+ * @param shards The bit vector outlining the shards in use by this transaction
+ * @param changes The output buffered changes (empty if the transaction could not be retrieved)
+ * @return The status code for the operation
+ */
+Executor::Result Executor::ExecuteSpeculatively(Digest const &digest, BlockIndex block,
+                                                SliceIndex slice, BitVector const &shards,
+                                                StateChangesPtr &changes)
+{
+  auto const result = Run(digest, block, slice, shards, true);
+
+  // hand over the buffered changes to the caller
+  changes = std::move(storage_cache_);
+
+  // clean up any used resources
+  Cleanup();
+
+  return result;
+}
+
+/**
+ * Internal: Executes a given transaction, all the resulting changes are buffered in the storage
+ * cache
+ *
+ * @param digest The transaction digest to be executed
+ * @param block The current block index
+ * @param slice The current slice index
+ * @param shards The bit vector outlining the shards in use by this transaction
+ * @param speculative Flag to signal if the execution is speculative
+ * @return The status code for the operation
+ */
+Executor::Result Executor::Run(Digest const &digest, BlockIndex block, SliceIndex slice,
+                               BitVector const &shards, bool speculative)
 {
   FETCH_LOG_DEBUG(LOGGING_NAME, "Executing tx ", byte_array::ToBase64(hash));
 
   Result result{Status::INEXPLICABLE_FAILURE, 0, 0, 0};
 
+  // the objects created by the contracts (and the cache) are allocated from the block arena
+  core::ArenaScope arena_scope{*arena_};
+
   // cache the state for the current transaction
   block_          = block;
   slice_          = slice;
   allowed_shards_ = shards;
   log2_num_lanes_ = shards.log2_size();
+  storage_cache_.reset();
 
   // attempt to retrieve the transaction from the storage
   if (!RetrieveTransaction(digest))
@@ -131,7 +190,7 @@ Executor::Result Executor::Execute(Digest const &digest, BlockIndex block, Slice
     result.charge_rate = current_tx_->charge();
 
     // create the storage cache
-    storage_cache_ = std::make_shared<CachedStorageAdapter>(*storage_);
+    storage_cache_ = std::make_shared<CachedStorageAdapter>(*storage_, speculative, arena_);
 
     // follow the three step process for executing a transaction
     //
@@ -152,14 +211,8 @@ Executor::Result Executor::Execute(Digest const &digest, BlockIndex block, Slice
 
     // deduct the fees from the originator
     DeductFees(result);
-
-    // flush the storage so that all changes are now persistent
-    storage_cache_->Flush();
   }
 
-  // clean up any used resources
-  Cleanup();
-
   return result;
 }
 
@@ -275,8 +328,12 @@ bool Executor::ExecuteTransactionContract(Result &result)
     // create the cache and state sentinel (lock and unlock resources as well as sandbox)
     StateSentinelAdapter storage_adapter{*storage_cache_, contract_id.GetParent(), allowed_shards_};
 
-    // lookup or create the instance of the contract as is needed
-    auto contract = chain_code_cache_.Lookup(contract_id.GetParent(), *storage_);
+    // lookup or create the instance of the contract as is needed. During speculative executions
+    // the lookup is made through the storage cache so that the reads of the contract are tracked
+    StorageInterface &contract_storage =
+        storage_cache_->speculative() ? static_cast<StorageInterface &>(*storage_cache_)
+                                      : *storage_;
+    auto contract = chain_code_cache_.Lookup(contract_id.GetParent(), contract_storage);
     if (!contract)
     {
       FETCH_LOG_WARN(LOGGING_NAME, "Contract lookup failure: ", contract_id.full_name());
@@ -420,9 +477,43 @@ void Executor::DeductFees(Result &result)
   token_contract_->Detach();
 }
 
+/**
+ * Signal that the block has finished executing, recycling the memory of the block arena. All the
+ * changes of the speculative executions have been released at this point, so any allocation which
+ * is still live has outlived the block. In that case the arena is retired and replaced rather than
+ * being left to grow, and it is only freed once those allocations have been released.
+ */
+void Executor::ReleaseBlockResources()
+{
+  retired_arenas_.erase(std::remove_if(retired_arenas_.begin(), retired_arenas_.end(),
+                                       [](ArenaPtr const &arena) {
+                                         return arena->num_live_allocations() == 0;
+                                       }),
+                        retired_arenas_.end());
+
+  if (!Cleanup())
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Block arena has ", arena_->num_live_allocations(),
+                   " allocations outliving the block (", arena_->capacity(),
+                   " bytes), replacing it");
+
+    retired_arenas_.emplace_back(std::move(arena_));
+    arena_ = std::make_shared<core::Arena>();
+  }
+}
+
+/**
+ * Internal: Release the state of the last execution and attempt to recycle the memory of the block
+ * arena. The arena is left untouched while any of its allocations are still in use.
+ *
+ * @return true if the arena was recycled, otherwise false
+ */
 bool Executor::Cleanup()
 {
-  return false;
+  storage_cache_.reset();
+  current_tx_.reset();
+
+  return arena_->Reset();
 }
 
 }  // namespace ledger
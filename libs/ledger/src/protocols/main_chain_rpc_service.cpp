@@ -25,12 +25,21 @@
 #include "crypto/fetch_identity.hpp"
 #include "ledger/chain/block_coordinator.hpp"
 #include "ledger/chain/transaction_layout_rpc_serializers.hpp"
+#include "ledger/transaction_layout_cache.hpp"
 #include "metrics/metrics.hpp"
 #include "network/muddle/packet.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <random>
+#include <utility>
+
 // TODO(private 976) : This can crash the network as it's not enforced server side
-static const uint32_t MAX_CHAIN_REQUEST_SIZE = 10000;
-static const uint64_t MAX_SUB_CHAIN_SIZE     = 1000;
+static const uint32_t MAX_CHAIN_REQUEST_SIZE  = 10000;
+static const uint64_t MAX_SUB_CHAIN_SIZE      = 1000;
+static const uint32_t MAX_HEADER_REQUEST_SIZE = 10000;
+static const uint64_t MAX_SYNC_HEADERS        = 10 * MAX_HEADER_REQUEST_SIZE;
 
 namespace fetch {
 namespace ledger {
@@ -44,16 +53,19 @@ using BlockSerializerCounter = fetch::serializers::SizeCounter<BlockSerializer>;
 using PromiseState           = fetch::service::PromiseState;
 using State                  = MainChainRpcService::State;
 using Mode                   = MainChainRpcService::Mode;
+using SyncMode               = MainChainRpcService::SyncMode;
 
 /**
  * Map the initial state of the state machine to the particular mode that is being configured.
  *
  * @param mode The mode for the main chain
+ * @param sync_mode The mode of the initial synchronisation of the chain
  * @return The initial state for the state machine
  */
-State GetInitialState(Mode mode)
+State GetInitialState(Mode mode, SyncMode sync_mode)
 {
-  State initial_state = State::REQUEST_HEAVIEST_CHAIN;
+  State initial_state = (SyncMode::HEADERS_FIRST == sync_mode) ? State::REQUEST_HEADERS
+                                                                : State::REQUEST_HEAVIEST_CHAIN;
 
   switch (mode)
   {
@@ -70,17 +82,27 @@ State GetInitialState(Mode mode)
 
 }  // namespace
 
+constexpr uint64_t    MainChainRpcService::COMPACT_BLOCK_TIMEOUT_MS;
+constexpr uint64_t    MainChainRpcService::BLOCK_REQUEST_TIMEOUT_MS;
+constexpr uint64_t    MainChainRpcService::SLOW_PEER_BACKOFF_MS;
+constexpr std::size_t MainChainRpcService::MAX_BLOCK_REQUESTS_PER_PEER;
+
 MainChainRpcService::MainChainRpcService(MuddleEndpoint &endpoint, MainChain &chain,
-                                         TrustSystem &trust, Mode mode)
+                                         LayoutCache &layout_cache, TrustSystem &trust, Mode mode,
+                                         SyncMode sync_mode)
   : muddle::rpc::Server(endpoint, SERVICE_MAIN_CHAIN, CHANNEL_RPC)
   , mode_(mode)
+  , sync_mode_(sync_mode)
   , endpoint_(endpoint)
   , chain_(chain)
+  , layout_cache_(layout_cache)
   , trust_(trust)
   , block_subscription_(endpoint.Subscribe(SERVICE_MAIN_CHAIN, CHANNEL_BLOCKS))
+  , compact_block_subscription_(endpoint.Subscribe(SERVICE_MAIN_CHAIN, CHANNEL_COMPACT_BLOCKS))
   , main_chain_protocol_(chain_)
+  , salt_generator_{std::random_device{}()}
   , rpc_client_("R:MChain", endpoint, Address{}, SERVICE_MAIN_CHAIN, CHANNEL_RPC)
-  , state_machine_{std::make_shared<StateMachine>("MainChain", GetInitialState(mode_),
+  , state_machine_{std::make_shared<StateMachine>("MainChain", GetInitialState(mode_, sync_mode_),
                                                   [](State state) { return ToString(state); })}
 {
   // register the main chain protocol
@@ -88,6 +110,9 @@ MainChainRpcService::MainChainRpcService(MuddleEndpoint &endpoint, MainChain &ch
 
   // configure the state machine
   // clang-format off
+  state_machine_->RegisterHandler(State::REQUEST_HEADERS,         this, &MainChainRpcService::OnRequestHeaders);
+  state_machine_->RegisterHandler(State::WAIT_FOR_HEADERS,        this, &MainChainRpcService::OnWaitForHeaders);
+  state_machine_->RegisterHandler(State::DOWNLOADING_BLOCKS,      this, &MainChainRpcService::OnDownloadingBlocks);
   state_machine_->RegisterHandler(State::REQUEST_HEAVIEST_CHAIN,  this, &MainChainRpcService::OnRequestHeaviestChain);
   state_machine_->RegisterHandler(State::WAIT_FOR_HEAVIEST_CHAIN, this, &MainChainRpcService::OnWaitForHeaviestChain);
   state_machine_->RegisterHandler(State::SYNCHRONISING,           this, &MainChainRpcService::OnSynchronising);
@@ -117,21 +142,46 @@ MainChainRpcService::MainChainRpcService(MuddleEndpoint &endpoint, MainChain &ch
     // dispatch the event
     OnNewBlock(from, block, transmitter);
   });
+
+  compact_block_subscription_->SetMessageHandler(
+      [this](Address const &from, uint16_t, uint16_t, uint16_t, Packet::Payload const &payload,
+             Address transmitter) {
+        FETCH_LOG_DEBUG(LOGGING_NAME, "Triggering new compact block handler");
+
+        BlockSerializer serialiser(payload);
+
+        // deserialize the compact block
+        CompactBlock compact;
+        serialiser >> compact;
+
+        // dispatch the event
+        OnNewCompactBlock(from, compact, transmitter);
+      });
 }
 
+/**
+ * Broadcast a newly generated block to the other nodes on the network
+ *
+ * The block is sent in its compact form, the receiving nodes rebuild it from the transactions they
+ * have already seen.
+ *
+ * @param block The block to be broadcast
+ */
 void MainChainRpcService::BroadcastBlock(MainChainRpcService::Block const &block)
 {
-  // determine the serialised size of the block
+  CompactBlock const compact{block, salt_generator_()};
+
+  // determine the serialised size of the compact block
   BlockSerializerCounter counter;
-  counter << block;
+  counter << compact;
 
-  // allocate the buffer and serialise the block
+  // allocate the buffer and serialise the compact block
   BlockSerializer serializer;
   serializer.Reserve(counter.size());
-  serializer << block;
+  serializer << compact;
 
   // broadcast the block to the nodes on the network
-  endpoint_.Broadcast(SERVICE_MAIN_CHAIN, CHANNEL_BLOCKS, serializer.data());
+  endpoint_.Broadcast(SERVICE_MAIN_CHAIN, CHANNEL_COMPACT_BLOCKS, serializer.data());
 }
 
 void MainChainRpcService::OnNewBlock(Address const &from, Block &block, Address const &transmitter)
@@ -185,12 +235,237 @@ void MainChainRpcService::OnNewBlock(Address const &from, Block &block, Address
   }
 }
 
+/**
+ * Handle a compact block which has been broadcast on the network
+ *
+ * The block is rebuilt from the layout cache. If any transactions are missing their layouts are
+ * requested from the sender, and the full block is requested if the block can not be completed.
+ *
+ * @param from The sender of the compact block
+ * @param compact The compact block
+ * @param transmitter The peer which relayed the compact block
+ */
+void MainChainRpcService::OnNewCompactBlock(Address const &from, CompactBlock const &compact,
+                                            Address const &transmitter)
+{
+  BlockHash const &hash = compact.header.body.hash;
+
+  // there is nothing to be done for blocks which are already known
+  if (chain_.GetBlock(hash))
+  {
+    FETCH_LOG_DEBUG(LOGGING_NAME, "Duplicate compact block: 0x", hash.ToHex());
+    return;
+  }
+
+  PendingBlock pending{};
+  pending.from        = from;
+  pending.transmitter = transmitter;
+
+  if (compact.Reconstruct(layout_cache_, pending.block, pending.missing))
+  {
+    pending.block.UpdateDigest();
+
+    if (pending.block.body.hash == hash)
+    {
+      OnNewBlock(from, pending.block, transmitter);
+      return;
+    }
+  }
+
+  {
+    FETCH_LOCK(pending_lock_);
+
+    // abandon the blocks which the sender has failed to complete
+    for (auto it = pending_blocks_.begin(); it != pending_blocks_.end();)
+    {
+      if (it->second.deadline.IsDue())
+      {
+        FETCH_LOG_WARN(LOGGING_NAME, "Abandoned compact block: 0x", it->first.ToHex());
+        it = pending_blocks_.erase(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+
+    // the block might have been relayed more than once
+    if (pending_blocks_.find(hash) != pending_blocks_.end())
+    {
+      return;
+    }
+
+    pending.compact = compact;
+    pending.deadline.Set(std::chrono::milliseconds{COMPACT_BLOCK_TIMEOUT_MS});
+
+    // reserve the entry until the request has been made
+    pending_blocks_.emplace(hash, pending);
+  }
+
+  FETCH_LOG_INFO(LOGGING_NAME, "Recv Compact Block: 0x", hash.ToHex(), " (missing txs: ",
+                 pending.missing.size(), " of ", compact.GetTransactionCount(), ")");
+
+  if (pending.missing.empty())
+  {
+    // the short IDs have matched the wrong transactions
+    RequestFullBlock(hash, pending);
+  }
+  else
+  {
+    RequestMissingTransactions(hash, pending);
+  }
+}
+
+/**
+ * Request the layouts of the missing transactions of a compact block from its sender
+ *
+ * @param hash The hash of the block
+ * @param pending The state of the incomplete block
+ */
+void MainChainRpcService::RequestMissingTransactions(BlockHash const &hash, PendingBlock &pending)
+{
+  pending.request =
+      rpc_client_.CallSpecificAddress(pending.from, RPC_MAIN_CHAIN,
+                                      MainChainProtocol::BLOCK_TRANSACTIONS, hash, pending.missing);
+
+  Promise const request = pending.request;
+
+  {
+    FETCH_LOCK(pending_lock_);
+    pending_blocks_[hash] = std::move(pending);
+  }
+
+  WatchPendingBlock(hash, request);
+}
+
+/**
+ * Request the full block from the sender of a compact block which could not be completed
+ *
+ * @param hash The hash of the block
+ * @param pending The state of the incomplete block
+ */
+void MainChainRpcService::RequestFullBlock(BlockHash const &hash, PendingBlock &pending)
+{
+  FETCH_LOG_INFO(LOGGING_NAME, "Requesting full block: 0x", hash.ToHex());
+
+  pending.full    = true;
+  pending.request = rpc_client_.CallSpecificAddress(pending.from, RPC_MAIN_CHAIN,
+                                                    MainChainProtocol::CHAIN_PRECEDING, hash, 1u);
+
+  Promise const request = pending.request;
+
+  {
+    FETCH_LOCK(pending_lock_);
+    pending_blocks_[hash] = std::move(pending);
+  }
+
+  WatchPendingBlock(hash, request);
+}
+
+/**
+ * Register the handlers for the response to a request for a pending block
+ *
+ * @param hash The hash of the block
+ * @param request The request in flight
+ */
+void MainChainRpcService::WatchPendingBlock(BlockHash const &hash, Promise const &request)
+{
+  std::weak_ptr<MainChainRpcService> weak_self = shared_from_this();
+
+  request->WithHandlers()
+      .Then([weak_self, hash]() {
+        auto self = weak_self.lock();
+        if (self)
+        {
+          self->OnPendingBlockResponse(hash, true);
+        }
+      })
+      .Catch([weak_self, hash]() {
+        auto self = weak_self.lock();
+        if (self)
+        {
+          self->OnPendingBlockResponse(hash, false);
+        }
+      });
+}
+
+/**
+ * Handle the response to a request for a pending block
+ *
+ * @param hash The hash of the block
+ * @param success Whether the request was successful
+ */
+void MainChainRpcService::OnPendingBlockResponse(BlockHash const &hash, bool success)
+{
+  PendingBlock pending{};
+
+  {
+    FETCH_LOCK(pending_lock_);
+
+    auto it = pending_blocks_.find(hash);
+    if (it == pending_blocks_.end())
+    {
+      return;
+    }
+
+    pending = std::move(it->second);
+    pending_blocks_.erase(it);
+  }
+
+  if (pending.full)
+  {
+    BlockList blocks{};
+    if (success)
+    {
+      blocks = pending.request->As<BlockList>();
+    }
+
+    if (blocks.size() == 1)
+    {
+      // recalculate the block hash
+      blocks.front().UpdateDigest();
+
+      if (blocks.front().body.hash == hash)
+      {
+        OnNewBlock(pending.from, blocks.front(), pending.transmitter);
+        return;
+      }
+    }
+
+    FETCH_LOG_WARN(LOGGING_NAME, "Unable to retrieve full block: 0x", hash.ToHex());
+    return;
+  }
+
+  if (success && pending.compact.Complete(pending.block, pending.missing,
+                                          pending.request->As<LayoutList>()))
+  {
+    pending.block.UpdateDigest();
+
+    if (pending.block.body.hash == hash)
+    {
+      OnNewBlock(pending.from, pending.block, pending.transmitter);
+      return;
+    }
+  }
+
+  RequestFullBlock(hash, pending);
+}
+
 char const *MainChainRpcService::ToString(State state)
 {
   char const *text = "unknown";
 
   switch (state)
   {
+  case State::REQUEST_HEADERS:
+    text = "Requesting Headers";
+    break;
+  case State::WAIT_FOR_HEADERS:
+    text = "Waiting for Headers";
+    break;
+  case State::DOWNLOADING_BLOCKS:
+    text = "Downloading Blocks";
+    break;
   case State::REQUEST_HEAVIEST_CHAIN:
     text = "Requesting Heaviest Chain";
     break;
@@ -299,6 +574,346 @@ void MainChainRpcService::HandleChainResponse(Address const &address, BlockList
   }
 }
 
+/**
+ * Validate a batch of headers received from the peer which is being synchronised with
+ *
+ * The headers are walked back from the heaviest block of the peer until a block which is already
+ * present in the chain is found. The hash of every header is recalculated, it must link to the
+ * previously validated header and satisfy its proof. Since the proof target is chosen by the peer,
+ * the walk is abandoned (and the peer penalised) if no known block is found within
+ * MAX_SYNC_HEADERS headers.
+ *
+ * @param header_list The headers (from heaviest to lightest)
+ * @return The next state of the state machine
+ */
+MainChainRpcService::State MainChainRpcService::HandleHeadersResponse(HeaderList header_list)
+{
+  if (header_list.empty())
+  {
+    FETCH_LOG_INFO(LOGGING_NAME, "No headers received from: ", ToBase64(current_peer_address_));
+
+    ResetDownload();
+    return State::REQUEST_HEADERS;
+  }
+
+  bool found_common_block{false};
+  for (auto &header : header_list)
+  {
+    // recompute the digest
+    header.UpdateDigest();
+
+    BlockHash const &hash = header.header.body.hash;
+
+    bool const is_linked = header_cursor_.empty() || (hash == header_cursor_);
+
+    // the remainder of the chain is already known
+    if (is_linked && chain_.GetBlock(hash))
+    {
+      found_common_block = true;
+      break;
+    }
+
+    if (!is_linked || !IsBlockValid(header.header))
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Invalid header: 0x", hash.ToHex(),
+                     " from: muddle://", ToBase64(current_peer_address_));
+
+      trust_.AddFeedback(current_peer_address_, p2p::TrustSubject::BLOCK,
+                         p2p::TrustQuality::LIED);
+
+      ResetDownload();
+      return State::REQUEST_HEADERS;
+    }
+
+    if (sync_headers_.size() >= MAX_SYNC_HEADERS)
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "No known block within ", MAX_SYNC_HEADERS,
+                     " headers from: muddle://", ToBase64(current_peer_address_));
+
+      trust_.AddFeedback(current_peer_address_, p2p::TrustSubject::BLOCK,
+                         p2p::TrustQuality::BAD_CONNECTION);
+
+      ResetDownload();
+      return State::REQUEST_HEADERS;
+    }
+
+    header_cursor_ = header.header.body.previous_hash;
+    sync_headers_.emplace_back(std::move(header));
+  }
+
+  if (!found_common_block)
+  {
+    // continue walking back the chain of the same peer
+    return State::REQUEST_HEADERS;
+  }
+
+  if (sync_headers_.empty())
+  {
+    ResetDownload();
+    return State::SYNCHRONISING;
+  }
+
+  FETCH_LOG_INFO(LOGGING_NAME, "Validated ", sync_headers_.size(),
+                 " headers from: muddle://", ToBase64(current_peer_address_));
+
+  // the blocks are downloaded from the lightest to the heaviest
+  HeaderList headers{std::make_move_iterator(sync_headers_.rbegin()),
+                     std::make_move_iterator(sync_headers_.rend())};
+  sync_headers_.clear();
+
+  download_queue_ = std::make_unique<BlockDownloadQueue>(std::move(headers));
+
+  return State::DOWNLOADING_BLOCKS;
+}
+
+/**
+ * Collect the responses to the requests for windows of blocks
+ *
+ * Windows which have failed or have not been served in time are returned to the download queue and
+ * the peer is not sent any further requests for a while.
+ */
+void MainChainRpcService::UpdateBlockRequests()
+{
+  for (auto it = block_requests_.begin(); it != block_requests_.end();)
+  {
+    auto const status = it->request->GetState();
+
+    if ((PromiseState::WAITING == status) && !it->deadline.IsDue())
+    {
+      ++it;
+      continue;
+    }
+
+    bool served{false};
+    if (PromiseState::SUCCESS == status)
+    {
+      auto blocks = it->request->As<BlockList>();
+      served      = !blocks.empty();
+
+      download_queue_->Complete(it->window, blocks);
+    }
+    else
+    {
+      download_queue_->Fail(it->window);
+    }
+
+    if (!served)
+    {
+      FETCH_LOG_INFO(LOGGING_NAME, "Block request to: muddle://", ToBase64(it->peer),
+                     " failed. Reason: ", service::ToString(status));
+
+      trust_.AddFeedback(it->peer, p2p::TrustSubject::BLOCK, p2p::TrustQuality::BAD_CONNECTION);
+
+      slow_peers_[it->peer].Set(std::chrono::milliseconds{SLOW_PEER_BACKOFF_MS});
+    }
+
+    it = block_requests_.erase(it);
+  }
+}
+
+/**
+ * Add the blocks which have been downloaded to the chain, in chain order
+ *
+ * @return true if all the blocks were added successfully, otherwise false
+ */
+bool MainChainRpcService::AddDownloadedBlocks()
+{
+  auto const blocks = download_queue_->PopReady();
+
+  for (auto const &block : blocks)
+  {
+    if (BlockStatus::INVALID == chain_.AddBlock(block))
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Synced invalid block: 0x", block.body.hash.ToHex());
+      return false;
+    }
+  }
+
+  if (!blocks.empty())
+  {
+    FETCH_LOG_DEBUG(LOGGING_NAME, "Synced ", blocks.size(), " blocks (remaining ",
+                    download_queue_->GetRemainingCount(), ")");
+  }
+
+  return true;
+}
+
+/**
+ * Request the next windows of blocks from all of the directly connected peers
+ */
+void MainChainRpcService::RequestBlocks()
+{
+  auto const peers = endpoint_.GetDirectlyConnectedPeers();
+
+  // the windows are handed out to the peers in turn
+  for (std::size_t round = 0; round < MAX_BLOCK_REQUESTS_PER_PEER; ++round)
+  {
+    for (auto const &peer : peers)
+    {
+      auto const slow_peer = slow_peers_.find(peer);
+      if (slow_peer != slow_peers_.end())
+      {
+        if (!slow_peer->second.IsDue())
+        {
+          continue;
+        }
+
+        slow_peers_.erase(slow_peer);
+      }
+
+      auto const num_requests = static_cast<std::size_t>(
+          std::count_if(block_requests_.begin(), block_requests_.end(),
+                        [&peer](BlockRequest const &request) { return request.peer == peer; }));
+      if (num_requests > round)
+      {
+        continue;
+      }
+
+      BlockRequest                    request{};
+      BlockDownloadQueue::BlockHashes hashes{};
+      if (!download_queue_->Assign(request.window, hashes))
+      {
+        return;
+      }
+
+      request.peer    = peer;
+      request.request = rpc_client_.CallSpecificAddress(peer, RPC_MAIN_CHAIN,
+                                                        MainChainProtocol::BLOCKS, hashes);
+      request.deadline.Set(std::chrono::milliseconds{BLOCK_REQUEST_TIMEOUT_MS});
+
+      WakeOnResponse(request.request);
+
+      block_requests_.emplace_back(std::move(request));
+    }
+  }
+}
+
+/**
+ * Discard the state of the header first synchronisation
+ */
+void MainChainRpcService::ResetDownload()
+{
+  current_peer_address_ = Address{};
+  current_request_.reset();
+  header_cursor_ = BlockHash{};
+  sync_headers_.clear();
+  download_queue_.reset();
+  block_requests_.clear();
+}
+
+/**
+ * Schedule the state machine to run as soon as the response to a request has been received
+ *
+ * @param request The request in flight
+ */
+void MainChainRpcService::WakeOnResponse(Promise const &request)
+{
+  std::weak_ptr<StateMachine> weak_state_machine = state_machine_;
+
+  request->WithHandlers().Finally([weak_state_machine]() {
+    auto state_machine = weak_state_machine.lock();
+    if (state_machine)
+    {
+      state_machine->Wake();
+    }
+  });
+}
+
+MainChainRpcService::State MainChainRpcService::OnRequestHeaders()
+{
+  State next_state{State::REQUEST_HEADERS};
+
+  // the headers are walked back with the same peer until a known block is found
+  auto const peer = header_cursor_.empty() ? GetRandomTrustedPeer() : current_peer_address_;
+
+  if (!peer.empty())
+  {
+    current_peer_address_ = peer;
+    current_request_      = rpc_client_.CallSpecificAddress(
+        current_peer_address_, RPC_MAIN_CHAIN, MainChainProtocol::HEADERS_PRECEDING, header_cursor_,
+        MAX_HEADER_REQUEST_SIZE);
+    header_deadline_.Set(std::chrono::milliseconds{BLOCK_REQUEST_TIMEOUT_MS});
+
+    WakeOnResponse(current_request_);
+
+    next_state = State::WAIT_FOR_HEADERS;
+  }
+  else
+  {
+    state_machine_->Delay(std::chrono::milliseconds{100});
+  }
+
+  return next_state;
+}
+
+MainChainRpcService::State MainChainRpcService::OnWaitForHeaders()
+{
+  State next_state{State::WAIT_FOR_HEADERS};
+
+  if (!current_request_)
+  {
+    // something went wrong we should attempt to request the headers again
+    ResetDownload();
+    next_state = State::REQUEST_HEADERS;
+  }
+  else
+  {
+    // determine the status of the request that is in flight
+    auto const status = current_request_->GetState();
+
+    if (PromiseState::SUCCESS == status)
+    {
+      next_state = HandleHeadersResponse(current_request_->As<HeaderList>());
+    }
+    else if ((PromiseState::WAITING != status) || header_deadline_.IsDue())
+    {
+      FETCH_LOG_INFO(LOGGING_NAME, "Header request to: ", ToBase64(current_peer_address_),
+                     " failed. Reason: ", service::ToString(status));
+
+      ResetDownload();
+      next_state = State::REQUEST_HEADERS;
+    }
+    else
+    {
+      // woken as soon as the response arrives
+      state_machine_->Delay(std::chrono::milliseconds{100});
+    }
+  }
+
+  return next_state;
+}
+
+MainChainRpcService::State MainChainRpcService::OnDownloadingBlocks()
+{
+  if (!download_queue_)
+  {
+    return State::SYNCHRONISING;
+  }
+
+  // woken as soon as one of the responses arrives
+  state_machine_->Delay(std::chrono::milliseconds{100});
+
+  UpdateBlockRequests();
+
+  if (!AddDownloadedBlocks())
+  {
+    ResetDownload();
+    return State::SYNCHRONISING;
+  }
+
+  if (download_queue_->IsComplete())
+  {
+    FETCH_LOG_INFO(LOGGING_NAME, "Block download complete");
+
+    ResetDownload();
+    return State::SYNCHRONISING;
+  }
+
+  RequestBlocks();
+
+  return State::DOWNLOADING_BLOCKS;
+}
+
 MainChainRpcService::State MainChainRpcService::OnRequestHeaviestChain()
 {
   State next_state{State::REQUEST_HEAVIEST_CHAIN};
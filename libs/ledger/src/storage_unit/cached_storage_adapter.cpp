@@ -24,10 +24,24 @@ namespace ledger {
 /**
  * Construct the Cache Adpater
  *
+ * In speculative mode the lock and unlock requests are not forwarded to the storage engine, it is
+ * the responsibility of the owner to lock the required resources when the cache is flushed.
+ *
  * @param storage The reference to the underlying storage engine
+ * @param speculative Flag to signal that the cache is being used for a speculative execution
+ * @param arena The (optional) arena from which the cache entries are allocated
  */
-CachedStorageAdapter::CachedStorageAdapter(StorageInterface &storage)
-  : storage_{storage}
+CachedStorageAdapter::CachedStorageAdapter(StorageInterface &storage, bool speculative,
+                                           ArenaPtr arena)
+  : arena_{std::move(arena)}
+  , storage_{storage}
+  , speculative_{speculative}
+  , cache_{0, std::hash<ResourceAddress>{}, std::equal_to<ResourceAddress>{},
+           CacheAllocator{arena_.get()}}
+  , read_keys_{0, std::hash<ResourceAddress>{}, std::equal_to<ResourceAddress>{},
+               KeySet::allocator_type{arena_.get()}}
+  , write_keys_{0, std::hash<ResourceAddress>{}, std::equal_to<ResourceAddress>{},
+                KeySet::allocator_type{arena_.get()}}
 {}
 
 /**
@@ -47,7 +61,11 @@ void CachedStorageAdapter::Flush()
   {
     for (auto &entry : cache_)
     {
-      if (!entry.second.flushed)
+      // speculative executions are validated such that the values that have only been read are
+      // unchanged, as such only the written values need to be flushed
+      bool const skip = speculative_ && (write_keys_.find(entry.first) == write_keys_.end());
+
+      if (!entry.second.flushed && !skip)
       {
         // set the value on the storage engine
         storage_.Set(entry.first, entry.second.value);
@@ -64,12 +82,16 @@ void CachedStorageAdapter::Flush()
 
 /**
  * Clear any cached values
+ *
+ * The set of keys read is retained since the values read might still have influenced the outcome
+ * of the execution
  */
 void CachedStorageAdapter::Clear()
 {
   FETCH_LOCK(lock_);
 
   cache_.clear();
+  write_keys_.clear();
   flush_required_ = false;
 }
 
@@ -94,6 +116,11 @@ CachedStorageAdapter::Document CachedStorageAdapter::Get(ResourceAddress const &
     // not in the cache need to retrieve
     auto const storage_result = storage_.Get(key);
 
+    {
+      FETCH_LOCK(lock_);
+      read_keys_.insert(key);
+    }
+
     if (!result.failed)
     {
       // update the result
@@ -128,6 +155,11 @@ CachedStorageAdapter::Document CachedStorageAdapter::GetOrCreate(ResourceAddress
     // not in the cache need to retrieve
     auto const storage_result = storage_.GetOrCreate(key);
 
+    {
+      FETCH_LOCK(lock_);
+      read_keys_.insert(key);
+    }
+
     if (!result.failed)
     {
       // update the result
@@ -151,6 +183,9 @@ void CachedStorageAdapter::Set(ResourceAddress const &key, StateValue const &val
 {
   // set the value directly into the cache
   AddCacheEntry(key, value);
+
+  FETCH_LOCK(lock_);
+  write_keys_.insert(key);
 }
 
 /**
@@ -161,6 +196,11 @@ void CachedStorageAdapter::Set(ResourceAddress const &key, StateValue const &val
  */
 bool CachedStorageAdapter::Lock(ShardIndex index)
 {
+  if (speculative_)
+  {
+    return true;
+  }
+
   // proxy this call directly to the underlying storage engine
   return storage_.Lock(index);
 }
@@ -173,6 +213,11 @@ bool CachedStorageAdapter::Lock(ShardIndex index)
  */
 bool CachedStorageAdapter::Unlock(ShardIndex index)
 {
+  if (speculative_)
+  {
+    return true;
+  }
+
   // proxy this call directly to the underlying storage engine
   return storage_.Unlock(index);
 }
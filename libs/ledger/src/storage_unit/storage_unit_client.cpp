@@ -57,6 +57,7 @@ StorageUnitClient::StorageUnitClient(MuddleEndpoint &muddle, ShardConfigs const
   : addresses_(GenerateAddressList(shards))
   , log2_num_lanes_(log2_num_lanes)
   , rpc_client_("STUC", muddle, MuddleEndpoint::Address{}, SERVICE_LANE_CTRL, CHANNEL_RPC)
+  , working_merkle_{num_lanes(), 0}
   , current_merkle_{num_lanes()}
 {
   if (num_lanes() != shards.size())
@@ -72,7 +73,7 @@ StorageUnitClient::StorageUnitClient(MuddleEndpoint &muddle, ShardConfigs const
 // Get the current hash of the world state (merkle tree root)
 byte_array::ConstByteArray StorageUnitClient::CurrentHash()
 {
-  MerkleTree                    tree{num_lanes()};
+  StateMerkleTree::DigestList   lane_hashes(num_lanes());
   std::vector<service::Promise> promises;
 
   for (uint32_t i = 0; i < num_lanes(); ++i)
@@ -87,18 +88,21 @@ byte_array::ConstByteArray StorageUnitClient::CurrentHash()
   for (auto &p : promises)
   {
     FETCH_LOG_PROMISE();
-    tree[index] = p->As<byte_array::ByteArray>();
+    lane_hashes[index] = p->As<byte_array::ByteArray>();
 
-    FETCH_LOG_DEBUG(LOGGING_NAME, "Merkle Hash ", index, ": 0x", tree[index].ToHex());
+    FETCH_LOG_DEBUG(LOGGING_NAME, "Merkle Hash ", index, ": 0x", lane_hashes[index].ToHex());
 
     ++index;
   }
 
-  tree.CalculateRoot();
+  FETCH_LOCK(merkle_mutex_);
+
+  // only the paths of the lanes whose roots have changed need to be recalculated
+  working_merkle_.Update(lane_hashes);
 
-  FETCH_LOG_DEBUG(LOGGING_NAME, "Merkle Final Hash: 0x", tree.root().ToHex());
+  FETCH_LOG_DEBUG(LOGGING_NAME, "Merkle Final Hash: 0x", working_merkle_.root().ToHex());
 
-  return tree.root();
+  return working_merkle_.root();
 }
 
 // return the last committed hash (should correspond to the state hash before you began execution)
@@ -130,8 +134,9 @@ bool StorageUnitClient::RevertToHash(Hash const &hash, uint64_t index)
 
   FETCH_LOCK(merkle_mutex_);
 
-  // Set merkle stack to this hash, get the tree
-  MerkleTree tree{num_lanes()};
+  // Set merkle stack to this hash, get the tree. The current tree is only updated once all the
+  // lanes have been successfully reverted
+  StateMerkleTree tree{current_merkle_};
   if (genesis_state && (index == 0))  // this is truly the genesis block
   {
     FETCH_LOG_INFO(LOGGING_NAME, "Reverting state to genesis.");
@@ -139,17 +144,19 @@ bool StorageUnitClient::RevertToHash(Hash const &hash, uint64_t index)
     // fill the tree with empty leaf nodes
     for (std::size_t i = 0; i < num_lanes(); ++i)
     {
-      tree[i] = GENESIS_MERKLE_ROOT;
+      tree.Update(i, GENESIS_MERKLE_ROOT);
     }
 
+    tree.ClearSnapshots();
+    tree.Snapshot(0);
+
     permanent_state_merkle_stack_.New(MERKLE_FILENAME);  // clear the stack
     permanent_state_merkle_stack_.Push(MerkleTreeBlock{tree});
   }
   else
   {
     // Try to find whether we believe the hash exists (index into merkle stack)
-    MerkleTreeBlock merkle_block;
-    uint64_t const  merkle_stack_size = permanent_state_merkle_stack_.size();
+    uint64_t const merkle_stack_size = permanent_state_merkle_stack_.size();
 
     if (index >= merkle_stack_size)
     {
@@ -159,8 +166,16 @@ bool StorageUnitClient::RevertToHash(Hash const &hash, uint64_t index)
       return false;
     }
 
-    permanent_state_merkle_stack_.Get(index, merkle_block);
-    tree = merkle_block.Extract(num_lanes());
+    // recent commits can be reverted to directly, otherwise the lane roots must be loaded from
+    // the stack. In either case only the paths of the lanes which differ are recalculated
+    if (!tree.RevertToSnapshot(index))
+    {
+      MerkleTreeBlock merkle_block;
+      permanent_state_merkle_stack_.Get(index, merkle_block);
+
+      tree.Update(merkle_block.Extract(num_lanes()).leaf_nodes());
+      tree.Snapshot(index);
+    }
 
     if (tree.root() != hash)
     {
@@ -177,7 +192,7 @@ bool StorageUnitClient::RevertToHash(Hash const &hash, uint64_t index)
 
   // Now perform the revert
   StorageUnitClient::LaneIndex lane_index{0};
-  for (auto const &lane_merkle_hash : tree)
+  for (auto const &lane_merkle_hash : tree.leaf_nodes())
   {
     assert(!hash.empty());
 
@@ -199,7 +214,7 @@ bool StorageUnitClient::RevertToHash(Hash const &hash, uint64_t index)
     if (!p->As<bool>())
     {
       FETCH_LOG_WARN(LOGGING_NAME, "Failed to revert shard ", lane_index, " to ",
-                     tree[lane_index].ToHex());
+                     tree.leaf(lane_index).ToHex());
 
       all_success &= false;
     }
@@ -216,7 +231,7 @@ bool StorageUnitClient::RevertToHash(Hash const &hash, uint64_t index)
     permanent_state_merkle_stack_.Flush(false);
 
     // since the state has now been restored we can update the current merkle reference
-    current_merkle_ = tree;
+    current_merkle_ = std::move(tree);
   }
 
   return all_success;
@@ -227,7 +242,7 @@ byte_array::ConstByteArray StorageUnitClient::Commit(uint64_t commit_index)
 {
   FETCH_LOG_DEBUG(LOGGING_NAME, "Committing: ", commit_index);
 
-  MerkleTree tree{num_lanes()};
+  StateMerkleTree::DigestList lane_hashes(num_lanes());
 
   std::vector<service::Promise> promises;
   promises.reserve(num_lanes());
@@ -246,18 +261,21 @@ byte_array::ConstByteArray StorageUnitClient::Commit(uint64_t commit_index)
   for (auto &p : promises)
   {
     FETCH_LOG_PROMISE();
-    tree[index] = p->As<byte_array::ByteArray>();
+    lane_hashes[index] = p->As<byte_array::ByteArray>();
 
     ++index;
   }
 
-  tree.CalculateRoot();
-
-  auto const tree_root = tree.root();
+  byte_array::ConstByteArray tree_root;
 
   {
     FETCH_LOCK(merkle_mutex_);
-    current_merkle_ = tree;
+
+    // only the paths of the lanes whose roots have changed need to be recalculated
+    current_merkle_.Update(lane_hashes);
+    current_merkle_.Snapshot(commit_index);
+
+    tree_root = current_merkle_.root();
 
     if (permanent_state_merkle_stack_.size() != commit_index)
     {
@@ -270,7 +288,7 @@ byte_array::ConstByteArray StorageUnitClient::Commit(uint64_t commit_index)
       permanent_state_merkle_stack_.Push(MerkleTreeBlock{});
     }
 
-    permanent_state_merkle_stack_.Set(commit_index, MerkleTreeBlock{tree});
+    permanent_state_merkle_stack_.Set(commit_index, MerkleTreeBlock{current_merkle_});
     permanent_state_merkle_stack_.Flush(false);
   }
 
@@ -309,6 +327,18 @@ bool StorageUnitClient::HashInStack(Hash const &hash, uint64_t index)
   return false;
 }
 
+/**
+ * Generate a proof that the root of a lane is included in the last committed state hash
+ *
+ * @param lane The index of the lane
+ * @return The inclusion proof (the sibling hashes from the lane root up to the state hash)
+ */
+StorageUnitClient::MerkleProof StorageUnitClient::GenerateLaneProof(ShardIndex lane) const
+{
+  FETCH_LOCK(merkle_mutex_);
+  return current_merkle_.GenerateProof(lane);
+}
+
 StorageUnitClient::Address const &StorageUnitClient::LookupAddress(ShardIndex shard) const
 {
   return addresses_.at(shard);
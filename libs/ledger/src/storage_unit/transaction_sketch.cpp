@@ -0,0 +1,285 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+#include "ledger/storage_unit/transaction_sketch.hpp"
+#include "core/byte_array/byte_array.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace fetch {
+namespace ledger {
+namespace {
+
+using KeySum = TransactionSketch::KeySum;
+
+/**
+ * Mix the bits of a 64 bit value (the finaliser of the SplitMix64 generator)
+ *
+ * @param value The value to be mixed
+ * @return The mixed value
+ */
+uint64_t Mix(uint64_t value)
+{
+  value = (value ^ (value >> 30u)) * 0xbf58476d1ce4e5b9ull;
+  value = (value ^ (value >> 27u)) * 0x94d049bb133111ebull;
+
+  return value ^ (value >> 31u);
+}
+
+/**
+ * Compute the checksum of a digest, used to determine if a cell contains a single digest
+ *
+ * @param key The digest
+ * @return The checksum
+ */
+uint64_t Checksum(KeySum const &key)
+{
+  return Mix(key[0] ^ Mix(key[1] ^ Mix(key[2] ^ Mix(key[3]))));
+}
+
+bool IsEmpty(TransactionSketch::Cell const &cell)
+{
+  return (cell.count == 0) && (cell.hash_sum == 0) && (cell.key_sum == KeySum{});
+}
+
+bool IsPure(TransactionSketch::Cell const &cell)
+{
+  return ((cell.count == 1) || (cell.count == -1)) && (Checksum(cell.key_sum) == cell.hash_sum);
+}
+
+}  // namespace
+
+constexpr std::size_t TransactionSketch::DIGEST_SIZE;
+constexpr std::size_t TransactionSketch::NUM_HASHES;
+
+/**
+ * Construct an empty sketch
+ *
+ * @param num_cells The number of cells in the sketch (rounded up to a multiple of NUM_HASHES)
+ */
+TransactionSketch::TransactionSketch(std::size_t num_cells)
+  : cells_(((std::max(num_cells, NUM_HASHES) + NUM_HASHES - 1) / NUM_HASHES) * NUM_HASHES)
+{}
+
+/**
+ * Construct a sketch from the cells of another sketch (i.e. one received from a peer)
+ *
+ * @param cells The cells of the sketch
+ */
+TransactionSketch::TransactionSketch(Cells cells)
+  : cells_(std::move(cells))
+{
+  // sketches which can not have been generated by this class are discarded
+  if (cells_.size() % NUM_HASHES != 0)
+  {
+    cells_.clear();
+  }
+}
+
+/**
+ * Calculate the number of cells required to decode a difference of a given size with a high
+ * probability
+ *
+ * @param difference The expected size of the symmetric difference
+ * @return The number of cells
+ */
+std::size_t TransactionSketch::CellsFor(std::size_t difference)
+{
+  // small sketches have a much higher chance of failing, hence the fixed overhead
+  std::size_t const num_cells = ((difference * 3u) / 2u) + (10u * NUM_HASHES);
+
+  return ((num_cells + NUM_HASHES - 1) / NUM_HASHES) * NUM_HASHES;
+}
+
+/**
+ * Add a digest to the sketch
+ *
+ * @param digest The digest to be added
+ */
+void TransactionSketch::Add(Digest const &digest)
+{
+  assert(digest.size() == DIGEST_SIZE);
+
+  if (cells_.empty() || (digest.size() != DIGEST_SIZE))
+  {
+    return;
+  }
+
+  KeySum key;
+  std::memcpy(key.data(), digest.pointer(), DIGEST_SIZE);
+
+  Update(key, 1, cells_);
+}
+
+/**
+ * Subtract another sketch from this one, removing all the digests which the two sets have in common
+ *
+ * @param other The sketch to be subtracted
+ * @return true if successful, otherwise false if the sketches are not of the same size
+ */
+bool TransactionSketch::Subtract(TransactionSketch const &other)
+{
+  if (other.cells_.size() != cells_.size())
+  {
+    return false;
+  }
+
+  for (std::size_t i = 0; i < cells_.size(); ++i)
+  {
+    Cell &      cell       = cells_[i];
+    Cell const &other_cell = other.cells_[i];
+
+    cell.count -= other_cell.count;
+    cell.hash_sum ^= other_cell.hash_sum;
+
+    for (std::size_t j = 0; j < cell.key_sum.size(); ++j)
+    {
+      cell.key_sum[j] ^= other_cell.key_sum[j];
+    }
+  }
+
+  return true;
+}
+
+/**
+ * Recover the digests which have been recorded in a subtracted sketch
+ *
+ * @param only_in_this The digests which were only in this sketch
+ * @param only_in_other The digests which were only in the subtracted sketch
+ * @return true if the whole difference was recovered, otherwise false if the difference was too
+ * large for the size of the sketch
+ */
+bool TransactionSketch::Decode(Digests &only_in_this, Digests &only_in_other) const
+{
+  Cells cells{cells_};
+
+  std::vector<std::size_t> candidates(cells.size());
+  for (std::size_t i = 0; i < candidates.size(); ++i)
+  {
+    candidates[i] = i;
+  }
+
+  // every recovered digest empties at least one cell, which bounds the work done if the sketch has
+  // been corrupted
+  std::size_t remaining = cells.size();
+
+  while (!candidates.empty() && (remaining > 0))
+  {
+    Cell const cell = cells[candidates.back()];
+    candidates.pop_back();
+
+    if (!IsPure(cell))
+    {
+      continue;
+    }
+
+    byte_array::ByteArray digest;
+    digest.Resize(DIGEST_SIZE);
+    std::memcpy(digest.pointer(), cell.key_sum.data(), DIGEST_SIZE);
+
+    if (cell.count > 0)
+    {
+      only_in_this.emplace_back(digest);
+    }
+    else
+    {
+      only_in_other.emplace_back(digest);
+    }
+
+    // remove the digest from the remaining cells, which might leave them with a single digest
+    Update(cell.key_sum, -cell.count, cells);
+
+    for (std::size_t index : CalculateIndices(cell.key_sum))
+    {
+      candidates.push_back(index);
+    }
+
+    --remaining;
+  }
+
+  return std::all_of(cells.begin(), cells.end(), IsEmpty);
+}
+
+/**
+ * Get the (net) number of digests which have been added to the sketch
+ *
+ * @return The number of digests
+ */
+int64_t TransactionSketch::count() const
+{
+  // every digest is added to exactly one cell of each partition
+  int64_t total{0};
+  for (std::size_t i = 0, end = cells_.size() / NUM_HASHES; i < end; ++i)
+  {
+    total += cells_[i].count;
+  }
+
+  return total;
+}
+
+/**
+ * Determine the cell of each partition to which a digest is added
+ *
+ * @param key The digest
+ * @return The indices of the cells
+ */
+TransactionSketch::Indices TransactionSketch::CalculateIndices(KeySum const &key) const
+{
+  std::size_t const partition_size = cells_.size() / NUM_HASHES;
+
+  // the first word of the digest is not used since it holds the prefix of the subtree, which is
+  // the same for all the digests in a sketch
+  Indices indices{};
+  for (std::size_t i = 0; i < NUM_HASHES; ++i)
+  {
+    uint64_t const hash = Mix(key[(i % 3u) + 1u] + (i * 0x9e3779b97f4a7c15ull));
+
+    indices[i] = (i * partition_size) + static_cast<std::size_t>(hash % partition_size);
+  }
+
+  return indices;
+}
+
+/**
+ * Add (or remove) a digest to the cells of a sketch
+ *
+ * @param key The digest
+ * @param count The number of times the digest is added (negative if removed)
+ * @param cells The cells to be updated
+ */
+void TransactionSketch::Update(KeySum const &key, int64_t count, Cells &cells) const
+{
+  uint64_t const checksum = Checksum(key);
+
+  for (std::size_t index : CalculateIndices(key))
+  {
+    Cell &cell = cells[index];
+
+    cell.count += count;
+    cell.hash_sum ^= checksum;
+
+    for (std::size_t j = 0; j < key.size(); ++j)
+    {
+      cell.key_sum[j] ^= key[j];
+    }
+  }
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -19,6 +19,8 @@
 #include "ledger/storage_unit/transaction_store_sync_protocol.hpp"
 #include "ledger/chain/transaction_rpc_serializers.hpp"
 
+#include <algorithm>
+
 using fetch::byte_array::ConstByteArray;
 
 // TODO(issue 7): Make cache configurable
@@ -46,6 +48,8 @@ static void RecordNewCacheElement(ConstByteArray const &identifier)
 namespace fetch {
 namespace ledger {
 
+constexpr uint64_t TransactionStoreSyncProtocol::MAX_SKETCH_CELLS_;
+
 /**
  * Create a transaction store sync protocol
  *
@@ -63,6 +67,7 @@ TransactionStoreSyncProtocol::TransactionStoreSyncProtocol(ObjectStore *store, i
   this->ExposeWithClientContext(PULL_OBJECTS, this, &Self::PullObjects);
   this->Expose(PULL_SUBTREE, this, &Self::PullSubtree);
   this->Expose(PULL_SPECIFIC_OBJECTS, this, &Self::PullSpecificObjects);
+  this->Expose(PULL_SKETCH, this, &Self::PullSketch);
 }
 
 void TransactionStoreSyncProtocol::TrimCache()
@@ -174,5 +179,29 @@ TransactionStoreSyncProtocol::TxArray TransactionStoreSyncProtocol::PullSpecific
   return ret;
 }
 
+/**
+ * Allow peers to reconcile a subtree with the one they hold, by building a sketch of the digests
+ * of the transactions in the subtree
+ *
+ * @param rid The key whose leading bits define the subtree
+ * @param bit_count The number of leading bits of the key to be matched
+ * @param num_cells The number of cells in the sketch (which is limited)
+ * @return The sketch of the subtree
+ */
+TransactionSketch TransactionStoreSyncProtocol::PullSketch(byte_array::ConstByteArray const &rid,
+                                                           uint64_t bit_count, uint64_t num_cells)
+{
+  generics::MilliTimer timer("ObjectSync:PullSketch", 500);
+
+  TransactionSketch sketch{static_cast<std::size_t>(std::min(num_cells, MAX_SKETCH_CELLS_))};
+
+  for (auto const &key : store_->PullSubtreeKeys(rid, bit_count))
+  {
+    sketch.Add(key);
+  }
+
+  return sketch;
+}
+
 }  // namespace ledger
 }  // namespace fetch
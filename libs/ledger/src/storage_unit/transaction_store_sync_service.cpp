@@ -41,6 +41,12 @@ static char const *FETCH_MAYBE_UNUSED ToString(fetch::ledger::tx_sync::State sta
   case State::RESOLVING_OBJECT_COUNTS:
     text = "Resolving Object Counts";
     break;
+  case State::QUERY_SKETCH:
+    text = "Query Sketch";
+    break;
+  case State::RESOLVING_SKETCH:
+    text = "Resolving Sketch";
+    break;
   case State::QUERY_SUBTREE:
     text = "Query Subtree";
     break;
@@ -85,6 +91,10 @@ TransactionStoreSyncService::TransactionStoreSyncService(Config const &cfg, Mudd
                                   &TransactionStoreSyncService::OnQueryObjectCounts);
   state_machine_->RegisterHandler(State::RESOLVING_OBJECT_COUNTS, this,
                                   &TransactionStoreSyncService::OnResolvingObjectCounts);
+  state_machine_->RegisterHandler(State::QUERY_SKETCH, this,
+                                  &TransactionStoreSyncService::OnQuerySketch);
+  state_machine_->RegisterHandler(State::RESOLVING_SKETCH, this,
+                                  &TransactionStoreSyncService::OnResolvingSketch);
   state_machine_->RegisterHandler(State::QUERY_SUBTREE, this,
                                   &TransactionStoreSyncService::OnQuerySubtree);
   state_machine_->RegisterHandler(State::RESOLVING_SUBTREE, this,
@@ -169,10 +179,10 @@ TransactionStoreSyncService::State TransactionStoreSyncService::OnResolvingObjec
     }
   }
 
-  // If there are objects to sync from the network, fetch N roots from each of the peers in
-  // parallel. So if we decided to split the sync into 4 roots, the mask would be 2 (bits) and
-  // the roots to sync 00, 10, 01 and 11...
-  // where roots to sync are all objects with the key starting with those bits
+  // If there are objects to sync from the network, the transactions are split into subtrees
+  // which are synced from each of the peers in parallel. So if we decided to split the sync into 4
+  // subtrees, the prefix would be 2 (bits) and the subtrees to sync 00, 10, 01 and 11...
+  // where the subtrees are all the objects with the key starting with those bits
   if (max_object_count_ == 0)
   {
     FETCH_LOG_DEBUG(LOGGING_NAME, "Network appears to have no transactions! Number of peers: ",
@@ -180,17 +190,48 @@ TransactionStoreSyncService::State TransactionStoreSyncService::OnResolvingObjec
   }
   else
   {
+    uint64_t const local_count = store_->Size();
+    uint64_t const difference =
+        ((max_object_count_ > local_count) ? (max_object_count_ - local_count) : 0) +
+        MIN_SKETCH_DIFFERENCE;
+
     FETCH_LOG_INFO(LOGGING_NAME, "Lane ", cfg_.lane_id, ": ",
-                   "Expected tx size: ", max_object_count_);
+                   "Expected tx size: ", max_object_count_, " local tx size: ", local_count);
 
-    root_size_ = platform::Log2Ceil(((max_object_count_ / (PULL_LIMIT / 2)) + 1)) + 1;
+    if ((local_count == 0) || (difference > (max_object_count_ / 2)))
+    {
+      // when most of the transactions are missing, a sketch would not save enough of the transfer
+      // to be worth its size, so the subtrees are pulled in full
+      uint64_t bit_count = 1;
+      while ((bit_count < MAX_SUBTREE_BITS) && ((max_object_count_ >> bit_count) > PULL_LIMIT / 2))
+      {
+        ++bit_count;
+      }
 
-    for (uint64_t i = 0, end = (1u << root_size_); i < end; ++i)
+      QueueSubtrees(bit_count, 0, roots_to_sync_);
+    }
+    else
     {
-      roots_to_sync_.push(Reverse(static_cast<uint8_t>(i)));
+      // otherwise only the symmetric difference of the transactions is exchanged, with the
+      // subtrees sized so that each sketch is able to decode its share of the difference
+      uint64_t bit_count = 0;
+      while ((bit_count < MAX_SUBTREE_BITS) && ((difference >> bit_count) > MAX_SKETCH_DIFFERENCE))
+      {
+        ++bit_count;
+      }
+
+      uint64_t const subtree_difference = (difference + (1u << bit_count) - 1u) >> bit_count;
+
+      QueueSubtrees(bit_count, TransactionSketch::CellsFor(subtree_difference),
+                    subtrees_to_reconcile_);
     }
   }
 
+  if (!subtrees_to_reconcile_.empty())
+  {
+    return State::QUERY_SKETCH;
+  }
+
   if (roots_to_sync_.empty())
   {
     state_machine_->Delay(std::chrono::milliseconds{20});
@@ -201,6 +242,134 @@ TransactionStoreSyncService::State TransactionStoreSyncService::OnResolvingObjec
   return State::QUERY_SUBTREE;
 }
 
+TransactionStoreSyncService::State TransactionStoreSyncService::OnQuerySketch()
+{
+  FETCH_LOCK(mutex_);
+  for (auto const &connection : muddle_->AsEndpoint().GetDirectlyConnectedPeers())
+  {
+    if (subtrees_to_reconcile_.empty())
+    {
+      break;
+    }
+
+    auto const subtree = subtrees_to_reconcile_.front();
+    subtrees_to_reconcile_.pop();
+
+    auto promise = PromiseOfSketch(client_->CallSpecificAddress(
+        connection, RPC_TX_STORE_SYNC, TransactionStoreSyncProtocol::PULL_SKETCH,
+        SubtreePrefix(subtree), subtree.bit_count, subtree.num_cells));
+
+    sketch_requests_[subtree.key()] = Reconciliation{subtree, connection};
+    pending_sketches_.Add(subtree.key(), promise);
+  }
+
+  if (!subtrees_to_reconcile_.empty())
+  {
+    return State::QUERY_SKETCH;
+  }
+
+  promise_wait_timeout_.Set(cfg_.promise_wait_timeout);
+
+  return State::RESOLVING_SKETCH;
+}
+
+TransactionStoreSyncService::State TransactionStoreSyncService::OnResolvingSketch()
+{
+  auto sketch_counts = pending_sketches_.Resolve();
+
+  FETCH_LOCK(mutex_);
+  for (auto &result : pending_sketches_.Get(MAX_SKETCH_RESOLUTION_PER_CYCLE))
+  {
+    auto it = sketch_requests_.find(result.key);
+    if (it != sketch_requests_.end())
+    {
+      Reconciliation const reconciliation = it->second;
+      sketch_requests_.erase(it);
+
+      ReconcileSubtree(reconciliation, std::move(result.promised));
+    }
+  }
+
+  // resolved after the sketches so that the requests made by the reconciliations are included
+  auto difference_counts = pending_differences_.Resolve();
+
+  std::size_t synced_tx{0};
+  for (auto &result : pending_differences_.Get(MAX_SUBTREE_RESOLUTION_PER_CYCLE))
+  {
+    difference_requests_.erase(result.key);
+
+    for (auto &tx : result.promised)
+    {
+      verifier_.AddTransaction(std::make_shared<Transaction>(tx));
+      ++synced_tx;
+    }
+  }
+
+  if (synced_tx)
+  {
+    FETCH_LOG_INFO(LOGGING_NAME, "Lane ", cfg_.lane_id, " Reconciled ", synced_tx, " txs");
+  }
+
+  // failed requests cause the subtree to be reconciled again (likely with another peer)
+  auto const retry = [this](ReconciliationMap &requests, uint64_t key) {
+    auto it = requests.find(key);
+    if (it != requests.end())
+    {
+      subtrees_to_reconcile_.push(it->second.subtree);
+      requests.erase(it);
+    }
+  };
+
+  if ((sketch_counts.failed > 0) || (difference_counts.failed > 0))
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Lane ", cfg_.lane_id, ": ", "Failed reconciliation promises ",
+                   sketch_counts.failed + difference_counts.failed);
+
+    for (auto &fail : pending_sketches_.GetFailures(MAX_SKETCH_RESOLUTION_PER_CYCLE))
+    {
+      retry(sketch_requests_, fail.key);
+    }
+
+    for (auto &fail : pending_differences_.GetFailures(MAX_SUBTREE_RESOLUTION_PER_CYCLE))
+    {
+      retry(difference_requests_, fail.key);
+    }
+  }
+
+  if ((sketch_counts.pending > 0) || (difference_counts.pending > 0))
+  {
+    if (!promise_wait_timeout_.IsDue())
+    {
+      if (!subtrees_to_reconcile_.empty())
+      {
+        return State::QUERY_SKETCH;
+      }
+
+      return State::RESOLVING_SKETCH;
+    }
+
+    FETCH_LOG_WARN(LOGGING_NAME, "Lane ", cfg_.lane_id, ": ",
+                   "Timeout for reconciliation promises!");
+
+    for (auto const &pending : pending_sketches_.GetPending())
+    {
+      retry(sketch_requests_, pending.first);
+    }
+
+    for (auto const &pending : pending_differences_.GetPending())
+    {
+      retry(difference_requests_, pending.first);
+    }
+  }
+
+  if (!subtrees_to_reconcile_.empty())
+  {
+    return State::QUERY_SKETCH;
+  }
+
+  return roots_to_sync_.empty() ? State::QUERY_OBJECTS : State::QUERY_SUBTREE;
+}
+
 TransactionStoreSyncService::State TransactionStoreSyncService::OnQuerySubtree()
 {
   assert(!roots_to_sync_.empty());
@@ -208,20 +377,20 @@ TransactionStoreSyncService::State TransactionStoreSyncService::OnQuerySubtree()
   FETCH_LOCK(mutex_);
   for (auto const &connection : muddle_->AsEndpoint().GetDirectlyConnectedPeers())
   {
+    if (roots_to_sync_.empty())
+    {
+      break;
+    }
+
     auto root = roots_to_sync_.front();
     roots_to_sync_.pop();
 
-    byte_array::ByteArray transactions_prefix;
-
-    transactions_prefix.Resize(std::size_t{ResourceID::RESOURCE_ID_SIZE_IN_BYTES});
-    transactions_prefix[0] = root;
-
     auto promise = PromiseOfTxList(client_->CallSpecificAddress(
         connection, RPC_TX_STORE_SYNC, TransactionStoreSyncProtocol::PULL_SUBTREE,
-        transactions_prefix, root_size_));
+        SubtreePrefix(root), root.bit_count));
 
     promise_id_to_roots_[promise.id()] = root;
-    pending_subtree_.Add(root, promise);
+    pending_subtree_.Add(root.key(), promise);
   }
 
   if (!roots_to_sync_.empty())
@@ -393,6 +562,109 @@ TransactionStoreSyncService::State TransactionStoreSyncService::OnTrimCache()
   return State::QUERY_OBJECTS;
 }
 
+/**
+ * Build the key whose leading bits define a subtree
+ *
+ * @param subtree The subtree
+ * @return The key
+ */
+byte_array::ConstByteArray TransactionStoreSyncService::SubtreePrefix(Subtree const &subtree)
+{
+  byte_array::ByteArray prefix;
+  prefix.Resize(std::size_t{ResourceID::RESOURCE_ID_SIZE_IN_BYTES});
+  prefix[0] = subtree.prefix;
+
+  return prefix;
+}
+
+/**
+ * Queue all the subtrees with the specified number of leading bits
+ *
+ * @param bit_count The number of leading bits of the subtrees
+ * @param num_cells The size of the sketch used to reconcile each subtree
+ * @param queue The queue to be populated
+ */
+void TransactionStoreSyncService::QueueSubtrees(uint64_t bit_count, uint64_t num_cells,
+                                                SubtreeQueue &queue)
+{
+  for (uint64_t i = 0, end = (1u << bit_count); i < end; ++i)
+  {
+    queue.push(Subtree{static_cast<uint8_t>(i), bit_count, num_cells});
+  }
+}
+
+/**
+ * Compare the sketch of a subtree received from a peer with the transactions held locally and
+ * request the transactions which are missing. If the sketch can not be decoded (since the
+ * difference is larger than expected), the subtree is split in two and each half is reconciled
+ * separately, until the subtrees are too small to split when they are pulled in full.
+ *
+ * @param reconciliation The subtree and the peer from which the sketch was received
+ * @param remote_sketch The sketch of the subtree held by the peer
+ */
+void TransactionStoreSyncService::ReconcileSubtree(Reconciliation const &reconciliation,
+                                                   TransactionSketch     remote_sketch)
+{
+  Subtree const &subtree = reconciliation.subtree;
+
+  // the local sketch must be the same size as the requested one
+  TransactionSketch local_sketch{subtree.num_cells};
+  for (auto const &key : store_->PullSubtreeKeys(SubtreePrefix(subtree), subtree.bit_count))
+  {
+    local_sketch.Add(key);
+  }
+
+  TransactionSketch::Digests missing{};
+  TransactionSketch::Digests excess{};
+
+  bool const decoded = (remote_sketch.num_cells() == local_sketch.num_cells()) &&
+                       remote_sketch.Subtract(local_sketch) &&
+                       remote_sketch.Decode(missing, excess);
+
+  if (!decoded)
+  {
+    if (subtree.bit_count < MAX_SUBTREE_BITS)
+    {
+      uint64_t const bit_count = subtree.bit_count + 1;
+      auto const     upper     = static_cast<uint8_t>(subtree.prefix | (1u << subtree.bit_count));
+
+      subtrees_to_reconcile_.push(Subtree{subtree.prefix, bit_count, subtree.num_cells});
+      subtrees_to_reconcile_.push(Subtree{upper, bit_count, subtree.num_cells});
+    }
+    else
+    {
+      roots_to_sync_.push(subtree);
+    }
+
+    return;
+  }
+
+  FETCH_LOG_DEBUG(LOGGING_NAME, "Lane ", cfg_.lane_id, ": Subtree ", subtree.key(), " missing ",
+                  missing.size(), " txs, peer missing ", excess.size(), " txs");
+
+  // the transactions which the peer is missing are left for it to reconcile itself
+  for (std::size_t offset = 0; offset < missing.size(); offset += PULL_LIMIT)
+  {
+    std::size_t const end = std::min(missing.size(), offset + std::size_t{PULL_LIMIT});
+
+    std::vector<ResourceID> rids;
+    rids.reserve(end - offset);
+    for (std::size_t i = offset; i < end; ++i)
+    {
+      rids.emplace_back(missing[i]);
+    }
+
+    auto promise = PromiseOfTxList(
+        client_->CallSpecificAddress(reconciliation.peer, RPC_TX_STORE_SYNC,
+                                     TransactionStoreSyncProtocol::PULL_SPECIFIC_OBJECTS, rids));
+
+    uint64_t const id = next_difference_id_++;
+
+    difference_requests_[id] = reconciliation;
+    pending_differences_.Add(id, promise);
+  }
+}
+
 void TransactionStoreSyncService::OnTransaction(TransactionPtr const &tx)
 {
   ResourceID const rid(tx->digest());
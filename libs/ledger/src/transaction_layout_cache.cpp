@@ -0,0 +1,135 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/transaction_layout_cache.hpp"
+#include "ledger/chain/transaction.hpp"
+
+#include <algorithm>
+#include <mutex>
+
+namespace fetch {
+namespace ledger {
+
+constexpr std::size_t TransactionLayoutCache::DEFAULT_CAPACITY;
+constexpr std::size_t TransactionLayoutCache::SEGMENT_SIZE;
+
+/**
+ * Construct the layout cache
+ *
+ * @param log2_num_lanes The log2 of the number of lanes, used to compute the layouts
+ * @param capacity The maximum number of layouts held in the cache
+ */
+TransactionLayoutCache::TransactionLayoutCache(uint32_t log2_num_lanes, std::size_t capacity)
+  : log2_num_lanes_{log2_num_lanes}
+  , generation_size_{std::max<std::size_t>(capacity / 2u, 1u)}
+  , segment_size_{std::min(generation_size_, SEGMENT_SIZE)}
+{}
+
+/**
+ * Add the layout of the specified transaction to the cache
+ *
+ * @param tx The reference to the transaction
+ */
+void TransactionLayoutCache::Add(Transaction const &tx)
+{
+  Add(TransactionLayout{tx, log2_num_lanes_});
+}
+
+/**
+ * Add the specified transaction layout to the cache
+ *
+ * @param layout The layout to be added
+ */
+void TransactionLayoutCache::Add(TransactionLayout const &layout)
+{
+  WriteLock lock{lock_};
+
+  if ((current_.digests.find(layout.digest()) != current_.digests.end()) ||
+      (previous_.digests.find(layout.digest()) != previous_.digests.end()))
+  {
+    return;
+  }
+
+  // rotate the generations once the current one is full
+  if (current_.digests.size() >= generation_size_)
+  {
+    previous_ = std::move(current_);
+    current_  = Generation{};
+  }
+
+  // the segments are reserved up front so that the written layouts are never moved
+  if (current_.segments.empty() || (current_.segments.back()->size() >= segment_size_))
+  {
+    current_.segments.push_back(std::make_shared<Segment>());
+    current_.segments.back()->reserve(segment_size_);
+  }
+
+  current_.digests.insert(layout.digest());
+  current_.segments.back()->push_back(layout);
+}
+
+/**
+ * Visit all the layouts in the cache, newest first
+ *
+ * @param visitor The function to be called with every layout
+ */
+void TransactionLayoutCache::Visit(Visitor const &visitor) const
+{
+  VisitRecent(size(), [&visitor](TransactionLayout const &layout) {
+    visitor(layout);
+    return true;
+  });
+}
+
+/**
+ * Get the number of layouts in the cache
+ *
+ * @return The number of layouts
+ */
+std::size_t TransactionLayoutCache::size() const
+{
+  ReadLock lock{lock_};
+
+  return current_.digests.size() + previous_.digests.size();
+}
+
+/**
+ * Capture the written ranges of the segments in the cache, oldest first
+ *
+ * @return The snapshot of the cache
+ */
+TransactionLayoutCache::Snapshot TransactionLayoutCache::TakeSnapshot() const
+{
+  ReadLock lock{lock_};
+
+  Snapshot snapshot;
+  snapshot.reserve(previous_.segments.size() + current_.segments.size());
+
+  for (auto const *generation : {&previous_, &current_})
+  {
+    for (auto const &segment : generation->segments)
+    {
+      snapshot.push_back(Range{segment, segment->data(), segment->size()});
+    }
+  }
+
+  return snapshot;
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -22,6 +22,7 @@
 #include "ledger/chain/transaction.hpp"
 #include "ledger/chain/transaction_layout.hpp"
 #include "ledger/storage_unit/storage_unit_interface.hpp"
+#include "ledger/transaction_layout_cache.hpp"
 #include "ledger/transaction_status_cache.hpp"
 #include "metrics/metrics.hpp"
 
@@ -33,13 +34,16 @@ namespace ledger {
  *
  * @param storage The reference to the storage unit
  * @param miner The reference to the system miner
+ * @param layout_cache The reference to the cache of layouts used to rebuild compact blocks
  */
 TransactionProcessor::TransactionProcessor(StorageUnitInterface &  storage,
                                            BlockPackerInterface &  packer,
+                                           TransactionLayoutCache &layout_cache,
                                            TransactionStatusCache &tx_status_cache,
                                            std::size_t             num_threads)
   : storage_{storage}
   , packer_{packer}
+  , layout_cache_{layout_cache}
   , status_cache_{tx_status_cache}
   , verifier_{*this, num_threads, "TxV-P"}
   , running_{false}
@@ -72,6 +76,7 @@ void TransactionProcessor::OnTransaction(TransactionPtr const &tx)
 
   // dispatch the summary to the miner
   packer_.EnqueueTransaction(*tx);
+  layout_cache_.Add(*tx);
 
   // update the status cache with the state of this transaction
   status_cache_.Update(tx->digest(), TransactionStatus::PENDING);
@@ -98,6 +103,7 @@ void TransactionProcessor::ThreadEntryPoint()
     for (auto const &summary : new_txs)
     {
       packer_.EnqueueTransaction(summary);
+      layout_cache_.Add(summary);
 
       FETCH_METRIC_TX_QUEUED(summary.transaction_hash);
     }
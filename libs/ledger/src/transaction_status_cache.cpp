@@ -17,8 +17,12 @@
 //------------------------------------------------------------------------------
 
 #include "ledger/transaction_status_cache.hpp"
+#include "core/threading.hpp"
 #include "network/generics/milli_timer.hpp"
 
+#include <algorithm>
+#include <mutex>
+
 static const std::chrono::hours   LIFETIME{24};
 static const std::chrono::minutes INTERVAL{5};
 
@@ -27,6 +31,8 @@ using fetch::generics::MilliTimer;
 namespace fetch {
 namespace ledger {
 
+constexpr std::size_t TransactionStatusCache::NUM_SHARDS;
+
 char const *ToString(TransactionStatus status)
 {
   char const *text = "Unknown";
@@ -49,15 +55,36 @@ char const *ToString(TransactionStatus status)
   return text;
 }
 
+/**
+ * Construct the cache and start the background expiry of its entries
+ */
+TransactionStatusCache::TransactionStatusCache()
+  : thread_{std::make_unique<std::thread>(&TransactionStatusCache::ThreadEntryPoint, this)}
+{}
+
+TransactionStatusCache::~TransactionStatusCache()
+{
+  stop_.Set(true);
+  thread_->join();
+}
+
+/**
+ * Query the status of a transaction
+ *
+ * @param digest The digest of the transaction
+ * @return The status of the transaction, or UNKNOWN if it is not present in the cache
+ */
 TransactionStatus TransactionStatusCache::Query(Digest digest) const
 {
   TransactionStatus status{TransactionStatus::UNKNOWN};
 
+  auto const &shard = LookupShard(digest);
+
   {
-    FETCH_LOCK(mtx_);
+    ReadLock lock{shard.lock};
 
-    auto const it = cache_.find(digest);
-    if (cache_.end() != it)
+    auto const it = shard.cache.find(digest);
+    if (shard.cache.end() != it)
     {
       status = it->second.status;
     }
@@ -66,40 +93,167 @@ TransactionStatus TransactionStatusCache::Query(Digest digest) const
   return status;
 }
 
+/**
+ * Update the status of a transaction
+ *
+ * @param digest The digest of the transaction
+ * @param status The new status of the transaction
+ * @param now The time of the update
+ */
 void TransactionStatusCache::Update(Digest digest, TransactionStatus status, Timepoint const &now)
 {
-  FETCH_LOCK(mtx_);
+  auto &shard = LookupShard(digest);
 
-  // update the cache
-  cache_[digest] = Element{status, now};
+  FETCH_LOCK(shard.lock);
+  Insert(shard, digest, status, now);
+}
+
+/**
+ * Update the status of a batch of transactions, for example all the transactions of a block. Each
+ * shard is locked once for all of its transactions in the batch.
+ *
+ * @param digests The digests of the transactions
+ * @param status The new status of the transactions
+ * @param now The time of the update
+ */
+void TransactionStatusCache::Update(Digests const &digests, TransactionStatus status,
+                                    Timepoint const &now)
+{
+  std::array<std::vector<Digest const *>, NUM_SHARDS> partitions{};
 
-  // determine if we need to prune the cache
-  auto const delta_prune = now - last_clean_;
-  if (delta_prune > INTERVAL)
+  for (auto const &digest : digests)
   {
-    PruneCache(now);
+    partitions[DigestHashAdapter{}(digest) % NUM_SHARDS].push_back(&digest);
+  }
+
+  for (std::size_t i = 0; i < NUM_SHARDS; ++i)
+  {
+    if (partitions[i].empty())
+    {
+      continue;
+    }
+
+    auto &shard = shards_[i];
 
-    last_clean_ = now;
+    FETCH_LOCK(shard.lock);
+    for (auto const *digest : partitions[i])
+    {
+      Insert(shard, *digest, status, now);
+    }
   }
 }
 
-void TransactionStatusCache::PruneCache(Timepoint const &now)
+/**
+ * Remove the entries which have not been updated for longer than the lifetime of the cache. This is
+ * called periodically by the background thread.
+ *
+ * @param now The current time
+ */
+void TransactionStatusCache::Prune(Timepoint const &now)
 {
   MilliTimer timer{"TxStatusCache::Prune"};
 
-  auto it = cache_.begin();
-  while (it != cache_.end())
+  for (auto &shard : shards_)
   {
-    auto const age = now - it->second.timestamp;
+    PruneShard(shard, now);
+  }
+}
 
-    if (age > LIFETIME)
-    {
-      it = cache_.erase(it);
-    }
-    else
+/**
+ * Get the number of transactions in the cache
+ *
+ * @return The number of transactions
+ */
+std::size_t TransactionStatusCache::size() const
+{
+  std::size_t total{0};
+
+  for (auto const &shard : shards_)
+  {
+    ReadLock lock{shard.lock};
+    total += shard.cache.size();
+  }
+
+  return total;
+}
+
+TransactionStatusCache::Shard &TransactionStatusCache::LookupShard(Digest const &digest)
+{
+  return shards_[DigestHashAdapter{}(digest) % NUM_SHARDS];
+}
+
+TransactionStatusCache::Shard const &TransactionStatusCache::LookupShard(
+    Digest const &digest) const
+{
+  return shards_[DigestHashAdapter{}(digest) % NUM_SHARDS];
+}
+
+/**
+ * Internal: Update an entry of a shard and record it in the current time bucket, unless it has
+ * already been recorded there. The lock of the shard must be held by the caller.
+ *
+ * @param shard The shard of the transaction
+ * @param digest The digest of the transaction
+ * @param status The new status of the transaction
+ * @param now The time of the update
+ */
+void TransactionStatusCache::Insert(Shard &shard, Digest const &digest, TransactionStatus status,
+                                    Timepoint const &now)
+{
+  auto &buckets = shard.buckets;
+  if (buckets.empty() || ((now - buckets.back().start) >= INTERVAL))
+  {
+    buckets.push_back(Bucket{++shard.num_buckets, now, now, {}});
+  }
+
+  auto &bucket  = buckets.back();
+  bucket.latest = std::max(bucket.latest, now);
+
+  auto &element = shard.cache[digest];
+  if (element.bucket != bucket.index)
+  {
+    bucket.digests.push_back(digest);
+  }
+
+  element = Element{status, now, bucket.index};
+}
+
+/**
+ * Internal: Expire the time buckets of a shard whose updates are all older than the lifetime of the
+ * cache. Entries which have been updated since are left in place, since they are also recorded in a
+ * more recent bucket.
+ *
+ * @param shard The shard to be pruned
+ * @param now The current time
+ */
+void TransactionStatusCache::PruneShard(Shard &shard, Timepoint const &now)
+{
+  FETCH_LOCK(shard.lock);
+
+  auto &buckets = shard.buckets;
+  while (!buckets.empty() && ((now - buckets.front().latest) > LIFETIME))
+  {
+    for (auto const &digest : buckets.front().digests)
     {
-      ++it;
+      auto const it = shard.cache.find(digest);
+      if ((it != shard.cache.end()) && ((now - it->second.timestamp) > LIFETIME))
+      {
+        shard.cache.erase(it);
+      }
     }
+
+    buckets.pop_front();
+  }
+}
+
+void TransactionStatusCache::ThreadEntryPoint()
+{
+  SetThreadName("TxStatusPrune");
+
+  // run until signalled to stop
+  while (!stop_.WaitFor(true, INTERVAL))
+  {
+    Prune();
   }
 }
 
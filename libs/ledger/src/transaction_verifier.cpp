@@ -24,7 +24,9 @@
 #include "metrics/metrics.hpp"
 #include "network/generics/milli_timer.hpp"
 
+#include <algorithm>
 #include <chrono>
+#include <iterator>
 
 static const std::chrono::milliseconds POP_TIMEOUT{300};
 
@@ -76,33 +78,66 @@ void TransactionVerifier::Stop()
 }
 
 /**
- * Internal: Thread process for the verification of
+ * Verify a batch of transactions
+ *
+ * All the signatories' public keys are resolved through the verifier's key cache. The invalid
+ * transactions are removed from the batch, preserving the order of the remaining ones.
+ *
+ * @param batch The batch of transactions to be verified
+ * @return The number of valid transactions remaining in the batch
+ */
+std::size_t TransactionVerifier::VerifyBatch(TransactionList &batch)
+{
+  auto const end = std::remove_if(batch.begin(), batch.end(), [this](TransactionPtr const &tx) {
+    bool valid{false};
+
+    try
+    {
+      FETCH_LOG_DEBUG(LOGGING_NAME, "Verifying TX: 0x", tx->digest().ToHex());
+
+      valid = tx->Verify(key_cache_);
+    }
+    catch (std::exception const &e)
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, name_ + " Exception caught: ", e.what());
+    }
+
+    if (!valid)
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, name_ + " Unable to verify transaction: 0x",
+                     tx->digest().ToHex());
+    }
+
+    return !valid;
+  });
+
+  batch.erase(end, batch.end());
+
+  return batch.size();
+}
+
+/**
+ * Internal: Thread process for the verification of transactions
  */
 void TransactionVerifier::Verifier()
 {
-  TransactionPtr tx;
+  TransactionList batch;
+  batch.reserve(MAX_BATCH_SIZE);
 
   while (active_)
   {
     try
     {
-      // wait for a mutable transaction to be available
-      if (unverified_queue_.Pop(tx, POP_TIMEOUT))
-      {
-        FETCH_LOG_DEBUG(LOGGING_NAME, "Verifying TX: 0x", tx->digest().ToHex());
+      batch.clear();
 
-        // check the status
-        if (tx->Verify())
-        {
-          FETCH_LOG_DEBUG(LOGGING_NAME, "TX Verify Complete: 0x", tx->digest().ToHex());
+      // wait for mutable transactions to be available, draining as many as possible so that they
+      // can be verified together
+      if (unverified_queue_.PopMany(batch, MAX_BATCH_SIZE, POP_TIMEOUT) > 0)
+      {
+        VerifyBatch(batch);
 
-          verified_queue_.Push(std::move(tx));
-        }
-        else
-        {
-          FETCH_LOG_WARN(LOGGING_NAME, name_ + " Unable to verify transaction: 0x",
-                         tx->digest().ToHex());
-        }
+        verified_queue_.PushMany(std::make_move_iterator(batch.begin()),
+                                 std::make_move_iterator(batch.end()));
       }
     }
     catch (std::exception const &e)
@@ -120,16 +155,23 @@ void TransactionVerifier::Dispatcher()
 {
   SetThreadName(name_ + "-D");
 
+  TransactionList batch;
+  batch.reserve(MAX_BATCH_SIZE);
+
   while (active_)
   {
     try
     {
-      TransactionPtr tx;
-      if (verified_queue_.Pop(tx, POP_TIMEOUT))
+      batch.clear();
+
+      if (verified_queue_.PopMany(batch, MAX_BATCH_SIZE, POP_TIMEOUT) > 0)
       {
-        FETCH_LOG_DEBUG(LOGGING_NAME, "TX Dispatch: 0x", tx->digest().ToHex());
+        for (auto const &tx : batch)
+        {
+          FETCH_LOG_DEBUG(LOGGING_NAME, "TX Dispatch: 0x", tx->digest().ToHex());
 
-        sink_.OnTransaction(tx);
+          sink_.OnTransaction(tx);
+        }
       }
     }
     catch (std::exception const &e)
@@ -0,0 +1,228 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/chain/block.hpp"
+#include "ledger/chain/block_cache.hpp"
+#include "ledger/chain/constants.hpp"
+#include "ledger/chain/main_chain.hpp"
+
+#include "ledger/testing/block_generator.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+using fetch::ledger::Block;
+using fetch::ledger::BlockCache;
+using fetch::ledger::BlockStatus;
+using fetch::ledger::MainChain;
+using fetch::ledger::testing::BlockGenerator;
+
+using BlockPtr  = BlockGenerator::BlockPtr;
+using BlockList = std::vector<BlockPtr>;
+
+constexpr std::size_t NUM_LANES  = 1;
+constexpr std::size_t NUM_SLICES = 2;
+
+class BlockCacheTests : public ::testing::Test
+{
+protected:
+  BlockList GenerateChain(std::size_t length)
+  {
+    BlockList blocks{generator_.Generate()};
+    for (std::size_t i = 1; i < length; ++i)
+    {
+      blocks.push_back(generator_.Generate(blocks.back()));
+    }
+
+    return blocks;
+  }
+
+  static std::size_t CountBodies(BlockCache const &cache, BlockList const &blocks)
+  {
+    std::size_t count{0};
+    for (auto const &block : blocks)
+    {
+      if (cache.HasBody(block->body.hash))
+      {
+        ++count;
+      }
+    }
+
+    return count;
+  }
+
+  BlockGenerator generator_{NUM_LANES, NUM_SLICES};
+};
+
+TEST_F(BlockCacheTests, BodiesAreNotEvictedUntilPersisted)
+{
+  BlockCache cache{0};
+
+  auto const blocks = GenerateChain(3);
+  for (auto const &block : blocks)
+  {
+    cache.Add(block);
+  }
+
+  EXPECT_EQ(cache.size(), blocks.size());
+  EXPECT_EQ(CountBodies(cache, blocks), blocks.size());
+
+  BlockCache::BlockPtr output{};
+  ASSERT_TRUE(cache.Get(blocks[1]->body.hash, output));
+  EXPECT_EQ(output, blocks[1]);
+}
+
+TEST_F(BlockCacheTests, HeadersArePinnedAfterEviction)
+{
+  BlockCache cache{0};
+
+  auto const blocks = GenerateChain(2);
+  auto const block  = blocks.back();
+
+  cache.Add(block);
+  cache.MarkPersisted(block->body.hash);
+
+  // the body is evicted immediately since the cache has no budget
+  BlockCache::BlockPtr output{};
+  EXPECT_TRUE(cache.Has(block->body.hash));
+  EXPECT_FALSE(cache.HasBody(block->body.hash));
+  EXPECT_FALSE(cache.Get(block->body.hash, output));
+
+  ASSERT_TRUE(cache.GetHeader(block->body.hash, output));
+  EXPECT_EQ(output->body.hash, block->body.hash);
+  EXPECT_EQ(output->body.previous_hash, block->body.previous_hash);
+  EXPECT_EQ(output->body.block_number, block->body.block_number);
+  EXPECT_EQ(output->total_weight, block->total_weight);
+  EXPECT_TRUE(output->body.slices.empty());
+
+  // the original block is unaffected by the eviction
+  EXPECT_EQ(block->body.slices.size(), NUM_SLICES);
+}
+
+TEST_F(BlockCacheTests, EvictsOnlyWhatIsRequired)
+{
+  // skip the genesis block so that all the blocks have the same size
+  auto blocks = GenerateChain(4);
+  blocks.erase(blocks.begin());
+
+  auto const header_size = [&blocks]() {
+    BlockCache cache{0};
+    cache.Add(blocks[0]);
+    cache.MarkPersisted(blocks[0]->body.hash);
+    return cache.size_in_bytes();
+  }();
+  auto const body_size = BlockCache::CalculateBodySize(*blocks[0]);
+
+  // enough space for all of the headers, but only one of the bodies
+  BlockCache cache{(blocks.size() * header_size) + body_size};
+  for (auto const &block : blocks)
+  {
+    cache.Add(block);
+  }
+
+  EXPECT_EQ(CountBodies(cache, blocks), blocks.size());
+
+  for (auto const &block : blocks)
+  {
+    cache.MarkPersisted(block->body.hash);
+  }
+
+  EXPECT_EQ(cache.size(), blocks.size());
+  EXPECT_EQ(CountBodies(cache, blocks), 1u);
+  EXPECT_LE(cache.size_in_bytes(), cache.max_bytes());
+
+  // restoring a body causes another to be evicted
+  BlockPtr evicted{};
+  for (auto const &block : blocks)
+  {
+    if (!cache.HasBody(block->body.hash))
+    {
+      evicted = block;
+      break;
+    }
+  }
+
+  ASSERT_TRUE(static_cast<bool>(evicted));
+  EXPECT_TRUE(cache.Restore(evicted));
+  EXPECT_EQ(CountBodies(cache, blocks), 1u);
+  EXPECT_LE(cache.size_in_bytes(), cache.max_bytes());
+}
+
+TEST_F(BlockCacheTests, EraseReleasesTheBlock)
+{
+  BlockCache cache{};
+
+  auto const blocks = GenerateChain(4);
+  for (auto const &block : blocks)
+  {
+    cache.Add(block);
+  }
+
+  EXPECT_GT(cache.size_in_bytes(), 0u);
+
+  for (auto const &block : blocks)
+  {
+    EXPECT_TRUE(cache.Erase(block->body.hash));
+    EXPECT_FALSE(cache.Has(block->body.hash));
+  }
+
+  EXPECT_FALSE(cache.Erase(blocks[0]->body.hash));
+  EXPECT_EQ(cache.size(), 0u);
+  EXPECT_EQ(cache.size_in_bytes(), 0u);
+}
+
+TEST_F(BlockCacheTests, MainChainReloadsEvictedBlocks)
+{
+  static constexpr std::size_t CHAIN_LENGTH = 5 * fetch::ledger::FINALITY_PERIOD;
+
+  // with no budget the bodies of the blocks are evicted as soon as they have been persisted
+  MainChain chain{MainChain::Mode::CREATE_PERSISTENT_DB, 0};
+
+  auto const blocks = GenerateChain(CHAIN_LENGTH);
+  for (std::size_t i = 1; i < blocks.size(); ++i)
+  {
+    ASSERT_EQ(BlockStatus::ADDED, chain.AddBlock(*blocks[i]));
+  }
+
+  auto const &early_block = blocks[fetch::ledger::FINALITY_PERIOD];
+  EXPECT_TRUE(chain.block_cache().Has(early_block->body.hash));
+  EXPECT_FALSE(chain.block_cache().HasBody(early_block->body.hash));
+
+  // the complete block is still available
+  auto const block = chain.GetBlock(early_block->body.hash);
+  ASSERT_TRUE(static_cast<bool>(block));
+  EXPECT_EQ(block->body.slices.size(), NUM_SLICES);
+
+  // the heaviest chain includes the genesis block
+  auto const heaviest_chain = chain.GetHeaviestChain();
+  ASSERT_EQ(heaviest_chain.size(), CHAIN_LENGTH);
+
+  for (std::size_t i = 0; i < heaviest_chain.size(); ++i)
+  {
+    auto const &expected = blocks[CHAIN_LENGTH - (i + 1)];
+
+    EXPECT_EQ(heaviest_chain[i]->body.hash, expected->body.hash);
+    EXPECT_EQ(heaviest_chain[i]->body.slices.size(), expected->body.slices.size());
+  }
+}
+
+}  // namespace
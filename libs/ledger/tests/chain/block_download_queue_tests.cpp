@@ -0,0 +1,321 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/bitvector.hpp"
+#include "core/byte_array/byte_array.hpp"
+#include "core/random/lcg.hpp"
+#include "core/serializers/byte_array_buffer.hpp"
+#include "ledger/chain/address.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/chain/block_download_queue.hpp"
+#include "ledger/chain/block_header.hpp"
+#include "ledger/chain/transaction_layout.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::byte_array::ByteArray;
+using fetch::ledger::Address;
+using fetch::ledger::Block;
+using fetch::ledger::BlockDownloadQueue;
+using fetch::ledger::BlockHeader;
+using fetch::ledger::Digest;
+using fetch::ledger::TransactionLayout;
+using fetch::random::LinearCongruentialGenerator;
+using fetch::serializers::ByteArrayBuffer;
+
+using Blocks      = BlockDownloadQueue::Blocks;
+using BlockHashes = BlockDownloadQueue::BlockHashes;
+using Headers     = BlockDownloadQueue::Headers;
+using WindowId    = BlockDownloadQueue::WindowId;
+
+constexpr uint32_t LOG2_NUM_LANES = 2;
+
+class BlockDownloadQueueTests : public ::testing::Test
+{
+protected:
+  Digest GenerateDigest()
+  {
+    ByteArray digest;
+    digest.Resize(32);
+
+    for (std::size_t i = 0; i < digest.size(); i += sizeof(uint64_t))
+    {
+      uint64_t const value = rng_();
+      for (std::size_t j = 0; j < sizeof(uint64_t); ++j)
+      {
+        digest[i + j] = static_cast<uint8_t>(value >> (j * 8u));
+      }
+    }
+
+    return {digest};
+  }
+
+  void GenerateChain(std::size_t length)
+  {
+    Digest previous_hash = GenerateDigest();
+
+    for (std::size_t i = 0; i < length; ++i)
+    {
+      Block block;
+      block.body.previous_hash  = previous_hash;
+      block.body.block_number   = i + 1;
+      block.body.miner          = Address{GenerateDigest()};
+      block.body.log2_num_lanes = LOG2_NUM_LANES;
+      block.nonce               = rng_();
+
+      block.body.slices.resize(2);
+      for (auto &slice : block.body.slices)
+      {
+        BitVector mask{1u << LOG2_NUM_LANES};
+        mask.set(rng_() % mask.size(), 1);
+
+        slice.emplace_back(GenerateDigest(), mask, rng_() % 1000u, 0, 100);
+      }
+
+      block.UpdateDigest();
+      previous_hash = block.body.hash;
+
+      blocks_.push_back(block);
+      headers_.emplace_back(block);
+    }
+  }
+
+  /**
+   * Build the response of a peer to a request for a window of blocks
+   */
+  Blocks Lookup(BlockHashes const &hashes) const
+  {
+    Blocks blocks;
+    for (auto const &hash : hashes)
+    {
+      for (auto const &block : blocks_)
+      {
+        if (block.body.hash == hash)
+        {
+          blocks.push_back(block);
+        }
+      }
+    }
+
+    return blocks;
+  }
+
+  void ExpectBlocks(Blocks const &blocks, std::size_t start)
+  {
+    for (std::size_t i = 0; i < blocks.size(); ++i)
+    {
+      EXPECT_EQ(blocks_[start + i].body.hash, blocks[i].body.hash);
+      EXPECT_EQ(blocks_[start + i].GetTransactionCount(), blocks[i].GetTransactionCount());
+    }
+  }
+
+  LinearCongruentialGenerator rng_;
+  Blocks                      blocks_;
+  Headers                     headers_;
+};
+
+TEST_F(BlockDownloadQueueTests, CheckHeadersMatchTheirBlocks)
+{
+  GenerateChain(1);
+
+  // the header must survive serialisation without its slices
+  ByteArrayBuffer buffer;
+  buffer << headers_.front();
+
+  BlockHeader header;
+  buffer.seek(0);
+  buffer >> header;
+
+  EXPECT_TRUE(header.header.body.slices.empty());
+
+  header.header.body.hash = Digest{};
+  header.UpdateDigest();
+  EXPECT_EQ(blocks_.front().body.hash, header.header.body.hash);
+
+  // the hash of the header commits to the transactions of the block
+  header.transaction_root = GenerateDigest();
+  header.UpdateDigest();
+  EXPECT_NE(blocks_.front().body.hash, header.header.body.hash);
+}
+
+TEST_F(BlockDownloadQueueTests, CheckWindowsCoverTheHeadersInOrder)
+{
+  GenerateChain(10);
+
+  BlockDownloadQueue queue{headers_, 4};
+
+  std::vector<std::size_t> sizes;
+
+  WindowId    id{0};
+  BlockHashes hashes;
+  std::size_t next{0};
+  while (queue.Assign(id, hashes))
+  {
+    sizes.push_back(hashes.size());
+
+    for (auto const &hash : hashes)
+    {
+      EXPECT_EQ(blocks_[next++].body.hash, hash);
+    }
+  }
+
+  EXPECT_EQ((std::vector<std::size_t>{4, 4, 2}), sizes);
+  EXPECT_EQ(3u, queue.GetInFlightCount());
+  EXPECT_EQ(10u, queue.GetRemainingCount());
+}
+
+TEST_F(BlockDownloadQueueTests, CheckOutOfOrderBlocksAreReleasedInChainOrder)
+{
+  GenerateChain(8);
+
+  BlockDownloadQueue queue{headers_, 4};
+
+  WindowId    first{0};
+  WindowId    second{0};
+  BlockHashes first_hashes;
+  BlockHashes second_hashes;
+  ASSERT_TRUE(queue.Assign(first, first_hashes));
+  ASSERT_TRUE(queue.Assign(second, second_hashes));
+
+  // the later window arrives first, and must be held back
+  Blocks blocks = Lookup(second_hashes);
+  queue.Complete(second, blocks);
+  EXPECT_TRUE(queue.PopReady().empty());
+  EXPECT_FALSE(queue.IsComplete());
+
+  blocks = Lookup(first_hashes);
+  queue.Complete(first, blocks);
+
+  auto const ready = queue.PopReady();
+  ASSERT_EQ(8u, ready.size());
+  ExpectBlocks(ready, 0);
+
+  EXPECT_TRUE(queue.IsComplete());
+  EXPECT_EQ(0u, queue.GetInFlightCount());
+}
+
+TEST_F(BlockDownloadQueueTests, CheckPartialAndFailedWindowsAreRequestedAgain)
+{
+  GenerateChain(8);
+
+  BlockDownloadQueue queue{headers_, 4};
+
+  WindowId    first{0};
+  WindowId    second{0};
+  BlockHashes first_hashes;
+  BlockHashes second_hashes;
+  ASSERT_TRUE(queue.Assign(first, first_hashes));
+  ASSERT_TRUE(queue.Assign(second, second_hashes));
+
+  // only half of the first window is served
+  Blocks blocks = Lookup({first_hashes[0], first_hashes[2]});
+  queue.Complete(first, blocks);
+  queue.Fail(second);
+
+  auto ready = queue.PopReady();
+  ASSERT_EQ(1u, ready.size());
+  ExpectBlocks(ready, 0);
+
+  // the remainder of the first window is requested before the failed window
+  WindowId    retry{0};
+  BlockHashes retry_hashes;
+  ASSERT_TRUE(queue.Assign(retry, retry_hashes));
+  EXPECT_EQ((BlockHashes{first_hashes[1], first_hashes[3]}), retry_hashes);
+
+  blocks = Lookup(retry_hashes);
+  queue.Complete(retry, blocks);
+
+  ASSERT_TRUE(queue.Assign(retry, retry_hashes));
+  EXPECT_EQ(second_hashes, retry_hashes);
+
+  blocks = Lookup(retry_hashes);
+  queue.Complete(retry, blocks);
+
+  ready = queue.PopReady();
+  ASSERT_EQ(7u, ready.size());
+  ExpectBlocks(ready, 1);
+  EXPECT_TRUE(queue.IsComplete());
+}
+
+TEST_F(BlockDownloadQueueTests, CheckBlocksWhichDoNotMatchTheirHeaderAreDiscarded)
+{
+  GenerateChain(4);
+
+  BlockDownloadQueue queue{headers_, 2};
+
+  WindowId    first{0};
+  WindowId    second{0};
+  BlockHashes first_hashes;
+  BlockHashes second_hashes;
+  ASSERT_TRUE(queue.Assign(first, first_hashes));
+  ASSERT_TRUE(queue.Assign(second, second_hashes));
+
+  // a block with a modified transaction, and a valid block which was not requested in the window
+  Blocks blocks = Lookup(first_hashes);
+  blocks[1].body.slices[0].pop_back();
+  blocks.push_back(blocks_[2]);
+  queue.Complete(first, blocks);
+
+  auto ready = queue.PopReady();
+  ASSERT_EQ(1u, ready.size());
+  ExpectBlocks(ready, 0);
+
+  WindowId    retry{0};
+  BlockHashes retry_hashes;
+  ASSERT_TRUE(queue.Assign(retry, retry_hashes));
+  EXPECT_EQ((BlockHashes{first_hashes[1]}), retry_hashes);
+
+  // responses for unknown windows are ignored
+  blocks = Lookup(second_hashes);
+  queue.Complete(retry + 1, blocks);
+  EXPECT_TRUE(queue.PopReady().empty());
+}
+
+TEST_F(BlockDownloadQueueTests, CheckLookaheadLimitsTheBufferedBlocks)
+{
+  GenerateChain(8);
+
+  BlockDownloadQueue queue{headers_, 2, 4};
+
+  WindowId    first{0};
+  WindowId    second{0};
+  WindowId    third{0};
+  BlockHashes first_hashes;
+  BlockHashes second_hashes;
+  BlockHashes third_hashes;
+  ASSERT_TRUE(queue.Assign(first, first_hashes));
+  ASSERT_TRUE(queue.Assign(second, second_hashes));
+  EXPECT_FALSE(queue.Assign(third, third_hashes));
+
+  Blocks blocks = Lookup(first_hashes);
+  queue.Complete(first, blocks);
+  EXPECT_EQ(2u, queue.PopReady().size());
+
+  // the next block has advanced, so the next window can be requested
+  ASSERT_TRUE(queue.Assign(third, third_hashes));
+  EXPECT_EQ(blocks_[4].body.hash, third_hashes.front());
+}
+
+}  // namespace
@@ -0,0 +1,334 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/bitvector.hpp"
+#include "core/byte_array/byte_array.hpp"
+#include "core/random/lcg.hpp"
+#include "core/serializers/byte_array_buffer.hpp"
+#include "ledger/chain/address.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/chain/compact_block.hpp"
+#include "ledger/chain/transaction_layout.hpp"
+#include "ledger/transaction_layout_cache.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::byte_array::ByteArray;
+using fetch::ledger::Address;
+using fetch::ledger::Block;
+using fetch::ledger::CompactBlock;
+using fetch::ledger::Digest;
+using fetch::ledger::TransactionLayout;
+using fetch::ledger::TransactionLayoutCache;
+using fetch::random::LinearCongruentialGenerator;
+using fetch::serializers::ByteArrayBuffer;
+
+using Layouts = std::vector<TransactionLayout>;
+using Indices = CompactBlock::Indices;
+
+constexpr uint32_t LOG2_NUM_LANES = 2;
+constexpr uint64_t SALT           = 0x5a17;
+
+class CompactBlockTests : public ::testing::Test
+{
+protected:
+  Digest GenerateDigest()
+  {
+    ByteArray digest;
+    digest.Resize(32);
+
+    for (std::size_t i = 0; i < digest.size(); i += sizeof(uint64_t))
+    {
+      uint64_t const value = rng_();
+      for (std::size_t j = 0; j < sizeof(uint64_t); ++j)
+      {
+        digest[i + j] = static_cast<uint8_t>(value >> (j * 8u));
+      }
+    }
+
+    return {digest};
+  }
+
+  TransactionLayout GenerateLayout()
+  {
+    BitVector mask{1u << LOG2_NUM_LANES};
+    mask.set(rng_() % mask.size(), 1);
+
+    return {GenerateDigest(), mask, rng_() % 1000u, 0, 100};
+  }
+
+  Block GenerateBlock(std::size_t num_slices, std::size_t txs_per_slice)
+  {
+    Block block;
+    block.body.previous_hash  = GenerateDigest();
+    block.body.block_number   = 10;
+    block.body.miner          = Address{GenerateDigest()};
+    block.body.log2_num_lanes = LOG2_NUM_LANES;
+    block.nonce               = rng_();
+
+    block.body.slices.resize(num_slices);
+    for (auto &slice : block.body.slices)
+    {
+      for (std::size_t i = 0; i < txs_per_slice; ++i)
+      {
+        slice.push_back(GenerateLayout());
+      }
+    }
+
+    block.UpdateDigest();
+
+    return block;
+  }
+
+  static Layouts Flatten(Block const &block)
+  {
+    Layouts layouts;
+    for (auto const &slice : block.body.slices)
+    {
+      layouts.insert(layouts.end(), slice.begin(), slice.end());
+    }
+
+    return layouts;
+  }
+
+  static void ExpectSameTransactions(Block const &expected, Block const &actual)
+  {
+    ASSERT_EQ(expected.body.slices.size(), actual.body.slices.size());
+
+    for (std::size_t i = 0; i < expected.body.slices.size(); ++i)
+    {
+      ASSERT_EQ(expected.body.slices[i].size(), actual.body.slices[i].size());
+
+      for (std::size_t j = 0; j < expected.body.slices[i].size(); ++j)
+      {
+        auto const &a = expected.body.slices[i][j];
+        auto const &b = actual.body.slices[i][j];
+
+        EXPECT_EQ(a.digest(), b.digest());
+        EXPECT_EQ(a.mask(), b.mask());
+        EXPECT_EQ(a.charge(), b.charge());
+      }
+    }
+  }
+
+  LinearCongruentialGenerator rng_;
+  TransactionLayoutCache      cache_{LOG2_NUM_LANES};
+};
+
+TEST_F(CompactBlockTests, CheckSerialization)
+{
+  auto const   block = GenerateBlock(4, 10);
+  CompactBlock compact{block, SALT};
+
+  ByteArrayBuffer buffer;
+  buffer << compact;
+  buffer.seek(0);
+
+  CompactBlock output;
+  buffer >> output;
+
+  EXPECT_EQ(block.body.hash, output.header.body.hash);
+  EXPECT_EQ(SALT, output.salt);
+  EXPECT_EQ(compact.slices, output.slices);
+  EXPECT_TRUE(output.header.body.slices.empty());
+
+  // the key for the short IDs is recovered from the block hash and the salt
+  auto const layouts = Flatten(block);
+  EXPECT_EQ(compact.ComputeShortId(layouts[7].digest()),
+            output.ComputeShortId(layouts[7].digest()));
+}
+
+TEST_F(CompactBlockTests, CheckShortIdsDependOnTheSalt)
+{
+  auto const         block = GenerateBlock(1, 1);
+  CompactBlock const first{block, SALT};
+  CompactBlock const second{block, SALT + 1};
+
+  Digest const &digest = block.body.slices[0][0].digest();
+  EXPECT_NE(first.ComputeShortId(digest), second.ComputeShortId(digest));
+}
+
+TEST_F(CompactBlockTests, CheckReconstructionFromTheCache)
+{
+  auto const         block = GenerateBlock(4, 25);
+  CompactBlock const compact{block, SALT};
+
+  for (auto const &layout : Flatten(block))
+  {
+    cache_.Add(layout);
+  }
+
+  // unrelated transactions are ignored
+  for (std::size_t i = 0; i < 500; ++i)
+  {
+    cache_.Add(GenerateLayout());
+  }
+
+  Block   output;
+  Indices missing;
+  ASSERT_TRUE(compact.Reconstruct(cache_, output, missing));
+  EXPECT_TRUE(missing.empty());
+
+  ExpectSameTransactions(block, output);
+
+  output.UpdateDigest();
+  EXPECT_EQ(block.body.hash, output.body.hash);
+}
+
+TEST_F(CompactBlockTests, CheckMissingTransactionsAreCompleted)
+{
+  auto const         block = GenerateBlock(3, 10);
+  CompactBlock const compact{block, SALT};
+  auto const         layouts = Flatten(block);
+
+  Indices expected_missing;
+  for (std::size_t i = 0; i < layouts.size(); ++i)
+  {
+    if ((i % 7) == 3)
+    {
+      expected_missing.push_back(i);
+    }
+    else
+    {
+      cache_.Add(layouts[i]);
+    }
+  }
+
+  Block   output;
+  Indices missing;
+  ASSERT_FALSE(compact.Reconstruct(cache_, output, missing));
+  ASSERT_EQ(expected_missing, missing);
+
+  // the layouts must match the short IDs of the block
+  Layouts requested;
+  for (std::size_t i = 0; i < missing.size(); ++i)
+  {
+    requested.push_back(GenerateLayout());
+  }
+  EXPECT_FALSE(compact.Complete(output, missing, requested));
+
+  requested.clear();
+  for (auto const index : missing)
+  {
+    requested.push_back(layouts[index]);
+  }
+  EXPECT_FALSE(compact.Complete(output, missing, Layouts{}));
+  ASSERT_TRUE(compact.Complete(output, missing, requested));
+
+  ExpectSameTransactions(block, output);
+
+  output.UpdateDigest();
+  EXPECT_EQ(block.body.hash, output.body.hash);
+}
+
+TEST_F(CompactBlockTests, CheckCollidingShortIdsAreReportedAsMissing)
+{
+  auto block = GenerateBlock(2, 5);
+
+  // the same transaction appears twice in the block, so its short ID is not unique
+  block.body.slices[1][2] = block.body.slices[0][4];
+  block.UpdateDigest();
+
+  CompactBlock const compact{block, SALT};
+  auto const         layouts = Flatten(block);
+
+  for (auto const &layout : layouts)
+  {
+    cache_.Add(layout);
+  }
+
+  Block   output;
+  Indices missing;
+  EXPECT_FALSE(compact.Reconstruct(cache_, output, missing));
+  EXPECT_EQ((Indices{4, 7}), missing);
+}
+
+TEST_F(CompactBlockTests, CheckOnlyTheRecentLayoutsAreScanned)
+{
+  auto const         block = GenerateBlock(2, 10);
+  CompactBlock const compact{block, SALT};
+
+  for (auto const &layout : Flatten(block))
+  {
+    cache_.Add(layout);
+  }
+
+  // the layouts of the block are pushed out of the scanned window
+  for (std::size_t i = 0; i < CompactBlock::MIN_SCAN_LENGTH; ++i)
+  {
+    cache_.Add(GenerateLayout());
+  }
+
+  Block   output;
+  Indices missing;
+  EXPECT_FALSE(compact.Reconstruct(cache_, output, missing));
+  EXPECT_EQ(compact.GetTransactionCount(), missing.size());
+}
+
+TEST_F(CompactBlockTests, CheckLayoutCacheEvictsTheOldestGeneration)
+{
+  TransactionLayoutCache cache{LOG2_NUM_LANES, 100};
+
+  Layouts layouts;
+  for (std::size_t i = 0; i < 150; ++i)
+  {
+    layouts.push_back(GenerateLayout());
+    cache.Add(layouts.back());
+
+    // duplicates are ignored
+    cache.Add(layouts.back());
+  }
+
+  // the first generation of 50 layouts has been discarded
+  EXPECT_EQ(100u, cache.size());
+
+  std::size_t num_old{0};
+  std::size_t num_new{0};
+  cache.Visit([&](TransactionLayout const &layout) {
+    for (std::size_t i = 0; i < layouts.size(); ++i)
+    {
+      if (layouts[i].digest() == layout.digest())
+      {
+        ((i < 50) ? num_old : num_new) += 1;
+      }
+    }
+  });
+
+  EXPECT_EQ(0u, num_old);
+  EXPECT_EQ(100u, num_new);
+
+  // the most recent layouts are visited first
+  Layouts recent;
+  cache.VisitRecent(3, [&recent](TransactionLayout const &layout) {
+    recent.push_back(layout);
+    return true;
+  });
+
+  ASSERT_EQ(3u, recent.size());
+  EXPECT_EQ(layouts[149].digest(), recent[0].digest());
+  EXPECT_EQ(layouts[147].digest(), recent[2].digest());
+}
+
+}  // namespace
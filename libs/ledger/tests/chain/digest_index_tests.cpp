@@ -0,0 +1,131 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/bitvector.hpp"
+#include "crypto/hash.hpp"
+#include "crypto/sha256.hpp"
+#include "ledger/chain/block.hpp"
+#include "ledger/chain/digest_index.hpp"
+
+#include "ledger/testing/block_generator.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::ledger::Block;
+using fetch::ledger::Digest;
+using fetch::ledger::DigestIndex;
+using fetch::ledger::DigestSet;
+using fetch::ledger::testing::BlockGenerator;
+
+using BlockPtr = BlockGenerator::BlockPtr;
+
+constexpr std::size_t NUM_LANES  = 1;
+constexpr std::size_t NUM_SLICES = 2;
+
+class DigestIndexTests : public ::testing::Test
+{
+protected:
+  static Digest GenerateDigest(std::size_t index)
+  {
+    return fetch::crypto::Hash<fetch::crypto::SHA256>("tx" + std::to_string(index));
+  }
+
+  /**
+   * Generate a block containing the transactions [first, first + count)
+   */
+  BlockPtr GenerateBlock(BlockPtr const &previous, std::size_t first, std::size_t count)
+  {
+    BitVector mask{NUM_LANES};
+    mask.set(0, 1);
+
+    auto block = generator_.Generate(previous);
+    for (std::size_t i = first; i < first + count; ++i)
+    {
+      block->body.slices[i % NUM_SLICES].emplace_back(GenerateDigest(i), mask, 1, 0, 100);
+    }
+    block->UpdateDigest();
+
+    return block;
+  }
+
+  BlockGenerator generator_{NUM_LANES, NUM_SLICES};
+};
+
+TEST_F(DigestIndexTests, LookupReturnsEveryLocation)
+{
+  DigestIndex index;
+
+  auto const genesis = generator_.Generate();
+  auto const block1  = GenerateBlock(genesis, 0, 10);
+  auto const block2  = GenerateBlock(block1, 10, 10);
+  auto const fork2   = GenerateBlock(block1, 5, 10);
+
+  index.Add(*block1);
+  index.Add(*block2);
+  index.Add(*fork2);
+
+  // adding the same block again has no effect
+  index.Add(*block2);
+  EXPECT_EQ(20u, index.size());
+
+  auto const locations =
+      index.Lookup(DigestSet{GenerateDigest(0), GenerateDigest(12), GenerateDigest(100)});
+  ASSERT_EQ(2u, locations.size());
+
+  auto const &first = locations.at(GenerateDigest(0));
+  ASSERT_EQ(1u, first.size());
+  EXPECT_EQ(block1->body.hash, first[0].block_hash);
+  EXPECT_EQ(block1->body.block_number, first[0].block_number);
+
+  // the transaction is present on both of the branches
+  auto const &second = locations.at(GenerateDigest(12));
+  ASSERT_EQ(2u, second.size());
+  EXPECT_EQ(block2->body.hash, second[0].block_hash);
+  EXPECT_EQ(fork2->body.hash, second[1].block_hash);
+}
+
+TEST_F(DigestIndexTests, FilterIsRebuiltAfterLoading)
+{
+  auto const genesis = generator_.Generate();
+  auto const block   = GenerateBlock(genesis, 0, 50);
+
+  {
+    DigestIndex index;
+    index.New("digest_index_test.db", "digest_index_test.index.db");
+    index.Add(*block);
+    index.Flush();
+  }
+
+  DigestIndex index;
+  index.Load("digest_index_test.db", "digest_index_test.index.db");
+  EXPECT_EQ(50u, index.size());
+
+  // until the filter has been repopulated, none of the digests pass it
+  DigestSet const digests{GenerateDigest(3), GenerateDigest(42)};
+  EXPECT_TRUE(index.Lookup(digests).empty());
+
+  index.AddToFilter(*block);
+  EXPECT_EQ(2u, index.Lookup(digests).size());
+}
+
+}  // namespace
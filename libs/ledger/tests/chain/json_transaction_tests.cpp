@@ -16,6 +16,7 @@
 //
 //------------------------------------------------------------------------------
 
+#include "core/json/on_demand.hpp"
 #include "crypto/ecdsa.hpp"
 #include "ledger/chain/address.hpp"
 #include "ledger/chain/json_transaction.hpp"
@@ -26,8 +27,11 @@
 #include "gtest/gtest.h"
 
 #include <memory>
+#include <sstream>
+#include <vector>
 
 using fetch::crypto::ECDSASigner;
+using fetch::json::OnDemandDocument;
 using fetch::ledger::Transaction;
 using fetch::ledger::TransactionBuilder;
 using fetch::ledger::Address;
@@ -76,4 +80,55 @@ TEST(JsonTransactionTests, BasicTest)
 
   EXPECT_EQ(transfers_expected[0].to, transfers_actual[0].to);
   EXPECT_EQ(transfers_expected[0].amount, transfers_actual[0].amount);
-}
\ No newline at end of file
+}
+
+TEST(JsonTransactionTests, OnDemandTest)
+{
+  ECDSASigner identity1{};
+  ECDSASigner identity2{};
+
+  Address const address1{identity1.identity()};
+  Address const address2{identity2.identity()};
+
+  auto tx = TransactionBuilder()
+                .From(address1)
+                .Transfer(address2, 500)
+                .Signer(identity1.identity())
+                .Seal()
+                .Sign(identity1)
+                .Build();
+
+  // build the json text of a batch of this transaction (with metadata to be skipped over)
+  Variant json{};
+  ASSERT_TRUE(ToJsonTransaction(*tx, json, true));
+
+  Variant batch   = Variant::Array(2);
+  batch[0]        = json;
+  batch[1]        = json;
+  batch[1]["ver"] = "1.1";
+
+  std::ostringstream text;
+  text << batch;
+
+  OnDemandDocument doc{text.str()};
+
+  std::vector<Transaction> outputs;
+  std::vector<bool>        results;
+  doc.root().ForEach([&](fetch::json::OnDemandValue const &value) {
+    outputs.emplace_back();
+    results.push_back(FromJsonTransaction(value, outputs.back()));
+  });
+
+  ASSERT_EQ(2u, results.size());
+  ASSERT_TRUE(results[0]);
+  EXPECT_EQ(tx->digest(), outputs[0].digest());
+  EXPECT_EQ(tx->from(), outputs[0].from());
+
+  // the version of the second transaction does not match
+  EXPECT_FALSE(results[1]);
+
+  // only objects are transactions
+  doc.Parse("[1]");
+  Transaction output;
+  EXPECT_FALSE(FromJsonTransaction(doc.root(), output));
+}
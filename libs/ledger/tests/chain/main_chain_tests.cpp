@@ -19,6 +19,7 @@
 #include "core/byte_array/byte_array.hpp"
 #include "core/containers/set_difference.hpp"
 #include "ledger/chain/block.hpp"
+#include "ledger/chain/digest_index.hpp"
 #include "ledger/chain/main_chain.hpp"
 #include "ledger/chain/transaction_layout_rpc_serializers.hpp"
 #include "ledger/chain/transaction_rpc_serializers.hpp"
@@ -28,6 +29,7 @@
 #include <gtest/gtest.h>
 #include <memory>
 #include <random>
+#include <vector>
 
 using namespace fetch;
 
@@ -36,6 +38,10 @@ using fetch::ledger::MainChain;
 using fetch::ledger::BlockStatus;
 using fetch::ledger::testing::BlockGenerator;
 using fetch::ledger::Address;
+using fetch::ledger::Digest;
+using fetch::ledger::DigestIndex;
+using fetch::ledger::DigestSet;
+using fetch::ledger::TransactionLayout;
 using fetch::byte_array::ToBase64;  // NOLINT - needed for debug messages
 
 using Rng               = std::mt19937_64;
@@ -54,6 +60,15 @@ static bool IsSameBlock(Block const &a, Block const &b)
          (a.proof == b.proof) && (a.nonce == b.nonce);
 }
 
+static void AddTransaction(Block &block, Digest const &digest)
+{
+  BitVector mask{1};
+  mask.set(0, 1);
+
+  block.body.slices[0].emplace_back(digest, mask, 1, 0, 1000);
+  block.UpdateDigest();
+}
+
 template <typename Container, typename Value>
 static bool Contains(Container const &collection, Value const &value)
 {
@@ -688,6 +703,171 @@ TEST_P(MainChainTests, CheckResolvedLooseWeight)
   ASSERT_EQ(chain_->GetBlock(main5->body.hash)->total_weight, main5->total_weight);
 }
 
+TEST_P(MainChainTests, CheckDuplicateTransactionsOnForks)
+{
+  Digest const tx1{"a transaction in the common history"};
+  Digest const tx2{"a transaction on the main chain"};
+  Digest const tx3{"a transaction on the side chain"};
+  Digest const tx4{"a transaction not on any chain"};
+
+  auto const genesis = generator_->Generate();
+
+  auto common = generator_->Generate(genesis);
+  AddTransaction(*common, tx1);
+
+  auto main1 = generator_->Generate(common);
+  AddTransaction(*main1, tx2);
+  auto const main2 = generator_->Generate(main1);
+
+  auto side1 = generator_->Generate(common);
+  AddTransaction(*side1, tx3);
+
+  for (auto const &block : {common, main1, main2, side1})
+  {
+    ASSERT_EQ(BlockStatus::ADDED, chain_->AddBlock(*block));
+  }
+
+  DigestSet const transactions{tx1, tx2, tx3, tx4};
+
+  EXPECT_EQ((DigestSet{tx1, tx2}),
+            chain_->DetectDuplicateTransactions(main2->body.hash, transactions));
+  EXPECT_EQ((DigestSet{tx1, tx3}),
+            chain_->DetectDuplicateTransactions(side1->body.hash, transactions));
+  EXPECT_EQ((DigestSet{tx1}),
+            chain_->DetectDuplicateTransactions(common->body.hash, transactions));
+  EXPECT_TRUE(chain_->DetectDuplicateTransactions(genesis->body.hash, transactions).empty());
+}
+
+TEST_P(MainChainTests, CheckDuplicateTransactionsOnLongChain)
+{
+  static constexpr std::size_t NUM_BLOCKS = 50;
+
+  Digest const old_tx{"a transaction in an old block"};
+  Digest const recent_tx{"a transaction in a recent block"};
+  Digest const new_tx{"a new transaction"};
+
+  auto previous_block = generator_->Generate();
+  for (std::size_t i = 0; i < NUM_BLOCKS; ++i)
+  {
+    auto next_block = generator_->Generate(previous_block);
+
+    // the old transaction is (in the persistent case) in a block which is written to the store
+    if (i == 2)
+    {
+      AddTransaction(*next_block, old_tx);
+    }
+    else if (i == (NUM_BLOCKS - 2))
+    {
+      AddTransaction(*next_block, recent_tx);
+    }
+
+    ASSERT_EQ(BlockStatus::ADDED, chain_->AddBlock(*next_block));
+    previous_block = next_block;
+  }
+
+  auto const duplicates = chain_->DetectDuplicateTransactions(previous_block->body.hash,
+                                                              DigestSet{old_tx, recent_tx, new_tx});
+
+  EXPECT_EQ((DigestSet{old_tx, recent_tx}), duplicates);
+}
+
+TEST_P(MainChainTests, CheckDuplicateTransactionsAfterReplacingPersistedBlocks)
+{
+  static constexpr std::size_t NUM_MAIN_BLOCKS = 20;
+  static constexpr std::size_t NUM_SIDE_BLOCKS = 12;
+
+  Digest const common_tx{"a transaction in the common history"};
+  Digest const replaced_tx{"a transaction in a replaced block"};
+
+  auto const genesis = generator_->Generate();
+
+  // the blocks of the main chain up to the finality period are written to the store
+  std::vector<BlockPtr> main_blocks{};
+  auto                  previous_block = genesis;
+  for (std::size_t i = 0; i < NUM_MAIN_BLOCKS; ++i)
+  {
+    auto next_block = generator_->Generate(previous_block);
+
+    if (i == 0)
+    {
+      AddTransaction(*next_block, common_tx);
+    }
+    else if (i == 2)
+    {
+      AddTransaction(*next_block, replaced_tx);
+    }
+
+    ASSERT_EQ(BlockStatus::ADDED, chain_->AddBlock(*next_block));
+    main_blocks.push_back(next_block);
+    previous_block = next_block;
+  }
+
+  // a heavier branch (since its blocks contain more transactions), which forks below the written
+  // blocks, replaces them
+  previous_block = main_blocks[1];
+  for (std::size_t i = 0; i < NUM_SIDE_BLOCKS; ++i)
+  {
+    auto next_block = generator_->Generate(previous_block);
+    AddTransaction(*next_block, Digest{"side transaction A" + std::to_string(i)});
+    AddTransaction(*next_block, Digest{"side transaction B" + std::to_string(i)});
+
+    ASSERT_EQ(BlockStatus::ADDED, chain_->AddBlock(*next_block));
+    previous_block = next_block;
+  }
+
+  ASSERT_EQ(previous_block->body.hash, chain_->GetHeaviestBlockHash());
+
+  EXPECT_EQ((DigestSet{common_tx}),
+            chain_->DetectDuplicateTransactions(previous_block->body.hash,
+                                                DigestSet{common_tx, replaced_tx}));
+}
+
+TEST(MainChainRecoveryTests, RecoveryIndexesTheBlocksMissingFromTheDigestIndex)
+{
+  static constexpr std::size_t NUM_BLOCKS = 20;
+
+  Digest const old_tx{"a transaction in a written block"};
+  Digest const other_tx{"a transaction in an unrelated block"};
+
+  BlockGenerator generator{1, 2};
+
+  auto const genesis = generator.Generate();
+
+  {
+    MainChain chain{MainChain::Mode::CREATE_PERSISTENT_DB};
+
+    auto previous_block = genesis;
+    for (std::size_t i = 0; i < NUM_BLOCKS; ++i)
+    {
+      auto next_block = generator.Generate(previous_block);
+
+      if (i == 2)
+      {
+        AddTransaction(*next_block, old_tx);
+      }
+
+      ASSERT_EQ(BlockStatus::ADDED, chain.AddBlock(*next_block));
+      previous_block = next_block;
+    }
+  }
+
+  // simulate the digest index falling behind the block store, without being empty
+  {
+    auto unrelated = generator.Generate(genesis);
+    AddTransaction(*unrelated, other_tx);
+
+    DigestIndex index{};
+    index.New("chain.digests.db", "chain.digests.index.db");
+    index.Add(*unrelated);
+    index.Flush();
+  }
+
+  MainChain chain{MainChain::Mode::LOAD_PERSISTENT_DB};
+
+  EXPECT_EQ((DigestSet{old_tx}),
+            chain.DetectDuplicateTransactions(chain.GetHeaviestBlockHash(), DigestSet{old_tx}));
+}
+
 INSTANTIATE_TEST_CASE_P(ParamBased, MainChainTests,
                         ::testing::Values(MainChain::Mode::CREATE_PERSISTENT_DB,
                                           MainChain::Mode::IN_MEMORY_DB), );
@@ -18,16 +18,20 @@
 
 #include "core/byte_array/decoders.hpp"
 #include "core/byte_array/encoders.hpp"
+#include "core/serializers/byte_array_buffer.hpp"
+#include "core/serializers/typed_byte_array_buffer.hpp"
 #include "crypto/ecdsa.hpp"
 #include "ledger/chain/address.hpp"
 #include "ledger/chain/transaction.hpp"
 #include "ledger/chain/transaction_builder.hpp"
+#include "ledger/chain/transaction_rpc_serializers.hpp"
 #include "ledger/chain/transaction_serializer.hpp"
 
 #include "gtest/gtest.h"
 
 #include <random>
 #include <string>
+#include <vector>
 
 using fetch::byte_array::ConstByteArray;
 using fetch::byte_array::FromHex;
@@ -37,6 +41,8 @@ using fetch::ledger::Address;
 using fetch::ledger::Transaction;
 using fetch::ledger::TransactionBuilder;
 using fetch::ledger::TransactionSerializer;
+using fetch::serializers::ByteArrayBuffer;
+using fetch::serializers::TypedByteArrayBuffer;
 using fetch::BitVector;
 
 struct Identities
@@ -1033,3 +1039,84 @@ TEST_F(TransactionSerializerTests, ContractWithLargeShardMask)
   // ensure the output transaction matches the input one
   EnsureAreSame(output, *tx);
 }
+
+TEST_F(TransactionSerializerTests, BatchDeserialization)
+{
+  static constexpr std::size_t NUM_TRANSACTIONS = 13;
+
+  std::vector<TransactionBuilder::TransactionPtr> inputs;
+  TransactionSerializer::ConstByteArrayList      data;
+  for (std::size_t i = 0; i < NUM_TRANSACTIONS; ++i)
+  {
+    // vary the size of the transactions (and therefore of the digested message)
+    TransactionBuilder builder{};
+    builder.From(addresses_[0]);
+    for (std::size_t j = 0; j <= (i % 4); ++j)
+    {
+      builder.Transfer(addresses_[j + 1], 100u * (i + 1));
+    }
+
+    auto tx = builder.Signer(signers_[0]->identity()).Seal().Sign(*signers_[0]).Build();
+    ASSERT_TRUE(static_cast<bool>(tx));
+
+    TransactionSerializer serializer;
+    serializer << *tx;
+
+    inputs.push_back(tx);
+    data.push_back(serializer.data());
+  }
+
+  TransactionSerializer::TransactionList outputs;
+  ASSERT_TRUE(TransactionSerializer::DeserializeBatch(data, outputs));
+  ASSERT_EQ(outputs.size(), NUM_TRANSACTIONS);
+
+  for (std::size_t i = 0; i < NUM_TRANSACTIONS; ++i)
+  {
+    EXPECT_TRUE(outputs[i].Verify());
+    EnsureAreSame(outputs[i], *inputs[i]);
+  }
+}
+
+TEST_F(TransactionSerializerTests, ListSerializationOverRpcBuffers)
+{
+  std::vector<Transaction> inputs;
+  for (std::size_t i = 0; i < 5; ++i)
+  {
+    auto tx = TransactionBuilder{}
+                  .From(addresses_[0])
+                  .Transfer(addresses_[1], 100u * (i + 1))
+                  .Signer(signers_[0]->identity())
+                  .Seal()
+                  .Sign(*signers_[0])
+                  .Build();
+    ASSERT_TRUE(static_cast<bool>(tx));
+
+    inputs.push_back(*tx);
+  }
+
+  // lists are sent over both the typed (RPC) and the untyped serializers
+  auto const round_trip = [&inputs](auto &buffer) {
+    buffer << inputs;
+    buffer.seek(0);
+
+    std::vector<Transaction> outputs;
+    buffer >> outputs;
+
+    return outputs;
+  };
+
+  TypedByteArrayBuffer typed_buffer;
+  ByteArrayBuffer      buffer;
+
+  for (auto &outputs : {round_trip(typed_buffer), round_trip(buffer)})
+  {
+    ASSERT_EQ(inputs.size(), outputs.size());
+
+    for (std::size_t i = 0; i < inputs.size(); ++i)
+    {
+      Transaction output{outputs[i]};
+      EXPECT_TRUE(output.Verify());
+      EnsureAreSame(output, inputs[i]);
+    }
+  }
+}
@@ -119,9 +119,59 @@ TEST_F(TransactionStatusCacheTests, CheckPruning)
   Timepoint const future_time_point = Clock::now() + std::chrono::hours{25};
   cache_->Update(tx3, TransactionStatus::EXECUTED, future_time_point);
 
+  // updates never prune the cache
+  EXPECT_EQ(TransactionStatus::PENDING, cache_->Query(tx1));
+  EXPECT_EQ(TransactionStatus::MINED, cache_->Query(tx2));
+
+  // pruning (normally from the background thread)
+  cache_->Prune(future_time_point);
+
   EXPECT_EQ(TransactionStatus::UNKNOWN, cache_->Query(tx1));
   EXPECT_EQ(TransactionStatus::UNKNOWN, cache_->Query(tx2));
   EXPECT_EQ(TransactionStatus::EXECUTED, cache_->Query(tx3));
+  EXPECT_EQ(1u, cache_->size());
+}
+
+TEST_F(TransactionStatusCacheTests, CheckRecentUpdatesSurvivePruning)
+{
+  auto tx1 = GenerateDigest();
+  auto tx2 = GenerateDigest();
+
+  Timepoint const start = Clock::now();
+
+  cache_->Update(tx1, TransactionStatus::PENDING, start);
+  cache_->Update(tx2, TransactionStatus::PENDING, start);
+
+  // the first transaction is updated again a day later
+  cache_->Update(tx1, TransactionStatus::EXECUTED, start + std::chrono::hours{23});
+
+  cache_->Prune(start + std::chrono::hours{25});
+
+  EXPECT_EQ(TransactionStatus::EXECUTED, cache_->Query(tx1));
+  EXPECT_EQ(TransactionStatus::UNKNOWN, cache_->Query(tx2));
+
+  cache_->Prune(start + std::chrono::hours{48});
+
+  EXPECT_EQ(TransactionStatus::UNKNOWN, cache_->Query(tx1));
+  EXPECT_EQ(0u, cache_->size());
+}
+
+TEST_F(TransactionStatusCacheTests, CheckBatchUpdate)
+{
+  TransactionStatusCache::Digests digests;
+  for (std::size_t i = 0; i < 100; ++i)
+  {
+    digests.push_back(GenerateDigest());
+    cache_->Update(digests.back(), TransactionStatus::MINED);
+  }
+
+  cache_->Update(digests, TransactionStatus::EXECUTED);
+
+  EXPECT_EQ(digests.size(), cache_->size());
+  for (auto const &digest : digests)
+  {
+    EXPECT_EQ(TransactionStatus::EXECUTED, cache_->Query(digest));
+  }
 }
 
 TEST_F(TransactionStatusCacheTests, CheckStatusStrings)
@@ -0,0 +1,218 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "crypto/sha256.hpp"
+#include "ledger/chaincode/compiled_contract_cache.hpp"
+#include "vm/generator.hpp"
+#include "vm/vm.hpp"
+#include "vm_modules/vm_factory.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <memory>
+#include <string>
+
+namespace fetch {
+namespace ledger {
+namespace {
+
+using byte_array::ConstByteArray;
+using vm::Executable;
+
+using ExecutablePtr = CompiledContractCache::ExecutablePtr;
+
+char const *const DOC_FILE   = "compiled_contract_cache_tests.db";
+char const *const INDEX_FILE = "compiled_contract_cache_tests.index.db";
+
+ConstByteArray const MODULE_FINGERPRINT{"module"};
+
+char const *const CONTRACT_SOURCE = R"(
+  @query
+  function value() : Int64
+    var total = 0i64;
+    for (i in 1:10)
+      total = total + 42i64;
+    endfor
+    return total;
+  endfunction
+)";
+
+ConstByteArray DigestOf(std::string const &source)
+{
+  crypto::SHA256 hash;
+  hash.Update(source);
+  return hash.Final();
+}
+
+TEST(CompiledContractCacheTests, CheckLookupAndEviction)
+{
+  CompiledContractCache cache{2};
+
+  auto const first  = std::make_shared<Executable const>("first");
+  auto const second = std::make_shared<Executable const>("second");
+  auto const third  = std::make_shared<Executable const>("third");
+
+  EXPECT_FALSE(cache.Lookup("first", MODULE_FINGERPRINT));
+  EXPECT_EQ(cache.miss_count(), 1u);
+
+  cache.Insert("first", MODULE_FINGERPRINT, first);
+  cache.Insert("second", MODULE_FINGERPRINT, second);
+  EXPECT_EQ(cache.size(), 2u);
+
+  // mark the first entry as the most recently used
+  EXPECT_EQ(cache.Lookup("first", MODULE_FINGERPRINT), first);
+  EXPECT_EQ(cache.hit_count(), 1u);
+
+  // inserting the third entry must evict the second
+  cache.Insert("third", MODULE_FINGERPRINT, third);
+  EXPECT_EQ(cache.size(), 2u);
+  EXPECT_EQ(cache.Lookup("first", MODULE_FINGERPRINT), first);
+  EXPECT_EQ(cache.Lookup("third", MODULE_FINGERPRINT), third);
+  EXPECT_FALSE(cache.Lookup("second", MODULE_FINGERPRINT));
+
+  // an executable compiled against a different module must never be returned
+  EXPECT_FALSE(cache.Lookup("first", "other module"));
+
+  EXPECT_EQ(cache.hit_count(), 3u);
+  EXPECT_EQ(cache.miss_count(), 3u);
+  EXPECT_EQ(cache.disk_hit_count(), 0u);
+
+  cache.Clear();
+  EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST(CompiledContractCacheTests, CheckDiskStoreRoundTrip)
+{
+  auto module = vm_modules::VMFactory::GetModule();
+
+  // compile the contract
+  auto compiled = std::make_shared<Executable>();
+  ASSERT_TRUE(vm_modules::VMFactory::Compile(module, CONTRACT_SOURCE, *compiled).empty());
+
+  auto const digest             = DigestOf(CONTRACT_SOURCE);
+  auto const module_fingerprint = CompiledContractCache::GenerateModuleFingerprint(*module);
+
+  // populate the disk store
+  {
+    CompiledContractCache cache;
+    cache.AttachDiskStore(DOC_FILE, INDEX_FILE);
+    cache.Insert(digest, module_fingerprint, compiled);
+    cache.DetachDiskStore();
+  }
+
+  // simulate a restart of the node, where the contract module is created afresh
+  auto restarted_module = vm_modules::VMFactory::GetModule();
+  EXPECT_EQ(CompiledContractCache::GenerateModuleFingerprint(*restarted_module),
+            module_fingerprint);
+
+  CompiledContractCache cache;
+  cache.AttachDiskStore(DOC_FILE, INDEX_FILE, false);
+  ASSERT_TRUE(cache.has_disk_store());
+
+  ExecutablePtr restored = cache.Lookup(digest, module_fingerprint);
+  ASSERT_TRUE(restored);
+  EXPECT_EQ(cache.disk_hit_count(), 1u);
+  EXPECT_EQ(cache.miss_count(), 0u);
+
+  // subsequent lookups are served from memory
+  EXPECT_EQ(cache.Lookup(digest, module_fingerprint), restored);
+  EXPECT_EQ(cache.hit_count(), 1u);
+
+  // check the structure of the restored executable
+  EXPECT_EQ(restored->name, compiled->name);
+  EXPECT_EQ(restored->strings, compiled->strings);
+  EXPECT_EQ(restored->constants.size(), compiled->constants.size());
+  EXPECT_EQ(restored->types.size(), compiled->types.size());
+  ASSERT_EQ(restored->functions.size(), compiled->functions.size());
+
+  for (std::size_t i = 0; i < compiled->functions.size(); ++i)
+  {
+    auto const &expected = compiled->functions[i];
+    auto const &actual   = restored->functions[i];
+
+    EXPECT_EQ(actual.name, expected.name);
+    EXPECT_EQ(actual.annotations.size(), expected.annotations.size());
+    EXPECT_EQ(actual.num_variables, expected.num_variables);
+    EXPECT_EQ(actual.num_parameters, expected.num_parameters);
+    EXPECT_EQ(actual.return_type_id, expected.return_type_id);
+    EXPECT_EQ(actual.pc_to_line_map_, expected.pc_to_line_map_);
+    ASSERT_EQ(actual.instructions.size(), expected.instructions.size());
+
+    for (std::size_t j = 0; j < expected.instructions.size(); ++j)
+    {
+      EXPECT_EQ(actual.instructions[j].opcode, expected.instructions[j].opcode);
+      EXPECT_EQ(actual.instructions[j].type_id, expected.instructions[j].type_id);
+      EXPECT_EQ(actual.instructions[j].index, expected.instructions[j].index);
+      EXPECT_EQ(actual.instructions[j].data, expected.instructions[j].data);
+    }
+  }
+
+  // finally check that the restored executable can be run against the new module
+  vm::VM      vm{restarted_module.get()};
+  std::string error;
+  vm::Variant output;
+  ASSERT_TRUE(vm.Execute(*restored, "value", error, output)) << error;
+  EXPECT_EQ(output.primitive.i64, 420);
+
+  cache.DetachDiskStore();
+  std::remove(DOC_FILE);
+  std::remove(INDEX_FILE);
+}
+
+TEST(CompiledContractCacheTests, CheckModuleChangeInvalidatesDiskStore)
+{
+  auto module = vm_modules::VMFactory::GetModule();
+
+  auto compiled = std::make_shared<Executable>();
+  ASSERT_TRUE(vm_modules::VMFactory::Compile(module, CONTRACT_SOURCE, *compiled).empty());
+
+  auto const digest             = DigestOf(CONTRACT_SOURCE);
+  auto const module_fingerprint = CompiledContractCache::GenerateModuleFingerprint(*module);
+
+  {
+    CompiledContractCache cache;
+    cache.AttachDiskStore(DOC_FILE, INDEX_FILE);
+    cache.Insert(digest, module_fingerprint, compiled);
+    cache.DetachDiskStore();
+  }
+
+  // the node restarts with an additional module function, which shifts the function opcodes
+  auto changed_module = vm_modules::VMFactory::GetModule();
+  changed_module->CreateFreeFunctionFromLambda<uint64_t>("getBlockNumber",
+                                                         [](vm::VM *) { return uint64_t{0}; });
+
+  auto const changed_fingerprint =
+      CompiledContractCache::GenerateModuleFingerprint(*changed_module);
+  EXPECT_NE(changed_fingerprint, module_fingerprint);
+
+  CompiledContractCache cache;
+  cache.AttachDiskStore(DOC_FILE, INDEX_FILE, false);
+
+  EXPECT_FALSE(cache.Lookup(digest, changed_fingerprint));
+  EXPECT_EQ(cache.disk_hit_count(), 0u);
+  EXPECT_EQ(cache.miss_count(), 1u);
+
+  cache.DetachDiskStore();
+  std::remove(DOC_FILE);
+  std::remove(INDEX_FILE);
+}
+
+}  // namespace
+}  // namespace ledger
+}  // namespace fetch
@@ -45,9 +45,15 @@ protected:
   using ScheduleStatus      = ExecutionManager::ScheduleStatus;
   using State               = ExecutionManager::State;
   using Digest              = fetch::ledger::Digest;
+  using SchedulingMode      = ExecutionManager::SchedulingMode;
 
   static constexpr char const *LOGGING_NAME = "ExecutionManagerTests";
 
+  virtual SchedulingMode GetSchedulingMode() const
+  {
+    return SchedulingMode::SLICE_ORDER;
+  }
+
   void SetUp() override
   {
     BlockConfig const &config = GetParam();
@@ -57,7 +63,8 @@ protected:
 
     // create the manager
     manager_ = std::make_shared<ExecutionManager>(
-        config.executors, config.log2_lanes, mock_storage_, [this]() { return CreateExecutor(); });
+        config.executors, config.log2_lanes, mock_storage_, [this]() { return CreateExecutor(); },
+        GetSchedulingMode());
   }
 
   void TearDown() override
@@ -162,6 +169,34 @@ protected:
     return success;
   }
 
+  bool CheckForConflictOrder()
+  {
+    using HistoryElementCache = FakeExecutor::HistoryElementCache;
+
+    HistoryElementCache history;
+    history.reserve(GetNumExecutedTransaction());
+    for (auto &exec : executors_)
+    {
+      exec->CollectHistory(history);
+    }
+
+    // any two transactions which share a lane must have been executed in slice order
+    for (auto const &a : history)
+    {
+      for (auto const &b : history)
+      {
+        bool const conflicting = (a.shards & b.shards).PopCount() > 0;
+
+        if (conflicting && (a.slice < b.slice) && (a.timestamp > b.timestamp))
+        {
+          return false;
+        }
+      }
+    }
+
+    return !history.empty();
+  }
+
   MockStorageUnitPtr  mock_storage_;
   ExecutionManagerPtr manager_;
   FakeExecutorList    executors_;
@@ -194,5 +229,40 @@ TEST_P(ExecutionManagerTests, CheckIncrementalExecution)
   manager_->Stop();
 }
 
+class ExecutionManagerConflictGraphTests : public ExecutionManagerTests
+{
+protected:
+  SchedulingMode GetSchedulingMode() const override
+  {
+    return SchedulingMode::CONFLICT_GRAPH;
+  }
+};
+
+TEST_P(ExecutionManagerConflictGraphTests, CheckIncrementalExecution)
+{
+  BlockConfig const &config = GetParam();
+
+  // generate a block with the desired lane and slice configuration
+  auto block = TestBlock::Generate(config.log2_lanes, config.slices, __LINE__);
+
+  FETCH_LOG_INFO(LOGGING_NAME, "Num transactions: ", block.num_transactions);
+  EXPECT_GT(block.num_transactions, 0);
+
+  // start the execution manager
+  manager_->Start();
+
+  // execute the block
+  ASSERT_EQ(manager_->Execute(block.block), ExecutionManager::ScheduleStatus::SCHEDULED);
+
+  // wait for the manager to become idle again
+  ASSERT_TRUE(WaitUntilExecutionComplete(static_cast<std::size_t>(block.num_transactions)));
+  ASSERT_EQ(GetNumExecutedTransaction(), block.num_transactions);
+  ASSERT_TRUE(CheckForConflictOrder());
+
+  manager_->Stop();
+}
+
 INSTANTIATE_TEST_CASE_P(Param, ExecutionManagerTests,
                         ::testing::ValuesIn(BlockConfig::REDUCED_SET), );
+INSTANTIATE_TEST_CASE_P(Param, ExecutionManagerConflictGraphTests,
+                        ::testing::ValuesIn(BlockConfig::REDUCED_SET), );
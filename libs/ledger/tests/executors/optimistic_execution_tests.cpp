@@ -0,0 +1,258 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/bitvector.hpp"
+#include "crypto/ecdsa.hpp"
+#include "ledger/chain/transaction_builder.hpp"
+#include "ledger/chain/transaction_layout.hpp"
+#include "ledger/chaincode/token_contract.hpp"
+#include "ledger/execution_manager.hpp"
+#include "ledger/executor.hpp"
+#include "ledger/state_sentinel_adapter.hpp"
+
+#include "fake_storage_unit.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace fetch {
+namespace ledger {
+namespace {
+
+using BalanceList        = std::vector<uint64_t>;
+using StatusList         = std::vector<ExecutorInterface::Status>;
+using FakeStorageUnitPtr = std::shared_ptr<FakeStorageUnit>;
+using TransactionPtr     = TransactionBuilder::TransactionPtr;
+using SchedulingMode     = ExecutionManager::SchedulingMode;
+
+constexpr uint32_t    LOG2_NUM_LANES   = 2;
+constexpr std::size_t NUM_LANES        = 1u << LOG2_NUM_LANES;
+constexpr std::size_t NUM_EXECUTORS    = 4;
+constexpr std::size_t NUM_ENTITIES     = 6;
+constexpr std::size_t TXS_PER_SLICE    = 8;
+constexpr uint64_t    INITIAL_BALANCE  = 1000000;
+constexpr uint64_t    BLOCK_NUMBER     = 1;
+constexpr uint64_t    MAX_TRANSFER     = 100;
+constexpr std::size_t MAX_WAIT_PERIODS = 600;
+
+struct Entity
+{
+  crypto::ECDSASigner signer{};
+  Address             address{signer.identity()};
+};
+
+using Entities = std::vector<Entity>;
+
+/**
+ * Deterministic result harness: the same block is executed serially (in block order) on one
+ * storage unit and optimistically on another. The resulting states must be identical.
+ */
+class OptimisticExecutionTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    entities_ = std::make_unique<Entities>(NUM_ENTITIES);
+
+    serial_storage_     = std::make_shared<FakeStorageUnit>();
+    optimistic_storage_ = std::make_shared<FakeStorageUnit>();
+
+    Fund(*serial_storage_);
+    Fund(*optimistic_storage_);
+  }
+
+  void Fund(FakeStorageUnit &storage)
+  {
+    BitVector all_lanes{NUM_LANES};
+    for (std::size_t i = 0; i < NUM_LANES; ++i)
+    {
+      all_lanes.set(i, 1);
+    }
+
+    StateSentinelAdapter adapter{storage, Identifier{"fetch.token"}, all_lanes};
+
+    TokenContract contract;
+    contract.Attach(adapter);
+    for (auto const &entity : *entities_)
+    {
+      contract.AddTokens(entity.address, INITIAL_BALANCE);
+    }
+    contract.Detach();
+  }
+
+  BalanceList GetBalances(FakeStorageUnit &storage)
+  {
+    StateAdapter adapter{storage, Identifier{"fetch.token"}};
+
+    TokenContract contract;
+    contract.Attach(adapter);
+
+    BalanceList balances;
+    for (auto const &entity : *entities_)
+    {
+      balances.push_back(contract.GetBalance(entity.address));
+    }
+
+    contract.Detach();
+
+    return balances;
+  }
+
+  /**
+   * Generate a block of transfers between a small number of entities (i.e. with many conflicts)
+   */
+  Block::Body GenerateBlock(std::size_t num_transactions, uint32_t seed)
+  {
+    std::mt19937 rng{seed};
+
+    Block::Body block;
+    block.block_number = BLOCK_NUMBER;
+
+    for (std::size_t i = 0; i < num_transactions; ++i)
+    {
+      auto const &from = (*entities_)[rng() % NUM_ENTITIES];
+      auto const &to   = (*entities_)[rng() % NUM_ENTITIES];
+
+      uint64_t const amount = 1 + (rng() % MAX_TRANSFER);
+
+      TransactionPtr tx = TransactionBuilder()
+                              .From(from.address)
+                              .Transfer(to.address, amount)
+                              .ValidUntil(BLOCK_NUMBER + 100)
+                              .ChargeRate(1)
+                              .ChargeLimit(10)
+                              .Signer(from.signer.identity())
+                              .Seal()
+                              .Sign(from.signer)
+                              .Build();
+
+      serial_storage_->AddTransaction(*tx);
+      optimistic_storage_->AddTransaction(*tx);
+
+      if ((i % TXS_PER_SLICE) == 0)
+      {
+        block.slices.emplace_back();
+      }
+
+      block.slices.back().emplace_back(*tx, LOG2_NUM_LANES);
+    }
+
+    return block;
+  }
+
+  StatusList ExecuteSerially(Block::Body const &block)
+  {
+    Executor executor{serial_storage_};
+
+    StatusList statuses;
+
+    uint64_t slice_index{0};
+    for (auto const &slice : block.slices)
+    {
+      for (auto const &layout : slice)
+      {
+        auto const result =
+            executor.Execute(layout.digest(), block.block_number, slice_index, layout.mask());
+
+        EXPECT_EQ(ExecutorInterface::Status::SUCCESS, result.status);
+        statuses.push_back(result.status);
+      }
+
+      ++slice_index;
+    }
+
+    return statuses;
+  }
+
+  bool ExecuteOptimistically(Block::Body const &block, std::size_t num_transactions)
+  {
+    auto storage = optimistic_storage_;
+
+    manager_ = std::make_shared<ExecutionManager>(
+        NUM_EXECUTORS, LOG2_NUM_LANES, storage,
+        [storage]() { return std::make_shared<Executor>(storage); }, SchedulingMode::OPTIMISTIC);
+
+    manager_->Start();
+
+    bool success = (ExecutionManager::ScheduleStatus::SCHEDULED == manager_->Execute(block));
+
+    // wait for the execution to complete
+    for (std::size_t i = 0; success && (i < MAX_WAIT_PERIODS); ++i)
+    {
+      if ((manager_->completed_executions() >= num_transactions) &&
+          (ExecutionManager::State::IDLE == manager_->GetState()))
+      {
+        break;
+      }
+
+      std::this_thread::sleep_for(std::chrono::milliseconds{100});
+    }
+
+    success = success && (manager_->completed_executions() >= num_transactions);
+
+    manager_->Stop();
+
+    return success;
+  }
+
+  std::unique_ptr<Entities>         entities_;
+  FakeStorageUnitPtr                serial_storage_;
+  FakeStorageUnitPtr                optimistic_storage_;
+  std::shared_ptr<ExecutionManager> manager_;
+};
+
+TEST_F(OptimisticExecutionTests, CheckStateMatchesSerialExecution)
+{
+  static constexpr std::size_t NUM_TRANSACTIONS = 64;
+
+  auto const block = GenerateBlock(NUM_TRANSACTIONS, 42);
+
+  auto const statuses = ExecuteSerially(block);
+  ASSERT_EQ(statuses.size(), NUM_TRANSACTIONS);
+
+  ASSERT_TRUE(ExecuteOptimistically(block, NUM_TRANSACTIONS));
+
+  // since the transfers are all between a small set of entities conflicts are unavoidable
+  EXPECT_GT(manager_->num_reexecutions(), 0u);
+
+  EXPECT_EQ(GetBalances(*serial_storage_), GetBalances(*optimistic_storage_));
+}
+
+TEST_F(OptimisticExecutionTests, CheckStateMatchesSerialExecutionForMultipleSeeds)
+{
+  static constexpr std::size_t NUM_TRANSACTIONS = 32;
+
+  for (uint32_t seed = 0; seed < 4; ++seed)
+  {
+    auto const block = GenerateBlock(NUM_TRANSACTIONS, seed);
+
+    ExecuteSerially(block);
+    ASSERT_TRUE(ExecuteOptimistically(block, NUM_TRANSACTIONS));
+
+    EXPECT_EQ(GetBalances(*serial_storage_), GetBalances(*optimistic_storage_));
+  }
+}
+
+}  // namespace
+}  // namespace ledger
+}  // namespace fetch
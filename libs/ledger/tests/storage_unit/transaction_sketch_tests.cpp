@@ -0,0 +1,163 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+#include "core/byte_array/byte_array.hpp"
+#include "core/serializers/byte_array_buffer.hpp"
+#include "crypto/hash.hpp"
+#include "crypto/sha256.hpp"
+#include "ledger/storage_unit/transaction_sketch.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+
+namespace {
+
+using fetch::byte_array::ConstByteArray;
+using fetch::crypto::Hash;
+using fetch::crypto::SHA256;
+using fetch::ledger::TransactionSketch;
+using fetch::serializers::ByteArrayBuffer;
+
+using Digests = TransactionSketch::Digests;
+
+Digests GenerateDigests(std::size_t count, std::string const &seed)
+{
+  Digests digests;
+  digests.reserve(count);
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    digests.emplace_back(Hash<SHA256>(seed + std::to_string(i)));
+  }
+
+  return digests;
+}
+
+TransactionSketch BuildSketch(std::size_t num_cells, Digests const &common, Digests const &unique)
+{
+  TransactionSketch sketch{num_cells};
+
+  for (auto const &digest : common)
+  {
+    sketch.Add(digest);
+  }
+
+  for (auto const &digest : unique)
+  {
+    sketch.Add(digest);
+  }
+
+  return sketch;
+}
+
+Digests Sorted(Digests digests)
+{
+  std::sort(digests.begin(), digests.end());
+  return digests;
+}
+
+TEST(TransactionSketchTests, CheckSymmetricDifferenceIsDecoded)
+{
+  Digests const common    = GenerateDigests(10000, "common");
+  Digests const only_in_a = GenerateDigests(40, "a");
+  Digests const only_in_b = GenerateDigests(25, "b");
+
+  std::size_t const num_cells = TransactionSketch::CellsFor(only_in_a.size() + only_in_b.size());
+
+  TransactionSketch       sketch_a = BuildSketch(num_cells, common, only_in_a);
+  TransactionSketch const sketch_b = BuildSketch(num_cells, common, only_in_b);
+
+  EXPECT_EQ(10040, sketch_a.count());
+  EXPECT_EQ(10025, sketch_b.count());
+
+  ASSERT_TRUE(sketch_a.Subtract(sketch_b));
+  EXPECT_EQ(15, sketch_a.count());
+
+  Digests decoded_a;
+  Digests decoded_b;
+  ASSERT_TRUE(sketch_a.Decode(decoded_a, decoded_b));
+
+  EXPECT_EQ(Sorted(only_in_a), Sorted(decoded_a));
+  EXPECT_EQ(Sorted(only_in_b), Sorted(decoded_b));
+}
+
+TEST(TransactionSketchTests, CheckIdenticalSetsHaveNoDifference)
+{
+  Digests const common = GenerateDigests(1000, "common");
+
+  TransactionSketch       sketch_a = BuildSketch(TransactionSketch::CellsFor(0), common, {});
+  TransactionSketch const sketch_b = BuildSketch(TransactionSketch::CellsFor(0), common, {});
+
+  ASSERT_TRUE(sketch_a.Subtract(sketch_b));
+
+  Digests decoded_a;
+  Digests decoded_b;
+  ASSERT_TRUE(sketch_a.Decode(decoded_a, decoded_b));
+
+  EXPECT_TRUE(decoded_a.empty());
+  EXPECT_TRUE(decoded_b.empty());
+}
+
+TEST(TransactionSketchTests, CheckOversizedDifferenceIsNotDecoded)
+{
+  Digests const only_in_a = GenerateDigests(500, "a");
+
+  TransactionSketch       sketch_a = BuildSketch(TransactionSketch::CellsFor(50), {}, only_in_a);
+  TransactionSketch const sketch_b{TransactionSketch::CellsFor(50)};
+
+  ASSERT_TRUE(sketch_a.Subtract(sketch_b));
+
+  Digests decoded_a;
+  Digests decoded_b;
+  EXPECT_FALSE(sketch_a.Decode(decoded_a, decoded_b));
+  EXPECT_LT(decoded_a.size(), only_in_a.size());
+}
+
+TEST(TransactionSketchTests, CheckSketchesOfDifferentSizesAreRejected)
+{
+  TransactionSketch       sketch_a{30};
+  TransactionSketch const sketch_b{60};
+
+  EXPECT_FALSE(sketch_a.Subtract(sketch_b));
+}
+
+TEST(TransactionSketchTests, CheckSerialisation)
+{
+  Digests const digests = GenerateDigests(20, "digest");
+
+  TransactionSketch const sketch = BuildSketch(TransactionSketch::CellsFor(20), digests, {});
+
+  ByteArrayBuffer buffer;
+  buffer << sketch;
+
+  TransactionSketch restored;
+  buffer.seek(0);
+  buffer >> restored;
+
+  ASSERT_EQ(sketch.num_cells(), restored.num_cells());
+
+  Digests decoded;
+  Digests unused;
+  ASSERT_TRUE(restored.Decode(decoded, unused));
+
+  EXPECT_EQ(Sorted(digests), Sorted(decoded));
+  EXPECT_TRUE(unused.empty());
+}
+
+}  // namespace
@@ -0,0 +1,384 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+#include "core/bitvector.hpp"
+#include "core/byte_array/decoders.hpp"
+#include "core/service_ids.hpp"
+#include "crypto/ecdsa.hpp"
+#include "ledger/chain/address.hpp"
+#include "ledger/chain/transaction.hpp"
+#include "ledger/chain/transaction_builder.hpp"
+#include "ledger/chain/transaction_rpc_serializers.hpp"
+#include "ledger/storage_unit/transaction_finder_protocol.hpp"
+#include "ledger/storage_unit/transaction_sketch.hpp"
+#include "ledger/storage_unit/transaction_store_sync_protocol.hpp"
+#include "ledger/storage_unit/transaction_store_sync_service.hpp"
+#include "network/management/network_manager.hpp"
+#include "network/muddle/muddle.hpp"
+#include "network/muddle/rpc/client.hpp"
+#include "network/muddle/rpc/server.hpp"
+#include "storage/resource_mapper.hpp"
+#include "storage/transient_object_store.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using std::this_thread::sleep_for;
+using std::chrono::milliseconds;
+using std::chrono::seconds;
+using fetch::BitVector;
+using fetch::byte_array::ByteArray;
+using fetch::byte_array::ConstByteArray;
+using fetch::byte_array::FromBase64;
+using fetch::crypto::ECDSASigner;
+using fetch::ledger::Address;
+using fetch::ledger::Transaction;
+using fetch::ledger::TransactionBuilder;
+using fetch::ledger::TransactionSketch;
+using fetch::ledger::TransactionStoreSyncProtocol;
+using fetch::ledger::TransactionStoreSyncService;
+using fetch::ledger::TxFinderProtocol;
+using fetch::muddle::NetworkId;
+using fetch::storage::ResourceID;
+
+using Digests = TransactionSketch::Digests;
+using TxArray = std::vector<Transaction>;
+
+class TransactionStoreSyncTests : public ::testing::Test
+{
+protected:
+  static constexpr char const *NETWORK_A_PRIVATE_KEY =
+      "BEb+rF65Dg+59XQyKcu9HLl5tJc9wAZDX+V0ud07iDQ=";
+  static constexpr char const *NETWORK_B_PRIVATE_KEY =
+      "4DW/sW8JLey8Z9nqi2yJJHaGzkLXIqaYc/fwHfK0w0Y=";
+  static constexpr uint32_t LOG2_NUM_LANES = 0;
+
+  using NetworkManager    = fetch::network::NetworkManager;
+  using NetworkManagerPtr = std::unique_ptr<NetworkManager>;
+  using Muddle            = fetch::muddle::Muddle;
+  using MuddlePtr         = std::shared_ptr<Muddle>;
+  using CertificatePtr    = Muddle::CertificatePtr;
+  using Uri               = Muddle::Uri;
+  using RpcServer         = fetch::muddle::rpc::Server;
+  using RpcServerPtr      = std::unique_ptr<RpcServer>;
+  using RpcClient         = fetch::muddle::rpc::Client;
+  using RpcClientPtr      = std::unique_ptr<RpcClient>;
+  using ObjectStore       = fetch::storage::TransientObjectStore<Transaction>;
+  using ObjectStorePtr    = std::shared_ptr<ObjectStore>;
+  using ProtocolPtr       = std::unique_ptr<TransactionStoreSyncProtocol>;
+
+  static CertificatePtr LoadIdentity(char const *private_key)
+  {
+    auto signer = std::make_unique<ECDSASigner>();
+    signer->Load(FromBase64(private_key));
+
+    return signer;
+  }
+
+  void SetUp() override
+  {
+    store_a_ = std::make_shared<ObjectStore>(LOG2_NUM_LANES);
+    store_a_->New("tx_sync_a.db", "tx_sync_a.index.db", true);
+    store_b_ = std::make_shared<ObjectStore>(LOG2_NUM_LANES);
+    store_b_->New("tx_sync_b.db", "tx_sync_b.index.db", true);
+
+    manager_a_ = std::make_unique<NetworkManager>("NetMgrA", 1);
+    network_a_ = std::make_shared<Muddle>(NetworkId{"Test"}, LoadIdentity(NETWORK_A_PRIVATE_KEY),
+                                          *manager_a_);
+
+    manager_b_ = std::make_unique<NetworkManager>("NetMgrB", 1);
+    network_b_ = std::make_shared<Muddle>(NetworkId{"Test"}, LoadIdentity(NETWORK_B_PRIVATE_KEY),
+                                          *manager_b_);
+
+    manager_a_->Start();
+    manager_b_->Start();
+
+    network_a_->Start({8040});
+    network_b_->Start({9040}, {Uri{"tcp://127.0.0.1:8040"}});
+
+    // peer A serves the transactions which it holds
+    protocol_a_ = std::make_unique<TransactionStoreSyncProtocol>(store_a_.get(), 0);
+    server_a_   = std::make_unique<RpcServer>(network_a_->AsEndpoint(), fetch::SERVICE_LANE,
+                                            fetch::CHANNEL_RPC);
+    server_a_->Add(fetch::RPC_TX_STORE_SYNC, protocol_a_.get());
+
+    client_b_ = std::make_unique<RpcClient>("Client", network_b_->AsEndpoint(), Muddle::Address{},
+                                            fetch::SERVICE_LANE, fetch::CHANNEL_RPC);
+
+    sleep_for(seconds{1});
+  }
+
+  void TearDown() override
+  {
+    client_b_.reset();
+    server_a_.reset();
+
+    network_b_->Stop();
+    network_a_->Stop();
+    manager_b_->Stop();
+    manager_a_->Stop();
+
+    network_b_.reset();
+    manager_b_.reset();
+    network_a_.reset();
+    manager_a_.reset();
+
+    protocol_a_.reset();
+    store_b_.reset();
+    store_a_.reset();
+  }
+
+  static TxArray GenerateTransactions(std::size_t count, ECDSASigner const &signer)
+  {
+    TxArray transactions;
+    transactions.reserve(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      auto tx = TransactionBuilder()
+                    .From(Address{signer.identity()})
+                    .TargetChainCode("fetch.dummy", BitVector{})
+                    .Action(std::to_string(i))
+                    .Signer(signer.identity())
+                    .Seal()
+                    .Sign(signer)
+                    .Build();
+
+      transactions.emplace_back(*tx);
+    }
+
+    return transactions;
+  }
+
+  static void AddTransactions(ObjectStore &store, TxArray const &transactions,
+                              std::size_t begin, std::size_t end)
+  {
+    for (std::size_t i = begin; i < end; ++i)
+    {
+      ResourceID const rid{transactions[i].digest()};
+
+      store.Set(rid, transactions[i], true);
+      store.Confirm(rid);
+    }
+  }
+
+  /**
+   * Run the worker of the store until the confirmed transactions have been written to the archive
+   */
+  static void Archive(ObjectStore &store)
+  {
+    auto runnable = store.GetWeakRunnable().lock();
+
+    while (runnable->IsReadyToExecute())
+    {
+      runnable->Execute();
+    }
+  }
+
+  /**
+   * Run the sync service of peer B until it holds the expected number of transactions (or gives up)
+   */
+  void RunSyncService(std::size_t expected_count)
+  {
+    TxFinderProtocol                    finder;
+    TransactionStoreSyncService::Config config;
+
+    TransactionStoreSyncService service{config, network_b_, store_b_, &finder, nullptr};
+    service.Start();
+
+    for (std::size_t i = 0; (i < 1000) && (store_b_->Size() < expected_count); ++i)
+    {
+      service.Execute();
+      sleep_for(milliseconds{10});
+    }
+
+    service.Stop();
+  }
+
+  static ConstByteArray Prefix(uint8_t prefix)
+  {
+    ByteArray key;
+    key.Resize(std::size_t{ResourceID::RESOURCE_ID_SIZE_IN_BYTES});
+    key[0] = prefix;
+
+    return {key};
+  }
+
+  template <typename T, typename... Args>
+  T Call(uint64_t function, Args &&... args)
+  {
+    auto promise = client_b_->CallSpecificAddress(network_a_->identity().identifier(),
+                                                  fetch::RPC_TX_STORE_SYNC, function,
+                                                  std::forward<Args>(args)...);
+
+    return promise->template As<T>();
+  }
+
+  static Digests Sorted(Digests digests)
+  {
+    std::sort(digests.begin(), digests.end());
+    return digests;
+  }
+
+  ObjectStorePtr    store_a_;
+  ObjectStorePtr    store_b_;
+  NetworkManagerPtr manager_a_;
+  MuddlePtr         network_a_;
+  NetworkManagerPtr manager_b_;
+  MuddlePtr         network_b_;
+  ProtocolPtr       protocol_a_;
+  RpcServerPtr      server_a_;
+  RpcClientPtr      client_b_;
+};
+
+TEST_F(TransactionStoreSyncTests, CheckSubtreeKeysCoverTheStore)
+{
+  ECDSASigner const signer;
+  TxArray const     transactions = GenerateTransactions(100, signer);
+
+  // half of the transactions are archived and the other half remain in the cache
+  AddTransactions(*store_a_, transactions, 0, 50);
+  Archive(*store_a_);
+  AddTransactions(*store_a_, transactions, 50, 100);
+
+  Digests keys;
+  for (uint8_t prefix = 0; prefix < 4; ++prefix)
+  {
+    for (auto const &key : store_a_->PullSubtreeKeys(Prefix(prefix), 2))
+    {
+      EXPECT_EQ(prefix, key[0] & 0x3);
+      keys.push_back(key);
+    }
+  }
+
+  Digests expected;
+  for (auto const &tx : transactions)
+  {
+    expected.push_back(tx.digest());
+  }
+
+  EXPECT_EQ(Sorted(expected), Sorted(keys));
+}
+
+TEST_F(TransactionStoreSyncTests, CheckOnlyTheDifferenceIsTransferred)
+{
+  ECDSASigner const signer;
+  TxArray const     transactions = GenerateTransactions(300, signer);
+
+  // peer A holds the first 280 transactions and peer B the last 250
+  AddTransactions(*store_a_, transactions, 0, 280);
+  Archive(*store_a_);
+  AddTransactions(*store_b_, transactions, 50, 300);
+
+  std::size_t const num_cells = TransactionSketch::CellsFor(70);
+
+  // reconcile the whole store (a subtree with no leading bits)
+  auto remote_sketch = Call<TransactionSketch>(TransactionStoreSyncProtocol::PULL_SKETCH,
+                                               Prefix(0), uint64_t{0}, uint64_t{num_cells});
+
+  TransactionSketch local_sketch{num_cells};
+  for (auto const &key : store_b_->PullSubtreeKeys(Prefix(0), 0))
+  {
+    local_sketch.Add(key);
+  }
+
+  ASSERT_TRUE(remote_sketch.Subtract(local_sketch));
+
+  Digests missing;
+  Digests excess;
+  ASSERT_TRUE(remote_sketch.Decode(missing, excess));
+  ASSERT_EQ(50u, missing.size());
+  ASSERT_EQ(20u, excess.size());
+
+  std::vector<ResourceID> rids;
+  for (auto const &digest : missing)
+  {
+    rids.emplace_back(digest);
+  }
+
+  auto const pulled = Call<TxArray>(TransactionStoreSyncProtocol::PULL_SPECIFIC_OBJECTS, rids);
+
+  Digests expected;
+  for (std::size_t i = 0; i < 50; ++i)
+  {
+    expected.push_back(transactions[i].digest());
+  }
+
+  Digests received;
+  for (auto const &tx : pulled)
+  {
+    received.push_back(tx.digest());
+  }
+
+  EXPECT_EQ(Sorted(expected), Sorted(received));
+}
+
+TEST_F(TransactionStoreSyncTests, CheckServiceReconcilesWithPeer)
+{
+  ECDSASigner const signer;
+  TxArray const     transactions = GenerateTransactions(300, signer);
+
+  AddTransactions(*store_a_, transactions, 0, 280);
+  Archive(*store_a_);
+  AddTransactions(*store_b_, transactions, 50, 300);
+
+  // only the 50 missing transactions are transferred to peer B
+  RunSyncService(transactions.size());
+
+  EXPECT_EQ(transactions.size(), store_b_->Size());
+}
+
+TEST_F(TransactionStoreSyncTests, CheckServiceSplitsSubtreesWhenSketchesFail)
+{
+  ECDSASigner const signer;
+  ECDSASigner const other_signer;
+  TxArray const     transactions       = GenerateTransactions(300, signer);
+  TxArray const     other_transactions = GenerateTransactions(200, other_signer);
+
+  // the peers hold a similar number of transactions, but very few of them are in common, which
+  // makes the initial sketch too small
+  AddTransactions(*store_a_, transactions, 0, 280);
+  Archive(*store_a_);
+  AddTransactions(*store_b_, transactions, 250, 300);
+  AddTransactions(*store_b_, other_transactions, 0, 200);
+
+  RunSyncService(500);
+
+  EXPECT_EQ(500u, store_b_->Size());
+}
+
+TEST_F(TransactionStoreSyncTests, CheckServicePullsSubtreesWhenEmpty)
+{
+  ECDSASigner const signer;
+  TxArray const     transactions = GenerateTransactions(200, signer);
+
+  AddTransactions(*store_a_, transactions, 0, 200);
+  Archive(*store_a_);
+
+  RunSyncService(transactions.size());
+
+  EXPECT_EQ(transactions.size(), store_b_->Size());
+}
+
+}  // namespace
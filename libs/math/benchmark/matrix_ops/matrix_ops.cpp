@@ -16,6 +16,10 @@
 //
 //------------------------------------------------------------------------------
 
+#include "math/linalg/blas/base.hpp"
+#include "math/linalg/blas/gemm_nn_novector.hpp"
+#include "math/linalg/blas/gemm_nn_vector.hpp"
+#include "math/linalg/prototype.hpp"
 #include "math/matrix_operations.hpp"
 #include "math/tensor.hpp"
 
@@ -596,6 +600,55 @@ BENCHMARK_TEMPLATE(BM_Dot, fetch::fixed_point::FixedPoint<16, 16>, 512, 512)
 BENCHMARK_TEMPLATE(BM_Dot, fetch::fixed_point::FixedPoint<32, 32>, 512, 512)
     ->Unit(benchmark::kMillisecond);
 
+template <class T, int N, uint64_t P>
+void BM_Gemm(benchmark::State &state)
+{
+  using namespace fetch::math::linalg;
+  using SizeType = fetch::math::SizeType;
+
+  fetch::math::Tensor<T> a(std::vector<SizeType>{N, N});
+  fetch::math::Tensor<T> b(std::vector<SizeType>{N, N});
+  fetch::math::Tensor<T> c(std::vector<SizeType>{N, N});
+  a.FillUniformRandom();
+  b.FillUniformRandom();
+
+  Blas<T, Signature(_C <= _alpha, _A, _B, _beta, _C), Computes(_C <= _alpha * _A * _B + _beta * _C),
+       P>
+      gemm;
+
+  for (auto _ : state)
+  {
+    gemm(T{1}, a, b, T{0}, c);
+  }
+
+  double const flops = 2.0 * N * N * N * static_cast<double>(state.iterations());
+  state.counters["GFLOP"] = benchmark::Counter(flops * 1e-9, benchmark::Counter::kIsRate);
+}
+
+// reference loops
+BENCHMARK_TEMPLATE(BM_Gemm, float, 128, fetch::platform::Parallelisation::NOT_PARALLEL)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Gemm, double, 128, fetch::platform::Parallelisation::NOT_PARALLEL)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Gemm, float, 512, fetch::platform::Parallelisation::NOT_PARALLEL)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Gemm, double, 512, fetch::platform::Parallelisation::NOT_PARALLEL)
+    ->Unit(benchmark::kMillisecond);
+
+// blocked kernel
+BENCHMARK_TEMPLATE(BM_Gemm, float, 128, fetch::platform::Parallelisation::VECTORISE)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Gemm, double, 128, fetch::platform::Parallelisation::VECTORISE)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Gemm, float, 512, fetch::platform::Parallelisation::VECTORISE)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Gemm, double, 512, fetch::platform::Parallelisation::VECTORISE)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Gemm, float, 1024, fetch::platform::Parallelisation::VECTORISE)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Gemm, double, 1024, fetch::platform::Parallelisation::VECTORISE)
+    ->Unit(benchmark::kMillisecond);
+
 template <class T, int H, int W>
 void BM_DotTranspose(benchmark::State &state)
 {
@@ -0,0 +1,57 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+/* Cache blocked general matrix multiplication on column major matrices:
+ *
+ *   C <= alpha * op(A) * op(B) + beta * C
+ *
+ * where op(X) is either X or its transpose, op(A) is m x k, op(B) is k x n and C is m x n. Each
+ * matrix is described by a pointer to its first element and the distance between its columns
+ * (the leading dimension), which allows the padded storage of the Tensor to be used directly.
+ *
+ * The multiplication follows the GotoBLAS scheme: op(B) is packed into panels which fit in the L3
+ * cache, op(A) is packed into blocks which fit in the L2 cache and a vectorised micro kernel
+ * computes small register tiles of C from the packed data. Large problems are partitioned along
+ * the larger of the M or N dimensions and computed on a shared worker pool.
+ *
+ * Only float and double are supported.
+ */
+
+#include <cstddef>
+
+namespace fetch {
+namespace math {
+namespace linalg {
+
+template <typename T>
+void Gemm(bool transpose_a, bool transpose_b, std::size_t m, std::size_t n, std::size_t k, T alpha,
+          T const *a, std::size_t lda, T const *b, std::size_t ldb, T beta, T *c, std::size_t ldc);
+
+/**
+ * Set the maximum number of threads used for a single matrix multiplication
+ *
+ * @param num_threads The number of threads, zero follows the limit of the parallel loops
+ */
+void SetGemmNumThreads(std::size_t num_threads);
+
+std::size_t GetGemmNumThreads();
+
+}  // namespace linalg
+}  // namespace math
+}  // namespace fetch
@@ -19,10 +19,12 @@
 
 #include "core/assert.hpp"
 #include <numeric>
+#include <type_traits>
 
 #include "math/base_types.hpp"
 #include "math/comparison.hpp"
 #include "math/fundamental_operators.hpp"  // add, subtract etc.
+#include "math/linalg/blas/gemm_kernel.hpp"
 
 namespace fetch {
 namespace math {
@@ -741,14 +743,44 @@ T ArgMax(std::vector<T> const &obj1)
   return ret;
 }
 
+namespace details_blas {
+
+// the element types supported by the blocked GEMM kernel
+template <typename T>
+using IsGemmType = std::integral_constant<bool, std::is_same<T, float>::value ||
+                                                    std::is_same<T, double>::value>;
+
+/**
+ * Computes ret <= op(A) * op(B) + beta * ret with the cache blocked GEMM kernel
+ * @param transpose_a whether op(A) is the transpose of A
+ * @param transpose_b whether op(B) is the transpose of B
+ * @param A
+ * @param B
+ * @param beta scale factor applied to the existing contents of ret
+ * @param ret
+ */
 template <typename ArrayType>
-fetch::math::meta::IfIsMathArray<ArrayType, void> Dot(ArrayType const &A, ArrayType const &B,
-                                                      ArrayType &ret)
+void Gemm(bool transpose_a, bool transpose_b, ArrayType const &A, ArrayType const &B,
+          typename ArrayType::Type beta, ArrayType &ret)
 {
-  ASSERT(A.shape().size() == 2);
-  ASSERT(B.shape().size() == 2);
-  ASSERT(A.shape()[1] == B.shape()[0]);
+  using Type = typename ArrayType::Type;
+
+  SizeType const k = transpose_a ? A.shape()[0] : A.shape()[1];
+
+  linalg::Gemm<Type>(transpose_a, transpose_b, ret.shape()[0], ret.shape()[1], k, Type{1},
+                     A.data().pointer(), A.padded_height(), B.data().pointer(), B.padded_height(),
+                     beta, ret.data().pointer(), ret.padded_height());
+}
+
+template <typename ArrayType>
+void Dot(ArrayType const &A, ArrayType const &B, ArrayType &ret, std::true_type /*gemm*/)
+{
+  Gemm(false, false, A, B, typename ArrayType::Type{0}, ret);
+}
 
+template <typename ArrayType>
+void Dot(ArrayType const &A, ArrayType const &B, ArrayType &ret, std::false_type /*gemm*/)
+{
   for (SizeType i(0); i < A.shape()[0]; ++i)
   {
     for (SizeType j(0); j < B.shape()[1]; ++j)
@@ -762,6 +794,62 @@ fetch::math::meta::IfIsMathArray<ArrayType, void> Dot(ArrayType const &A, ArrayT
   }
 }
 
+// N.B. DotTranspose and TransposeDot accumulate into ret
+template <typename ArrayType>
+void DotTranspose(ArrayType const &A, ArrayType const &B, ArrayType &ret, std::true_type /*gemm*/)
+{
+  Gemm(false, true, A, B, typename ArrayType::Type{1}, ret);
+}
+
+template <typename ArrayType>
+void DotTranspose(ArrayType const &A, ArrayType const &B, ArrayType &ret, std::false_type /*gemm*/)
+{
+  for (SizeType i(0); i < A.shape()[0]; ++i)
+  {
+    for (SizeType j(0); j < B.shape()[0]; ++j)
+    {
+      for (SizeType k(0); k < A.shape()[1]; ++k)
+      {
+        ret.At(i, j) += A.At(i, k) * B.At(j, k);
+      }
+    }
+  }
+}
+
+template <typename ArrayType>
+void TransposeDot(ArrayType const &A, ArrayType const &B, ArrayType &ret, std::true_type /*gemm*/)
+{
+  Gemm(true, false, A, B, typename ArrayType::Type{1}, ret);
+}
+
+template <typename ArrayType>
+void TransposeDot(ArrayType const &A, ArrayType const &B, ArrayType &ret, std::false_type /*gemm*/)
+{
+  for (SizeType i(0); i < A.shape()[1]; ++i)
+  {
+    for (SizeType j(0); j < B.shape()[1]; ++j)
+    {
+      for (SizeType k(0); k < A.shape()[0]; ++k)
+      {
+        ret.At(i, j) += A.At(k, i) * B.At(k, j);
+      }
+    }
+  }
+}
+
+}  // namespace details_blas
+
+template <typename ArrayType>
+fetch::math::meta::IfIsMathArray<ArrayType, void> Dot(ArrayType const &A, ArrayType const &B,
+                                                      ArrayType &ret)
+{
+  ASSERT(A.shape().size() == 2);
+  ASSERT(B.shape().size() == 2);
+  ASSERT(A.shape()[1] == B.shape()[0]);
+
+  details_blas::Dot(A, B, ret, details_blas::IsGemmType<typename ArrayType::Type>{});
+}
+
 template <typename ArrayType>
 ArrayType Dot(ArrayType const &A, ArrayType const &B)
 {
@@ -788,16 +876,7 @@ fetch::math::meta::IfIsMathArray<ArrayType, void> DotTranspose(ArrayType const &
   ASSERT(A.shape()[0] == ret.shape()[0]);
   ASSERT(B.shape()[0] == ret.shape()[1]);
 
-  for (size_t i(0); i < A.shape()[0]; ++i)
-  {
-    for (size_t j(0); j < B.shape()[0]; ++j)
-    {
-      for (size_t k(0); k < A.shape()[1]; ++k)
-      {
-        ret.At(i, j) += A.At(i, k) * B.At(j, k);
-      }
-    }
-  }
+  details_blas::DotTranspose(A, B, ret, details_blas::IsGemmType<typename ArrayType::Type>{});
 }
 
 template <typename ArrayType>
@@ -825,16 +904,7 @@ fetch::math::meta::IfIsMathArray<ArrayType, void> TransposeDot(ArrayType const &
   ASSERT(A.shape()[1] == ret.shape()[0]);
   ASSERT(B.shape()[1] == ret.shape()[1]);
 
-  for (size_t i(0); i < A.shape()[1]; ++i)
-  {
-    for (size_t j(0); j < B.shape()[1]; ++j)
-    {
-      for (size_t k(0); k < A.shape()[0]; ++k)
-      {
-        ret.At(i, j) += A.At(k, i) * B.At(k, j);
-      }
-    }
-  }
+  details_blas::TransposeDot(A, B, ret, details_blas::IsGemmType<typename ArrayType::Type>{});
 }
 
 template <class ArrayType>
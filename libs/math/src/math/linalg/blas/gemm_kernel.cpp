@@ -0,0 +1,434 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/linalg/blas/gemm_kernel.hpp"
+#include "vectorise/memory/shared_array.hpp"
+#include "vectorise/platform.hpp"
+#include "vectorise/threading/parallel_for.hpp"
+#include "vectorise/vectorise.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+namespace fetch {
+namespace math {
+namespace linalg {
+namespace {
+
+template <typename T>
+struct GemmBlocking
+{
+  using Register = vectorize::VectorRegister<T, platform::VectorRegisterSize<T>::value>;
+
+  static constexpr std::size_t LANES = Register::E_BLOCK_COUNT;
+  static constexpr std::size_t MR    = 2 * LANES;  ///< The rows of the register tile
+  static constexpr std::size_t NR    = 4;          ///< The columns of the register tile
+  static constexpr std::size_t MC    = 96;         ///< The rows of the packed block of A (L2)
+  static constexpr std::size_t KC    = 256;        ///< The depth of the packed A and B panels
+  static constexpr std::size_t NC    = 1024;       ///< The columns of the packed panel of B (L3)
+
+  static_assert((MC % MR) == 0, "The block of A must contain a whole number of register tiles");
+  static_assert((NC % NR) == 0, "The panel of B must contain a whole number of register tiles");
+};
+
+// below this number of multiply-adds the cost of dispatching to the pool outweighs the gain
+constexpr std::size_t MIN_PARALLEL_WORK = std::size_t{1} << 18u;
+
+// the smallest number of rows or columns of C computed by a single task
+constexpr std::size_t MIN_TASK_EXTENT = 32;
+
+std::atomic<std::size_t> gemm_num_threads{0};
+
+/**
+ * The per thread packing buffers, grown on demand and reused between multiplications
+ */
+template <typename T>
+class PackBuffers
+{
+public:
+  static PackBuffers &Get()
+  {
+    static thread_local PackBuffers buffers;
+    return buffers;
+  }
+
+  T *a(std::size_t size)
+  {
+    return Reserve(a_, size);
+  }
+
+  T *b(std::size_t size)
+  {
+    return Reserve(b_, size);
+  }
+
+private:
+  using Buffer = memory::SharedArray<T>;
+
+  static T *Reserve(Buffer &buffer, std::size_t size)
+  {
+    if (buffer.size() < size)
+    {
+      buffer = Buffer(size);
+    }
+
+    return buffer.pointer();
+  }
+
+  Buffer a_;
+  Buffer b_;
+};
+
+/**
+ * Pack a block of op(A) into panels of MR rows. Within a panel the MR elements of each column are
+ * contiguous, the rows beyond the edge of the matrix are zero filled.
+ *
+ * @param transpose Flag to signal A is stored transposed
+ * @param a The pointer to the first element of the block
+ * @param lda The leading dimension of A
+ * @param mc The number of rows in the block
+ * @param kc The number of columns in the block
+ * @param packed The output buffer
+ */
+template <typename T>
+void PackA(bool transpose, T const *a, std::size_t lda, std::size_t mc, std::size_t kc, T *packed)
+{
+  static constexpr std::size_t MR = GemmBlocking<T>::MR;
+
+  for (std::size_t i = 0; i < mc; i += MR)
+  {
+    std::size_t const mr = std::min(MR, mc - i);
+
+    for (std::size_t p = 0; p < kc; ++p)
+    {
+      if (transpose)
+      {
+        for (std::size_t ii = 0; ii < mr; ++ii)
+        {
+          packed[ii] = a[p + ((i + ii) * lda)];
+        }
+      }
+      else
+      {
+        T const *column = a + i + (p * lda);
+        std::copy(column, column + mr, packed);
+      }
+
+      std::fill(packed + mr, packed + MR, T{0});
+      packed += MR;
+    }
+  }
+}
+
+/**
+ * Pack a panel of op(B) into slivers of NR columns. Within a sliver the NR elements of each row
+ * are contiguous, the columns beyond the edge of the matrix are zero filled.
+ *
+ * @param transpose Flag to signal B is stored transposed
+ * @param b The pointer to the first element of the panel
+ * @param ldb The leading dimension of B
+ * @param kc The number of rows in the panel
+ * @param nc The number of columns in the panel
+ * @param packed The output buffer
+ */
+template <typename T>
+void PackB(bool transpose, T const *b, std::size_t ldb, std::size_t kc, std::size_t nc, T *packed)
+{
+  static constexpr std::size_t NR = GemmBlocking<T>::NR;
+
+  for (std::size_t j = 0; j < nc; j += NR)
+  {
+    std::size_t const nr = std::min(NR, nc - j);
+
+    for (std::size_t p = 0; p < kc; ++p)
+    {
+      for (std::size_t jj = 0; jj < nr; ++jj)
+      {
+        packed[jj] = transpose ? b[(j + jj) + (p * ldb)] : b[p + ((j + jj) * ldb)];
+      }
+
+      std::fill(packed + nr, packed + NR, T{0});
+      packed += NR;
+    }
+  }
+}
+
+/**
+ * Compute a MR x NR register tile of the product of a packed panel of A and a packed sliver of B
+ *
+ * @param kc The depth of the panels
+ * @param a The packed panel of A
+ * @param b The packed sliver of B
+ * @param tile The (aligned) output tile, stored column major
+ */
+template <typename T>
+void MicroKernel(std::size_t kc, T const *a, T const *b, T *tile)
+{
+  using Register = typename GemmBlocking<T>::Register;
+
+  static constexpr std::size_t LANES = GemmBlocking<T>::LANES;
+  static constexpr std::size_t MR    = GemmBlocking<T>::MR;
+  static constexpr std::size_t NR    = GemmBlocking<T>::NR;
+
+  Register upper[NR];
+  Register lower[NR];
+  for (std::size_t j = 0; j < NR; ++j)
+  {
+    upper[j] = Register(T{0});
+    lower[j] = Register(T{0});
+  }
+
+  for (std::size_t p = 0; p < kc; ++p)
+  {
+    Register const a_upper(a);
+    Register const a_lower(a + LANES);
+
+    for (std::size_t j = 0; j < NR; ++j)
+    {
+      Register const b_j(b[j]);
+
+      upper[j] = upper[j] + (a_upper * b_j);
+      lower[j] = lower[j] + (a_lower * b_j);
+    }
+
+    a += MR;
+    b += NR;
+  }
+
+  for (std::size_t j = 0; j < NR; ++j)
+  {
+    upper[j].Store(tile + (j * MR));
+    lower[j].Store(tile + (j * MR) + LANES);
+  }
+}
+
+/**
+ * Accumulate the product of a packed block of A and a packed panel of B into C
+ */
+template <typename T>
+void MacroKernel(std::size_t mc, std::size_t nc, std::size_t kc, T alpha, T const *packed_a,
+                 T const *packed_b, T *c, std::size_t ldc)
+{
+  static constexpr std::size_t MR = GemmBlocking<T>::MR;
+  static constexpr std::size_t NR = GemmBlocking<T>::NR;
+
+  alignas(64) T tile[MR * NR];
+
+  for (std::size_t j = 0; j < nc; j += NR)
+  {
+    std::size_t const nr = std::min(NR, nc - j);
+
+    for (std::size_t i = 0; i < mc; i += MR)
+    {
+      std::size_t const mr = std::min(MR, mc - i);
+
+      MicroKernel(kc, packed_a + (i * kc), packed_b + (j * kc), tile);
+
+      T *c_tile = c + i + (j * ldc);
+      for (std::size_t jj = 0; jj < nr; ++jj)
+      {
+        for (std::size_t ii = 0; ii < mr; ++ii)
+        {
+          c_tile[ii + (jj * ldc)] += alpha * tile[ii + (jj * MR)];
+        }
+      }
+    }
+  }
+}
+
+template <typename T>
+void Scale(std::size_t m, std::size_t n, T beta, T *c, std::size_t ldc)
+{
+  if (beta == T{1})
+  {
+    return;
+  }
+
+  for (std::size_t j = 0; j < n; ++j)
+  {
+    T *column = c + (j * ldc);
+
+    // as in the reference BLAS, a zero beta overwrites C (including any NaNs) rather than scaling
+    if (beta == T{0})
+    {
+      std::fill(column, column + m, T{0});
+    }
+    else
+    {
+      for (std::size_t i = 0; i < m; ++i)
+      {
+        column[i] *= beta;
+      }
+    }
+  }
+}
+
+/**
+ * Compute the whole multiplication on the calling thread
+ */
+template <typename T>
+void GemmSerial(bool transpose_a, bool transpose_b, std::size_t m, std::size_t n, std::size_t k,
+                T alpha, T const *a, std::size_t lda, T const *b, std::size_t ldb, T beta, T *c,
+                std::size_t ldc)
+{
+  static constexpr std::size_t MC = GemmBlocking<T>::MC;
+  static constexpr std::size_t KC = GemmBlocking<T>::KC;
+  static constexpr std::size_t NC = GemmBlocking<T>::NC;
+  static constexpr std::size_t MR = GemmBlocking<T>::MR;
+  static constexpr std::size_t NR = GemmBlocking<T>::NR;
+
+  Scale(m, n, beta, c, ldc);
+
+  if ((alpha == T{0}) || (k == 0))
+  {
+    return;
+  }
+
+  auto &buffers = PackBuffers<T>::Get();
+
+  std::size_t const block_rows = std::min(MC, ((m + MR - 1) / MR) * MR);
+  std::size_t const panel_cols = std::min(NC, ((n + NR - 1) / NR) * NR);
+
+  T *packed_a = buffers.a(block_rows * std::min(KC, k));
+  T *packed_b = buffers.b(panel_cols * std::min(KC, k));
+
+  for (std::size_t jc = 0; jc < n; jc += NC)
+  {
+    std::size_t const nc = std::min(NC, n - jc);
+
+    for (std::size_t pc = 0; pc < k; pc += KC)
+    {
+      std::size_t const kc = std::min(KC, k - pc);
+
+      T const *b_panel = transpose_b ? (b + jc + (pc * ldb)) : (b + pc + (jc * ldb));
+      PackB(transpose_b, b_panel, ldb, kc, nc, packed_b);
+
+      for (std::size_t ic = 0; ic < m; ic += MC)
+      {
+        std::size_t const mc = std::min(MC, m - ic);
+
+        T const *a_block = transpose_a ? (a + pc + (ic * lda)) : (a + ic + (pc * lda));
+        PackA(transpose_a, a_block, lda, mc, kc, packed_a);
+
+        MacroKernel(mc, nc, kc, alpha, packed_a, packed_b, c + ic + (jc * ldc), ldc);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+/**
+ * Compute C <= alpha * op(A) * op(B) + beta * C on column major matrices
+ *
+ * @param transpose_a Flag to signal op(A) is the transpose of A
+ * @param transpose_b Flag to signal op(B) is the transpose of B
+ * @param m The number of rows of op(A) and C
+ * @param n The number of columns of op(B) and C
+ * @param k The number of columns of op(A) and rows of op(B)
+ * @param alpha The scale factor of the product
+ * @param a The pointer to the first element of A
+ * @param lda The distance between the columns of A
+ * @param b The pointer to the first element of B
+ * @param ldb The distance between the columns of B
+ * @param beta The scale factor of C
+ * @param c The pointer to the first element of C
+ * @param ldc The distance between the columns of C
+ */
+template <typename T>
+void Gemm(bool transpose_a, bool transpose_b, std::size_t m, std::size_t n, std::size_t k, T alpha,
+          T const *a, std::size_t lda, T const *b, std::size_t ldb, T beta, T *c, std::size_t ldc)
+{
+  if ((m == 0) || (n == 0))
+  {
+    return;
+  }
+
+  // partition the larger dimension of C between the threads
+  bool const        split_columns = (n >= m);
+  std::size_t const extent        = split_columns ? n : m;
+  std::size_t const alignment     = split_columns ? GemmBlocking<T>::NR : GemmBlocking<T>::MR;
+
+  std::size_t num_tasks = 1;
+  if ((m * n * k) >= MIN_PARALLEL_WORK)
+  {
+    num_tasks = std::min(GetGemmNumThreads(), extent / MIN_TASK_EXTENT);
+  }
+
+  if (num_tasks <= 1)
+  {
+    GemmSerial(transpose_a, transpose_b, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+    return;
+  }
+
+  std::size_t chunk = (extent + num_tasks - 1) / num_tasks;
+  chunk             = ((chunk + alignment - 1) / alignment) * alignment;
+
+  auto const compute = [=](std::size_t start) {
+    std::size_t const size = std::min(chunk, extent - start);
+
+    if (split_columns)
+    {
+      T const *b_start = transpose_b ? (b + start) : (b + (start * ldb));
+      GemmSerial(transpose_a, transpose_b, m, size, k, alpha, a, lda, b_start, ldb, beta,
+                 c + (start * ldc), ldc);
+    }
+    else
+    {
+      T const *a_start = transpose_a ? (a + (start * lda)) : (a + start);
+      GemmSerial(transpose_a, transpose_b, size, n, k, alpha, a_start, lda, b, ldb, beta,
+                 c + start, ldc);
+    }
+  };
+
+  // the partitions share the process wide parallel loop pool, so a multiplication made from inside
+  // a parallel tensor operation is computed serially rather than oversubscribing the cores
+  threading::ParallelFor((extent + chunk - 1) / chunk,
+                         [&compute, chunk](std::size_t index) { compute(index * chunk); });
+}
+
+void SetGemmNumThreads(std::size_t num_threads)
+{
+  gemm_num_threads = num_threads;
+}
+
+/**
+ * Get the maximum number of threads used for a single matrix multiplication
+ *
+ * @return The number of threads
+ */
+std::size_t GetGemmNumThreads()
+{
+  std::size_t const num_threads = gemm_num_threads;
+  if (num_threads != 0)
+  {
+    return num_threads;
+  }
+
+  return threading::GetParallelForNumThreads();
+}
+
+template void Gemm<float>(bool, bool, std::size_t, std::size_t, std::size_t, float, float const *,
+                          std::size_t, float const *, std::size_t, float, float *, std::size_t);
+template void Gemm<double>(bool, bool, std::size_t, std::size_t, std::size_t, double,
+                           double const *, std::size_t, double const *, std::size_t, double,
+                           double *, std::size_t);
+
+}  // namespace linalg
+}  // namespace math
+}  // namespace fetch
@@ -18,6 +18,7 @@
 
 #include "math/linalg/blas/gemm_tt_vector.hpp"
 #include "math/linalg/blas/base.hpp"
+#include "math/linalg/blas/gemm_kernel.hpp"
 #include "math/linalg/prototype.hpp"
 #include "math/tensor.hpp"
 namespace fetch {
@@ -32,74 +33,8 @@ void Blas<S, Signature(_C <= _alpha, _A, _B, _beta, _C),
                                                             Tensor<Type> const &b, Type const &beta,
                                                             Tensor<Type> &c) const
 {
-  std::size_t i;
-  std::size_t j;
-  if ((c.height() == 0) ||
-      ((c.width() == 0) || (((alpha == 0.0) || (a.height() == 0)) && (beta == 1.0))))
-  {
-    return;
-  }
-
-  if (alpha == 0.0)
-  {
-    if (beta == 0.0)
-    {
-      for (j = 0; j < c.width(); ++j)
-      {
-
-        VectorRegisterType vec_zero(0.0);
-
-        auto                 ret_slice = c.data().slice(c.padded_height() * j, c.height());
-        memory::TrivialRange range(std::size_t(0), std::size_t(c.height()));
-        ret_slice.in_parallel().Apply(
-            range, [vec_zero](VectorRegisterType &vw_c_j) { vw_c_j = vec_zero; });
-      }
-    }
-    else
-    {
-      for (j = 0; j < c.width(); ++j)
-      {
-
-        VectorRegisterType vec_beta(beta);
-
-        auto ret_slice = c.data().slice(c.padded_height() * j, c.height());
-        auto slice_c_j = c.data().slice(c.padded_height() * std::size_t(j), c.padded_height());
-        memory::TrivialRange range(std::size_t(0), std::size_t(c.height()));
-        ret_slice.in_parallel().Apply(
-            range,
-            [vec_beta](VectorRegisterType const &vr_c_j, VectorRegisterType &vw_c_j) {
-              vw_c_j = vec_beta * vr_c_j;
-            },
-            slice_c_j);
-      }
-    }
-
-    return;
-  }
-
-  for (j = 0; j < c.width(); ++j)
-  {
-    for (i = 0; i < c.height(); ++i)
-    {
-      Type        temp;
-      std::size_t l;
-      temp = 0.0;
-      for (l = 0; l < a.height(); ++l)
-      {
-        temp = temp + a(l, i) * b(j, l);
-      }
-
-      if (beta == 0.0)
-      {
-        c(i, j) = alpha * temp;
-      }
-      else
-      {
-        c(i, j) = alpha * temp + beta * c(i, j);
-      }
-    }
-  }
-  return;
+  Gemm(true, true, c.height(), c.width(), a.height(), alpha, a.data().pointer(), a.padded_height(),
+       b.data().pointer(), b.padded_height(), beta, c.data().pointer(), c.padded_height());
 }
 
 template class Blas<double, Signature(_C <= _alpha, _A, _B, _beta, _C),
@@ -0,0 +1,170 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include "core/random/lcg.hpp"
+#include "math/linalg/blas/gemm_kernel.hpp"
+#include "vectorise/threading/parallel_for.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+using namespace fetch::math::linalg;
+
+namespace {
+
+/**
+ * A column major matrix with (deliberately) padded columns
+ */
+template <typename T>
+struct Matrix
+{
+  Matrix(std::size_t r, std::size_t c, fetch::random::LinearCongruentialGenerator &rng)
+    : rows{r}
+    , cols{c}
+    , ld{r + 3}
+    , data(ld * c)
+  {
+    for (auto &value : data)
+    {
+      value = static_cast<T>(rng.AsDouble() - 0.5);
+    }
+  }
+
+  T &operator()(std::size_t i, std::size_t j)
+  {
+    return data[i + (j * ld)];
+  }
+
+  std::size_t    rows;
+  std::size_t    cols;
+  std::size_t    ld;
+  std::vector<T> data;
+};
+
+template <typename T>
+void CheckGemm(bool transpose_a, bool transpose_b, std::size_t m, std::size_t n, std::size_t k,
+               T alpha, T beta)
+{
+  fetch::random::LinearCongruentialGenerator rng;
+
+  Matrix<T> a{transpose_a ? k : m, transpose_a ? m : k, rng};
+  Matrix<T> b{transpose_b ? n : k, transpose_b ? k : n, rng};
+  Matrix<T> c{m, n, rng};
+  Matrix<T> expected = c;
+
+  for (std::size_t i = 0; i < m; ++i)
+  {
+    for (std::size_t j = 0; j < n; ++j)
+    {
+      double sum{0};
+      for (std::size_t p = 0; p < k; ++p)
+      {
+        T const a_ip = transpose_a ? a(p, i) : a(i, p);
+        T const b_pj = transpose_b ? b(j, p) : b(p, j);
+        sum += static_cast<double>(a_ip) * static_cast<double>(b_pj);
+      }
+
+      expected(i, j) = static_cast<T>((alpha * sum) + (beta * expected(i, j)));
+    }
+  }
+
+  Gemm<T>(transpose_a, transpose_b, m, n, k, alpha, a.data.data(), a.ld, b.data.data(), b.ld, beta,
+          c.data.data(), c.ld);
+
+  double const tolerance = (sizeof(T) == sizeof(float)) ? 1e-4 : 1e-10;
+  for (std::size_t j = 0; j < n; ++j)
+  {
+    for (std::size_t i = 0; i < m; ++i)
+    {
+      ASSERT_NEAR(c(i, j), expected(i, j), tolerance * static_cast<double>(k + 1))
+          << "m: " << m << " n: " << n << " k: " << k << " i: " << i << " j: " << j;
+    }
+
+    // the padding between the columns must not be touched
+    for (std::size_t i = m; i < c.ld; ++i)
+    {
+      ASSERT_EQ(c(i, j), expected(i, j));
+    }
+  }
+}
+
+template <typename T>
+class GemmKernelTest : public ::testing::Test
+{
+protected:
+  void TearDown() override
+  {
+    SetGemmNumThreads(0);
+    fetch::threading::SetParallelForNumThreads(0);
+  }
+};
+
+using GemmTypes = ::testing::Types<float, double>;
+TYPED_TEST_CASE(GemmKernelTest, GemmTypes);
+
+TYPED_TEST(GemmKernelTest, edge_tiles_and_transposes)
+{
+  using Type = TypeParam;
+
+  // sizes straddling the register tile, the block of A and the depth of the panels
+  std::vector<std::size_t> const sizes{1, 3, 7, 17, 97, 260};
+
+  for (bool transpose_a : {false, true})
+  {
+    for (bool transpose_b : {false, true})
+    {
+      for (std::size_t const size : sizes)
+      {
+        CheckGemm<Type>(transpose_a, transpose_b, size, 5, 9, Type{1}, Type{0});
+        CheckGemm<Type>(transpose_a, transpose_b, 6, size, 11, Type{2}, Type{1});
+        CheckGemm<Type>(transpose_a, transpose_b, 13, 10, size, Type{-1}, Type{0.5});
+      }
+    }
+  }
+}
+
+TYPED_TEST(GemmKernelTest, zero_alpha_or_depth_only_scales_c)
+{
+  using Type = TypeParam;
+
+  CheckGemm<Type>(false, false, 9, 8, 7, Type{0}, Type{3});
+  CheckGemm<Type>(true, false, 9, 8, 0, Type{1}, Type{0.5});
+  CheckGemm<Type>(false, true, 9, 8, 0, Type{1}, Type{0});
+}
+
+TYPED_TEST(GemmKernelTest, threaded_partitions)
+{
+  using Type = TypeParam;
+
+  // the partitions run on the parallel loop pool, which is also limited to 4 threads so that they
+  // are computed concurrently whatever the number of cores
+  SetGemmNumThreads(4);
+  fetch::threading::SetParallelForNumThreads(4);
+  EXPECT_EQ(GetGemmNumThreads(), 4u);
+
+  // wide (split by columns) and tall (split by rows) problems
+  CheckGemm<Type>(false, false, 70, 301, 40, Type{1}, Type{0});
+  CheckGemm<Type>(true, true, 70, 301, 40, Type{1}, Type{1});
+  CheckGemm<Type>(false, true, 301, 70, 40, Type{0.5}, Type{2});
+  CheckGemm<Type>(true, false, 301, 70, 40, Type{1}, Type{0});
+}
+
+}  // namespace
@@ -0,0 +1,108 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/bitvector.hpp"
+#include "core/byte_array/byte_array.hpp"
+#include "core/random/lcg.hpp"
+#include "ledger/chain/main_chain.hpp"
+#include "ledger/chain/transaction_layout.hpp"
+#include "miner/basic_miner.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::byte_array::ByteArray;
+using fetch::ledger::Block;
+using fetch::ledger::MainChain;
+using fetch::ledger::TransactionLayout;
+using fetch::miner::BasicMiner;
+using fetch::random::LinearCongruentialGenerator;
+
+constexpr uint32_t    LOG2_NUM_LANES = 4;
+constexpr std::size_t NUM_LANES      = 1u << LOG2_NUM_LANES;
+constexpr std::size_t NUM_SLICES     = 64;
+
+TransactionLayout GenerateLayout(LinearCongruentialGenerator &rng, uint64_t index)
+{
+  ByteArray digest;
+  digest.Resize(32);
+
+  auto *raw = reinterpret_cast<LinearCongruentialGenerator::random_type *>(digest.pointer());
+  for (std::size_t i = 0; i < 4; ++i)
+  {
+    raw[i] = rng();
+  }
+
+  // between one and three resources
+  BitVector mask{NUM_LANES};
+  for (uint64_t i = 0, num_resources = 1 + (rng() % 3); i < num_resources; ++i)
+  {
+    mask.set(rng() % NUM_LANES, 1);
+  }
+
+  return {digest, mask, 1 + (rng() % 10000), index, index + 1000};
+}
+
+void BasicMiner_GenerateBlock(benchmark::State &state)
+{
+  auto const pool_size = static_cast<std::size_t>(state.range(0));
+
+  LinearCongruentialGenerator rng;
+  MainChain                   chain{MainChain::Mode::IN_MEMORY_DB};
+  BasicMiner                  miner{LOG2_NUM_LANES};
+
+  for (std::size_t i = 0; i < pool_size; ++i)
+  {
+    miner.EnqueueTransaction(GenerateLayout(rng, i));
+  }
+
+  // move the pending transactions into the (fee ordered) mining pool
+  {
+    Block block;
+    block.body.previous_hash = chain.GetHeaviestBlockHash();
+    miner.GenerateBlock(block, NUM_LANES, NUM_SLICES, chain);
+  }
+
+  for (auto _ : state)
+  {
+    Block block;
+    block.body.previous_hash = chain.GetHeaviestBlockHash();
+
+    miner.GenerateBlock(block, NUM_LANES, NUM_SLICES, chain);
+
+    benchmark::DoNotOptimize(block.body.slices.data());
+  }
+
+  state.counters["Backlog"] = static_cast<double>(miner.GetBacklog());
+}
+
+}  // namespace
+
+BENCHMARK(BasicMiner_GenerateBlock)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
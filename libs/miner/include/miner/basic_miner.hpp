@@ -27,7 +27,10 @@
 
 #include "miner/transaction_layout_queue.hpp"
 
+#include <atomic>
+#include <cstddef>
 #include <list>
+#include <vector>
 
 namespace fetch {
 namespace miner {
@@ -37,9 +40,13 @@ namespace miner {
  * parallelize the packing over a number of threads.
  *
  * Internally the miner maintains 2 queues. One which is the pending queue which is populated when
- * a new transaction is added to the miner. When block generation begins, this pending queue is
- * transferred to the main queue when it is evaluated in order to generate new blocks. During this
- * operation the main queue is locked.
+ * a new transaction is added to the miner. When block generation begins, the contents of the
+ * pending queue are exchanged for an empty one, so new transactions can continue to be added while
+ * the block is being packed. The transactions are then merged into the main queue, which is kept
+ * ordered by fee.
+ *
+ * The main queue is dealt out between the packing threads in fee order, each of which greedily
+ * fills its own range of slices. During this operation the main queue is locked.
  */
 class BasicMiner : public ledger::BlockPackerInterface
 {
@@ -76,13 +83,17 @@ private:
   using ThreadPool      = threading::Pool;
   using DigestSet       = ledger::DigestSet;
   using Queue           = TransactionLayoutQueue;
+  using Candidates      = std::vector<Queue::Iterator>;
+  using CandidateFlags  = std::vector<bool>;
 
   /// @name Packing Operations
   /// @{
-  static void GenerateSlices(Queue &transactions, Block::Body &block, std::size_t offset,
-                             std::size_t interval, std::size_t num_lanes);
-  static void GenerateSlice(Queue &transactions, Block::Slice &slice, std::size_t slice_index,
-                            std::size_t num_lanes);
+  static void GenerateSlices(Candidates const &candidates, Block::Body &block,
+                             std::size_t slice_begin, std::size_t slice_end, std::size_t num_lanes,
+                             Candidates &packed);
+  static void GenerateSlice(Candidates const &candidates, CandidateFlags &used,
+                            std::size_t &first_unused, Block::Slice &slice, std::size_t num_lanes,
+                            Candidates &packed);
   static bool SortByFee(TransactionLayout const &a, TransactionLayout const &b);
   /// @}
 
@@ -104,6 +115,8 @@ private:
   mutable Mutex mining_pool_lock_{__LINE__, __FILE__};  ///< Mining pool lock (priority 0)
   Queue         mining_pool_;                           ///< The main mining queue for the node
   /// @}
+
+  std::atomic<std::size_t> mining_pool_size_{0};  ///< Size of the main queue (read without locking)
 };
 
 }  // namespace miner
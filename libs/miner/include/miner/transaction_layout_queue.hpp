@@ -63,10 +63,13 @@ public:
   std::size_t Remove(DigestSet const &digests);
   void        Splice(TransactionLayoutQueue &other);
   void        Splice(TransactionLayoutQueue &other, Iterator start, Iterator end);
+  void        Swap(TransactionLayoutQueue &other);
   Iterator    Erase(Iterator const &iterator);
 
   template <typename SortPredicate>
   void Sort(SortPredicate &&predicate);
+  template <typename SortPredicate>
+  void Merge(TransactionLayoutQueue &other, SortPredicate &&predicate);
   /// @}
 
   // Operators
@@ -75,6 +78,7 @@ public:
 
 private:
   static bool RemapAndAdd(UnderlyingList &list, TransactionLayout const &tx, uint32_t num_lanes);
+  UnderlyingList ExtractNewEntries(TransactionLayoutQueue &other);
 
   uint32_t       log2_num_lanes_;
   DigestSet      digests_;  ///< Set of digests stored within the list
@@ -136,5 +140,24 @@ void TransactionLayoutQueue::Sort(SortPredicate &&predicate)
   list_.sort(predicate);
 }
 
+/**
+ * Merge the contents of the specified queue into the current queue, which must already be sorted
+ * by the same predicate. The result is a sorted queue.
+ *
+ * After the operation the contents of the input queue will be zero
+ *
+ * @param other The queue to be merged into the existing one
+ * @param predicate The sorting predicate
+ */
+template <typename SortPredicate>
+void TransactionLayoutQueue::Merge(TransactionLayoutQueue &other, SortPredicate &&predicate)
+{
+  UnderlyingList input = ExtractNewEntries(other);
+
+  // sorting the new entries is cheap in comparison with sorting the complete queue
+  input.sort(predicate);
+  list_.merge(input, predicate);
+}
+
 }  // namespace miner
 }  // namespace fetch
\ No newline at end of file
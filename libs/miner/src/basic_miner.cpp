@@ -24,6 +24,8 @@
 #include "ledger/chain/transaction.hpp"
 
 #include <algorithm>
+#include <future>
+#include <vector>
 
 namespace fetch {
 namespace miner {
@@ -113,10 +115,18 @@ void BasicMiner::GenerateBlock(Block &block, std::size_t num_lanes, std::size_t
   FETCH_LOCK(mining_pool_lock_);
   assert(num_lanes == (1u << log2_num_lanes_));
 
-  // splice the contents of the pending queue into the main mining pool
+  // merge the contents of the pending queue into the (fee ordered) main mining pool. The pending
+  // lock is only held while the queue is exchanged for an empty one, in order that new
+  // transactions are never blocked by the packing of the block
   {
-    FETCH_LOCK(pending_lock_);
-    mining_pool_.Splice(pending_);
+    Queue incoming{log2_num_lanes_};
+
+    {
+      FETCH_LOCK(pending_lock_);
+      incoming.Swap(pending_);
+    }
+
+    mining_pool_.Merge(incoming, SortByFee);
   }
 
   // detect the transactions which have already been incorporated into previous blocks
@@ -132,63 +142,66 @@ void BasicMiner::GenerateBlock(Block &block, std::size_t num_lanes, std::size_t
   FETCH_LOG_INFO(LOGGING_NAME, "Starting block packing. Pool Size: ", pool_size_before);
 
   // determine how many of the threads should be used in this block generation
-  std::size_t const num_threads =
-      Clip3<std::size_t>(mining_pool_.size() / 1000u, 1u, max_num_threads_);
+  std::size_t const max_threads =
+      std::max<std::size_t>(std::min<std::size_t>(max_num_threads_, num_slices), 1u);
+  std::size_t const num_threads = Clip3<std::size_t>(mining_pool_.size() / 1000u, 1u, max_threads);
 
   // prepare the basic formatting for the block
   block.body.slices.resize(num_slices);
 
-  // skip thread generation in the simple case
-  if (num_threads == 1)
+  // deal out the fee ordered pool between the threads, so that each of them receives a similar
+  // share of the most valuable transactions
+  std::vector<Candidates> candidates(num_threads);
+  for (auto &list : candidates)
   {
-    GenerateSlices(mining_pool_, block.body, 0, 1, num_lanes);
+    list.reserve((mining_pool_.size() / num_threads) + 1);
   }
-  else
-  {
-    using QueuePtr = std::unique_ptr<Queue>;
 
-    // split the main queue into a series of smaller queues that can be executed in parallel
-    std::vector<QueuePtr> transaction_lists(num_threads);
-    for (auto &queue : transaction_lists)
-    {
-      queue = std::make_unique<Queue>(log2_num_lanes_);
-    }
-
-    std::size_t const num_tx_per_thread = mining_pool_.size() / num_threads;
-
-    for (std::size_t i = 0; i < num_threads; ++i)
-    {
-      QueuePtr const &txs = transaction_lists[i];
-
-      auto start = mining_pool_.begin();
-      auto end   = start;
-      std::advance(end, static_cast<int32_t>(std::min(num_tx_per_thread, mining_pool_.size())));
+  std::size_t index{0};
+  for (auto it = mining_pool_.begin(), end = mining_pool_.end(); it != end; ++it, ++index)
+  {
+    candidates[index % num_threads].push_back(it);
+  }
 
-      // TODO(private issue XXX): While this efficiently breaks up the transaction queue into even
-      //  chunks it assumes that the fees of the transactions are roughly the same. This algorithm
-      //  should be updated to maximise collected fees for the miner.
+  // each thread populates its own range of slices
+  std::vector<Candidates> packed(num_threads);
+  auto const slice_begin = [num_slices, num_threads](std::size_t thread_index) {
+    return (thread_index * num_slices) / num_threads;
+  };
 
-      // splice in the contents of the array
-      txs->Splice(mining_pool_, start, end);
+  std::vector<std::future<void>> pending_threads{};
+  for (std::size_t i = 1; i < num_threads; ++i)
+  {
+    pending_threads.emplace_back(thread_pool_.Dispatch(
+        [&candidates, &block, &packed, &slice_begin, i, num_lanes]() {
+          GenerateSlices(candidates[i], block.body, slice_begin(i), slice_begin(i + 1),
+                         num_lanes, packed[i]);
+        }));
+  }
 
-      thread_pool_.Dispatch([&txs, &block, i, num_threads, num_lanes]() {
-        GenerateSlices(*txs, block.body, i, num_threads, num_lanes);
-      });
-    }
+  // the current thread populates the first range
+  GenerateSlices(candidates[0], block.body, slice_begin(0), slice_begin(1), num_lanes, packed[0]);
 
-    // wait for all the threads to complete
-    thread_pool_.Wait();
+  // wait for all the threads to complete
+  for (auto &thread : pending_threads)
+  {
+    thread.get();
+  }
 
-    // return all the transactions to the main queue
-    for (std::size_t i = 0; i < num_threads; ++i)
+  // remove the packed transactions from the main queue
+  for (auto const &list : packed)
+  {
+    for (auto const &it : list)
     {
-      mining_pool_.Splice(*transaction_lists[i]);
+      mining_pool_.Erase(it);
     }
   }
 
   std::size_t const remaining_transactions = mining_pool_.size();
   std::size_t const packed_transactions    = pool_size_before - remaining_transactions;
 
+  mining_pool_size_ = remaining_transactions;
+
   FETCH_LOG_INFO(LOGGING_NAME, "Finished block packing (packed: ", packed_transactions,
                  " remaining: ", remaining_transactions, ")");
 }
@@ -200,49 +213,59 @@ void BasicMiner::GenerateBlock(Block &block, std::size_t num_lanes, std::size_t
  */
 uint64_t BasicMiner::GetBacklog() const
 {
-  FETCH_LOCK(mining_pool_lock_);
-  return mining_pool_.size();
+  return mining_pool_size_;
 }
 
 /**
- * Internal: Generate a selection of slices
+ * Internal: Generate a range of slices
  *
- * @param transactions The transaction queue to be used when generating the selection of slices
+ * @param candidates The fee ordered transactions to be used when generating the slices
  * @param block The reference to the block to populate
- * @param offset The slice index offset to start from
- * @param interval The slice index interval to be used when selecting the next slice to populate
+ * @param slice_begin The index of the first slice to populate
+ * @param slice_end The index after the last slice to populate
  * @param num_lanes The number of lanes of the block
+ * @param packed The list to which the packed transactions are added
  */
-void BasicMiner::GenerateSlices(Queue &transactions, Block::Body &block, std::size_t offset,
-                                std::size_t interval, std::size_t num_lanes)
+void BasicMiner::GenerateSlices(Candidates const &candidates, Block::Body &block,
+                                std::size_t slice_begin, std::size_t slice_end,
+                                std::size_t num_lanes, Candidates &packed)
 {
-  // sort by fees
-  transactions.Sort(SortByFee);
+  CandidateFlags used(candidates.size(), false);
+  std::size_t    first_unused{0};
 
-  for (std::size_t slice_idx = offset; slice_idx < block.slices.size(); slice_idx += interval)
+  for (std::size_t slice_idx = slice_begin; slice_idx < slice_end; ++slice_idx)
   {
     auto &slice = block.slices[slice_idx];
 
     // generate the slice
-    GenerateSlice(transactions, slice, slice_idx, num_lanes);
+    GenerateSlice(candidates, used, first_unused, slice, num_lanes, packed);
   }
 }
 
 /**
  * Internal: Generate a slice
  *
- * @param transactions The transaction queue to be used when generating the slice
+ * @param candidates The fee ordered transactions to be used when generating the slice
+ * @param used The flags marking the candidates which have already been packed
+ * @param first_unused The index of the first candidate which might not have been packed
  * @param slice The slice to be populated
- * @param slice_index The slice number
  * @param num_lanes The number of lanes for the block
+ * @param packed The list to which the packed transactions are added
  */
-void BasicMiner::GenerateSlice(Queue &transactions, Block::Slice &      slice,
-                               std::size_t /*slice_index*/, std::size_t num_lanes)
+void BasicMiner::GenerateSlice(Candidates const &candidates, CandidateFlags &used,
+                               std::size_t &first_unused, Block::Slice &slice,
+                               std::size_t num_lanes, Candidates &packed)
 {
   BitVector slice_state{num_lanes};
+  BitVector collisions{num_lanes};
 
-  auto it = transactions.begin();
-  while (it != transactions.end())
+  // skip the candidates (with the highest fees) which were packed into the previous slices
+  while ((first_unused < candidates.size()) && used[first_unused])
+  {
+    ++first_unused;
+  }
+
+  for (std::size_t i = first_unused; i < candidates.size(); ++i)
   {
     // exit the search loop once the slice is full
     if (slice_state.PopCount() == num_lanes)
@@ -250,10 +273,16 @@ void BasicMiner::GenerateSlice(Queue &transactions, Block::Slice &      slice,
       break;
     }
 
-    BitVector const &mask = it->mask();
+    if (used[i])
+    {
+      continue;
+    }
 
-    // calculate the collisions for this
-    BitVector const collisions = slice_state & mask;
+    TransactionLayout const &layout = *candidates[i];
+    BitVector const &        mask   = layout.mask();
+
+    // calculate the collisions for this (without allocating a new bit vector)
+    collisions.InlineAndAssign(slice_state, mask);
 
     // determine if there are collisions
     if (collisions.PopCount() == 0)
@@ -262,15 +291,11 @@ void BasicMiner::GenerateSlice(Queue &transactions, Block::Slice &      slice,
       slice_state |= mask;
 
       // insert the transaction into the slice
-      slice.push_back(*it);
+      slice.push_back(layout);
 
-      // remove the transaction from the main queue
-      it = transactions.Erase(it);
-    }
-    else
-    {
-      // advance to the next iterator
-      ++it;
+      // mark the transaction to be removed from the main queue
+      used[i] = true;
+      packed.push_back(candidates[i]);
     }
   }
 }
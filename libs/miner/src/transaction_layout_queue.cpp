@@ -19,6 +19,7 @@
 #include "miner/transaction_layout_queue.hpp"
 
 #include <algorithm>
+#include <utility>
 
 namespace fetch {
 namespace miner {
@@ -116,32 +117,8 @@ std::size_t TransactionLayoutQueue::Remove(DigestSet const &digests)
  */
 void TransactionLayoutQueue::Splice(TransactionLayoutQueue &other)
 {
-  // extract the queue from other queue
-  UnderlyingList input = std::move(other.list_);
-  other.digests_.clear();
-
-  // loop through the queue and filter out the duplicate entries from the main queue
-  for (auto it = input.begin(); it != input.end();)
-  {
-    bool const new_entry = digests_.find(it->digest()) == digests_.end();
-
-    if (new_entry)
-    {
-      // update this queues digest set (in anticipation for new transaction objects)
-      digests_.insert(it->digest());
-
-      // advance on to the next entry
-      ++it;
-    }
-    else
-    {
-      // remove the entry from the list
-      it = other.list_.erase(it);
-    }
-  }
-
   // splice the contents
-  list_.splice(list_.end(), std::move(input));
+  list_.splice(list_.end(), ExtractNewEntries(other));
 }
 
 void TransactionLayoutQueue::Splice(TransactionLayoutQueue &other, Iterator start, Iterator end)
@@ -201,6 +178,18 @@ void TransactionLayoutQueue::Splice(TransactionLayoutQueue &other, Iterator star
   list_.splice(list_.end(), other.list_, begin, end);
 }
 
+/**
+ * Exchange the contents of the current queue with the specified queue
+ *
+ * @param other The queue to be exchanged with
+ */
+void TransactionLayoutQueue::Swap(TransactionLayoutQueue &other)
+{
+  std::swap(log2_num_lanes_, other.log2_num_lanes_);
+  digests_.swap(other.digests_);
+  list_.swap(other.list_);
+}
+
 TransactionLayoutQueue::Iterator TransactionLayoutQueue::Erase(Iterator const &iterator)
 {
   // remove the associated digest from the set
@@ -210,5 +199,44 @@ TransactionLayoutQueue::Iterator TransactionLayoutQueue::Erase(Iterator const &i
   return list_.erase(iterator);
 }
 
+/**
+ * Internal: Extract the contents of the specified queue, ready to be added to the current queue
+ *
+ * After the operation the contents of the input queue will be zero
+ *
+ * @param other The queue to be extracted from
+ * @return The list of entries which are not already present in the current queue
+ */
+TransactionLayoutQueue::UnderlyingList TransactionLayoutQueue::ExtractNewEntries(
+    TransactionLayoutQueue &other)
+{
+  // extract the queue from other queue
+  UnderlyingList input = std::move(other.list_);
+  other.list_.clear();
+  other.digests_.clear();
+
+  // loop through the queue and filter out the duplicate entries from the main queue
+  for (auto it = input.begin(); it != input.end();)
+  {
+    bool const new_entry = digests_.find(it->digest()) == digests_.end();
+
+    if (new_entry)
+    {
+      // update this queues digest set (in anticipation for new transaction objects)
+      digests_.insert(it->digest());
+
+      // advance on to the next entry
+      ++it;
+    }
+    else
+    {
+      // remove the entry from the list
+      it = input.erase(it);
+    }
+  }
+
+  return input;
+}
+
 }  // namespace miner
 }  // namespace fetch
\ No newline at end of file
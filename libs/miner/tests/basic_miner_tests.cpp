@@ -28,6 +28,7 @@
 
 #include "gtest/gtest.h"
 
+#include <algorithm>
 #include <chrono>
 #include <fstream>
 #include <memory>
@@ -136,6 +137,38 @@ TEST_P(BasicMinerTests, SimpleExample)
   }
 }
 
+TEST_P(BasicMinerTests, PacksHighestFeeFirstAndUpdatesBacklog)
+{
+  std::size_t const num_tx = GetParam();
+
+  PopulateWithTransactions(num_tx);
+
+  Block     block;
+  MainChain dummy{MainChain::Mode::IN_MEMORY_DB};
+
+  block.body.previous_hash = dummy.GetHeaviestBlockHash();
+
+  miner_->GenerateBlock(block, NUM_LANES, NUM_SLICES, dummy);
+
+  ASSERT_EQ(block.body.slices.size(), std::size_t{NUM_SLICES});
+  ASSERT_FALSE(block.body.slices[0].empty());
+
+  // the generator increases the charge of every transaction, so the last one is the most valuable
+  uint64_t    max_charge{0};
+  std::size_t num_packed{0};
+  for (auto const &slice : block.body.slices)
+  {
+    for (auto const &tx : slice)
+    {
+      max_charge = std::max(max_charge, tx.charge());
+      ++num_packed;
+    }
+  }
+
+  EXPECT_EQ(block.body.slices[0].front().charge(), max_charge);
+  EXPECT_EQ(miner_->GetBacklog(), num_tx - num_packed);
+}
+
 TEST_P(BasicMinerTests, RejectReplayedTransactions)
 {
   std::size_t const num_tx = GetParam();
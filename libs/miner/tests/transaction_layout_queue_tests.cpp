@@ -298,6 +298,71 @@ TEST_F(TransactionLayoutQueueTests, CheckSorting)
   EXPECT_EQ((it++)->digest(), tx1.digest());
 }
 
+TEST_F(TransactionLayoutQueueTests, CheckMerge)
+{
+  auto const by_charge = [](auto const &a, auto const &b) { return a.charge() > b.charge(); };
+
+  // generate a series of transactions
+  auto const tx1 = generator_(2);
+  auto const tx2 = generator_(2);
+  auto const tx3 = generator_(2);
+  auto const tx4 = generator_(2);
+  auto const tx5 = generator_(2);
+
+  // create a sorted queue
+  EXPECT_TRUE(queue_->Add(tx2));
+  EXPECT_TRUE(queue_->Add(tx4));
+  queue_->Sort(by_charge);
+
+  // create an unsorted queue which contains a duplicate
+  TransactionLayoutQueue other{1};
+  EXPECT_TRUE(other.Add(tx1));
+  EXPECT_TRUE(other.Add(tx5));
+  EXPECT_TRUE(other.Add(tx4));
+  EXPECT_TRUE(other.Add(tx3));
+
+  queue_->Merge(other, by_charge);
+
+  EXPECT_EQ(other.size(), 0u);
+  EXPECT_TRUE(other.empty());
+  ASSERT_EQ(queue_->size(), 5u);
+
+  auto it = queue_->cbegin();
+  EXPECT_EQ((it++)->digest(), tx5.digest());
+  EXPECT_EQ((it++)->digest(), tx4.digest());
+  EXPECT_EQ((it++)->digest(), tx3.digest());
+  EXPECT_EQ((it++)->digest(), tx2.digest());
+  EXPECT_EQ((it++)->digest(), tx1.digest());
+  EXPECT_EQ(it, queue_->cend());
+}
+
+TEST_F(TransactionLayoutQueueTests, CheckSwap)
+{
+  // generate a series of transactions
+  auto const tx1 = generator_(2);
+  auto const tx2 = generator_(2);
+  auto const tx3 = generator_(2);
+
+  EXPECT_TRUE(queue_->Add(tx1));
+  EXPECT_TRUE(queue_->Add(tx2));
+
+  TransactionLayoutQueue other{1};
+  EXPECT_TRUE(other.Add(tx3));
+
+  queue_->Swap(other);
+
+  ASSERT_EQ(queue_->size(), 1u);
+  ASSERT_EQ(other.size(), 2u);
+
+  EXPECT_TRUE(IsIn(*queue_, tx3));
+  EXPECT_TRUE(IsIn(other, tx1));
+  EXPECT_TRUE(IsIn(other, tx2));
+
+  // the digests are exchanged along with the contents
+  EXPECT_FALSE(queue_->Add(tx3));
+  EXPECT_TRUE(queue_->Add(tx1));
+}
+
 TEST_F(TransactionLayoutQueueTests, CheckSubSplicing)
 {
   // generate a series of transactions
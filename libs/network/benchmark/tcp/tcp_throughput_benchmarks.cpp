@@ -0,0 +1,129 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "network/management/network_manager.hpp"
+#include "network/tcp/loopback_server.hpp"
+#include "network/tcp/tcp_client.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+namespace {
+
+using fetch::network::LoopbackServer;
+using fetch::network::NetworkManager;
+using fetch::network::TCPClient;
+using fetch::network::message_type;
+
+constexpr uint16_t    PORT        = 9110;
+constexpr std::size_t NUM_THREADS = 2;
+
+/**
+ * Client which counts the messages echoed back by the loopback server
+ */
+class CountingClient : public TCPClient
+{
+public:
+  explicit CountingClient(NetworkManager &network_manager)
+    : TCPClient(network_manager)
+  {
+    OnMessage([this](message_type const &) { ++received_; });
+  }
+
+  ~CountingClient()
+  {
+    TCPClient::Cleanup();
+  }
+
+  std::atomic<std::size_t> received_{0};
+};
+
+/**
+ * Measure the throughput of a client sending a burst of messages to an echo server and waiting
+ * for all of the responses
+ *
+ * Arguments: message size (bytes), number of messages per burst
+ */
+void Tcp_LoopbackThroughput(benchmark::State &state)
+{
+  auto const message_size = static_cast<std::size_t>(state.range(0));
+  auto const num_messages = static_cast<std::size_t>(state.range(1));
+
+  NetworkManager network_manager{"Bench", NUM_THREADS};
+  network_manager.Start();
+
+  LoopbackServer server{PORT};
+
+  {
+    CountingClient client{network_manager};
+    client.Connect("localhost", PORT);
+
+    if (!client.WaitForAlive(2000))
+    {
+      state.SkipWithError("Unable to connect to the loopback server");
+      network_manager.Stop();
+      return;
+    }
+
+    message_type message;
+    message.Resize(message_size);
+    for (std::size_t i = 0; i < message_size; ++i)
+    {
+      message[i] = static_cast<uint8_t>(i);
+    }
+
+    std::size_t expected{0};
+    for (auto _ : state)
+    {
+      for (std::size_t i = 0; i < num_messages; ++i)
+      {
+        client.Send(message);
+      }
+
+      expected += num_messages;
+      while (client.received_ < expected)
+      {
+        std::this_thread::yield();
+      }
+    }
+
+    auto const stats = client.write_statistics();
+
+    state.SetBytesProcessed(
+        static_cast<int64_t>(state.iterations() * num_messages * message_size));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * num_messages));
+    state.counters["msgs_per_write"] = stats.messages_per_write();
+  }
+
+  network_manager.Stop();
+}
+
+}  // namespace
+
+BENCHMARK(Tcp_LoopbackThroughput)
+    ->Args({64, 1})
+    ->Args({64, 100})
+    ->Args({64, 1000})
+    ->Args({1024, 100})
+    ->Args({65536, 100})
+    ->UseRealTime();
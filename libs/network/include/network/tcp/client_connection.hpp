@@ -25,10 +25,12 @@
 #include "network/management/client_manager.hpp"
 #include "network/management/network_manager.hpp"
 #include "network/message.hpp"
+#include "network/tcp/write_coalescer.hpp"
 
 #include "network/fetch_asio.hpp"
 #include <atomic>
 #include <utility>
+#include <vector>
 
 namespace fetch {
 namespace network {
@@ -126,10 +128,7 @@ public:
       return;
     }
 
-    {
-      std::lock_guard<mutex_type> lock(queue_mutex_);
-      write_queue_.push_back(msg);
-    }
+    write_queue_.Push(msg);
 
     std::weak_ptr<AbstractConnection> self   = shared_from_this();
     std::weak_ptr<Strand>             strand = strand_;
@@ -177,7 +176,30 @@ public:
     // state DISCONNECTED->CONNECTED->DROPPED
   }
 
+  /**
+   * Set the maximum number of bytes to be coalesced into a single write
+   *
+   * @param max_bytes The byte budget for each write
+   */
+  void SetMaxWriteBatchBytes(std::size_t max_bytes)
+  {
+    write_queue_.SetMaxBatchBytes(max_bytes);
+  }
+
+  /**
+   * Get the write statistics for this connection
+   *
+   * @return The statistics
+   */
+  WriteStatistics write_statistics() const
+  {
+    return write_queue_.statistics();
+  }
+
 private:
+  using WriteBatch = WriteCoalescer::Batch;
+  using BufferList = std::vector<asio::const_buffer>;
+
   std::atomic<bool>                         shutting_down_{false};
   std::weak_ptr<asio::ip::tcp::tcp::socket> socket_;
   std::weak_ptr<ClientManager>              manager_;
@@ -188,13 +210,9 @@ private:
   // bool                  posted_close_ = false;
   std::weak_ptr<Strand> strand_;
 
-  message_queue_type write_queue_;
-  mutable mutex_type can_write_mutex_;
-  bool               can_write_{true};
-  mutable mutex_type queue_mutex_;
-
-  // TODO(issue 17): put this in shared class
-  static const uint64_t networkMagic_ = 0xFE7C80A1FE7C80A1;
+  WriteCoalescer write_queue_;
+  WriteBatch     write_batch_;    ///< The batch in flight (only accessed on the strand)
+  BufferList     write_buffers_;  ///< The buffers of the batch in flight (only on the strand)
 
   // TODO(issue 17): fix this to be self-contained
   union
@@ -263,7 +281,7 @@ private:
 
     byte_array::ByteArray message;
 
-    if (header_.content.magic != networkMagic_)
+    if (header_.content.magic != WriteCoalescer::NETWORK_MAGIC)
     {
       FETCH_LOG_DEBUG(LOGGING_NAME, "Magic incorrect - closing connection.");
       auto ptr = manager_.lock();
@@ -303,66 +321,27 @@ private:
     asio::async_read(*socket_ptr, asio::buffer(message.pointer(), message.size()), cb);
   }
 
-  static void SetHeader(byte_array::ByteArray &header, uint64_t bufSize)
-  {
-    header.Resize(16);
-
-    for (std::size_t i = 0; i < 8; ++i)
-    {
-      header[i] = uint8_t((networkMagic_ >> i * 8) & 0xff);
-    }
-
-    for (std::size_t i = 0; i < 8; ++i)
-    {
-      header[i + 8] = uint8_t((bufSize >> i * 8) & 0xff);
-    }
-  }
-
   // Always executed in a run(), in a strand
   void WriteNext(shared_self_type selfLock)
   {
-    // Only one thread can get past here at a time. Effectively a try_lock
-    // except that we can't unlock a mutex in the callback (undefined behaviour)
-    {
-      std::lock_guard<mutex_type> lock(can_write_mutex_);
-      if (can_write_)
-      {
-        can_write_ = false;
-      }
-      else
-      {
-        return;
-      }
-    }
-
-    message_type buffer;
+    // Only one batch can be in flight at a time, all the messages queued in the meantime are
+    // coalesced into the next one
+    if (!write_queue_.BeginWrite(write_batch_))
     {
-      std::lock_guard<mutex_type> lock(queue_mutex_);
-      if (write_queue_.empty())
-      {
-        std::lock_guard<mutex_type> lock(can_write_mutex_);
-        can_write_ = true;
-        return;
-      }
-      buffer = write_queue_.front();
-      write_queue_.pop_front();
+      return;
     }
 
-    byte_array::ByteArray header;
-    SetHeader(header, buffer.size());
-
-    std::vector<asio::const_buffer> buffers{asio::buffer(header.pointer(), header.size()),
-                                            asio::buffer(buffer.pointer(), buffer.size())};
+    write_buffers_.clear();
+    write_batch_.VisitBuffers([this](void const *data, std::size_t size) {
+      write_buffers_.emplace_back(asio::buffer(data, size));
+    });
 
     auto socket = socket_.lock();
 
-    auto cb = [this, selfLock, socket, buffer, header](std::error_code ec, std::size_t len) {
+    auto cb = [this, selfLock, socket](std::error_code ec, std::size_t len) {
       FETCH_UNUSED(len);
 
-      {
-        std::lock_guard<mutex_type> lock(can_write_mutex_);
-        can_write_ = true;
-      }
+      write_queue_.CompleteWrite(write_batch_, !ec);
 
       if (ec)
       {
@@ -385,11 +364,12 @@ private:
     if (socket && strand)
     {
       assert(strand->running_in_this_thread());
-      asio::async_write(*socket, buffers, strand->wrap(cb));
+      asio::async_write(*socket, write_buffers_, strand->wrap(cb));
     }
     else
     {
       FETCH_LOG_ERROR(LOGGING_NAME, "Failed to lock socket in WriteNext!");
+      write_queue_.CompleteWrite(write_batch_, false);
       SignalLeave();
     }
   }
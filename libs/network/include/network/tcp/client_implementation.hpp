@@ -29,11 +29,13 @@
 #include "core/mutex.hpp"
 #include "network/fetch_asio.hpp"
 #include "network/management/abstract_connection.hpp"
+#include "network/tcp/write_coalescer.hpp"
 
 #include <atomic>
 #include <memory>
 #include <mutex>
 #include <utility>
+#include <vector>
 
 namespace fetch {
 namespace network {
@@ -192,10 +194,7 @@ public:
       return;
     }
 
-    {
-      std::lock_guard<mutex_type> lock(queue_mutex_);
-      write_queue_.push_back(msg);
-    }
+    write_queue_.Push(msg);
 
     self_type                  self   = shared_from_this();
     std::weak_ptr<strand_type> strand = strand_;
@@ -246,7 +245,30 @@ public:
     return socket_.expired();
   }
 
+  /**
+   * Set the maximum number of bytes to be coalesced into a single write
+   *
+   * @param max_bytes The byte budget for each write
+   */
+  void SetMaxWriteBatchBytes(std::size_t max_bytes)
+  {
+    write_queue_.SetMaxBatchBytes(max_bytes);
+  }
+
+  /**
+   * Get the write statistics for this connection
+   *
+   * @return The statistics
+   */
+  WriteStatistics write_statistics() const
+  {
+    return write_queue_.statistics();
+  }
+
 private:
+  using WriteBatch = WriteCoalescer::Batch;
+  using BufferList = std::vector<asio::const_buffer>;
+
   static const uint64_t networkMagic_ = 0xFE7C80A1FE7C80A1;
 
   network_manager_type networkManager_;
@@ -255,13 +277,12 @@ private:
   std::weak_ptr<socket_type> socket_;
   std::weak_ptr<strand_type> strand_;
 
-  message_queue_type write_queue_;
-  mutable mutex_type queue_mutex_;
+  WriteCoalescer     write_queue_;
+  WriteBatch         write_batch_;    ///< The batch in flight (only accessed on the strand)
+  BufferList         write_buffers_;  ///< The buffers of the batch in flight (only on the strand)
   mutable mutex_type io_creation_mutex_;
 
-  mutable mutex_type can_write_mutex_;
-  bool               can_write_{true};
-  bool               posted_close_ = false;
+  bool posted_close_ = false;
 
   mutable mutex_type callback_mutex_;
   std::atomic<bool>  connected_{false};
@@ -399,48 +420,24 @@ private:
   // Always executed in a run(), in a strand
   void WriteNext(shared_self_type selfLock)
   {
-    // Only one thread can get past here at a time. Effectively a try_lock
-    // except that we can't unlock a mutex in the callback (undefined behaviour)
+    // Only one batch can be in flight at a time, all the messages queued in the meantime are
+    // coalesced into the next one
+    if (!write_queue_.BeginWrite(write_batch_))
     {
-      std::lock_guard<mutex_type> lock(can_write_mutex_);
-      if (can_write_)
-      {
-        can_write_ = false;
-      }
-      else
-      {
-        return;
-      }
-    }
-
-    message_type buffer;
-    {
-      std::lock_guard<mutex_type> lock(queue_mutex_);
-      if (write_queue_.empty())
-      {
-        std::lock_guard<mutex_type> lock(can_write_mutex_);
-        can_write_ = true;
-        return;
-      }
-      buffer = write_queue_.front();
-      write_queue_.pop_front();
+      return;
     }
 
-    byte_array::ByteArray header;
-    SetHeader(header, buffer.size());
-
-    std::vector<asio::const_buffer> buffers{asio::buffer(header.pointer(), header.size()),
-                                            asio::buffer(buffer.pointer(), buffer.size())};
+    write_buffers_.clear();
+    write_batch_.VisitBuffers([this](void const *data, std::size_t size) {
+      write_buffers_.emplace_back(asio::buffer(data, size));
+    });
 
     auto socket = socket_.lock();
 
-    auto cb = [this, selfLock, socket, buffer, header](std::error_code ec, std::size_t len) {
+    auto cb = [this, selfLock, socket](std::error_code ec, std::size_t len) {
       FETCH_UNUSED(len);
 
-      {
-        std::lock_guard<mutex_type> lock(can_write_mutex_);
-        can_write_ = true;
-      }
+      write_queue_.CompleteWrite(write_batch_, !ec);
 
       if (ec)
       {
@@ -463,11 +460,12 @@ private:
     if (socket && strand)
     {
       assert(strand->running_in_this_thread());
-      asio::async_write(*socket, buffers, strand->wrap(cb));
+      asio::async_write(*socket, write_buffers_, strand->wrap(cb));
     }
     else
     {
       FETCH_LOG_ERROR(LOGGING_NAME, "Failed to lock socket in WriteNext!");
+      write_queue_.CompleteWrite(write_batch_, false);
       SignalLeave();
     }
   }
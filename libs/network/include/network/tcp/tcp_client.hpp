@@ -128,6 +128,16 @@ public:
     return pointer_->is_alive();
   }
 
+  void SetMaxWriteBatchBytes(std::size_t max_bytes)
+  {
+    pointer_->SetMaxWriteBatchBytes(max_bytes);
+  }
+
+  WriteStatistics write_statistics() const
+  {
+    return pointer_->write_statistics();
+  }
+
   typename implementation_type::weak_ptr_type connection_pointer()
   {
     return pointer_->connection_pointer();
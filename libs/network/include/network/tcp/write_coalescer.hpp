@@ -0,0 +1,166 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "network/message.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace fetch {
+namespace network {
+
+/**
+ * The write statistics of a connection
+ */
+struct WriteStatistics
+{
+  uint64_t bytes{0};     ///< The total number of bytes written (including the headers)
+  uint64_t writes{0};    ///< The number of write operations
+  uint64_t messages{0};  ///< The number of messages written
+
+  double messages_per_write() const
+  {
+    return (writes == 0) ? 0.0 : static_cast<double>(messages) / static_cast<double>(writes);
+  }
+};
+
+/**
+ * The outgoing message queue of a connection
+ *
+ * Rather than writing one message at a time, all of the queued messages (up to a byte budget) are
+ * collected into a batch that is sent with a single vectored write. The batch, including the
+ * storage for the message headers, is reused between writes so that the steady state does not
+ * allocate per message.
+ *
+ * Only one batch can be in flight at any point in time.
+ */
+class WriteCoalescer
+{
+public:
+  static constexpr uint64_t    NETWORK_MAGIC           = 0xFE7C80A1FE7C80A1;
+  static constexpr std::size_t HEADER_SIZE             = 2 * sizeof(uint64_t);
+  static constexpr std::size_t DEFAULT_MAX_BATCH_BYTES = 256 * 1024;
+
+  using Header = std::array<uint8_t, HEADER_SIZE>;
+
+  /**
+   * The set of messages (and their headers) to be sent in a single write
+   */
+  class Batch
+  {
+  public:
+    std::size_t size() const;
+    bool        empty() const;
+    std::size_t size_in_bytes() const;
+
+    template <typename Visitor>
+    void VisitBuffers(Visitor &&visitor) const;
+
+  private:
+    using HeaderList  = std::vector<Header>;
+    using MessageList = std::vector<message_type>;
+
+    void Clear();
+
+    HeaderList  headers_;
+    MessageList messages_;
+    std::size_t size_in_bytes_{0};
+
+    friend class WriteCoalescer;
+  };
+
+  // Construction / Destruction
+  explicit WriteCoalescer(std::size_t max_batch_bytes = DEFAULT_MAX_BATCH_BYTES);
+  WriteCoalescer(WriteCoalescer const &) = delete;
+  WriteCoalescer(WriteCoalescer &&)      = delete;
+  ~WriteCoalescer()                      = default;
+
+  /// @name Message Queue
+  /// @{
+  void        Push(message_type const &message);
+  bool        BeginWrite(Batch &batch);
+  void        CompleteWrite(Batch &batch, bool success);
+  std::size_t queue_size() const;
+  /// @}
+
+  /// @name Configuration & Statistics
+  /// @{
+  void            SetMaxBatchBytes(std::size_t max_batch_bytes);
+  std::size_t     max_batch_bytes() const;
+  WriteStatistics statistics() const;
+  /// @}
+
+  static void SetHeader(Header &header, uint64_t size);
+
+  // Operators
+  WriteCoalescer &operator=(WriteCoalescer const &) = delete;
+  WriteCoalescer &operator=(WriteCoalescer &&) = delete;
+
+private:
+  using Mutex         = std::mutex;
+  using AtomicSize    = std::atomic<std::size_t>;
+  using AtomicCounter = std::atomic<uint64_t>;
+
+  mutable Mutex      lock_;             ///< Protects the queue and the writing flag
+  message_queue_type queue_;            ///< The messages waiting to be written
+  bool               writing_{false};   ///< Flag to signal a batch is in flight
+  AtomicSize         max_batch_bytes_;  ///< The byte budget for each batch
+
+  AtomicCounter total_bytes_{0};
+  AtomicCounter total_writes_{0};
+  AtomicCounter total_messages_{0};
+};
+
+/**
+ * Visit each of the buffers of the batch, in the order they should be written
+ *
+ * @tparam Visitor The type of the visitor
+ * @param visitor The visitor to be called with a pointer to and size of each buffer
+ */
+template <typename Visitor>
+void WriteCoalescer::Batch::VisitBuffers(Visitor &&visitor) const
+{
+  for (std::size_t i = 0; i < messages_.size(); ++i)
+  {
+    visitor(static_cast<void const *>(headers_[i].data()), headers_[i].size());
+    visitor(static_cast<void const *>(messages_[i].pointer()), messages_[i].size());
+  }
+}
+
+inline std::size_t WriteCoalescer::Batch::size() const
+{
+  return messages_.size();
+}
+
+inline bool WriteCoalescer::Batch::empty() const
+{
+  return messages_.empty();
+}
+
+inline std::size_t WriteCoalescer::Batch::size_in_bytes() const
+{
+  return size_in_bytes_;
+}
+
+}  // namespace network
+}  // namespace fetch
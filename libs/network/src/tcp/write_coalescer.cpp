@@ -0,0 +1,191 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "network/tcp/write_coalescer.hpp"
+
+#include <utility>
+
+namespace fetch {
+namespace network {
+
+constexpr uint64_t    WriteCoalescer::NETWORK_MAGIC;
+constexpr std::size_t WriteCoalescer::HEADER_SIZE;
+constexpr std::size_t WriteCoalescer::DEFAULT_MAX_BATCH_BYTES;
+
+/**
+ * Construct the write coalescer
+ *
+ * @param max_batch_bytes The maximum number of bytes to be sent in each write. A batch always
+ * contains at least one message, regardless of its size.
+ */
+WriteCoalescer::WriteCoalescer(std::size_t max_batch_bytes)
+  : max_batch_bytes_{max_batch_bytes}
+{}
+
+/**
+ * Add a message to the queue
+ *
+ * @param message The message to be sent
+ */
+void WriteCoalescer::Push(message_type const &message)
+{
+  std::lock_guard<Mutex> lock(lock_);
+  queue_.push_back(message);
+}
+
+/**
+ * Collect the queued messages into a batch to be written. Only one batch can be in flight at any
+ * point in time, so this fails if the previous batch has not been completed.
+ *
+ * @param batch The (previously completed or new) batch to be populated
+ * @return true if a batch has been populated and needs to be written, otherwise false
+ */
+bool WriteCoalescer::BeginWrite(Batch &batch)
+{
+  std::size_t const max_batch_bytes = max_batch_bytes_;
+
+  std::lock_guard<Mutex> lock(lock_);
+
+  if (writing_ || queue_.empty())
+  {
+    return false;
+  }
+
+  batch.Clear();
+
+  while (!queue_.empty())
+  {
+    std::size_t const message_bytes = HEADER_SIZE + queue_.front().size();
+
+    // always send at least one message, regardless of the budget
+    if (!batch.empty() && ((batch.size_in_bytes_ + message_bytes) > max_batch_bytes))
+    {
+      break;
+    }
+
+    Header header;
+    SetHeader(header, queue_.front().size());
+
+    batch.headers_.push_back(header);
+    batch.messages_.emplace_back(std::move(queue_.front()));
+    batch.size_in_bytes_ += message_bytes;
+
+    queue_.pop_front();
+  }
+
+  writing_ = true;
+
+  return true;
+}
+
+/**
+ * Signal that the write of a batch has completed, allowing the next batch to be written
+ *
+ * @param batch The batch that has been written
+ * @param success Flag to signal the write was successful
+ */
+void WriteCoalescer::CompleteWrite(Batch &batch, bool success)
+{
+  if (success)
+  {
+    total_bytes_ += batch.size_in_bytes();
+    total_messages_ += batch.size();
+    ++total_writes_;
+  }
+
+  // release the messages, but retain the storage for the next batch
+  batch.Clear();
+
+  std::lock_guard<Mutex> lock(lock_);
+  writing_ = false;
+}
+
+/**
+ * Get the number of messages waiting to be written
+ *
+ * @return The number of messages
+ */
+std::size_t WriteCoalescer::queue_size() const
+{
+  std::lock_guard<Mutex> lock(lock_);
+  return queue_.size();
+}
+
+/**
+ * Update the maximum number of bytes to be sent in each write
+ *
+ * @param max_batch_bytes The new byte budget
+ */
+void WriteCoalescer::SetMaxBatchBytes(std::size_t max_batch_bytes)
+{
+  max_batch_bytes_ = max_batch_bytes;
+}
+
+/**
+ * Get the maximum number of bytes to be sent in each write
+ *
+ * @return The byte budget
+ */
+std::size_t WriteCoalescer::max_batch_bytes() const
+{
+  return max_batch_bytes_;
+}
+
+/**
+ * Get the write statistics
+ *
+ * @return The statistics
+ */
+WriteStatistics WriteCoalescer::statistics() const
+{
+  WriteStatistics stats;
+  stats.bytes    = total_bytes_;
+  stats.writes   = total_writes_;
+  stats.messages = total_messages_;
+
+  return stats;
+}
+
+/**
+ * Populate a message header (the network magic followed by the size of the message, both little
+ * endian)
+ *
+ * @param header The header to be populated
+ * @param size The size of the message
+ */
+void WriteCoalescer::SetHeader(Header &header, uint64_t size)
+{
+  for (std::size_t i = 0; i < sizeof(uint64_t); ++i)
+  {
+    header[i]                    = uint8_t((NETWORK_MAGIC >> (i * 8)) & 0xff);
+    header[i + sizeof(uint64_t)] = uint8_t((size >> (i * 8)) & 0xff);
+  }
+}
+
+/**
+ * Internal: Release the messages of the batch, retaining the storage
+ */
+void WriteCoalescer::Batch::Clear()
+{
+  headers_.clear();
+  messages_.clear();
+  size_in_bytes_ = 0;
+}
+
+}  // namespace network
+}  // namespace fetch
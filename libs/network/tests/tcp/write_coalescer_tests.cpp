@@ -0,0 +1,188 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "network/tcp/write_coalescer.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+using fetch::network::WriteCoalescer;
+using fetch::network::message_type;
+
+using Batch  = WriteCoalescer::Batch;
+using Buffer = std::vector<uint8_t>;
+
+message_type CreateMessage(std::size_t size, uint8_t value)
+{
+  message_type message;
+  message.Resize(size);
+
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    message[i] = value;
+  }
+
+  return message;
+}
+
+/**
+ * Flatten the buffers of the batch into the stream of bytes that would be written to the socket
+ */
+Buffer Flatten(Batch const &batch)
+{
+  Buffer stream;
+  batch.VisitBuffers([&stream](void const *data, std::size_t size) {
+    auto const *bytes = static_cast<uint8_t const *>(data);
+    stream.insert(stream.end(), bytes, bytes + size);
+  });
+
+  return stream;
+}
+
+uint64_t ReadUint64(Buffer const &stream, std::size_t offset)
+{
+  uint64_t value{0};
+  for (std::size_t i = 0; i < sizeof(uint64_t); ++i)
+  {
+    value |= static_cast<uint64_t>(stream[offset + i]) << (i * 8);
+  }
+
+  return value;
+}
+
+TEST(WriteCoalescerTests, QueuedMessagesAreCoalescedIntoASingleWrite)
+{
+  WriteCoalescer coalescer;
+  Batch          batch;
+
+  EXPECT_FALSE(coalescer.BeginWrite(batch));
+
+  for (uint8_t i = 1; i <= 5; ++i)
+  {
+    coalescer.Push(CreateMessage(i * 10u, i));
+  }
+
+  ASSERT_TRUE(coalescer.BeginWrite(batch));
+  EXPECT_EQ(batch.size(), 5u);
+  EXPECT_EQ(coalescer.queue_size(), 0u);
+
+  // the stream must be the same as the messages written one at a time
+  Buffer const stream = Flatten(batch);
+  ASSERT_EQ(stream.size(), batch.size_in_bytes());
+  ASSERT_EQ(stream.size(), (5 * WriteCoalescer::HEADER_SIZE) + 150u);
+
+  std::size_t offset{0};
+  for (uint8_t i = 1; i <= 5; ++i)
+  {
+    std::size_t const size = i * 10u;
+
+    EXPECT_EQ(ReadUint64(stream, offset), WriteCoalescer::NETWORK_MAGIC);
+    EXPECT_EQ(ReadUint64(stream, offset + sizeof(uint64_t)), size);
+    offset += WriteCoalescer::HEADER_SIZE;
+
+    for (std::size_t j = 0; j < size; ++j)
+    {
+      ASSERT_EQ(stream[offset + j], i);
+    }
+    offset += size;
+  }
+
+  coalescer.CompleteWrite(batch, true);
+  EXPECT_TRUE(batch.empty());
+
+  auto const stats = coalescer.statistics();
+  EXPECT_EQ(stats.writes, 1u);
+  EXPECT_EQ(stats.messages, 5u);
+  EXPECT_EQ(stats.bytes, stream.size());
+  EXPECT_DOUBLE_EQ(stats.messages_per_write(), 5.0);
+}
+
+TEST(WriteCoalescerTests, OnlyOneBatchIsInFlight)
+{
+  WriteCoalescer coalescer;
+  Batch          batch;
+  Batch          other;
+
+  coalescer.Push(CreateMessage(8, 1));
+  ASSERT_TRUE(coalescer.BeginWrite(batch));
+
+  // messages queued while writing are held back until the write completes
+  coalescer.Push(CreateMessage(8, 2));
+  coalescer.Push(CreateMessage(8, 3));
+  EXPECT_FALSE(coalescer.BeginWrite(other));
+  EXPECT_EQ(coalescer.queue_size(), 2u);
+
+  // failed writes are not counted, but still release the queue
+  coalescer.CompleteWrite(batch, false);
+  EXPECT_EQ(coalescer.statistics().writes, 0u);
+
+  ASSERT_TRUE(coalescer.BeginWrite(batch));
+  EXPECT_EQ(batch.size(), 2u);
+  coalescer.CompleteWrite(batch, true);
+
+  EXPECT_FALSE(coalescer.BeginWrite(batch));
+  EXPECT_EQ(coalescer.statistics().messages, 2u);
+}
+
+TEST(WriteCoalescerTests, BatchesAreLimitedByTheByteBudget)
+{
+  static constexpr std::size_t MESSAGE_SIZE  = 100;
+  static constexpr std::size_t MESSAGE_BYTES = MESSAGE_SIZE + WriteCoalescer::HEADER_SIZE;
+
+  WriteCoalescer coalescer{3 * MESSAGE_BYTES};
+  Batch          batch;
+
+  for (std::size_t i = 0; i < 7; ++i)
+  {
+    coalescer.Push(CreateMessage(MESSAGE_SIZE, 0));
+  }
+
+  std::vector<std::size_t> batch_sizes;
+  while (coalescer.BeginWrite(batch))
+  {
+    EXPECT_LE(batch.size_in_bytes(), coalescer.max_batch_bytes());
+    batch_sizes.push_back(batch.size());
+    coalescer.CompleteWrite(batch, true);
+  }
+
+  EXPECT_EQ(batch_sizes, (std::vector<std::size_t>{3, 3, 1}));
+  EXPECT_EQ(coalescer.statistics().writes, 3u);
+
+  // messages larger than the budget are still sent, one at a time
+  coalescer.SetMaxBatchBytes(1);
+  coalescer.Push(CreateMessage(MESSAGE_SIZE, 0));
+  coalescer.Push(CreateMessage(MESSAGE_SIZE, 0));
+
+  ASSERT_TRUE(coalescer.BeginWrite(batch));
+  EXPECT_EQ(batch.size(), 1u);
+  coalescer.CompleteWrite(batch, true);
+
+  ASSERT_TRUE(coalescer.BeginWrite(batch));
+  EXPECT_EQ(batch.size(), 1u);
+  coalescer.CompleteWrite(batch, true);
+
+  EXPECT_EQ(coalescer.queue_size(), 0u);
+}
+
+}  // namespace
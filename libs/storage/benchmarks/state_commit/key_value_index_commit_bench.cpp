@@ -0,0 +1,110 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/random/lfg.hpp"
+#include "storage/key_value_index.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+using fetch::byte_array::ByteArray;
+using fetch::storage::KeyValueIndex;
+using fetch::storage::KeyValuePair;
+using fetch::storage::RandomAccessStack;
+using fetch::random::LaggedFibonacciGenerator;
+
+using KeyValueIndexType = KeyValueIndex<KeyValuePair<>, RandomAccessStack<KeyValuePair<>>>;
+using KeyList           = std::vector<ByteArray>;
+
+namespace {
+
+KeyList GenerateKeys(std::size_t count)
+{
+  LaggedFibonacciGenerator<> lfg;
+
+  KeyList keys;
+  keys.reserve(count);
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    ByteArray key;
+    key.Resize(256 / 8);
+    for (std::size_t j = 0; j < key.size(); ++j)
+    {
+      key[j] = uint8_t(lfg() >> 9);
+    }
+
+    keys.push_back(key);
+  }
+
+  return keys;
+}
+
+/**
+ * Emulates the commit of a block: a number of keys are updated in an existing state and then the
+ * new state root is calculated
+ */
+void KeyValueIndexCommit(benchmark::State &state, bool batch_mode)
+{
+  auto const num_updates = static_cast<std::size_t>(state.range(0));
+  auto const keys        = GenerateKeys(100000);
+  auto const updates     = GenerateKeys(num_updates);
+
+  KeyValueIndexType index;
+  index.New("state_commit_bench.db");
+
+  for (std::size_t i = 0; i < keys.size(); ++i)
+  {
+    index.Set(keys[i], i, keys[i]);
+  }
+  index.Hash();
+
+  index.SetBatchMode(batch_mode);
+
+  uint64_t value = 0;
+  for (auto _ : state)
+  {
+    for (auto const &key : updates)
+    {
+      index.Set(key, value++, key);
+    }
+
+    benchmark::DoNotOptimize(index.Hash());
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(num_updates));
+}
+
+void KeyValueIndexCommit_Immediate(benchmark::State &state)
+{
+  KeyValueIndexCommit(state, false);
+}
+
+void KeyValueIndexCommit_Batched(benchmark::State &state)
+{
+  KeyValueIndexCommit(state, true);
+}
+
+}  // namespace
+
+BENCHMARK(KeyValueIndexCommit_Immediate)->Range(100, 10000)->Unit(benchmark::kMillisecond);
+BENCHMARK(KeyValueIndexCommit_Batched)->Range(100, 10000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
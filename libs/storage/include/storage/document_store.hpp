@@ -236,6 +236,16 @@ public:
       return self_->file_object_.AsDocument();
     }
 
+    /**
+     * Get the key of the current element, without reading the document
+     *
+     * @return: the key (the identifier of the resource)
+     */
+    byte_array::ConstByteArray GetKey() const
+    {
+      return (*wrapped_iterator_).first;
+    }
+
   protected:
     typename key_value_index_type::Iterator wrapped_iterator_;
     self_type *                             self_;
@@ -63,15 +63,19 @@
 #include "storage/random_access_stack.hpp"
 #include "storage/storage_exception.hpp"
 #include "storage/versioned_random_access_stack.hpp"
+#include "vectorise/threading/parallel_for.hpp"
 
+#include <algorithm>
 #include <cstring>
 #include <deque>
 #include <queue>
 #include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace fetch {
 namespace storage {
-
 /**
  * Key value pair for binary tries where the key is a byte array. The tree can
  * be traversed given a key by switching on the split until the leaf or its nearest equivalent is
@@ -145,6 +149,38 @@ struct KeyValuePair
     return true;
   }
 
+  /**
+   * Recalculate the hashes of a set of independent nodes as a single batch. Equivalent to calling
+   * UpdateNode on each of the nodes, however the nodes are hashed in parallel where the CPU allows
+   *
+   * @param nodes The nodes to be updated
+   * @param lefts The left children of the nodes
+   * @param rights The right children of the nodes
+   * @param count The number of nodes
+   */
+  static void UpdateNodes(KeyValuePair *nodes, KeyValuePair const *lefts,
+                          KeyValuePair const *rights, std::size_t count)
+  {
+    static constexpr std::size_t MESSAGE_SIZE = 2 * N;
+
+    std::vector<uint8_t>                 messages(count * MESSAGE_SIZE);
+    std::vector<HashFunction::BatchItem> items(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      uint8_t *message = messages.data() + (i * MESSAGE_SIZE);
+
+      memcpy(message, rights[i].hash, N);
+      memcpy(message + N, lefts[i].hash, N);
+
+      items[i].data   = message;
+      items[i].size   = MESSAGE_SIZE;
+      items[i].digest = nodes[i].hash;
+    }
+
+    HashFunction::HashBatch(items.data(), count);
+  }
+
   byte_array::ByteArray Hash() const
   {
     return {hash, N};
@@ -160,24 +196,6 @@ struct KeyValuePair
 template <typename KV = KeyValuePair<>, typename D = VersionedRandomAccessStack<KV>>
 class KeyValueIndex
 {
-  /**
-   * Used to keep track of the ordering of task priority, in this usage writing to the stack.
-   */
-  struct UpdateTask
-  {
-    uint64_t priority;
-    uint64_t element;
-
-    bool operator==(UpdateTask const &other) const
-    {
-      return (priority == other.priority) && (other.element == element);
-    }
-    bool operator<(UpdateTask const &other) const
-    {
-      return priority < other.priority;
-    }
-  };
-
 public:
   using self_type      = KeyValueIndex<KV, D>;
   using stack_type     = D;
@@ -202,6 +220,7 @@ public:
   template <typename... Args>
   void New(Args &&... args)
   {
+    dirty_.clear();
     stack_.New(std::forward<Args>(args)...);
     root_ = 0;
   }
@@ -209,6 +228,7 @@ public:
   template <typename... Args>
   void Load(Args &&... args)
   {
+    dirty_.clear();
     stack_.Load(std::forward<Args>(args)...);
   }
 
@@ -221,73 +241,31 @@ public:
 
     stack_.SetExtraHeader(root_);
 
-    std::unordered_map<uint64_t, uint64_t> depths;
-    std::unordered_map<uint64_t, uint64_t> parents;
-    std::priority_queue<UpdateTask>        q;
-
-    for (auto &k : schedule_update_)
-    {
-      auto &         kv   = k.second;
-      uint64_t       last = k.first;
-      uint64_t       pid  = kv.parent;
-      key_value_pair parent;
-      uint64_t       depth = 1;
-
-      while (pid != uint64_t(-1))
-      {
-        if (parents.find(last) != parents.end())
-        {
-          depth += depths[last];
-          break;
-        }
-        parents[last] = pid;
-
-        stack_.Get(pid, parent);
-        last = pid;
-        pid  = parent.parent;
-        ++depth;
-      }
-
-      // Adding root
-      if (pid == uint64_t(-1))
-      {
-        parents[last] = pid;
-      }
+    UpdateDirtyNodes();
+  }
 
-      last = k.first;
-      while (parents.find(last) != parents.end())
-      {
-        if (depths.find(last) != depths.end())
-        {
-          break;
-        }
-        depths[last] = depth;
-        q.push({depth, last});
-        --depth;
-        last = parents[last];
-      }
-    }
+  /**
+   * Enable or disable the batch write mode.
+   *
+   * In batch mode the Set and Erase operations only mark the modified nodes as dirty. The hashes of
+   * all the affected nodes are then recomputed exactly once, when the index is flushed, committed,
+   * hashed or the batch mode is disabled.
+   *
+   * @param: enabled Flag to signal if the batch mode should be enabled
+   */
+  void SetBatchMode(bool enabled)
+  {
+    batch_mode_ = enabled;
 
-    UpdateTask task;
-    while (!q.empty())
+    if (!batch_mode_)
     {
-      task = q.top();
-      q.pop();
-
-      key_value_pair element, left, right;
-      stack_.Get(task.element, element);
-      if (element.is_leaf())
-      {
-        continue;
-      }
-
-      stack_.Get(element.left, left);
-      stack_.Get(element.right, right);
-      element.UpdateNode(left, right);
-      stack_.Set(task.element, element);
+      UpdateDirtyNodes();
     }
+  }
 
-    schedule_update_.clear();
+  bool batch_mode() const
+  {
+    return batch_mode_;
   }
 
   void Delete(byte_array::ConstByteArray const & /*key*/)
@@ -455,23 +433,24 @@ public:
       stack_.Set(uint64_t(index), kv);
     }
 
-    // Depending on whether the underlying stack is caching or not, we write to it or defer writing
-    // to it by scheduling updates until the next flush
+    // Depending on whether the underlying stack is caching (or the index is in batch mode) or not,
+    // we write to it or defer writing to it by marking the node as dirty until the next flush
     if ((kv.parent != index_type(-1)) && (update_parent))
     {
-      if (stack_.DirectWrite())
+      if (stack_.DirectWrite() && !batch_mode_)
       {
         UpdateParents(kv.parent, index, kv);
       }
       else
       {
-        schedule_update_[index] = kv;
+        dirty_.insert(index);
       }
     }
   }
 
   byte_array::ByteArray Hash()
   {
+    UpdateDirtyNodes();
     stack_.Flush();
     key_value_pair kv;
     if (stack_.size() > 0)
@@ -494,6 +473,7 @@ public:
 
   void Flush(bool lazy = true)
   {
+    UpdateDirtyNodes();
     stack_.Flush(lazy);
   }
 
@@ -516,16 +496,21 @@ public:
   using bookmark_type = uint64_t;
   bookmark_type Commit()
   {
+    UpdateDirtyNodes();
     return stack_.Commit();
   }
 
   bookmark_type Commit(bookmark_type const &b)
   {
+    UpdateDirtyNodes();
     return stack_.Commit(b);
   }
 
   void Revert(bookmark_type const &b)
   {
+    // any pending updates refer to the state being discarded
+    dirty_.clear();
+
     stack_.Revert(b);
 
     root_ = stack_.header_extra();
@@ -676,10 +661,10 @@ public:
    */
   void Erase(byte_array::ConstByteArray const &key_str)
   {
-    static int times_erased = 0;
-    times_erased++;
-
-    Flush(false);
+    if (!batch_mode_)
+    {
+      Flush(false);
+    }
 
     if (size() == 0)
     {
@@ -772,7 +757,15 @@ public:
     }
 
     stack_.Set(sibling_index, sibling);
-    UpdateParents(sibling.parent, sibling_index, sibling);
+
+    if (batch_mode_)
+    {
+      dirty_.insert(sibling_index);
+    }
+    else
+    {
+      UpdateParents(sibling.parent, sibling_index, sibling);
+    }
 
     //// Erase our node and its parent, important to do this at the end since it might shuffle
     /// indexes
@@ -796,10 +789,129 @@ public:
   }
 
 private:
+  using IndexSet  = std::unordered_set<index_type>;
+  using IndexList = std::vector<index_type>;
+
+  /// The minimum number of nodes in a level of the trie before the hashing is distributed
+  static constexpr std::size_t PARALLEL_HASH_THRESHOLD = 256;
+
   stack_type stack_;
 
-  uint64_t                                     root_ = 0;
-  std::unordered_map<uint64_t, key_value_pair> schedule_update_;
+  uint64_t root_       = 0;
+  bool     batch_mode_ = false;
+  IndexSet dirty_;  ///< The nodes whose ancestors' hashes must be recalculated
+
+  /**
+   * Recalculate the hashes of all the ancestors of the dirty nodes. Each affected node is only
+   * hashed once and the nodes are visited bottom up, one level of the trie at a time. Since the
+   * nodes of a level are independent of each other, the hashing of large levels is distributed
+   * over the process wide parallel loop pool.
+   */
+  void UpdateDirtyNodes()
+  {
+    if (dirty_.empty())
+    {
+      return;
+    }
+
+    // determine the depth (from the root) of every ancestor of the dirty nodes
+    std::unordered_map<index_type, std::size_t> depths;
+    IndexList                                   path;
+    std::size_t                                 max_depth = 0;
+    key_value_pair                              kv;
+
+    for (auto const &index : dirty_)
+    {
+      stack_.Get(index, kv);
+
+      path.clear();
+      auto pid = kv.parent;
+      while ((pid != key_value_pair::TREE_ROOT_VALUE) && (depths.find(pid) == depths.end()))
+      {
+        path.push_back(pid);
+        stack_.Get(pid, kv);
+        pid = kv.parent;
+      }
+
+      std::size_t depth = (pid == key_value_pair::TREE_ROOT_VALUE) ? 0 : depths[pid] + 1;
+      for (auto it = path.rbegin(); it != path.rend(); ++it)
+      {
+        depths[*it] = depth;
+        max_depth   = std::max(max_depth, depth);
+        ++depth;
+      }
+    }
+
+    dirty_.clear();
+
+    if (depths.empty())
+    {
+      return;
+    }
+
+    // group the nodes by level
+    std::vector<IndexList> levels(max_depth + 1);
+    for (auto const &element : depths)
+    {
+      levels[element.second].push_back(element.first);
+    }
+
+    // update the levels from the bottom up
+    for (auto it = levels.rbegin(); it != levels.rend(); ++it)
+    {
+      UpdateLevel(*it);
+    }
+  }
+
+  /**
+   * Recalculate the hashes of a set of independent nodes (i.e. none of the nodes is an ancestor of
+   * another)
+   *
+   * @param: nodes The indices of the nodes to be updated
+   */
+  void UpdateLevel(IndexList const &nodes)
+  {
+    std::size_t const count = nodes.size();
+
+    std::vector<key_value_pair> elements(count);
+    std::vector<key_value_pair> lefts(count);
+    std::vector<key_value_pair> rights(count);
+
+    // the underlying stack is not thread safe so all the accesses are serialised
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      stack_.Get(nodes[i], elements[i]);
+      stack_.Get(elements[i].left, lefts[i]);
+      stack_.Get(elements[i].right, rights[i]);
+    }
+
+    auto hash_range = [&elements, &lefts, &rights](std::size_t start, std::size_t end) {
+      key_value_pair::UpdateNodes(elements.data() + start, lefts.data() + start,
+                                  rights.data() + start, end - start);
+    };
+
+    if (count < PARALLEL_HASH_THRESHOLD)
+    {
+      hash_range(0, count);
+    }
+    else
+    {
+      std::size_t const num_chunks = std::min<std::size_t>(threading::GetParallelForNumThreads(),
+                                                           count / PARALLEL_HASH_THRESHOLD);
+      std::size_t const chunk_size = (count + num_chunks - 1) / num_chunks;
+
+      threading::ParallelFor((count + chunk_size - 1) / chunk_size,
+                             [&hash_range, chunk_size, count](std::size_t index) {
+                               std::size_t const start = index * chunk_size;
+                               hash_range(start, std::min(start + chunk_size, count));
+                             });
+    }
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      stack_.Set(nodes[i], elements[i]);
+    }
+  }
 
   /**
    * Update the parents of a changed node, since this changes the merkle tree
@@ -1021,12 +1133,21 @@ private:
 
     assert(index <= stack_end);
 
+    // the node is being removed, as such it is no longer of interest
+    dirty_.erase(index);
+
     if (index == stack_end)
     {
       stack_.Pop();
       return;
     }
 
+    // the last element is being moved, any pending update must follow it
+    if (dirty_.erase(stack_end) > 0)
+    {
+      dirty_.insert(index);
+    }
+
     // Get last element on stack
     key_value_pair last_element;
     stack_.Get(stack_end, last_element);
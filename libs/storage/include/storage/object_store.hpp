@@ -264,6 +264,16 @@ public:
       return ret;
     }
 
+    /**
+     * Get the key of the current element, without deserializing the object
+     *
+     * @return: the key (the identifier of the resource)
+     */
+    byte_array::ConstByteArray GetKey() const
+    {
+      return wrapped_iterator_.GetKey();
+    }
+
   protected:
     typename KeyByteArrayStore<S>::Iterator wrapped_iterator_;
   };
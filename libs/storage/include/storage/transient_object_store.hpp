@@ -26,6 +26,7 @@
 #include "ledger/chain/transaction_layout.hpp"
 #include "storage/object_store.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <functional>
 #include <map>
@@ -52,6 +53,7 @@ public:
   using Archive      = ObjectStore<Object>;
   using TxLayouts    = std::vector<ledger::TransactionLayout>;
   using TxArray      = std::vector<ledger::Transaction>;
+  using KeyArray     = std::vector<byte_array::ConstByteArray>;
   using WeakRunnable = core::WeakRunnable;
 
   static constexpr char const *LOGGING_NAME = "TransientObjectStore";
@@ -83,8 +85,9 @@ public:
 
   std::size_t Size() const;
 
-  TxArray PullSubtree(byte_array::ConstByteArray const &rid, uint64_t bit_count,
-                      uint64_t pull_limit);
+  TxArray  PullSubtree(byte_array::ConstByteArray const &rid, uint64_t bit_count,
+                       uint64_t pull_limit);
+  KeyArray PullSubtreeKeys(byte_array::ConstByteArray const &rid, uint64_t bit_count);
 
   WeakRunnable GetWeakRunnable() const;
 
@@ -103,6 +106,9 @@ private:
   using Cache           = std::unordered_map<ResourceID, Object>;
   using Flag            = std::atomic<bool>;
 
+  static bool MatchesPrefix(byte_array::ConstByteArray const &key,
+                            byte_array::ConstByteArray const &prefix, uint64_t bit_count);
+
   bool GetFromCache(ResourceID const &rid, Object &object);
   void SetInCache(ResourceID const &rid, Object const &object);
   bool IsInCache(ResourceID const &rid);
@@ -180,6 +186,94 @@ typename TransientObjectStore<O>::TxArray TransientObjectStore<O>::PullSubtree(
   return ret;
 }
 
+/**
+ * Get the keys of all the objects (both cached and archived) in a subtree, without reading the
+ * objects themselves
+ *
+ * @param rid The key whose leading bits define the subtree
+ * @param bit_count The number of leading bits of the key to be matched
+ * @return The (unique) keys of the objects in the subtree
+ */
+template <typename O>
+typename TransientObjectStore<O>::KeyArray TransientObjectStore<O>::PullSubtreeKeys(
+    byte_array::ConstByteArray const &rid, uint64_t bit_count)
+{
+  KeyArray keys{};
+
+  // the cache must be inspected first, since objects are only removed from it once they have been
+  // written to the archive
+  {
+    FETCH_LOCK(cache_mutex_);
+
+    for (auto const &element : cache_)
+    {
+      if (MatchesPrefix(element.first.id(), rid, bit_count))
+      {
+        keys.push_back(element.first.id());
+      }
+    }
+  }
+
+  archive_.Flush(false);
+
+  archive_.WithLock([this, &keys, &rid, bit_count]() {
+    auto it = this->archive_.GetSubtree(ResourceID(rid), bit_count);
+
+    while (it != this->archive_.end())
+    {
+      keys.push_back(it.GetKey());
+      ++it;
+    }
+  });
+
+  // objects in the process of being archived will have been seen twice
+  std::sort(keys.begin(), keys.end());
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+  return keys;
+}
+
+/**
+ * Determine if the leading bits of a key match a prefix. In line with the ordering of the archive,
+ * the bits of each byte are compared from the least significant to the most significant.
+ *
+ * @param key The key to be checked
+ * @param prefix The prefix
+ * @param bit_count The number of leading bits to be compared
+ * @return true if the bits match, otherwise false
+ */
+template <typename O>
+bool TransientObjectStore<O>::MatchesPrefix(byte_array::ConstByteArray const &key,
+                                            byte_array::ConstByteArray const &prefix,
+                                            uint64_t                          bit_count)
+{
+  uint64_t const num_bytes = bit_count >> 3u;
+  uint64_t const num_bits  = bit_count & 0x7u;
+  uint64_t const required  = num_bytes + ((num_bits != 0) ? 1u : 0u);
+
+  if ((key.size() < required) || (prefix.size() < required))
+  {
+    return false;
+  }
+
+  for (std::size_t i = 0; i < num_bytes; ++i)
+  {
+    if (key[i] != prefix[i])
+    {
+      return false;
+    }
+  }
+
+  if (num_bits == 0)
+  {
+    return true;
+  }
+
+  auto const mask = static_cast<uint8_t>((1u << num_bits) - 1u);
+
+  return (key[num_bytes] & mask) == (prefix[num_bytes] & mask);
+}
+
 template <typename O>
 constexpr core::Tickets::Count TransientObjectStore<O>::recent_queue_alarm_threshold;
 
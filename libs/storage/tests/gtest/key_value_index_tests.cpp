@@ -446,3 +446,70 @@ TEST(storage_key_value_index_gtest, Load_save_consistency)
 {
   EXPECT_TRUE(LoadSaveVsBulk());
 }
+
+template <typename T>
+bool BatchModeHashConsistency()
+{
+  std::vector<TestData> values;
+  for (std::size_t i = 0; i < 2000; ++i)
+  {
+    byte_array::ByteArray key;
+    key.Resize(256 / 8);
+    for (std::size_t j = 0; j < key.size(); ++j)
+    {
+      key[j] = uint8_t(lfg() >> 9);
+    }
+
+    values.push_back({key, lfg()});
+  }
+
+  T immediate;
+  T batched;
+  immediate.New("test_immediate.db");
+  batched.New("test_batched.db");
+  batched.SetBatchMode(true);
+
+  for (auto const &val : values)
+  {
+    immediate.Set(val.key, val.value, val.key);
+    batched.Set(val.key, val.value, val.key);
+  }
+
+  // overwrite a subset of the values and erase another
+  for (std::size_t i = 0; i < values.size(); i += 7)
+  {
+    immediate.Set(values[i].key, i, values[i].key);
+    batched.Set(values[i].key, i, values[i].key);
+  }
+
+  for (std::size_t i = 3; i < values.size(); i += 5)
+  {
+    immediate.Erase(values[i].key);
+    batched.Erase(values[i].key);
+  }
+
+  if (immediate.Hash() != batched.Hash())
+  {
+    std::cout << "Hash mismatch after batch update" << std::endl;
+    return false;
+  }
+
+  // leaving the batch mode must leave the index in a consistent state
+  batched.SetBatchMode(false);
+  batched.Set(values[1].key, 42, values[1].key);
+  immediate.Set(values[1].key, 42, values[1].key);
+
+  if (immediate.Hash() != batched.Hash())
+  {
+    std::cout << "Hash mismatch after leaving batch mode" << std::endl;
+    return false;
+  }
+
+  return (immediate.size() == batched.size()) && (batched.Get(values[1].key) == 42);
+}
+
+TEST(storage_key_value_index_gtest, Batch_mode_consistency)
+{
+  EXPECT_TRUE(BatchModeHashConsistency<kvi_type>());
+  EXPECT_TRUE(BatchModeHashConsistency<cached_kvi_type>());
+}
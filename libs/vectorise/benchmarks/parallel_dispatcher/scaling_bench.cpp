@@ -0,0 +1,109 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vectorise/memory/shared_array.hpp"
+#include "vectorise/threading/parallel_for.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+
+using namespace fetch::memory;
+
+namespace {
+
+using ndarray_type       = SharedArray<float>;
+using VectorRegisterType = ndarray_type::VectorRegisterType;
+
+// Arguments: number of elements, number of threads
+void ScalingArguments(benchmark::internal::Benchmark *b)
+{
+  for (int64_t size : {int64_t{1} << 12, int64_t{1} << 18, int64_t{1} << 22, int64_t{100000000}})
+  {
+    for (int64_t threads : {1, 2, 4, 8})
+    {
+      b->Args({size, threads});
+    }
+  }
+}
+
+ndarray_type MakeArray(std::size_t size)
+{
+  ndarray_type array(size);
+  array.SetAllZero();
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    array[i] = float(i % 1024) / 1024.0f;
+  }
+
+  return array;
+}
+
+void BM_ApplyScaling(benchmark::State &state)
+{
+  auto const size = static_cast<std::size_t>(state.range(0));
+  fetch::threading::SetParallelForNumThreads(static_cast<std::size_t>(state.range(1)));
+
+  ndarray_type a = MakeArray(size);
+  ndarray_type b = MakeArray(size);
+  ndarray_type c(size);
+
+  for (auto _ : state)
+  {
+    c.in_parallel().Apply(
+        [](VectorRegisterType const &x, VectorRegisterType const &y, VectorRegisterType &z) {
+          z = (x * y) + x;
+        },
+        a, b);
+    benchmark::DoNotOptimize(c.pointer());
+  }
+
+  fetch::threading::SetParallelForNumThreads(0);
+  state.SetBytesProcessed(int64_t(state.iterations()) * state.range(0) *
+                          int64_t(3 * sizeof(float)));
+}
+
+void BM_SumReduceScaling(benchmark::State &state)
+{
+  auto const size = static_cast<std::size_t>(state.range(0));
+  fetch::threading::SetParallelForNumThreads(static_cast<std::size_t>(state.range(1)));
+
+  ndarray_type a = MakeArray(size);
+  ndarray_type b = MakeArray(size);
+
+  for (auto _ : state)
+  {
+    float result = a.in_parallel().SumReduce(
+        TrivialRange(0, size),
+        [](VectorRegisterType const &x, VectorRegisterType const &y) { return x * y; }, b);
+    benchmark::DoNotOptimize(result);
+  }
+
+  fetch::threading::SetParallelForNumThreads(0);
+  state.SetBytesProcessed(int64_t(state.iterations()) * state.range(0) *
+                          int64_t(2 * sizeof(float)));
+}
+
+}  // namespace
+
+BENCHMARK(BM_ApplyScaling)->Apply(ScalingArguments)->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK(BM_SumReduceScaling)
+    ->Apply(ScalingArguments)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
@@ -20,10 +20,17 @@
 #include "vectorise/memory/details.hpp"
 #include "vectorise/memory/range.hpp"
 #include "vectorise/platform.hpp"
+#include "vectorise/threading/parallel_for.hpp"
 #include "vectorise/vectorise.hpp"
 
+#include <mm_malloc.h>
+
+#include <algorithm>
+#include <cstddef>
 #include <iostream>
+#include <memory>
 #include <type_traits>
+#include <vector>
 
 namespace fetch {
 namespace memory {
@@ -41,6 +48,18 @@ public:
   using VectorRegisterType         = typename vectorize::VectorRegister<type, vector_size>;
   using VectorRegisterIteratorType = vectorize::VectorRegisterIterator<type, vector_size>;
 
+  /* Large ranges are split into cache sized chunks which are processed concurrently on a shared
+   * worker pool, while smaller ranges are processed on the calling thread. The chunk boundaries
+   * only depend on the range, not on the number of threads, and reductions combine the partial
+   * result of each chunk in order, so the results are deterministic. Consequently kernels must
+   * be free of side effects other than writing their output register.
+   */
+  enum
+  {
+    CHUNK_SIZE         = (128 * 1024) / sizeof(type),  ///< Number of elements in each chunk
+    PARALLEL_THRESHOLD = 8 * CHUNK_SIZE                ///< Minimum elements to run in parallel
+  };
+
   ConstParallelDispatcher(type *ptr, std::size_t const &size)
     : pointer_(ptr)
     , size_(size)
@@ -49,18 +68,20 @@ public:
   type Reduce(VectorRegisterType (*vector_reduction)(VectorRegisterType const &,
                                                      VectorRegisterType const &)) const
   {
-    VectorRegisterType         a, b(type(0));
-    VectorRegisterIteratorType iter(this->pointer(), this->size());
+    auto const partial = [this, vector_reduction](std::size_t from, std::size_t to) {
+      VectorRegisterType         a, b(type(0));
+      VectorRegisterIteratorType iter(this->pointer() + from, to - from);
 
-    std::size_t N = this->size();
+      for (std::size_t i = from; i < to; i += VectorRegisterType::E_BLOCK_COUNT)
+      {
+        iter.Next(a);
+        b = vector_reduction(a, b);
+      }
 
-    for (std::size_t i = 0; i < N; i += VectorRegisterType::E_BLOCK_COUNT)
-    {
-      iter.Next(a);
-      b = vector_reduction(a, b);
-    }
+      return b;
+    };
 
-    return reduce(b);
+    return reduce(ReduceChunks(0, this->size(), partial, vector_reduction));
   }
 
   /// Sum reduce
@@ -68,102 +89,424 @@ public:
   template <typename F, typename V>
   type SumReduce(F &&vector_reduce, V const &a, V const &b, V const &c)
   {
-    VectorRegisterIteratorType self_iter(this->pointer(), this->size());
-    VectorRegisterIteratorType a_iter(a.pointer(), a.size());
-    VectorRegisterIteratorType b_iter(b.pointer(), b.size());
-    VectorRegisterIteratorType c_iter(c.pointer(), c.size());
+    auto const partial = [this, &vector_reduce, &a, &b, &c](std::size_t from, std::size_t to) {
+      VectorRegisterIteratorType self_iter(this->pointer() + from, to - from);
+      VectorRegisterIteratorType a_iter(a.pointer() + from, to - from);
+      VectorRegisterIteratorType b_iter(b.pointer() + from, to - from);
+      VectorRegisterIteratorType c_iter(c.pointer() + from, to - from);
 
-    VectorRegisterType ret(type(0)), tmp, self;
+      VectorRegisterType ret(type(0)), tmp, self;
 
-    VectorRegisterType a_val;
-    VectorRegisterType b_val;
-    VectorRegisterType c_val;
+      VectorRegisterType a_val;
+      VectorRegisterType b_val;
+      VectorRegisterType c_val;
 
-    std::size_t N = this->size();
-    for (std::size_t i = 0; i < N; i += VectorRegisterType::E_BLOCK_COUNT)
-    {
-      self_iter.Next(self);
-      a_iter.Next(a_val);
-      b_iter.Next(b_val);
-      c_iter.Next(c_val);
-      tmp = vector_reduce(self, a_val, b_val, c_val);
-      ret = ret + tmp;
-    }
+      for (std::size_t i = from; i < to; i += VectorRegisterType::E_BLOCK_COUNT)
+      {
+        self_iter.Next(self);
+        a_iter.Next(a_val);
+        b_iter.Next(b_val);
+        c_iter.Next(c_val);
+        tmp = vector_reduce(self, a_val, b_val, c_val);
+        ret = ret + tmp;
+      }
 
-    return reduce(c);
+      return ret;
+    };
+
+    return reduce(ReduceChunks(0, this->size(), partial, AddRegisters));
   }
 
   template <typename F, typename V>
   type SumReduce(F &&vector_reduce, V const &a, V const &b)
   {
-    VectorRegisterIteratorType self_iter(this->pointer(), this->size());
-    VectorRegisterIteratorType a_iter(a.pointer(), a.size());
-    VectorRegisterIteratorType b_iter(b.pointer(), b.size());
+    auto const partial = [this, &vector_reduce, &a, &b](std::size_t from, std::size_t to) {
+      VectorRegisterIteratorType self_iter(this->pointer() + from, to - from);
+      VectorRegisterIteratorType a_iter(a.pointer() + from, to - from);
+      VectorRegisterIteratorType b_iter(b.pointer() + from, to - from);
 
-    VectorRegisterType c(type(0)), tmp, self;
+      VectorRegisterType c(type(0)), tmp, self;
 
-    VectorRegisterType a_val;
-    VectorRegisterType b_val;
+      VectorRegisterType a_val;
+      VectorRegisterType b_val;
 
-    std::size_t N = this->size();
-    for (std::size_t i = 0; i < N; i += VectorRegisterType::E_BLOCK_COUNT)
-    {
-      self_iter.Next(self);
-      a_iter.Next(a_val);
-      b_iter.Next(b_val);
-      tmp = vector_reduce(self, a_val, b_val);
-      c   = c + tmp;
-    }
+      for (std::size_t i = from; i < to; i += VectorRegisterType::E_BLOCK_COUNT)
+      {
+        self_iter.Next(self);
+        a_iter.Next(a_val);
+        b_iter.Next(b_val);
+        tmp = vector_reduce(self, a_val, b_val);
+        c   = c + tmp;
+      }
 
-    return reduce(c);
+      return c;
+    };
+
+    return reduce(ReduceChunks(0, this->size(), partial, AddRegisters));
   }
 
   template <typename F, typename V>
   typename std::enable_if<!std::is_same<F, TrivialRange>::value, type>::type SumReduce(
       F &&vector_reduce, V const &a)
   {
-    VectorRegisterIteratorType self_iter(this->pointer(), this->size());
-    VectorRegisterIteratorType a_iter(a.pointer(), a.size());
+    auto const partial = [this, &vector_reduce, &a](std::size_t from, std::size_t to) {
+      VectorRegisterIteratorType self_iter(this->pointer() + from, to - from);
+      VectorRegisterIteratorType a_iter(a.pointer() + from, to - from);
 
-    VectorRegisterType c(type(0)), tmp, self;
+      VectorRegisterType c(type(0)), tmp, self;
 
-    VectorRegisterType a_val;
+      VectorRegisterType a_val;
 
-    std::size_t N = this->size();
-    for (std::size_t i = 0; i < N; i += VectorRegisterType::E_BLOCK_COUNT)
-    {
-      self_iter.Next(self);
-      a_iter.Next(a_val);
-      tmp = vector_reduce(self, a_val);
-      c   = c + tmp;
-    }
+      for (std::size_t i = from; i < to; i += VectorRegisterType::E_BLOCK_COUNT)
+      {
+        self_iter.Next(self);
+        a_iter.Next(a_val);
+        tmp = vector_reduce(self, a_val);
+        c   = c + tmp;
+      }
 
-    return reduce(c);
+      return c;
+    };
+
+    return reduce(ReduceChunks(0, this->size(), partial, AddRegisters));
   }
 
   template <typename F>
   type SumReduce(F &&vector_reduce)
   {
+    auto const partial = [this, &vector_reduce](std::size_t from, std::size_t to) {
+      VectorRegisterIteratorType self_iter(this->pointer() + from, to - from);
+      VectorRegisterType         c(type(0)), tmp, self;
+
+      for (std::size_t i = from; i < to; i += VectorRegisterType::E_BLOCK_COUNT)
+      {
+        self_iter.Next(self);
+        tmp = vector_reduce(self);
+        c   = c + tmp;
+      }
+
+      return c;
+    };
+
+    return reduce(ReduceChunks(0, this->size(), partial, AddRegisters));
+  }
+  ///  @}
+
+  /// SumReduce with range
+  /// @{
+  template <typename F, typename V>
+  type SumReduce(TrivialRange const &range, F &&vector_reduce, V const &a, V const &b, V const &c)
+  {
+    return SumChunks(range.from(), range.to(),
+                     [this, &vector_reduce, &a, &b, &c](std::size_t from, std::size_t to) {
+                       return SumReduceRange(TrivialRange(from, to), vector_reduce, a, b, c);
+                     });
+  }
+
+  template <typename F, typename V>
+  type SumReduce(TrivialRange const &range, F &&vector_reduce, V const &a, V const &b)
+  {
+    return SumChunks(range.from(), range.to(),
+                     [this, &vector_reduce, &a, &b](std::size_t from, std::size_t to) {
+                       return SumReduceRange(TrivialRange(from, to), vector_reduce, a, b);
+                     });
+  }
+
+  template <typename F, typename V>
+  type SumReduce(TrivialRange const &range, F &&vector_reduce, V const &a)
+  {
+    return SumChunks(range.from(), range.to(),
+                     [this, &vector_reduce, &a](std::size_t from, std::size_t to) {
+                       return SumReduceRange(TrivialRange(from, to), vector_reduce, a);
+                     });
+  }
+
+  template <typename F>
+  type SumReduce(TrivialRange const &range, F &&vector_reduce)
+  {
+    return SumChunks(range.from(), range.to(),
+                     [this, &vector_reduce](std::size_t from, std::size_t to) {
+                       return SumReduceRange(TrivialRange(from, to), vector_reduce);
+                     });
+  }
+  /// @}
+
+  template <typename... Args>
+  type ProductReduce(typename details::MatrixReduceFreeFunction<VectorRegisterType>::
+                         template Unroll<Args...>::signature_type const &kernel,
+                     Args &&... args)
+  {
+
+    VectorRegisterType         regs[sizeof...(args)];
+    VectorRegisterIteratorType iters[sizeof...(args)];
+    InitializeVectorIterators(0, this->size(), iters, std::forward<Args>(args)...);
+
     VectorRegisterIteratorType self_iter(this->pointer(), this->size());
     VectorRegisterType         c(type(0)), tmp, self;
 
     std::size_t N = this->size();
     for (std::size_t i = 0; i < N; i += VectorRegisterType::E_BLOCK_COUNT)
     {
+      details::UnrollNext<sizeof...(args), VectorRegisterType, VectorRegisterIteratorType>::Apply(
+          regs, iters);
       self_iter.Next(self);
-      tmp = vector_reduce(self);
-      c   = c + tmp;
+      tmp = details::MatrixReduceFreeFunction<VectorRegisterType>::template Unroll<Args...>::Apply(
+          self, regs, kernel);
+      c = c * tmp;
     }
 
     return reduce(c);
   }
-  ///  @}
 
-  /// SumReduce with range
+  type Reduce(TrivialRange const &range,
+              VectorRegisterType (*vector_reduction)(VectorRegisterType const &,
+                                                     VectorRegisterType const &)) const
+  {
+    VectorRegisterType b = ReduceChunks(
+        range.from(), range.to(),
+        [this, vector_reduction](std::size_t from, std::size_t to) {
+          return ReduceRange(TrivialRange(from, to), vector_reduction);
+        },
+        vector_reduction);
+
+    // TODO(issue 1): Make reduction tree / Wallace tree
+    type ret = 0;
+    for (std::size_t i = 0; i < VectorRegisterType::E_BLOCK_COUNT; ++i)
+    {
+      VectorRegisterType c(ret);
+      c   = vector_reduction(c, b);
+      ret = first_element(c);
+      b   = shift_elements_right(b);
+    }
+
+    return ret;
+  }
+
+  type Reduce(type (*register_reduction)(type const &, type const &)) const
+  {
+    type        ret = 0;
+    std::size_t N   = this->size();
+
+    for (std::size_t i = 0; i < N; ++i)
+    {
+      ret = register_reduction(ret, pointer_[i]);
+    }
+
+    return ret;
+  }
+
+  type Reduce(TrivialRange const &range,
+              type (*register_reduction)(type const &, type const &)) const
+  {
+    type ret = 0;
+    for (std::size_t i = range.from(); i < range.to(); ++i)
+    {
+      ret = register_reduction(ret, pointer_[i]);
+    }
+    return ret;
+  }
+
+  type const *pointer() const
+  {
+    return pointer_;
+  }
+  std::size_t const &size() const
+  {
+    return size_;
+  }
+  std::size_t &size()
+  {
+    return size_;
+  }
+
+protected:
+  type *pointer()
+  {
+    return pointer_;
+  }
+  type *      pointer_;
+  std::size_t size_;
+
+  /// @name Chunked execution
   /// @{
 
+  /**
+   * Get the number of chunks a range is split into
+   *
+   * @param from The first element of the range
+   * @param to The end of the range
+   * @return The number of chunks, one if the range is to be processed on the calling thread
+   */
+  static std::size_t NumChunks(std::size_t from, std::size_t to)
+  {
+    if ((to <= from) || ((to - from) < std::size_t(PARALLEL_THRESHOLD)))
+    {
+      return 1;
+    }
+
+    // chunk boundaries are aligned with the start of the array, so every chunk other than the
+    // first and the last consists of whole vector registers
+    std::size_t const chunk_size = CHUNK_SIZE;
+    return ((to + chunk_size - 1) / chunk_size) - (from / chunk_size);
+  }
+
+  /**
+   * Process a range chunk by chunk, concurrently if the range is large enough
+   *
+   * @param from The first element of the range
+   * @param to The end of the range
+   * @param chunk The function called with the index, first element and end of each chunk
+   */
+  template <typename F>
+  static void ForEachChunk(std::size_t from, std::size_t to, F &&chunk)
+  {
+    static_assert((CHUNK_SIZE % VectorRegisterType::E_BLOCK_COUNT) == 0,
+                  "chunks must consist of whole vector registers");
+
+    std::size_t const num_chunks = NumChunks(from, to);
+
+    if (num_chunks == 1)
+    {
+      chunk(std::size_t{0}, from, to);
+      return;
+    }
+
+    std::size_t const chunk_size  = CHUNK_SIZE;
+    std::size_t const first_chunk = from / chunk_size;
+
+    threading::ParallelFor(num_chunks, [from, to, chunk_size, first_chunk,
+                                        &chunk](std::size_t index) {
+      std::size_t const chunk_from = std::max(from, (first_chunk + index) * chunk_size);
+      std::size_t const chunk_to   = std::min(to, (first_chunk + index + 1) * chunk_size);
+
+      chunk(index, chunk_from, chunk_to);
+    });
+  }
+
+  /**
+   * Sum the scalar partial results of each chunk of a range, in order
+   *
+   * @param from The first element of the range
+   * @param to The end of the range
+   * @param partial The function returning the partial result of a chunk, given its bounds
+   * @return The sum of the partial results
+   */
+  template <typename F>
+  static type SumChunks(std::size_t from, std::size_t to, F &&partial)
+  {
+    std::size_t const num_chunks = NumChunks(from, to);
+
+    if (num_chunks == 1)
+    {
+      return partial(from, to);
+    }
+
+    std::vector<type> partials(num_chunks);
+    ForEachChunk(from, to, [&partials, &partial](std::size_t index, std::size_t chunk_from,
+                                                 std::size_t chunk_to) {
+      partials[index] = partial(chunk_from, chunk_to);
+    });
+
+    type ret = partials[0];
+    for (std::size_t i = 1; i < num_chunks; ++i)
+    {
+      ret += partials[i];
+    }
+
+    return ret;
+  }
+
+  /**
+   * Combine the vector register partial results of each chunk of a range, in order
+   *
+   * @param from The first element of the range
+   * @param to The end of the range
+   * @param partial The function returning the partial result of a chunk, given its bounds
+   * @param combine The function combining a partial result with the accumulated result
+   * @return The combined result
+   */
+  template <typename F, typename C>
+  static VectorRegisterType ReduceChunks(std::size_t from, std::size_t to, F &&partial,
+                                         C &&combine)
+  {
+    std::size_t const num_chunks = NumChunks(from, to);
+
+    if (num_chunks == 1)
+    {
+      return partial(from, to);
+    }
+
+    // registers might require a larger alignment than the standard allocator provides
+    std::size_t const block_count = VectorRegisterType::E_BLOCK_COUNT;
+    std::unique_ptr<type, void (*)(void *)> partials(
+        reinterpret_cast<type *>(_mm_malloc(num_chunks * block_count * sizeof(type), 64)),
+        _mm_free);
+
+    type *const storage = partials.get();
+    ForEachChunk(from, to, [storage, block_count, &partial](std::size_t index,
+                                                            std::size_t chunk_from,
+                                                            std::size_t chunk_to) {
+      partial(chunk_from, chunk_to).Store(storage + (index * block_count));
+    });
+
+    VectorRegisterType ret(storage);
+    for (std::size_t i = 1; i < num_chunks; ++i)
+    {
+      ret = combine(VectorRegisterType(storage + (i * block_count)), ret);
+    }
+
+    return ret;
+  }
+
+  static VectorRegisterType AddRegisters(VectorRegisterType const &a, VectorRegisterType const &b)
+  {
+    return a + b;
+  }
+
+  /// @}
+
+  VectorRegisterType ReduceRange(TrivialRange const &range,
+                                 VectorRegisterType (*vector_reduction)(
+                                     VectorRegisterType const &, VectorRegisterType const &)) const
+  {
+    int SFL = int(range.SIMDFromLower<VectorRegisterType::E_BLOCK_COUNT>());
+
+    int SF = int(range.SIMDFromUpper<VectorRegisterType::E_BLOCK_COUNT>());
+    int ST = int(range.SIMDToLower<VectorRegisterType::E_BLOCK_COUNT>());
+
+    int STU      = int(range.SIMDToUpper<VectorRegisterType::E_BLOCK_COUNT>());
+    int SIMDSize = STU - SFL;
+
+    VectorRegisterType         a, b(type(0));
+    VectorRegisterIteratorType iter(this->pointer() + SFL, std::size_t(SIMDSize));
+
+    if (SFL != SF)
+    {
+      iter.Next(a);
+      a = vector_zero_below_element(a,
+                                    VectorRegisterType::E_BLOCK_COUNT - (SF - int(range.from())));
+      b = vector_reduction(a, b);
+    }
+
+    for (int i = SF; i < ST; i += VectorRegisterType::E_BLOCK_COUNT)
+    {
+      iter.Next(a);
+      b = vector_reduction(a, b);
+    }
+
+    if (STU != ST)
+    {
+      iter.Next(a);
+      a = vector_zero_above_element(a, (int(range.to()) - ST - 1));
+      b = vector_reduction(a, b);
+    }
+
+    return b;
+  }
+
   template <typename F, typename V>
-  type SumReduce(TrivialRange const &range, F &&vector_reduce, V const &a, V const &b, V const &c)
+  type SumReduceRange(TrivialRange const &range, F &&vector_reduce, V const &a, V const &b,
+                      V const &c)
   {
     int SFL      = int(range.SIMDFromLower<VectorRegisterType::E_BLOCK_COUNT>());
     int SF       = int(range.SIMDFromUpper<VectorRegisterType::E_BLOCK_COUNT>());
@@ -171,10 +514,10 @@ public:
     int STU      = int(range.SIMDToUpper<VectorRegisterType::E_BLOCK_COUNT>());
     int SIMDSize = STU - SFL;
 
-    VectorRegisterIteratorType self_iter(this->pointer(), std::size_t(SIMDSize));
-    VectorRegisterIteratorType a_iter(a.pointer(), std::size_t(SIMDSize));
-    VectorRegisterIteratorType b_iter(b.pointer(), std::size_t(SIMDSize));
-    VectorRegisterIteratorType c_iter(c.pointer(), std::size_t(SIMDSize));
+    VectorRegisterIteratorType self_iter(this->pointer() + SFL, std::size_t(SIMDSize));
+    VectorRegisterIteratorType a_iter(a.pointer() + SFL, std::size_t(SIMDSize));
+    VectorRegisterIteratorType b_iter(b.pointer() + SFL, std::size_t(SIMDSize));
+    VectorRegisterIteratorType c_iter(c.pointer() + SFL, std::size_t(SIMDSize));
 
     VectorRegisterType vec_ret(type(0)), tmp, self;
 
@@ -237,9 +580,8 @@ public:
   }
 
   template <typename F, typename V>
-  type SumReduce(TrivialRange const &range, F &&vector_reduce, V const &a, V const &b)
+  type SumReduceRange(TrivialRange const &range, F &&vector_reduce, V const &a, V const &b)
   {
-
     VectorRegisterType c(type(0)), tmp, self;
 
     VectorRegisterType a_val;
@@ -251,9 +593,9 @@ public:
     int STU      = int(range.SIMDToUpper<VectorRegisterType::E_BLOCK_COUNT>());
     int SIMDSize = STU - SFL;
 
-    VectorRegisterIteratorType self_iter(this->pointer(), std::size_t(SIMDSize));
-    VectorRegisterIteratorType a_iter(a.pointer(), std::size_t(SIMDSize));
-    VectorRegisterIteratorType b_iter(b.pointer(), std::size_t(SIMDSize));
+    VectorRegisterIteratorType self_iter(this->pointer() + SFL, std::size_t(SIMDSize));
+    VectorRegisterIteratorType a_iter(a.pointer() + SFL, std::size_t(SIMDSize));
+    VectorRegisterIteratorType b_iter(b.pointer() + SFL, std::size_t(SIMDSize));
 
     // Taking care of thread
     type ret = 0;
@@ -307,7 +649,7 @@ public:
   }
 
   template <typename F, typename V>
-  type SumReduce(TrivialRange const &range, F &&vector_reduce, V const &a)
+  type SumReduceRange(TrivialRange const &range, F &&vector_reduce, V const &a)
   {
     int SFL      = int(range.SIMDFromLower<VectorRegisterType::E_BLOCK_COUNT>());
     int SF       = int(range.SIMDFromUpper<VectorRegisterType::E_BLOCK_COUNT>());
@@ -315,8 +657,8 @@ public:
     int STU      = int(range.SIMDToUpper<VectorRegisterType::E_BLOCK_COUNT>());
     int SIMDSize = STU - SFL;
 
-    VectorRegisterIteratorType self_iter(this->pointer(), std::size_t(SIMDSize));
-    VectorRegisterIteratorType a_iter(a.pointer(), std::size_t(SIMDSize));
+    VectorRegisterIteratorType self_iter(this->pointer() + SFL, std::size_t(SIMDSize));
+    VectorRegisterIteratorType a_iter(a.pointer() + SFL, std::size_t(SIMDSize));
 
     VectorRegisterType c(type(0)), tmp, self;
 
@@ -354,199 +696,77 @@ public:
     // Taking care of the tail
     if (STU != ST)
     {
-      self_iter.Next(self);
-      a_iter.Next(a_val);
-      tmp = vector_reduce(self, a_val);
-
-      int Q = (int(range.to()) - ST - 1);
-      for (int i = 0; i <= Q; ++i)
-      {
-        ret += first_element(tmp);
-        tmp = shift_elements_right(tmp);
-      }
-    }
-
-    return ret;
-  }
-
-  template <typename F>
-  type SumReduce(TrivialRange const &range, F &&vector_reduce)
-  {
-    int SFL      = int(range.SIMDFromLower<VectorRegisterType::E_BLOCK_COUNT>());
-    int SF       = int(range.SIMDFromUpper<VectorRegisterType::E_BLOCK_COUNT>());
-    int ST       = int(range.SIMDToLower<VectorRegisterType::E_BLOCK_COUNT>());
-    int STU      = int(range.SIMDToUpper<VectorRegisterType::E_BLOCK_COUNT>());
-    int SIMDSize = STU - SFL;
-
-    type                       ret = 0;
-    VectorRegisterIteratorType self_iter(this->pointer(), std::size_t(SIMDSize));
-    VectorRegisterType         c(type(0)), tmp, self;
-
-    // Taking care of thread
-    if (SFL != SF)
-    {
-      self_iter.Next(self);
-      tmp = vector_reduce(self);
-
-      int Q = VectorRegisterType::E_BLOCK_COUNT - (SF - int(range.from()));
-      for (int i = 0; i < VectorRegisterType::E_BLOCK_COUNT; ++i)
-      {
-        if (Q <= i)
-        {
-          ret += first_element(tmp);
-        }
-        tmp = shift_elements_right(tmp);
-      }
-    }
-
-    for (int i = SF; i < ST; i += VectorRegisterType::E_BLOCK_COUNT)
-    {
-      self_iter.Next(self);
-      tmp = vector_reduce(self);
-      c   = c + tmp;
-    }
-
-    ret += reduce(c);
-
-    // Taking care of the tail
-    if (STU != ST)
-    {
-      self_iter.Next(self);
-      tmp = vector_reduce(self);
-
-      int Q = (int(range.to()) - ST - 1);
-      for (int i = 0; i <= Q; ++i)
-      {
-        ret += first_element(tmp);
-        tmp = shift_elements_right(tmp);
-      }
-    }
-
-    return ret;
-  }
-  /// @}
-
-  template <typename... Args>
-  type ProductReduce(typename details::MatrixReduceFreeFunction<VectorRegisterType>::
-                         template Unroll<Args...>::signature_type const &kernel,
-                     Args &&... args)
-  {
-
-    VectorRegisterType         regs[sizeof...(args)];
-    VectorRegisterIteratorType iters[sizeof...(args)];
-    InitializeVectorIterators(0, this->size(), iters, std::forward<Args>(args)...);
-
-    VectorRegisterIteratorType self_iter(this->pointer(), this->size());
-    VectorRegisterType         c(type(0)), tmp, self;
-
-    std::size_t N = this->size();
-    for (std::size_t i = 0; i < N; i += VectorRegisterType::E_BLOCK_COUNT)
-    {
-      details::UnrollNext<sizeof...(args), VectorRegisterType, VectorRegisterIteratorType>::Apply(
-          regs, iters);
-      self_iter.Next(self);
-      tmp = details::MatrixReduceFreeFunction<VectorRegisterType>::template Unroll<Args...>::Apply(
-          self, regs, kernel);
-      c = c * tmp;
-    }
-
-    return reduce(c);
-  }
-
-  type Reduce(TrivialRange const &range,
-              VectorRegisterType (*vector_reduction)(VectorRegisterType const &,
-                                                     VectorRegisterType const &)) const
-  {
-
-    int SFL = int(range.SIMDFromLower<VectorRegisterType::E_BLOCK_COUNT>());
-
-    int SF = int(range.SIMDFromUpper<VectorRegisterType::E_BLOCK_COUNT>());
-    int ST = int(range.SIMDToLower<VectorRegisterType::E_BLOCK_COUNT>());
-
-    int STU      = int(range.SIMDToUpper<VectorRegisterType::E_BLOCK_COUNT>());
-    int SIMDSize = STU - SFL;
-
-    VectorRegisterType         a, b(type(0));
-    VectorRegisterIteratorType iter(this->pointer() + SFL, std::size_t(SIMDSize));
-
-    if (SFL != SF)
-    {
-      iter.Next(a);
-      a = vector_zero_below_element(a,
-                                    VectorRegisterType::E_BLOCK_COUNT - (SF - int(range.from())));
-      b = vector_reduction(a, b);
-    }
-
-    for (int i = SF; i < ST; i += VectorRegisterType::E_BLOCK_COUNT)
-    {
-      iter.Next(a);
-      b = vector_reduction(a, b);
-    }
-
-    if (STU != ST)
-    {
-      iter.Next(a);
-      a = vector_zero_above_element(a, (int(range.to()) - ST - 1));
-      b = vector_reduction(a, b);
-    }
-
-    // TODO(issue 1): Make reduction tree / Wallace tree
-    type ret = 0;
-    for (std::size_t i = 0; i < VectorRegisterType::E_BLOCK_COUNT; ++i)
-    {
-      VectorRegisterType c(ret);
-      c   = vector_reduction(c, b);
-      ret = first_element(c);
-      b   = shift_elements_right(b);
+      self_iter.Next(self);
+      a_iter.Next(a_val);
+      tmp = vector_reduce(self, a_val);
+
+      int Q = (int(range.to()) - ST - 1);
+      for (int i = 0; i <= Q; ++i)
+      {
+        ret += first_element(tmp);
+        tmp = shift_elements_right(tmp);
+      }
     }
 
     return ret;
   }
 
-  type Reduce(type (*register_reduction)(type const &, type const &)) const
+  template <typename F>
+  type SumReduceRange(TrivialRange const &range, F &&vector_reduce)
   {
-    type        ret = 0;
-    std::size_t N   = this->size();
+    int SFL      = int(range.SIMDFromLower<VectorRegisterType::E_BLOCK_COUNT>());
+    int SF       = int(range.SIMDFromUpper<VectorRegisterType::E_BLOCK_COUNT>());
+    int ST       = int(range.SIMDToLower<VectorRegisterType::E_BLOCK_COUNT>());
+    int STU      = int(range.SIMDToUpper<VectorRegisterType::E_BLOCK_COUNT>());
+    int SIMDSize = STU - SFL;
 
-    for (std::size_t i = 0; i < N; ++i)
+    type                       ret = 0;
+    VectorRegisterIteratorType self_iter(this->pointer() + SFL, std::size_t(SIMDSize));
+    VectorRegisterType         c(type(0)), tmp, self;
+
+    // Taking care of thread
+    if (SFL != SF)
     {
-      ret = register_reduction(ret, pointer_[i]);
+      self_iter.Next(self);
+      tmp = vector_reduce(self);
+
+      int Q = VectorRegisterType::E_BLOCK_COUNT - (SF - int(range.from()));
+      for (int i = 0; i < VectorRegisterType::E_BLOCK_COUNT; ++i)
+      {
+        if (Q <= i)
+        {
+          ret += first_element(tmp);
+        }
+        tmp = shift_elements_right(tmp);
+      }
     }
 
-    return ret;
-  }
+    for (int i = SF; i < ST; i += VectorRegisterType::E_BLOCK_COUNT)
+    {
+      self_iter.Next(self);
+      tmp = vector_reduce(self);
+      c   = c + tmp;
+    }
 
-  type Reduce(TrivialRange const &range,
-              type (*register_reduction)(type const &, type const &)) const
-  {
-    type ret = 0;
-    for (std::size_t i = range.from(); i < range.to(); ++i)
+    ret += reduce(c);
+
+    // Taking care of the tail
+    if (STU != ST)
     {
-      ret = register_reduction(ret, pointer_[i]);
+      self_iter.Next(self);
+      tmp = vector_reduce(self);
+
+      int Q = (int(range.to()) - ST - 1);
+      for (int i = 0; i <= Q; ++i)
+      {
+        ret += first_element(tmp);
+        tmp = shift_elements_right(tmp);
+      }
     }
-    return ret;
-  }
 
-  type const *pointer() const
-  {
-    return pointer_;
-  }
-  std::size_t const &size() const
-  {
-    return size_;
-  }
-  std::size_t &size()
-  {
-    return size_;
+    return ret;
   }
 
-protected:
-  type *pointer()
-  {
-    return pointer_;
-  }
-  type *      pointer_;
-  std::size_t size_;
 
   template <typename G, typename... Args>
   static void InitializeVectorIterators(std::size_t const &offset, std::size_t const &size,
@@ -617,16 +837,18 @@ public:
   template <typename F>
   void Apply(F &&apply)
   {
-    VectorRegisterType c;
+    this->ForEachChunk(0, this->size(), [this, &apply](std::size_t /*index*/, std::size_t from,
+                                                       std::size_t to) {
+      VectorRegisterType c;
 
-    std::size_t N = this->size();
-    for (std::size_t i = 0; i < N; i += VectorRegisterType::E_BLOCK_COUNT)
-    {
-      assert(i < this->size());
-      apply(c);
+      for (std::size_t i = from; i < to; i += VectorRegisterType::E_BLOCK_COUNT)
+      {
+        assert(i < this->size());
+        apply(c);
 
-      c.Store(this->pointer() + i);
-    }
+        c.Store(this->pointer() + i);
+      }
+    });
   }
 
   template <typename... Args>
@@ -634,28 +856,147 @@ public:
                  Args...>::signature_type &&apply,
              Args &&... args)
   {
-    VectorRegisterType         regs[sizeof...(args)], c;
-    VectorRegisterIteratorType iters[sizeof...(args)];
-    ConstParallelDispatcher<T>::InitializeVectorIterators(0, this->size(), iters,
-                                                          std::forward<Args>(args)...);
+    this->ForEachChunk(0, this->size(), [this, &apply, &args...](std::size_t /*index*/,
+                                                                 std::size_t from, std::size_t to) {
+      VectorRegisterType         regs[sizeof...(args)], c;
+      VectorRegisterIteratorType iters[sizeof...(args)];
+      ConstParallelDispatcher<T>::InitializeVectorIterators(from, to - from, iters, args...);
 
-    std::size_t N = this->size();
-    for (std::size_t i = 0; i < N; i += VectorRegisterType::E_BLOCK_COUNT)
-    {
-      details::UnrollNext<sizeof...(args), VectorRegisterType, VectorRegisterIteratorType>::Apply(
-          regs, iters);
+      for (std::size_t i = from; i < to; i += VectorRegisterType::E_BLOCK_COUNT)
+      {
+        details::UnrollNext<sizeof...(args), VectorRegisterType, VectorRegisterIteratorType>::Apply(
+            regs, iters);
 
-      details::MatrixApplyFreeFunction<VectorRegisterType, void>::template Unroll<Args...>::Apply(
-          regs, std::move(apply), c);
+        details::MatrixApplyFreeFunction<VectorRegisterType, void>::template Unroll<Args...>::Apply(
+            regs, apply, c);
 
-      c.Store(this->pointer() + i);
-    }
+        c.Store(this->pointer() + i);
+      }
+    });
   }
 
   template <typename F>
   void Apply(TrivialRange const &range, F &&apply)
   {
+    this->ForEachChunk(range.from(), range.to(),
+                       [this, &apply](std::size_t /*index*/, std::size_t from, std::size_t to) {
+                         ApplyRange(TrivialRange(from, to), apply);
+                       });
+  }
+
+  template <typename... Args>
+  void Apply(TrivialRange const &range,
+             typename details::MatrixApplyFreeFunction<VectorRegisterType, void>::template Unroll<
+                 Args...>::signature_type const &apply,
+             Args &&... args)
+  {
+    this->ForEachChunk(range.from(), range.to(), [this, &apply, &args...](std::size_t /*index*/,
+                                                                          std::size_t from,
+                                                                          std::size_t to) {
+      ApplyRange<Args...>(TrivialRange(from, to), apply, args...);
+    });
+  }
+
+  template <class C, typename... Args>
+  void Apply(C const &cls,
+             typename details::MatrixApplyClassMember<C, VectorRegisterType, void>::template Unroll<
+                 Args...>::signature_type const &fnc,
+             Args &&... args)
+  {
+    this->ForEachChunk(0, super_type::size(), [this, &cls, &fnc, &args...](std::size_t /*index*/,
+                                                                          std::size_t from,
+                                                                          std::size_t to) {
+      VectorRegisterType         regs[sizeof...(args)];
+      VectorRegisterType         c;
+      VectorRegisterIteratorType iters[sizeof...(args)];
+      ConstParallelDispatcher<T>::InitializeVectorIterators(from, to - from, iters, args...);
+
+      for (std::size_t i = from; i < to; i += VectorRegisterType::E_BLOCK_COUNT)
+      {
+        details::UnrollNext<sizeof...(args), VectorRegisterType, VectorRegisterIteratorType>::Apply(
+            regs, iters);
+
+        details::MatrixApplyClassMember<C, VectorRegisterType, void>::template Unroll<
+            Args...>::Apply(regs, cls, fnc, c);
+        c.Store(this->pointer() + i);
+      }
+    });
+  }
+
+  template <class C, typename... Args>
+  void Apply(C const &cls,
+             typename details::MatrixApplyClassMember<C, type, void>::template Unroll<
+                 Args...>::signature_type const &fnc,
+             Args &&... args)
+  {
+    this->ForEachChunk(0, super_type::size(), [this, &cls, &fnc, &args...](std::size_t /*index*/,
+                                                                          std::size_t from,
+                                                                          std::size_t to) {
+      constexpr std::size_t R = sizeof...(args);
+      type const *          regs[R];
+      type                  c;
+
+      ConstParallelDispatcher<T>::SetPointers(from, to - from, regs, args...);
+
+      for (std::size_t i = from; i < to; ++i)
+      {
+        details::MatrixApplyClassMember<C, type, void>::template Unroll<Args...>::Apply(regs, cls,
+                                                                                        fnc, c);
+
+        this->pointer()[i] = c;
+
+        for (std::size_t j = 0; j < R; ++j)
+        {
+          ++regs[j];
+        }
+      }
+    });
+  }
+
+  template <class C, typename... Args>
+  typename std::enable_if<std::is_same<decltype(&C::operator()),
+                                       typename details::MatrixApplyClassMember<C, type, void>::
+                                           template Unroll<Args...>::signature_type>::value,
+                          void>::type
+  Apply(C const &cls, Args &&... args)
+  {
+    return Apply(cls, &C::operator(), std::forward<Args>(args)...);
+  }
+
+  template <class C, typename... Args>
+  typename std::enable_if<
+      std::is_same<decltype(&C::operator()),
+                   typename details::MatrixApplyClassMember<C, VectorRegisterType, void>::
+                       template Unroll<Args...>::signature_type>::value,
+      void>::type
+  Apply(C const &cls, Args &&... args)
+  {
+
+    return Apply(cls, &C::operator(), std::forward<Args>(args)...);
+  }
+
+  template <class C, typename... Args>
+  void Apply(TrivialRange const &range, C const &cls,
+             typename details::MatrixApplyClassMember<C, VectorRegisterType, void>::template Unroll<
+                 Args...>::signature_type &fnc,
+             Args &&... args)
+  {
+    this->ForEachChunk(range.from(), range.to(), [this, &cls, &fnc, &args...](
+                                                     std::size_t /*index*/, std::size_t from,
+                                                     std::size_t to) {
+      ApplyRange<C, Args...>(TrivialRange(from, to), cls, fnc, args...);
+    });
+  }
+
+  type *pointer()
+  {
+    return super_type::pointer();
+  }
 
+private:
+  template <typename F>
+  void ApplyRange(TrivialRange const &range, F &&apply)
+  {
     int SFL = int(range.SIMDFromLower<VectorRegisterType::E_BLOCK_COUNT>());
 
     int SF = int(range.SIMDFromUpper<VectorRegisterType::E_BLOCK_COUNT>());
@@ -702,12 +1043,11 @@ public:
   }
 
   template <typename... Args>
-  void Apply(TrivialRange const &range,
+  void ApplyRange(TrivialRange const &range,
              typename details::MatrixApplyFreeFunction<VectorRegisterType, void>::template Unroll<
                  Args...>::signature_type const &apply,
              Args &&... args)
   {
-
     int SFL = int(range.SIMDFromLower<VectorRegisterType::E_BLOCK_COUNT>());
 
     int SF = int(range.SIMDFromUpper<VectorRegisterType::E_BLOCK_COUNT>());
@@ -720,7 +1060,7 @@ public:
     VectorRegisterIteratorType iters[sizeof...(args)];
 
     ConstParallelDispatcher<T>::InitializeVectorIterators(std::size_t(SFL), std::size_t(SIMDSize),
-                                                          iters, std::forward<Args>(args)...);
+                                                          iters, args...);
 
     if (SFL != SF)
     {
@@ -770,90 +1110,11 @@ public:
   }
 
   template <class C, typename... Args>
-  void Apply(C const &cls,
-             typename details::MatrixApplyClassMember<C, VectorRegisterType, void>::template Unroll<
-                 Args...>::signature_type const &fnc,
-             Args &&... args)
-  {
-
-    VectorRegisterType         regs[sizeof...(args)];
-    VectorRegisterType         c;
-    VectorRegisterIteratorType iters[sizeof...(args)];
-    std::size_t                N = super_type::size();
-    ConstParallelDispatcher<T>::InitializeVectorIterators(0, N, iters, std::forward<Args>(args)...);
-
-    for (std::size_t i = 0; i < N; i += VectorRegisterType::E_BLOCK_COUNT)
-    {
-      //      assert(i < N);
-
-      details::UnrollNext<sizeof...(args), VectorRegisterType, VectorRegisterIteratorType>::Apply(
-          regs, iters);
-
-      details::MatrixApplyClassMember<C, VectorRegisterType, void>::template Unroll<Args...>::Apply(
-          regs, cls, fnc, c);
-      c.Store(this->pointer() + i);
-    }
-  }
-
-  template <class C, typename... Args>
-  void Apply(C const &cls,
-             typename details::MatrixApplyClassMember<C, type, void>::template Unroll<
-                 Args...>::signature_type const &fnc,
-             Args &&... args)
-  {
-
-    constexpr std::size_t R = sizeof...(args);
-    type const *          regs[R];
-    type                  c;
-
-    std::size_t N = super_type::size();
-
-    ConstParallelDispatcher<T>::SetPointers(0, N, regs, std::forward<Args>(args)...);
-
-    for (std::size_t i = 0; i < N; ++i)
-    {
-
-      details::MatrixApplyClassMember<C, type, void>::template Unroll<Args...>::Apply(regs, cls,
-                                                                                      fnc, c);
-
-      this->pointer()[i] = c;
-
-      for (std::size_t j = 0; j < R; ++j)
-      {
-        ++regs[j];
-      }
-    }
-  }
-
-  template <class C, typename... Args>
-  typename std::enable_if<std::is_same<decltype(&C::operator()),
-                                       typename details::MatrixApplyClassMember<C, type, void>::
-                                           template Unroll<Args...>::signature_type>::value,
-                          void>::type
-  Apply(C const &cls, Args &&... args)
-  {
-    return Apply(cls, &C::operator(), std::forward<Args>(args)...);
-  }
-
-  template <class C, typename... Args>
-  typename std::enable_if<
-      std::is_same<decltype(&C::operator()),
-                   typename details::MatrixApplyClassMember<C, VectorRegisterType, void>::
-                       template Unroll<Args...>::signature_type>::value,
-      void>::type
-  Apply(C const &cls, Args &&... args)
-  {
-
-    return Apply(cls, &C::operator(), std::forward<Args>(args)...);
-  }
-
-  template <class C, typename... Args>
-  void Apply(TrivialRange const &range, C const &cls,
+  void ApplyRange(TrivialRange const &range, C const &cls,
              typename details::MatrixApplyClassMember<C, VectorRegisterType, void>::template Unroll<
                  Args...>::signature_type &fnc,
              Args &&... args)
   {
-
     int SFL = int(range.SIMDFromLower<VectorRegisterType::E_BLOCK_COUNT>());
 
     int SF = int(range.SIMDFromUpper<VectorRegisterType::E_BLOCK_COUNT>());
@@ -865,7 +1126,7 @@ public:
     VectorRegisterType         regs[sizeof...(args)], c;
     VectorRegisterIteratorType iters[sizeof...(args)];
     ConstParallelDispatcher<T>::InitializeVectorIterators(std::size_t(SFL), std::size_t(SIMDSize),
-                                                          iters, std::forward<Args>(args)...);
+                                                          iters, args...);
 
     if (SFL != SF)
     {
@@ -911,13 +1172,6 @@ public:
       }
     }
   }
-
-  type *pointer()
-  {
-    return super_type::pointer();
-  }
-
-private:
 };
 
 }  // namespace memory
@@ -20,6 +20,10 @@
 #include "meta/type_traits.hpp"
 #include "vectorise/vectorise.hpp"
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#endif
+
 namespace fetch {
 namespace platform {
 
@@ -150,6 +154,40 @@ constexpr bool has_sse42()
 #endif
 }
 
+/**
+ * Determine at runtime if the CPU supports the AVX2 instruction set. Unlike has_avx2() this allows
+ * code which has been compiled for AVX2 to be selected even if the rest of the project has not.
+ *
+ * @return true if AVX2 is supported, otherwise false
+ */
+inline bool cpu_supports_avx2()
+{
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  static bool const supported = __builtin_cpu_supports("avx2") != 0;
+  return supported;
+#else
+  return false;
+#endif
+}
+
+/**
+ * Determine at runtime if the CPU supports the SHA extensions (hardware SHA-1 / SHA-256)
+ *
+ * @return true if the SHA extensions are supported, otherwise false
+ */
+inline bool cpu_supports_sha()
+{
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  static bool const supported = []() {
+    unsigned int eax{0}, ebx{0}, ecx{0}, edx{0};
+    return (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) != 0) && ((ebx & (1u << 29u)) != 0);
+  }();
+  return supported;
+#else
+  return false;
+#endif
+}
+
 // Allow the option of specifying our platform endianness
 #if defined(FETCH_PLATFORM_BIG_ENDIAN) || defined(FETCH_PLATFORM_LITTLE_ENDIAN)
 #else
@@ -0,0 +1,188 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+/* Work sharing loop over a fixed number of independent chunks.
+ *
+ * The chunks are claimed from a shared counter by the calling thread and by helper tasks on a
+ * process wide worker pool, so a slow or busy worker never holds up the rest of the loop. The
+ * calling thread always takes part and waits until every chunk has completed. Calls made from
+ * inside a chunk (i.e. nested loops) are executed serially on the current thread to avoid
+ * exhausting the pool.
+ */
+
+#include "vectorise/threading/pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace fetch {
+namespace threading {
+namespace details {
+
+inline std::size_t HardwareThreads()
+{
+  return std::max<std::size_t>(1u, std::thread::hardware_concurrency());
+}
+
+inline std::atomic<std::size_t> &ParallelForNumThreads()
+{
+  static std::atomic<std::size_t> num_threads{0};
+  return num_threads;
+}
+
+inline bool &InsideParallelFor()
+{
+  static thread_local bool inside{false};
+  return inside;
+}
+
+inline Pool &ParallelForPool()
+{
+  // one helper less than the number of cores since the calling thread always takes part
+  static Pool pool{std::max<std::size_t>(1u, HardwareThreads() - 1), "ParFor"};
+  return pool;
+}
+
+}  // namespace details
+
+/**
+ * Set the maximum number of threads (including the calling thread) used by a parallel loop
+ *
+ * @param num_threads The number of threads, zero selects the hardware concurrency
+ */
+inline void SetParallelForNumThreads(std::size_t num_threads)
+{
+  details::ParallelForNumThreads() = num_threads;
+}
+
+/**
+ * Get the maximum number of threads (including the calling thread) used by a parallel loop
+ *
+ * @return The number of threads
+ */
+inline std::size_t GetParallelForNumThreads()
+{
+  std::size_t const num_threads = details::ParallelForNumThreads();
+  return (num_threads == 0) ? details::HardwareThreads() : num_threads;
+}
+
+/**
+ * Execute the chunks [0, num_chunks) concurrently, returning once all of them have completed.
+ * The chunks must be independent of each other, the order in which they execute is undefined.
+ *
+ * @param num_chunks The number of chunks
+ * @param chunk The function to be called with the index of each chunk
+ */
+template <typename F>
+void ParallelFor(std::size_t num_chunks, F &&chunk)
+{
+  std::size_t const num_threads = std::min(GetParallelForNumThreads(), num_chunks);
+
+  if ((num_threads <= 1) || details::InsideParallelFor())
+  {
+    for (std::size_t i = 0; i < num_chunks; ++i)
+    {
+      chunk(i);
+    }
+
+    return;
+  }
+
+  // the job is shared with the helper tasks which might only be scheduled after the loop has
+  // completed, in which case they find no work left and never touch the chunk function
+  struct Job
+  {
+    std::function<void(std::size_t)> function;
+    std::size_t                      num_chunks{0};
+    std::atomic<std::size_t>         next{0};
+    std::mutex                       lock;
+    std::condition_variable          done_condition;
+    std::size_t                      done{0};
+    std::exception_ptr               error;
+  };
+
+  auto job        = std::make_shared<Job>();
+  job->function   = [&chunk](std::size_t index) { chunk(index); };
+  job->num_chunks = num_chunks;
+
+  auto const work = [](Job &job) {
+    bool &inside = details::InsideParallelFor();
+    inside       = true;
+
+    std::size_t        completed = 0;
+    std::exception_ptr error;
+    for (std::size_t index = job.next++; index < job.num_chunks; index = job.next++)
+    {
+      try
+      {
+        job.function(index);
+      }
+      catch (...)
+      {
+        error = std::current_exception();
+      }
+
+      ++completed;
+    }
+
+    inside = false;
+
+    if (completed != 0)
+    {
+      std::lock_guard<std::mutex> lock(job.lock);
+
+      if (error && !job.error)
+      {
+        job.error = error;
+      }
+
+      job.done += completed;
+      if (job.done == job.num_chunks)
+      {
+        job.done_condition.notify_all();
+      }
+    }
+  };
+
+  Pool &pool = details::ParallelForPool();
+  for (std::size_t i = 1; i < num_threads; ++i)
+  {
+    pool.Dispatch([job, work]() { work(*job); });
+  }
+
+  work(*job);
+
+  std::unique_lock<std::mutex> lock(job->lock);
+  job->done_condition.wait(lock, [&job]() { return job->done == job->num_chunks; });
+
+  if (job->error)
+  {
+    std::rethrow_exception(job->error);
+  }
+}
+
+}  // namespace threading
+}  // namespace fetch
@@ -0,0 +1,217 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/random/lcg.hpp"
+#include "vectorise/memory/shared_array.hpp"
+#include "vectorise/threading/parallel_for.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+using namespace fetch::memory;
+
+namespace {
+
+using data_type          = float;
+using array_type         = SharedArray<data_type>;
+using dispatcher_type    = ConstParallelDispatcher<data_type>;
+using VectorRegisterType = array_type::VectorRegisterType;
+
+// large enough to be split into several chunks, with a partial vector register at the end
+std::size_t const LARGE_SIZE = (3 * std::size_t(dispatcher_type::PARALLEL_THRESHOLD)) + 5;
+
+array_type MakeArray(std::size_t size)
+{
+  static fetch::random::LinearCongruentialGenerator lcg;
+
+  array_type array(size);
+  array.SetAllZero();
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    array[i] = static_cast<data_type>(lcg.AsDouble()) - 0.5f;
+  }
+
+  return array;
+}
+
+class ParallelDispatcherTests : public ::testing::TestWithParam<std::size_t>
+{
+protected:
+  void SetUp() override
+  {
+    fetch::threading::SetParallelForNumThreads(GetParam());
+  }
+
+  void TearDown() override
+  {
+    fetch::threading::SetParallelForNumThreads(0);
+  }
+};
+
+TEST_P(ParallelDispatcherTests, apply_matches_serial_evaluation)
+{
+  for (std::size_t size : {std::size_t{13}, LARGE_SIZE})
+  {
+    array_type a = MakeArray(size);
+    array_type b = MakeArray(size);
+    array_type c(size);
+
+    c.in_parallel().Apply(
+        [](VectorRegisterType const &x, VectorRegisterType const &y, VectorRegisterType &z) {
+          z = (x * y) + x;
+        },
+        a, b);
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      ASSERT_EQ(c[i], (a[i] * b[i]) + a[i]) << "size: " << size << " i: " << i;
+    }
+  }
+}
+
+TEST_P(ParallelDispatcherTests, apply_range_only_writes_range)
+{
+  array_type a        = MakeArray(LARGE_SIZE);
+  array_type c        = MakeArray(LARGE_SIZE);
+  array_type original = c.Copy();
+
+  TrivialRange const range(3, LARGE_SIZE - 7);
+  c.in_parallel().Apply(range,
+                        [](VectorRegisterType const &x, VectorRegisterType &z) { z = x + x; }, a);
+
+  for (std::size_t i = 0; i < LARGE_SIZE; ++i)
+  {
+    bool const      in_range = (range.from() <= i) && (i < range.to());
+    data_type const expected = in_range ? a[i] + a[i] : original[i];
+    ASSERT_EQ(c[i], expected) << "i: " << i;
+  }
+
+  // generators are applied to the range as well
+  c.in_parallel().Apply(range, [](VectorRegisterType &z) { z = VectorRegisterType(2.0f); });
+  for (std::size_t i = 0; i < LARGE_SIZE; ++i)
+  {
+    bool const      in_range = (range.from() <= i) && (i < range.to());
+    data_type const expected = in_range ? 2.0f : original[i];
+    ASSERT_EQ(c[i], expected) << "i: " << i;
+  }
+}
+
+TEST_P(ParallelDispatcherTests, reductions_match_serial_sum)
+{
+  array_type a = MakeArray(LARGE_SIZE);
+  array_type b = MakeArray(LARGE_SIZE);
+
+  double expected_sum{0};
+  double expected_product{0};
+  for (std::size_t i = 0; i < LARGE_SIZE; ++i)
+  {
+    expected_sum += static_cast<double>(a[i]);
+    expected_product += static_cast<double>(a[i]) * static_cast<double>(b[i]);
+  }
+
+  double const tolerance = 1e-6 * static_cast<double>(LARGE_SIZE);
+
+  EXPECT_NEAR(a.in_parallel().Reduce([](VectorRegisterType const &x,
+                                        VectorRegisterType const &y) { return x + y; }),
+              expected_sum, tolerance);
+  EXPECT_NEAR(a.in_parallel().Reduce(TrivialRange(0, LARGE_SIZE),
+                                     [](VectorRegisterType const &x,
+                                        VectorRegisterType const &y) { return x + y; }),
+              expected_sum, tolerance);
+  EXPECT_NEAR(a.in_parallel().SumReduce([](VectorRegisterType const &x) { return x; }),
+              expected_sum, tolerance);
+  EXPECT_NEAR(a.in_parallel().SumReduce(
+                  [](VectorRegisterType const &x, VectorRegisterType const &y) { return x * y; },
+                  b),
+              expected_product, tolerance);
+  EXPECT_NEAR(a.in_parallel().SumReduce(
+                  TrivialRange(0, LARGE_SIZE),
+                  [](VectorRegisterType const &x, VectorRegisterType const &y) { return x * y; },
+                  b),
+              expected_product, tolerance);
+}
+
+TEST_P(ParallelDispatcherTests, range_reductions_start_at_range)
+{
+  array_type a = MakeArray(LARGE_SIZE);
+
+  for (std::size_t from : {std::size_t{0}, std::size_t{5}, LARGE_SIZE / 3})
+  {
+    TrivialRange const range(from, LARGE_SIZE - 2);
+
+    double expected{0};
+    for (std::size_t i = range.from(); i < range.to(); ++i)
+    {
+      expected += static_cast<double>(a[i]);
+    }
+
+    EXPECT_NEAR(a.in_parallel().SumReduce(range, [](VectorRegisterType const &x) { return x; }),
+                expected, 1e-6 * static_cast<double>(LARGE_SIZE))
+        << "from: " << from;
+  }
+}
+
+TEST_P(ParallelDispatcherTests, reductions_are_deterministic)
+{
+  array_type a = MakeArray(LARGE_SIZE);
+
+  auto const sum = [&a]() {
+    return a.in_parallel().SumReduce(TrivialRange(1, LARGE_SIZE),
+                                     [](VectorRegisterType const &x) { return x * x; });
+  };
+
+  // the partial sums of the chunks are combined in the same order regardless of the threads
+  fetch::threading::SetParallelForNumThreads(1);
+  data_type const reference = sum();
+
+  fetch::threading::SetParallelForNumThreads(GetParam());
+  for (std::size_t i = 0; i < 5; ++i)
+  {
+    ASSERT_EQ(sum(), reference);
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(ThreadCounts, ParallelDispatcherTests, ::testing::Values(1, 2, 4));
+
+TEST(ParallelForTests, every_chunk_is_executed_once)
+{
+  fetch::threading::SetParallelForNumThreads(4);
+
+  std::vector<std::atomic<std::size_t>> counts(1000);
+  for (auto &count : counts)
+  {
+    count = 0;
+  }
+
+  fetch::threading::ParallelFor(counts.size(), [&counts](std::size_t index) {
+    // nested loops are executed on the current thread
+    fetch::threading::ParallelFor(3, [&counts, index](std::size_t) { ++counts[index]; });
+  });
+
+  for (auto const &count : counts)
+  {
+    EXPECT_EQ(count, 3u);
+  }
+
+  fetch::threading::SetParallelForNumThreads(0);
+}
+
+}  // namespace
@@ -0,0 +1,144 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm/compiler.hpp"
+#include "vm/module.hpp"
+#include "vm/variant.hpp"
+#include "vm/vm.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+using fetch::vm::Compiler;
+using fetch::vm::Executable;
+using fetch::vm::IR;
+using fetch::vm::Module;
+using fetch::vm::Variant;
+using fetch::vm::VM;
+
+// accumulation of a running total, the typical shape of the loops found in contracts
+char const *WHILE_LOOP = R"(
+  function main() : Int64
+    var total : Int64 = 0i64;
+    var i : Int64 = 0i64;
+    while (i < 10000i64)
+      total = total + i * 3i64;
+      i = i + 1i64;
+    endwhile
+    return total;
+  endfunction
+)";
+
+char const *FOR_RANGE_LOOP = R"(
+  function main() : Int64
+    var total : Int64 = 0i64;
+    for (i in 0:10000)
+      total += 7i64;
+      if (total > 1000000i64)
+        total -= 1000000i64;
+      endif
+    endfor
+    return total;
+  endfunction
+)";
+
+char const *FUNCTION_CALLS = R"(
+  function fee(amount : Int64, rate : Int64) : Int64
+    var fee : Int64 = amount * rate;
+    return fee - 1i64;
+  endfunction
+
+  function main() : Int64
+    var total : Int64 = 0i64;
+    var i : Int64 = 0i64;
+    while (i < 1000i64)
+      total = total + fee(i, 2i64);
+      i = i + 1i64;
+    endwhile
+    return total;
+  endfunction
+)";
+
+// tight numeric loop over a single primitive type
+std::string NumericLoop(std::string const &type, std::string const &zero, std::string const &one,
+                        std::string const &three)
+{
+  return "function main() : " + type + "\n" +
+         "  var total : " + type + " = " + zero + ";\n" +
+         "  var x : " + type + " = " + one + ";\n" +
+         "  var i : Int32 = 0;\n"
+         "  while (i < 10000)\n" +
+         "    total = total + x * " + three + ";\n" +
+         "    x = x + " + one + ";\n" +
+         "    i = i + 1;\n"
+         "  endwhile\n"
+         "  return total;\n"
+         "endfunction\n";
+}
+
+void Interpreter(benchmark::State &state, std::string const &source)
+{
+  Module                   module;
+  Compiler                 compiler{&module};
+  IR                       ir;
+  Executable               executable;
+  VM                       vm{&module};
+  std::vector<std::string> errors;
+
+  if (!compiler.Compile(source, "benchmark", ir, errors) ||
+      !vm.GenerateExecutable(ir, "benchmark", executable, errors))
+  {
+    throw std::runtime_error("unable to compile benchmark script");
+  }
+
+  std::string error;
+  Variant     output;
+  uint64_t    num_instructions{0};
+  for (auto _ : state)
+  {
+    if (!vm.Execute(executable, "main", error, output))
+    {
+      throw std::runtime_error(error);
+    }
+
+    num_instructions = vm.instruction_count();
+    benchmark::DoNotOptimize(output.primitive.i64);
+  }
+
+  // reported as instructions per second, the inverse of the time per instruction
+  state.counters["instructions"] = benchmark::Counter(
+      static_cast<double>(num_instructions), benchmark::Counter::kIsIterationInvariantRate);
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE(Interpreter, while_loop, WHILE_LOOP);
+BENCHMARK_CAPTURE(Interpreter, for_range_loop, FOR_RANGE_LOOP);
+BENCHMARK_CAPTURE(Interpreter, function_calls, FUNCTION_CALLS);
+
+BENCHMARK_CAPTURE(Interpreter, numeric_int32, NumericLoop("Int32", "0", "1", "3"));
+BENCHMARK_CAPTURE(Interpreter, numeric_int64, NumericLoop("Int64", "0i64", "1i64", "3i64"));
+BENCHMARK_CAPTURE(Interpreter, numeric_uint64, NumericLoop("UInt64", "0u64", "1u64", "3u64"));
+BENCHMARK_CAPTURE(Interpreter, numeric_float32, NumericLoop("Float32", "0.0f", "1.0f", "3.0f"));
+BENCHMARK_CAPTURE(Interpreter, numeric_float64, NumericLoop("Float64", "0.0", "1.0", "3.0"));
@@ -0,0 +1,300 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/serializers/stl_types.hpp"
+#include "vm/generator.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+/**
+ * Serialisers for the compiled form of a smart contract.
+ *
+ * The serialised executable only contains the generated byte code and the associated metadata. The
+ * type and opcode identifiers it contains are only meaningful in conjunction with a module that
+ * has been populated in exactly the same way as the one which was used to compile it.
+ */
+
+namespace fetch {
+namespace vm {
+
+template <typename T>
+void Serialize(T &s, AnnotationLiteral const &literal)
+{
+  s << static_cast<uint8_t>(literal.type);
+
+  switch (literal.type)
+  {
+  case AnnotationLiteralType::Boolean:
+    s << static_cast<uint8_t>(literal.boolean);
+    break;
+  case AnnotationLiteralType::Integer:
+    s << literal.integer;
+    break;
+  case AnnotationLiteralType::Real:
+    s << literal.real;
+    break;
+  case AnnotationLiteralType::String:
+  case AnnotationLiteralType::Identifier:
+    s << literal.str;
+    break;
+  case AnnotationLiteralType::Unknown:
+    break;
+  }
+}
+
+template <typename T>
+void Deserialize(T &s, AnnotationLiteral &literal)
+{
+  uint8_t type{0};
+  s >> type;
+
+  switch (static_cast<AnnotationLiteralType>(type))
+  {
+  case AnnotationLiteralType::Boolean:
+  {
+    uint8_t value{0};
+    s >> value;
+    literal.SetBoolean(value != 0);
+    break;
+  }
+  case AnnotationLiteralType::Integer:
+  {
+    int64_t value{0};
+    s >> value;
+    literal.SetInteger(value);
+    break;
+  }
+  case AnnotationLiteralType::Real:
+  {
+    double value{0};
+    s >> value;
+    literal.SetReal(value);
+    break;
+  }
+  case AnnotationLiteralType::String:
+  case AnnotationLiteralType::Identifier:
+  {
+    std::string value;
+    s >> value;
+
+    if (static_cast<AnnotationLiteralType>(type) == AnnotationLiteralType::String)
+    {
+      literal.SetString(value);
+    }
+    else
+    {
+      literal.SetIdentifier(value);
+    }
+    break;
+  }
+  case AnnotationLiteralType::Unknown:
+    literal = AnnotationLiteral{};
+    break;
+  default:
+    throw std::runtime_error("Invalid annotation literal type in serialised executable");
+  }
+}
+
+template <typename T>
+void Serialize(T &s, AnnotationElement const &element)
+{
+  s << static_cast<uint8_t>(element.type) << element.name << element.value;
+}
+
+template <typename T>
+void Deserialize(T &s, AnnotationElement &element)
+{
+  uint8_t type{0};
+  s >> type >> element.name >> element.value;
+  element.type = static_cast<AnnotationElementType>(type);
+}
+
+template <typename T>
+void Serialize(T &s, Annotation const &annotation)
+{
+  s << annotation.name << annotation.elements;
+}
+
+template <typename T>
+void Deserialize(T &s, Annotation &annotation)
+{
+  s >> annotation.name >> annotation.elements;
+}
+
+template <typename T>
+void Serialize(T &s, TypeInfo const &info)
+{
+  s << static_cast<uint8_t>(info.type_kind) << info.name << info.parameter_type_ids;
+}
+
+template <typename T>
+void Deserialize(T &s, TypeInfo &info)
+{
+  uint8_t type_kind{0};
+  s >> type_kind >> info.name >> info.parameter_type_ids;
+  info.type_kind = static_cast<TypeKind>(type_kind);
+}
+
+template <typename T>
+void Serialize(T &s, Executable::Instruction const &instruction)
+{
+  s << instruction.opcode << instruction.type_id << instruction.index << instruction.data;
+}
+
+template <typename T>
+void Deserialize(T &s, Executable::Instruction &instruction)
+{
+  s >> instruction.opcode >> instruction.type_id >> instruction.index >> instruction.data;
+}
+
+template <typename T>
+void Serialize(T &s, Executable::Variable const &variable)
+{
+  s << variable.name << variable.type_id << variable.scope_number;
+}
+
+template <typename T>
+void Deserialize(T &s, Executable::Variable &variable)
+{
+  s >> variable.name >> variable.type_id >> variable.scope_number;
+}
+
+template <typename T>
+void Serialize(T &s, Executable::Function const &function)
+{
+  s << function.name << function.annotations << static_cast<int32_t>(function.num_variables)
+    << static_cast<int32_t>(function.num_parameters) << function.return_type_id;
+
+  // the instruction and variable types are not default constructible and therefore are written
+  // (and read) element by element
+  s << static_cast<uint64_t>(function.variables.size());
+  for (auto const &variable : function.variables)
+  {
+    s << variable;
+  }
+
+  s << static_cast<uint64_t>(function.instructions.size());
+  for (auto const &instruction : function.instructions)
+  {
+    s << instruction;
+  }
+
+  s << function.pc_to_line_map_;
+}
+
+template <typename T>
+void Deserialize(T &s, Executable::Function &function)
+{
+  int32_t num_variables{0};
+  int32_t num_parameters{0};
+  s >> function.name >> function.annotations >> num_variables >> num_parameters >>
+      function.return_type_id;
+
+  function.num_variables  = num_variables;
+  function.num_parameters = num_parameters;
+
+  uint64_t num_elements{0};
+  s >> num_elements;
+
+  function.variables.clear();
+  for (uint64_t i = 0; i < num_elements; ++i)
+  {
+    Executable::Variable variable{std::string{}, TypeIds::Unknown, 0};
+    s >> variable;
+    function.variables.push_back(std::move(variable));
+  }
+
+  s >> num_elements;
+
+  function.instructions.clear();
+  for (uint64_t i = 0; i < num_elements; ++i)
+  {
+    Executable::Instruction instruction{0};
+    s >> instruction;
+    function.instructions.push_back(instruction);
+  }
+
+  s >> function.pc_to_line_map_;
+}
+
+template <typename T>
+void Serialize(T &s, Executable const &executable)
+{
+  s << executable.name << executable.strings;
+
+  // only primitive constants are ever generated by the compiler
+  s << static_cast<uint64_t>(executable.constants.size());
+  for (auto const &constant : executable.constants)
+  {
+    if (!constant.IsPrimitive())
+    {
+      throw std::runtime_error("Unable to serialise non primitive executable constant");
+    }
+
+    s << constant.type_id << constant.primitive.ui64;
+  }
+
+  s << executable.types << static_cast<uint64_t>(executable.functions.size());
+  for (auto const &function : executable.functions)
+  {
+    s << function;
+  }
+}
+
+template <typename T>
+void Deserialize(T &s, Executable &executable)
+{
+  s >> executable.name >> executable.strings;
+
+  uint64_t num_elements{0};
+  s >> num_elements;
+
+  executable.constants.clear();
+  for (uint64_t i = 0; i < num_elements; ++i)
+  {
+    TypeId    type_id{TypeIds::Unknown};
+    Primitive value{};
+    s >> type_id >> value.ui64;
+
+    executable.constants.emplace_back(value, type_id);
+
+    if (!executable.constants.back().IsPrimitive())
+    {
+      throw std::runtime_error("Invalid executable constant in serialised executable");
+    }
+  }
+
+  s >> executable.types >> num_elements;
+
+  executable.functions.clear();
+  executable.function_map.clear();
+  for (uint64_t i = 0; i < num_elements; ++i)
+  {
+    Executable::Function function{std::string{}, AnnotationArray{}, 0, TypeIds::Unknown};
+    s >> function;
+
+    // also rebuilds the function lookup map
+    executable.AddFunction(function);
+  }
+}
+
+}  // namespace vm
+}  // namespace fetch
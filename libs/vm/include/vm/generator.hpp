@@ -321,6 +321,9 @@ private:
                                uint16_t opcode3, uint16_t opcode4, TypeId &type_id,
                                TypeId &other_type_id);
 
+  static uint16_t GetSpecialisedOpcode(uint16_t opcode, TypeId type_id);
+  static uint16_t GetGenericOpcode(uint16_t opcode);
+
   friend class VM;
 };
 
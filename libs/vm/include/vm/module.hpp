@@ -234,6 +234,18 @@ public:
     return ClassInterface<Type>(this, type_index);
   }
 
+  // The type and function tables, in id order. These are only populated once a Compiler has been
+  // constructed against the module
+  TypeInfoArray const &type_info_array() const
+  {
+    return type_info_array_;
+  }
+
+  FunctionInfoArray const &function_info_array() const
+  {
+    return function_info_array_;
+  }
+
 private:
   void CompilerSetup(Compiler *compiler)
   {
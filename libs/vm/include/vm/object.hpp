@@ -209,6 +209,10 @@ public:
   virtual bool SerializeTo(ByteArrayBuffer &buffer);
   virtual bool DeserializeFrom(ByteArrayBuffer &buffer);
 
+  // Objects are allocated from the arena of the executing thread (if there is one)
+  static void *operator new(std::size_t size);
+  static void  operator delete(void *ptr) noexcept;
+
 protected:
   Variant &       Push();
   Variant &       Pop();
@@ -23,86 +23,155 @@ namespace fetch {
 namespace vm {
 
 namespace Opcodes {
-static const uint16_t Unknown                            = 0;
-static const uint16_t VariableDeclare                    = 1;
-static const uint16_t VariableDeclareAssign              = 2;
-static const uint16_t PushNull                           = 3;
-static const uint16_t PushFalse                          = 4;
-static const uint16_t PushTrue                           = 5;
-static const uint16_t PushString                         = 6;
-static const uint16_t PushConstant                       = 7;
-static const uint16_t PushVariable                       = 8;
-static const uint16_t PopToVariable                      = 9;
-static const uint16_t Inc                                = 10;
-static const uint16_t Dec                                = 11;
-static const uint16_t Duplicate                          = 12;
-static const uint16_t DuplicateInsert                    = 13;
-static const uint16_t Discard                            = 14;
-static const uint16_t Destruct                           = 15;
-static const uint16_t Break                              = 16;
-static const uint16_t Continue                           = 17;
-static const uint16_t Jump                               = 18;
-static const uint16_t JumpIfFalse                        = 19;
-static const uint16_t JumpIfTrue                         = 20;
-static const uint16_t Return                             = 21;
-static const uint16_t ReturnValue                        = 22;
-static const uint16_t ForRangeInit                       = 23;
-static const uint16_t ForRangeIterate                    = 24;
-static const uint16_t ForRangeTerminate                  = 25;
-static const uint16_t InvokeUserDefinedFreeFunction      = 26;
-static const uint16_t VariablePrefixInc                  = 27;
-static const uint16_t VariablePrefixDec                  = 28;
-static const uint16_t VariablePostfixInc                 = 29;
-static const uint16_t VariablePostfixDec                 = 30;
-static const uint16_t And                                = 31;
-static const uint16_t Or                                 = 32;
-static const uint16_t Not                                = 33;
-static const uint16_t PrimitiveEqual                     = 34;
-static const uint16_t ObjectEqual                        = 35;
-static const uint16_t PrimitiveNotEqual                  = 36;
-static const uint16_t ObjectNotEqual                     = 37;
-static const uint16_t PrimitiveLessThan                  = 38;
-static const uint16_t ObjectLessThan                     = 39;
-static const uint16_t PrimitiveLessThanOrEqual           = 40;
-static const uint16_t ObjectLessThanOrEqual              = 41;
-static const uint16_t PrimitiveGreaterThan               = 42;
-static const uint16_t ObjectGreaterThan                  = 43;
-static const uint16_t PrimitiveGreaterThanOrEqual        = 44;
-static const uint16_t ObjectGreaterThanOrEqual           = 45;
-static const uint16_t PrimitiveNegate                    = 46;
-static const uint16_t ObjectNegate                       = 47;
-static const uint16_t PrimitiveAdd                       = 48;
-static const uint16_t ObjectAdd                          = 49;
-static const uint16_t ObjectLeftAdd                      = 50;
-static const uint16_t ObjectRightAdd                     = 51;
-static const uint16_t VariablePrimitiveInplaceAdd        = 52;
-static const uint16_t VariableObjectInplaceAdd           = 53;
-static const uint16_t VariableObjectInplaceRightAdd      = 54;
-static const uint16_t PrimitiveSubtract                  = 55;
-static const uint16_t ObjectSubtract                     = 56;
-static const uint16_t ObjectLeftSubtract                 = 57;
-static const uint16_t ObjectRightSubtract                = 58;
-static const uint16_t VariablePrimitiveInplaceSubtract   = 59;
-static const uint16_t VariableObjectInplaceSubtract      = 60;
-static const uint16_t VariableObjectInplaceRightSubtract = 61;
-static const uint16_t PrimitiveMultiply                  = 62;
-static const uint16_t ObjectMultiply                     = 63;
-static const uint16_t ObjectLeftMultiply                 = 64;
-static const uint16_t ObjectRightMultiply                = 65;
-static const uint16_t VariablePrimitiveInplaceMultiply   = 66;
-static const uint16_t VariableObjectInplaceMultiply      = 67;
-static const uint16_t VariableObjectInplaceRightMultiply = 68;
-static const uint16_t PrimitiveDivide                    = 69;
-static const uint16_t ObjectDivide                       = 70;
-static const uint16_t ObjectLeftDivide                   = 71;
-static const uint16_t ObjectRightDivide                  = 72;
-static const uint16_t VariablePrimitiveInplaceDivide     = 73;
-static const uint16_t VariableObjectInplaceDivide        = 74;
-static const uint16_t VariableObjectInplaceRightDivide   = 75;
-static const uint16_t PrimitiveModulo                    = 76;
-static const uint16_t VariablePrimitiveInplaceModulo     = 77;
-static const uint16_t NumReserved                        = 78;
+static const uint16_t Unknown                                 = 0;
+static const uint16_t VariableDeclare                         = 1;
+static const uint16_t VariableDeclareAssign                   = 2;
+static const uint16_t PushNull                                = 3;
+static const uint16_t PushFalse                               = 4;
+static const uint16_t PushTrue                                = 5;
+static const uint16_t PushString                              = 6;
+static const uint16_t PushConstant                            = 7;
+static const uint16_t PushVariable                            = 8;
+static const uint16_t PopToVariable                           = 9;
+static const uint16_t Inc                                     = 10;
+static const uint16_t Dec                                     = 11;
+static const uint16_t Duplicate                               = 12;
+static const uint16_t DuplicateInsert                         = 13;
+static const uint16_t Discard                                 = 14;
+static const uint16_t Destruct                                = 15;
+static const uint16_t Break                                   = 16;
+static const uint16_t Continue                                = 17;
+static const uint16_t Jump                                    = 18;
+static const uint16_t JumpIfFalse                             = 19;
+static const uint16_t JumpIfTrue                              = 20;
+static const uint16_t Return                                  = 21;
+static const uint16_t ReturnValue                             = 22;
+static const uint16_t ForRangeInit                            = 23;
+static const uint16_t ForRangeIterate                         = 24;
+static const uint16_t ForRangeTerminate                       = 25;
+static const uint16_t InvokeUserDefinedFreeFunction           = 26;
+static const uint16_t VariablePrefixInc                       = 27;
+static const uint16_t VariablePrefixDec                       = 28;
+static const uint16_t VariablePostfixInc                      = 29;
+static const uint16_t VariablePostfixDec                      = 30;
+static const uint16_t And                                     = 31;
+static const uint16_t Or                                      = 32;
+static const uint16_t Not                                     = 33;
+static const uint16_t PrimitiveEqual                          = 34;
+static const uint16_t ObjectEqual                             = 35;
+static const uint16_t PrimitiveNotEqual                       = 36;
+static const uint16_t ObjectNotEqual                          = 37;
+static const uint16_t PrimitiveLessThan                       = 38;
+static const uint16_t ObjectLessThan                          = 39;
+static const uint16_t PrimitiveLessThanOrEqual                = 40;
+static const uint16_t ObjectLessThanOrEqual                   = 41;
+static const uint16_t PrimitiveGreaterThan                    = 42;
+static const uint16_t ObjectGreaterThan                       = 43;
+static const uint16_t PrimitiveGreaterThanOrEqual             = 44;
+static const uint16_t ObjectGreaterThanOrEqual                = 45;
+static const uint16_t PrimitiveNegate                         = 46;
+static const uint16_t ObjectNegate                            = 47;
+static const uint16_t PrimitiveAdd                            = 48;
+static const uint16_t ObjectAdd                               = 49;
+static const uint16_t ObjectLeftAdd                           = 50;
+static const uint16_t ObjectRightAdd                          = 51;
+static const uint16_t VariablePrimitiveInplaceAdd             = 52;
+static const uint16_t VariableObjectInplaceAdd                = 53;
+static const uint16_t VariableObjectInplaceRightAdd           = 54;
+static const uint16_t PrimitiveSubtract                       = 55;
+static const uint16_t ObjectSubtract                          = 56;
+static const uint16_t ObjectLeftSubtract                      = 57;
+static const uint16_t ObjectRightSubtract                     = 58;
+static const uint16_t VariablePrimitiveInplaceSubtract        = 59;
+static const uint16_t VariableObjectInplaceSubtract           = 60;
+static const uint16_t VariableObjectInplaceRightSubtract      = 61;
+static const uint16_t PrimitiveMultiply                       = 62;
+static const uint16_t ObjectMultiply                          = 63;
+static const uint16_t ObjectLeftMultiply                      = 64;
+static const uint16_t ObjectRightMultiply                     = 65;
+static const uint16_t VariablePrimitiveInplaceMultiply        = 66;
+static const uint16_t VariableObjectInplaceMultiply           = 67;
+static const uint16_t VariableObjectInplaceRightMultiply      = 68;
+static const uint16_t PrimitiveDivide                         = 69;
+static const uint16_t ObjectDivide                            = 70;
+static const uint16_t ObjectLeftDivide                        = 71;
+static const uint16_t ObjectRightDivide                       = 72;
+static const uint16_t VariablePrimitiveInplaceDivide          = 73;
+static const uint16_t VariableObjectInplaceDivide             = 74;
+static const uint16_t VariableObjectInplaceRightDivide        = 75;
+static const uint16_t PrimitiveModulo                         = 76;
+static const uint16_t VariablePrimitiveInplaceModulo          = 77;
+
+// type specialised primitive opcodes
+static const uint16_t PushPrimitiveVariable                   = 78;
+static const uint16_t PopToPrimitiveVariable                  = 79;
+static const uint16_t PrimitiveAddInt32                       = 80;
+static const uint16_t PrimitiveSubtractInt32                  = 81;
+static const uint16_t PrimitiveMultiplyInt32                  = 82;
+static const uint16_t PrimitiveEqualInt32                     = 83;
+static const uint16_t PrimitiveNotEqualInt32                  = 84;
+static const uint16_t PrimitiveLessThanInt32                  = 85;
+static const uint16_t PrimitiveLessThanOrEqualInt32           = 86;
+static const uint16_t PrimitiveGreaterThanInt32               = 87;
+static const uint16_t PrimitiveGreaterThanOrEqualInt32        = 88;
+static const uint16_t VariablePrimitiveInplaceAddInt32        = 89;
+static const uint16_t VariablePrimitiveInplaceSubtractInt32   = 90;
+static const uint16_t VariablePrimitiveInplaceMultiplyInt32   = 91;
+static const uint16_t PrimitiveAddInt64                       = 92;
+static const uint16_t PrimitiveSubtractInt64                  = 93;
+static const uint16_t PrimitiveMultiplyInt64                  = 94;
+static const uint16_t PrimitiveEqualInt64                     = 95;
+static const uint16_t PrimitiveNotEqualInt64                  = 96;
+static const uint16_t PrimitiveLessThanInt64                  = 97;
+static const uint16_t PrimitiveLessThanOrEqualInt64           = 98;
+static const uint16_t PrimitiveGreaterThanInt64               = 99;
+static const uint16_t PrimitiveGreaterThanOrEqualInt64        = 100;
+static const uint16_t VariablePrimitiveInplaceAddInt64        = 101;
+static const uint16_t VariablePrimitiveInplaceSubtractInt64   = 102;
+static const uint16_t VariablePrimitiveInplaceMultiplyInt64   = 103;
+static const uint16_t PrimitiveAddUInt64                      = 104;
+static const uint16_t PrimitiveSubtractUInt64                 = 105;
+static const uint16_t PrimitiveMultiplyUInt64                 = 106;
+static const uint16_t PrimitiveEqualUInt64                    = 107;
+static const uint16_t PrimitiveNotEqualUInt64                 = 108;
+static const uint16_t PrimitiveLessThanUInt64                 = 109;
+static const uint16_t PrimitiveLessThanOrEqualUInt64          = 110;
+static const uint16_t PrimitiveGreaterThanUInt64              = 111;
+static const uint16_t PrimitiveGreaterThanOrEqualUInt64       = 112;
+static const uint16_t VariablePrimitiveInplaceAddUInt64       = 113;
+static const uint16_t VariablePrimitiveInplaceSubtractUInt64  = 114;
+static const uint16_t VariablePrimitiveInplaceMultiplyUInt64  = 115;
+static const uint16_t PrimitiveAddFloat32                     = 116;
+static const uint16_t PrimitiveSubtractFloat32                = 117;
+static const uint16_t PrimitiveMultiplyFloat32                = 118;
+static const uint16_t PrimitiveEqualFloat32                   = 119;
+static const uint16_t PrimitiveNotEqualFloat32                = 120;
+static const uint16_t PrimitiveLessThanFloat32                = 121;
+static const uint16_t PrimitiveLessThanOrEqualFloat32         = 122;
+static const uint16_t PrimitiveGreaterThanFloat32             = 123;
+static const uint16_t PrimitiveGreaterThanOrEqualFloat32      = 124;
+static const uint16_t VariablePrimitiveInplaceAddFloat32      = 125;
+static const uint16_t VariablePrimitiveInplaceSubtractFloat32 = 126;
+static const uint16_t VariablePrimitiveInplaceMultiplyFloat32 = 127;
+static const uint16_t PrimitiveAddFloat64                     = 128;
+static const uint16_t PrimitiveSubtractFloat64                = 129;
+static const uint16_t PrimitiveMultiplyFloat64                = 130;
+static const uint16_t PrimitiveEqualFloat64                   = 131;
+static const uint16_t PrimitiveNotEqualFloat64                = 132;
+static const uint16_t PrimitiveLessThanFloat64                = 133;
+static const uint16_t PrimitiveLessThanOrEqualFloat64         = 134;
+static const uint16_t PrimitiveGreaterThanFloat64             = 135;
+static const uint16_t PrimitiveGreaterThanOrEqualFloat64      = 136;
+static const uint16_t VariablePrimitiveInplaceAddFloat64      = 137;
+static const uint16_t VariablePrimitiveInplaceSubtractFloat64 = 138;
+static const uint16_t VariablePrimitiveInplaceMultiplyFloat64 = 139;
+static const uint16_t NumReserved                             = 140;
 }  // namespace Opcodes
 
+// The version of the serialised bytecode format. It must be incremented whenever an opcode above is
+// added, removed or renumbered, or the serialised layout of an Executable changes, since persisted
+// executables are keyed on it
+static const uint16_t BYTECODE_FORMAT_VERSION = 2;
+
 }  // namespace vm
 }  // namespace fetch
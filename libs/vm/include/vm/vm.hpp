@@ -23,8 +23,10 @@
 #include "vm/string.hpp"
 #include "vm/variant.hpp"
 #include <cassert>
+#include <cstdint>
 #include <iostream>
 #include <sstream>
+#include <vector>
 
 namespace fetch {
 namespace vm {
@@ -387,6 +389,17 @@ public:
     output_buffer_ << line << '\n';
   }
 
+  /**
+   * Get the number of instructions executed by the last execution, a superinstruction counts as
+   * each of the instructions that it replaces
+   *
+   * @return The number of instructions
+   */
+  uint64_t instruction_count() const
+  {
+    return instruction_count_;
+  }
+
   // These two are public for the benefit of the static Constructor() functions in
   // each of the Object-derived classes
   void            RuntimeError(std::string const &message);
@@ -415,9 +428,30 @@ private:
   using OpcodeInfoArray = std::vector<OpcodeInfo>;
   using OpcodeMap       = std::unordered_map<std::string, uint16_t>;
 
+  // Each instruction of a function is pre-decoded to the handler which the interpreter dispatches
+  // to. Handler identifiers below NumReserved are the opcode handlers, the remainder are the
+  // superinstructions (fused sequences of common instructions) and the generic handlers.
+  using DispatchArray     = std::vector<uint16_t>;
+  using DispatchArrayList = std::vector<DispatchArray>;
+
+  struct Dispatch
+  {
+    static const uint16_t LocalConstantOp          = Opcodes::NumReserved;
+    static const uint16_t LocalLocalOp             = Opcodes::NumReserved + 1;
+    static const uint16_t LocalConstantOpPop       = Opcodes::NumReserved + 2;
+    static const uint16_t LocalLocalOpPop          = Opcodes::NumReserved + 3;
+    static const uint16_t LocalConstantCompareJump = Opcodes::NumReserved + 4;
+    static const uint16_t LocalLocalCompareJump    = Opcodes::NumReserved + 5;
+    static const uint16_t ConstantInplaceOp        = Opcodes::NumReserved + 6;
+    static const uint16_t ModuleFunction           = Opcodes::NumReserved + 7;
+    static const uint16_t Unknown                  = Opcodes::NumReserved + 8;
+    static const uint16_t NumHandlers              = Opcodes::NumReserved + 9;
+  };
+
   struct Frame
   {
     Executable::Function const *function;
+    uint16_t const *            dispatch;
     int                         bsp;
     uint16_t                    pc;
   };
@@ -462,6 +496,9 @@ private:
   Generator                      generator_;
   Executable const *             executable_;
   Executable::Function const *   function_;
+  DispatchArrayList              dispatch_arrays_;
+  uint16_t const *               dispatch_{nullptr};
+  uint64_t                       instruction_count_{0};
   std::vector<Ptr<String>>       strings_;
   Frame                          frame_stack_[FRAME_STACK_SIZE];
   int                            frame_sp_;
@@ -487,8 +524,11 @@ private:
     opcode_info_array_[opcode] = OpcodeInfo(name, handler);
   }
 
-  bool Execute(std::string &error, Variant &output);
-  void Destruct(uint16_t scope_number);
+  bool            Execute(std::string &error, Variant &output);
+  void            Destruct(uint16_t scope_number);
+  void            Run();
+  uint16_t const *GetDispatchArray(Executable::Function const *function);
+  uint16_t        Decode(Executable::InstructionArray const &instructions, std::size_t pc) const;
 
   TypeId FindType(std::string const &name) const
   {
@@ -1369,6 +1409,56 @@ private:
     DoNumericInplaceOp<Op>(instruction_->type_id, &variable.primitive);
   }
 
+  // The operands of the type specialised opcodes are known to be primitives of the type T, so the
+  // runtime type switch is not needed and the stack entries are released without the checks of
+  // Variant::Reset
+  template <typename Op, typename T>
+  void ApplyTypedNumericOp(Variant &lhsv, Variant const &rhsv)
+  {
+    T lhs = lhsv.primitive.Get<T>();
+    T rhs = rhsv.primitive.Get<T>();
+    Op::Apply(this, lhs, rhs);
+    lhsv.primitive.Set(lhs);
+  }
+
+  template <typename Op, typename T>
+  void ApplyTypedRelationalOp(Variant &lhsv, Variant const &rhsv)
+  {
+    T lhs = lhsv.primitive.Get<T>();
+    T rhs = rhsv.primitive.Get<T>();
+    Op::Apply(lhsv, lhs, rhs);
+  }
+
+  template <typename Op, typename T>
+  void DoTypedNumericOp()
+  {
+    Variant &rhsv = Pop();
+    ApplyTypedNumericOp<Op, T>(Top(), rhsv);
+    rhsv.type_id = TypeIds::Unknown;
+  }
+
+  template <typename Op, typename T>
+  void DoTypedRelationalOp()
+  {
+    Variant &rhsv = Pop();
+    ApplyTypedRelationalOp<Op, T>(Top(), rhsv);
+    rhsv.type_id = TypeIds::Unknown;
+  }
+
+  template <typename Op, typename T>
+  void DoTypedVariableNumericInplaceOp()
+  {
+    Variant &rhsv = Pop();
+    ApplyTypedNumericOp<Op, T>(GetVariable(instruction_->index), rhsv);
+    rhsv.type_id = TypeIds::Unknown;
+  }
+
+  static void CopyPrimitive(Variant &dest, Variant const &src)
+  {
+    dest.primitive = src.primitive;
+    dest.type_id   = src.type_id;
+  }
+
   template <typename Op>
   void DoVariableObjectInplaceOp()
   {
@@ -1464,6 +1554,87 @@ private:
   void Handler__PrimitiveModulo();
   void Handler__VariablePrimitiveInplaceModulo();
 
+  //
+  // Type specialised opcode handler prototypes
+  //
+
+  void Handler__PushPrimitiveVariable();
+  void Handler__PopToPrimitiveVariable();
+  void Handler__PrimitiveAddInt32();
+  void Handler__PrimitiveSubtractInt32();
+  void Handler__PrimitiveMultiplyInt32();
+  void Handler__PrimitiveEqualInt32();
+  void Handler__PrimitiveNotEqualInt32();
+  void Handler__PrimitiveLessThanInt32();
+  void Handler__PrimitiveLessThanOrEqualInt32();
+  void Handler__PrimitiveGreaterThanInt32();
+  void Handler__PrimitiveGreaterThanOrEqualInt32();
+  void Handler__VariablePrimitiveInplaceAddInt32();
+  void Handler__VariablePrimitiveInplaceSubtractInt32();
+  void Handler__VariablePrimitiveInplaceMultiplyInt32();
+  void Handler__PrimitiveAddInt64();
+  void Handler__PrimitiveSubtractInt64();
+  void Handler__PrimitiveMultiplyInt64();
+  void Handler__PrimitiveEqualInt64();
+  void Handler__PrimitiveNotEqualInt64();
+  void Handler__PrimitiveLessThanInt64();
+  void Handler__PrimitiveLessThanOrEqualInt64();
+  void Handler__PrimitiveGreaterThanInt64();
+  void Handler__PrimitiveGreaterThanOrEqualInt64();
+  void Handler__VariablePrimitiveInplaceAddInt64();
+  void Handler__VariablePrimitiveInplaceSubtractInt64();
+  void Handler__VariablePrimitiveInplaceMultiplyInt64();
+  void Handler__PrimitiveAddUInt64();
+  void Handler__PrimitiveSubtractUInt64();
+  void Handler__PrimitiveMultiplyUInt64();
+  void Handler__PrimitiveEqualUInt64();
+  void Handler__PrimitiveNotEqualUInt64();
+  void Handler__PrimitiveLessThanUInt64();
+  void Handler__PrimitiveLessThanOrEqualUInt64();
+  void Handler__PrimitiveGreaterThanUInt64();
+  void Handler__PrimitiveGreaterThanOrEqualUInt64();
+  void Handler__VariablePrimitiveInplaceAddUInt64();
+  void Handler__VariablePrimitiveInplaceSubtractUInt64();
+  void Handler__VariablePrimitiveInplaceMultiplyUInt64();
+  void Handler__PrimitiveAddFloat32();
+  void Handler__PrimitiveSubtractFloat32();
+  void Handler__PrimitiveMultiplyFloat32();
+  void Handler__PrimitiveEqualFloat32();
+  void Handler__PrimitiveNotEqualFloat32();
+  void Handler__PrimitiveLessThanFloat32();
+  void Handler__PrimitiveLessThanOrEqualFloat32();
+  void Handler__PrimitiveGreaterThanFloat32();
+  void Handler__PrimitiveGreaterThanOrEqualFloat32();
+  void Handler__VariablePrimitiveInplaceAddFloat32();
+  void Handler__VariablePrimitiveInplaceSubtractFloat32();
+  void Handler__VariablePrimitiveInplaceMultiplyFloat32();
+  void Handler__PrimitiveAddFloat64();
+  void Handler__PrimitiveSubtractFloat64();
+  void Handler__PrimitiveMultiplyFloat64();
+  void Handler__PrimitiveEqualFloat64();
+  void Handler__PrimitiveNotEqualFloat64();
+  void Handler__PrimitiveLessThanFloat64();
+  void Handler__PrimitiveLessThanOrEqualFloat64();
+  void Handler__PrimitiveGreaterThanFloat64();
+  void Handler__PrimitiveGreaterThanOrEqualFloat64();
+  void Handler__VariablePrimitiveInplaceAddFloat64();
+  void Handler__VariablePrimitiveInplaceSubtractFloat64();
+  void Handler__VariablePrimitiveInplaceMultiplyFloat64();
+
+  //
+  // Superinstruction handler prototypes
+  //
+
+  void ExecuteFusedOp(uint16_t opcode, TypeId type_id, Variant &lhsv, Variant &rhsv);
+  void Handler__LocalConstantOp();
+  void Handler__LocalLocalOp();
+  void Handler__LocalConstantOpPop();
+  void Handler__LocalLocalOpPop();
+  void Handler__LocalConstantCompareJump();
+  void Handler__LocalLocalCompareJump();
+  void Handler__ConstantInplaceOp();
+  void Handler__ModuleFunction();
+
   friend class Object;
   friend class Module;
   friend class Generator;
@@ -21,6 +21,28 @@
 
 namespace fetch {
 namespace vm {
+namespace {
+
+// The generic primitive opcodes which have type specialised versions. The specialised opcodes of
+// each type are consecutive and follow the order of this list.
+uint16_t const SPECIALISED_OPCODES[] = {
+    Opcodes::PrimitiveAdd,
+    Opcodes::PrimitiveSubtract,
+    Opcodes::PrimitiveMultiply,
+    Opcodes::PrimitiveEqual,
+    Opcodes::PrimitiveNotEqual,
+    Opcodes::PrimitiveLessThan,
+    Opcodes::PrimitiveLessThanOrEqual,
+    Opcodes::PrimitiveGreaterThan,
+    Opcodes::PrimitiveGreaterThanOrEqual,
+    Opcodes::VariablePrimitiveInplaceAdd,
+    Opcodes::VariablePrimitiveInplaceSubtract,
+    Opcodes::VariablePrimitiveInplaceMultiply};
+
+std::size_t const NUM_SPECIALISED_OPCODES =
+    sizeof(SPECIALISED_OPCODES) / sizeof(SPECIALISED_OPCODES[0]);
+
+}  // namespace
 
 Generator::Generator()
 {
@@ -698,7 +720,8 @@ void Generator::HandleVariableAssignmentStatement(IRExpressionNodePtr const &lhs
 {
   IRVariablePtr const &v = lhs->variable;
   HandleExpression(rhs);
-  Executable::Instruction instruction(Opcodes::PopToVariable);
+  Executable::Instruction instruction(v->type->IsPrimitive() ? Opcodes::PopToPrimitiveVariable
+                                                             : Opcodes::PopToVariable);
   instruction.type_id = v->type->resolved_id;
   instruction.index   = v->index;
   uint16_t pc         = function_->AddInstruction(instruction);
@@ -757,7 +780,7 @@ void Generator::HandleVariableInplaceAssignmentStatement(IRExpressionNodePtr con
   }  // switch
 
   HandleExpression(rhs);
-  Executable::Instruction instruction(opcode);
+  Executable::Instruction instruction(GetSpecialisedOpcode(opcode, lhs_type_id));
   instruction.type_id = lhs_type_id;
   instruction.index   = v->index;
   instruction.data    = rhs_type_id;
@@ -865,7 +888,7 @@ void Generator::HandleIndexedInplaceAssignmentStatement(IRExpressionNodePtr cons
   }
   }  // switch
 
-  Executable::Instruction instruction(opcode);
+  Executable::Instruction instruction(GetSpecialisedOpcode(opcode, type_id));
   instruction.type_id = type_id;
   instruction.data    = rhs_type_id;
   uint16_t pc         = function_->AddInstruction(instruction);
@@ -1014,7 +1037,8 @@ void Generator::HandleExpression(IRExpressionNodePtr const &node)
 void Generator::HandleIdentifier(IRExpressionNodePtr const &node)
 {
   IRVariablePtr           v = node->variable;
-  Executable::Instruction instruction(Opcodes::PushVariable);
+  Executable::Instruction instruction(v->type->IsPrimitive() ? Opcodes::PushPrimitiveVariable
+                                                             : Opcodes::PushVariable);
   instruction.type_id = v->type->resolved_id;
   instruction.index   = v->index;
   uint16_t pc         = function_->AddInstruction(instruction);
@@ -1283,7 +1307,7 @@ void Generator::HandleBinaryOp(IRExpressionNodePtr const &node)
   }
   }  // switch
 
-  Executable::Instruction instruction(opcode);
+  Executable::Instruction instruction(GetSpecialisedOpcode(opcode, type_id));
   instruction.type_id = type_id;
   instruction.data    = other_type_id;
   uint16_t pc         = function_->AddInstruction(instruction);
@@ -1621,6 +1645,75 @@ uint16_t Generator::GetArithmeticOpcode(bool lhs_is_primitive, TypeId node_type_
   return opcode;
 }
 
+/**
+ * Get the type specialised version of a generic primitive opcode. The handlers of the specialised
+ * opcodes do not need to switch on the type of their operands at runtime.
+ *
+ * @param opcode The generic opcode
+ * @param type_id The type of the operands
+ * @return The specialised opcode, or the generic opcode if there is no specialised version
+ */
+uint16_t Generator::GetSpecialisedOpcode(uint16_t opcode, TypeId type_id)
+{
+  uint16_t first;
+  switch (type_id)
+  {
+  case TypeIds::Int32:
+  {
+    first = Opcodes::PrimitiveAddInt32;
+    break;
+  }
+  case TypeIds::Int64:
+  {
+    first = Opcodes::PrimitiveAddInt64;
+    break;
+  }
+  case TypeIds::UInt64:
+  {
+    first = Opcodes::PrimitiveAddUInt64;
+    break;
+  }
+  case TypeIds::Float32:
+  {
+    first = Opcodes::PrimitiveAddFloat32;
+    break;
+  }
+  case TypeIds::Float64:
+  {
+    first = Opcodes::PrimitiveAddFloat64;
+    break;
+  }
+  default:
+  {
+    return opcode;
+  }
+  }  // switch
+
+  for (std::size_t i = 0; i < NUM_SPECIALISED_OPCODES; ++i)
+  {
+    if (SPECIALISED_OPCODES[i] == opcode)
+    {
+      return static_cast<uint16_t>(first + i);
+    }
+  }
+  return opcode;
+}
+
+/**
+ * Get the generic opcode of a type specialised primitive opcode
+ *
+ * @param opcode The opcode
+ * @return The generic opcode, or the opcode itself if it is not a specialised opcode
+ */
+uint16_t Generator::GetGenericOpcode(uint16_t opcode)
+{
+  if ((opcode < Opcodes::PrimitiveAddInt32) || (opcode >= Opcodes::NumReserved))
+  {
+    return opcode;
+  }
+  return SPECIALISED_OPCODES[(opcode - Opcodes::PrimitiveAddInt32) % NUM_SPECIALISED_OPCODES];
+}
+
 bool Generator::ConstantComparator::operator()(Variant const &lhs, Variant const &rhs) const
 {
   if (lhs.type_id < rhs.type_id)
@@ -16,12 +16,23 @@
 //
 //------------------------------------------------------------------------------
 
+#include "core/memory/arena.hpp"
 #include "vm/variant.hpp"
 #include "vm/vm.hpp"
 
 namespace fetch {
 namespace vm {
 
+void *Object::operator new(std::size_t size)
+{
+  return core::Arena::AllocateTagged(size);
+}
+
+void Object::operator delete(void *ptr) noexcept
+{
+  core::Arena::DeallocateTagged(ptr);
+}
+
 Variant &Object::Push()
 {
   return vm_->Push();
@@ -158,6 +158,140 @@ VM::VM(Module *module)
                 [](VM *vm) { vm->Handler__PrimitiveModulo(); });
   AddOpcodeInfo(Opcodes::VariablePrimitiveInplaceModulo, "VariablePrimitiveInplaceModulo",
                 [](VM *vm) { vm->Handler__VariablePrimitiveInplaceModulo(); });
+  AddOpcodeInfo(Opcodes::PushPrimitiveVariable, "PushPrimitiveVariable",
+                [](VM *vm) { vm->Handler__PushPrimitiveVariable(); });
+  AddOpcodeInfo(Opcodes::PopToPrimitiveVariable, "PopToPrimitiveVariable",
+                [](VM *vm) { vm->Handler__PopToPrimitiveVariable(); });
+  AddOpcodeInfo(Opcodes::PrimitiveAddInt32, "PrimitiveAddInt32",
+                [](VM *vm) { vm->Handler__PrimitiveAddInt32(); });
+  AddOpcodeInfo(Opcodes::PrimitiveSubtractInt32, "PrimitiveSubtractInt32",
+                [](VM *vm) { vm->Handler__PrimitiveSubtractInt32(); });
+  AddOpcodeInfo(Opcodes::PrimitiveMultiplyInt32, "PrimitiveMultiplyInt32",
+                [](VM *vm) { vm->Handler__PrimitiveMultiplyInt32(); });
+  AddOpcodeInfo(Opcodes::PrimitiveEqualInt32, "PrimitiveEqualInt32",
+                [](VM *vm) { vm->Handler__PrimitiveEqualInt32(); });
+  AddOpcodeInfo(Opcodes::PrimitiveNotEqualInt32, "PrimitiveNotEqualInt32",
+                [](VM *vm) { vm->Handler__PrimitiveNotEqualInt32(); });
+  AddOpcodeInfo(Opcodes::PrimitiveLessThanInt32, "PrimitiveLessThanInt32",
+                [](VM *vm) { vm->Handler__PrimitiveLessThanInt32(); });
+  AddOpcodeInfo(Opcodes::PrimitiveLessThanOrEqualInt32, "PrimitiveLessThanOrEqualInt32",
+                [](VM *vm) { vm->Handler__PrimitiveLessThanOrEqualInt32(); });
+  AddOpcodeInfo(Opcodes::PrimitiveGreaterThanInt32, "PrimitiveGreaterThanInt32",
+                [](VM *vm) { vm->Handler__PrimitiveGreaterThanInt32(); });
+  AddOpcodeInfo(Opcodes::PrimitiveGreaterThanOrEqualInt32, "PrimitiveGreaterThanOrEqualInt32",
+                [](VM *vm) { vm->Handler__PrimitiveGreaterThanOrEqualInt32(); });
+  AddOpcodeInfo(Opcodes::VariablePrimitiveInplaceAddInt32, "VariablePrimitiveInplaceAddInt32",
+                [](VM *vm) { vm->Handler__VariablePrimitiveInplaceAddInt32(); });
+  AddOpcodeInfo(
+      Opcodes::VariablePrimitiveInplaceSubtractInt32, "VariablePrimitiveInplaceSubtractInt32",
+      [](VM *vm) { vm->Handler__VariablePrimitiveInplaceSubtractInt32(); });
+  AddOpcodeInfo(
+      Opcodes::VariablePrimitiveInplaceMultiplyInt32, "VariablePrimitiveInplaceMultiplyInt32",
+      [](VM *vm) { vm->Handler__VariablePrimitiveInplaceMultiplyInt32(); });
+  AddOpcodeInfo(Opcodes::PrimitiveAddInt64, "PrimitiveAddInt64",
+                [](VM *vm) { vm->Handler__PrimitiveAddInt64(); });
+  AddOpcodeInfo(Opcodes::PrimitiveSubtractInt64, "PrimitiveSubtractInt64",
+                [](VM *vm) { vm->Handler__PrimitiveSubtractInt64(); });
+  AddOpcodeInfo(Opcodes::PrimitiveMultiplyInt64, "PrimitiveMultiplyInt64",
+                [](VM *vm) { vm->Handler__PrimitiveMultiplyInt64(); });
+  AddOpcodeInfo(Opcodes::PrimitiveEqualInt64, "PrimitiveEqualInt64",
+                [](VM *vm) { vm->Handler__PrimitiveEqualInt64(); });
+  AddOpcodeInfo(Opcodes::PrimitiveNotEqualInt64, "PrimitiveNotEqualInt64",
+                [](VM *vm) { vm->Handler__PrimitiveNotEqualInt64(); });
+  AddOpcodeInfo(Opcodes::PrimitiveLessThanInt64, "PrimitiveLessThanInt64",
+                [](VM *vm) { vm->Handler__PrimitiveLessThanInt64(); });
+  AddOpcodeInfo(Opcodes::PrimitiveLessThanOrEqualInt64, "PrimitiveLessThanOrEqualInt64",
+                [](VM *vm) { vm->Handler__PrimitiveLessThanOrEqualInt64(); });
+  AddOpcodeInfo(Opcodes::PrimitiveGreaterThanInt64, "PrimitiveGreaterThanInt64",
+                [](VM *vm) { vm->Handler__PrimitiveGreaterThanInt64(); });
+  AddOpcodeInfo(Opcodes::PrimitiveGreaterThanOrEqualInt64, "PrimitiveGreaterThanOrEqualInt64",
+                [](VM *vm) { vm->Handler__PrimitiveGreaterThanOrEqualInt64(); });
+  AddOpcodeInfo(Opcodes::VariablePrimitiveInplaceAddInt64, "VariablePrimitiveInplaceAddInt64",
+                [](VM *vm) { vm->Handler__VariablePrimitiveInplaceAddInt64(); });
+  AddOpcodeInfo(
+      Opcodes::VariablePrimitiveInplaceSubtractInt64, "VariablePrimitiveInplaceSubtractInt64",
+      [](VM *vm) { vm->Handler__VariablePrimitiveInplaceSubtractInt64(); });
+  AddOpcodeInfo(
+      Opcodes::VariablePrimitiveInplaceMultiplyInt64, "VariablePrimitiveInplaceMultiplyInt64",
+      [](VM *vm) { vm->Handler__VariablePrimitiveInplaceMultiplyInt64(); });
+  AddOpcodeInfo(Opcodes::PrimitiveAddUInt64, "PrimitiveAddUInt64",
+                [](VM *vm) { vm->Handler__PrimitiveAddUInt64(); });
+  AddOpcodeInfo(Opcodes::PrimitiveSubtractUInt64, "PrimitiveSubtractUInt64",
+                [](VM *vm) { vm->Handler__PrimitiveSubtractUInt64(); });
+  AddOpcodeInfo(Opcodes::PrimitiveMultiplyUInt64, "PrimitiveMultiplyUInt64",
+                [](VM *vm) { vm->Handler__PrimitiveMultiplyUInt64(); });
+  AddOpcodeInfo(Opcodes::PrimitiveEqualUInt64, "PrimitiveEqualUInt64",
+                [](VM *vm) { vm->Handler__PrimitiveEqualUInt64(); });
+  AddOpcodeInfo(Opcodes::PrimitiveNotEqualUInt64, "PrimitiveNotEqualUInt64",
+                [](VM *vm) { vm->Handler__PrimitiveNotEqualUInt64(); });
+  AddOpcodeInfo(Opcodes::PrimitiveLessThanUInt64, "PrimitiveLessThanUInt64",
+                [](VM *vm) { vm->Handler__PrimitiveLessThanUInt64(); });
+  AddOpcodeInfo(Opcodes::PrimitiveLessThanOrEqualUInt64, "PrimitiveLessThanOrEqualUInt64",
+                [](VM *vm) { vm->Handler__PrimitiveLessThanOrEqualUInt64(); });
+  AddOpcodeInfo(Opcodes::PrimitiveGreaterThanUInt64, "PrimitiveGreaterThanUInt64",
+                [](VM *vm) { vm->Handler__PrimitiveGreaterThanUInt64(); });
+  AddOpcodeInfo(Opcodes::PrimitiveGreaterThanOrEqualUInt64, "PrimitiveGreaterThanOrEqualUInt64",
+                [](VM *vm) { vm->Handler__PrimitiveGreaterThanOrEqualUInt64(); });
+  AddOpcodeInfo(Opcodes::VariablePrimitiveInplaceAddUInt64, "VariablePrimitiveInplaceAddUInt64",
+                [](VM *vm) { vm->Handler__VariablePrimitiveInplaceAddUInt64(); });
+  AddOpcodeInfo(
+      Opcodes::VariablePrimitiveInplaceSubtractUInt64, "VariablePrimitiveInplaceSubtractUInt64",
+      [](VM *vm) { vm->Handler__VariablePrimitiveInplaceSubtractUInt64(); });
+  AddOpcodeInfo(
+      Opcodes::VariablePrimitiveInplaceMultiplyUInt64, "VariablePrimitiveInplaceMultiplyUInt64",
+      [](VM *vm) { vm->Handler__VariablePrimitiveInplaceMultiplyUInt64(); });
+  AddOpcodeInfo(Opcodes::PrimitiveAddFloat32, "PrimitiveAddFloat32",
+                [](VM *vm) { vm->Handler__PrimitiveAddFloat32(); });
+  AddOpcodeInfo(Opcodes::PrimitiveSubtractFloat32, "PrimitiveSubtractFloat32",
+                [](VM *vm) { vm->Handler__PrimitiveSubtractFloat32(); });
+  AddOpcodeInfo(Opcodes::PrimitiveMultiplyFloat32, "PrimitiveMultiplyFloat32",
+                [](VM *vm) { vm->Handler__PrimitiveMultiplyFloat32(); });
+  AddOpcodeInfo(Opcodes::PrimitiveEqualFloat32, "PrimitiveEqualFloat32",
+                [](VM *vm) { vm->Handler__PrimitiveEqualFloat32(); });
+  AddOpcodeInfo(Opcodes::PrimitiveNotEqualFloat32, "PrimitiveNotEqualFloat32",
+                [](VM *vm) { vm->Handler__PrimitiveNotEqualFloat32(); });
+  AddOpcodeInfo(Opcodes::PrimitiveLessThanFloat32, "PrimitiveLessThanFloat32",
+                [](VM *vm) { vm->Handler__PrimitiveLessThanFloat32(); });
+  AddOpcodeInfo(Opcodes::PrimitiveLessThanOrEqualFloat32, "PrimitiveLessThanOrEqualFloat32",
+                [](VM *vm) { vm->Handler__PrimitiveLessThanOrEqualFloat32(); });
+  AddOpcodeInfo(Opcodes::PrimitiveGreaterThanFloat32, "PrimitiveGreaterThanFloat32",
+                [](VM *vm) { vm->Handler__PrimitiveGreaterThanFloat32(); });
+  AddOpcodeInfo(Opcodes::PrimitiveGreaterThanOrEqualFloat32, "PrimitiveGreaterThanOrEqualFloat32",
+                [](VM *vm) { vm->Handler__PrimitiveGreaterThanOrEqualFloat32(); });
+  AddOpcodeInfo(Opcodes::VariablePrimitiveInplaceAddFloat32, "VariablePrimitiveInplaceAddFloat32",
+                [](VM *vm) { vm->Handler__VariablePrimitiveInplaceAddFloat32(); });
+  AddOpcodeInfo(
+      Opcodes::VariablePrimitiveInplaceSubtractFloat32, "VariablePrimitiveInplaceSubtractFloat32",
+      [](VM *vm) { vm->Handler__VariablePrimitiveInplaceSubtractFloat32(); });
+  AddOpcodeInfo(
+      Opcodes::VariablePrimitiveInplaceMultiplyFloat32, "VariablePrimitiveInplaceMultiplyFloat32",
+      [](VM *vm) { vm->Handler__VariablePrimitiveInplaceMultiplyFloat32(); });
+  AddOpcodeInfo(Opcodes::PrimitiveAddFloat64, "PrimitiveAddFloat64",
+                [](VM *vm) { vm->Handler__PrimitiveAddFloat64(); });
+  AddOpcodeInfo(Opcodes::PrimitiveSubtractFloat64, "PrimitiveSubtractFloat64",
+                [](VM *vm) { vm->Handler__PrimitiveSubtractFloat64(); });
+  AddOpcodeInfo(Opcodes::PrimitiveMultiplyFloat64, "PrimitiveMultiplyFloat64",
+                [](VM *vm) { vm->Handler__PrimitiveMultiplyFloat64(); });
+  AddOpcodeInfo(Opcodes::PrimitiveEqualFloat64, "PrimitiveEqualFloat64",
+                [](VM *vm) { vm->Handler__PrimitiveEqualFloat64(); });
+  AddOpcodeInfo(Opcodes::PrimitiveNotEqualFloat64, "PrimitiveNotEqualFloat64",
+                [](VM *vm) { vm->Handler__PrimitiveNotEqualFloat64(); });
+  AddOpcodeInfo(Opcodes::PrimitiveLessThanFloat64, "PrimitiveLessThanFloat64",
+                [](VM *vm) { vm->Handler__PrimitiveLessThanFloat64(); });
+  AddOpcodeInfo(Opcodes::PrimitiveLessThanOrEqualFloat64, "PrimitiveLessThanOrEqualFloat64",
+                [](VM *vm) { vm->Handler__PrimitiveLessThanOrEqualFloat64(); });
+  AddOpcodeInfo(Opcodes::PrimitiveGreaterThanFloat64, "PrimitiveGreaterThanFloat64",
+                [](VM *vm) { vm->Handler__PrimitiveGreaterThanFloat64(); });
+  AddOpcodeInfo(Opcodes::PrimitiveGreaterThanOrEqualFloat64, "PrimitiveGreaterThanOrEqualFloat64",
+                [](VM *vm) { vm->Handler__PrimitiveGreaterThanOrEqualFloat64(); });
+  AddOpcodeInfo(Opcodes::VariablePrimitiveInplaceAddFloat64, "VariablePrimitiveInplaceAddFloat64",
+                [](VM *vm) { vm->Handler__VariablePrimitiveInplaceAddFloat64(); });
+  AddOpcodeInfo(
+      Opcodes::VariablePrimitiveInplaceSubtractFloat64, "VariablePrimitiveInplaceSubtractFloat64",
+      [](VM *vm) { vm->Handler__VariablePrimitiveInplaceSubtractFloat64(); });
+  AddOpcodeInfo(
+      Opcodes::VariablePrimitiveInplaceMultiplyFloat64, "VariablePrimitiveInplaceMultiplyFloat64",
+      [](VM *vm) { vm->Handler__VariablePrimitiveInplaceMultiplyFloat64(); });
 
   opcode_map_.clear();
   for (uint16_t i = 0; i < num_functions; ++i)
@@ -206,21 +340,17 @@ bool VM::Execute(std::string &error, Variant &output)
   error_.clear();
   error.clear();
 
-  do
+  // the functions of the executable are decoded as they are first called
+  dispatch_arrays_.resize(executable_->functions.size());
+  for (auto &dispatch_array : dispatch_arrays_)
   {
-    instruction_pc_  = pc_;
-    instruction_     = &function_->instructions[pc_++];
-    OpcodeInfo &info = opcode_info_array_[instruction_->opcode];
-    if (info.handler)
-    {
-      info.handler(this);
-    }
-    else
-    {
-      RuntimeError("unknown opcode");
-      break;
-    }
-  } while (!stop_);
+    dispatch_array.clear();
+  }
+
+  dispatch_          = GetDispatchArray(function_);
+  instruction_count_ = 0;
+
+  Run();
 
   bool const ok = error_.empty();
 
@@ -255,6 +385,108 @@ bool VM::Execute(std::string &error, Variant &output)
   return false;
 }
 
+uint16_t const *VM::GetDispatchArray(Executable::Function const *function)
+{
+  auto const     index          = static_cast<std::size_t>(function - executable_->functions.data());
+  DispatchArray &dispatch_array = dispatch_arrays_[index];
+
+  if (dispatch_array.empty())
+  {
+    auto const &instructions = function->instructions;
+
+    dispatch_array.resize(instructions.size());
+    for (std::size_t pc = 0; pc < instructions.size(); ++pc)
+    {
+      dispatch_array[pc] = Decode(instructions, pc);
+    }
+  }
+
+  return dispatch_array.data();
+}
+
+/**
+ * Determine the handler for the instruction at the specified position of a function. Where the
+ * instruction starts one of the common sequences of instructions the sequence is handled by a
+ * single superinstruction. Since the decoding is made for every position, jumps into the middle of
+ * a sequence are handled by the handlers of the remaining instructions.
+ *
+ * @param instructions The instructions of the function
+ * @param pc The position of the instruction
+ * @return The identifier of the handler
+ */
+uint16_t VM::Decode(Executable::InstructionArray const &instructions, std::size_t pc) const
+{
+  // the type specialised opcodes are matched as their generic opcodes
+  auto const opcode_at = [&instructions, pc](std::size_t offset) {
+    return ((pc + offset) < instructions.size())
+               ? Generator::GetGenericOpcode(instructions[pc + offset].opcode)
+               : Opcodes::Unknown;
+  };
+
+  auto const is_push_variable = [](uint16_t opcode) {
+    return (opcode == Opcodes::PushVariable) || (opcode == Opcodes::PushPrimitiveVariable);
+  };
+
+  auto const is_pop_to_variable = [](uint16_t opcode) {
+    return (opcode == Opcodes::PopToVariable) || (opcode == Opcodes::PopToPrimitiveVariable);
+  };
+
+  auto const is_fusable_op = [](uint16_t opcode) {
+    return (opcode == Opcodes::PrimitiveAdd) || (opcode == Opcodes::PrimitiveSubtract) ||
+           (opcode == Opcodes::PrimitiveMultiply) ||
+           ((opcode >= Opcodes::PrimitiveEqual) && (opcode <= Opcodes::ObjectGreaterThanOrEqual) &&
+            ((opcode - Opcodes::PrimitiveEqual) % 2 == 0));
+  };
+
+  auto const is_relational_op = [](uint16_t opcode) {
+    return (opcode >= Opcodes::PrimitiveEqual) && (opcode <= Opcodes::ObjectGreaterThanOrEqual);
+  };
+
+  uint16_t const opcode = instructions[pc].opcode;
+
+  // variable (op) constant and variable (op) variable sequences
+  if (is_push_variable(opcode) &&
+      ((opcode_at(1) == Opcodes::PushConstant) || is_push_variable(opcode_at(1))) &&
+      is_fusable_op(opcode_at(2)))
+  {
+    bool const constant = (opcode_at(1) == Opcodes::PushConstant);
+
+    if (is_relational_op(opcode_at(2)) && (opcode_at(3) == Opcodes::JumpIfFalse))
+    {
+      return constant ? Dispatch::LocalConstantCompareJump : Dispatch::LocalLocalCompareJump;
+    }
+
+    if (is_pop_to_variable(opcode_at(3)))
+    {
+      return constant ? Dispatch::LocalConstantOpPop : Dispatch::LocalLocalOpPop;
+    }
+
+    return constant ? Dispatch::LocalConstantOp : Dispatch::LocalLocalOp;
+  }
+
+  // variable (op)= constant sequences
+  if ((opcode == Opcodes::PushConstant) &&
+      ((opcode_at(1) == Opcodes::VariablePrimitiveInplaceAdd) ||
+       (opcode_at(1) == Opcodes::VariablePrimitiveInplaceSubtract) ||
+       (opcode_at(1) == Opcodes::VariablePrimitiveInplaceMultiply)))
+  {
+    return Dispatch::ConstantInplaceOp;
+  }
+
+  if (opcode == Opcodes::ReturnValue)
+  {
+    return Opcodes::Return;
+  }
+
+  if ((opcode == Opcodes::Unknown) || (opcode >= opcode_info_array_.size()) ||
+      !opcode_info_array_[opcode].handler)
+  {
+    return Dispatch::Unknown;
+  }
+
+  return (opcode < Opcodes::NumReserved) ? opcode : Dispatch::ModuleFunction;
+}
+
 void VM::RuntimeError(std::string const &message)
 {
   uint16_t const    line = function_->FindLineNumber(instruction_pc_);
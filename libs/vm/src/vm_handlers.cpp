@@ -205,6 +205,7 @@ void VM::Handler__Return()
     // We've finished executing an inner function
     Frame const &frame = frame_stack_[frame_sp_];
     function_          = frame.function;
+    dispatch_          = frame.dispatch;
     bsp_               = frame.bsp;
     pc_                = frame.pc;
     --frame_sp_;
@@ -398,6 +399,7 @@ void VM::Handler__InvokeUserDefinedFreeFunction()
   // Note: the parameters are already on the stack
   Frame frame;
   frame.function = function_;
+  frame.dispatch = dispatch_;
   frame.bsp      = bsp_;
   frame.pc       = pc_;
   if (frame_sp_ >= FRAME_STACK_SIZE - 1)
@@ -407,6 +409,7 @@ void VM::Handler__InvokeUserDefinedFreeFunction()
   }
   frame_stack_[++frame_sp_] = frame;
   function_                 = &(executable_->functions[index]);
+  dispatch_                 = GetDispatchArray(function_);
   bsp_                      = sp_ - function_->num_parameters + 1;  // first parameter
   pc_                       = 0;
   int const num_locals      = function_->num_variables - function_->num_parameters;
@@ -688,5 +691,1031 @@ void VM::Handler__VariablePrimitiveInplaceModulo()
   DoVariableIntegralInplaceOp<PrimitiveModulo>();
 }
 
+void VM::Handler__PushPrimitiveVariable()
+{
+  CopyPrimitive(Push(), GetVariable(instruction_->index));
+}
+
+void VM::Handler__PopToPrimitiveVariable()
+{
+  Variant &top = Pop();
+  CopyPrimitive(GetVariable(instruction_->index), top);
+  top.type_id = TypeIds::Unknown;
+}
+
+void VM::Handler__PrimitiveAddInt32()
+{
+  DoTypedNumericOp<PrimitiveAdd, int32_t>();
+}
+
+void VM::Handler__PrimitiveSubtractInt32()
+{
+  DoTypedNumericOp<PrimitiveSubtract, int32_t>();
+}
+
+void VM::Handler__PrimitiveMultiplyInt32()
+{
+  DoTypedNumericOp<PrimitiveMultiply, int32_t>();
+}
+
+void VM::Handler__PrimitiveEqualInt32()
+{
+  DoTypedRelationalOp<PrimitiveEqual, int32_t>();
+}
+
+void VM::Handler__PrimitiveNotEqualInt32()
+{
+  DoTypedRelationalOp<PrimitiveNotEqual, int32_t>();
+}
+
+void VM::Handler__PrimitiveLessThanInt32()
+{
+  DoTypedRelationalOp<PrimitiveLessThan, int32_t>();
+}
+
+void VM::Handler__PrimitiveLessThanOrEqualInt32()
+{
+  DoTypedRelationalOp<PrimitiveLessThanOrEqual, int32_t>();
+}
+
+void VM::Handler__PrimitiveGreaterThanInt32()
+{
+  DoTypedRelationalOp<PrimitiveGreaterThan, int32_t>();
+}
+
+void VM::Handler__PrimitiveGreaterThanOrEqualInt32()
+{
+  DoTypedRelationalOp<PrimitiveGreaterThanOrEqual, int32_t>();
+}
+
+void VM::Handler__VariablePrimitiveInplaceAddInt32()
+{
+  DoTypedVariableNumericInplaceOp<PrimitiveAdd, int32_t>();
+}
+
+void VM::Handler__VariablePrimitiveInplaceSubtractInt32()
+{
+  DoTypedVariableNumericInplaceOp<PrimitiveSubtract, int32_t>();
+}
+
+void VM::Handler__VariablePrimitiveInplaceMultiplyInt32()
+{
+  DoTypedVariableNumericInplaceOp<PrimitiveMultiply, int32_t>();
+}
+
+void VM::Handler__PrimitiveAddInt64()
+{
+  DoTypedNumericOp<PrimitiveAdd, int64_t>();
+}
+
+void VM::Handler__PrimitiveSubtractInt64()
+{
+  DoTypedNumericOp<PrimitiveSubtract, int64_t>();
+}
+
+void VM::Handler__PrimitiveMultiplyInt64()
+{
+  DoTypedNumericOp<PrimitiveMultiply, int64_t>();
+}
+
+void VM::Handler__PrimitiveEqualInt64()
+{
+  DoTypedRelationalOp<PrimitiveEqual, int64_t>();
+}
+
+void VM::Handler__PrimitiveNotEqualInt64()
+{
+  DoTypedRelationalOp<PrimitiveNotEqual, int64_t>();
+}
+
+void VM::Handler__PrimitiveLessThanInt64()
+{
+  DoTypedRelationalOp<PrimitiveLessThan, int64_t>();
+}
+
+void VM::Handler__PrimitiveLessThanOrEqualInt64()
+{
+  DoTypedRelationalOp<PrimitiveLessThanOrEqual, int64_t>();
+}
+
+void VM::Handler__PrimitiveGreaterThanInt64()
+{
+  DoTypedRelationalOp<PrimitiveGreaterThan, int64_t>();
+}
+
+void VM::Handler__PrimitiveGreaterThanOrEqualInt64()
+{
+  DoTypedRelationalOp<PrimitiveGreaterThanOrEqual, int64_t>();
+}
+
+void VM::Handler__VariablePrimitiveInplaceAddInt64()
+{
+  DoTypedVariableNumericInplaceOp<PrimitiveAdd, int64_t>();
+}
+
+void VM::Handler__VariablePrimitiveInplaceSubtractInt64()
+{
+  DoTypedVariableNumericInplaceOp<PrimitiveSubtract, int64_t>();
+}
+
+void VM::Handler__VariablePrimitiveInplaceMultiplyInt64()
+{
+  DoTypedVariableNumericInplaceOp<PrimitiveMultiply, int64_t>();
+}
+
+void VM::Handler__PrimitiveAddUInt64()
+{
+  DoTypedNumericOp<PrimitiveAdd, uint64_t>();
+}
+
+void VM::Handler__PrimitiveSubtractUInt64()
+{
+  DoTypedNumericOp<PrimitiveSubtract, uint64_t>();
+}
+
+void VM::Handler__PrimitiveMultiplyUInt64()
+{
+  DoTypedNumericOp<PrimitiveMultiply, uint64_t>();
+}
+
+void VM::Handler__PrimitiveEqualUInt64()
+{
+  DoTypedRelationalOp<PrimitiveEqual, uint64_t>();
+}
+
+void VM::Handler__PrimitiveNotEqualUInt64()
+{
+  DoTypedRelationalOp<PrimitiveNotEqual, uint64_t>();
+}
+
+void VM::Handler__PrimitiveLessThanUInt64()
+{
+  DoTypedRelationalOp<PrimitiveLessThan, uint64_t>();
+}
+
+void VM::Handler__PrimitiveLessThanOrEqualUInt64()
+{
+  DoTypedRelationalOp<PrimitiveLessThanOrEqual, uint64_t>();
+}
+
+void VM::Handler__PrimitiveGreaterThanUInt64()
+{
+  DoTypedRelationalOp<PrimitiveGreaterThan, uint64_t>();
+}
+
+void VM::Handler__PrimitiveGreaterThanOrEqualUInt64()
+{
+  DoTypedRelationalOp<PrimitiveGreaterThanOrEqual, uint64_t>();
+}
+
+void VM::Handler__VariablePrimitiveInplaceAddUInt64()
+{
+  DoTypedVariableNumericInplaceOp<PrimitiveAdd, uint64_t>();
+}
+
+void VM::Handler__VariablePrimitiveInplaceSubtractUInt64()
+{
+  DoTypedVariableNumericInplaceOp<PrimitiveSubtract, uint64_t>();
+}
+
+void VM::Handler__VariablePrimitiveInplaceMultiplyUInt64()
+{
+  DoTypedVariableNumericInplaceOp<PrimitiveMultiply, uint64_t>();
+}
+
+void VM::Handler__PrimitiveAddFloat32()
+{
+  DoTypedNumericOp<PrimitiveAdd, float>();
+}
+
+void VM::Handler__PrimitiveSubtractFloat32()
+{
+  DoTypedNumericOp<PrimitiveSubtract, float>();
+}
+
+void VM::Handler__PrimitiveMultiplyFloat32()
+{
+  DoTypedNumericOp<PrimitiveMultiply, float>();
+}
+
+void VM::Handler__PrimitiveEqualFloat32()
+{
+  DoTypedRelationalOp<PrimitiveEqual, float>();
+}
+
+void VM::Handler__PrimitiveNotEqualFloat32()
+{
+  DoTypedRelationalOp<PrimitiveNotEqual, float>();
+}
+
+void VM::Handler__PrimitiveLessThanFloat32()
+{
+  DoTypedRelationalOp<PrimitiveLessThan, float>();
+}
+
+void VM::Handler__PrimitiveLessThanOrEqualFloat32()
+{
+  DoTypedRelationalOp<PrimitiveLessThanOrEqual, float>();
+}
+
+void VM::Handler__PrimitiveGreaterThanFloat32()
+{
+  DoTypedRelationalOp<PrimitiveGreaterThan, float>();
+}
+
+void VM::Handler__PrimitiveGreaterThanOrEqualFloat32()
+{
+  DoTypedRelationalOp<PrimitiveGreaterThanOrEqual, float>();
+}
+
+void VM::Handler__VariablePrimitiveInplaceAddFloat32()
+{
+  DoTypedVariableNumericInplaceOp<PrimitiveAdd, float>();
+}
+
+void VM::Handler__VariablePrimitiveInplaceSubtractFloat32()
+{
+  DoTypedVariableNumericInplaceOp<PrimitiveSubtract, float>();
+}
+
+void VM::Handler__VariablePrimitiveInplaceMultiplyFloat32()
+{
+  DoTypedVariableNumericInplaceOp<PrimitiveMultiply, float>();
+}
+
+void VM::Handler__PrimitiveAddFloat64()
+{
+  DoTypedNumericOp<PrimitiveAdd, double>();
+}
+
+void VM::Handler__PrimitiveSubtractFloat64()
+{
+  DoTypedNumericOp<PrimitiveSubtract, double>();
+}
+
+void VM::Handler__PrimitiveMultiplyFloat64()
+{
+  DoTypedNumericOp<PrimitiveMultiply, double>();
+}
+
+void VM::Handler__PrimitiveEqualFloat64()
+{
+  DoTypedRelationalOp<PrimitiveEqual, double>();
+}
+
+void VM::Handler__PrimitiveNotEqualFloat64()
+{
+  DoTypedRelationalOp<PrimitiveNotEqual, double>();
+}
+
+void VM::Handler__PrimitiveLessThanFloat64()
+{
+  DoTypedRelationalOp<PrimitiveLessThan, double>();
+}
+
+void VM::Handler__PrimitiveLessThanOrEqualFloat64()
+{
+  DoTypedRelationalOp<PrimitiveLessThanOrEqual, double>();
+}
+
+void VM::Handler__PrimitiveGreaterThanFloat64()
+{
+  DoTypedRelationalOp<PrimitiveGreaterThan, double>();
+}
+
+void VM::Handler__PrimitiveGreaterThanOrEqualFloat64()
+{
+  DoTypedRelationalOp<PrimitiveGreaterThanOrEqual, double>();
+}
+
+void VM::Handler__VariablePrimitiveInplaceAddFloat64()
+{
+  DoTypedVariableNumericInplaceOp<PrimitiveAdd, double>();
+}
+
+void VM::Handler__VariablePrimitiveInplaceSubtractFloat64()
+{
+  DoTypedVariableNumericInplaceOp<PrimitiveSubtract, double>();
+}
+
+void VM::Handler__VariablePrimitiveInplaceMultiplyFloat64()
+{
+  DoTypedVariableNumericInplaceOp<PrimitiveMultiply, double>();
+}
+
+void VM::ExecuteFusedOp(uint16_t opcode, TypeId type_id, Variant &lhsv, Variant &rhsv)
+{
+  switch (opcode)
+  {
+  case Opcodes::PrimitiveAdd:
+  {
+    ExecuteNumericOp<PrimitiveAdd>(type_id, lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveSubtract:
+  {
+    ExecuteNumericOp<PrimitiveSubtract>(type_id, lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveMultiply:
+  {
+    ExecuteNumericOp<PrimitiveMultiply>(type_id, lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveEqual:
+  {
+    ExecutePrimitiveRelationalOp<PrimitiveEqual>(type_id, lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveNotEqual:
+  {
+    ExecutePrimitiveRelationalOp<PrimitiveNotEqual>(type_id, lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveLessThan:
+  {
+    ExecutePrimitiveRelationalOp<PrimitiveLessThan>(type_id, lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveLessThanOrEqual:
+  {
+    ExecutePrimitiveRelationalOp<PrimitiveLessThanOrEqual>(type_id, lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveGreaterThan:
+  {
+    ExecutePrimitiveRelationalOp<PrimitiveGreaterThan>(type_id, lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveGreaterThanOrEqual:
+  {
+    ExecutePrimitiveRelationalOp<PrimitiveGreaterThanOrEqual>(type_id, lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveAddInt32:
+  {
+    ApplyTypedNumericOp<PrimitiveAdd, int32_t>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveSubtractInt32:
+  {
+    ApplyTypedNumericOp<PrimitiveSubtract, int32_t>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveMultiplyInt32:
+  {
+    ApplyTypedNumericOp<PrimitiveMultiply, int32_t>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveEqualInt32:
+  {
+    ApplyTypedRelationalOp<PrimitiveEqual, int32_t>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveNotEqualInt32:
+  {
+    ApplyTypedRelationalOp<PrimitiveNotEqual, int32_t>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveLessThanInt32:
+  {
+    ApplyTypedRelationalOp<PrimitiveLessThan, int32_t>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveLessThanOrEqualInt32:
+  {
+    ApplyTypedRelationalOp<PrimitiveLessThanOrEqual, int32_t>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveGreaterThanInt32:
+  {
+    ApplyTypedRelationalOp<PrimitiveGreaterThan, int32_t>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveGreaterThanOrEqualInt32:
+  {
+    ApplyTypedRelationalOp<PrimitiveGreaterThanOrEqual, int32_t>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveAddInt64:
+  {
+    ApplyTypedNumericOp<PrimitiveAdd, int64_t>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveSubtractInt64:
+  {
+    ApplyTypedNumericOp<PrimitiveSubtract, int64_t>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveMultiplyInt64:
+  {
+    ApplyTypedNumericOp<PrimitiveMultiply, int64_t>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveEqualInt64:
+  {
+    ApplyTypedRelationalOp<PrimitiveEqual, int64_t>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveNotEqualInt64:
+  {
+    ApplyTypedRelationalOp<PrimitiveNotEqual, int64_t>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveLessThanInt64:
+  {
+    ApplyTypedRelationalOp<PrimitiveLessThan, int64_t>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveLessThanOrEqualInt64:
+  {
+    ApplyTypedRelationalOp<PrimitiveLessThanOrEqual, int64_t>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveGreaterThanInt64:
+  {
+    ApplyTypedRelationalOp<PrimitiveGreaterThan, int64_t>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveGreaterThanOrEqualInt64:
+  {
+    ApplyTypedRelationalOp<PrimitiveGreaterThanOrEqual, int64_t>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveAddUInt64:
+  {
+    ApplyTypedNumericOp<PrimitiveAdd, uint64_t>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveSubtractUInt64:
+  {
+    ApplyTypedNumericOp<PrimitiveSubtract, uint64_t>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveMultiplyUInt64:
+  {
+    ApplyTypedNumericOp<PrimitiveMultiply, uint64_t>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveEqualUInt64:
+  {
+    ApplyTypedRelationalOp<PrimitiveEqual, uint64_t>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveNotEqualUInt64:
+  {
+    ApplyTypedRelationalOp<PrimitiveNotEqual, uint64_t>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveLessThanUInt64:
+  {
+    ApplyTypedRelationalOp<PrimitiveLessThan, uint64_t>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveLessThanOrEqualUInt64:
+  {
+    ApplyTypedRelationalOp<PrimitiveLessThanOrEqual, uint64_t>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveGreaterThanUInt64:
+  {
+    ApplyTypedRelationalOp<PrimitiveGreaterThan, uint64_t>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveGreaterThanOrEqualUInt64:
+  {
+    ApplyTypedRelationalOp<PrimitiveGreaterThanOrEqual, uint64_t>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveAddFloat32:
+  {
+    ApplyTypedNumericOp<PrimitiveAdd, float>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveSubtractFloat32:
+  {
+    ApplyTypedNumericOp<PrimitiveSubtract, float>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveMultiplyFloat32:
+  {
+    ApplyTypedNumericOp<PrimitiveMultiply, float>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveEqualFloat32:
+  {
+    ApplyTypedRelationalOp<PrimitiveEqual, float>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveNotEqualFloat32:
+  {
+    ApplyTypedRelationalOp<PrimitiveNotEqual, float>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveLessThanFloat32:
+  {
+    ApplyTypedRelationalOp<PrimitiveLessThan, float>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveLessThanOrEqualFloat32:
+  {
+    ApplyTypedRelationalOp<PrimitiveLessThanOrEqual, float>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveGreaterThanFloat32:
+  {
+    ApplyTypedRelationalOp<PrimitiveGreaterThan, float>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveGreaterThanOrEqualFloat32:
+  {
+    ApplyTypedRelationalOp<PrimitiveGreaterThanOrEqual, float>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveAddFloat64:
+  {
+    ApplyTypedNumericOp<PrimitiveAdd, double>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveSubtractFloat64:
+  {
+    ApplyTypedNumericOp<PrimitiveSubtract, double>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveMultiplyFloat64:
+  {
+    ApplyTypedNumericOp<PrimitiveMultiply, double>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveEqualFloat64:
+  {
+    ApplyTypedRelationalOp<PrimitiveEqual, double>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveNotEqualFloat64:
+  {
+    ApplyTypedRelationalOp<PrimitiveNotEqual, double>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveLessThanFloat64:
+  {
+    ApplyTypedRelationalOp<PrimitiveLessThan, double>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveLessThanOrEqualFloat64:
+  {
+    ApplyTypedRelationalOp<PrimitiveLessThanOrEqual, double>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveGreaterThanFloat64:
+  {
+    ApplyTypedRelationalOp<PrimitiveGreaterThan, double>(lhsv, rhsv);
+    break;
+  }
+  case Opcodes::PrimitiveGreaterThanOrEqualFloat64:
+  {
+    ApplyTypedRelationalOp<PrimitiveGreaterThanOrEqual, double>(lhsv, rhsv);
+    break;
+  }
+  default:
+    break;
+  }
+}
+
+// The superinstructions are only decoded for primitive operations, so the operands are copied into
+// the stack without the checks of Variant::Construct and Variant::Reset. PushVariable stands for
+// either of PushVariable and PushPrimitiveVariable, similarly for PopToVariable.
+
+// PushVariable, PushConstant, <op>
+void VM::Handler__LocalConstantOp()
+{
+  Variant &lhsv = Push();
+  Variant &rhsv = stack_[sp_ + 1];
+  CopyPrimitive(lhsv, GetVariable(instruction_[0].index));
+  CopyPrimitive(rhsv, executable_->constants[instruction_[1].index]);
+  ExecuteFusedOp(instruction_[2].opcode, instruction_[2].type_id, lhsv, rhsv);
+  rhsv.type_id = TypeIds::Unknown;
+
+  pc_ = static_cast<uint16_t>(pc_ + 2);
+  instruction_count_ += 2;
+}
+
+// PushVariable, PushVariable, <op>
+void VM::Handler__LocalLocalOp()
+{
+  Variant &lhsv = Push();
+  Variant &rhsv = stack_[sp_ + 1];
+  CopyPrimitive(lhsv, GetVariable(instruction_[0].index));
+  CopyPrimitive(rhsv, GetVariable(instruction_[1].index));
+  ExecuteFusedOp(instruction_[2].opcode, instruction_[2].type_id, lhsv, rhsv);
+  rhsv.type_id = TypeIds::Unknown;
+
+  pc_ = static_cast<uint16_t>(pc_ + 2);
+  instruction_count_ += 2;
+}
+
+// PushVariable, PushConstant, <op>, PopToVariable
+void VM::Handler__LocalConstantOpPop()
+{
+  Variant &lhsv = stack_[sp_ + 1];
+  Variant &rhsv = stack_[sp_ + 2];
+  CopyPrimitive(lhsv, GetVariable(instruction_[0].index));
+  CopyPrimitive(rhsv, executable_->constants[instruction_[1].index]);
+  ExecuteFusedOp(instruction_[2].opcode, instruction_[2].type_id, lhsv, rhsv);
+  rhsv.type_id = TypeIds::Unknown;
+
+  CopyPrimitive(GetVariable(instruction_[3].index), lhsv);
+  lhsv.type_id = TypeIds::Unknown;
+
+  pc_ = static_cast<uint16_t>(pc_ + 3);
+  instruction_count_ += 3;
+}
+
+// PushVariable, PushVariable, <op>, PopToVariable
+void VM::Handler__LocalLocalOpPop()
+{
+  Variant &lhsv = stack_[sp_ + 1];
+  Variant &rhsv = stack_[sp_ + 2];
+  CopyPrimitive(lhsv, GetVariable(instruction_[0].index));
+  CopyPrimitive(rhsv, GetVariable(instruction_[1].index));
+  ExecuteFusedOp(instruction_[2].opcode, instruction_[2].type_id, lhsv, rhsv);
+  rhsv.type_id = TypeIds::Unknown;
+
+  CopyPrimitive(GetVariable(instruction_[3].index), lhsv);
+  lhsv.type_id = TypeIds::Unknown;
+
+  pc_ = static_cast<uint16_t>(pc_ + 3);
+  instruction_count_ += 3;
+}
+
+// PushVariable, PushConstant, <relational op>, JumpIfFalse
+void VM::Handler__LocalConstantCompareJump()
+{
+  Variant &lhsv = stack_[sp_ + 1];
+  Variant &rhsv = stack_[sp_ + 2];
+  CopyPrimitive(lhsv, GetVariable(instruction_[0].index));
+  CopyPrimitive(rhsv, executable_->constants[instruction_[1].index]);
+  ExecuteFusedOp(instruction_[2].opcode, instruction_[2].type_id, lhsv, rhsv);
+  rhsv.type_id = TypeIds::Unknown;
+
+  pc_ = (lhsv.primitive.ui8 == 0) ? instruction_[3].index : static_cast<uint16_t>(pc_ + 3);
+  lhsv.type_id = TypeIds::Unknown;
+  instruction_count_ += 3;
+}
+
+// PushVariable, PushVariable, <relational op>, JumpIfFalse
+void VM::Handler__LocalLocalCompareJump()
+{
+  Variant &lhsv = stack_[sp_ + 1];
+  Variant &rhsv = stack_[sp_ + 2];
+  CopyPrimitive(lhsv, GetVariable(instruction_[0].index));
+  CopyPrimitive(rhsv, GetVariable(instruction_[1].index));
+  ExecuteFusedOp(instruction_[2].opcode, instruction_[2].type_id, lhsv, rhsv);
+  rhsv.type_id = TypeIds::Unknown;
+
+  pc_ = (lhsv.primitive.ui8 == 0) ? instruction_[3].index : static_cast<uint16_t>(pc_ + 3);
+  lhsv.type_id = TypeIds::Unknown;
+  instruction_count_ += 3;
+}
+
+// PushConstant, VariablePrimitiveInplace<op>
+void VM::Handler__ConstantInplaceOp()
+{
+  Executable::Instruction const &op       = instruction_[1];
+  Variant &                      variable = GetVariable(op.index);
+  Variant const &                constant = executable_->constants[instruction_[0].index];
+
+  switch (op.opcode)
+  {
+  case Opcodes::VariablePrimitiveInplaceAdd:
+  {
+    Push().Construct(constant);
+    DoNumericInplaceOp<PrimitiveAdd>(op.type_id, &variable.primitive);
+    break;
+  }
+  case Opcodes::VariablePrimitiveInplaceSubtract:
+  {
+    Push().Construct(constant);
+    DoNumericInplaceOp<PrimitiveSubtract>(op.type_id, &variable.primitive);
+    break;
+  }
+  case Opcodes::VariablePrimitiveInplaceMultiply:
+  {
+    Push().Construct(constant);
+    DoNumericInplaceOp<PrimitiveMultiply>(op.type_id, &variable.primitive);
+    break;
+  }
+  case Opcodes::VariablePrimitiveInplaceAddInt32:
+  {
+    ApplyTypedNumericOp<PrimitiveAdd, int32_t>(variable, constant);
+    break;
+  }
+  case Opcodes::VariablePrimitiveInplaceSubtractInt32:
+  {
+    ApplyTypedNumericOp<PrimitiveSubtract, int32_t>(variable, constant);
+    break;
+  }
+  case Opcodes::VariablePrimitiveInplaceMultiplyInt32:
+  {
+    ApplyTypedNumericOp<PrimitiveMultiply, int32_t>(variable, constant);
+    break;
+  }
+  case Opcodes::VariablePrimitiveInplaceAddInt64:
+  {
+    ApplyTypedNumericOp<PrimitiveAdd, int64_t>(variable, constant);
+    break;
+  }
+  case Opcodes::VariablePrimitiveInplaceSubtractInt64:
+  {
+    ApplyTypedNumericOp<PrimitiveSubtract, int64_t>(variable, constant);
+    break;
+  }
+  case Opcodes::VariablePrimitiveInplaceMultiplyInt64:
+  {
+    ApplyTypedNumericOp<PrimitiveMultiply, int64_t>(variable, constant);
+    break;
+  }
+  case Opcodes::VariablePrimitiveInplaceAddUInt64:
+  {
+    ApplyTypedNumericOp<PrimitiveAdd, uint64_t>(variable, constant);
+    break;
+  }
+  case Opcodes::VariablePrimitiveInplaceSubtractUInt64:
+  {
+    ApplyTypedNumericOp<PrimitiveSubtract, uint64_t>(variable, constant);
+    break;
+  }
+  case Opcodes::VariablePrimitiveInplaceMultiplyUInt64:
+  {
+    ApplyTypedNumericOp<PrimitiveMultiply, uint64_t>(variable, constant);
+    break;
+  }
+  case Opcodes::VariablePrimitiveInplaceAddFloat32:
+  {
+    ApplyTypedNumericOp<PrimitiveAdd, float>(variable, constant);
+    break;
+  }
+  case Opcodes::VariablePrimitiveInplaceSubtractFloat32:
+  {
+    ApplyTypedNumericOp<PrimitiveSubtract, float>(variable, constant);
+    break;
+  }
+  case Opcodes::VariablePrimitiveInplaceMultiplyFloat32:
+  {
+    ApplyTypedNumericOp<PrimitiveMultiply, float>(variable, constant);
+    break;
+  }
+  case Opcodes::VariablePrimitiveInplaceAddFloat64:
+  {
+    ApplyTypedNumericOp<PrimitiveAdd, double>(variable, constant);
+    break;
+  }
+  case Opcodes::VariablePrimitiveInplaceSubtractFloat64:
+  {
+    ApplyTypedNumericOp<PrimitiveSubtract, double>(variable, constant);
+    break;
+  }
+  case Opcodes::VariablePrimitiveInplaceMultiplyFloat64:
+  {
+    ApplyTypedNumericOp<PrimitiveMultiply, double>(variable, constant);
+    break;
+  }
+  default:
+    break;
+  }
+
+  pc_ = static_cast<uint16_t>(pc_ + 1);
+  instruction_count_ += 1;
+}
+
+void VM::Handler__ModuleFunction()
+{
+  opcode_info_array_[instruction_->opcode].handler(this);
+}
+
+// The handlers which the dispatch identifiers refer to. Opcodes::ReturnValue is decoded to the
+// Opcodes::Return handler which serves both.
+#define FETCH_VM_HANDLER_LIST(X)                                                               \
+  X(Opcodes::VariableDeclare, VariableDeclare)                                                 \
+  X(Opcodes::VariableDeclareAssign, VariableDeclareAssign)                                     \
+  X(Opcodes::PushNull, PushNull)                                                               \
+  X(Opcodes::PushFalse, PushFalse)                                                             \
+  X(Opcodes::PushTrue, PushTrue)                                                               \
+  X(Opcodes::PushString, PushString)                                                           \
+  X(Opcodes::PushConstant, PushConstant)                                                       \
+  X(Opcodes::PushVariable, PushVariable)                                                       \
+  X(Opcodes::PopToVariable, PopToVariable)                                                     \
+  X(Opcodes::Inc, Inc)                                                                         \
+  X(Opcodes::Dec, Dec)                                                                         \
+  X(Opcodes::Duplicate, Duplicate)                                                             \
+  X(Opcodes::DuplicateInsert, DuplicateInsert)                                                 \
+  X(Opcodes::Discard, Discard)                                                                 \
+  X(Opcodes::Destruct, Destruct)                                                               \
+  X(Opcodes::Break, Break)                                                                     \
+  X(Opcodes::Continue, Continue)                                                               \
+  X(Opcodes::Jump, Jump)                                                                       \
+  X(Opcodes::JumpIfFalse, JumpIfFalse)                                                         \
+  X(Opcodes::JumpIfTrue, JumpIfTrue)                                                           \
+  X(Opcodes::Return, Return)                                                                   \
+  X(Opcodes::ForRangeInit, ForRangeInit)                                                       \
+  X(Opcodes::ForRangeIterate, ForRangeIterate)                                                 \
+  X(Opcodes::ForRangeTerminate, ForRangeTerminate)                                             \
+  X(Opcodes::InvokeUserDefinedFreeFunction, InvokeUserDefinedFreeFunction)                     \
+  X(Opcodes::VariablePrefixInc, VariablePrefixInc)                                             \
+  X(Opcodes::VariablePrefixDec, VariablePrefixDec)                                             \
+  X(Opcodes::VariablePostfixInc, VariablePostfixInc)                                           \
+  X(Opcodes::VariablePostfixDec, VariablePostfixDec)                                           \
+  X(Opcodes::And, And)                                                                         \
+  X(Opcodes::Or, Or)                                                                           \
+  X(Opcodes::Not, Not)                                                                         \
+  X(Opcodes::PrimitiveEqual, PrimitiveEqual)                                                   \
+  X(Opcodes::ObjectEqual, ObjectEqual)                                                         \
+  X(Opcodes::PrimitiveNotEqual, PrimitiveNotEqual)                                             \
+  X(Opcodes::ObjectNotEqual, ObjectNotEqual)                                                   \
+  X(Opcodes::PrimitiveLessThan, PrimitiveLessThan)                                             \
+  X(Opcodes::ObjectLessThan, ObjectLessThan)                                                   \
+  X(Opcodes::PrimitiveLessThanOrEqual, PrimitiveLessThanOrEqual)                               \
+  X(Opcodes::ObjectLessThanOrEqual, ObjectLessThanOrEqual)                                     \
+  X(Opcodes::PrimitiveGreaterThan, PrimitiveGreaterThan)                                       \
+  X(Opcodes::ObjectGreaterThan, ObjectGreaterThan)                                             \
+  X(Opcodes::PrimitiveGreaterThanOrEqual, PrimitiveGreaterThanOrEqual)                         \
+  X(Opcodes::ObjectGreaterThanOrEqual, ObjectGreaterThanOrEqual)                               \
+  X(Opcodes::PrimitiveNegate, PrimitiveNegate)                                                 \
+  X(Opcodes::ObjectNegate, ObjectNegate)                                                       \
+  X(Opcodes::PrimitiveAdd, PrimitiveAdd)                                                       \
+  X(Opcodes::ObjectAdd, ObjectAdd)                                                             \
+  X(Opcodes::ObjectLeftAdd, ObjectLeftAdd)                                                     \
+  X(Opcodes::ObjectRightAdd, ObjectRightAdd)                                                   \
+  X(Opcodes::VariablePrimitiveInplaceAdd, VariablePrimitiveInplaceAdd)                         \
+  X(Opcodes::VariableObjectInplaceAdd, VariableObjectInplaceAdd)                               \
+  X(Opcodes::VariableObjectInplaceRightAdd, VariableObjectInplaceRightAdd)                     \
+  X(Opcodes::PrimitiveSubtract, PrimitiveSubtract)                                             \
+  X(Opcodes::ObjectSubtract, ObjectSubtract)                                                   \
+  X(Opcodes::ObjectLeftSubtract, ObjectLeftSubtract)                                           \
+  X(Opcodes::ObjectRightSubtract, ObjectRightSubtract)                                         \
+  X(Opcodes::VariablePrimitiveInplaceSubtract, VariablePrimitiveInplaceSubtract)               \
+  X(Opcodes::VariableObjectInplaceSubtract, VariableObjectInplaceSubtract)                     \
+  X(Opcodes::VariableObjectInplaceRightSubtract, VariableObjectInplaceRightSubtract)           \
+  X(Opcodes::PrimitiveMultiply, PrimitiveMultiply)                                             \
+  X(Opcodes::ObjectMultiply, ObjectMultiply)                                                   \
+  X(Opcodes::ObjectLeftMultiply, ObjectLeftMultiply)                                           \
+  X(Opcodes::ObjectRightMultiply, ObjectRightMultiply)                                         \
+  X(Opcodes::VariablePrimitiveInplaceMultiply, VariablePrimitiveInplaceMultiply)               \
+  X(Opcodes::VariableObjectInplaceMultiply, VariableObjectInplaceMultiply)                     \
+  X(Opcodes::VariableObjectInplaceRightMultiply, VariableObjectInplaceRightMultiply)           \
+  X(Opcodes::PrimitiveDivide, PrimitiveDivide)                                                 \
+  X(Opcodes::ObjectDivide, ObjectDivide)                                                       \
+  X(Opcodes::ObjectLeftDivide, ObjectLeftDivide)                                               \
+  X(Opcodes::ObjectRightDivide, ObjectRightDivide)                                             \
+  X(Opcodes::VariablePrimitiveInplaceDivide, VariablePrimitiveInplaceDivide)                   \
+  X(Opcodes::VariableObjectInplaceDivide, VariableObjectInplaceDivide)                         \
+  X(Opcodes::VariableObjectInplaceRightDivide, VariableObjectInplaceRightDivide)               \
+  X(Opcodes::PrimitiveModulo, PrimitiveModulo)                                                 \
+  X(Opcodes::VariablePrimitiveInplaceModulo, VariablePrimitiveInplaceModulo)                   \
+  X(Opcodes::PushPrimitiveVariable, PushPrimitiveVariable)                                     \
+  X(Opcodes::PopToPrimitiveVariable, PopToPrimitiveVariable)                                   \
+  X(Opcodes::PrimitiveAddInt32, PrimitiveAddInt32)                                             \
+  X(Opcodes::PrimitiveSubtractInt32, PrimitiveSubtractInt32)                                   \
+  X(Opcodes::PrimitiveMultiplyInt32, PrimitiveMultiplyInt32)                                   \
+  X(Opcodes::PrimitiveEqualInt32, PrimitiveEqualInt32)                                         \
+  X(Opcodes::PrimitiveNotEqualInt32, PrimitiveNotEqualInt32)                                   \
+  X(Opcodes::PrimitiveLessThanInt32, PrimitiveLessThanInt32)                                   \
+  X(Opcodes::PrimitiveLessThanOrEqualInt32, PrimitiveLessThanOrEqualInt32)                     \
+  X(Opcodes::PrimitiveGreaterThanInt32, PrimitiveGreaterThanInt32)                             \
+  X(Opcodes::PrimitiveGreaterThanOrEqualInt32, PrimitiveGreaterThanOrEqualInt32)               \
+  X(Opcodes::VariablePrimitiveInplaceAddInt32, VariablePrimitiveInplaceAddInt32)               \
+  X(Opcodes::VariablePrimitiveInplaceSubtractInt32, VariablePrimitiveInplaceSubtractInt32)     \
+  X(Opcodes::VariablePrimitiveInplaceMultiplyInt32, VariablePrimitiveInplaceMultiplyInt32)     \
+  X(Opcodes::PrimitiveAddInt64, PrimitiveAddInt64)                                             \
+  X(Opcodes::PrimitiveSubtractInt64, PrimitiveSubtractInt64)                                   \
+  X(Opcodes::PrimitiveMultiplyInt64, PrimitiveMultiplyInt64)                                   \
+  X(Opcodes::PrimitiveEqualInt64, PrimitiveEqualInt64)                                         \
+  X(Opcodes::PrimitiveNotEqualInt64, PrimitiveNotEqualInt64)                                   \
+  X(Opcodes::PrimitiveLessThanInt64, PrimitiveLessThanInt64)                                   \
+  X(Opcodes::PrimitiveLessThanOrEqualInt64, PrimitiveLessThanOrEqualInt64)                     \
+  X(Opcodes::PrimitiveGreaterThanInt64, PrimitiveGreaterThanInt64)                             \
+  X(Opcodes::PrimitiveGreaterThanOrEqualInt64, PrimitiveGreaterThanOrEqualInt64)               \
+  X(Opcodes::VariablePrimitiveInplaceAddInt64, VariablePrimitiveInplaceAddInt64)               \
+  X(Opcodes::VariablePrimitiveInplaceSubtractInt64, VariablePrimitiveInplaceSubtractInt64)     \
+  X(Opcodes::VariablePrimitiveInplaceMultiplyInt64, VariablePrimitiveInplaceMultiplyInt64)     \
+  X(Opcodes::PrimitiveAddUInt64, PrimitiveAddUInt64)                                           \
+  X(Opcodes::PrimitiveSubtractUInt64, PrimitiveSubtractUInt64)                                 \
+  X(Opcodes::PrimitiveMultiplyUInt64, PrimitiveMultiplyUInt64)                                 \
+  X(Opcodes::PrimitiveEqualUInt64, PrimitiveEqualUInt64)                                       \
+  X(Opcodes::PrimitiveNotEqualUInt64, PrimitiveNotEqualUInt64)                                 \
+  X(Opcodes::PrimitiveLessThanUInt64, PrimitiveLessThanUInt64)                                 \
+  X(Opcodes::PrimitiveLessThanOrEqualUInt64, PrimitiveLessThanOrEqualUInt64)                   \
+  X(Opcodes::PrimitiveGreaterThanUInt64, PrimitiveGreaterThanUInt64)                           \
+  X(Opcodes::PrimitiveGreaterThanOrEqualUInt64, PrimitiveGreaterThanOrEqualUInt64)             \
+  X(Opcodes::VariablePrimitiveInplaceAddUInt64, VariablePrimitiveInplaceAddUInt64)             \
+  X(Opcodes::VariablePrimitiveInplaceSubtractUInt64, VariablePrimitiveInplaceSubtractUInt64)   \
+  X(Opcodes::VariablePrimitiveInplaceMultiplyUInt64, VariablePrimitiveInplaceMultiplyUInt64)   \
+  X(Opcodes::PrimitiveAddFloat32, PrimitiveAddFloat32)                                         \
+  X(Opcodes::PrimitiveSubtractFloat32, PrimitiveSubtractFloat32)                               \
+  X(Opcodes::PrimitiveMultiplyFloat32, PrimitiveMultiplyFloat32)                               \
+  X(Opcodes::PrimitiveEqualFloat32, PrimitiveEqualFloat32)                                     \
+  X(Opcodes::PrimitiveNotEqualFloat32, PrimitiveNotEqualFloat32)                               \
+  X(Opcodes::PrimitiveLessThanFloat32, PrimitiveLessThanFloat32)                               \
+  X(Opcodes::PrimitiveLessThanOrEqualFloat32, PrimitiveLessThanOrEqualFloat32)                 \
+  X(Opcodes::PrimitiveGreaterThanFloat32, PrimitiveGreaterThanFloat32)                         \
+  X(Opcodes::PrimitiveGreaterThanOrEqualFloat32, PrimitiveGreaterThanOrEqualFloat32)           \
+  X(Opcodes::VariablePrimitiveInplaceAddFloat32, VariablePrimitiveInplaceAddFloat32)           \
+  X(Opcodes::VariablePrimitiveInplaceSubtractFloat32, VariablePrimitiveInplaceSubtractFloat32) \
+  X(Opcodes::VariablePrimitiveInplaceMultiplyFloat32, VariablePrimitiveInplaceMultiplyFloat32) \
+  X(Opcodes::PrimitiveAddFloat64, PrimitiveAddFloat64)                                         \
+  X(Opcodes::PrimitiveSubtractFloat64, PrimitiveSubtractFloat64)                               \
+  X(Opcodes::PrimitiveMultiplyFloat64, PrimitiveMultiplyFloat64)                               \
+  X(Opcodes::PrimitiveEqualFloat64, PrimitiveEqualFloat64)                                     \
+  X(Opcodes::PrimitiveNotEqualFloat64, PrimitiveNotEqualFloat64)                               \
+  X(Opcodes::PrimitiveLessThanFloat64, PrimitiveLessThanFloat64)                               \
+  X(Opcodes::PrimitiveLessThanOrEqualFloat64, PrimitiveLessThanOrEqualFloat64)                 \
+  X(Opcodes::PrimitiveGreaterThanFloat64, PrimitiveGreaterThanFloat64)                         \
+  X(Opcodes::PrimitiveGreaterThanOrEqualFloat64, PrimitiveGreaterThanOrEqualFloat64)           \
+  X(Opcodes::VariablePrimitiveInplaceAddFloat64, VariablePrimitiveInplaceAddFloat64)           \
+  X(Opcodes::VariablePrimitiveInplaceSubtractFloat64, VariablePrimitiveInplaceSubtractFloat64) \
+  X(Opcodes::VariablePrimitiveInplaceMultiplyFloat64, VariablePrimitiveInplaceMultiplyFloat64) \
+  X(Dispatch::LocalConstantOp, LocalConstantOp)                                                \
+  X(Dispatch::LocalLocalOp, LocalLocalOp)                                                      \
+  X(Dispatch::LocalConstantOpPop, LocalConstantOpPop)                                          \
+  X(Dispatch::LocalLocalOpPop, LocalLocalOpPop)                                                \
+  X(Dispatch::LocalConstantCompareJump, LocalConstantCompareJump)                              \
+  X(Dispatch::LocalLocalCompareJump, LocalLocalCompareJump)                                    \
+  X(Dispatch::ConstantInplaceOp, ConstantInplaceOp)                                            \
+  X(Dispatch::ModuleFunction, ModuleFunction)
+
+/**
+ * The interpreter loop. Every instruction is dispatched through the pre-decoded array of the
+ * current function, and where supported by the compiler the handlers are threaded together with
+ * computed gotos so that each handler jumps directly to the next one.
+ */
+void VM::Run()
+{
+  uint16_t id{0};
+
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+
+  void *labels[Dispatch::NumHandlers];
+  for (auto &label : labels)
+  {
+    label = &&handler_Unknown;
+  }
+
+#define FETCH_VM_LABEL(ID, NAME) labels[ID] = &&handler_##NAME;
+  FETCH_VM_HANDLER_LIST(FETCH_VM_LABEL)
+#undef FETCH_VM_LABEL
+
+#define FETCH_VM_DISPATCH()                        \
+  if (stop_)                                       \
+  {                                                \
+    return;                                        \
+  }                                                \
+  instruction_pc_ = pc_;                           \
+  instruction_    = &function_->instructions[pc_]; \
+  id              = dispatch_[pc_++];              \
+  ++instruction_count_;                            \
+  goto *labels[id]
+
+  FETCH_VM_DISPATCH();
+
+#define FETCH_VM_HANDLER(ID, NAME) \
+  handler_##NAME:                  \
+  Handler__##NAME();               \
+  FETCH_VM_DISPATCH();
+  FETCH_VM_HANDLER_LIST(FETCH_VM_HANDLER)
+#undef FETCH_VM_HANDLER
+#undef FETCH_VM_DISPATCH
+
+handler_Unknown:
+  RuntimeError("unknown opcode");
+
+#pragma GCC diagnostic pop
+#else
+  while (!stop_)
+  {
+    instruction_pc_ = pc_;
+    instruction_    = &function_->instructions[pc_];
+    id              = dispatch_[pc_++];
+    ++instruction_count_;
+
+    switch (id)
+    {
+#define FETCH_VM_HANDLER(ID, NAME) \
+  case ID:                         \
+    Handler__##NAME();             \
+    break;
+      FETCH_VM_HANDLER_LIST(FETCH_VM_HANDLER)
+#undef FETCH_VM_HANDLER
+    default:
+      RuntimeError("unknown opcode");
+      break;
+    }
+  }
+#endif
+}
+
+#undef FETCH_VM_HANDLER_LIST
+
 }  // namespace vm
 }  // namespace fetch
@@ -0,0 +1,213 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2019 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm_test_suite.hpp"
+
+#include "gmock/gmock.h"
+
+namespace {
+
+class InterpreterTests : public VmTestSuite
+{
+};
+
+TEST_F(InterpreterTests, fused_arithmetic_matches_the_unfused_result)
+{
+  static char const *TEXT = R"(
+    function main()
+      var a : Int32 = 7;
+      var b : Int32 = 3;
+      var c : Int32 = a + 2;
+      var d : Int32 = a - b;
+      var e : Int32 = a * b;
+      var f : Int32 = (a * 4) - (b + 1);
+      print(c);
+      print(' ');
+      print(d);
+      print(' ');
+      print(e);
+      print(' ');
+      print(f);
+    endfunction
+  )";
+
+  ASSERT_TRUE(Compile(TEXT));
+  ASSERT_TRUE(Run());
+
+  ASSERT_EQ(stdout(), "9 4 21 24");
+}
+
+TEST_F(InterpreterTests, fused_comparisons_control_loops_and_branches)
+{
+  static char const *TEXT = R"(
+    function main()
+      var total : Int64 = 0i64;
+      var i : Int64 = 0i64;
+      var limit : Int64 = 10i64;
+      while (i < limit)
+        if (i >= 5i64)
+          total = total + i;
+        endif
+        i = i + 1i64;
+      endwhile
+      for (j in 0:3)
+        total += 100i64;
+        total -= 1i64;
+      endfor
+      print(total);
+    endfunction
+  )";
+
+  ASSERT_TRUE(Compile(TEXT));
+  ASSERT_TRUE(Run());
+
+  // 5 + 6 + 7 + 8 + 9 + (4 * 99)
+  ASSERT_EQ(stdout(), "431");
+}
+
+TEST_F(InterpreterTests, user_functions_resume_in_the_callers_instruction_stream)
+{
+  static char const *TEXT = R"(
+    function fib(n : Int32) : Int32
+      if (n < 2)
+        return n;
+      endif
+      return fib(n - 1) + fib(n - 2);
+    endfunction
+
+    function main()
+      var total : Int32 = 0;
+      var i : Int32 = 0;
+      while (i <= 10)
+        total = total + fib(i);
+        i = i + 1;
+      endwhile
+      print(total);
+    endfunction
+  )";
+
+  ASSERT_TRUE(Compile(TEXT));
+  ASSERT_TRUE(Run());
+
+  ASSERT_EQ(stdout(), "143");
+}
+
+TEST_F(InterpreterTests, type_specialised_arithmetic_matches_the_generic_result)
+{
+  static char const *TEXT = R"(
+    function main()
+      var a : Int32 = -7;
+      var b : Int64 = 3000000000i64;
+      var c : Float32 = 1.5f;
+      var d : Float64 = 0.25;
+      a = a * 3 - 1;
+      a -= 2;
+      b = b * 3i64 + 1i64;
+      b *= 2i64;
+      c = c * 2.0f + 0.5f;
+      c += 1.0f;
+      d = d * d - 0.0625;
+      d += 2.0;
+      print(a);
+      print(' ');
+      print(b);
+      print(' ');
+      print(c);
+      print(' ');
+      print(d);
+    endfunction
+  )";
+
+  ASSERT_TRUE(Compile(TEXT));
+  ASSERT_TRUE(Run());
+
+  ASSERT_EQ(stdout(), "-24 18000000002 4.5 2");
+}
+
+TEST_F(InterpreterTests, type_specialised_comparisons_use_the_type_of_the_operands)
+{
+  static char const *TEXT = R"(
+    function main()
+      var zero : UInt64 = 0u64;
+      var wrapped : UInt64 = zero - 1u64;
+      var negative : Int64 = 0i64 - 1i64;
+      if (wrapped > zero)
+        print('unsigned ');
+      endif
+      if (negative < 0i64)
+        print('signed ');
+      endif
+      var x : Float64 = 0.1;
+      var y : Float64 = x + 0.2;
+      if (y >= 0.3)
+        print('float');
+      endif
+    endfunction
+  )";
+
+  ASSERT_TRUE(Compile(TEXT));
+  ASSERT_TRUE(Run());
+
+  ASSERT_EQ(stdout(), "unsigned signed float");
+}
+
+TEST_F(InterpreterTests, runtime_errors_report_the_line_of_the_failing_instruction)
+{
+  static char const *TEXT = R"(
+    function main()
+      var i : Int32 = 3;
+      var total : Int32 = 0;
+      while (i >= 0)
+        total = total + 12 / i;
+        i = i - 1;
+      endwhile
+    endfunction
+  )";
+
+  ASSERT_TRUE(Compile(TEXT));
+  ASSERT_FALSE(Run());
+
+  ASSERT_EQ(stdout(), "Runtime Error: runtime error: line 6: division by zero\n");
+}
+
+TEST_F(InterpreterTests, executions_count_the_instructions_which_are_run)
+{
+  static char const *TEXT = R"(
+    function main()
+      var i : Int32 = 0;
+      while (i < 100)
+        i = i + 1;
+      endwhile
+    endfunction
+  )";
+
+  ASSERT_TRUE(Compile(TEXT));
+  ASSERT_TRUE(Run());
+
+  // the declaration is 2 instructions and each iteration of the loop is 9, which run as 2
+  // superinstructions of 4 and a jump. The final test of the condition is 4 more and the implicit
+  // return is 1, so a superinstruction must be charged for every instruction it stands for
+  uint64_t const count = vm_->instruction_count();
+  EXPECT_EQ(2u + (100u * 9u) + 4u + 1u, count);
+
+  // the count is restarted by every execution
+  ASSERT_TRUE(Run());
+  EXPECT_EQ(count, vm_->instruction_count());
+}
+
+}  // namespace